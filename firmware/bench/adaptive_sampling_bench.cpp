@@ -0,0 +1,324 @@
+/**
+ * @file adaptive_sampling_bench.cpp
+ * @author zuudevs (zuudevs@gmail.com)
+ * @brief Average power and detection latency: adaptive vs fixed-rate sampling
+ * @version 1.0
+ * @date 2026-03-26
+ *
+ * Replays a seeded trace of household load (slow drift plus appliance
+ * steps) with short tamper events: a bypass or magnet that pulls the
+ * measured current down for a few seconds, preceded most of the time by
+ * a casing or motion interrupt while the meter is being worked on. The
+ * same trace is sampled at the fixed idle rate, at the fixed burst rate
+ * and by the adaptive controller. An event counts as detected by the
+ * first reading that lands inside it; the report gives coverage, mean and
+ * worst latency, and the modelled average supply current of each.
+ *
+ *   gridshield_adaptive_sampling_bench [--hours N] [--seed N]
+ *       [--events-per-hour N] [--precursor-pct P]
+ *       [--max-power-pct P] [--min-detect-pct P] [--max-latency-ms M]
+ *
+ * @copyright Copyright (c) 2026
+ */
+
+#include "hardware/adaptive_sampling.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+using namespace gridshield;
+using hardware::AdaptiveSampler;
+using hardware::AdaptiveSamplingConfig;
+using hardware::SamplingObservation;
+
+// ============================================================================
+// OPTIONS
+// ============================================================================
+static constexpr uint32_t STEP_MS = 10;
+static constexpr uint32_t MS_PER_HOUR = 3600U * 1000U;
+static constexpr size_t MAX_EVENTS = 4096;
+static constexpr uint32_t VOLTAGE_V = 230;
+
+struct BenchOptions
+{
+    uint32_t hours{24};
+    uint64_t seed{1};
+    uint32_t events_per_hour{3};
+    uint32_t precursor_pct{70};
+    double max_power_pct{-1.0};  // adaptive draw as % of fixed-burst draw
+    double min_detect_pct{-1.0}; // adaptive event coverage
+    double max_latency_ms{-1.0}; // adaptive mean latency over detected events
+};
+
+static void print_usage(const char* argv0)
+{
+    std::printf("usage: %s [--hours N] [--seed N] [--events-per-hour N] [--precursor-pct P]\n"
+                "          [--max-power-pct P] [--min-detect-pct P] [--max-latency-ms M]\n",
+                argv0);
+}
+
+static bool parse_args(int argc, char** argv, BenchOptions& opts)
+{
+    for (int i = 1; i < argc; ++i) {
+        const char* arg = argv[i];
+        const char* value = (i + 1 < argc) ? argv[i + 1] : nullptr;
+        if (value == nullptr) {
+            return false;
+        }
+        if (std::strcmp(arg, "--hours") == 0) {
+            opts.hours = static_cast<uint32_t>(std::strtoul(value, nullptr, 10));
+        } else if (std::strcmp(arg, "--seed") == 0) {
+            opts.seed = std::strtoull(value, nullptr, 10);
+        } else if (std::strcmp(arg, "--events-per-hour") == 0) {
+            opts.events_per_hour = static_cast<uint32_t>(std::strtoul(value, nullptr, 10));
+        } else if (std::strcmp(arg, "--precursor-pct") == 0) {
+            opts.precursor_pct = static_cast<uint32_t>(std::strtoul(value, nullptr, 10));
+        } else if (std::strcmp(arg, "--max-power-pct") == 0) {
+            opts.max_power_pct = std::strtod(value, nullptr);
+        } else if (std::strcmp(arg, "--min-detect-pct") == 0) {
+            opts.min_detect_pct = std::strtod(value, nullptr);
+        } else if (std::strcmp(arg, "--max-latency-ms") == 0) {
+            opts.max_latency_ms = std::strtod(value, nullptr);
+        } else {
+            return false;
+        }
+        ++i;
+    }
+    return opts.hours > 0 && opts.precursor_pct <= 100 && opts.events_per_hour <= 60 &&
+           static_cast<uint64_t>(opts.hours) * opts.events_per_hour <= MAX_EVENTS;
+}
+
+static uint64_t next_random(uint64_t& state)
+{
+    // xorshift64*
+    state ^= state >> 12;
+    state ^= state << 25;
+    state ^= state >> 27;
+    return state * 0x2545F4914F6CDD1DULL;
+}
+
+static uint32_t uniform(uint64_t& state, uint32_t lo, uint32_t hi)
+{
+    return lo + static_cast<uint32_t>(next_random(state) % (hi - lo + 1U));
+}
+
+// ============================================================================
+// TRACE
+// ============================================================================
+struct TamperEvent
+{
+    uint64_t start_ms{};
+    uint32_t duration_ms{};
+    uint32_t remaining_permille{}; // measured current while active
+    uint64_t precursor_ms{};       // 0 = no interrupt before the event
+};
+
+struct Trace
+{
+    TamperEvent events[MAX_EVENTS]{};
+    size_t event_count{};
+    uint64_t length_ms{};
+    uint64_t seed{};
+};
+
+static Trace trace;
+
+static void build_trace(const BenchOptions& opts)
+{
+    uint64_t rng = opts.seed * 0x9E3779B97F4A7C15ULL + 1;
+    trace.length_ms = static_cast<uint64_t>(opts.hours) * MS_PER_HOUR;
+    trace.seed = next_random(rng);
+    trace.event_count = static_cast<size_t>(opts.hours) * opts.events_per_hour;
+    if (trace.event_count == 0) {
+        return;
+    }
+    // One event per equal slot, placed at random inside it
+    const uint64_t slot = trace.length_ms / trace.event_count;
+    for (size_t i = 0; i < trace.event_count; ++i) {
+        TamperEvent& e = trace.events[i];
+        e.duration_ms = uniform(rng, 1000, 15000);
+        e.start_ms = i * slot + 10000 + uniform(rng, 0, static_cast<uint32_t>(slot - 40000));
+        e.remaining_permille = uniform(rng, 0, 600);
+        if (uniform(rng, 1, 100) <= opts.precursor_pct) {
+            e.precursor_ms = e.start_ms - uniform(rng, 500, 5000);
+        }
+    }
+}
+
+/// Household load: base level drifting over the day plus appliance steps
+/// that switch on and off every few minutes (benign escalations)
+static uint32_t load_ma(uint64_t t_ms)
+{
+    const uint64_t minute = t_ms / 60000U;
+    uint64_t h = (minute / 7U) ^ trace.seed;
+    h = next_random(h);
+    const uint32_t base = 2000U + static_cast<uint32_t>((t_ms / MS_PER_HOUR) % 24U) * 250U;
+    const uint32_t appliance = (h & 1U) != 0 ? 3000U + static_cast<uint32_t>(h % 5000U) : 0U;
+    return base + appliance;
+}
+
+static const TamperEvent* active_event(uint64_t t_ms, size_t& cursor)
+{
+    while (cursor < trace.event_count &&
+           trace.events[cursor].start_ms + trace.events[cursor].duration_ms <= t_ms) {
+        ++cursor;
+    }
+    if (cursor < trace.event_count && trace.events[cursor].start_ms <= t_ms) {
+        return &trace.events[cursor];
+    }
+    return nullptr;
+}
+
+// ============================================================================
+// RUN
+// ============================================================================
+struct Outcome
+{
+    uint32_t detected{};
+    uint64_t latency_sum_ms{};
+    uint64_t worst_latency_ms{};
+    uint32_t average_ua{};
+    uint32_t readings{};
+    uint32_t escalations{};
+};
+
+static Outcome run(const AdaptiveSamplingConfig& config)
+{
+    Outcome out;
+    AdaptiveSampler sampler;
+    if (sampler.initialize(config, 0).is_error()) {
+        return out;
+    }
+
+    bool seen[MAX_EVENTS]{};
+    size_t cursor = 0;
+    size_t precursor_cursor = 0;
+    for (uint64_t t = 0; t <= trace.length_ms; t += STEP_MS) {
+        // Casing or motion interrupt; lead times never reach the previous event
+        while (precursor_cursor < trace.event_count &&
+               trace.events[precursor_cursor].precursor_ms <= t) {
+            if (trace.events[precursor_cursor].precursor_ms != 0) {
+                sampler.notify_tamper();
+            }
+            ++precursor_cursor;
+        }
+
+        sampler.poll(t);
+        if (!sampler.due(t)) {
+            continue;
+        }
+        const TamperEvent* event = active_event(t, cursor);
+        uint32_t current = load_ma(t);
+        if (event != nullptr) {
+            current = current * event->remaining_permille / 1000U;
+            const auto index = static_cast<size_t>(event - trace.events);
+            if (!seen[index]) {
+                seen[index] = true;
+                const uint64_t latency = t - event->start_ms;
+                ++out.detected;
+                out.latency_sum_ms += latency;
+                out.worst_latency_ms = std::max(out.worst_latency_ms, latency);
+            }
+        }
+        SamplingObservation obs;
+        obs.current_ma = current;
+        obs.power_mw = current * VOLTAGE_V;
+        (void)sampler.observe(obs, t);
+    }
+
+    out.average_ua = sampler.stats().average_ua();
+    out.readings = sampler.stats().readings;
+    out.escalations = sampler.stats().escalations;
+    return out;
+}
+
+static void report(const char* name, const Outcome& o)
+{
+    const double pct = trace.event_count == 0
+                           ? 100.0
+                           : 100.0 * o.detected / static_cast<double>(trace.event_count);
+    const double mean = o.detected == 0 ? 0.0
+                                        : static_cast<double>(o.latency_sum_ms) / o.detected;
+    std::printf("  %-14s %8.2f mA %9u %10u %7.1f%% %9.0f %9llu\n",
+                name,
+                o.average_ua / 1000.0,
+                static_cast<unsigned>(o.readings),
+                static_cast<unsigned>(o.escalations),
+                pct,
+                mean,
+                static_cast<unsigned long long>(o.worst_latency_ms));
+}
+
+int main(int argc, char** argv)
+{
+    BenchOptions opts;
+    if (!parse_args(argc, argv, opts)) {
+        print_usage(argv[0]);
+        return EXIT_FAILURE;
+    }
+    build_trace(opts);
+
+    // Fixed baselines: the controller disabled, running one profile throughout
+    AdaptiveSamplingConfig slow;
+    AdaptiveSamplingConfig fast;
+    fast.idle = hardware::burst_sampling_profile();
+    AdaptiveSamplingConfig adaptive;
+    adaptive.enabled = true;
+
+    const Outcome slow_out = run(slow);
+    const Outcome fast_out = run(fast);
+    const Outcome adaptive_out = run(adaptive);
+
+    std::printf("%u h, %zu tamper events (1-15 s, %u%% with a precursor interrupt), seed %llu\n\n",
+                static_cast<unsigned>(opts.hours),
+                trace.event_count,
+                static_cast<unsigned>(opts.precursor_pct),
+                static_cast<unsigned long long>(opts.seed));
+    std::printf("  %-14s %11s %9s %10s %8s %9s %9s\n",
+                "sampling",
+                "avg supply",
+                "readings",
+                "escalated",
+                "detect",
+                "mean ms",
+                "worst ms");
+    report("fixed 5 s", slow_out);
+    report("fixed 250 ms", fast_out);
+    report("adaptive", adaptive_out);
+
+    const double power_pct = fast_out.average_ua == 0
+                                 ? 0.0
+                                 : 100.0 * adaptive_out.average_ua / fast_out.average_ua;
+    const double detect_pct =
+        trace.event_count == 0
+            ? 100.0
+            : 100.0 * adaptive_out.detected / static_cast<double>(trace.event_count);
+    const double mean_latency =
+        adaptive_out.detected == 0
+            ? 0.0
+            : static_cast<double>(adaptive_out.latency_sum_ms) / adaptive_out.detected;
+    std::printf("\n  adaptive draw %.1f%% of fixed 250 ms\n", power_pct);
+
+    bool ok = true;
+    if (opts.max_power_pct >= 0.0 && power_pct > opts.max_power_pct) {
+        std::printf("FAIL: adaptive draw %.1f%% of fixed burst (limit %.1f%%)\n",
+                    power_pct,
+                    opts.max_power_pct);
+        ok = false;
+    }
+    if (opts.min_detect_pct >= 0.0 && detect_pct < opts.min_detect_pct) {
+        std::printf("FAIL: adaptive detected %.1f%% of events (floor %.1f%%)\n",
+                    detect_pct,
+                    opts.min_detect_pct);
+        ok = false;
+    }
+    if (opts.max_latency_ms >= 0.0 && mean_latency > opts.max_latency_ms) {
+        std::printf("FAIL: adaptive mean latency %.0f ms (limit %.0f ms)\n",
+                    mean_latency,
+                    opts.max_latency_ms);
+        ok = false;
+    }
+    return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
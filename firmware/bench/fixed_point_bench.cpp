@@ -0,0 +1,252 @@
+/**
+ * @file fixed_point_bench.cpp
+ * @author zuudevs (zuudevs@gmail.com)
+ * @brief Cost and accuracy of the Q-format kernels against double
+ * @version 1.0
+ * @date 2026-03-22
+ *
+ * Runs each utils/fixed_point.hpp kernel (sqrt, log2, exp2, ln, exp,
+ * reciprocal, divide, multiply) and its double/libm counterpart over the
+ * same seeded Q16 inputs, reporting ns per call and the worst error
+ * against double. The host has an FPU, so the double column is the best
+ * case; on the ESP32 double is soft-float (hundreds of cycles per op) and
+ * the integer kernels keep the host timings' ratios among themselves.
+ *
+ *   gridshield_fixed_point_bench [--calls N] [--seed N]
+ *       [--max-log-err E] [--max-exp-rel-err E] [--max-ns N]
+ *
+ * @copyright Copyright (c) 2026
+ */
+
+#include "utils/fixed_point.hpp"
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+using namespace gridshield;
+using utils::Q16;
+
+// ============================================================================
+// OPTIONS
+// ============================================================================
+static constexpr uint32_t MAX_CALLS = 1U << 20;
+static constexpr double LSB = 1.0 / Q16::ONE_RAW;
+
+struct BenchOptions
+{
+    uint32_t calls{1U << 18};
+    uint64_t seed{1};
+    double max_log_err{-1.0};
+    double max_exp_rel_err{-1.0};
+    double max_ns{-1.0};
+};
+
+static void print_usage(const char* argv0)
+{
+    std::printf("usage: %s [--calls N] [--seed N]\n"
+                "          [--max-log-err E] [--max-exp-rel-err E] [--max-ns N]\n",
+                argv0);
+}
+
+static bool parse_args(int argc, char** argv, BenchOptions& opts)
+{
+    for (int i = 1; i < argc; ++i) {
+        const char* arg = argv[i];
+        const char* value = (i + 1 < argc) ? argv[i + 1] : nullptr;
+        if (value == nullptr) {
+            return false;
+        }
+        if (std::strcmp(arg, "--calls") == 0) {
+            opts.calls = static_cast<uint32_t>(std::strtoul(value, nullptr, 10));
+        } else if (std::strcmp(arg, "--seed") == 0) {
+            opts.seed = std::strtoull(value, nullptr, 10);
+        } else if (std::strcmp(arg, "--max-log-err") == 0) {
+            opts.max_log_err = std::strtod(value, nullptr);
+        } else if (std::strcmp(arg, "--max-exp-rel-err") == 0) {
+            opts.max_exp_rel_err = std::strtod(value, nullptr);
+        } else if (std::strcmp(arg, "--max-ns") == 0) {
+            opts.max_ns = std::strtod(value, nullptr);
+        } else {
+            return false;
+        }
+        ++i;
+    }
+    return opts.calls > 0 && opts.calls <= MAX_CALLS;
+}
+
+static uint64_t next_random(uint64_t& state)
+{
+    // xorshift64*
+    state ^= state >> 12;
+    state ^= state << 25;
+    state ^= state >> 27;
+    return state * 0x2545F4914F6CDD1DULL;
+}
+
+static uint64_t elapsed_ns(std::chrono::steady_clock::time_point start)
+{
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                     std::chrono::steady_clock::now() - start)
+                                     .count());
+}
+
+// ============================================================================
+// KERNELS
+// ============================================================================
+static Q16 inputs[MAX_CALLS];
+static Q16 inputs_b[MAX_CALLS];
+static double doubles[MAX_CALLS];
+static double doubles_b[MAX_CALLS];
+static Q16 q_out[MAX_CALLS];
+static double d_out[MAX_CALLS];
+
+enum class ErrorKind
+{
+    Absolute,
+    Relative,
+};
+
+struct Kernel
+{
+    const char* name;
+    double lo;   // input range, applied to both operands
+    double hi;
+    ErrorKind error;
+    Q16 (*fixed)(Q16, Q16);
+    double (*reference)(double, double);
+};
+
+static const Kernel KERNELS[] = {
+    {"sqrt", 0.0, 32000.0, ErrorKind::Absolute,
+     [](Q16 a, Q16) { return utils::sqrt(a); },
+     [](double a, double) { return std::sqrt(a); }},
+    {"log2", 1.0 / 4096, 32000.0, ErrorKind::Absolute,
+     [](Q16 a, Q16) { return utils::log2(a); },
+     [](double a, double) { return std::log2(a); }},
+    {"ln", 1.0 / 4096, 32000.0, ErrorKind::Absolute,
+     [](Q16 a, Q16) { return utils::ln(a); },
+     [](double a, double) { return std::log(a); }},
+    {"exp2", -8.0, 14.0, ErrorKind::Relative,
+     [](Q16 a, Q16) { return utils::exp2(a); },
+     [](double a, double) { return std::exp2(a); }},
+    {"exp", -6.0, 10.0, ErrorKind::Relative,
+     [](Q16 a, Q16) { return utils::exp(a); },
+     [](double a, double) { return std::exp(a); }},
+    {"reciprocal", 1.0 / 16, 30000.0, ErrorKind::Absolute,
+     [](Q16 a, Q16) { return utils::reciprocal(a); },
+     [](double a, double) { return 1.0 / a; }},
+    {"divide", 1.0 / 16, 150.0, ErrorKind::Absolute,
+     [](Q16 a, Q16 b) { return a / b; },
+     [](double a, double b) { return a / b; }},
+    {"multiply", -150.0, 150.0, ErrorKind::Absolute,
+     [](Q16 a, Q16 b) { return a * b; },
+     [](double a, double b) { return a * b; }},
+};
+
+struct KernelResult
+{
+    double fixed_ns{0.0};
+    double double_ns{0.0};
+    double worst{0.0};
+};
+
+static KernelResult run_kernel(const Kernel& k, const BenchOptions& opts, uint64_t& rng)
+{
+    const uint32_t n = opts.calls;
+    for (uint32_t i = 0; i < n; ++i) {
+        const double u = static_cast<double>(next_random(rng) >> 11) / 9007199254740992.0;
+        const double v = static_cast<double>(next_random(rng) >> 11) / 9007199254740992.0;
+        inputs[i] = Q16::from_double(k.lo + (k.hi - k.lo) * u);
+        inputs_b[i] = Q16::from_double(k.lo + (k.hi - k.lo) * v);
+        if (inputs_b[i] == Q16::zero()) {
+            inputs_b[i] = Q16::one();
+        }
+        doubles[i] = inputs[i].to_double();
+        doubles_b[i] = inputs_b[i].to_double();
+    }
+
+    KernelResult result;
+    auto start = std::chrono::steady_clock::now();
+    for (uint32_t i = 0; i < n; ++i) {
+        q_out[i] = k.fixed(inputs[i], inputs_b[i]);
+    }
+    result.fixed_ns = static_cast<double>(elapsed_ns(start)) / n;
+
+    start = std::chrono::steady_clock::now();
+    for (uint32_t i = 0; i < n; ++i) {
+        d_out[i] = k.reference(doubles[i], doubles_b[i]);
+    }
+    result.double_ns = static_cast<double>(elapsed_ns(start)) / n;
+
+    for (uint32_t i = 0; i < n; ++i) {
+        const double want = d_out[i];
+        if (want >= Q16::max().to_double() || want <= Q16::min().to_double()) {
+            continue; // saturated by design
+        }
+        double err = std::fabs(q_out[i].to_double() - want);
+        if (k.error == ErrorKind::Relative) {
+            err = want > LSB ? (err - LSB / 2) / want : 0.0; // less output quantization
+        }
+        result.worst = err > result.worst ? err : result.worst;
+    }
+    return result;
+}
+
+// ============================================================================
+// RUN
+// ============================================================================
+int main(int argc, char** argv)
+{
+    BenchOptions opts;
+    if (!parse_args(argc, argv, opts)) {
+        print_usage(argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    uint64_t rng = opts.seed * 0x9E3779B97F4A7C15ULL + 1;
+    std::printf("%u calls per kernel, Q16 (Q15.16), seed %llu\n\n",
+                static_cast<unsigned>(opts.calls),
+                static_cast<unsigned long long>(opts.seed));
+    std::printf("  %-11s %10s %10s %14s\n", "kernel", "Q16 ns", "double ns", "worst error");
+
+    bool ok = true;
+    double sink = 0.0;
+    for (const Kernel& k : KERNELS) {
+        const KernelResult r = run_kernel(k, opts, rng);
+        sink += q_out[opts.calls - 1].to_double() + d_out[opts.calls - 1];
+        std::printf("  %-11s %10.2f %10.2f %11.2e %s\n",
+                    k.name,
+                    r.fixed_ns,
+                    r.double_ns,
+                    r.worst,
+                    k.error == ErrorKind::Relative ? "rel" : "abs");
+
+        const bool is_log = std::strcmp(k.name, "log2") == 0 || std::strcmp(k.name, "ln") == 0;
+        const bool is_exp = k.error == ErrorKind::Relative;
+        if (is_log && opts.max_log_err >= 0.0 && r.worst > opts.max_log_err) {
+            std::printf("FAIL: %s error %.2e (limit %.2e)\n", k.name, r.worst, opts.max_log_err);
+            ok = false;
+        }
+        if (is_exp && opts.max_exp_rel_err >= 0.0 && r.worst > opts.max_exp_rel_err) {
+            std::printf("FAIL: %s relative error %.2e (limit %.2e)\n",
+                        k.name,
+                        r.worst,
+                        opts.max_exp_rel_err);
+            ok = false;
+        }
+        // Rounded kernels must be within one output LSB of double
+        if (!is_log && !is_exp && r.worst > LSB) {
+            std::printf("FAIL: %s error %.2e exceeds one LSB\n", k.name, r.worst);
+            ok = false;
+        }
+        if (opts.max_ns >= 0.0 && r.fixed_ns > opts.max_ns) {
+            std::printf("FAIL: %s %.1f ns/call (limit %.1f)\n", k.name, r.fixed_ns, opts.max_ns);
+            ok = false;
+        }
+    }
+    std::printf("\n(checksum %.3f)\n", sink);
+    return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
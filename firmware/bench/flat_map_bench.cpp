@@ -0,0 +1,293 @@
+/**
+ * @file flat_map_bench.cpp
+ * @author zuudevs (zuudevs@gmail.com)
+ * @brief FlatMap lookup cost against the linear scans it replaces
+ * @version 1.0
+ * @date 2026-03-20
+ *
+ * Three key shapes from the firmware: config keys (strings looked up by
+ * name, as RemoteConfigManager::get does), peer MACs (6-byte arrays, as
+ * EspNowMesh) and meter ids (64-bit, as a gateway table). For each table
+ * size the same random mix of hits and misses is resolved by a linear scan
+ * over a packed array and by utils::FlatMap; both must agree on every
+ * lookup. Reports ns per lookup and the speedup; small tables are expected
+ * to favour the scan, the gate only applies from --gate-size up.
+ *
+ *   gridshield_flat_map_bench [--lookups N] [--seed N] [--miss-pct P]
+ *       [--gate-size N] [--min-speedup R]
+ *
+ * @copyright Copyright (c) 2026
+ */
+
+#include "utils/flat_map.hpp"
+
+#include <array>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <type_traits>
+
+using namespace gridshield;
+
+// ============================================================================
+// OPTIONS
+// ============================================================================
+static constexpr size_t MAX_LOOKUPS = 1000000;
+static constexpr size_t CONFIG_KEY_LENGTH = 32;
+static constexpr size_t MAX_TABLE = 1024;
+
+struct BenchOptions
+{
+    uint32_t lookups{200000};
+    uint64_t seed{1};
+    uint32_t miss_pct{20};
+    size_t gate_size{0}; // 0 = no speed gate
+    double min_speedup{1.0};
+};
+
+static void print_usage(const char* argv0)
+{
+    std::printf("usage: %s [--lookups N] [--seed N] [--miss-pct P]\n"
+                "          [--gate-size N] [--min-speedup R]\n",
+                argv0);
+}
+
+static bool parse_args(int argc, char** argv, BenchOptions& opts)
+{
+    for (int i = 1; i < argc; ++i) {
+        const char* arg = argv[i];
+        const char* value = (i + 1 < argc) ? argv[i + 1] : nullptr;
+        if (value == nullptr) {
+            return false;
+        }
+        if (std::strcmp(arg, "--lookups") == 0) {
+            opts.lookups = static_cast<uint32_t>(std::strtoul(value, nullptr, 10));
+        } else if (std::strcmp(arg, "--seed") == 0) {
+            opts.seed = std::strtoull(value, nullptr, 10);
+        } else if (std::strcmp(arg, "--miss-pct") == 0) {
+            opts.miss_pct = static_cast<uint32_t>(std::strtoul(value, nullptr, 10));
+        } else if (std::strcmp(arg, "--gate-size") == 0) {
+            opts.gate_size = static_cast<size_t>(std::strtoul(value, nullptr, 10));
+        } else if (std::strcmp(arg, "--min-speedup") == 0) {
+            opts.min_speedup = std::strtod(value, nullptr);
+        } else {
+            return false;
+        }
+        ++i;
+    }
+    return opts.lookups > 0 && opts.lookups <= MAX_LOOKUPS && opts.miss_pct <= 100;
+}
+
+static uint64_t next_random(uint64_t& state)
+{
+    // xorshift64*
+    state ^= state >> 12;
+    state ^= state << 25;
+    state ^= state >> 27;
+    return state * 0x2545F4914F6CDD1DULL;
+}
+
+static uint64_t elapsed_ns(std::chrono::steady_clock::time_point start)
+{
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                     std::chrono::steady_clock::now() - start)
+                                     .count());
+}
+
+// ============================================================================
+// KEY SHAPES
+// ============================================================================
+using ConfigKey = std::array<char, CONFIG_KEY_LENGTH>;
+using Mac = std::array<uint8_t, 6>;
+
+struct ConfigShape
+{
+    static constexpr const char* NAME = "config key";
+    using Key = ConfigKey;
+
+    static Key make(uint32_t id)
+    {
+        // Ids stay below 100000 (misses top out at 0x10000 + 2 * MAX_TABLE), so
+        // five digits keep the longest key inside CONFIG_MAX_KEY_LENGTH
+        Key key{};
+        std::snprintf(key.data(), key.size(), "sensor.ch_%05u.interval_ms", id % 100000U);
+        return key;
+    }
+    static bool equal(const Key& a, const Key& b)
+    {
+        return std::strncmp(a.data(), b.data(), CONFIG_KEY_LENGTH) == 0;
+    }
+    // Stored by hash and verified against the entry, as RemoteConfigManager
+    static uint32_t index_key(const Key& key)
+    {
+        return utils::hash_string(key.data(), CONFIG_KEY_LENGTH);
+    }
+};
+
+struct MacShape
+{
+    static constexpr const char* NAME = "peer MAC";
+    using Key = Mac;
+
+    static Key make(uint32_t id)
+    {
+        return Key{0x24, 0x6F, 0x28, static_cast<uint8_t>(id >> 16),
+                   static_cast<uint8_t>(id >> 8), static_cast<uint8_t>(id)};
+    }
+    static bool equal(const Key& a, const Key& b)
+    {
+        return a == b;
+    }
+    static const Key& index_key(const Key& key)
+    {
+        return key;
+    }
+};
+
+struct MeterShape
+{
+    static constexpr const char* NAME = "meter id";
+    using Key = uint64_t;
+
+    static Key make(uint32_t id)
+    {
+        return 0x4753000000000000ULL | (static_cast<uint64_t>(id) * 2654435761ULL);
+    }
+    static bool equal(Key a, Key b)
+    {
+        return a == b;
+    }
+    static Key index_key(Key key)
+    {
+        return key;
+    }
+};
+
+// ============================================================================
+// RUN
+// ============================================================================
+static uint32_t queries[MAX_LOOKUPS];
+static int32_t scan_result[MAX_LOOKUPS];
+static int32_t map_result[MAX_LOOKUPS];
+
+struct SizeResult
+{
+    double scan_ns{0.0};
+    double map_ns{0.0};
+    uint16_t max_probe{0};
+    uint64_t mismatches{0};
+};
+
+template <typename Shape, size_t N>
+static SizeResult run_size(const BenchOptions& opts, uint64_t& rng)
+{
+    using Key = typename Shape::Key;
+    using IndexKey = typename std::decay<decltype(Shape::index_key(Key{}))>::type;
+
+    // Keys 0..N-1 are present; ids >= MAX_TABLE are misses
+    static std::array<Key, N> table;
+    static std::array<Key, 2 * MAX_TABLE> probes;
+    static utils::FlatMap<IndexKey, uint16_t, N> index;
+    index.clear();
+    for (uint32_t i = 0; i < N; ++i) {
+        table[i] = Shape::make(i);
+        (void)index.insert(Shape::index_key(table[i]), static_cast<uint16_t>(i));
+    }
+    for (uint32_t i = 0; i < probes.size(); ++i) {
+        probes[i] = Shape::make(i < MAX_TABLE ? i : i + 0x10000U);
+    }
+    for (uint32_t q = 0; q < opts.lookups; ++q) {
+        const bool miss = next_random(rng) % 100 < opts.miss_pct;
+        const auto pick = static_cast<uint32_t>(next_random(rng) % N);
+        queries[q] = miss ? static_cast<uint32_t>(MAX_TABLE + pick % MAX_TABLE) : pick;
+    }
+
+    SizeResult result;
+    auto start = std::chrono::steady_clock::now();
+    for (uint32_t q = 0; q < opts.lookups; ++q) {
+        const Key& key = probes[queries[q]];
+        int32_t found = -1;
+        for (size_t i = 0; i < N; ++i) {
+            if (Shape::equal(table[i], key)) {
+                found = static_cast<int32_t>(i);
+                break;
+            }
+        }
+        scan_result[q] = found;
+    }
+    result.scan_ns = static_cast<double>(elapsed_ns(start)) / opts.lookups;
+
+    start = std::chrono::steady_clock::now();
+    for (uint32_t q = 0; q < opts.lookups; ++q) {
+        const Key& key = probes[queries[q]];
+        const uint16_t* slot = index.find(Shape::index_key(key));
+        map_result[q] = (slot != nullptr && Shape::equal(table[*slot], key))
+                            ? static_cast<int32_t>(*slot)
+                            : -1;
+    }
+    result.map_ns = static_cast<double>(elapsed_ns(start)) / opts.lookups;
+
+    for (uint32_t q = 0; q < opts.lookups; ++q) {
+        result.mismatches += scan_result[q] != map_result[q] ? 1U : 0U;
+    }
+    result.max_probe = index.max_probe();
+    return result;
+}
+
+template <typename Shape, size_t... Sizes>
+static bool run_shape(const BenchOptions& opts, uint64_t& rng)
+{
+    bool ok = true;
+    const size_t sizes[] = {Sizes...};
+    const SizeResult results[] = {run_size<Shape, Sizes>(opts, rng)...};
+
+    std::printf("%s\n", Shape::NAME);
+    for (size_t i = 0; i < sizeof(sizes) / sizeof(sizes[0]); ++i) {
+        const SizeResult& r = results[i];
+        const double speedup = r.map_ns > 0.0 ? r.scan_ns / r.map_ns : 0.0;
+        std::printf("  n=%-5zu scan %7.1f ns  flat_map %6.1f ns  x%-6.2f max probe %u\n",
+                    sizes[i],
+                    r.scan_ns,
+                    r.map_ns,
+                    speedup,
+                    static_cast<unsigned>(r.max_probe));
+        if (r.mismatches != 0) {
+            std::printf("FAIL: %s n=%zu: %llu lookups disagree\n",
+                        Shape::NAME,
+                        sizes[i],
+                        static_cast<unsigned long long>(r.mismatches));
+            ok = false;
+        }
+        if (opts.gate_size != 0 && sizes[i] >= opts.gate_size && speedup < opts.min_speedup) {
+            std::printf("FAIL: %s n=%zu: speedup %.2f (limit %.2f)\n",
+                        Shape::NAME,
+                        sizes[i],
+                        speedup,
+                        opts.min_speedup);
+            ok = false;
+        }
+    }
+    return ok;
+}
+
+int main(int argc, char** argv)
+{
+    BenchOptions opts;
+    if (!parse_args(argc, argv, opts)) {
+        print_usage(argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    uint64_t rng = opts.seed * 0x9E3779B97F4A7C15ULL + 1;
+    std::printf("lookups %u per size, seed %llu, miss %u%%\n\n",
+                static_cast<unsigned>(opts.lookups),
+                static_cast<unsigned long long>(opts.seed),
+                static_cast<unsigned>(opts.miss_pct));
+
+    bool ok = true;
+    ok &= run_shape<ConfigShape, 8, 16, 32, 64, 256>(opts, rng);
+    ok &= run_shape<MacShape, 8, 20, 64, 256, 1024>(opts, rng);
+    ok &= run_shape<MeterShape, 8, 64, 256, 1024>(opts, rng);
+    return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
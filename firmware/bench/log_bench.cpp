@@ -0,0 +1,307 @@
+/**
+ * @file log_bench.cpp
+ * @author zuudevs (zuudevs@gmail.com)
+ * @brief Per-call cost of deferred binary logging against formatted logging
+ * @version 1.0
+ * @date 2026-03-21
+ *
+ * Times the same hot-path log line three ways: GS_DLOGI (record into the
+ * ring), the native ESP_LOGI shim (fprintf, here to /dev/null) and the
+ * ESP-IDF cost on a device, which is formatting plus the UART at 115200
+ * baud (reported from the measured line length). Every deferred record is
+ * drained and compared with the formatted text, so a wrong encoding fails
+ * the run. --threads N adds a multi-producer run: N threads log numbered
+ * records while one consumer drains; every record must arrive once and in
+ * per-thread order, or be counted as dropped.
+ *
+ *   gridshield_log_bench [--calls N] [--threads N] [--dump FILE]
+ *       [--min-speedup R] [--max-deferred-ns N]
+ *
+ * --dump writes one drain_raw() batch for native/log_decode.cpp.
+ *
+ * @copyright Copyright (c) 2026
+ */
+
+#include "utils/deferred_log.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+
+using namespace gridshield;
+
+// ============================================================================
+// OPTIONS
+// ============================================================================
+static constexpr char TAG[] = "GS_Bench";
+static constexpr uint32_t BATCH = 64; // records per timed batch (fits the ring)
+static constexpr uint32_t MAX_THREADS = 8;
+static constexpr double UART_BAUD = 115200.0;
+static constexpr double UART_BITS_PER_BYTE = 10.0;
+
+struct BenchOptions
+{
+    uint32_t calls{200000};
+    uint32_t threads{0};
+    const char* dump{nullptr};
+    double min_speedup{-1.0};
+    double max_deferred_ns{-1.0};
+};
+
+static void print_usage(const char* argv0)
+{
+    std::printf("usage: %s [--calls N] [--threads N] [--dump FILE]\n"
+                "          [--min-speedup R] [--max-deferred-ns N]\n",
+                argv0);
+}
+
+static bool parse_args(int argc, char** argv, BenchOptions& opts)
+{
+    for (int i = 1; i < argc; ++i) {
+        const char* arg = argv[i];
+        const char* value = (i + 1 < argc) ? argv[i + 1] : nullptr;
+        if (value == nullptr) {
+            return false;
+        }
+        if (std::strcmp(arg, "--calls") == 0) {
+            opts.calls = static_cast<uint32_t>(std::strtoul(value, nullptr, 10));
+        } else if (std::strcmp(arg, "--threads") == 0) {
+            opts.threads = static_cast<uint32_t>(std::strtoul(value, nullptr, 10));
+        } else if (std::strcmp(arg, "--dump") == 0) {
+            opts.dump = value;
+        } else if (std::strcmp(arg, "--min-speedup") == 0) {
+            opts.min_speedup = std::strtod(value, nullptr);
+        } else if (std::strcmp(arg, "--max-deferred-ns") == 0) {
+            opts.max_deferred_ns = std::strtod(value, nullptr);
+        } else {
+            return false;
+        }
+        ++i;
+    }
+    return opts.calls >= BATCH && opts.threads <= MAX_THREADS;
+}
+
+static uint64_t elapsed_ns(std::chrono::steady_clock::time_point start)
+{
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                     std::chrono::steady_clock::now() - start)
+                                     .count());
+}
+
+// ============================================================================
+// SINGLE PRODUCER: COST AND FIDELITY
+// ============================================================================
+struct Sample
+{
+    unsigned long long meter;
+    unsigned seq;
+    int power;
+    double pf;
+};
+
+static Sample sample_for(uint32_t i)
+{
+    return Sample{0x4753000000000000ULL + i, i, static_cast<int>(i % 5000) - 2500,
+                  0.5 + (i % 50) / 100.0};
+}
+
+#define BENCH_FMT "reading meter=0x%llx seq=%u power=%dW pf=%.2f"
+
+struct CheckState
+{
+    uint32_t next{0};
+    uint64_t mismatches{0};
+    uint64_t bytes{0};
+};
+
+static void check_line(void* ctx, const utils::DeferredLogLine& line)
+{
+    auto* state = static_cast<CheckState*>(ctx);
+    const Sample s = sample_for(state->next++);
+    char expected[utils::DLOG_LINE_SIZE];
+    const int n = std::snprintf(expected, sizeof(expected), BENCH_FMT, s.meter, s.seq, s.power,
+                                s.pf);
+    state->bytes += static_cast<uint64_t>(n) + line.tag_len + 6; // "I (" tag ") " ... "\n"
+    if (std::strcmp(expected, line.text) != 0 || line.level != 'I' ||
+        line.tag_len != sizeof(TAG) - 1 || std::strncmp(line.tag, TAG, line.tag_len) != 0) {
+        if (state->mismatches++ == 0) {
+            std::printf("  mismatch: \"%s\" vs \"%s\"\n", line.text, expected);
+        }
+    }
+}
+
+static std::atomic<uint32_t> clock_ticks{0};
+static uint32_t bench_clock()
+{
+    return clock_ticks.fetch_add(1, std::memory_order_relaxed) + 1;
+}
+
+// ============================================================================
+// MULTI PRODUCER
+// ============================================================================
+struct OrderState
+{
+    uint32_t last[MAX_THREADS]{};
+    uint64_t received{0};
+    uint64_t out_of_order{0};
+};
+
+static void check_order(void* ctx, const utils::DeferredLogLine& line)
+{
+    auto* state = static_cast<OrderState*>(ctx);
+    unsigned thread = 0;
+    unsigned seq = 0;
+    if (std::sscanf(line.text, "t%u n%u", &thread, &seq) != 2 || thread >= MAX_THREADS ||
+        seq <= state->last[thread]) {
+        ++state->out_of_order;
+        return;
+    }
+    state->last[thread] = seq;
+    ++state->received;
+}
+
+static bool run_threads(const BenchOptions& opts)
+{
+    auto& log = utils::deferred_log();
+    const utils::DeferredLogStats before = log.stats();
+    std::atomic<uint32_t> running{opts.threads};
+    std::thread producers[MAX_THREADS];
+    for (uint32_t t = 0; t < opts.threads; ++t) {
+        producers[t] = std::thread([t, &opts, &running]() {
+            auto& ring = utils::deferred_log();
+            for (uint32_t n = 1; n <= opts.calls; ++n) {
+                // Pace to the consumer so most records are delivered, not dropped
+                while (ring.pending_words() > ring.capacity_words() / 2) {
+                    std::this_thread::yield();
+                }
+                GS_DLOGI(TAG, "t%u n%u", static_cast<unsigned>(t), static_cast<unsigned>(n));
+            }
+            running.fetch_sub(1);
+        });
+    }
+    OrderState state;
+    while (running.load() != 0) {
+        (void)log.drain(&check_order, &state);
+    }
+    for (uint32_t t = 0; t < opts.threads; ++t) {
+        producers[t].join();
+    }
+    (void)log.drain(&check_order, &state);
+
+    const utils::DeferredLogStats after = log.stats();
+    const uint64_t dropped = after.dropped - before.dropped;
+    const uint64_t total = static_cast<uint64_t>(opts.calls) * opts.threads;
+    std::printf("\n%u producers x %u records: received %llu, dropped %llu on a full ring\n",
+                static_cast<unsigned>(opts.threads),
+                static_cast<unsigned>(opts.calls),
+                static_cast<unsigned long long>(state.received),
+                static_cast<unsigned long long>(dropped));
+    if (state.out_of_order != 0 || state.received + dropped != total) {
+        std::printf("FAIL: %llu out of order, %llu lost\n",
+                    static_cast<unsigned long long>(state.out_of_order),
+                    static_cast<unsigned long long>(total - state.received - dropped));
+        return false;
+    }
+    return true;
+}
+
+// ============================================================================
+// RUN
+// ============================================================================
+int main(int argc, char** argv)
+{
+    BenchOptions opts;
+    if (!parse_args(argc, argv, opts)) {
+        print_usage(argv[0]);
+        return EXIT_FAILURE;
+    }
+    FILE* devnull = std::fopen("/dev/null", "w");
+    if (devnull == nullptr) {
+        std::printf("cannot open /dev/null\n");
+        return EXIT_FAILURE;
+    }
+    auto& log = utils::deferred_log();
+    log.set_clock(&bench_clock);
+
+    const uint32_t batches = opts.calls / BATCH;
+    uint64_t deferred_ns = 0;
+    uint64_t formatted_ns = 0;
+    CheckState check;
+    bool dumped = false;
+
+    for (uint32_t b = 0; b < batches; ++b) {
+        auto start = std::chrono::steady_clock::now();
+        for (uint32_t i = 0; i < BATCH; ++i) {
+            const Sample s = sample_for(b * BATCH + i);
+            GS_DLOGI(TAG, BENCH_FMT, s.meter, s.seq, s.power, s.pf);
+        }
+        deferred_ns += elapsed_ns(start);
+
+        start = std::chrono::steady_clock::now();
+        for (uint32_t i = 0; i < BATCH; ++i) {
+            const Sample s = sample_for(b * BATCH + i);
+            // What the native ESP_LOGI shim does
+            std::fprintf(devnull, "I (%s) " BENCH_FMT "\n", TAG, s.meter, s.seq, s.power, s.pf);
+        }
+        formatted_ns += elapsed_ns(start);
+
+        if (opts.dump != nullptr && !dumped) {
+            static uint8_t raw[GS_DLOG_RING_WORDS * 4];
+            const size_t n = log.drain_raw(raw, sizeof(raw));
+            FILE* f = std::fopen(opts.dump, "wb");
+            if (f == nullptr || std::fwrite(raw, 1, n, f) != n) {
+                std::printf("cannot write %s\n", opts.dump);
+                return EXIT_FAILURE;
+            }
+            std::fclose(f);
+            check.next += BATCH;
+            dumped = true;
+            continue;
+        }
+        (void)log.drain(&check_line, &check);
+    }
+    std::fclose(devnull);
+
+    const uint64_t calls = static_cast<uint64_t>(batches) * BATCH;
+    const double deferred = static_cast<double>(deferred_ns) / calls;
+    const double formatted = static_cast<double>(formatted_ns) / calls;
+    const double line_bytes = check.next == 0 ? 0.0 : static_cast<double>(check.bytes) / check.next;
+    const double uart_ns = line_bytes * UART_BITS_PER_BYTE / UART_BAUD * 1e9;
+    const double speedup = deferred > 0.0 ? formatted / deferred : 0.0;
+    const utils::DeferredLogStats stats = log.stats();
+
+    std::printf("%llu calls, %.1f-byte lines\n\n",
+                static_cast<unsigned long long>(calls),
+                line_bytes);
+    std::printf("  GS_DLOGI (deferred):        %8.1f ns/call\n", deferred);
+    std::printf("  ESP_LOGI shim (formatted):  %8.1f ns/call  x%.1f\n", formatted, speedup);
+    std::printf("  + UART @115200 on device:   %8.0f us/call  x%.0f\n",
+                (formatted + uart_ns) / 1e3,
+                deferred > 0.0 ? (formatted + uart_ns) / deferred : 0.0);
+    std::printf("  recorded %u, dropped %u\n",
+                static_cast<unsigned>(stats.recorded),
+                static_cast<unsigned>(stats.dropped));
+
+    bool ok = true;
+    if (check.mismatches != 0 || stats.dropped != 0) {
+        std::printf("FAIL: %llu records formatted differently, %u dropped\n",
+                    static_cast<unsigned long long>(check.mismatches),
+                    static_cast<unsigned>(stats.dropped));
+        ok = false;
+    }
+    if (opts.min_speedup >= 0.0 && speedup < opts.min_speedup) {
+        std::printf("FAIL: speedup %.2f (limit %.2f)\n", speedup, opts.min_speedup);
+        ok = false;
+    }
+    if (opts.max_deferred_ns >= 0.0 && deferred > opts.max_deferred_ns) {
+        std::printf("FAIL: deferred %.1f ns/call (limit %.1f)\n", deferred, opts.max_deferred_ns);
+        ok = false;
+    }
+    if (opts.threads > 0) {
+        ok &= run_threads(opts);
+    }
+    return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,234 @@
+/**
+ * @file replay_bench.cpp
+ * @author zuudevs (zuudevs@gmail.com)
+ * @brief Anti-replay lookup throughput at gateway scale
+ * @version 1.0
+ * @date 2026-03-18
+ *
+ * Drives network::ReplayGuard with a fleet of senders the way a head-end
+ * or gateway sees them: every round each sender sends once, in shuffled
+ * order; a fraction of frames arrive reordered (inside the window) and a
+ * fraction are followed by a replay of themselves. Reports lookups per
+ * second for the admission round and for steady state, and fails if a
+ * replay was accepted or a fresh frame rejected. A fleet larger than the
+ * table (131072 senders) exercises LRU eviction and backward-shift
+ * deletion on every lookup.
+ *
+ *   gridshield_replay_bench [--senders N] [--rounds N] [--seed N]
+ *       [--replay-pct P] [--reorder-pct P] [--min-mlookups-per-s R]
+ *
+ * @copyright Copyright (c) 2026
+ */
+
+#include "network/replay_guard.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+using namespace gridshield;
+
+// ============================================================================
+// OPTIONS
+// ============================================================================
+static constexpr size_t GUARD_CAPACITY = 131072;
+static constexpr size_t MAX_SENDERS = 2 * GUARD_CAPACITY;
+static constexpr core::meter_id_t METER_ID_BASE = 0x4753000000000000ULL;
+
+struct BenchOptions
+{
+    uint32_t senders{10000};
+    uint32_t rounds{50};
+    uint64_t seed{1};
+    uint32_t replay_pct{5};
+    uint32_t reorder_pct{10};
+    double min_mlookups_per_s{-1.0};
+};
+
+static void print_usage(const char* argv0)
+{
+    std::printf("usage: %s [--senders N] [--rounds N] [--seed N]\n"
+                "          [--replay-pct P] [--reorder-pct P] [--min-mlookups-per-s R]\n",
+                argv0);
+}
+
+static bool parse_args(int argc, char** argv, BenchOptions& opts)
+{
+    for (int i = 1; i < argc; ++i) {
+        const char* arg = argv[i];
+        const char* value = (i + 1 < argc) ? argv[i + 1] : nullptr;
+        if (value == nullptr) {
+            return false;
+        }
+        if (std::strcmp(arg, "--senders") == 0) {
+            opts.senders = static_cast<uint32_t>(std::strtoul(value, nullptr, 10));
+        } else if (std::strcmp(arg, "--rounds") == 0) {
+            opts.rounds = static_cast<uint32_t>(std::strtoul(value, nullptr, 10));
+        } else if (std::strcmp(arg, "--seed") == 0) {
+            opts.seed = std::strtoull(value, nullptr, 10);
+        } else if (std::strcmp(arg, "--replay-pct") == 0) {
+            opts.replay_pct = static_cast<uint32_t>(std::strtoul(value, nullptr, 10));
+        } else if (std::strcmp(arg, "--reorder-pct") == 0) {
+            opts.reorder_pct = static_cast<uint32_t>(std::strtoul(value, nullptr, 10));
+        } else if (std::strcmp(arg, "--min-mlookups-per-s") == 0) {
+            opts.min_mlookups_per_s = std::strtod(value, nullptr);
+        } else {
+            return false;
+        }
+        ++i;
+    }
+    return opts.senders > 0 && opts.senders <= MAX_SENDERS && opts.rounds > 1 &&
+           opts.replay_pct <= 100 && opts.reorder_pct <= 100;
+}
+
+// ============================================================================
+// TRAFFIC
+// ============================================================================
+struct Frame
+{
+    core::meter_id_t meter_id;
+    core::sequence_t seq;
+    bool replay; // must be rejected
+};
+
+struct SenderState
+{
+    core::sequence_t next{1};
+    core::sequence_t delayed{0}; // held back by a reorder, sent on the next visit
+};
+
+static uint64_t next_random(uint64_t& state)
+{
+    // xorshift64*
+    state ^= state >> 12;
+    state ^= state << 25;
+    state ^= state >> 27;
+    return state * 0x2545F4914F6CDD1DULL;
+}
+
+static uint32_t order[MAX_SENDERS];
+static SenderState senders[MAX_SENDERS];
+static Frame frames[2 * MAX_SENDERS];
+static network::ReplayVerdict verdicts[2 * MAX_SENDERS];
+static network::ReplayGuard<GUARD_CAPACITY> guard;
+
+/// One round of traffic: every sender once (plus replays), shuffled.
+static size_t generate_round(const BenchOptions& opts, uint64_t& rng)
+{
+    for (uint32_t i = opts.senders; i-- > 1;) {
+        const auto j = static_cast<uint32_t>(next_random(rng) % (i + 1));
+        const uint32_t tmp = order[i];
+        order[i] = order[j];
+        order[j] = tmp;
+    }
+    size_t count = 0;
+    for (uint32_t i = 0; i < opts.senders; ++i) {
+        const uint32_t s = order[i];
+        SenderState& st = senders[s];
+        core::sequence_t seq = 0;
+        if (st.delayed != 0) {
+            seq = st.delayed;
+            st.delayed = 0;
+        } else if (next_random(rng) % 100 < opts.reorder_pct) {
+            // seq+1 overtakes seq
+            seq = st.next + 1;
+            st.delayed = st.next;
+            st.next += 2;
+        } else {
+            seq = st.next++;
+        }
+        const core::meter_id_t meter_id = METER_ID_BASE | s;
+        frames[count++] = Frame{meter_id, seq, false};
+        if (next_random(rng) % 100 < opts.replay_pct) {
+            frames[count++] = Frame{meter_id, seq, true};
+        }
+    }
+    return count;
+}
+
+// ============================================================================
+// RUN
+// ============================================================================
+int main(int argc, char** argv)
+{
+    BenchOptions opts;
+    if (!parse_args(argc, argv, opts)) {
+        print_usage(argv[0]);
+        return EXIT_FAILURE;
+    }
+    for (uint32_t s = 0; s < opts.senders; ++s) {
+        order[s] = s;
+    }
+
+    uint64_t rng = opts.seed * 0x9E3779B97F4A7C15ULL + 1;
+    uint64_t wrong_accepts = 0; // replays let through
+    uint64_t wrong_rejects = 0; // fresh frames refused
+    uint64_t admit_lookups = 0;
+    uint64_t admit_ns = 0;
+    uint64_t steady_lookups = 0;
+    uint64_t steady_ns = 0;
+
+    for (uint32_t round = 0; round < opts.rounds; ++round) {
+        const size_t count = generate_round(opts, rng);
+
+        const auto start = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < count; ++i) {
+            verdicts[i] = guard.check_and_update(frames[i].meter_id, frames[i].seq);
+        }
+        const auto ns = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                                  std::chrono::steady_clock::now() - start)
+                                                  .count());
+
+        for (size_t i = 0; i < count; ++i) {
+            const bool accepted = verdicts[i] == network::ReplayVerdict::Accepted;
+            wrong_accepts += (frames[i].replay && accepted) ? 1U : 0U;
+            wrong_rejects += (!frames[i].replay && !accepted) ? 1U : 0U;
+        }
+        if (round == 0) {
+            admit_lookups += count;
+            admit_ns += ns;
+        } else {
+            steady_lookups += count;
+            steady_ns += ns;
+        }
+    }
+
+    const auto& stats = guard.stats();
+    const double admit_rate = admit_ns == 0 ? 0.0 : 1e3 * admit_lookups / admit_ns;
+    const double steady_rate = steady_ns == 0 ? 0.0 : 1e3 * steady_lookups / steady_ns;
+
+    std::printf("senders %u (table %zu), rounds %u, seed %llu, replay %u%%, reorder %u%%\n\n",
+                static_cast<unsigned>(opts.senders),
+                GUARD_CAPACITY,
+                static_cast<unsigned>(opts.rounds),
+                static_cast<unsigned long long>(opts.seed),
+                static_cast<unsigned>(opts.replay_pct),
+                static_cast<unsigned>(opts.reorder_pct));
+    std::printf("  admission: %llu lookups, %.2f M/s (%.1f ns each)\n",
+                static_cast<unsigned long long>(admit_lookups),
+                admit_rate,
+                admit_lookups == 0 ? 0.0 : static_cast<double>(admit_ns) / admit_lookups);
+    std::printf("  steady:    %llu lookups, %.2f M/s (%.1f ns each)\n",
+                static_cast<unsigned long long>(steady_lookups),
+                steady_rate,
+                steady_lookups == 0 ? 0.0 : static_cast<double>(steady_ns) / steady_lookups);
+    std::printf("  accepted %u, duplicates %u, too old %u, evictions %u\n",
+                static_cast<unsigned>(stats.accepted),
+                static_cast<unsigned>(stats.duplicates),
+                static_cast<unsigned>(stats.too_old),
+                static_cast<unsigned>(stats.evictions));
+
+    bool ok = wrong_accepts == 0 && wrong_rejects == 0;
+    if (!ok) {
+        std::printf("FAIL: %llu replays accepted, %llu fresh frames lost\n",
+                    static_cast<unsigned long long>(wrong_accepts),
+                    static_cast<unsigned long long>(wrong_rejects));
+    }
+    if (opts.min_mlookups_per_s >= 0.0 && steady_rate < opts.min_mlookups_per_s) {
+        std::printf("FAIL: steady lookups %.3f M/s (limit %.3f)\n", steady_rate,
+                    opts.min_mlookups_per_s);
+        ok = false;
+    }
+    return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,270 @@
+/**
+ * @file report_bench.cpp
+ * @author zuudevs (zuudevs@gmail.com)
+ * @brief Report-by-exception replay: airtime saved vs reconstruction error
+ * @version 1.0
+ * @date 2026-03-17
+ *
+ * Replays a TheftDatasetGenerator trace through network::ReportPolicy the
+ * way GridShieldSystem::send_meter_reading() does (urgent = profile
+ * detector alert at severity >= High) and reconstructs the server's view
+ * by holding the last reported reading. Reports the transmitted-bytes
+ * reduction against sending every reading, the energy reconstruction error
+ * (running total and per interval) and the worst held-value error of the
+ * instantaneous fields. With threshold flags set, any miss exits non-zero.
+ *
+ *   gridshield_report_bench [--kind household|commercial] [--seed N]
+ *       [--days N] [--interval S] [--energy-bound WH] [--max-silence-min M]
+ *       [--min-reduction R] [--max-energy-error-wh E]
+ *
+ * @copyright Copyright (c) 2026
+ */
+
+#include "analytics/detector.hpp"
+#include "network/packet.hpp"
+#include "network/report_policy.hpp"
+#include "theft_dataset.hpp"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+using namespace gridshield;
+using namespace gridshield::bench;
+
+// ============================================================================
+// OPTIONS
+// ============================================================================
+struct BenchOptions
+{
+    DatasetConfig dataset{};
+    network::ReportPolicyConfig policy{};
+    double min_reduction{-1.0};
+    double max_energy_error_wh{-1.0};
+};
+
+static void print_usage(const char* argv0)
+{
+    std::printf("usage: %s [--kind household|commercial] [--seed N] [--days N] [--interval S]\n"
+                "          [--energy-bound WH] [--max-silence-min M]\n"
+                "          [--min-reduction R] [--max-energy-error-wh E]\n",
+                argv0);
+}
+
+static bool parse_args(int argc, char** argv, BenchOptions& opts)
+{
+    for (int i = 1; i < argc; ++i) {
+        const char* arg = argv[i];
+        const char* value = (i + 1 < argc) ? argv[i + 1] : nullptr;
+        if (value == nullptr) {
+            return false;
+        }
+        if (std::strcmp(arg, "--kind") == 0) {
+            if (std::strcmp(value, "household") == 0) {
+                opts.dataset.kind = LoadKind::Household;
+            } else if (std::strcmp(value, "commercial") == 0) {
+                opts.dataset.kind = LoadKind::Commercial;
+            } else {
+                return false;
+            }
+        } else if (std::strcmp(arg, "--seed") == 0) {
+            opts.dataset.seed = std::strtoull(value, nullptr, 10);
+        } else if (std::strcmp(arg, "--days") == 0) {
+            opts.dataset.days = static_cast<uint32_t>(std::strtoul(value, nullptr, 10));
+        } else if (std::strcmp(arg, "--interval") == 0) {
+            opts.dataset.interval_s = static_cast<uint32_t>(std::strtoul(value, nullptr, 10));
+        } else if (std::strcmp(arg, "--energy-bound") == 0) {
+            opts.policy.energy_error_bound_wh =
+                static_cast<uint32_t>(std::strtoul(value, nullptr, 10));
+        } else if (std::strcmp(arg, "--max-silence-min") == 0) {
+            opts.policy.max_silence_ms =
+                static_cast<uint32_t>(std::strtoul(value, nullptr, 10)) * 60000U;
+        } else if (std::strcmp(arg, "--min-reduction") == 0) {
+            opts.min_reduction = std::strtod(value, nullptr);
+        } else if (std::strcmp(arg, "--max-energy-error-wh") == 0) {
+            opts.max_energy_error_wh = std::strtod(value, nullptr);
+        } else {
+            return false;
+        }
+        ++i;
+    }
+    return true;
+}
+
+// ============================================================================
+// METRICS
+// ============================================================================
+struct ReplayMetrics
+{
+    uint64_t readings{0};
+    uint64_t alerts{0};
+    uint64_t alerts_unsent{0}; // must stay 0
+    int64_t actual_wh{0};
+    int64_t server_wh{0};
+    int64_t max_total_error_wh{0};
+    uint64_t abs_interval_error_wh{0};
+    uint32_t max_voltage_error_mv{0};
+    uint32_t max_current_error_ma{0};
+};
+
+static uint32_t abs_diff(uint32_t a, uint32_t b)
+{
+    return a > b ? a - b : b - a;
+}
+
+static const char* reason_name(network::ReportReason reason)
+{
+    switch (reason) {
+    case network::ReportReason::Suppressed:
+        return "suppressed";
+    case network::ReportReason::Disabled:
+        return "disabled";
+    case network::ReportReason::First:
+        return "first";
+    case network::ReportReason::Urgent:
+        return "urgent";
+    case network::ReportReason::Heartbeat:
+        return "heartbeat";
+    case network::ReportReason::Deadband:
+        return "deadband";
+    case network::ReportReason::IntegralError:
+        return "integral";
+    default:
+        return "?";
+    }
+}
+
+// ============================================================================
+// RUN
+// ============================================================================
+static TheftDatasetGenerator generator;
+
+int main(int argc, char** argv)
+{
+    BenchOptions opts;
+    opts.policy.enabled = true;
+    if (!parse_args(argc, argv, opts)) {
+        print_usage(argv[0]);
+        return EXIT_FAILURE;
+    }
+    if (!generator.init(opts.dataset)) {
+        std::fprintf(stderr, "invalid dataset configuration\n");
+        return EXIT_FAILURE;
+    }
+
+    // One signed MeterData frame on the wire
+    static constexpr size_t FRAME_BYTES = sizeof(network::PacketHeader) +
+                                          sizeof(core::MeterReading) +
+                                          sizeof(network::PacketFooter);
+
+    analytics::AnomalyDetector detector;
+    (void)detector.initialize(analytics::ConsumptionProfile{});
+    network::ReportPolicy policy(opts.policy);
+    ReplayMetrics m;
+
+    const uint32_t warmup = generator.warmup_samples();
+    core::MeterReading held{};
+    LabeledSample sample;
+    uint32_t index = 0;
+    while (generator.next(sample)) {
+        const core::MeterReading& r = sample.reading;
+        bool urgent = false;
+        if (index++ >= warmup) {
+            auto report = detector.analyze(r);
+            urgent = report.is_ok() && report.value().severity >= analytics::AnomalySeverity::High;
+        }
+        (void)detector.update_profile(r);
+
+        const network::ReportReason reason = policy.evaluate(r, urgent);
+        if (reason != network::ReportReason::Suppressed) {
+            held = policy.outgoing(r);
+            policy.commit(r, held);
+        }
+        m.alerts += urgent ? 1U : 0U;
+        m.alerts_unsent += (urgent && reason == network::ReportReason::Suppressed) ? 1U : 0U;
+
+        // Server view: the held reading stands in for this interval
+        ++m.readings;
+        m.actual_wh += r.energy_wh;
+        m.server_wh += held.energy_wh;
+        const int64_t total_error = m.actual_wh - m.server_wh;
+        const int64_t total_mag = total_error < 0 ? -total_error : total_error;
+        m.max_total_error_wh = total_mag > m.max_total_error_wh ? total_mag : m.max_total_error_wh;
+        m.abs_interval_error_wh += abs_diff(r.energy_wh, held.energy_wh);
+        const uint32_t dv = abs_diff(r.voltage_mv, held.voltage_mv);
+        const uint32_t di = abs_diff(r.current_ma, held.current_ma);
+        m.max_voltage_error_mv = dv > m.max_voltage_error_mv ? dv : m.max_voltage_error_mv;
+        m.max_current_error_ma = di > m.max_current_error_ma ? di : m.max_current_error_ma;
+    }
+
+    const auto& stats = policy.stats();
+    const uint64_t baseline_bytes = m.readings * FRAME_BYTES;
+    const uint64_t sent_bytes = static_cast<uint64_t>(stats.sent) * FRAME_BYTES;
+    const double reduction =
+        baseline_bytes == 0 ? 0.0 : 1.0 - static_cast<double>(sent_bytes) / baseline_bytes;
+    const double mean_interval_error =
+        m.readings == 0 ? 0.0 : static_cast<double>(m.abs_interval_error_wh) / m.readings;
+    const double energy_total_pct =
+        m.actual_wh == 0 ? 0.0
+                         : 100.0 * static_cast<double>(m.actual_wh - m.server_wh) / m.actual_wh;
+
+    std::printf("dataset: %s, seed %llu, %u days @ %us (%llu readings)\n",
+                opts.dataset.kind == LoadKind::Household ? "household" : "commercial",
+                static_cast<unsigned long long>(opts.dataset.seed),
+                static_cast<unsigned>(opts.dataset.days),
+                static_cast<unsigned>(opts.dataset.interval_s),
+                static_cast<unsigned long long>(m.readings));
+    std::printf("policy: energy bound %u Wh, max silence %u min\n\n",
+                static_cast<unsigned>(opts.policy.energy_error_bound_wh),
+                static_cast<unsigned>(opts.policy.max_silence_ms / 60000U));
+
+    for (size_t reason = 0; reason < static_cast<size_t>(network::ReportReason::COUNT);
+         ++reason) {
+        if (stats.by_reason[reason] != 0) {
+            std::printf("  %-11s %8u\n",
+                        reason_name(static_cast<network::ReportReason>(reason)),
+                        static_cast<unsigned>(stats.by_reason[reason]));
+        }
+    }
+    std::printf("\n  sent %u/%llu frames, %llu of %llu bytes: %.1f%% reduction\n",
+                static_cast<unsigned>(stats.sent),
+                static_cast<unsigned long long>(m.readings),
+                static_cast<unsigned long long>(sent_bytes),
+                static_cast<unsigned long long>(baseline_bytes),
+                reduction * 100.0);
+    std::printf("  energy: max running-total error %lld Wh, final %+.4f%%, "
+                "mean |interval error| %.1f Wh\n",
+                static_cast<long long>(m.max_total_error_wh), energy_total_pct,
+                mean_interval_error);
+    std::printf("  held-value error: voltage <= %u mV, current <= %u mA\n",
+                static_cast<unsigned>(m.max_voltage_error_mv),
+                static_cast<unsigned>(m.max_current_error_ma));
+    const uint64_t quiet = m.readings - m.alerts;
+    std::printf("  alerts %llu (all sent immediately, %llu suppressed); "
+                "without alerts %.1f%% of readings suppressed\n",
+                static_cast<unsigned long long>(m.alerts),
+                static_cast<unsigned long long>(m.alerts_unsent),
+                quiet == 0 ? 0.0 : 100.0 * static_cast<double>(stats.suppressed()) / quiet);
+
+    // Thresholds (negative = not checked); a suppressed alert always fails
+    bool ok = m.alerts_unsent == 0;
+    if (!ok) {
+        std::printf("FAIL: %llu alert readings were suppressed\n",
+                    static_cast<unsigned long long>(m.alerts_unsent));
+    }
+    auto check = [&ok](bool pass, const char* what, double got, double limit) {
+        if (!pass) {
+            std::printf("FAIL: %s %.3f (limit %.3f)\n", what, got, limit);
+            ok = false;
+        }
+    };
+    if (opts.min_reduction >= 0.0) {
+        check(reduction >= opts.min_reduction, "byte reduction", reduction, opts.min_reduction);
+    }
+    if (opts.max_energy_error_wh >= 0.0) {
+        check(static_cast<double>(m.max_total_error_wh) <= opts.max_energy_error_wh,
+              "energy total error (Wh)", static_cast<double>(m.max_total_error_wh),
+              opts.max_energy_error_wh);
+    }
+    return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,471 @@
+/**
+ * @file shadow_bench.cpp
+ * @author zuudevs (zuudevs@gmail.com)
+ * @brief Shadow / twin messages and bytes per hour: full document vs diffs
+ * @version 1.0
+ * @date 2026-04-01
+ *
+ * Replays a day of the seeded synthetic load (theft_dataset.hpp, 5-min
+ * samples interpolated to the reading cadence with measurement noise, a
+ * cumulative energy register and a daily temperature swing) through
+ * AwsIotConnector and AzureIotConnector. A few tamper events flip the
+ * tamper flag, and the desired state is changed from the cloud side four
+ * times; half of those deltas reach the device before its next report,
+ * the rest arrive two minutes late. On AWS the report racing a late delta
+ * is rejected as a version conflict and the delta itself is then stale;
+ * Azure reported patches are unversioned and simply apply it late.
+ *
+ * Setups, per connector:
+ *   full      whole reported document on every reading (previous behaviour)
+ *   exact     merge patch of fields that changed at all, sent at once
+ *   deadband  merge patch of fields outside their deadbands, sent at once
+ *   managed   deadbands plus a coalescing window (default 60 s)
+ *
+ * Messages count patches plus document fetches after a conflict. After a
+ * final flush every setup must have left nothing outside its bands unsent,
+ * the device must hold the cloud's desired state and tamper changes must
+ * reach the cloud on the reading that saw them.
+ *
+ *   gridshield_shadow_bench [--kind household|commercial] [--seed N]
+ *       [--reading-interval S] [--window S]
+ *       [--max-messages-per-hour M] [--max-bytes-per-hour B]
+ *
+ * @copyright Copyright (c) 2026
+ */
+
+#include "cloud/aws_iot.hpp"
+#include "cloud/azure_iot.hpp"
+#include "cloud/shadow_sync.hpp"
+#include "theft_dataset.hpp"
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+using namespace gridshield;
+using namespace gridshield::bench;
+using namespace gridshield::cloud;
+
+// ============================================================================
+// OPTIONS
+// ============================================================================
+static constexpr uint32_t DAY_S = 86400;
+static constexpr uint32_t SAMPLE_S = 300;
+static constexpr size_t SAMPLES = DAY_S / SAMPLE_S;
+static constexpr size_t MAX_READINGS = DAY_S; // 1 s cadence
+static constexpr size_t TAMPER_EVENTS = 3;
+static constexpr size_t DESIRED_CHANGES = 4;
+static constexpr uint64_t DELTA_LAG_MS = 120000; // undelivered deltas show up this late
+
+struct BenchOptions
+{
+    LoadKind kind{LoadKind::Household};
+    uint64_t seed{1};
+    uint32_t reading_interval_s{5}; // demo_main.cpp READING_INTERVAL_S
+    uint32_t window_s{60};
+    double max_messages_per_hour{-1.0}; // managed, AWS
+    double max_bytes_per_hour{-1.0};    // managed, AWS
+};
+
+static void print_usage(const char* argv0)
+{
+    std::printf("usage: %s [--kind household|commercial] [--seed N]\n"
+                "          [--reading-interval S] [--window S]\n"
+                "          [--max-messages-per-hour M] [--max-bytes-per-hour B]\n",
+                argv0);
+}
+
+static bool parse_args(int argc, char** argv, BenchOptions& opts)
+{
+    for (int i = 1; i < argc; ++i) {
+        const char* arg = argv[i];
+        const char* value = (i + 1 < argc) ? argv[i + 1] : nullptr;
+        if (value == nullptr) {
+            return false;
+        }
+        if (std::strcmp(arg, "--kind") == 0) {
+            if (std::strcmp(value, "household") == 0) {
+                opts.kind = LoadKind::Household;
+            } else if (std::strcmp(value, "commercial") == 0) {
+                opts.kind = LoadKind::Commercial;
+            } else {
+                return false;
+            }
+        } else if (std::strcmp(arg, "--seed") == 0) {
+            opts.seed = std::strtoull(value, nullptr, 10);
+        } else if (std::strcmp(arg, "--reading-interval") == 0) {
+            opts.reading_interval_s = static_cast<uint32_t>(std::strtoul(value, nullptr, 10));
+        } else if (std::strcmp(arg, "--window") == 0) {
+            opts.window_s = static_cast<uint32_t>(std::strtoul(value, nullptr, 10));
+        } else if (std::strcmp(arg, "--max-messages-per-hour") == 0) {
+            opts.max_messages_per_hour = std::strtod(value, nullptr);
+        } else if (std::strcmp(arg, "--max-bytes-per-hour") == 0) {
+            opts.max_bytes_per_hour = std::strtod(value, nullptr);
+        } else {
+            return false;
+        }
+        ++i;
+    }
+    return opts.reading_interval_s > 0 && opts.reading_interval_s <= SAMPLE_S;
+}
+
+static uint64_t next_random(uint64_t& state)
+{
+    // xorshift64*
+    state ^= state >> 12;
+    state ^= state << 25;
+    state ^= state >> 27;
+    return state * 0x2545F4914F6CDD1DULL;
+}
+
+static uint32_t uniform(uint64_t& state, uint32_t lo, uint32_t hi)
+{
+    return lo + static_cast<uint32_t>(next_random(state) % (hi - lo + 1U));
+}
+
+/// Symmetric noise in [-span, span].
+static double jitter(uint64_t& state, double span)
+{
+    return span * (static_cast<double>(next_random(state) % 20001U) / 10000.0 - 1.0);
+}
+
+// ============================================================================
+// TRACE
+// ============================================================================
+struct Reading
+{
+    uint64_t t_ms{};
+    ReportedState state{};
+};
+
+struct DesiredChange
+{
+    uint64_t t_ms{};
+    DesiredState desired{};
+    bool delivered{}; // delta reaches the device before its next report
+};
+
+static LabeledSample samples[SAMPLES + 1];
+static Reading readings[MAX_READINGS];
+static size_t reading_count;
+static DesiredChange changes[DESIRED_CHANGES];
+
+static bool build_trace(const BenchOptions& opts)
+{
+    DatasetConfig dataset;
+    dataset.kind = opts.kind;
+    dataset.seed = opts.seed;
+    dataset.days = 3;
+    dataset.interval_s = SAMPLE_S;
+    dataset.warmup_days = 1;
+    dataset.attacks_per_type = 0;
+    TheftDatasetGenerator generator;
+    if (!generator.init(dataset)) {
+        return false;
+    }
+    // Day after the warm-up, plus the next day's first sample to interpolate to
+    LabeledSample sample;
+    for (size_t i = 0; i < SAMPLES; ++i) {
+        (void)generator.next(sample);
+    }
+    for (size_t i = 0; i <= SAMPLES && generator.next(sample); ++i) {
+        samples[i] = sample;
+    }
+
+    uint64_t rng = opts.seed * 0x9E3779B97F4A7C15ULL + 1;
+    uint32_t tamper_start[TAMPER_EVENTS];
+    uint32_t tamper_end[TAMPER_EVENTS];
+    for (size_t k = 0; k < TAMPER_EVENTS; ++k) {
+        tamper_start[k] = uniform(rng, 0, DAY_S - 1200);
+        tamper_end[k] = tamper_start[k] + uniform(rng, 120, 600);
+    }
+    for (size_t k = 0; k < DESIRED_CHANGES; ++k) {
+        changes[k].t_ms = (static_cast<uint64_t>(k) * DAY_S / DESIRED_CHANGES +
+                           uniform(rng, 600, DAY_S / DESIRED_CHANGES - 600)) *
+                          1000U;
+        changes[k].desired.reading_interval_ms = (k % 2 == 0) ? 10000U : 5000U;
+        changes[k].desired.ota_requested = k == DESIRED_CHANGES - 1;
+        changes[k].delivered = (k % 2) == 0;
+    }
+
+    reading_count = 0;
+    double energy_wh = 0.0;
+    for (uint32_t t = 0; t < DAY_S && reading_count < MAX_READINGS; t += opts.reading_interval_s) {
+        const size_t i = t / SAMPLE_S;
+        const double frac = static_cast<double>(t % SAMPLE_S) / SAMPLE_S;
+        const core::MeterReading& a = samples[i].reading;
+        const core::MeterReading& b = samples[i + 1].reading;
+        const double volts_mv =
+            (a.voltage_mv + (static_cast<double>(b.voltage_mv) - a.voltage_mv) * frac) *
+            (1.0 + jitter(rng, 0.002));
+        const double amps_ma =
+            (a.current_ma + (static_cast<double>(b.current_ma) - a.current_ma) * frac) *
+            (1.0 + jitter(rng, 0.01));
+        energy_wh += static_cast<double>(samples[i].reading.energy_wh) * opts.reading_interval_s /
+                     SAMPLE_S;
+        const double day_phase = 2.0 * 3.14159265358979 * (t / static_cast<double>(DAY_S) - 0.25);
+
+        Reading& r = readings[reading_count++];
+        r.t_ms = static_cast<uint64_t>(t) * 1000U;
+        r.state.voltage_mv = static_cast<uint32_t>(volts_mv);
+        r.state.current_ma = static_cast<uint32_t>(amps_ma < 0.0 ? 0.0 : amps_ma);
+        r.state.energy_wh = static_cast<uint32_t>(energy_wh);
+        r.state.temperature_c10 =
+            static_cast<int16_t>(250.0 + 60.0 * std::sin(day_phase) + jitter(rng, 2.0));
+        for (size_t k = 0; k < TAMPER_EVENTS; ++k) {
+            r.state.tamper_detected =
+                r.state.tamper_detected || (t >= tamper_start[k] && t < tamper_end[k]);
+        }
+    }
+    return true;
+}
+
+// ============================================================================
+// CONNECTOR GLUE
+// ============================================================================
+static void configure(AwsIotConnector& c, const ShadowSyncConfig& config)
+{
+    c.configure_shadow_sync(config);
+}
+static void configure(AzureIotConnector& c, const ShadowSyncConfig& config)
+{
+    c.configure_twin_sync(config);
+}
+static const ShadowSync& sync_of(const AwsIotConnector& c)
+{
+    return c.shadow_sync();
+}
+static const ShadowSync& sync_of(const AzureIotConnector& c)
+{
+    return c.twin_sync();
+}
+static void flush(AwsIotConnector& c, uint64_t now_ms)
+{
+    (void)c.flush_shadow(now_ms);
+}
+static void flush(AzureIotConnector& c, uint64_t now_ms)
+{
+    (void)c.flush_twin(now_ms);
+}
+static const ReportedState& cloud_reported(const AwsIotConnector& c)
+{
+    return c.shadow().reported;
+}
+static const ReportedState& cloud_reported(const AzureIotConnector& c)
+{
+    return c.twin().reported;
+}
+static const DesiredState& cloud_desired(const AwsIotConnector& c)
+{
+    return c.shadow().desired;
+}
+static const DesiredState& cloud_desired(const AzureIotConnector& c)
+{
+    return c.twin().desired;
+}
+static uint32_t cloud_version(const AwsIotConnector& c)
+{
+    return c.shadow().version;
+}
+static uint32_t cloud_version(const AzureIotConnector& c)
+{
+    return c.twin().version;
+}
+
+// ============================================================================
+// RUN
+// ============================================================================
+struct Outcome
+{
+    ShadowSyncStats stats{};
+    uint64_t worst_tamper_ms{};
+    bool consistent{};
+};
+
+template <typename Connector>
+static Outcome run(const ShadowSyncConfig& config)
+{
+    Outcome out;
+    Connector connector;
+    CloudConfig cloud{};
+    std::strncpy(cloud.endpoint.data(), "bench.iot.example.com", CLOUD_MAX_ENDPOINT_LENGTH - 1);
+    std::strncpy(cloud.device_id.data(), "gridshield_bench", CLOUD_MAX_DEVICE_ID_LENGTH - 1);
+    (void)connector.init(cloud);
+    (void)connector.connect();
+    configure(connector, config);
+
+    size_t next_change = 0;
+    uint32_t late_version = 0; // a delta held back by the broker
+    uint64_t late_at_ms = 0;
+    DesiredState late_desired{};
+    uint64_t tamper_since = 0;
+    bool tamper_pending = false;
+    bool tamper_state = false;
+
+    for (size_t i = 0; i < reading_count; ++i) {
+        const Reading& r = readings[i];
+        if (late_version != 0 && r.t_ms >= late_at_ms) {
+            (void)connector.apply_desired_delta(late_desired, late_version);
+            late_version = 0;
+        }
+        while (next_change < DESIRED_CHANGES && changes[next_change].t_ms <= r.t_ms) {
+            const DesiredChange& c = changes[next_change++];
+            connector.set_desired_state(c.desired);
+            if (c.delivered) {
+                (void)connector.apply_desired_delta(c.desired, cloud_version(connector));
+            } else {
+                late_desired = c.desired;
+                late_version = cloud_version(connector);
+                late_at_ms = r.t_ms + DELTA_LAG_MS;
+            }
+        }
+        if (r.state.tamper_detected != tamper_state) {
+            tamper_state = r.state.tamper_detected;
+            tamper_since = r.t_ms;
+            tamper_pending = true;
+        }
+
+        TelemetryPayload payload{};
+        payload.voltage_mv = r.state.voltage_mv;
+        payload.current_ma = r.state.current_ma;
+        payload.energy_wh = r.state.energy_wh;
+        payload.temperature_c10 = r.state.temperature_c10;
+        payload.tamper_detected = r.state.tamper_detected;
+        payload.timestamp = r.t_ms;
+        (void)connector.publish_telemetry(payload);
+
+        if (tamper_pending && cloud_reported(connector).tamper_detected == tamper_state) {
+            const uint64_t delay = r.t_ms - tamper_since;
+            out.worst_tamper_ms = delay > out.worst_tamper_ms ? delay : out.worst_tamper_ms;
+            tamper_pending = false;
+        }
+    }
+
+    const uint64_t end_ms = static_cast<uint64_t>(DAY_S) * 1000U + config.coalesce_ms;
+    flush(connector, end_ms);
+    const ShadowSync& sync = sync_of(connector);
+    out.stats = sync.stats();
+    out.consistent = !tamper_pending && sync.dirty_fields() == 0 &&
+                     std::memcmp(&sync.desired(), &cloud_desired(connector),
+                                 sizeof(DesiredState)) == 0;
+    if (!config.enabled) {
+        out.consistent = !tamper_pending; // legacy always reports everything
+    }
+    return out;
+}
+
+static double per_hour(double value)
+{
+    return value * 3600.0 / DAY_S;
+}
+
+static void report(const char* provider, const char* name, const Outcome& o)
+{
+    const uint32_t messages = o.stats.messages + o.stats.resyncs;
+    std::printf("  %-6s %-9s %9.1f %10.0f %7.1f %6.2f %5u %5u %8llu %5s\n",
+                provider,
+                name,
+                per_hour(messages),
+                per_hour(static_cast<double>(o.stats.bytes)),
+                o.stats.messages == 0 ? 0.0
+                                      : static_cast<double>(o.stats.bytes) / o.stats.messages,
+                o.stats.messages == 0
+                    ? 0.0
+                    : static_cast<double>(o.stats.fields_sent) / o.stats.messages,
+                static_cast<unsigned>(o.stats.conflicts),
+                static_cast<unsigned>(o.stats.stale_deltas),
+                static_cast<unsigned long long>(o.worst_tamper_ms),
+                o.consistent ? "yes" : "NO");
+}
+
+int main(int argc, char** argv)
+{
+    BenchOptions opts;
+    if (!parse_args(argc, argv, opts)) {
+        print_usage(argv[0]);
+        return EXIT_FAILURE;
+    }
+    if (!build_trace(opts)) {
+        std::printf("FAIL: dataset configuration rejected\n");
+        return EXIT_FAILURE;
+    }
+
+    ShadowSyncConfig full;
+    full.enabled = false;
+    ShadowSyncConfig exact;
+    exact.coalesce_ms = 0;
+    exact.voltage_mv = network::Deadband{};
+    exact.current_ma = network::Deadband{};
+    exact.energy_wh = network::Deadband{};
+    exact.temperature_c10 = 0;
+    ShadowSyncConfig deadband;
+    deadband.coalesce_ms = 0;
+    ShadowSyncConfig managed;
+    managed.coalesce_ms = opts.window_s * 1000U;
+
+    const ShadowSyncConfig* setups[] = {&full, &exact, &deadband, &managed};
+    static const char* const names[] = {"full", "exact", "deadband", "managed"};
+    Outcome aws[4];
+    Outcome azure[4];
+    for (size_t i = 0; i < 4; ++i) {
+        aws[i] = run<AwsIotConnector>(*setups[i]);
+        azure[i] = run<AzureIotConnector>(*setups[i]);
+    }
+
+    std::printf("%s day, %zu readings every %u s, %zu tamper events, %zu desired changes, "
+                "window %u s, seed %llu\n\n",
+                opts.kind == LoadKind::Household ? "household" : "commercial",
+                reading_count,
+                static_cast<unsigned>(opts.reading_interval_s),
+                TAMPER_EVENTS,
+                DESIRED_CHANGES,
+                static_cast<unsigned>(opts.window_s),
+                static_cast<unsigned long long>(opts.seed));
+    std::printf("  %-6s %-9s %9s %10s %7s %6s %5s %5s %8s %5s\n",
+                "cloud",
+                "setup",
+                "msgs/h",
+                "bytes/h",
+                "B/msg",
+                "fields",
+                "confl",
+                "stale",
+                "tamper",
+                "sync");
+    for (size_t i = 0; i < 4; ++i) {
+        report("aws", names[i], aws[i]);
+    }
+    for (size_t i = 0; i < 4; ++i) {
+        report("azure", names[i], azure[i]);
+    }
+
+    const Outcome& gated = aws[3];
+    const double messages_h = per_hour(gated.stats.messages + gated.stats.resyncs);
+    const double bytes_h = per_hour(static_cast<double>(gated.stats.bytes));
+    const double full_bytes_h = per_hour(static_cast<double>(aws[0].stats.bytes));
+    std::printf("\n  managed vs full (aws): %.1fx fewer messages, %.1fx fewer bytes\n",
+                messages_h > 0.0 ? per_hour(aws[0].stats.messages) / messages_h : 0.0,
+                bytes_h > 0.0 ? full_bytes_h / bytes_h : 0.0);
+
+    bool ok = true;
+    for (size_t i = 0; i < 4; ++i) {
+        if (!aws[i].consistent || !azure[i].consistent || aws[i].worst_tamper_ms != 0 ||
+            azure[i].worst_tamper_ms != 0) {
+            std::printf("FAIL: %s left the cloud out of sync or held back a tamper change\n",
+                        names[i]);
+            ok = false;
+        }
+    }
+    if (opts.max_messages_per_hour >= 0.0 && messages_h > opts.max_messages_per_hour) {
+        std::printf("FAIL: managed %.1f messages/h (limit %.1f)\n",
+                    messages_h,
+                    opts.max_messages_per_hour);
+        ok = false;
+    }
+    if (opts.max_bytes_per_hour >= 0.0 && bytes_h > opts.max_bytes_per_hour) {
+        std::printf("FAIL: managed %.0f bytes/h (limit %.0f)\n", bytes_h, opts.max_bytes_per_hour);
+        ok = false;
+    }
+    return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,437 @@
+/**
+ * @file theft_dataset.hpp
+ * @author zuudevs (zuudevs@gmail.com)
+ * @brief Seeded synthetic load profiles with labeled theft/tamper attacks
+ * @version 1.0
+ * @date 2026-03-16
+ *
+ * Streams MeterReadings for a household or commercial service at a fixed
+ * interval. True load = daily shape x weekday/weekend pattern x annual
+ * seasonality x AR(1) noise + appliance bursts. After a clean warm-up,
+ * attack windows are scheduled one per slot (type order shuffled) and
+ * applied to the *reported* reading; every sample carries its label.
+ *
+ * Attacks:
+ *   MeterBypass        — load partly bypasses the meter for a few hours
+ *   GradualUnderReport — reported energy ramps down over days, then holds
+ *   ReversedCt         — CT reversed: current present, import register stalls
+ *   MagneticTamper     — CT saturation clips reported current/energy
+ *   Replay             — readings recorded a week earlier are re-sent
+ *
+ * Host-only tooling: uses floating point and is not part of the firmware.
+ *
+ * @copyright Copyright (c) 2026
+ */
+
+#pragma once
+
+#include "core/types.hpp"
+
+#include <cmath>
+#include <cstdint>
+
+namespace gridshield::bench {
+
+// ============================================================================
+// Types
+// ============================================================================
+
+enum class LoadKind : uint8_t
+{
+    Household = 0,
+    Commercial = 1
+};
+
+enum class AttackType : uint8_t
+{
+    None = 0,
+    MeterBypass = 1,
+    GradualUnderReport = 2,
+    ReversedCt = 3,
+    MagneticTamper = 4,
+    Replay = 5
+};
+
+static constexpr size_t ATTACK_TYPE_COUNT = 6; // including None
+
+inline const char* attack_name(AttackType type) noexcept
+{
+    switch (type) {
+    case AttackType::MeterBypass:
+        return "bypass";
+    case AttackType::GradualUnderReport:
+        return "under-report";
+    case AttackType::ReversedCt:
+        return "reversed-ct";
+    case AttackType::MagneticTamper:
+        return "magnetic";
+    case AttackType::Replay:
+        return "replay";
+    default:
+        return "none";
+    }
+}
+
+struct DatasetConfig
+{
+    LoadKind kind{LoadKind::Household};
+    uint64_t seed{1};
+    uint32_t days{180};
+    uint32_t interval_s{900};
+    uint32_t warmup_days{14};       // attack-free learning period
+    uint32_t attacks_per_type{4};
+    uint32_t start_day_of_year{0};  // seasonality phase (0 = 1 Jan)
+};
+
+struct AttackWindow
+{
+    AttackType type{AttackType::None};
+    uint32_t start{0};    // sample index
+    uint32_t length{0};   // samples
+    uint16_t strength{0}; // percent; meaning depends on type
+};
+
+struct LabeledSample
+{
+    core::MeterReading reading{};  // what the meter reports
+    uint32_t true_energy_wh{0};    // what was actually consumed
+    AttackType label{AttackType::None};
+    int16_t attack_index{-1};      // into attacks(), -1 when clean
+};
+
+// ============================================================================
+// Generator
+// ============================================================================
+
+class TheftDatasetGenerator
+{
+public:
+    static constexpr size_t MAX_ATTACKS = 64;
+    static constexpr uint32_t REPLAY_LAG_DAYS = 7;
+    static constexpr size_t MAX_SAMPLES_PER_DAY = 288; // 5-min resolution
+    static constexpr size_t REPLAY_RING = REPLAY_LAG_DAYS * MAX_SAMPLES_PER_DAY;
+
+    /// Schedules the attacks; returns false on an unusable configuration.
+    bool init(const DatasetConfig& config) noexcept
+    {
+        config_ = config;
+        rng_ = config.seed ^ 0x9E3779B97F4A7C15ULL;
+        if (config.interval_s == 0 || 86400U % config.interval_s != 0) {
+            return false;
+        }
+        samples_per_day_ = 86400U / config.interval_s;
+        if (samples_per_day_ > MAX_SAMPLES_PER_DAY || config.days <= config.warmup_days) {
+            return false;
+        }
+        total_ = config.days * samples_per_day_;
+        index_ = 0;
+        ar_state_ = 0.0;
+        burst_left_ = 0;
+        burst_wh_ = 0.0;
+        schedule_attacks();
+        return true;
+    }
+
+    /// Produce the next sample; false once the dataset is exhausted.
+    bool next(LabeledSample& out) noexcept
+    {
+        if (index_ >= total_) {
+            return false;
+        }
+        const uint32_t i = index_++;
+        const uint64_t timestamp_ms = static_cast<uint64_t>(i) * config_.interval_s * 1000U;
+
+        const double true_wh = true_energy(i);
+        const double volts = 230.0 * (1.0 + 0.015 * std::sin(i * 0.37) - 0.01 * load_factor(i));
+        const double hours = static_cast<double>(config_.interval_s) / 3600.0;
+        const double true_amps = true_wh / hours / volts;
+
+        out = LabeledSample{};
+        out.true_energy_wh = static_cast<uint32_t>(true_wh + 0.5);
+        core::MeterReading& r = out.reading;
+        r.timestamp = timestamp_ms;
+        r.voltage_mv = static_cast<uint32_t>(volts * 1000.0);
+        r.power_factor = (config_.kind == LoadKind::Household) ? 950 : 880;
+        r.energy_wh = out.true_energy_wh;
+        r.current_ma = clamp_ma(true_amps * 1000.0);
+
+        const int16_t attack = attack_at(i);
+        if (attack >= 0) {
+            const AttackWindow& w = attacks_[attack];
+            out.label = w.type;
+            out.attack_index = attack;
+            apply_attack(w, i, r);
+        }
+        history_[i % REPLAY_RING] = r;
+        return true;
+    }
+
+    GS_NODISCARD uint32_t total_samples() const noexcept
+    {
+        return total_;
+    }
+    GS_NODISCARD uint32_t samples_per_day() const noexcept
+    {
+        return samples_per_day_;
+    }
+    GS_NODISCARD uint32_t warmup_samples() const noexcept
+    {
+        return config_.warmup_days * samples_per_day_;
+    }
+    GS_NODISCARD size_t attack_count() const noexcept
+    {
+        return attack_count_;
+    }
+    GS_NODISCARD const AttackWindow& attack(size_t index) const noexcept
+    {
+        return attacks_[index];
+    }
+
+private:
+    // ---- Random ------------------------------------------------------------
+    uint64_t next_u64() noexcept
+    {
+        // splitmix64
+        uint64_t z = (rng_ += 0x9E3779B97F4A7C15ULL);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        return z ^ (z >> 31);
+    }
+    double uniform() noexcept
+    {
+        return static_cast<double>(next_u64() >> 11) * (1.0 / 9007199254740992.0);
+    }
+    uint32_t uniform_u32(uint32_t lo, uint32_t hi) noexcept
+    {
+        return lo + static_cast<uint32_t>(next_u64() % (hi - lo + 1U));
+    }
+    double gaussian() noexcept
+    {
+        // Irwin–Hall approximation, adequate for load noise
+        double sum = 0.0;
+        for (int k = 0; k < 4; ++k) {
+            sum += uniform();
+        }
+        return (sum - 2.0) * 1.7320508;
+    }
+
+    // ---- Load model --------------------------------------------------------
+    GS_NODISCARD uint32_t day_of(uint32_t i) const noexcept
+    {
+        return i / samples_per_day_;
+    }
+    GS_NODISCARD bool weekend(uint32_t i) const noexcept
+    {
+        return day_of(i) % 7U >= 5U;
+    }
+    GS_NODISCARD double hour_of(uint32_t i) const noexcept
+    {
+        return static_cast<double>(i % samples_per_day_) * 24.0 / samples_per_day_;
+    }
+
+    /// Dimensionless diurnal shape (mean ~1 over a day).
+    GS_NODISCARD double load_factor(uint32_t i) const noexcept
+    {
+        static constexpr double HOUSEHOLD[24] = {0.45, 0.40, 0.38, 0.37, 0.38, 0.45,
+                                                 0.85, 1.35, 1.10, 0.80, 0.70, 0.72,
+                                                 0.80, 0.75, 0.70, 0.78, 1.00, 1.55,
+                                                 2.00, 2.10, 1.85, 1.45, 1.05, 0.70};
+        static constexpr double COMMERCIAL[24] = {0.30, 0.30, 0.30, 0.30, 0.30, 0.35,
+                                                  0.60, 1.20, 1.70, 1.85, 1.90, 1.90,
+                                                  1.80, 1.85, 1.90, 1.85, 1.70, 1.40,
+                                                  0.90, 0.55, 0.40, 0.35, 0.30, 0.30};
+        const double h = hour_of(i);
+        const size_t h0 = static_cast<size_t>(h) % 24U;
+        const size_t h1 = (h0 + 1U) % 24U;
+        const double frac = h - static_cast<double>(static_cast<size_t>(h));
+        const double* shape = (config_.kind == LoadKind::Household) ? HOUSEHOLD : COMMERCIAL;
+        double f = shape[h0] + (shape[h1] - shape[h0]) * frac;
+        if (weekend(i)) {
+            if (config_.kind == LoadKind::Commercial) {
+                f = 0.30 + (f - 0.30) * 0.15; // closed; base load only
+            } else {
+                f *= 1.12; // at home more
+            }
+        }
+        return f;
+    }
+
+    GS_NODISCARD double seasonal(uint32_t i) const noexcept
+    {
+        static constexpr double TWO_PI = 6.283185307179586;
+        const double doy = static_cast<double>((config_.start_day_of_year + day_of(i)) % 365U);
+        const double winter = std::cos(TWO_PI * (doy - 15.0) / 365.0); // +1 mid-January
+        if (config_.kind == LoadKind::Household) {
+            return 1.0 + 0.25 * winter; // electric heating
+        }
+        return 1.0 - 0.20 * winter; // cooling load peaks mid-summer
+    }
+
+    double true_energy(uint32_t i) noexcept
+    {
+        const bool household = config_.kind == LoadKind::Household;
+        const double daily_kwh = household ? 10.0 : 220.0;
+        const double mean_wh = daily_kwh * 1000.0 / samples_per_day_;
+
+        ar_state_ = 0.85 * ar_state_ + 0.15 * gaussian();
+        double wh = mean_wh * load_factor(i) * seasonal(i) * (1.0 + (household ? 0.35 : 0.12) *
+                                                                       ar_state_);
+
+        // Appliance bursts (kettle/oven/dryer; compressor starts)
+        if (burst_left_ == 0 && uniform() < (household ? 0.03 : 0.01)) {
+            burst_left_ = uniform_u32(1, 3);
+            burst_wh_ = mean_wh * (household ? 2.0 + 4.0 * uniform() : 0.3 + 0.4 * uniform());
+        }
+        if (burst_left_ > 0) {
+            --burst_left_;
+            wh += burst_wh_;
+        }
+        return wh < 0.0 ? 0.0 : wh;
+    }
+
+    static uint16_t clamp_ma(double ma) noexcept
+    {
+        if (ma <= 0.0) {
+            return 0;
+        }
+        return ma >= 65535.0 ? 65535U : static_cast<uint16_t>(ma + 0.5);
+    }
+
+    // ---- Attacks -----------------------------------------------------------
+    void schedule_attacks() noexcept
+    {
+        static constexpr AttackType TYPES[] = {AttackType::MeterBypass,
+                                               AttackType::GradualUnderReport,
+                                               AttackType::ReversedCt,
+                                               AttackType::MagneticTamper,
+                                               AttackType::Replay};
+        static constexpr size_t TYPE_COUNT = sizeof(TYPES) / sizeof(TYPES[0]);
+
+        attack_count_ = config_.attacks_per_type * TYPE_COUNT;
+        if (attack_count_ > MAX_ATTACKS) {
+            attack_count_ = MAX_ATTACKS;
+        }
+        if (attack_count_ == 0) {
+            return;
+        }
+
+        AttackType order[MAX_ATTACKS];
+        for (size_t k = 0; k < attack_count_; ++k) {
+            order[k] = TYPES[k % TYPE_COUNT];
+        }
+        for (size_t k = attack_count_ - 1; k > 0; --k) { // Fisher–Yates
+            const size_t j = static_cast<size_t>(next_u64() % (k + 1));
+            const AttackType tmp = order[k];
+            order[k] = order[j];
+            order[j] = tmp;
+        }
+
+        // One attack per slot; it starts in the first third and ends before
+        // the slot's last third so detectors see clean data in between
+        const uint32_t first = warmup_samples();
+        const uint32_t slot = (total_ - first) / static_cast<uint32_t>(attack_count_);
+        const uint32_t day = samples_per_day_;
+        const uint32_t hour = samples_per_day_ / 24U;
+        for (size_t k = 0; k < attack_count_; ++k) {
+            AttackWindow& w = attacks_[k];
+            w.type = order[k];
+            switch (w.type) {
+            case AttackType::MeterBypass:
+                w.length = uniform_u32(2 * hour, 12 * hour);
+                w.strength = static_cast<uint16_t>(uniform_u32(60, 95)); // % bypassed
+                break;
+            case AttackType::GradualUnderReport:
+                w.length = uniform_u32(2 * day, 4 * day);
+                w.strength = static_cast<uint16_t>(uniform_u32(35, 60)); // final % cut
+                break;
+            case AttackType::ReversedCt:
+                w.length = uniform_u32(6 * hour, 2 * day);
+                w.strength = 100;
+                break;
+            case AttackType::MagneticTamper:
+                w.length = uniform_u32(4 * hour, day);
+                w.strength = static_cast<uint16_t>(uniform_u32(20, 45)); // clip, % of mean peak
+                break;
+            default: // Replay
+                w.length = uniform_u32(day, 3 * day);
+                w.strength = 100;
+                break;
+            }
+            const uint32_t max_len = (slot * 2U) / 3U;
+            if (w.length > max_len) {
+                w.length = max_len;
+            }
+            const uint32_t offset_range = slot / 3U;
+            w.start = first + static_cast<uint32_t>(k) * slot +
+                      (offset_range > 0 ? uniform_u32(0, offset_range - 1) : 0U);
+        }
+    }
+
+    GS_NODISCARD int16_t attack_at(uint32_t i) const noexcept
+    {
+        for (size_t k = 0; k < attack_count_; ++k) {
+            const AttackWindow& w = attacks_[k];
+            if (i >= w.start && i < w.start + w.length) {
+                return static_cast<int16_t>(k);
+            }
+        }
+        return -1;
+    }
+
+    /// Rewrite the reported reading for sample @p i inside attack window @p w.
+    void apply_attack(const AttackWindow& w, uint32_t i, core::MeterReading& r) noexcept
+    {
+        const double strength = w.strength / 100.0;
+        double scale = 1.0;
+        switch (w.type) {
+        case AttackType::MeterBypass:
+            scale = 1.0 - strength;
+            break;
+        case AttackType::GradualUnderReport: {
+            // Ramp over the first half, then hold the full cut
+            const double progress = (2.0 * (i - w.start)) / w.length;
+            scale = 1.0 - strength * (progress < 1.0 ? progress : 1.0);
+            break;
+        }
+        case AttackType::ReversedCt:
+            r.energy_wh = 0; // energy flows into the export register; current unchanged
+            return;
+        case AttackType::MagneticTamper: {
+            const bool household = config_.kind == LoadKind::Household;
+            const double clip_wh =
+                (household ? 10.0 : 220.0) * 1000.0 / samples_per_day_ * 2.0 * strength;
+            if (r.energy_wh > clip_wh) {
+                scale = clip_wh / r.energy_wh;
+            }
+            break;
+        }
+        case AttackType::Replay: {
+            const uint32_t lag = REPLAY_LAG_DAYS * samples_per_day_;
+            if (i >= lag) {
+                const core::timestamp_t ts = r.timestamp;
+                r = history_[(i - lag) % REPLAY_RING];
+                r.timestamp = ts;
+            }
+            return;
+        }
+        default:
+            return;
+        }
+        r.energy_wh = static_cast<uint32_t>(r.energy_wh * scale + 0.5);
+        r.current_ma = clamp_ma(r.current_ma * scale);
+    }
+
+    DatasetConfig config_{};
+    uint64_t rng_{0};
+    uint32_t samples_per_day_{96};
+    uint32_t total_{0};
+    uint32_t index_{0};
+    double ar_state_{0.0};
+    uint32_t burst_left_{0};
+    double burst_wh_{0.0};
+    AttackWindow attacks_[MAX_ATTACKS]{};
+    size_t attack_count_{0};
+    core::MeterReading history_[REPLAY_RING]{};
+};
+
+} // namespace gridshield::bench
@@ -0,0 +1,285 @@
+/**
+ * @file three_phase_bench.cpp
+ * @author zuudevs (zuudevs@gmail.com)
+ * @brief Per-round cost of the three-phase accumulator against the ADC budget
+ * @version 1.0
+ * @date 2026-03-24
+ *
+ * Feeds ThreePhaseAccumulator seeded, noisy three-phase waveforms (random
+ * load, power factor and frequency per window) as a multiplexed ADC would
+ * deliver them, one read per slot. Reports the compute cost of one round
+ * (all 6 or 7 slots) against the time the ADC needs to deliver that round
+ * at N samples per cycle at 50 and 60 Hz, and the worst RMS, power and
+ * frequency error against double.
+ *
+ *   gridshield_three_phase_bench [--windows N] [--seed N] [--neutral]
+ *       [--samples-per-cycle N] [--max-budget-pct P] [--max-err-permille E]
+ *
+ * @copyright Copyright (c) 2026
+ */
+
+#include "hardware/sensors/three_phase.hpp"
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+using namespace gridshield;
+using hardware::sensors::ThreePhaseAccumulator;
+using hardware::sensors::ThreePhaseConfig;
+using hardware::sensors::ThreePhaseMeasurement;
+
+// ============================================================================
+// OPTIONS
+// ============================================================================
+static constexpr double PI = 3.14159265358979323846;
+static constexpr uint32_t MAX_ROUNDS = 4096;
+static constexpr uint8_t NEUTRAL_CHANNEL = 6;
+static constexpr double SENSITIVITY_MV_PER_A = 100.0;
+static constexpr uint32_t VOLTAGE_RATIO = 250000; // sensor mV x 250 -> line mV
+
+struct BenchOptions
+{
+    uint32_t windows{200};
+    uint64_t seed{1};
+    bool neutral{false};
+    uint32_t samples_per_cycle{64};
+    double max_budget_pct{-1.0};
+    double max_err_permille{-1.0};
+};
+
+static void print_usage(const char* argv0)
+{
+    std::printf("usage: %s [--windows N] [--seed N] [--neutral]\n"
+                "          [--samples-per-cycle N] [--max-budget-pct P] [--max-err-permille E]\n",
+                argv0);
+}
+
+static bool parse_args(int argc, char** argv, BenchOptions& opts)
+{
+    for (int i = 1; i < argc; ++i) {
+        const char* arg = argv[i];
+        if (std::strcmp(arg, "--neutral") == 0) {
+            opts.neutral = true;
+            continue;
+        }
+        const char* value = (i + 1 < argc) ? argv[i + 1] : nullptr;
+        if (value == nullptr) {
+            return false;
+        }
+        if (std::strcmp(arg, "--windows") == 0) {
+            opts.windows = static_cast<uint32_t>(std::strtoul(value, nullptr, 10));
+        } else if (std::strcmp(arg, "--seed") == 0) {
+            opts.seed = std::strtoull(value, nullptr, 10);
+        } else if (std::strcmp(arg, "--samples-per-cycle") == 0) {
+            opts.samples_per_cycle = static_cast<uint32_t>(std::strtoul(value, nullptr, 10));
+        } else if (std::strcmp(arg, "--max-budget-pct") == 0) {
+            opts.max_budget_pct = std::strtod(value, nullptr);
+        } else if (std::strcmp(arg, "--max-err-permille") == 0) {
+            opts.max_err_permille = std::strtod(value, nullptr);
+        } else {
+            return false;
+        }
+        ++i;
+    }
+    return opts.windows > 0 && opts.samples_per_cycle >= 16 && opts.samples_per_cycle <= 512;
+}
+
+static uint64_t next_random(uint64_t& state)
+{
+    // xorshift64*
+    state ^= state >> 12;
+    state ^= state << 25;
+    state ^= state >> 27;
+    return state * 0x2545F4914F6CDD1DULL;
+}
+
+static double uniform(uint64_t& state, double lo, double hi)
+{
+    const double u = static_cast<double>(next_random(state) >> 11) / 9007199254740992.0;
+    return lo + (hi - lo) * u;
+}
+
+static uint64_t elapsed_ns(std::chrono::steady_clock::time_point start)
+{
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                     std::chrono::steady_clock::now() - start)
+                                     .count());
+}
+
+// ============================================================================
+// WAVEFORMS
+// ============================================================================
+struct Window
+{
+    double frequency_hz{50.0};
+    double voltage_rms_mv[3]{}; // sensor side
+    double current_a[3]{};
+    double lag_rad[3]{};
+};
+
+static int32_t rounds_buffer[MAX_ROUNDS][hardware::sensors::THREE_PHASE_MAX_SLOTS];
+
+static double phase_current_a(const Window& w, size_t p, double t)
+{
+    const double offset = -2.0 * PI / 3.0 * static_cast<double>(p);
+    return w.current_a[p] * std::sqrt(2.0) *
+           std::sin(2.0 * PI * w.frequency_hz * t + offset - w.lag_rad[p]);
+}
+
+/// Fill @p rounds of slot-ordered reads, one read every @p read_us.
+static void synthesize(const Window& w, uint32_t rounds, size_t slots, double read_us,
+                       uint64_t& rng)
+{
+    double t = uniform(rng, 0.0, 0.02); // arbitrary start phase
+    for (uint32_t r = 0; r < rounds; ++r) {
+        for (size_t k = 0; k < slots; ++k) {
+            double value = 0.0;
+            const size_t p = k / 2;
+            if (k == NEUTRAL_CHANNEL) {
+                for (size_t q = 0; q < 3; ++q) {
+                    value += phase_current_a(w, q, t) * SENSITIVITY_MV_PER_A;
+                }
+            } else if (k % 2 == 0) {
+                const double offset = -2.0 * PI / 3.0 * static_cast<double>(p);
+                value = w.voltage_rms_mv[p] * std::sqrt(2.0) *
+                        std::sin(2.0 * PI * w.frequency_hz * t + offset);
+            } else {
+                value = phase_current_a(w, p, t) * SENSITIVITY_MV_PER_A;
+            }
+            const double noise = uniform(rng, -2.0, 2.0); // +-2 mV ADC noise
+            rounds_buffer[r][k] = static_cast<int32_t>(std::lround(2500.0 + value + noise));
+            t += read_us * 1e-6;
+        }
+    }
+}
+
+// ============================================================================
+// RUN
+// ============================================================================
+int main(int argc, char** argv)
+{
+    BenchOptions opts;
+    if (!parse_args(argc, argv, opts)) {
+        print_usage(argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    ThreePhaseConfig config;
+    config.voltage_ratio = VOLTAGE_RATIO;
+    if (opts.neutral) {
+        config.neutral_channel = NEUTRAL_CHANNEL;
+    }
+    const size_t slots = opts.neutral ? 7 : 6;
+    const uint32_t rounds = opts.samples_per_cycle * 5; // 5 cycles per window
+    config.rounds = static_cast<uint16_t>(rounds);
+    if (rounds > MAX_ROUNDS) {
+        print_usage(argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    ThreePhaseAccumulator acc;
+    if (acc.configure(config).is_error()) {
+        std::printf("FAIL: configure\n");
+        return EXIT_FAILURE;
+    }
+
+    uint64_t rng = opts.seed * 0x9E3779B97F4A7C15ULL + 1;
+    uint64_t total_ns = 0;
+    uint64_t total_rounds = 0;
+    double worst_rms = 0.0;
+    double worst_power = 0.0;
+    double worst_freq = 0.0;
+    uint32_t sequence_misses = 0;
+    uint64_t sink = 0;
+
+    for (uint32_t win = 0; win < opts.windows; ++win) {
+        Window w;
+        w.frequency_hz = uniform(rng, 49.5, 60.5);
+        for (size_t p = 0; p < 3; ++p) {
+            w.voltage_rms_mv[p] = uniform(rng, 850.0, 950.0);
+            w.current_a[p] = uniform(rng, 2.0, 15.0);
+            w.lag_rad[p] = uniform(rng, -0.6, 0.6);
+        }
+        // Sample rate tracks the nominal grid so each cycle gets ~N rounds
+        const double nominal = w.frequency_hz < 55.0 ? 50.0 : 60.0;
+        const double read_us = 1e6 / (nominal * opts.samples_per_cycle * slots);
+        synthesize(w, rounds, slots, read_us, rng);
+
+        acc.reset();
+        const auto start = std::chrono::steady_clock::now();
+        for (uint32_t r = 0; r < rounds; ++r) {
+            acc.push_round(rounds_buffer[r]);
+        }
+        const ThreePhaseMeasurement m =
+            acc.finish(static_cast<uint64_t>(std::llround(read_us * slots * rounds)));
+        total_ns += elapsed_ns(start);
+        total_rounds += rounds;
+        sink += static_cast<uint64_t>(m.total_power_mw) + m.neutral_ma;
+
+        for (size_t p = 0; p < 3; ++p) {
+            const double v_line_mv = w.voltage_rms_mv[p] * VOLTAGE_RATIO / 1000.0;
+            const double i_ma = w.current_a[p] * 1000.0;
+            const double p_mw = v_line_mv * i_ma * std::cos(w.lag_rad[p]) / 1000.0;
+            const double ev = std::fabs(m.phases[p].voltage_mv - v_line_mv) / v_line_mv;
+            const double ei = std::fabs(m.phases[p].current_ma - i_ma) / i_ma;
+            // Power relative to apparent power: exact near PF 0 is not required
+            const double ep = std::fabs(m.phases[p].power_mw - p_mw) / (v_line_mv * i_ma / 1000.0);
+            worst_rms = std::fmax(worst_rms, std::fmax(ev, ei) * 1000.0);
+            worst_power = std::fmax(worst_power, ep * 1000.0);
+        }
+        const double ef = std::fabs(m.frequency_chz / 100.0 - w.frequency_hz) / w.frequency_hz;
+        worst_freq = std::fmax(worst_freq, ef * 1000.0);
+        sequence_misses += m.sequence == core::PhaseSequence::Abc ? 0U : 1U;
+    }
+
+    const double ns_per_round = static_cast<double>(total_ns) / static_cast<double>(total_rounds);
+    std::printf("%u windows x %u rounds, %zu slots/round, %u samples/cycle, seed %llu\n\n",
+                static_cast<unsigned>(opts.windows),
+                static_cast<unsigned>(rounds),
+                slots,
+                static_cast<unsigned>(opts.samples_per_cycle),
+                static_cast<unsigned long long>(opts.seed));
+    std::printf("  compute per round        %8.1f ns (%.1f ns per read)\n",
+                ns_per_round,
+                ns_per_round / static_cast<double>(slots));
+
+    double worst_budget_pct = 0.0;
+    for (double hz : {50.0, 60.0}) {
+        const double budget_ns = 1e9 / (hz * opts.samples_per_cycle);
+        const double pct = 100.0 * ns_per_round / budget_ns;
+        worst_budget_pct = std::fmax(worst_budget_pct, pct);
+        std::printf("  ADC round budget @ %2.0f Hz %8.0f ns (%.1f us per read) -> %.2f%% used\n",
+                    hz,
+                    budget_ns,
+                    budget_ns / 1000.0 / static_cast<double>(slots),
+                    pct);
+    }
+    std::printf("  worst RMS error          %8.2f permille\n", worst_rms);
+    std::printf("  worst power error        %8.2f permille of VA\n", worst_power);
+    std::printf("  worst frequency error    %8.2f permille\n", worst_freq);
+    std::printf("  sequence misses          %8u\n", static_cast<unsigned>(sequence_misses));
+
+    bool ok = sequence_misses == 0;
+    if (!ok) {
+        std::printf("FAIL: phase sequence not recognised in %u windows\n",
+                    static_cast<unsigned>(sequence_misses));
+    }
+    if (opts.max_budget_pct >= 0.0 && worst_budget_pct > opts.max_budget_pct) {
+        std::printf("FAIL: %.2f%% of the ADC budget (limit %.2f%%)\n",
+                    worst_budget_pct,
+                    opts.max_budget_pct);
+        ok = false;
+    }
+    if (opts.max_err_permille >= 0.0) {
+        const double worst = std::fmax(worst_rms, std::fmax(worst_power, worst_freq));
+        if (worst > opts.max_err_permille) {
+            std::printf("FAIL: error %.2f permille (limit %.2f)\n", worst, opts.max_err_permille);
+            ok = false;
+        }
+    }
+    std::printf("\n(checksum %llu)\n", static_cast<unsigned long long>(sink));
+    return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
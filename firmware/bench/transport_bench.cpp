@@ -0,0 +1,409 @@
+/**
+ * @file transport_bench.cpp
+ * @author zuudevs (zuudevs@gmail.com)
+ * @brief Delivery latency through injected link outages: failover vs one link
+ * @version 1.0
+ * @date 2026-03-28
+ *
+ * Simulates a meter with WiFi, cellular and LoRa uplinks on a SimClock.
+ * WiFi drops out every few tens of minutes for up to five minutes, either
+ * cleanly (disconnected) or silently (sends time out after a second);
+ * cellular has rarer, shorter outages; LoRa stays up but is slow and takes
+ * only 255-byte frames. A seeded day of traffic (telemetry every 15 s,
+ * random tamper alerts, hourly evidence exports) is sent by a single radio
+ * task that retries once a second until a message goes out. The same trace
+ * runs through TransportManager over all three links and over WiFi alone;
+ * the report gives per-class delivery latency, overall and for messages
+ * created while WiFi was down, and where the manager carried them.
+ *
+ *   gridshield_transport_bench [--hours N] [--seed N]
+ *       [--max-alert-ms M] [--max-telemetry-ms M] [--max-evidence-ms M]
+ *
+ * @copyright Copyright (c) 2026
+ */
+
+#include "network/transport_manager.hpp"
+#include "platform/sim_clock.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+using namespace gridshield;
+using network::LinkConfig;
+using network::TrafficClass;
+using network::TransportConfig;
+using network::TransportManager;
+
+// ============================================================================
+// OPTIONS
+// ============================================================================
+static constexpr uint64_t MS_PER_MIN = 60U * 1000U;
+static constexpr uint64_t MS_PER_HOUR = 60U * MS_PER_MIN;
+static constexpr size_t MAX_MESSAGES = 32768;
+static constexpr size_t MAX_OUTAGES = 1024;
+static constexpr uint32_t RETRY_MS = 1000;
+static constexpr uint32_t SILENT_TIMEOUT_MS = 1000;
+static constexpr size_t LINK_COUNT = 3;
+
+struct BenchOptions
+{
+    uint32_t hours{24};
+    uint64_t seed{1};
+    double max_alert_ms{-1.0};     // worst alert latency while WiFi is down
+    double max_telemetry_ms{-1.0}; // worst telemetry latency while WiFi is down
+    double max_evidence_ms{-1.0};  // worst evidence latency while WiFi is down
+};
+
+static void print_usage(const char* argv0)
+{
+    std::printf("usage: %s [--hours N] [--seed N]\n"
+                "          [--max-alert-ms M] [--max-telemetry-ms M] [--max-evidence-ms M]\n",
+                argv0);
+}
+
+static bool parse_args(int argc, char** argv, BenchOptions& opts)
+{
+    for (int i = 1; i < argc; ++i) {
+        const char* arg = argv[i];
+        const char* value = (i + 1 < argc) ? argv[i + 1] : nullptr;
+        if (value == nullptr) {
+            return false;
+        }
+        if (std::strcmp(arg, "--hours") == 0) {
+            opts.hours = static_cast<uint32_t>(std::strtoul(value, nullptr, 10));
+        } else if (std::strcmp(arg, "--seed") == 0) {
+            opts.seed = std::strtoull(value, nullptr, 10);
+        } else if (std::strcmp(arg, "--max-alert-ms") == 0) {
+            opts.max_alert_ms = std::strtod(value, nullptr);
+        } else if (std::strcmp(arg, "--max-telemetry-ms") == 0) {
+            opts.max_telemetry_ms = std::strtod(value, nullptr);
+        } else if (std::strcmp(arg, "--max-evidence-ms") == 0) {
+            opts.max_evidence_ms = std::strtod(value, nullptr);
+        } else {
+            return false;
+        }
+        ++i;
+    }
+    return opts.hours > 0 && opts.hours <= 72;
+}
+
+static uint64_t next_random(uint64_t& state)
+{
+    // xorshift64*
+    state ^= state >> 12;
+    state ^= state << 25;
+    state ^= state >> 27;
+    return state * 0x2545F4914F6CDD1DULL;
+}
+
+static uint32_t uniform(uint64_t& state, uint32_t lo, uint32_t hi)
+{
+    return lo + static_cast<uint32_t>(next_random(state) % (hi - lo + 1U));
+}
+
+// ============================================================================
+// LINKS
+// ============================================================================
+struct Outage
+{
+    uint64_t start_ms{};
+    uint64_t end_ms{};
+    bool silent{}; // link still claims to be connected; sends time out
+};
+
+struct LinkModel
+{
+    const char* name{};
+    uint32_t rtt_min_ms{};
+    uint32_t rtt_max_ms{};
+    uint32_t bytes_per_s{};
+    uint16_t mtu{};
+    uint8_t cost{};
+    Outage outages[MAX_OUTAGES]{};
+    size_t outage_count{};
+};
+
+static LinkModel models[LINK_COUNT];
+
+static void build_outages(LinkModel& m, uint64_t length_ms, uint64_t& rng, uint32_t up_min,
+                          uint32_t up_max, uint32_t down_min_s, uint32_t down_max_s)
+{
+    m.outage_count = 0;
+    if (up_min == 0) {
+        return;
+    }
+    uint64_t t = static_cast<uint64_t>(uniform(rng, up_min, up_max)) * MS_PER_MIN;
+    while (t < length_ms && m.outage_count < MAX_OUTAGES) {
+        Outage& o = m.outages[m.outage_count++];
+        o.start_ms = t;
+        o.end_ms = t + static_cast<uint64_t>(uniform(rng, down_min_s, down_max_s)) * 1000U;
+        o.silent = (next_random(rng) & 1U) != 0;
+        t = o.end_ms + static_cast<uint64_t>(uniform(rng, up_min, up_max)) * MS_PER_MIN;
+    }
+}
+
+static const Outage* outage_at(const LinkModel& m, uint64_t t_ms)
+{
+    // Few outages per link: a scan is fine
+    for (size_t i = 0; i < m.outage_count; ++i) {
+        if (m.outages[i].start_ms <= t_ms && t_ms < m.outages[i].end_ms) {
+            return &m.outages[i];
+        }
+        if (m.outages[i].start_ms > t_ms) {
+            break;
+        }
+    }
+    return nullptr;
+}
+
+/// Acknowledged send: blocks the simulated clock for RTT plus serialization.
+class SimLink final : public platform::IPlatformComm
+{
+public:
+    SimLink(platform::sim::SimClock& clock, const LinkModel& model, uint64_t seed) noexcept
+        : clock_(clock), model_(model), rng_(seed)
+    {}
+
+    core::Result<void> init() noexcept override
+    {
+        return core::Result<void>{};
+    }
+    core::Result<void> shutdown() noexcept override
+    {
+        return core::Result<void>{};
+    }
+
+    core::Result<size_t> send(const uint8_t* /*data*/, size_t length) noexcept override
+    {
+        const Outage* outage = outage_at(model_, clock_.get_timestamp_ms());
+        if (outage != nullptr) {
+            if (!outage->silent) {
+                return core::Result<size_t>(GS_MAKE_ERROR(core::ErrorCode::NetworkDisconnected));
+            }
+            clock_.delay_ms(SILENT_TIMEOUT_MS);
+            return core::Result<size_t>(GS_MAKE_ERROR(core::ErrorCode::NetworkTimeout));
+        }
+        const uint64_t rtt_us =
+            static_cast<uint64_t>(uniform(rng_, model_.rtt_min_ms, model_.rtt_max_ms)) * 1000U;
+        clock_.advance_us(rtt_us + static_cast<uint64_t>(length) * 1000000U / model_.bytes_per_s);
+        return core::Result<size_t>(length);
+    }
+
+    core::Result<size_t>
+    receive(uint8_t* /*buffer*/, size_t /*max_length*/, uint32_t /*timeout_ms*/) noexcept override
+    {
+        return core::Result<size_t>(GS_MAKE_ERROR(core::ErrorCode::NetworkTimeout));
+    }
+
+    bool is_connected() noexcept override
+    {
+        const Outage* outage = outage_at(model_, clock_.get_timestamp_ms());
+        return outage == nullptr || outage->silent;
+    }
+
+private:
+    platform::sim::SimClock& clock_;
+    const LinkModel& model_;
+    uint64_t rng_;
+};
+
+// ============================================================================
+// TRAFFIC
+// ============================================================================
+struct Message
+{
+    uint64_t created_ms{};
+    TrafficClass cls{};
+    uint16_t length{};
+};
+
+static Message messages[MAX_MESSAGES];
+static size_t message_count;
+static uint8_t payload[8192];
+
+static void build_traffic(uint64_t length_ms, uint64_t& rng)
+{
+    message_count = 0;
+    for (uint64_t t = 5000; t < length_ms && message_count < MAX_MESSAGES; t += 15000) {
+        messages[message_count++] = Message{t, TrafficClass::Telemetry, 180};
+    }
+    for (uint64_t t = uniform(rng, 30, 240) * 1000U; t < length_ms && message_count < MAX_MESSAGES;
+         t += static_cast<uint64_t>(uniform(rng, 30, 240)) * 1000U) {
+        messages[message_count++] = Message{t, TrafficClass::TamperAlert, 96};
+    }
+    for (uint64_t t = MS_PER_HOUR - 7000; t < length_ms && message_count < MAX_MESSAGES;
+         t += MS_PER_HOUR) {
+        messages[message_count++] = Message{t, TrafficClass::Evidence, 8192};
+    }
+    std::sort(messages, messages + message_count, [](const Message& a, const Message& b) {
+        return a.created_ms < b.created_ms;
+    });
+}
+
+// ============================================================================
+// RUN
+// ============================================================================
+struct ClassOutcome
+{
+    uint32_t count{};
+    uint64_t latency_sum_ms{};
+    uint64_t worst_ms{};
+    uint32_t outage_count{}; // created while WiFi was down
+    uint64_t outage_sum_ms{};
+    uint64_t outage_worst_ms{};
+};
+
+struct Outcome
+{
+    ClassOutcome classes[network::TRAFFIC_CLASS_COUNT]{};
+    uint32_t per_link[LINK_COUNT]{};
+    uint32_t failovers{};
+    uint64_t finished_ms{};
+};
+
+static Outcome run(bool failover, uint64_t seed)
+{
+    Outcome out;
+    platform::sim::SimClock clock;
+    SimLink wifi(clock, models[0], seed + 1);
+    SimLink cellular(clock, models[1], seed + 2);
+    SimLink lora(clock, models[2], seed + 3);
+    SimLink* links[LINK_COUNT] = {&wifi, &cellular, &lora};
+
+    TransportConfig config;
+    TransportManager manager(clock, config);
+    const size_t used = failover ? LINK_COUNT : 1;
+    for (size_t i = 0; i < used; ++i) {
+        LinkConfig lc;
+        lc.mtu = models[i].mtu;
+        lc.cost = models[i].cost;
+        lc.nominal_rtt_ms = (models[i].rtt_min_ms + models[i].rtt_max_ms) / 2;
+        lc.nominal_bytes_per_s = models[i].bytes_per_s;
+        lc.send_is_round_trip = true;
+        (void)manager.add_link(*links[i], lc);
+    }
+    static const uint8_t probe[32]{};
+    manager.set_probe_frame(probe, sizeof(probe));
+
+    for (size_t m = 0; m < message_count; ++m) {
+        const Message& msg = messages[m];
+        if (clock.get_timestamp_ms() < msg.created_ms) {
+            clock.advance_us((msg.created_ms - clock.get_timestamp_ms()) * 1000U);
+        }
+        for (;;) {
+            manager.poll();
+            auto result = manager.send(msg.cls, payload, msg.length);
+            if (result.is_ok()) {
+                ++out.per_link[result.value()];
+                break;
+            }
+            clock.delay_ms(RETRY_MS);
+        }
+        const uint64_t latency = clock.get_timestamp_ms() - msg.created_ms;
+        ClassOutcome& c = out.classes[static_cast<size_t>(msg.cls)];
+        ++c.count;
+        c.latency_sum_ms += latency;
+        c.worst_ms = std::max(c.worst_ms, latency);
+        if (outage_at(models[0], msg.created_ms) != nullptr) {
+            ++c.outage_count;
+            c.outage_sum_ms += latency;
+            c.outage_worst_ms = std::max(c.outage_worst_ms, latency);
+        }
+    }
+    out.failovers = manager.stats().failovers;
+    out.finished_ms = clock.get_timestamp_ms();
+    return out;
+}
+
+static void report(const char* name, const Outcome& o)
+{
+    static const char* const class_names[] = {"alert", "telemetry", "evidence"};
+    for (size_t i = 0; i < network::TRAFFIC_CLASS_COUNT; ++i) {
+        const ClassOutcome& c = o.classes[i];
+        const double mean = c.count == 0 ? 0.0 : static_cast<double>(c.latency_sum_ms) / c.count;
+        const double outage_mean =
+            c.outage_count == 0 ? 0.0 : static_cast<double>(c.outage_sum_ms) / c.outage_count;
+        std::printf("  %-10s %-10s %6u %9.0f %9llu %6u %11.0f %11llu\n",
+                    i == 0 ? name : "",
+                    class_names[i],
+                    static_cast<unsigned>(c.count),
+                    mean,
+                    static_cast<unsigned long long>(c.worst_ms),
+                    static_cast<unsigned>(c.outage_count),
+                    outage_mean,
+                    static_cast<unsigned long long>(c.outage_worst_ms));
+    }
+}
+
+static bool check(const char* what, uint64_t worst_ms, double limit_ms)
+{
+    if (limit_ms >= 0.0 && static_cast<double>(worst_ms) > limit_ms) {
+        std::printf("FAIL: %s worst latency during WiFi outages %llu ms (limit %.0f ms)\n",
+                    what,
+                    static_cast<unsigned long long>(worst_ms),
+                    limit_ms);
+        return false;
+    }
+    return true;
+}
+
+int main(int argc, char** argv)
+{
+    BenchOptions opts;
+    if (!parse_args(argc, argv, opts)) {
+        print_usage(argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    const uint64_t length_ms = static_cast<uint64_t>(opts.hours) * MS_PER_HOUR;
+    uint64_t rng = opts.seed * 0x9E3779B97F4A7C15ULL + 1;
+    models[0] = LinkModel{"wifi", 15, 60, 250000, 0, 1, {}, 0};
+    models[1] = LinkModel{"cellular", 150, 400, 40000, 0, 8, {}, 0};
+    models[2] = LinkModel{"lora", 900, 1400, 300, 255, 2, {}, 0};
+    build_outages(models[0], length_ms, rng, 10, 40, 30, 300);
+    build_outages(models[1], length_ms, rng, 60, 240, 10, 60);
+    build_outages(models[2], length_ms, rng, 0, 0, 0, 0);
+    build_traffic(length_ms, rng);
+
+    uint64_t wifi_down_ms = 0;
+    for (size_t i = 0; i < models[0].outage_count; ++i) {
+        wifi_down_ms += models[0].outages[i].end_ms - models[0].outages[i].start_ms;
+    }
+
+    const Outcome single = run(false, opts.seed);
+    const Outcome managed = run(true, opts.seed);
+
+    std::printf("%u h, %zu messages, WiFi down %zu times (%.1f%% of the time), seed %llu\n\n",
+                static_cast<unsigned>(opts.hours),
+                message_count,
+                models[0].outage_count,
+                100.0 * static_cast<double>(wifi_down_ms) / static_cast<double>(length_ms),
+                static_cast<unsigned long long>(opts.seed));
+    std::printf("  %-10s %-10s %6s %9s %9s %6s %11s %11s\n",
+                "uplink",
+                "class",
+                "sent",
+                "mean ms",
+                "worst ms",
+                "in out",
+                "out mean ms",
+                "out worst");
+    report("wifi only", single);
+    report("managed", managed);
+    std::printf("\n  managed: %u wifi / %u cellular / %u lora, %u failovers in-call\n",
+                static_cast<unsigned>(managed.per_link[0]),
+                static_cast<unsigned>(managed.per_link[1]),
+                static_cast<unsigned>(managed.per_link[2]),
+                static_cast<unsigned>(managed.failovers));
+
+    bool ok = true;
+    const auto& alert = managed.classes[static_cast<size_t>(TrafficClass::TamperAlert)];
+    const auto& telemetry = managed.classes[static_cast<size_t>(TrafficClass::Telemetry)];
+    const auto& evidence = managed.classes[static_cast<size_t>(TrafficClass::Evidence)];
+    ok = check("alert", alert.outage_worst_ms, opts.max_alert_ms) && ok;
+    ok = check("telemetry", telemetry.outage_worst_ms, opts.max_telemetry_ms) && ok;
+    ok = check("evidence", evidence.outage_worst_ms, opts.max_evidence_ms) && ok;
+    return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
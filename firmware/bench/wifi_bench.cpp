@@ -0,0 +1,657 @@
+/**
+ * @file wifi_bench.cpp
+ * @author zuudevs (zuudevs@gmail.com)
+ * @brief Reconnect time and radio-on duty cycle: WiFiManager vs connect-and-send
+ * @version 1.0
+ * @date 2026-03-30
+ *
+ * Simulates a day on a SimClock with an access point that drops out every
+ * one to three hours for 5-60 s, sometimes coming back on another channel.
+ * The simulated driver charges what an ESP32 station pays for each step: an
+ * all-channel scan, a directed probe on a known channel, association, DHCP
+ * (occasionally timing out) or an ARP check of a reused address. Readings
+ * go out every 5 s as in demo_main.cpp, with a random tamper alert every
+ * 10-60 min. Three setups run the same trace through WiFiManager:
+ *
+ *   current  full scan and DHCP on every connect, radio always on, each
+ *            reading sent as it arrives (what demo_main.cpp does)
+ *   sleep    cached fast reconnect and DTIM modem sleep, still unbatched
+ *   managed  cached fast reconnect, modem sleep and 60 s wake windows
+ *
+ * Radio-on time counts connect attempts, every instant with power save off,
+ * a beacon receive per wake period with it on, and per transmit burst a
+ * wake-up, the airtime and the tail the radio stays up for after it.
+ *
+ *   gridshield_wifi_bench [--hours N] [--seed N]
+ *       [--max-reconnect-ms M] [--max-duty-pct P] [--max-alert-ms M]
+ *
+ * @copyright Copyright (c) 2026
+ */
+
+#include "network/wifi_manager.hpp"
+#include "platform/sim_clock.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+using namespace gridshield;
+using network::TrafficClass;
+using network::WiFiManager;
+using network::WiFiManagerConfig;
+
+// ============================================================================
+// OPTIONS
+// ============================================================================
+static constexpr uint64_t MS_PER_MIN = 60U * 1000U;
+static constexpr uint64_t MS_PER_HOUR = 60U * MS_PER_MIN;
+static constexpr size_t MAX_OUTAGES = 256;
+static constexpr size_t MAX_INTERVALS = 1U << 17;
+static constexpr uint32_t READING_INTERVAL_MS = 5000; // demo_main.cpp READING_INTERVAL_S
+static constexpr uint32_t POLL_MS = 1000;
+static constexpr size_t TELEMETRY_BYTES = 160;
+static constexpr size_t ALERT_BYTES = 120;
+
+// Station costs (ESP32-class, 2.4 GHz, WPA2-PSK)
+static constexpr uint32_t SCAN_MIN_MS = 1500; // active scan, all channels
+static constexpr uint32_t SCAN_MAX_MS = 3000;
+static constexpr uint32_t PROBE_TIMEOUT_MS = 300; // directed probe, no answer
+static constexpr uint32_t ASSOC_MIN_MS = 60;      // auth, assoc, 4-way handshake
+static constexpr uint32_t ASSOC_MAX_MS = 150;
+static constexpr uint32_t DHCP_MIN_MS = 300;
+static constexpr uint32_t DHCP_MAX_MS = 2500;
+static constexpr uint32_t DHCP_TIMEOUT_MS = 5000;
+static constexpr uint32_t DHCP_FAIL_PCT = 3;
+static constexpr uint32_t ARP_CHECK_MS = 10; // reused address still free
+static constexpr uint32_t LEASE_S = 86400;
+static constexpr uint64_t BEACON_RX_US = 3000; // wake, settle, receive one beacon
+static constexpr uint64_t TX_WAKE_US = 8000;
+static constexpr uint64_t TX_TAIL_US = 50000; // radio stays up after the last frame
+static constexpr uint64_t TX_ACK_US = 2000;   // per frame: contention, ACK, TCP ACK
+static constexpr uint64_t PHY_BYTES_PER_S = 2500000;
+
+struct BenchOptions
+{
+    uint32_t hours{24};
+    uint64_t seed{1};
+    double max_reconnect_ms{-1.0}; // mean connect time, managed
+    double max_duty_pct{-1.0};     // radio-on share of the run, managed
+    double max_alert_ms{-1.0};     // worst alert delay, managed
+};
+
+static void print_usage(const char* argv0)
+{
+    std::printf("usage: %s [--hours N] [--seed N]\n"
+                "          [--max-reconnect-ms M] [--max-duty-pct P] [--max-alert-ms M]\n",
+                argv0);
+}
+
+static bool parse_args(int argc, char** argv, BenchOptions& opts)
+{
+    for (int i = 1; i < argc; ++i) {
+        const char* arg = argv[i];
+        const char* value = (i + 1 < argc) ? argv[i + 1] : nullptr;
+        if (value == nullptr) {
+            return false;
+        }
+        if (std::strcmp(arg, "--hours") == 0) {
+            opts.hours = static_cast<uint32_t>(std::strtoul(value, nullptr, 10));
+        } else if (std::strcmp(arg, "--seed") == 0) {
+            opts.seed = std::strtoull(value, nullptr, 10);
+        } else if (std::strcmp(arg, "--max-reconnect-ms") == 0) {
+            opts.max_reconnect_ms = std::strtod(value, nullptr);
+        } else if (std::strcmp(arg, "--max-duty-pct") == 0) {
+            opts.max_duty_pct = std::strtod(value, nullptr);
+        } else if (std::strcmp(arg, "--max-alert-ms") == 0) {
+            opts.max_alert_ms = std::strtod(value, nullptr);
+        } else {
+            return false;
+        }
+        ++i;
+    }
+    return opts.hours > 0 && opts.hours <= 72;
+}
+
+static uint64_t next_random(uint64_t& state)
+{
+    // xorshift64*
+    state ^= state >> 12;
+    state ^= state << 25;
+    state ^= state >> 27;
+    return state * 0x2545F4914F6CDD1DULL;
+}
+
+static uint32_t uniform(uint64_t& state, uint32_t lo, uint32_t hi)
+{
+    return lo + static_cast<uint32_t>(next_random(state) % (hi - lo + 1U));
+}
+
+// ============================================================================
+// ACCESS POINT
+// ============================================================================
+struct Outage
+{
+    uint64_t start_ms{};
+    uint64_t end_ms{};
+    uint8_t channel_after{}; // AP channel once it is back
+};
+
+static Outage outages[MAX_OUTAGES];
+static size_t outage_count;
+static constexpr uint8_t INITIAL_CHANNEL = 6;
+
+static void build_outages(uint64_t length_ms, uint64_t& rng)
+{
+    outage_count = 0;
+    uint8_t channel = INITIAL_CHANNEL;
+    uint64_t t = static_cast<uint64_t>(uniform(rng, 60, 180)) * MS_PER_MIN;
+    while (t < length_ms && outage_count < MAX_OUTAGES) {
+        Outage& o = outages[outage_count++];
+        o.start_ms = t;
+        o.end_ms = t + static_cast<uint64_t>(uniform(rng, 5, 60)) * 1000U;
+        // A quarter of the restarts pick a new channel
+        if (uniform(rng, 0, 3) == 0) {
+            const auto other = static_cast<uint8_t>(uniform(rng, 1, 10));
+            channel = other >= channel ? static_cast<uint8_t>(other + 1U) : other;
+        }
+        o.channel_after = channel;
+        t = o.end_ms + static_cast<uint64_t>(uniform(rng, 60, 180)) * MS_PER_MIN;
+    }
+}
+
+static const Outage* outage_at(uint64_t t_ms)
+{
+    for (size_t i = 0; i < outage_count && outages[i].start_ms <= t_ms; ++i) {
+        if (t_ms < outages[i].end_ms) {
+            return &outages[i];
+        }
+    }
+    return nullptr;
+}
+
+static uint8_t channel_at(uint64_t t_ms)
+{
+    uint8_t channel = INITIAL_CHANNEL;
+    for (size_t i = 0; i < outage_count && outages[i].end_ms <= t_ms; ++i) {
+        channel = outages[i].channel_after;
+    }
+    return channel;
+}
+
+// ============================================================================
+// RADIO-ON ACCOUNTING
+// ============================================================================
+struct Interval
+{
+    uint64_t start_us{};
+    uint64_t end_us{};
+};
+
+class RadioMeter
+{
+public:
+    void reset() noexcept
+    {
+        count_ = 0;
+        beacon_us_ = 0;
+    }
+
+    void on(uint64_t start_us, uint64_t end_us) noexcept
+    {
+        if (end_us > start_us && count_ < MAX_INTERVALS) {
+            intervals_[count_++] = Interval{start_us, end_us};
+        }
+    }
+
+    void beacons(uint64_t us) noexcept
+    {
+        beacon_us_ += us;
+    }
+
+    /// Union of the recorded intervals plus beacon wake-ups, capped at @p end_us.
+    uint64_t total_us(uint64_t end_us) noexcept
+    {
+        std::sort(intervals_, intervals_ + count_, [](const Interval& a, const Interval& b) {
+            return a.start_us < b.start_us;
+        });
+        uint64_t total = beacon_us_;
+        uint64_t covered = 0;
+        for (size_t i = 0; i < count_; ++i) {
+            const uint64_t start = std::max(intervals_[i].start_us, covered);
+            const uint64_t end = std::min(intervals_[i].end_us, end_us);
+            if (end > start) {
+                total += end - start;
+                covered = end;
+            }
+        }
+        return total;
+    }
+
+private:
+    Interval intervals_[MAX_INTERVALS]{};
+    size_t count_{0};
+    uint64_t beacon_us_{0};
+};
+
+static RadioMeter meter;
+
+// ============================================================================
+// SIMULATED STATION
+// ============================================================================
+class SimWiFi final : public platform::IPlatformWiFi
+{
+public:
+    SimWiFi(platform::sim::SimClock& clock, uint64_t seed) noexcept : clock_(clock), rng_(seed) {}
+
+    core::Result<void> init() noexcept override
+    {
+        return core::Result<void>{};
+    }
+
+    core::Result<void> connect(const char* ssid, const char* password) noexcept override
+    {
+        return connect_with_hint(ssid, password, platform::WiFiConnectHint{});
+    }
+
+    core::Result<void> connect_with_hint(const char* /*ssid*/,
+                                         const char* /*password*/,
+                                         const platform::WiFiConnectHint& hint) noexcept override
+    {
+        const uint64_t start_us = clock_.get_timestamp_us();
+        const bool ok = associate(hint);
+        meter.on(start_us, clock_.get_timestamp_us());
+        if (!ok) {
+            return GS_MAKE_ERROR(core::ErrorCode::WiFiConnectionFailed);
+        }
+        connected_ = true;
+        ps_ = platform::WiFiPowerSave::None;
+        session_start_us_ = clock_.get_timestamp_us();
+        return core::Result<void>{};
+    }
+
+    core::Result<void> disconnect() noexcept override
+    {
+        if (connected_) {
+            close_session(clock_.get_timestamp_us());
+        }
+        connected_ = false;
+        return core::Result<void>{};
+    }
+
+    /// Drops are noticed at once (beacon loss); the session ends at the outage start.
+    bool is_connected() noexcept override
+    {
+        if (connected_) {
+            const Outage* outage = outage_at(clock_.get_timestamp_ms());
+            if (outage != nullptr) {
+                close_session(outage->start_ms * 1000U);
+                connected_ = false;
+            }
+        }
+        return connected_;
+    }
+
+    core::Result<void> get_ip(char* buf, size_t len) noexcept override
+    {
+        if (buf == nullptr || len == 0) {
+            return GS_MAKE_ERROR(core::ErrorCode::InvalidParameter);
+        }
+        (void)std::snprintf(buf, len, "192.168.1.%u", static_cast<unsigned>(ip_ & 0xFFU));
+        return core::Result<void>{};
+    }
+
+    core::Result<platform::WiFiLinkInfo> get_link_info() noexcept override
+    {
+        if (!connected_) {
+            return core::Result<platform::WiFiLinkInfo>(
+                GS_MAKE_ERROR(core::ErrorCode::WiFiNotConnected));
+        }
+        platform::WiFiLinkInfo info;
+        info.bssid = {0x02, 0x47, 0x53, 0x00, 0x00, 0x01};
+        info.channel = channel_;
+        info.rssi_dbm = -62;
+        info.ip.address = ip_;
+        info.ip.gateway = 0xC0A80101;
+        info.ip.netmask = 0xFFFFFF00;
+        info.lease_s = leased_ ? LEASE_S : 0;
+        return core::Result<platform::WiFiLinkInfo>(info);
+    }
+
+    core::Result<void> set_power_save(platform::WiFiPowerSave mode,
+                                      uint8_t listen_interval) noexcept override
+    {
+        if (connected_) {
+            close_session(clock_.get_timestamp_us());
+            session_start_us_ = clock_.get_timestamp_us();
+        }
+        ps_ = mode;
+        // DTIM 1, 100 TU beacons
+        const uint64_t beacons =
+            mode == platform::WiFiPowerSave::MaxModem && listen_interval > 1 ? listen_interval : 1;
+        wake_period_us_ = 100U * network::WIFI_TU_US * beacons;
+        return core::Result<void>{};
+    }
+
+    void finish() noexcept
+    {
+        (void)disconnect();
+    }
+
+private:
+    bool associate(const platform::WiFiConnectHint& hint) noexcept
+    {
+        const uint64_t now_ms = clock_.get_timestamp_ms();
+        const bool ap_up = outage_at(now_ms) == nullptr;
+        const uint8_t ap_channel = channel_at(now_ms);
+        if (hint.channel != 0) {
+            if (!ap_up || hint.channel != ap_channel) {
+                clock_.delay_ms(PROBE_TIMEOUT_MS);
+                return false;
+            }
+        } else {
+            clock_.delay_ms(uniform(rng_, SCAN_MIN_MS, SCAN_MAX_MS));
+            if (!ap_up) {
+                return false;
+            }
+        }
+        clock_.delay_ms(uniform(rng_, ASSOC_MIN_MS, ASSOC_MAX_MS));
+        channel_ = ap_channel;
+
+        if (hint.static_ip.is_set()) {
+            clock_.delay_ms(ARP_CHECK_MS);
+            ip_ = hint.static_ip.address;
+            leased_ = false;
+            return true;
+        }
+        if (uniform(rng_, 1, 100) <= DHCP_FAIL_PCT) {
+            clock_.delay_ms(DHCP_TIMEOUT_MS);
+            return false;
+        }
+        clock_.delay_ms(uniform(rng_, DHCP_MIN_MS, DHCP_MAX_MS));
+        ip_ = 0xC0A80164; // 192.168.1.100
+        leased_ = true;
+        return true;
+    }
+
+    void close_session(uint64_t end_us) noexcept
+    {
+        if (end_us <= session_start_us_) {
+            return;
+        }
+        if (ps_ == platform::WiFiPowerSave::None) {
+            meter.on(session_start_us_, end_us);
+        } else {
+            meter.beacons((end_us - session_start_us_) / wake_period_us_ * BEACON_RX_US);
+        }
+        session_start_us_ = end_us;
+    }
+
+    platform::sim::SimClock& clock_;
+    uint64_t rng_;
+    bool connected_{false};
+    uint8_t channel_{0};
+    uint32_t ip_{0};
+    bool leased_{false};
+    platform::WiFiPowerSave ps_{platform::WiFiPowerSave::None};
+    uint64_t wake_period_us_{102400};
+    uint64_t session_start_us_{0};
+};
+
+// ============================================================================
+// UPLINK
+// ============================================================================
+struct ClassDelay
+{
+    uint32_t delivered{};
+    uint64_t sum_ms{};
+    uint64_t worst_ms{};
+};
+
+/// Socket send over the station: each call is one frame on the air.
+class SimUplink final : public platform::IPlatformComm
+{
+public:
+    SimUplink(platform::sim::SimClock& clock, SimWiFi& wifi) noexcept : clock_(clock), wifi_(wifi)
+    {}
+
+    core::Result<void> init() noexcept override
+    {
+        return core::Result<void>{};
+    }
+    core::Result<void> shutdown() noexcept override
+    {
+        return core::Result<void>{};
+    }
+
+    core::Result<size_t> send(const uint8_t* data, size_t length) noexcept override
+    {
+        const uint64_t start_us = clock_.get_timestamp_us();
+        if (!wifi_.is_connected()) {
+            return core::Result<size_t>(GS_MAKE_ERROR(core::ErrorCode::NetworkDisconnected));
+        }
+        clock_.advance_us(TX_ACK_US + static_cast<uint64_t>(length) * 1000000U / PHY_BYTES_PER_S);
+        meter.on(start_us, clock_.get_timestamp_us() + TX_WAKE_US + TX_TAIL_US);
+
+        uint64_t created_ms = 0;
+        std::memcpy(&created_ms, data + sizeof(network::PacketHeader), sizeof(created_ms));
+        ClassDelay& d = delays[static_cast<size_t>(network::classify_frame(data, length))];
+        const uint64_t delay = clock_.get_timestamp_ms() - created_ms;
+        ++d.delivered;
+        d.sum_ms += delay;
+        d.worst_ms = std::max(d.worst_ms, delay);
+        return core::Result<size_t>(length);
+    }
+
+    core::Result<size_t>
+    receive(uint8_t* /*buffer*/, size_t /*max_length*/, uint32_t /*timeout_ms*/) noexcept override
+    {
+        return core::Result<size_t>(GS_MAKE_ERROR(core::ErrorCode::NetworkTimeout));
+    }
+
+    bool is_connected() noexcept override
+    {
+        return wifi_.is_connected();
+    }
+
+    ClassDelay delays[network::TRAFFIC_CLASS_COUNT]{};
+
+private:
+    platform::sim::SimClock& clock_;
+    SimWiFi& wifi_;
+};
+
+// ============================================================================
+// RUN
+// ============================================================================
+struct Outcome
+{
+    network::WiFiStats stats{};
+    ClassDelay telemetry{};
+    ClassDelay alert{};
+    uint32_t created{};
+    uint32_t refused{}; // send() failed: frame dropped by the application
+    double duty_pct{};
+};
+
+static void make_frame(uint8_t* frame, size_t length, bool alert, uint64_t created_ms)
+{
+    std::memset(frame, 0, length);
+    frame[0] = network::MAGIC_HEADER;
+    frame[offsetof(network::PacketHeader, type)] = static_cast<uint8_t>(
+        alert ? network::PacketType::TamperAlert : network::PacketType::MeterData);
+    frame[offsetof(network::PacketHeader, priority)] =
+        static_cast<uint8_t>(alert ? core::Priority::Critical : core::Priority::Normal);
+    std::memcpy(frame + sizeof(network::PacketHeader), &created_ms, sizeof(created_ms));
+}
+
+static Outcome
+run(const WiFiManagerConfig& config, uint64_t length_ms, uint64_t seed, uint64_t alert_seed)
+{
+    Outcome out;
+    meter.reset();
+    platform::sim::SimClock clock;
+    SimWiFi wifi(clock, seed);
+    SimUplink uplink(clock, wifi);
+    WiFiManager manager(wifi, uplink, clock);
+    (void)manager.configure(config);
+    (void)manager.init();
+
+    uint64_t alert_rng = alert_seed;
+    uint64_t next_reading = READING_INTERVAL_MS;
+    uint64_t next_alert = static_cast<uint64_t>(uniform(alert_rng, 10, 60)) * MS_PER_MIN;
+    uint64_t next_poll = POLL_MS;
+    uint8_t frame[TELEMETRY_BYTES];
+
+    while (clock.get_timestamp_ms() < length_ms) {
+        const uint64_t now = clock.get_timestamp_ms();
+        if (now >= next_reading) {
+            make_frame(frame, TELEMETRY_BYTES, false, next_reading);
+            ++out.created;
+            out.refused += manager.send(frame, TELEMETRY_BYTES).is_error() ? 1U : 0U;
+            next_reading += READING_INTERVAL_MS;
+        }
+        if (now >= next_alert) {
+            make_frame(frame, ALERT_BYTES, true, next_alert);
+            ++out.created;
+            out.refused += manager.send(frame, ALERT_BYTES).is_error() ? 1U : 0U;
+            next_alert += static_cast<uint64_t>(uniform(alert_rng, 10, 60)) * MS_PER_MIN;
+        }
+        if (now >= next_poll) {
+            manager.poll();
+            next_poll = (clock.get_timestamp_ms() / POLL_MS + 1U) * POLL_MS;
+        }
+        const uint64_t next = std::min(next_reading, std::min(next_alert, next_poll));
+        if (next > clock.get_timestamp_ms()) {
+            clock.advance_us((next - clock.get_timestamp_ms()) * 1000U);
+        }
+    }
+
+    const uint64_t end_us = clock.get_timestamp_us();
+    wifi.finish();
+    out.stats = manager.stats();
+    out.telemetry = uplink.delays[static_cast<size_t>(TrafficClass::Telemetry)];
+    out.alert = uplink.delays[static_cast<size_t>(TrafficClass::TamperAlert)];
+    out.duty_pct = 100.0 * static_cast<double>(meter.total_us(end_us)) /
+                   static_cast<double>(end_us);
+    return out;
+}
+
+static double mean_connect_ms(const Outcome& o)
+{
+    const uint32_t connects = o.stats.connects();
+    return connects == 0 ? 0.0 : static_cast<double>(o.stats.connect_ms_total) / connects;
+}
+
+static void report(const char* name, const Outcome& o)
+{
+    const double telemetry_mean =
+        o.telemetry.delivered == 0
+            ? 0.0
+            : static_cast<double>(o.telemetry.sum_ms) / o.telemetry.delivered / 1000.0;
+    const uint32_t delivered = o.telemetry.delivered + o.alert.delivered;
+    std::printf("  %-8s %4u/%-4u/%-3u %8.0f %8u %7.2f %8.1f %8.1f %8llu %6u\n",
+                name,
+                static_cast<unsigned>(o.stats.fast_connects),
+                static_cast<unsigned>(o.stats.full_connects),
+                static_cast<unsigned>(o.stats.fallback_connects),
+                mean_connect_ms(o),
+                static_cast<unsigned>(o.stats.worst_connect_ms),
+                o.duty_pct,
+                telemetry_mean,
+                static_cast<double>(o.telemetry.worst_ms) / 1000.0,
+                static_cast<unsigned long long>(o.alert.worst_ms),
+                static_cast<unsigned>(o.created - delivered));
+}
+
+int main(int argc, char** argv)
+{
+    BenchOptions opts;
+    if (!parse_args(argc, argv, opts)) {
+        print_usage(argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    const uint64_t length_ms = static_cast<uint64_t>(opts.hours) * MS_PER_HOUR;
+    uint64_t rng = opts.seed * 0x9E3779B97F4A7C15ULL + 1;
+    build_outages(length_ms, rng);
+    const uint64_t alert_seed = next_random(rng) | 1U;
+    const uint64_t radio_seed = next_random(rng) | 1U;
+
+    WiFiManagerConfig base;
+    base.ssid = "gridshield";
+    base.password = "bench";
+    base.static_fallback.address = 0xC0A801C8; // 192.168.1.200
+    base.static_fallback.gateway = 0xC0A80101;
+    base.static_fallback.netmask = 0xFFFFFF00;
+
+    WiFiManagerConfig current = base;
+    current.use_cache = false;
+    current.static_fallback = platform::WiFiIpConfig{};
+    current.power_save = platform::WiFiPowerSave::None;
+    current.batch_interval_ms = 0;
+
+    WiFiManagerConfig sleep = base;
+    sleep.batch_interval_ms = 0;
+
+    const WiFiManagerConfig& managed_config = base;
+
+    const Outcome before = run(current, length_ms, radio_seed, alert_seed);
+    const Outcome sleeping = run(sleep, length_ms, radio_seed, alert_seed);
+    const Outcome managed = run(managed_config, length_ms, radio_seed, alert_seed);
+
+    size_t channel_changes = 0;
+    for (size_t i = 0; i < outage_count; ++i) {
+        const uint8_t prev = i == 0 ? INITIAL_CHANNEL : outages[i - 1].channel_after;
+        channel_changes += outages[i].channel_after != prev ? 1U : 0U;
+    }
+    std::printf("%u h, %u messages, AP down %zu times (%zu on a new channel), seed %llu\n\n",
+                static_cast<unsigned>(opts.hours),
+                static_cast<unsigned>(managed.created),
+                outage_count,
+                channel_changes,
+                static_cast<unsigned long long>(opts.seed));
+    std::printf("  %-8s %-12s %8s %8s %7s %8s %8s %8s %6s\n",
+                "setup",
+                "fast/full/fb",
+                "conn ms",
+                "worst",
+                "radio%",
+                "tlm s",
+                "tlm max",
+                "alert ms",
+                "lost");
+    report("current", before);
+    report("sleep", sleeping);
+    report("managed", managed);
+    std::printf("\n  managed: %u windows, %u batched, %u immediate; reconnect %.1fx faster,"
+                " radio-on %.1fx lower than current\n",
+                static_cast<unsigned>(managed.stats.windows),
+                static_cast<unsigned>(managed.stats.batched),
+                static_cast<unsigned>(managed.stats.immediate),
+                mean_connect_ms(managed) > 0.0 ? mean_connect_ms(before) / mean_connect_ms(managed)
+                                               : 0.0,
+                managed.duty_pct > 0.0 ? before.duty_pct / managed.duty_pct : 0.0);
+
+    bool ok = true;
+    if (opts.max_reconnect_ms >= 0.0 && mean_connect_ms(managed) > opts.max_reconnect_ms) {
+        std::printf("FAIL: managed mean connect %.0f ms (limit %.0f ms)\n",
+                    mean_connect_ms(managed),
+                    opts.max_reconnect_ms);
+        ok = false;
+    }
+    if (opts.max_duty_pct >= 0.0 && managed.duty_pct > opts.max_duty_pct) {
+        std::printf("FAIL: managed radio-on %.2f%% (limit %.2f%%)\n",
+                    managed.duty_pct,
+                    opts.max_duty_pct);
+        ok = false;
+    }
+    const auto alert_worst_ms = static_cast<double>(managed.alert.worst_ms);
+    if (opts.max_alert_ms >= 0.0 && alert_worst_ms > opts.max_alert_ms) {
+        std::printf("FAIL: managed worst alert delay %llu ms (limit %.0f ms)\n",
+                    static_cast<unsigned long long>(managed.alert.worst_ms),
+                    opts.max_alert_ms);
+        ok = false;
+    }
+    return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -32,6 +32,30 @@ extern void test_telemetry_suite(void);
 extern "C" void test_mqtt_suite(void);
 extern "C" void test_sensors_suite(void);
 extern "C" void test_ota_power_suite(void);
+extern "C" void test_native_crypto_suite(void);
+extern void test_warm_boot_suite(void);
+extern void test_incremental_job_suite(void);
+extern void test_static_platform_suite(void);
+extern void test_flash_storage_suite(void);
+extern void test_net_emulator_suite(void);
+extern void test_flash_sim_suite(void);
+extern void test_posix_platform_suite(void);
+extern void test_nvs_storage_suite(void);
+extern void test_cascade_suite(void);
+extern void test_quantile_suite(void);
+extern void test_model_slots_suite(void);
+extern void test_flight_recorder_suite(void);
+extern void test_report_policy_suite(void);
+extern void test_replay_guard_suite(void);
+extern void test_ack_suite(void);
+extern void test_flat_map_suite(void);
+extern void test_deferred_log_suite(void);
+extern void test_fixed_point_suite(void);
+extern void test_three_phase_suite(void);
+extern void test_adaptive_sampling_suite(void);
+extern void test_transport_manager_suite(void);
+extern void test_wifi_manager_suite(void);
+extern void test_shadow_sync_suite(void);
 
 int main()
 {
@@ -59,6 +83,30 @@ int main()
     test_mqtt_suite();
     test_sensors_suite();
     test_ota_power_suite();
+    test_native_crypto_suite();
+    test_warm_boot_suite();
+    test_incremental_job_suite();
+    test_static_platform_suite();
+    test_flash_storage_suite();
+    test_net_emulator_suite();
+    test_flash_sim_suite();
+    test_posix_platform_suite();
+    test_nvs_storage_suite();
+    test_cascade_suite();
+    test_quantile_suite();
+    test_model_slots_suite();
+    test_flight_recorder_suite();
+    test_report_policy_suite();
+    test_replay_guard_suite();
+    test_ack_suite();
+    test_flat_map_suite();
+    test_deferred_log_suite();
+    test_fixed_point_suite();
+    test_three_phase_suite();
+    test_adaptive_sampling_suite();
+    test_transport_manager_suite();
+    test_wifi_manager_suite();
+    test_shadow_sync_suite();
 
     int failures = UNITY_END();
 
@@ -0,0 +1,385 @@
+/**
+ * @file cascade.hpp
+ * @brief Cascaded anomaly scoring: O(1) gates in front of ML inference
+ *
+ * Most readings are plainly normal, yet MlAnomalyDetector extracts features
+ * and invokes the model on every one. CascadeGate decides per sample whether
+ * the model needs to run at all:
+ *
+ *   1. Deadband      — deviation from profile moved less than the band
+ *                      since the last fully gated sample (so slow drift
+ *                      still accumulates): skip without further work.
+ *   2. Profile score — |deviation| against a learned noise scale. The scale
+ *                      is the mean sample-to-sample step, so a slow
+ *                      diversion cannot inflate it and hide itself.
+ *   3. Rate of change — step in deviation between consecutive samples.
+ *
+ * Tripping gate 2 or 3 escalates: every sample is scored until the gates
+ * and the model have stayed below the (lower) exit thresholds for a run of
+ * samples. Quiet samples are still audited at random; an audit the model
+ * flags counts as a gate miss, escalates and tightens the entry threshold.
+ *
+ * @note Header-only, zero heap allocation.
+ */
+
+#pragma once
+
+#include "analytics/ml_anomaly.hpp"
+#include "core/error.hpp"
+#include "utils/fixed_point.hpp"
+#include "utils/gs_macros.hpp"
+
+#include <cstdint>
+
+namespace gridshield::analytics {
+
+// ============================================================================
+// Constants
+// ============================================================================
+static constexpr uint32_t CASCADE_PERMILLE = 1000;
+static constexpr uint32_t CASCADE_SCALE_SHIFT = 4; // noise EWMA weight 1/16
+
+// ============================================================================
+// Types
+// ============================================================================
+
+struct CascadeConfig
+{
+    uint32_t deadband_permille{20};        // skip if deviation moved less than this
+    uint32_t score_enter_x1000{3500};      // |dev| / noise scale to escalate
+    uint32_t score_exit_x1000{2000};       // ... and to count as calm again
+    uint32_t roc_enter_permille{250};      // step in deviation to escalate
+    uint32_t min_scale_permille{20};       // floor of the learned noise scale
+    uint16_t exit_calm_samples{8};         // calm run needed to de-escalate
+    uint16_t audit_period{64};             // mean samples between audits (0 = off)
+    uint32_t audit_tighten_x1000{250};     // entry threshold cut per gate miss
+    uint32_t seed{0x6A09E667};
+};
+
+enum class CascadeReason : uint8_t
+{
+    Deadband = 0,     // skipped: nothing changed
+    Quiet = 1,        // skipped: gates below entry thresholds
+    ProfileScore = 2, // scored: deviation from profile
+    RateOfChange = 3, // scored: step change
+    Escalated = 4,    // scored: still inside an escalation
+    Audit = 5         // scored: random audit of a quiet sample
+};
+
+struct CascadeDecision
+{
+    bool score{false};
+    CascadeReason reason{CascadeReason::Quiet};
+};
+
+struct CascadeStats
+{
+    uint32_t samples{0};
+    uint32_t scored{0};
+    uint32_t deadband_skips{0};
+    uint32_t quiet_skips{0};
+    uint32_t escalations{0};
+    uint32_t audits{0};
+    uint32_t audit_misses{0}; // audits the model flagged while the gate was quiet
+
+    GS_NODISCARD uint32_t skipped() const noexcept
+    {
+        return deadband_skips + quiet_skips;
+    }
+
+    GS_NODISCARD uint32_t skip_fraction_x1000() const noexcept
+    {
+        return samples == 0 ? 0 : static_cast<uint32_t>(
+                                      (static_cast<uint64_t>(skipped()) * CASCADE_PERMILLE) /
+                                      samples);
+    }
+};
+
+// ============================================================================
+// Cascade Gate
+// ============================================================================
+
+class CascadeGate
+{
+public:
+    void init(const CascadeConfig& config = CascadeConfig{}) noexcept
+    {
+        config_ = config;
+        score_enter_x1000_ = config.score_enter_x1000;
+        scale_x16_ = config.min_scale_permille << CASCADE_SCALE_SHIFT;
+        rng_ = (config.seed != 0) ? config.seed : 1U;
+        escalated_ = false;
+        have_last_ = false;
+        calm_run_ = 0;
+        stats_ = CascadeStats{};
+    }
+
+    /**
+     * @brief Decide whether @p value needs the expensive scorer.
+     * @param value    Observed reading (e.g. energy_wh)
+     * @param expected Profile expectation for the same time slot
+     */
+    CascadeDecision evaluate(uint32_t value, uint32_t expected) noexcept
+    {
+        ++stats_.samples;
+        const int32_t dev = deviation_permille(value, expected);
+        const int32_t last = last_dev_;
+        const bool first = !have_last_;
+        last_dev_ = dev;
+        have_last_ = true;
+
+        const uint32_t step = first ? 0U : abs_diff(dev, last);
+        const uint32_t abs_dev = static_cast<uint32_t>(dev < 0 ? -dev : dev);
+        const uint32_t score_x1000 = profile_score_x1000(abs_dev);
+
+        if (escalated_) {
+            const bool calm =
+                score_x1000 < config_.score_exit_x1000 && step < config_.roc_enter_permille;
+            calm_run_ = calm ? static_cast<uint16_t>(calm_run_ + 1) : 0;
+            pending_step_ = step;
+            return scored(CascadeReason::Escalated);
+        }
+
+        // Gate 1: deviation unchanged since the last full check
+        if (!first && abs_diff(dev, anchor_dev_) < config_.deadband_permille) {
+            ++stats_.deadband_skips;
+            return maybe_audit(CascadeReason::Deadband);
+        }
+        anchor_dev_ = dev;
+
+        // Gates 2 and 3
+        if (score_x1000 >= score_enter_x1000_) {
+            escalate();
+            return scored(CascadeReason::ProfileScore);
+        }
+        if (step >= config_.roc_enter_permille) {
+            escalate();
+            return scored(CascadeReason::RateOfChange);
+        }
+
+        // Quiet: learn the noise scale from normal samples only
+        learn_scale(step);
+        ++stats_.quiet_skips;
+        return maybe_audit(CascadeReason::Quiet);
+    }
+
+    /// Feed back the scorer's verdict for the sample just evaluated.
+    void report(const CascadeDecision& decision, bool anomaly) noexcept
+    {
+        if (!decision.score) {
+            return;
+        }
+        if (decision.reason == CascadeReason::Audit) {
+            if (anomaly) {
+                ++stats_.audit_misses;
+                tighten();
+                escalate();
+            } else {
+                relax();
+            }
+            return;
+        }
+        if (anomaly) {
+            calm_run_ = 0;
+            return;
+        }
+        if (!escalated_) {
+            return;
+        }
+        // Model-confirmed normal: keep learning, or a scale that started too
+        // small would hold the gate escalated forever
+        learn_scale(pending_step_);
+        if (calm_run_ >= config_.exit_calm_samples) {
+            escalated_ = false;
+            calm_run_ = 0;
+            anchor_dev_ = last_dev_;
+        }
+    }
+
+    GS_NODISCARD bool escalated() const noexcept
+    {
+        return escalated_;
+    }
+    /// Current entry threshold (lowered by gate misses, restored by clean audits).
+    GS_NODISCARD uint32_t score_enter_x1000() const noexcept
+    {
+        return score_enter_x1000_;
+    }
+    GS_NODISCARD uint32_t noise_scale_permille() const noexcept
+    {
+        return scale_x16_ >> CASCADE_SCALE_SHIFT;
+    }
+    GS_NODISCARD const CascadeStats& stats() const noexcept
+    {
+        return stats_;
+    }
+    void reset_stats() noexcept
+    {
+        stats_ = CascadeStats{};
+    }
+
+private:
+    static int32_t deviation_permille(uint32_t value, uint32_t expected) noexcept
+    {
+        if (expected == 0) {
+            return value == 0 ? 0 : static_cast<int32_t>(CASCADE_PERMILLE);
+        }
+        const int64_t diff = static_cast<int64_t>(value) - static_cast<int64_t>(expected);
+        int64_t dev = (diff * CASCADE_PERMILLE) / static_cast<int64_t>(expected);
+        // Clamp: a >10x spike is as anomalous as it gets
+        if (dev > 10 * static_cast<int64_t>(CASCADE_PERMILLE)) {
+            dev = 10 * static_cast<int64_t>(CASCADE_PERMILLE);
+        }
+        return static_cast<int32_t>(dev);
+    }
+
+    static uint32_t abs_diff(int32_t a, int32_t b) noexcept
+    {
+        return static_cast<uint32_t>(a > b ? a - b : b - a);
+    }
+
+    GS_NODISCARD uint32_t profile_score_x1000(uint32_t abs_dev) const noexcept
+    {
+        uint32_t scale = scale_x16_ >> CASCADE_SCALE_SHIFT;
+        if (scale < config_.min_scale_permille) {
+            scale = config_.min_scale_permille;
+        }
+        return utils::mul_div_u32(abs_dev, CASCADE_PERMILLE, scale == 0 ? 1U : scale);
+    }
+
+    void learn_scale(uint32_t step) noexcept
+    {
+        scale_x16_ = scale_x16_ - (scale_x16_ >> CASCADE_SCALE_SHIFT) + step;
+    }
+
+    void escalate() noexcept
+    {
+        if (!escalated_) {
+            escalated_ = true;
+            ++stats_.escalations;
+        }
+        calm_run_ = 0;
+    }
+
+    void tighten() noexcept
+    {
+        const uint32_t floor = config_.score_exit_x1000;
+        score_enter_x1000_ = (score_enter_x1000_ > floor + config_.audit_tighten_x1000)
+                                 ? score_enter_x1000_ - config_.audit_tighten_x1000
+                                 : floor;
+    }
+
+    void relax() noexcept
+    {
+        // Clean audits walk a tightened threshold back, a quarter step each
+        const uint32_t step = config_.audit_tighten_x1000 / 4U;
+        score_enter_x1000_ = (score_enter_x1000_ + step < config_.score_enter_x1000)
+                                 ? score_enter_x1000_ + step
+                                 : config_.score_enter_x1000;
+    }
+
+    CascadeDecision maybe_audit(CascadeReason skip_reason) noexcept
+    {
+        if (config_.audit_period != 0 && next_random() % config_.audit_period == 0) {
+            ++stats_.audits;
+            ++stats_.scored;
+            // Undo the skip accounting: this sample reaches the model
+            if (skip_reason == CascadeReason::Deadband) {
+                --stats_.deadband_skips;
+            } else {
+                --stats_.quiet_skips;
+            }
+            return CascadeDecision{true, CascadeReason::Audit};
+        }
+        return CascadeDecision{false, skip_reason};
+    }
+
+    CascadeDecision scored(CascadeReason reason) noexcept
+    {
+        ++stats_.scored;
+        return CascadeDecision{true, reason};
+    }
+
+    uint32_t next_random() noexcept
+    {
+        // xorshift32
+        rng_ ^= rng_ << 13;
+        rng_ ^= rng_ >> 17;
+        rng_ ^= rng_ << 5;
+        return rng_;
+    }
+
+    CascadeConfig config_{};
+    uint32_t score_enter_x1000_{0};
+    uint32_t scale_x16_{0};
+    uint32_t rng_{1};
+    int32_t last_dev_{0};
+    int32_t anchor_dev_{0};
+    uint32_t pending_step_{0};
+    uint16_t calm_run_{0};
+    bool escalated_{false};
+    bool have_last_{false};
+    CascadeStats stats_{};
+};
+
+// ============================================================================
+// Cascaded ML Detector
+// ============================================================================
+
+/**
+ * @brief MlAnomalyDetector behind a CascadeGate.
+ *
+ * score() returns an AnomalyScore with valid == false when the gate skipped
+ * the sample; callers treat that as "normal, not evaluated".
+ */
+class CascadedMlDetector
+{
+public:
+    core::Result<void> init(ITfliteRunner* runner,
+                            const CascadeConfig& config = CascadeConfig{}) noexcept
+    {
+        GS_TRY(detector_.init(runner));
+        gate_.init(config);
+        return core::Result<void>{};
+    }
+
+    core::Result<AnomalyScore> score(const SensorSnapshot& snapshot,
+                                     uint32_t expected_wh) noexcept
+    {
+        if (GS_UNLIKELY(!detector_.is_initialized())) {
+            return core::Result<AnomalyScore>(GS_MAKE_ERROR(core::ErrorCode::SystemNotInitialized));
+        }
+        const CascadeDecision decision = gate_.evaluate(snapshot.energy_wh, expected_wh);
+        last_reason_ = decision.reason;
+        if (!decision.score) {
+            return core::Result<AnomalyScore>(AnomalyScore{});
+        }
+
+        auto result = detector_.score(snapshot);
+        if (result.is_error()) {
+            return result;
+        }
+        gate_.report(decision, result.value().is_anomaly);
+        return result;
+    }
+
+    GS_NODISCARD CascadeReason last_reason() const noexcept
+    {
+        return last_reason_;
+    }
+    GS_NODISCARD CascadeGate& gate() noexcept
+    {
+        return gate_;
+    }
+    GS_NODISCARD MlAnomalyDetector& detector() noexcept
+    {
+        return detector_;
+    }
+
+private:
+    MlAnomalyDetector detector_;
+    CascadeGate gate_;
+    CascadeReason last_reason_{CascadeReason::Quiet};
+};
+
+} // namespace gridshield::analytics
@@ -11,6 +11,7 @@
 
 #pragma once
 
+#include "analytics/quantile.hpp"
 #include "core/error.hpp"
 #include "core/types.hpp"
 #include <array>
@@ -35,6 +36,14 @@ constexpr uint32_t SEVERITY_LOW_THRESHOLD = 20;
 // Confidence score for high-certainty detections
 constexpr uint16_t CONFIDENCE_HIGH = 95;
 
+// Empirical per-hour thresholds: drop and spike deviations are skewed
+// differently (appliance bursts vs. bounded drops), so each direction keeps
+// its own quantile per hour bin; it replaces the fixed variance_threshold
+// once the bin has enough samples
+constexpr uint16_t DEVIATION_QUANTILE_X1000 = 990; // p99
+constexpr uint32_t QUANTILE_MIN_SAMPLES = 48;      // ~12 days of 15-min readings
+constexpr uint32_t QUANTILE_WINSOR_FACTOR = 2;     // learn at most 2x the threshold
+
 // ============================================================================
 // ANOMALY CLASSIFICATION
 // ============================================================================
@@ -72,6 +81,32 @@ struct ConsumptionProfile
     GS_CONSTEXPR ConsumptionProfile() noexcept = default;
 };
 
+// ============================================================================
+// DETECTOR CHECKPOINT (warm-boot state)
+// ============================================================================
+/**
+ * @brief Learned detector state persisted across reboots.
+ *
+ * Only energy values of the rolling window are kept — that is all
+ * update_profile() reads back — plus the per-hour deviation quantiles, so
+ * a reboot does not fall back to the fixed threshold for ~12 days.
+ * The checkpoint stays ~1.25 KB.
+ */
+struct DetectorCheckpoint
+{
+    static constexpr uint8_t VERSION = 2;
+
+    ConsumptionProfile profile;
+    uint16_t recent_count{};
+    uint8_t version{VERSION};
+    uint8_t reserved{};
+    std::array<uint32_t, MAX_RECENT_READINGS> recent_energy_wh{};
+    std::array<P2Snapshot, PROFILE_HISTORY_SIZE> drop_quantiles{};
+    std::array<P2Snapshot, PROFILE_HISTORY_SIZE> spike_quantiles{};
+
+    GS_CONSTEXPR DetectorCheckpoint() noexcept = default;
+};
+
 // ============================================================================
 // ANOMALY REPORT
 // ============================================================================
@@ -122,12 +157,24 @@ public:
     GS_NODISCARD const ConsumptionProfile& get_profile() const noexcept override;
     core::Result<void> reset_profile() noexcept override;
 
+    // Warm-boot persistence
+    void export_state(DetectorCheckpoint& out) const noexcept;
+    core::Result<void> restore_state(const DetectorCheckpoint& state) noexcept;
+
+    /// Deviation threshold (percent) in effect for @p hour_index in one
+    /// direction: the bin's empirical p99 once learned, else
+    /// profile.variance_threshold.
+    GS_NODISCARD uint32_t deviation_threshold(size_t hour_index, bool drop) const noexcept;
+
 private:
     GS_NODISCARD static AnomalySeverity calculate_severity(uint32_t deviation_percent) noexcept;
     GS_NODISCARD uint32_t calculate_expected_value(core::timestamp_t timestamp) const noexcept;
+    void reset_quantiles() noexcept;
 
     ConsumptionProfile profile_;
     core::StaticBuffer<core::MeterReading, MAX_RECENT_READINGS> recent_readings_;
+    std::array<P2Quantile, PROFILE_HISTORY_SIZE> drop_quantiles_{};
+    std::array<P2Quantile, PROFILE_HISTORY_SIZE> spike_quantiles_{};
     bool initialized_{false};
 };
 
@@ -9,6 +9,7 @@
 
 #include "analytics/tflite_runner.hpp"
 #include "core/error.hpp"
+#include "utils/fixed_point.hpp"
 #include "utils/gs_macros.hpp"
 
 #include <array>
@@ -87,19 +88,17 @@ public:
         static constexpr int32_t ACCEL_NORM_DIVISOR = 1000;
         static constexpr int32_t SECONDS_PER_DAY = 86400;
 
+        // Saturating: an out-of-range reading pins its feature instead of wrapping
         fv.features[0] =
-            static_cast<int32_t>((static_cast<int64_t>(snapshot.voltage_mv) * ML_THRESHOLD_SCALE) /
-                                 VOLTAGE_NORM_DIVISOR);
+            utils::mul_div_i32(snapshot.voltage_mv, ML_THRESHOLD_SCALE, VOLTAGE_NORM_DIVISOR);
         fv.features[1] =
-            static_cast<int32_t>((static_cast<int64_t>(snapshot.current_ma) * ML_THRESHOLD_SCALE) /
-                                 CURRENT_NORM_DIVISOR);
-        fv.features[2] = static_cast<int32_t>(
-            (static_cast<int64_t>(snapshot.energy_wh) * ML_THRESHOLD_SCALE) / ENERGY_NORM_DIVISOR);
-        fv.features[3] = static_cast<int32_t>(
-            (static_cast<int64_t>(snapshot.temperature_c10) * ML_THRESHOLD_SCALE) /
-            TEMP_NORM_DIVISOR);
-        fv.features[4] = static_cast<int32_t>(
-            (static_cast<int64_t>(snapshot.accel_mg) * ML_THRESHOLD_SCALE) / ACCEL_NORM_DIVISOR);
+            utils::mul_div_i32(snapshot.current_ma, ML_THRESHOLD_SCALE, CURRENT_NORM_DIVISOR);
+        fv.features[2] =
+            utils::mul_div_i32(snapshot.energy_wh, ML_THRESHOLD_SCALE, ENERGY_NORM_DIVISOR);
+        fv.features[3] =
+            utils::mul_div_i32(snapshot.temperature_c10, ML_THRESHOLD_SCALE, TEMP_NORM_DIVISOR);
+        fv.features[4] =
+            utils::mul_div_i32(snapshot.accel_mg, ML_THRESHOLD_SCALE, ACCEL_NORM_DIVISOR);
         fv.features[5] =
             static_cast<int32_t>(snapshot.timestamp % static_cast<uint64_t>(SECONDS_PER_DAY));
 
@@ -170,6 +169,23 @@ public:
         return core::Result<AnomalyScore>(GS_MOVE(result));
     }
 
+    /// Replace the model between score() calls; the adaptive threshold and
+    /// score history carry over. Returns the previous runner (nullptr and no
+    /// change if @p runner is null).
+    ITfliteRunner* swap_runner(ITfliteRunner* runner) noexcept
+    {
+        if (runner == nullptr) {
+            return nullptr;
+        }
+        ITfliteRunner* previous = runner_;
+        runner_ = runner;
+        return previous;
+    }
+    const ITfliteRunner* runner() const noexcept
+    {
+        return runner_;
+    }
+
     int32_t threshold() const noexcept
     {
         return threshold_x1000_;
@@ -0,0 +1,582 @@
+/**
+ * @file model_slots.hpp
+ * @brief Double-buffered model slots: hot-swap anomaly models at runtime
+ *
+ * Two flash slots, each paired with its own ITfliteRunner and resident
+ * model image. A new signed model streams into the inactive slot while the
+ * active one keeps scoring; the warm-up job then reads it back, checks the
+ * SHA-256 and ECDSA signature, loads it (allocating its arena) and runs the
+ * calibration vectors, one bounded step per JobScheduler cycle. activate()
+ * swaps MlAnomalyDetector's runner pointer between two score() calls, so
+ * detection never pauses. The previous model stays loaded for a probation
+ * window; if the new model fails inferences or its anomaly rate regresses
+ * against the old model's, the pointer is swapped back.
+ *
+ * The active slot is recorded in storage only once probation passes;
+ * restore() re-stages it after a reboot.
+ *
+ * @note Header-only, zero heap allocation.
+ */
+
+#pragma once
+
+#include "analytics/ml_anomaly.hpp"
+#include "analytics/tflite_runner.hpp"
+#include "core/error.hpp"
+#include "core/incremental_job.hpp"
+#include "platform/platform.hpp"
+#include "security/crypto.hpp"
+#include "utils/gs_macros.hpp"
+
+#include <array>
+#include <cstdint>
+#include <cstring>
+
+namespace gridshield::analytics {
+
+// ============================================================================
+// Constants
+// ============================================================================
+static constexpr size_t MODEL_SLOT_COUNT = 2;
+static constexpr uint8_t MODEL_SLOT_NONE = 0xFF;
+static constexpr size_t MODEL_CALIBRATION_MAX = 8;
+static constexpr size_t MODEL_DIGEST_SIZE = 32;
+static constexpr size_t MODEL_SIGNATURE_SIZE = 64; // ECDSA P-256
+static constexpr size_t MODEL_SIGNED_BODY_SIZE = 12 + MODEL_DIGEST_SIZE;
+static constexpr size_t MODEL_READ_CHUNK = 1024; // flash → image per job step
+static constexpr uint32_t MODEL_RECORD_MAGIC = 0x544C534DU; // "MSLT"
+
+// ============================================================================
+// Types
+// ============================================================================
+
+/// Publisher-signed description of a model blob.
+struct ModelManifest
+{
+    uint32_t version{0};
+    uint32_t size_bytes{0};
+    int32_t threshold_x1000{0}; // 0 = keep the running detector threshold
+    std::array<uint8_t, MODEL_DIGEST_SIZE> sha256{};
+    std::array<uint8_t, MODEL_SIGNATURE_SIZE> signature{}; // over signed_body()
+
+    /// Little-endian version | size | threshold | sha256: the signed bytes.
+    void signed_body(uint8_t out[MODEL_SIGNED_BODY_SIZE]) const noexcept
+    {
+        const uint32_t fields[3] = {version, size_bytes, static_cast<uint32_t>(threshold_x1000)};
+        for (size_t f = 0; f < 3; ++f) {
+            for (size_t b = 0; b < 4; ++b) {
+                out[f * 4 + b] = static_cast<uint8_t>(fields[f] >> (8 * b));
+            }
+        }
+        std::memcpy(&out[12], sha256.data(), MODEL_DIGEST_SIZE);
+    }
+};
+
+/// Known input and the score the publisher expects the model to produce.
+struct ModelCalibration
+{
+    std::array<int32_t, ML_FEATURE_COUNT> features{};
+    int32_t expected_score_x1000{0};
+};
+
+enum class ModelSlotState : uint8_t
+{
+    Empty = 0,
+    Receiving = 1, // blob streaming into flash
+    Staged = 2,    // fully written, waiting for the warm-up job
+    Verifying = 3, // warm-up job running
+    Ready = 4,     // verified, loaded and calibrated
+    Active = 5,    // behind the detector
+    Failed = 6
+};
+
+struct ModelSlotConfig
+{
+    std::array<uint32_t, MODEL_SLOT_COUNT> slot_address{{0x0000, 0x4000}};
+    uint32_t slot_capacity{TFLITE_MAX_MODEL_SIZE};
+    uint32_t record_address{0x8000};
+    int32_t calibration_tolerance_x1000{50};
+    uint32_t probation_samples{64};
+    uint32_t max_probation_failures{0};
+    uint16_t max_anomaly_rate_increase_permille{100};
+
+    GS_CONSTEXPR ModelSlotConfig() noexcept = default;
+};
+
+struct ModelSwapStats
+{
+    uint32_t swaps{0};
+    uint32_t confirmations{0};
+    uint32_t rollbacks{0};
+    uint32_t verify_failures{0};
+    uint32_t calibration_failures{0};
+    uint32_t inference_failures{0}; // observed score() errors, any model
+    uint32_t probation_scored{0};
+    uint32_t probation_anomalies{0};
+};
+
+/// Persisted in storage at config.record_address.
+struct ModelSlotRecord
+{
+    uint32_t magic{0};
+    uint8_t active_slot{MODEL_SLOT_NONE};
+    uint8_t reserved[3]{};
+    ModelManifest manifest{};
+};
+
+// ============================================================================
+// Slot Manager
+// ============================================================================
+
+/**
+ * @tparam MaxModelSize Bytes reserved per resident image (two are kept)
+ */
+template <size_t MaxModelSize = TFLITE_MAX_MODEL_SIZE> class ModelSlotManager
+{
+public:
+    // === Warm-up job: verify → load → calibrate, one bounded step at a time ===
+    class WarmupJob final : public core::IIncrementalJob
+    {
+    public:
+        explicit WarmupJob(ModelSlotManager& owner) noexcept : owner_(owner) {}
+
+        core::JobStatus step() noexcept override
+        {
+            return owner_.warmup_step();
+        }
+        void reset() noexcept override
+        {
+            owner_.phase_ = Phase::Read;
+            owner_.cursor_ = 0;
+        }
+
+    private:
+        ModelSlotManager& owner_;
+    };
+
+    ModelSlotManager() noexcept : job_(*this) {}
+
+    // Owns references handed to the job and the detector
+    ModelSlotManager(const ModelSlotManager&) = delete;
+    ModelSlotManager& operator=(const ModelSlotManager&) = delete;
+
+    core::Result<void> init(ITfliteRunner& runner_a,
+                            ITfliteRunner& runner_b,
+                            platform::IPlatformStorage& storage,
+                            security::ICryptoEngine& crypto,
+                            const security::ECCKeyPair& publisher_key,
+                            const ModelSlotConfig& config = ModelSlotConfig{}) noexcept
+    {
+        if (!publisher_key.has_public_key() || config.slot_capacity > MaxModelSize) {
+            return GS_MAKE_ERROR(core::ErrorCode::InvalidParameter);
+        }
+        runners_[0] = &runner_a;
+        runners_[1] = &runner_b;
+        storage_ = &storage;
+        crypto_ = &crypto;
+        publisher_key_ = &publisher_key;
+        config_ = config;
+        slots_.fill(SlotInfo{});
+        active_ = MODEL_SLOT_NONE;
+        staged_ = MODEL_SLOT_NONE;
+        previous_ = MODEL_SLOT_NONE;
+        stats_ = ModelSwapStats{};
+        initialized_ = true;
+        return core::Result<void>{};
+    }
+
+    /// Detector whose runner this manager swaps.
+    void bind(MlAnomalyDetector& detector) noexcept
+    {
+        detector_ = &detector;
+    }
+
+    /// Calibration vectors checked during the next warm-up (copied).
+    core::Result<void> set_calibration(const ModelCalibration* vectors, size_t count) noexcept
+    {
+        if (count > MODEL_CALIBRATION_MAX || (count > 0 && vectors == nullptr)) {
+            return GS_MAKE_ERROR(core::ErrorCode::InvalidParameter);
+        }
+        for (size_t idx = 0; idx < count; ++idx) {
+            calibration_[idx] = vectors[idx];
+        }
+        calibration_count_ = count;
+        return core::Result<void>{};
+    }
+
+    // === Streaming into the inactive slot ===
+
+    core::Result<void> begin_update(const ModelManifest& manifest) noexcept
+    {
+        if (GS_UNLIKELY(!initialized_)) {
+            return GS_MAKE_ERROR(core::ErrorCode::SystemNotInitialized);
+        }
+        if (manifest.size_bytes == 0 || manifest.size_bytes > config_.slot_capacity) {
+            return GS_MAKE_ERROR(core::ErrorCode::InvalidParameter);
+        }
+        // One change at a time: the fallback slot is busy until probation ends
+        if (in_probation()) {
+            return GS_MAKE_ERROR(core::ErrorCode::InvalidState);
+        }
+
+        const uint8_t target = inactive_slot();
+        runners_[target]->unload();
+        GS_TRY(storage_->erase(config_.slot_address[target], config_.slot_capacity));
+
+        SlotInfo& slot = slots_[target];
+        slot = SlotInfo{};
+        slot.manifest = manifest;
+        slot.state = ModelSlotState::Receiving;
+        staged_ = target;
+        return core::Result<void>{};
+    }
+
+    core::Result<void> write_chunk(const uint8_t* data, size_t length) noexcept
+    {
+        if (staged_ == MODEL_SLOT_NONE || slots_[staged_].state != ModelSlotState::Receiving) {
+            return GS_MAKE_ERROR(core::ErrorCode::InvalidState);
+        }
+        SlotInfo& slot = slots_[staged_];
+        if (data == nullptr || length > slot.manifest.size_bytes - slot.received) {
+            return GS_MAKE_ERROR(core::ErrorCode::InvalidParameter);
+        }
+        GS_TRY(storage_->write(config_.slot_address[staged_] + slot.received, data, length));
+        slot.received += static_cast<uint32_t>(length);
+        return core::Result<void>{};
+    }
+
+    /// All bytes written: the warm-up job may run (submit warmup_job()).
+    core::Result<void> finish_update() noexcept
+    {
+        if (staged_ == MODEL_SLOT_NONE || slots_[staged_].state != ModelSlotState::Receiving) {
+            return GS_MAKE_ERROR(core::ErrorCode::InvalidState);
+        }
+        SlotInfo& slot = slots_[staged_];
+        if (slot.received != slot.manifest.size_bytes) {
+            return GS_MAKE_ERROR(core::ErrorCode::DataInvalid);
+        }
+        GS_TRY(storage_->flush());
+        stage(staged_);
+        return core::Result<void>{};
+    }
+
+    GS_NODISCARD WarmupJob& warmup_job() noexcept
+    {
+        return job_;
+    }
+
+    // === Swap / probation / rollback ===
+
+    /**
+     * @brief Point the detector at the warmed-up slot.
+     *
+     * A pointer store between score() calls (the main loop runs both), so
+     * no reading goes unscored. The first model is trusted as-is; later
+     * ones enter probation with the previous model kept loaded.
+     */
+    core::Result<void> activate() noexcept
+    {
+        if (GS_UNLIKELY(!initialized_ || detector_ == nullptr || !detector_->is_initialized())) {
+            return GS_MAKE_ERROR(core::ErrorCode::SystemNotInitialized);
+        }
+        if (staged_ == MODEL_SLOT_NONE || slots_[staged_].state != ModelSlotState::Ready) {
+            return GS_MAKE_ERROR(core::ErrorCode::InvalidState);
+        }
+
+        const uint8_t next = staged_;
+        (void)detector_->swap_runner(runners_[next]);
+        previous_threshold_x1000_ = detector_->threshold();
+        if (slots_[next].manifest.threshold_x1000 != 0) {
+            detector_->set_threshold(slots_[next].manifest.threshold_x1000);
+        }
+
+        previous_ = active_;
+        active_ = next;
+        staged_ = MODEL_SLOT_NONE;
+        slots_[next].state = ModelSlotState::Active;
+        ++stats_.swaps;
+        stats_.probation_scored = 0;
+        stats_.probation_anomalies = 0;
+
+        if (previous_ == MODEL_SLOT_NONE) {
+            return confirm();
+        }
+        return core::Result<void>{};
+    }
+
+    /// Feed every score() result; drives baseline, probation and rollback.
+    void observe(const core::Result<AnomalyScore>& result) noexcept
+    {
+        const bool failed = result.is_error() || !result.value().valid;
+        const bool anomaly = !failed && result.value().is_anomaly;
+        if (failed) {
+            ++stats_.inference_failures;
+        }
+
+        if (!in_probation()) {
+            // Baseline of the trusted model: a window that halves when full
+            ++baseline_scored_;
+            baseline_anomalies_ += anomaly ? 1U : 0U;
+            if (baseline_scored_ >= 2 * config_.probation_samples) {
+                baseline_scored_ /= 2;
+                baseline_anomalies_ /= 2;
+            }
+            return;
+        }
+
+        ++stats_.probation_scored;
+        if (failed) {
+            ++probation_failures_;
+        }
+        stats_.probation_anomalies += anomaly ? 1U : 0U;
+
+        if (probation_failures_ > config_.max_probation_failures) {
+            (void)rollback();
+        } else if (stats_.probation_scored >= config_.probation_samples) {
+            if (anomaly_rate_regressed()) {
+                (void)rollback();
+            } else {
+                (void)confirm();
+            }
+        }
+    }
+
+    /// Swap back to the previous model (also called on regression).
+    core::Result<void> rollback() noexcept
+    {
+        if (!in_probation()) {
+            return GS_MAKE_ERROR(core::ErrorCode::InvalidState);
+        }
+        (void)detector_->swap_runner(runners_[previous_]);
+        detector_->set_threshold(previous_threshold_x1000_);
+
+        runners_[active_]->unload();
+        slots_[active_].state = ModelSlotState::Failed;
+        active_ = previous_;
+        previous_ = MODEL_SLOT_NONE;
+        probation_failures_ = 0;
+        ++stats_.rollbacks;
+        return core::Result<void>{};
+    }
+
+    /// Re-stage the slot recorded before the last reboot (warm-up job verifies it).
+    core::Result<void> restore() noexcept
+    {
+        if (GS_UNLIKELY(!initialized_)) {
+            return GS_MAKE_ERROR(core::ErrorCode::SystemNotInitialized);
+        }
+        ModelSlotRecord record{};
+        GS_TRY(storage_->read(
+            config_.record_address, reinterpret_cast<uint8_t*>(&record), sizeof(record)));
+        if (record.magic != MODEL_RECORD_MAGIC || record.active_slot >= MODEL_SLOT_COUNT ||
+            record.manifest.size_bytes > config_.slot_capacity) {
+            return GS_MAKE_ERROR(core::ErrorCode::DataInvalid);
+        }
+        slots_[record.active_slot] = SlotInfo{};
+        slots_[record.active_slot].manifest = record.manifest;
+        slots_[record.active_slot].received = record.manifest.size_bytes;
+        stage(record.active_slot);
+        return core::Result<void>{};
+    }
+
+    // === Accessors ===
+
+    GS_NODISCARD uint8_t active_slot() const noexcept
+    {
+        return active_;
+    }
+    GS_NODISCARD uint8_t staged_slot() const noexcept
+    {
+        return staged_;
+    }
+    GS_NODISCARD ModelSlotState slot_state(size_t slot) const noexcept
+    {
+        return slots_[slot % MODEL_SLOT_COUNT].state;
+    }
+    GS_NODISCARD uint32_t active_version() const noexcept
+    {
+        return active_ == MODEL_SLOT_NONE ? 0 : slots_[active_].manifest.version;
+    }
+    GS_NODISCARD bool in_probation() const noexcept
+    {
+        return previous_ != MODEL_SLOT_NONE;
+    }
+    GS_NODISCARD const ModelSwapStats& stats() const noexcept
+    {
+        return stats_;
+    }
+
+private:
+    enum class Phase : uint8_t
+    {
+        Read = 0,
+        Verify = 1,
+        Load = 2,
+        Calibrate = 3
+    };
+
+    struct SlotInfo
+    {
+        ModelManifest manifest{};
+        uint32_t received{0};
+        ModelSlotState state{ModelSlotState::Empty};
+    };
+
+    GS_NODISCARD uint8_t inactive_slot() const noexcept
+    {
+        return active_ == 0 ? 1 : 0;
+    }
+
+    void stage(uint8_t slot) noexcept
+    {
+        slots_[slot].state = ModelSlotState::Staged;
+        staged_ = slot;
+        phase_ = Phase::Read;
+        cursor_ = 0;
+    }
+
+    core::JobStatus fail(bool calibration) noexcept
+    {
+        runners_[staged_]->unload();
+        slots_[staged_].state = ModelSlotState::Failed;
+        if (calibration) {
+            ++stats_.calibration_failures;
+        } else {
+            ++stats_.verify_failures;
+        }
+        return core::JobStatus::Failed;
+    }
+
+    core::JobStatus warmup_step() noexcept
+    {
+        if (staged_ == MODEL_SLOT_NONE) {
+            return core::JobStatus::Failed;
+        }
+        SlotInfo& slot = slots_[staged_];
+        if (slot.state != ModelSlotState::Staged && slot.state != ModelSlotState::Verifying) {
+            return core::JobStatus::Failed;
+        }
+        slot.state = ModelSlotState::Verifying;
+        uint8_t* image = images_[staged_].data();
+        const uint32_t size = slot.manifest.size_bytes;
+
+        switch (phase_) {
+        case Phase::Read: {
+            const uint32_t left = size - cursor_;
+            const uint32_t len = left < MODEL_READ_CHUNK ? left : MODEL_READ_CHUNK;
+            const uint32_t address = config_.slot_address[staged_] + cursor_;
+            if (storage_->read(address, &image[cursor_], len).is_error()) {
+                return fail(false);
+            }
+            cursor_ += len;
+            if (cursor_ == size) {
+                phase_ = Phase::Verify;
+            }
+            return core::JobStatus::Pending;
+        }
+        case Phase::Verify: {
+            std::array<uint8_t, MODEL_DIGEST_SIZE> digest{};
+            if (crypto_->hash_sha256(image, size, digest.data()).is_error() ||
+                std::memcmp(digest.data(), slot.manifest.sha256.data(), MODEL_DIGEST_SIZE) != 0) {
+                return fail(false);
+            }
+            uint8_t body[MODEL_SIGNED_BODY_SIZE];
+            slot.manifest.signed_body(body);
+            auto verified = crypto_->verify(
+                *publisher_key_, body, sizeof(body), slot.manifest.signature.data());
+            if (verified.is_error() || !verified.value()) {
+                return fail(false);
+            }
+            phase_ = Phase::Load;
+            return core::JobStatus::Pending;
+        }
+        case Phase::Load:
+            if (runners_[staged_]->load_model(image, size).is_error()) {
+                return fail(false);
+            }
+            phase_ = Phase::Calibrate;
+            cursor_ = 0;
+            return core::JobStatus::Pending;
+        case Phase::Calibrate:
+        default:
+            break;
+        }
+
+        if (cursor_ >= calibration_count_) {
+            slot.state = ModelSlotState::Ready;
+            return core::JobStatus::Done;
+        }
+        const ModelCalibration& cal = calibration_[cursor_++];
+        ITfliteRunner& runner = *runners_[staged_];
+        if (runner.set_input(cal.features.data(), ML_FEATURE_COUNT).is_error()) {
+            return fail(true);
+        }
+        auto inference = runner.invoke();
+        if (inference.is_error() || inference.value().output_count == 0) {
+            return fail(true);
+        }
+        const int32_t diff = inference.value().output[0] - cal.expected_score_x1000;
+        if (diff > config_.calibration_tolerance_x1000 ||
+            diff < -config_.calibration_tolerance_x1000) {
+            return fail(true);
+        }
+        return core::JobStatus::Pending;
+    }
+
+    GS_NODISCARD bool anomaly_rate_regressed() const noexcept
+    {
+        const uint64_t new_rate = (static_cast<uint64_t>(stats_.probation_anomalies) * 1000U) /
+                                  (stats_.probation_scored == 0 ? 1U : stats_.probation_scored);
+        const uint64_t base_rate = (static_cast<uint64_t>(baseline_anomalies_) * 1000U) /
+                                   (baseline_scored_ == 0 ? 1U : baseline_scored_);
+        return new_rate > base_rate + config_.max_anomaly_rate_increase_permille;
+    }
+
+    core::Result<void> confirm() noexcept
+    {
+        if (previous_ != MODEL_SLOT_NONE) {
+            runners_[previous_]->unload();
+            slots_[previous_].state = ModelSlotState::Empty;
+        }
+        previous_ = MODEL_SLOT_NONE;
+        probation_failures_ = 0;
+        baseline_scored_ = stats_.probation_scored;
+        baseline_anomalies_ = stats_.probation_anomalies;
+        ++stats_.confirmations;
+
+        ModelSlotRecord record{};
+        record.magic = MODEL_RECORD_MAGIC;
+        record.active_slot = active_;
+        record.manifest = slots_[active_].manifest;
+        GS_TRY(storage_->write(
+            config_.record_address, reinterpret_cast<const uint8_t*>(&record), sizeof(record)));
+        return storage_->flush();
+    }
+
+    std::array<ITfliteRunner*, MODEL_SLOT_COUNT> runners_{};
+    std::array<SlotInfo, MODEL_SLOT_COUNT> slots_{};
+    std::array<std::array<uint8_t, MaxModelSize>, MODEL_SLOT_COUNT> images_{};
+    std::array<ModelCalibration, MODEL_CALIBRATION_MAX> calibration_{};
+    size_t calibration_count_{0};
+
+    platform::IPlatformStorage* storage_{nullptr};
+    security::ICryptoEngine* crypto_{nullptr};
+    const security::ECCKeyPair* publisher_key_{nullptr};
+    MlAnomalyDetector* detector_{nullptr};
+    ModelSlotConfig config_{};
+    WarmupJob job_;
+
+    uint8_t active_{MODEL_SLOT_NONE};
+    uint8_t staged_{MODEL_SLOT_NONE};
+    uint8_t previous_{MODEL_SLOT_NONE}; // fallback while in probation
+    Phase phase_{Phase::Read};
+    uint32_t cursor_{0};
+    int32_t previous_threshold_x1000_{ML_DEFAULT_THRESHOLD_X1000};
+    uint32_t probation_failures_{0};
+    uint32_t baseline_scored_{0};
+    uint32_t baseline_anomalies_{0};
+    ModelSwapStats stats_{};
+    bool initialized_{false};
+};
+
+} // namespace gridshield::analytics
@@ -0,0 +1,333 @@
+/**
+ * @file phase_rules.hpp
+ * @author zuudevs (zuudevs@gmail.com)
+ * @brief Phase-specific tamper rules for three-phase readings
+ * @version 1.0
+ * @date 2026-03-24
+ *
+ * The consumption detector only sees the total, so a bypass on one phase
+ * looks like a modest drop. These rules look at the per-phase record
+ * instead: a phase whose current collapses against its own learned level
+ * while the others hold, a reversed CT, current returning through the
+ * neutral without passing a phase CT, a missing phase and a change of
+ * phase sequence (rewiring). A condition must persist for several
+ * readings before it is reported.
+ *
+ * @copyright Copyright (c) 2026
+ */
+
+#pragma once
+
+#include "analytics/detector.hpp"
+#include "analytics/time_series.hpp"
+#include "core/error.hpp"
+#include "core/types.hpp"
+#include "utils/fixed_point.hpp"
+
+#include <array>
+#include <cstdint>
+
+namespace gridshield::analytics {
+
+static constexpr uint8_t PHASE_ALL = 0xFF; // anomaly not tied to one phase
+
+// ============================================================================
+// PHASE ANOMALY CLASSIFICATION
+// ============================================================================
+enum class PhaseAnomalyType : uint8_t
+{
+    None = 0,
+    NeutralResidual = 1, // In != Ia + Ib + Ic: load current bypassing the phase CTs
+    ReverseFlow = 2,     // one phase exporting while the meter imports (reversed CT)
+    CurrentBypass = 3,   // one phase's current collapsed while the others hold
+    PhaseLoss = 4,       // one phase de-energised while others are live
+    SequenceChange = 5,  // learned ABC/ACB order changed
+    Imbalance = 6        // current unbalance above threshold
+};
+
+static constexpr size_t PHASE_ANOMALY_TYPE_COUNT = 7;
+
+struct PhaseRulesConfig
+{
+    uint16_t residual_threshold_ca{50};         // 0.5 A in the neutral unaccounted for
+    int32_t reverse_threshold_w{50};            // a phase exporting more than this
+    uint16_t bypass_drop_permille{800};         // current fell by >= 80% of its baseline
+    uint16_t bypass_hold_permille{700};         // ... while the others keep >= 70% of theirs
+    uint16_t bypass_min_baseline_ca{100};       // ignore phases normally below 1 A
+    uint16_t loss_voltage_dv{1000};             // < 100 V on a phase counts as lost
+    uint16_t imbalance_threshold_permille{400}; // NEMA current unbalance
+    uint16_t baseline_half_life{16};            // readings
+    uint8_t persistence{2};                     // consecutive readings before reporting
+
+    GS_CONSTEXPR PhaseRulesConfig() noexcept = default;
+};
+
+struct PhaseAnomalyReport
+{
+    core::timestamp_t timestamp{};
+    PhaseAnomalyType type{PhaseAnomalyType::None};
+    AnomalySeverity severity{AnomalySeverity::None};
+    uint8_t phase{PHASE_ALL};
+    uint32_t current_value{};  // type-specific: residual/current in 10 mA, power in W, ...
+    uint32_t expected_value{}; // baseline or threshold it was compared against
+
+    GS_CONSTEXPR PhaseAnomalyReport() noexcept = default;
+};
+
+// ============================================================================
+// PHASE RULES
+// ============================================================================
+class PhaseRules
+{
+public:
+    PhaseRules() noexcept = default;
+
+    core::Result<void> initialize(const PhaseRulesConfig& config) noexcept
+    {
+        if (GS_UNLIKELY(config.persistence == 0 || config.bypass_drop_permille > 1000 ||
+                        config.bypass_hold_permille > 1000)) {
+            return GS_MAKE_ERROR(core::ErrorCode::InvalidParameter);
+        }
+        config_ = config;
+        alpha_ = ema_alpha_for_half_life(config.baseline_half_life);
+        reset();
+        initialized_ = true;
+        return core::Result<void>{};
+    }
+
+    void reset() noexcept
+    {
+        baseline_ca_.fill(0);
+        baseline_valid_ = false;
+        learned_sequence_ = core::PhaseSequence::Unknown;
+        streak_.fill(0);
+    }
+
+    /**
+     * @brief Evaluate one reading; returns the most severe persistent anomaly.
+     *
+     * Per-phase current baselines are only learned from readings without
+     * a bypass candidate, so a sustained bypass is not absorbed.
+     */
+    core::Result<PhaseAnomalyReport> evaluate(const core::ThreePhaseReading& reading) noexcept
+    {
+        if (GS_UNLIKELY(!initialized_)) {
+            return core::Result<PhaseAnomalyReport>{
+                GS_MAKE_ERROR(core::ErrorCode::SystemNotInitialized)};
+        }
+
+        std::array<PhaseAnomalyReport, PHASE_ANOMALY_TYPE_COUNT> found{};
+        check_neutral(reading, found);
+        check_reverse(reading, found);
+        check_bypass(reading, found);
+        check_loss(reading, found);
+        check_sequence(reading, found);
+        check_imbalance(reading, found);
+
+        PhaseAnomalyReport result;
+        result.timestamp = reading.timestamp;
+        for (size_t t = 1; t < PHASE_ANOMALY_TYPE_COUNT; ++t) {
+            if (found[t].type == PhaseAnomalyType::None) {
+                streak_[t] = 0;
+                continue;
+            }
+            streak_[t] = static_cast<uint8_t>(streak_[t] < UINT8_MAX ? streak_[t] + 1 : UINT8_MAX);
+            if (streak_[t] >= config_.persistence && found[t].severity > result.severity) {
+                result = found[t];
+                result.timestamp = reading.timestamp;
+            }
+        }
+
+        if (found[index(PhaseAnomalyType::CurrentBypass)].type == PhaseAnomalyType::None &&
+            found[index(PhaseAnomalyType::NeutralResidual)].type == PhaseAnomalyType::None) {
+            learn_baseline(reading);
+        }
+        return core::Result<PhaseAnomalyReport>{result};
+    }
+
+    GS_NODISCARD core::PhaseSequence learned_sequence() const noexcept
+    {
+        return learned_sequence_;
+    }
+
+    GS_NODISCARD uint32_t baseline_current_ca(size_t phase) const noexcept
+    {
+        return phase < core::PHASE_COUNT ? static_cast<uint32_t>(baseline_ca_[phase]) : 0;
+    }
+
+    GS_NODISCARD bool is_initialized() const noexcept
+    {
+        return initialized_;
+    }
+
+private:
+    using Found = std::array<PhaseAnomalyReport, PHASE_ANOMALY_TYPE_COUNT>;
+
+    static GS_CONSTEXPR size_t index(PhaseAnomalyType type) noexcept
+    {
+        return static_cast<size_t>(type);
+    }
+
+    static void flag(Found& found,
+                     PhaseAnomalyType type,
+                     AnomalySeverity severity,
+                     uint8_t phase,
+                     uint32_t value,
+                     uint32_t expected) noexcept
+    {
+        PhaseAnomalyReport& report = found[index(type)];
+        if (report.type != PhaseAnomalyType::None) {
+            return; // first (lowest-numbered) phase wins
+        }
+        report.type = type;
+        report.severity = severity;
+        report.phase = phase;
+        report.current_value = value;
+        report.expected_value = expected;
+    }
+
+    void check_neutral(const core::ThreePhaseReading& reading, Found& found) const noexcept
+    {
+        if ((reading.flags & core::PHASE_FLAG_NEUTRAL_CT) != 0 &&
+            reading.residual_ca >= config_.residual_threshold_ca) {
+            flag(found,
+                 PhaseAnomalyType::NeutralResidual,
+                 AnomalySeverity::Critical,
+                 PHASE_ALL,
+                 reading.residual_ca,
+                 config_.residual_threshold_ca);
+        }
+    }
+
+    void check_reverse(const core::ThreePhaseReading& reading, Found& found) const noexcept
+    {
+        // Genuine export (PV) shows on the total; a reversed CT on one phase
+        // shows as that phase exporting against an importing total
+        for (size_t p = 0; p < core::PHASE_COUNT; ++p) {
+            const int32_t power = reading.phases[p].power_w;
+            if (power < -config_.reverse_threshold_w && reading.total_power_w > 0) {
+                flag(found,
+                     PhaseAnomalyType::ReverseFlow,
+                     AnomalySeverity::Critical,
+                     static_cast<uint8_t>(p),
+                     static_cast<uint32_t>(-power),
+                     static_cast<uint32_t>(config_.reverse_threshold_w));
+            }
+        }
+    }
+
+    void check_bypass(const core::ThreePhaseReading& reading, Found& found) const noexcept
+    {
+        if (!baseline_valid_) {
+            return;
+        }
+        for (size_t p = 0; p < core::PHASE_COUNT; ++p) {
+            const auto base = static_cast<uint32_t>(baseline_ca_[p]);
+            if (base < config_.bypass_min_baseline_ca || !reading.phase_live(p)) {
+                continue;
+            }
+            const uint32_t current = reading.phases[p].current_ca;
+            const uint32_t floor = base - base * config_.bypass_drop_permille / 1000U;
+            if (current > floor || !others_hold(reading, p)) {
+                continue;
+            }
+            flag(found,
+                 PhaseAnomalyType::CurrentBypass,
+                 AnomalySeverity::High,
+                 static_cast<uint8_t>(p),
+                 current,
+                 base);
+        }
+    }
+
+    // A whole-premises drop (everything switched off) is not a bypass
+    GS_NODISCARD bool others_hold(const core::ThreePhaseReading& reading,
+                                  size_t phase) const noexcept
+    {
+        bool any = false;
+        for (size_t q = 0; q < core::PHASE_COUNT; ++q) {
+            const auto base = static_cast<uint32_t>(baseline_ca_[q]);
+            if (q == phase || base < config_.bypass_min_baseline_ca) {
+                continue;
+            }
+            if (uint32_t{reading.phases[q].current_ca} * 1000U <
+                base * config_.bypass_hold_permille) {
+                return false;
+            }
+            any = true;
+        }
+        return any;
+    }
+
+    void check_loss(const core::ThreePhaseReading& reading, Found& found) const noexcept
+    {
+        size_t live = 0;
+        for (const core::PhaseSample& phase : reading.phases) {
+            live += phase.voltage_dv >= config_.loss_voltage_dv ? 1U : 0U;
+        }
+        if (live == 0 || live == core::PHASE_COUNT) {
+            return; // full outage is a power-loss event, not a phase rule
+        }
+        for (size_t p = 0; p < core::PHASE_COUNT; ++p) {
+            if (reading.phases[p].voltage_dv < config_.loss_voltage_dv) {
+                flag(found,
+                     PhaseAnomalyType::PhaseLoss,
+                     AnomalySeverity::High,
+                     static_cast<uint8_t>(p),
+                     reading.phases[p].voltage_dv,
+                     config_.loss_voltage_dv);
+            }
+        }
+    }
+
+    void check_sequence(const core::ThreePhaseReading& reading, Found& found) noexcept
+    {
+        if (reading.sequence == core::PhaseSequence::Unknown) {
+            return;
+        }
+        if (learned_sequence_ == core::PhaseSequence::Unknown) {
+            learned_sequence_ = reading.sequence;
+            return;
+        }
+        if (reading.sequence != learned_sequence_) {
+            flag(found,
+                 PhaseAnomalyType::SequenceChange,
+                 AnomalySeverity::Medium,
+                 PHASE_ALL,
+                 static_cast<uint32_t>(reading.sequence),
+                 static_cast<uint32_t>(learned_sequence_));
+        }
+    }
+
+    void check_imbalance(const core::ThreePhaseReading& reading, Found& found) const noexcept
+    {
+        if (reading.current_unbalance_permille >= config_.imbalance_threshold_permille) {
+            flag(found,
+                 PhaseAnomalyType::Imbalance,
+                 AnomalySeverity::Low,
+                 PHASE_ALL,
+                 reading.current_unbalance_permille,
+                 config_.imbalance_threshold_permille);
+        }
+    }
+
+    void learn_baseline(const core::ThreePhaseReading& reading) noexcept
+    {
+        for (size_t p = 0; p < core::PHASE_COUNT; ++p) {
+            const int32_t current = reading.phases[p].current_ca;
+            baseline_ca_[p] =
+                baseline_valid_ ? utils::lerp(baseline_ca_[p], current, alpha_) : current;
+        }
+        baseline_valid_ = true;
+    }
+
+    PhaseRulesConfig config_{};
+    EmaAlpha alpha_{EmaAlpha::one()};
+    std::array<int32_t, core::PHASE_COUNT> baseline_ca_{};
+    std::array<uint8_t, PHASE_ANOMALY_TYPE_COUNT> streak_{};
+    core::PhaseSequence learned_sequence_{core::PhaseSequence::Unknown};
+    bool baseline_valid_{false};
+    bool initialized_{false};
+};
+
+} // namespace gridshield::analytics
@@ -0,0 +1,472 @@
+/**
+ * @file quantile.hpp
+ * @brief Constant-memory streaming quantile estimators
+ *
+ * P2Quantile — Jain & Chlamtac P² algorithm: one quantile from five markers
+ * (48 bytes), O(1) update, no stored samples. Used per hour bin by
+ * AnomalyDetector for empirical p99 deviation thresholds.
+ *
+ * TDigest — merging t-digest with a fixed number of centroids. Any quantile
+ * can be queried after the fact, tails are kept sharp, and two digests
+ * merge (e.g. per-phase or per-day sketches into one).
+ *
+ * Integer arithmetic only (marker heights in Q8), like the rest of the
+ * analytics layer.
+ *
+ * @note Header-only, zero heap allocation.
+ */
+
+#pragma once
+
+#include "utils/gs_macros.hpp"
+
+#include <cstddef>
+#include <cstdint>
+
+namespace gridshield::analytics {
+
+// ============================================================================
+// Constants
+// ============================================================================
+static constexpr uint32_t QUANTILE_SCALE = 1000; // quantiles given in permille
+static constexpr uint32_t P2_MARKERS = 5;
+
+// ============================================================================
+// P² single-quantile estimator
+// ============================================================================
+
+/**
+ * @brief Compact P² marker state for warm-boot checkpoints (16 bytes).
+ *
+ * Heights are kept in Q4 and saturate to [0, 4095], so it suits the
+ * non-negative deviation streams the detector feeds. Inner marker
+ * positions are stored relative to their desired positions and the count
+ * saturates at UINT16_MAX, which keeps the marker spacing intact.
+ */
+struct P2Snapshot
+{
+    uint16_t height_q4[P2_MARKERS]{};
+    int8_t position_offset[3]{}; // inner markers vs. desired position
+    uint8_t reserved{};
+    uint16_t count{};
+
+    constexpr P2Snapshot() noexcept = default;
+};
+
+class P2Quantile
+{
+public:
+    constexpr P2Quantile() noexcept = default;
+    explicit constexpr P2Quantile(uint16_t p_x1000) noexcept : p_x1000_(p_x1000) {}
+
+    /// Reset and track quantile @p p_x1000 (e.g. 990 for p99).
+    void init(uint16_t p_x1000) noexcept
+    {
+        *this = P2Quantile(p_x1000 > QUANTILE_SCALE ? QUANTILE_SCALE : p_x1000);
+    }
+
+    void add(int32_t value) noexcept
+    {
+        const int32_t x = to_q(value);
+
+        // Warm-up: keep the first five observations sorted
+        if (count_ < P2_MARKERS) {
+            size_t pos = count_;
+            while (pos > 0 && q_[pos - 1] > x) {
+                q_[pos] = q_[pos - 1];
+                --pos;
+            }
+            q_[pos] = x;
+            ++count_;
+            if (count_ == P2_MARKERS) {
+                for (uint32_t i = 0; i < P2_MARKERS; ++i) {
+                    n_[i] = static_cast<int32_t>(i + 1);
+                }
+            }
+            return;
+        }
+
+        // Cell containing x; extremes move to the observation
+        size_t cell;
+        if (x < q_[0]) {
+            q_[0] = x;
+            cell = 0;
+        } else if (x >= q_[4]) {
+            q_[4] = x;
+            cell = 3;
+        } else {
+            cell = 0;
+            while (cell < 3 && x >= q_[cell + 1]) {
+                ++cell;
+            }
+        }
+        for (size_t i = cell + 1; i < P2_MARKERS; ++i) {
+            ++n_[i];
+        }
+        ++count_;
+
+        // Nudge the three inner markers toward their desired positions
+        for (size_t i = 1; i <= 3; ++i) {
+            const int64_t d = desired_x2000(i) - static_cast<int64_t>(n_[i]) * 2000;
+            const int32_t up = n_[i + 1] - n_[i];
+            const int32_t down = n_[i - 1] - n_[i];
+            if ((d >= 2000 && up > 1) || (d <= -2000 && down < -1)) {
+                const int32_t s = (d > 0) ? 1 : -1;
+                int64_t candidate = parabolic(i, s);
+                if (candidate <= q_[i - 1] || candidate >= q_[i + 1]) {
+                    candidate = linear(i, s);
+                }
+                q_[i] = static_cast<int32_t>(candidate);
+                n_[i] += s;
+            }
+        }
+    }
+
+    /// Current estimate (exact while fewer than five samples were seen).
+    GS_NODISCARD int32_t value() const noexcept
+    {
+        if (count_ == 0) {
+            return 0;
+        }
+        if (count_ < P2_MARKERS) {
+            const uint32_t idx = (p_x1000_ * (count_ - 1) + QUANTILE_SCALE / 2) / QUANTILE_SCALE;
+            return static_cast<int32_t>(q_[idx] >> Q_SHIFT);
+        }
+        return static_cast<int32_t>(q_[2] >> Q_SHIFT);
+    }
+
+    GS_NODISCARD uint32_t count() const noexcept
+    {
+        return count_;
+    }
+
+    GS_NODISCARD uint16_t quantile_x1000() const noexcept
+    {
+        return p_x1000_;
+    }
+
+    /// Pack the marker state into @p out (see P2Snapshot for the precision).
+    void save(P2Snapshot& out) const noexcept
+    {
+        out = P2Snapshot();
+        const uint32_t count = count_ < UINT16_MAX ? count_ : UINT16_MAX;
+        out.count = static_cast<uint16_t>(count);
+        for (size_t i = 0; i < P2_MARKERS; ++i) {
+            const int32_t h = q_[i] >> (Q_SHIFT - SNAPSHOT_SHIFT);
+            out.height_q4[i] = static_cast<uint16_t>(h < 0 ? 0 : (h > UINT16_MAX ? UINT16_MAX : h));
+        }
+        if (count < P2_MARKERS) {
+            return;
+        }
+        // A saturated count scales the positions down with it
+        for (size_t i = 1; i <= 3; ++i) {
+            const int64_t position = static_cast<int64_t>(n_[i]) * count / count_;
+            int64_t offset = position - desired_position(i, count);
+            offset = offset < INT8_MIN ? INT8_MIN : (offset > INT8_MAX ? INT8_MAX : offset);
+            out.position_offset[i - 1] = static_cast<int8_t>(offset);
+        }
+    }
+
+    /**
+     * @brief Resume tracking quantile @p p_x1000 from @p in.
+     * @return false (and a reset estimator) when the markers are inconsistent.
+     */
+    bool load(const P2Snapshot& in, uint16_t p_x1000) noexcept
+    {
+        init(p_x1000);
+        P2Quantile restored = *this;
+        restored.count_ = in.count;
+        for (size_t i = 0; i < P2_MARKERS; ++i) {
+            restored.q_[i] = static_cast<int32_t>(in.height_q4[i]) << (Q_SHIFT - SNAPSHOT_SHIFT);
+        }
+        for (size_t i = 1; i < P2_MARKERS && i < in.count; ++i) {
+            if (restored.q_[i] < restored.q_[i - 1]) {
+                return false;
+            }
+        }
+        if (in.count >= P2_MARKERS) {
+            restored.n_[0] = 1;
+            restored.n_[4] = static_cast<int32_t>(in.count);
+            for (size_t i = 1; i <= 3; ++i) {
+                restored.n_[i] = static_cast<int32_t>(desired_position(i, in.count) +
+                                                      in.position_offset[i - 1]);
+            }
+            for (size_t i = 1; i < P2_MARKERS; ++i) {
+                if (restored.n_[i] <= restored.n_[i - 1]) {
+                    return false;
+                }
+            }
+        }
+        *this = restored;
+        return true;
+    }
+
+private:
+    static constexpr uint32_t Q_SHIFT = 8;
+    static constexpr uint32_t SNAPSHOT_SHIFT = 4;
+    static constexpr int32_t Q_LIMIT = INT32_MAX >> Q_SHIFT;
+
+    /// Saturate to the Q8 range (|value| < 2^23).
+    static int32_t to_q(int32_t value) noexcept
+    {
+        if (value > Q_LIMIT) {
+            value = Q_LIMIT;
+        } else if (value < -Q_LIMIT) {
+            value = -Q_LIMIT;
+        }
+        return static_cast<int32_t>(static_cast<uint32_t>(value) << Q_SHIFT);
+    }
+
+    /// Desired position of marker @p i, scaled by 2000 so p/2 stays exact.
+    GS_NODISCARD int64_t desired_x2000(size_t i) const noexcept
+    {
+        return desired_x2000(i, count_);
+    }
+
+    GS_NODISCARD int64_t desired_x2000(size_t i, uint32_t count) const noexcept
+    {
+        const int64_t p = p_x1000_;
+        const int64_t f_x2000[P2_MARKERS] = {0, p, 2 * p, 1000 + p, 2000};
+        return 2000 + static_cast<int64_t>(count - 1) * f_x2000[i];
+    }
+
+    /// Desired position of marker @p i after @p count samples, rounded.
+    GS_NODISCARD int64_t desired_position(size_t i, uint32_t count) const noexcept
+    {
+        return (desired_x2000(i, count) + 1000) / 2000;
+    }
+
+    GS_NODISCARD int64_t parabolic(size_t i, int32_t s) const noexcept
+    {
+        const int64_t n_prev = n_[i - 1];
+        const int64_t n_cur = n_[i];
+        const int64_t n_next = n_[i + 1];
+        const int64_t right =
+            (n_cur - n_prev + s) * (static_cast<int64_t>(q_[i + 1]) - q_[i]) / (n_next - n_cur);
+        const int64_t left =
+            (n_next - n_cur - s) * (static_cast<int64_t>(q_[i]) - q_[i - 1]) / (n_cur - n_prev);
+        return q_[i] + s * (right + left) / (n_next - n_prev);
+    }
+
+    GS_NODISCARD int64_t linear(size_t i, int32_t s) const noexcept
+    {
+        const size_t j = (s > 0) ? i + 1 : i - 1;
+        return q_[i] + s * (static_cast<int64_t>(q_[j]) - q_[i]) / (n_[j] - n_[i]);
+    }
+
+    int32_t q_[P2_MARKERS]{};  // marker heights, Q8
+    int32_t n_[P2_MARKERS]{};  // marker positions (1-based)
+    uint32_t count_{0};
+    uint16_t p_x1000_{500};
+};
+
+// ============================================================================
+// Merging t-digest
+// ============================================================================
+
+/**
+ * @tparam Centroids Maximum retained centroids (memory ~12 B each)
+ * @tparam Buffer    Raw samples buffered between compressions
+ */
+template <size_t Centroids = 32, size_t Buffer = 32> class TDigest
+{
+    static_assert(Centroids >= 8, "too few centroids for useful tails");
+    static_assert(Buffer > 0, "buffer must hold at least one sample");
+
+public:
+    void add(int32_t value) noexcept
+    {
+        if (total_ == 0 && buffered_ == 0) {
+            min_ = value;
+            max_ = value;
+        }
+        min_ = (value < min_) ? value : min_;
+        max_ = (value > max_) ? value : max_;
+        buffer_[buffered_++] = value;
+        if (buffered_ == Buffer) {
+            compress();
+        }
+    }
+
+    /// Fold @p other into this digest (both stay bounded).
+    void merge(const TDigest& other) noexcept
+    {
+        compress();
+        TDigest rhs = other;
+        rhs.compress();
+        if (rhs.total_ == 0) {
+            return;
+        }
+        if (total_ == 0) {
+            *this = rhs;
+            return;
+        }
+        min_ = (rhs.min_ < min_) ? rhs.min_ : min_;
+        max_ = (rhs.max_ > max_) ? rhs.max_ : max_;
+
+        Centroid merged[2 * Centroids];
+        size_t a = 0;
+        size_t b = 0;
+        size_t out = 0;
+        while (a < count_ || b < rhs.count_) {
+            const bool take_a =
+                b == rhs.count_ || (a < count_ && centroids_[a].mean() <= rhs.centroids_[b].mean());
+            merged[out++] = take_a ? centroids_[a++] : rhs.centroids_[b++];
+        }
+        rebuild(merged, out, total_ + rhs.total_);
+    }
+
+    /// Fold buffered samples into the centroids.
+    void compress() noexcept
+    {
+        if (buffered_ == 0) {
+            return;
+        }
+        // Insertion sort: the buffer is small and often nearly ordered
+        for (size_t i = 1; i < buffered_; ++i) {
+            const int32_t v = buffer_[i];
+            size_t j = i;
+            while (j > 0 && buffer_[j - 1] > v) {
+                buffer_[j] = buffer_[j - 1];
+                --j;
+            }
+            buffer_[j] = v;
+        }
+
+        Centroid merged[Centroids + Buffer];
+        size_t a = 0;
+        size_t b = 0;
+        size_t out = 0;
+        while (a < count_ || b < buffered_) {
+            const bool take_c =
+                b == buffered_ || (a < count_ && centroids_[a].mean() <= buffer_[b]);
+            if (take_c) {
+                merged[out++] = centroids_[a++];
+            } else {
+                merged[out++] = Centroid{buffer_[b++], 1};
+            }
+        }
+        const uint64_t total = total_ + buffered_;
+        buffered_ = 0;
+        rebuild(merged, out, total);
+    }
+
+    /// Estimate quantile @p p_x1000 (permille). Buffered samples are included.
+    GS_NODISCARD int32_t quantile(uint32_t p_x1000) const noexcept
+    {
+        if (buffered_ > 0) {
+            TDigest flushed = *this;
+            flushed.compress();
+            return flushed.quantile(p_x1000);
+        }
+        if (total_ == 0) {
+            return 0;
+        }
+        if (p_x1000 >= QUANTILE_SCALE) {
+            return max_;
+        }
+        // Target rank and centroid centres in half-weight units
+        const auto target_x2 = static_cast<int64_t>((2 * total_ * p_x1000) / QUANTILE_SCALE);
+        int64_t cum_x2 = 0;
+        int64_t prev_center_x2 = 0;
+        int64_t prev_mean = min_;
+        for (size_t i = 0; i < count_; ++i) {
+            const int64_t w_x2 = 2 * static_cast<int64_t>(centroids_[i].weight);
+            const int64_t center_x2 = cum_x2 + w_x2 / 2;
+            const int64_t mean = centroids_[i].mean();
+            if (target_x2 < center_x2) {
+                return interpolate(prev_mean, mean, prev_center_x2, center_x2, target_x2);
+            }
+            prev_center_x2 = center_x2;
+            prev_mean = mean;
+            cum_x2 += w_x2;
+        }
+        return interpolate(prev_mean, max_, prev_center_x2, cum_x2, target_x2);
+    }
+
+    GS_NODISCARD uint64_t count() const noexcept
+    {
+        return total_ + buffered_;
+    }
+    GS_NODISCARD size_t centroid_count() const noexcept
+    {
+        return count_;
+    }
+    GS_NODISCARD int32_t min() const noexcept
+    {
+        return min_;
+    }
+    GS_NODISCARD int32_t max() const noexcept
+    {
+        return max_;
+    }
+
+private:
+    struct Centroid
+    {
+        int64_t sum{0};
+        uint32_t weight{0};
+
+        Centroid() noexcept = default;
+        Centroid(int64_t s, uint32_t w) noexcept : sum(s), weight(w) {}
+
+        GS_NODISCARD int64_t mean() const noexcept
+        {
+            return weight == 0 ? 0 : sum / static_cast<int64_t>(weight);
+        }
+    };
+
+    static int32_t interpolate(int64_t lo, int64_t hi, int64_t lo_rank, int64_t hi_rank,
+                               int64_t rank) noexcept
+    {
+        const int64_t span = hi_rank - lo_rank;
+        return static_cast<int32_t>(lo + (span == 0 ? 0 : (hi - lo) * (rank - lo_rank) / span));
+    }
+
+    /// Greedy merge of sorted @p in under the k2 size bound
+    /// w <= 4 * N * q(1-q) * scale / delta, with delta = Centroids / 2.
+    /// The bound alone does not cap the centroid count (the tails grow with
+    /// log N), so an overflowing pass is redone with twice the scale.
+    void rebuild(const Centroid* in, size_t n, uint64_t total) noexcept
+    {
+        static constexpr uint64_t DELTA = Centroids / 2;
+        for (uint64_t scale = 1;; scale *= 2) {
+            count_ = 0;
+            uint64_t cum = 0; // weight before the centroid being built
+            bool overflow = false;
+            for (size_t i = 0; i < n && !overflow; ++i) {
+                if (count_ == 0) {
+                    centroids_[count_++] = in[i];
+                    continue;
+                }
+                Centroid& cur = centroids_[count_ - 1];
+                const uint64_t proposed = static_cast<uint64_t>(cur.weight) + in[i].weight;
+                const uint64_t mid = cum + proposed / 2;
+                const uint64_t limit = (4 * mid * (total - mid) * scale) / (total * DELTA);
+                if (proposed <= (limit < 1 ? 1 : limit)) {
+                    cur.sum += in[i].sum;
+                    cur.weight = static_cast<uint32_t>(proposed);
+                } else if (count_ == Centroids) {
+                    overflow = true;
+                } else {
+                    cum += cur.weight;
+                    centroids_[count_++] = in[i];
+                }
+            }
+            if (!overflow) {
+                break;
+            }
+        }
+        total_ = total;
+    }
+
+    Centroid centroids_[Centroids]{};
+    int32_t buffer_[Buffer]{};
+    size_t count_{0};
+    size_t buffered_{0};
+    uint64_t total_{0}; // weight held in centroids
+    int32_t min_{0};
+    int32_t max_{0};
+};
+
+} // namespace gridshield::analytics
@@ -8,9 +8,11 @@
 #pragma once
 
 #include "core/error.hpp"
+#include "utils/fixed_point.hpp"
 #include "utils/gs_macros.hpp"
 
 #include <array>
+#include <cstddef>
 #include <cstdint>
 
 namespace gridshield::analytics {
@@ -21,7 +23,20 @@ namespace gridshield::analytics {
 static constexpr size_t TS_DEFAULT_CAPACITY = 128;
 static constexpr size_t TS_MIN_FORECAST_SAMPLES = 3;
 static constexpr uint16_t TS_DEFAULT_ALPHA_X1000 = 200;
-static constexpr uint32_t TS_FIXPOINT_SCALE = 1000;
+static constexpr uint32_t TS_FIXPOINT_SCALE = 1000; // alpha_x1000 denominator
+
+/// EMA weight in [0, 1]
+using EmaAlpha = utils::Q30;
+
+/// EMA weight whose impulse response halves every @p samples pushes:
+/// alpha = 1 - 2^(-1 / samples). 0 gives alpha = 1 (no smoothing).
+GS_NODISCARD GS_CONSTEXPR EmaAlpha ema_alpha_for_half_life(uint16_t samples) noexcept
+{
+    if (samples == 0) {
+        return EmaAlpha::one();
+    }
+    return EmaAlpha::one() - utils::exp2(EmaAlpha::from_ratio(-1, samples));
+}
 
 // ============================================================================
 // Types
@@ -49,6 +64,7 @@ struct TimeSeriesStats
     int32_t mean_value{0};
     int32_t moving_avg{0};
     int32_t exp_smooth{0};
+    int32_t std_dev{0}; // population standard deviation
     size_t sample_count{0};
 };
 
@@ -63,9 +79,18 @@ template <size_t N = TS_DEFAULT_CAPACITY> class TimeSeriesBuffer
 public:
     core::Result<void> init(uint16_t alpha_x1000 = TS_DEFAULT_ALPHA_X1000) noexcept
     {
+        const uint32_t clamped = alpha_x1000 > TS_FIXPOINT_SCALE ? TS_FIXPOINT_SCALE : alpha_x1000;
+        return init(EmaAlpha::from_ratio(clamped, TS_FIXPOINT_SCALE));
+    }
+
+    core::Result<void> init(EmaAlpha alpha) noexcept
+    {
+        if (alpha < EmaAlpha::zero() || alpha > EmaAlpha::one()) {
+            return GS_MAKE_ERROR(core::ErrorCode::InvalidParameter);
+        }
         head_ = 0;
         count_ = 0;
-        alpha_x1000_ = alpha_x1000;
+        alpha_ = alpha;
         exp_smooth_ = 0;
         initialized_ = true;
         return core::Result<void>{};
@@ -92,10 +117,7 @@ public:
         if (count_ == 1) {
             exp_smooth_ = value;
         } else {
-            int64_t alpha = alpha_x1000_;
-            int64_t one_minus_alpha = static_cast<int64_t>(TS_FIXPOINT_SCALE) - alpha;
-            exp_smooth_ = static_cast<int32_t>((alpha * value + one_minus_alpha * exp_smooth_) /
-                                               static_cast<int64_t>(TS_FIXPOINT_SCALE));
+            exp_smooth_ = utils::lerp(exp_smooth_, value, alpha_);
         }
 
         return core::Result<void>{};
@@ -213,6 +235,18 @@ public:
 
         st.mean_value = static_cast<int32_t>(sum / static_cast<int64_t>(count_));
 
+        uint64_t sum_sq = 0;
+        for (size_t step = 0; step < count_; ++step) {
+            size_t idx = (head_ + N - count_ + step) % N;
+            const int64_t dev = static_cast<int64_t>(buffer_[idx].value) - st.mean_value;
+            // |dev| < 2^32, so its square fits uint64 (but not int64)
+            const uint64_t mag = dev < 0 ? static_cast<uint64_t>(-dev) : static_cast<uint64_t>(dev);
+            const uint64_t sq = mag * mag;
+            sum_sq = (sum_sq > UINT64_MAX - sq) ? UINT64_MAX : sum_sq + sq;
+        }
+        const uint32_t sd = utils::isqrt_u64(sum_sq / count_);
+        st.std_dev = static_cast<int32_t>(sd <= INT32_MAX ? sd : uint32_t{INT32_MAX});
+
         static constexpr size_t DEFAULT_MA_WINDOW = 10;
         auto ma_result = moving_average(DEFAULT_MA_WINDOW);
         if (ma_result.is_ok()) {
@@ -234,6 +268,10 @@ public:
     {
         return initialized_;
     }
+    EmaAlpha alpha() const noexcept
+    {
+        return alpha_;
+    }
 
     core::Result<DataPoint> latest() const noexcept
     {
@@ -247,7 +285,7 @@ private:
     std::array<DataPoint, N> buffer_{};
     size_t head_{0};
     size_t count_{0};
-    uint16_t alpha_x1000_{TS_DEFAULT_ALPHA_X1000};
+    EmaAlpha alpha_{EmaAlpha::from_ratio(TS_DEFAULT_ALPHA_X1000, TS_FIXPOINT_SCALE)};
     int32_t exp_smooth_{0};
     bool initialized_{false};
 };
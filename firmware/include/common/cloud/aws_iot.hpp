@@ -2,12 +2,20 @@
  * @file aws_iot.hpp
  * @brief AWS IoT Core connector
  *
+ * Reported state goes through ShadowSync: each publish_telemetry() feeds
+ * the reading in and only a due merge patch is sent, versioned against the
+ * known document. The simulated service applies patches to shadow() and
+ * rejects one sent against an outdated version, after which the connector
+ * fetches the document and retries, as it would on
+ * `$aws/things/<thing>/shadow/update/rejected` (code 409).
+ *
  * @note Header-only, zero heap allocation, uses named constants.
  */
 
 #pragma once
 
 #include "cloud/cloud_connector.hpp"
+#include "cloud/shadow_sync.hpp"
 #include "core/error.hpp"
 #include "utils/gs_macros.hpp"
 
@@ -31,23 +39,11 @@ static constexpr size_t AWS_SHADOW_MAX_SIZE = 256;
 
 struct DeviceShadowState
 {
-    struct Reported
-    {
-        uint32_t voltage_mv{0};
-        uint32_t current_ma{0};
-        uint32_t energy_wh{0};
-        int16_t temperature_c10{0};
-        bool tamper_detected{false};
-        bool online{false};
-    } reported{};
-
-    struct Desired
-    {
-        uint32_t reading_interval_ms{0};
-        bool ota_requested{false};
-        bool reset_requested{false};
-    } desired{};
+    using Reported = ReportedState;
+    using Desired = DesiredState;
 
+    Reported reported{};
+    Desired desired{};
     uint32_t version{0};
 };
 
@@ -102,13 +98,55 @@ public:
         if (state_ != CloudState::Connected && state_ != CloudState::Ready) {
             return GS_MAKE_ERROR(core::ErrorCode::CloudPublishFailed);
         }
-        shadow_.reported.voltage_mv = payload.voltage_mv;
-        shadow_.reported.current_ma = payload.current_ma;
-        shadow_.reported.energy_wh = payload.energy_wh;
-        shadow_.reported.temperature_c10 = payload.temperature_c10;
-        shadow_.reported.tamper_detected = payload.tamper_detected;
+        ReportedState local{};
+        local.voltage_mv = payload.voltage_mv;
+        local.current_ma = payload.current_ma;
+        local.energy_wh = payload.energy_wh;
+        local.temperature_c10 = payload.temperature_c10;
+        local.tamper_detected = payload.tamper_detected;
+        sync_.update(local, payload.timestamp);
         publish_count_++;
-        return core::Result<void>{};
+        return flush_shadow(payload.timestamp);
+    }
+
+    /// Send the pending patch once due; call between readings so a
+    /// coalescing window still closes when readings stop changing.
+    core::Result<void> flush_shadow(uint64_t now_ms) noexcept
+    {
+        if (state_ != CloudState::Connected && state_ != CloudState::Ready) {
+            return GS_MAKE_ERROR(core::ErrorCode::CloudPublishFailed);
+        }
+        sync_.poll(now_ms);
+        // One retry after a version conflict, on the fetched document
+        for (int attempt = 0; attempt < 2; ++attempt) {
+            if (sync_.resync_needed()) {
+                sync_.on_document(shadow_.version, shadow_.reported, shadow_.desired);
+            }
+            if (!sync_.due(now_ms)) {
+                return core::Result<void>{};
+            }
+            auto length = sync_.build_patch(
+                last_update_.data(), last_update_.size(), ShadowFormat::AwsShadow, now_ms);
+            if (length.is_error()) {
+                return length.error();
+            }
+            if (deliver_update()) {
+                return core::Result<void>{};
+            }
+        }
+        return GS_MAKE_ERROR(core::ErrorCode::CloudVersionConflict);
+    }
+
+    /// Desired-state delta from `shadow/update/delta`.
+    DeltaOutcome apply_desired_delta(const DesiredState& desired, uint32_t version) noexcept
+    {
+        return sync_.apply_delta(desired, version);
+    }
+
+    /// Resets the diff: the next publish is a full report.
+    void configure_shadow_sync(const ShadowSyncConfig& config) noexcept
+    {
+        sync_.configure(config);
     }
 
     core::Result<void> subscribe_commands() noexcept override
@@ -148,10 +186,20 @@ public:
         return CloudProvider::AwsIotCore;
     }
 
+    /// Service-side document.
     const DeviceShadowState& shadow() const noexcept
     {
         return shadow_;
     }
+    const ShadowSync& shadow_sync() const noexcept
+    {
+        return sync_;
+    }
+    /// Last update document sent, NUL-terminated.
+    const char* last_shadow_update() const noexcept
+    {
+        return last_update_.data();
+    }
     uint32_t publish_count() const noexcept
     {
         return publish_count_;
@@ -173,9 +221,24 @@ public:
     }
 
 private:
+    /// Simulated service: optimistic locking on the document version.
+    bool deliver_update() noexcept
+    {
+        if (sync_.sent_version() != 0 && sync_.sent_version() != shadow_.version) {
+            sync_.on_rejected(true);
+            return false;
+        }
+        merge_fields(shadow_.reported, sync_.in_flight_state(), sync_.in_flight_fields());
+        shadow_.version++;
+        sync_.on_accepted(shadow_.version);
+        return true;
+    }
+
     CloudConfig config_{};
     CloudState state_{CloudState::Disconnected};
     DeviceShadowState shadow_{};
+    ShadowSync sync_{};
+    std::array<char, AWS_SHADOW_MAX_SIZE> last_update_{};
     CloudCommand pending_command_{};
     bool initialized_{false};
     bool simulate_connect_failure_{false};
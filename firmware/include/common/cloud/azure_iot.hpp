@@ -2,12 +2,19 @@
  * @file azure_iot.hpp
  * @brief Azure IoT Hub connector
  *
+ * Reported properties go through ShadowSync: each publish_telemetry() feeds
+ * the reading in and only a due merge patch is sent to
+ * `$iothub/twin/PATCH/properties/reported/`. Twin reported patches are not
+ * versioned, so the sync runs unversioned and tracks the desired $version
+ * only, to drop stale desired-property updates.
+ *
  * @note Header-only, zero heap allocation, uses named constants.
  */
 
 #pragma once
 
 #include "cloud/cloud_connector.hpp"
+#include "cloud/shadow_sync.hpp"
 #include "core/error.hpp"
 #include "utils/gs_macros.hpp"
 
@@ -23,6 +30,7 @@ namespace gridshield::cloud {
 static constexpr uint16_t AZURE_IOT_DEFAULT_PORT = 8883;
 static constexpr size_t AZURE_MAX_SAS_TOKEN_LENGTH = 256;
 static constexpr uint32_t AZURE_SAS_DEFAULT_TTL_S = 3600;
+static constexpr size_t AZURE_TWIN_PATCH_MAX_SIZE = 256;
 
 // ============================================================================
 // Types
@@ -37,24 +45,12 @@ struct SasToken
 
 struct DeviceTwinState
 {
-    struct Reported
-    {
-        uint32_t voltage_mv{0};
-        uint32_t current_ma{0};
-        uint32_t energy_wh{0};
-        int16_t temperature_c10{0};
-        bool tamper_detected{false};
-        bool online{false};
-    } reported{};
-
-    struct Desired
-    {
-        uint32_t reading_interval_ms{0};
-        bool ota_requested{false};
-        bool reset_requested{false};
-    } desired{};
+    using Reported = ReportedState;
+    using Desired = DesiredState;
 
-    uint32_t version{0};
+    Reported reported{};
+    Desired desired{};
+    uint32_t version{0}; // desired $version
 };
 
 // ============================================================================
@@ -108,15 +104,51 @@ public:
         if (state_ != CloudState::Connected && state_ != CloudState::Ready) {
             return GS_MAKE_ERROR(core::ErrorCode::CloudPublishFailed);
         }
-        twin_.reported.voltage_mv = payload.voltage_mv;
-        twin_.reported.current_ma = payload.current_ma;
-        twin_.reported.energy_wh = payload.energy_wh;
-        twin_.reported.temperature_c10 = payload.temperature_c10;
-        twin_.reported.tamper_detected = payload.tamper_detected;
+        ReportedState local{};
+        local.voltage_mv = payload.voltage_mv;
+        local.current_ma = payload.current_ma;
+        local.energy_wh = payload.energy_wh;
+        local.temperature_c10 = payload.temperature_c10;
+        local.tamper_detected = payload.tamper_detected;
+        sync_.update(local, payload.timestamp);
         publish_count_++;
+        return flush_twin(payload.timestamp);
+    }
+
+    /// Send the pending patch once due; call between readings so a
+    /// coalescing window still closes when readings stop changing.
+    core::Result<void> flush_twin(uint64_t now_ms) noexcept
+    {
+        if (state_ != CloudState::Connected && state_ != CloudState::Ready) {
+            return GS_MAKE_ERROR(core::ErrorCode::CloudPublishFailed);
+        }
+        sync_.poll(now_ms);
+        if (!sync_.due(now_ms)) {
+            return core::Result<void>{};
+        }
+        auto length = sync_.build_patch(
+            last_patch_.data(), last_patch_.size(), ShadowFormat::AzureTwin, now_ms);
+        if (length.is_error()) {
+            return length.error();
+        }
+        // Simulated hub: reported patches are merged as they come
+        merge_fields(twin_.reported, sync_.in_flight_state(), sync_.in_flight_fields());
+        sync_.on_accepted(0);
         return core::Result<void>{};
     }
 
+    /// Desired-property update from `$iothub/twin/PATCH/properties/desired/`.
+    DeltaOutcome apply_desired_delta(const DesiredState& desired, uint32_t version) noexcept
+    {
+        return sync_.apply_delta(desired, version);
+    }
+
+    /// Resets the diff: the next publish is a full report. Always unversioned.
+    void configure_twin_sync(const ShadowSyncConfig& config) noexcept
+    {
+        sync_.configure(twin_config(config));
+    }
+
     core::Result<void> subscribe_commands() noexcept override
     {
         if (state_ != CloudState::Connected && state_ != CloudState::Ready) {
@@ -154,10 +186,20 @@ public:
         return CloudProvider::AzureIotHub;
     }
 
+    /// Hub-side twin.
     const DeviceTwinState& twin() const noexcept
     {
         return twin_;
     }
+    const ShadowSync& twin_sync() const noexcept
+    {
+        return sync_;
+    }
+    /// Last reported patch sent, NUL-terminated.
+    const char* last_twin_patch() const noexcept
+    {
+        return last_patch_.data();
+    }
     uint32_t publish_count() const noexcept
     {
         return publish_count_;
@@ -188,9 +230,17 @@ public:
     }
 
 private:
+    static ShadowSyncConfig twin_config(ShadowSyncConfig config) noexcept
+    {
+        config.versioned = false;
+        return config;
+    }
+
     CloudConfig config_{};
     CloudState state_{CloudState::Disconnected};
     DeviceTwinState twin_{};
+    ShadowSync sync_{twin_config(ShadowSyncConfig{})};
+    std::array<char, AZURE_TWIN_PATCH_MAX_SIZE> last_patch_{};
     SasToken sas_token_{};
     CloudCommand pending_command_{};
     bool initialized_{false};
@@ -0,0 +1,485 @@
+/**
+ * @file shadow_sync.hpp
+ * @author zuudevs (zuudevs@gmail.com)
+ * @brief Delta-only reported state for AWS device shadows and Azure twins
+ * @version 1.0
+ * @date 2026-04-01
+ *
+ * Shadow and twin updates are billed and rate-limited per message and per
+ * KB, so instead of the whole reported document on every reading this
+ * keeps the last state the service acknowledged and sends a JSON merge
+ * patch (RFC 7396) of the fields that changed since:
+ *
+ *   - a numeric field counts as changed once it leaves its deadband
+ *     (network::Deadband, 0/0 = any change) around the acknowledged value;
+ *   - the first change opens a coalescing window, and the patch goes out
+ *     when it closes with the latest values, so a burst of readings costs
+ *     one message; urgent fields (tamper) and the first report after boot
+ *     go out at once;
+ *   - one patch is in flight at a time; a lost acknowledgement counts as a
+ *     rejection after ack_timeout_ms and the fields are sent again.
+ *
+ * Versions: desired deltas older than the known document version are
+ * ignored as stale. With `versioned` (AWS) each patch carries the known
+ * version for optimistic locking; a version-conflict rejection means the
+ * document moved on (usually a desired change whose delta has not arrived
+ * yet), so the caller fetches it and hands it to on_document(), which
+ * rebases the diff on what the service actually holds.
+ *
+ * `online` is kept by the broker (AWS lifecycle events, Azure connection
+ * state), not reported by the device, so it is never part of a patch.
+ *
+ * Flow: update() each reading → if due(), build_patch() and publish →
+ * on_accepted() / on_rejected(); poll() for window expiry and ack timeout.
+ *
+ * @note Header-only, zero heap allocation.
+ *
+ * @copyright Copyright (c) 2026
+ */
+
+#pragma once
+
+#include "core/error.hpp"
+#include "network/report_policy.hpp"
+#include "utils/gs_macros.hpp"
+
+#include <cstdint>
+#include <cstdio>
+
+namespace gridshield::cloud {
+
+// ============================================================================
+// CONSTANTS
+// ============================================================================
+static constexpr uint32_t SHADOW_DEFAULT_COALESCE_MS = 60000;
+static constexpr uint32_t SHADOW_DEFAULT_ACK_TIMEOUT_MS = 10000;
+
+// ============================================================================
+// STATE
+// ============================================================================
+struct ReportedState
+{
+    uint32_t voltage_mv{0};
+    uint32_t current_ma{0};
+    uint32_t energy_wh{0};
+    int16_t temperature_c10{0};
+    bool tamper_detected{false};
+    bool online{false}; // broker-maintained, never patched
+};
+
+struct DesiredState
+{
+    uint32_t reading_interval_ms{0};
+    bool ota_requested{false};
+    bool reset_requested{false};
+};
+
+/// Device-reported fields, in patch order.
+enum class ShadowField : uint8_t
+{
+    VoltageMv = 0,
+    CurrentMa = 1,
+    EnergyWh = 2,
+    TemperatureC10 = 3,
+    TamperDetected = 4
+};
+
+static constexpr size_t SHADOW_FIELD_COUNT = 5;
+
+GS_NODISCARD GS_CONSTEXPR inline uint8_t shadow_field_bit(ShadowField field) noexcept
+{
+    return static_cast<uint8_t>(1U << static_cast<uint8_t>(field));
+}
+
+static constexpr uint8_t SHADOW_ALL_FIELDS = (1U << SHADOW_FIELD_COUNT) - 1U;
+
+/// Copy the @p fields of @p patch into @p target, as the service merges a patch.
+inline void merge_fields(ReportedState& target, const ReportedState& patch, uint8_t fields) noexcept
+{
+    if ((fields & shadow_field_bit(ShadowField::VoltageMv)) != 0) {
+        target.voltage_mv = patch.voltage_mv;
+    }
+    if ((fields & shadow_field_bit(ShadowField::CurrentMa)) != 0) {
+        target.current_ma = patch.current_ma;
+    }
+    if ((fields & shadow_field_bit(ShadowField::EnergyWh)) != 0) {
+        target.energy_wh = patch.energy_wh;
+    }
+    if ((fields & shadow_field_bit(ShadowField::TemperatureC10)) != 0) {
+        target.temperature_c10 = patch.temperature_c10;
+    }
+    if ((fields & shadow_field_bit(ShadowField::TamperDetected)) != 0) {
+        target.tamper_detected = patch.tamper_detected;
+    }
+}
+
+/// Envelope the patch is written in.
+enum class ShadowFormat : uint8_t
+{
+    AwsShadow = 0, // {"state":{"reported":PATCH},"version":N}
+    AzureTwin = 1  // PATCH, to the reported-properties topic
+};
+
+enum class DeltaOutcome : uint8_t
+{
+    Applied = 0,
+    Stale = 1 // not newer than the known document version; ignored
+};
+
+// ============================================================================
+// CONFIGURATION
+// ============================================================================
+struct ShadowSyncConfig
+{
+    bool enabled{true}; // false = full document on every update (legacy behaviour)
+    uint32_t coalesce_ms{SHADOW_DEFAULT_COALESCE_MS}; // 0 = every change at once
+    uint32_t ack_timeout_ms{SHADOW_DEFAULT_ACK_TIMEOUT_MS};
+    network::Deadband voltage_mv{0, 10};   // 1 %
+    network::Deadband current_ma{100, 50}; // 100 mA or 5 %
+    network::Deadband energy_wh{10, 0};
+    uint16_t temperature_c10{5};           // 0.5 °C; 0 = any change
+    uint8_t urgent_fields{shadow_field_bit(ShadowField::TamperDetected)};
+    bool versioned{true}; // carry the known version (AWS optimistic locking)
+};
+
+struct ShadowSyncStats
+{
+    uint32_t messages{};     // patches built (published or not)
+    uint64_t bytes{};        // their serialized size
+    uint32_t fields_sent{};
+    uint32_t coalesced{};    // updates folded into an open window
+    uint32_t conflicts{};    // version-conflict rejections
+    uint32_t resyncs{};      // documents fetched after a conflict
+    uint32_t stale_deltas{};
+    uint32_t timeouts{};     // patches never acknowledged
+};
+
+// ============================================================================
+// SHADOW SYNC
+// ============================================================================
+class ShadowSync
+{
+public:
+    explicit ShadowSync(const ShadowSyncConfig& config = ShadowSyncConfig{}) noexcept
+        : config_(config)
+    {}
+
+    /// Also forgets the acknowledged state: the next patch is a full report.
+    void configure(const ShadowSyncConfig& config) noexcept
+    {
+        config_ = config;
+        has_baseline_ = false;
+        in_flight_ = false;
+        window_open_ = false;
+    }
+
+    /// Latest device state; called every reading.
+    void update(const ReportedState& state, uint64_t now_ms) noexcept
+    {
+        current_ = state;
+        updated_ = true;
+        if (dirty_fields() == 0) {
+            window_open_ = false; // back inside the bands: nothing to send
+            return;
+        }
+        if (window_open_) {
+            ++stats_.coalesced;
+        } else {
+            window_open_ = true;
+            window_start_ms_ = now_ms;
+        }
+    }
+
+    /// Expire an unacknowledged patch.
+    void poll(uint64_t now_ms) noexcept
+    {
+        if (in_flight_ && now_ms - sent_ms_ >= config_.ack_timeout_ms) {
+            ++stats_.timeouts;
+            on_rejected(false);
+        }
+    }
+
+    /// Fields that differ from the acknowledged state (all before the first ack).
+    GS_NODISCARD uint8_t dirty_fields() const noexcept
+    {
+        if (!config_.enabled || !has_baseline_) {
+            return SHADOW_ALL_FIELDS;
+        }
+        uint8_t dirty = 0;
+        if (changed(config_.voltage_mv, current_.voltage_mv, acked_.voltage_mv)) {
+            dirty |= shadow_field_bit(ShadowField::VoltageMv);
+        }
+        if (changed(config_.current_ma, current_.current_ma, acked_.current_ma)) {
+            dirty |= shadow_field_bit(ShadowField::CurrentMa);
+        }
+        if (changed(config_.energy_wh, current_.energy_wh, acked_.energy_wh)) {
+            dirty |= shadow_field_bit(ShadowField::EnergyWh);
+        }
+        const int32_t dt = static_cast<int32_t>(current_.temperature_c10) - acked_.temperature_c10;
+        if (dt != 0 && (dt > config_.temperature_c10 || -dt > config_.temperature_c10)) {
+            dirty |= shadow_field_bit(ShadowField::TemperatureC10);
+        }
+        if (current_.tamper_detected != acked_.tamper_detected) {
+            dirty |= shadow_field_bit(ShadowField::TamperDetected);
+        }
+        return dirty;
+    }
+
+    /// True when a patch should be built now.
+    GS_NODISCARD bool due(uint64_t now_ms) const noexcept
+    {
+        if (in_flight_ || resync_needed_ || !updated_) {
+            return false;
+        }
+        if (!config_.enabled || !has_baseline_) {
+            return true;
+        }
+        const uint8_t dirty = dirty_fields();
+        if (dirty == 0) {
+            return false;
+        }
+        return (dirty & config_.urgent_fields) != 0 || config_.coalesce_ms == 0 ||
+               (window_open_ && now_ms - window_start_ms_ >= config_.coalesce_ms);
+    }
+
+    /**
+     * @brief Serialize the dirty fields into @p buffer and mark them in flight.
+     * @return Patch length (no terminator counted); CloudPayloadTooLarge if
+     *         it does not fit, in which case nothing is marked.
+     */
+    core::Result<size_t>
+    build_patch(char* buffer, size_t capacity, ShadowFormat format, uint64_t now_ms) noexcept
+    {
+        if (GS_UNLIKELY(buffer == nullptr || capacity == 0)) {
+            return core::Result<size_t>(GS_MAKE_ERROR(core::ErrorCode::InvalidParameter));
+        }
+        const uint8_t fields = dirty_fields();
+        const uint32_t version = config_.versioned && has_baseline_ ? version_ : 0;
+        const bool aws = format == ShadowFormat::AwsShadow;
+
+        size_t pos = 0;
+        bool ok = append(buffer, capacity, pos, aws ? "{\"state\":{\"reported\":{" : "{");
+        const char* sep = "";
+        for (uint8_t i = 0; i < SHADOW_FIELD_COUNT && ok; ++i) {
+            if ((fields & (1U << i)) != 0) {
+                ok = append_field(buffer, capacity, pos, static_cast<ShadowField>(i), sep);
+                sep = ",";
+            }
+        }
+        ok = ok && append(buffer, capacity, pos, aws ? "}}" : "}");
+        if (ok && aws && version != 0) {
+            ok = append_u32(buffer, capacity, pos, ",\"version\":", version);
+        }
+        ok = ok && append(buffer, capacity, pos, aws ? "}" : "");
+        if (!ok) {
+            buffer[0] = '\0';
+            return core::Result<size_t>(GS_MAKE_ERROR(core::ErrorCode::CloudPayloadTooLarge));
+        }
+
+        in_flight_ = true;
+        in_flight_fields_ = fields;
+        in_flight_state_ = current_;
+        sent_version_ = version;
+        sent_ms_ = now_ms;
+        window_open_ = false;
+        updated_ = false;
+        ++stats_.messages;
+        stats_.bytes += pos;
+        for (uint8_t i = 0; i < SHADOW_FIELD_COUNT; ++i) {
+            stats_.fields_sent += (fields >> i) & 1U;
+        }
+        return core::Result<size_t>(pos);
+    }
+
+    /// The service took the patch; @p version is the document's new version.
+    void on_accepted(uint32_t version) noexcept
+    {
+        if (!in_flight_) {
+            return;
+        }
+        merge_fields(acked_, in_flight_state_, in_flight_fields_);
+        has_baseline_ = true;
+        in_flight_ = false;
+        if (version > version_) {
+            version_ = version;
+        }
+        // Whatever changed meanwhile is measured against the new baseline;
+        // the legacy mode waits for the next reading
+        updated_ = config_.enabled && dirty_fields() != 0;
+        window_open_ = window_open_ && updated_;
+    }
+
+    /// The patch was refused. A version conflict needs on_document() first.
+    void on_rejected(bool version_conflict) noexcept
+    {
+        in_flight_ = false;
+        updated_ = true;
+        // Retry a window after the refused send, or sooner if urgent
+        window_open_ = true;
+        window_start_ms_ = sent_ms_;
+        if (version_conflict) {
+            ++stats_.conflicts;
+            resync_needed_ = true;
+        }
+    }
+
+    /// Rebase on the full document fetched from the service.
+    void on_document(uint32_t version, const ReportedState& reported, const DesiredState& desired)
+        noexcept
+    {
+        acked_ = reported;
+        desired_ = desired;
+        version_ = version;
+        has_baseline_ = true;
+        resync_needed_ = false;
+        in_flight_ = false;
+        updated_ = true;
+        ++stats_.resyncs;
+    }
+
+    /// A desired-state delta from the service.
+    DeltaOutcome apply_delta(const DesiredState& desired, uint32_t version) noexcept
+    {
+        if (version_ != 0 && version <= version_) {
+            ++stats_.stale_deltas;
+            return DeltaOutcome::Stale;
+        }
+        desired_ = desired;
+        version_ = version;
+        return DeltaOutcome::Applied;
+    }
+
+    // === Observability ===
+
+    GS_NODISCARD const ReportedState& acknowledged() const noexcept
+    {
+        return acked_;
+    }
+    GS_NODISCARD const DesiredState& desired() const noexcept
+    {
+        return desired_;
+    }
+    GS_NODISCARD uint32_t version() const noexcept
+    {
+        return version_;
+    }
+    GS_NODISCARD bool in_flight() const noexcept
+    {
+        return in_flight_;
+    }
+    GS_NODISCARD uint8_t in_flight_fields() const noexcept
+    {
+        return in_flight_fields_;
+    }
+    GS_NODISCARD const ReportedState& in_flight_state() const noexcept
+    {
+        return in_flight_state_;
+    }
+    /// Version the in-flight patch was sent against; 0 = unversioned.
+    GS_NODISCARD uint32_t sent_version() const noexcept
+    {
+        return sent_version_;
+    }
+    GS_NODISCARD bool resync_needed() const noexcept
+    {
+        return resync_needed_;
+    }
+    GS_NODISCARD const ShadowSyncConfig& config() const noexcept
+    {
+        return config_;
+    }
+    GS_NODISCARD const ShadowSyncStats& stats() const noexcept
+    {
+        return stats_;
+    }
+
+private:
+    GS_NODISCARD static bool
+    changed(const network::Deadband& band, uint32_t value, uint32_t reference) noexcept
+    {
+        if (value == reference) {
+            return false;
+        }
+        return (band.absolute == 0 && band.percent_x10 == 0) || band.exceeded(value, reference);
+    }
+
+    static bool append(char* buffer, size_t capacity, size_t& pos, const char* text) noexcept
+    {
+        const int n = std::snprintf(buffer + pos, capacity - pos, "%s", text);
+        if (n < 0 || static_cast<size_t>(n) >= capacity - pos) {
+            return false;
+        }
+        pos += static_cast<size_t>(n);
+        return true;
+    }
+
+    static bool append_u32(char* buffer,
+                           size_t capacity,
+                           size_t& pos,
+                           const char* key,
+                           uint32_t value) noexcept
+    {
+        const int n = std::snprintf(
+            buffer + pos, capacity - pos, "%s%lu", key, static_cast<unsigned long>(value));
+        if (n < 0 || static_cast<size_t>(n) >= capacity - pos) {
+            return false;
+        }
+        pos += static_cast<size_t>(n);
+        return true;
+    }
+
+    bool append_field(
+        char* buffer, size_t capacity, size_t& pos, ShadowField field, const char* sep) const
+        noexcept
+    {
+        int n = 0;
+        char* out = buffer + pos;
+        const size_t room = capacity - pos;
+        switch (field) {
+        case ShadowField::VoltageMv:
+            n = std::snprintf(out, room, "%s\"voltage_mv\":%lu", sep,
+                              static_cast<unsigned long>(current_.voltage_mv));
+            break;
+        case ShadowField::CurrentMa:
+            n = std::snprintf(out, room, "%s\"current_ma\":%lu", sep,
+                              static_cast<unsigned long>(current_.current_ma));
+            break;
+        case ShadowField::EnergyWh:
+            n = std::snprintf(out, room, "%s\"energy_wh\":%lu", sep,
+                              static_cast<unsigned long>(current_.energy_wh));
+            break;
+        case ShadowField::TemperatureC10:
+            n = std::snprintf(out, room, "%s\"temperature_c10\":%d", sep,
+                              static_cast<int>(current_.temperature_c10));
+            break;
+        case ShadowField::TamperDetected:
+            n = std::snprintf(out, room, "%s\"tamper_detected\":%s", sep,
+                              current_.tamper_detected ? "true" : "false");
+            break;
+        }
+        if (n < 0 || static_cast<size_t>(n) >= room) {
+            return false;
+        }
+        pos += static_cast<size_t>(n);
+        return true;
+    }
+
+    ShadowSyncConfig config_;
+    ReportedState current_{};
+    ReportedState acked_{};
+    ReportedState in_flight_state_{};
+    DesiredState desired_{};
+    ShadowSyncStats stats_{};
+    uint64_t window_start_ms_{0};
+    uint64_t sent_ms_{0};
+    uint32_t version_{0};
+    uint32_t sent_version_{0};
+    uint8_t in_flight_fields_{0};
+    bool has_baseline_{false};
+    bool in_flight_{false};
+    bool window_open_{false};
+    bool updated_{false};
+    bool resync_needed_{false};
+};
+
+} // namespace gridshield::cloud
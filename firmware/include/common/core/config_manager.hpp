@@ -57,7 +57,8 @@ public:
         uint32_t crc = crc_res.value();
         memcpy(buffer + TOTAL_SIZE - FOOTER_SIZE, &crc, 4);
 
-        return platform_.storage->write(CONFIG_ADDRESS, buffer, TOTAL_SIZE).as_void();
+        GS_TRY(platform_.storage->write(CONFIG_ADDRESS, buffer, TOTAL_SIZE).as_void());
+        return platform_.storage->flush();
     }
 
     /**
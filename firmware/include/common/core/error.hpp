@@ -52,6 +52,7 @@ enum class ErrorCode : uint16_t
     SignatureInvalid = 304,
     EncryptionFailed = 305,
     DecryptionFailed = 306,
+    ReplayDetected = 307,
 
     // Network errors (400-499)
     NetworkTimeout = 400,
@@ -99,6 +100,7 @@ enum class ErrorCode : uint16_t
     CloudProvisioningFailed = 813,
     CloudAuthenticationFailed = 814,
     CloudPayloadTooLarge = 815,
+    CloudVersionConflict = 816, // shadow/twin document changed under the update
 
     // SNTP errors (820-829)
     SntpSyncFailed = 820,
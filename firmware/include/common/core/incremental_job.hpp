@@ -0,0 +1,200 @@
+/**
+ * @file incremental_job.hpp
+ * @brief Cooperative, time-sliced execution of long-running operations
+ *
+ * A job does a bounded unit of work per step() and keeps its own cursor,
+ * so the scheduler can resume it on the next cycle. JobScheduler runs
+ * steps round-robin until the per-cycle budget is spent, keeping the
+ * tamper path and watchdog feed on a bounded main-loop latency.
+ *
+ * @note Header-only, zero heap allocation.
+ */
+
+#pragma once
+
+#include "core/error.hpp"
+#include "platform/platform.hpp"
+#include "utils/gs_macros.hpp"
+
+#include <array>
+#include <cstdint>
+
+namespace gridshield::core {
+
+// ============================================================================
+// Constants
+// ============================================================================
+static constexpr size_t JOB_MAX_CONCURRENT = 8;
+static constexpr uint32_t JOB_DEFAULT_BUDGET_US = 2000;
+
+// ============================================================================
+// Types
+// ============================================================================
+
+enum class JobStatus : uint8_t
+{
+    Pending = 0, // more steps required
+    Done = 1,
+    Failed = 2
+};
+
+struct JobSchedulerStats
+{
+    uint32_t steps_run{0};
+    uint32_t jobs_completed{0};
+    uint32_t jobs_failed{0};
+    uint32_t budget_exhausted{0}; // cycles that ended with work still queued
+    uint32_t last_run_us{0};
+    uint32_t max_run_us{0};
+};
+
+// ============================================================================
+// Interface
+// ============================================================================
+
+class IIncrementalJob
+{
+public:
+    virtual ~IIncrementalJob() noexcept = default;
+
+    /// Perform one bounded unit of work and report progress.
+    virtual JobStatus step() noexcept = 0;
+
+    /// Rewind to the initial state so the job can be resubmitted.
+    virtual void reset() noexcept = 0;
+
+    /**
+     * @brief Expected cost of the next step, in microseconds.
+     *
+     * The scheduler only starts a step that fits the remaining budget, except
+     * as the first step of a cycle (so an indivisible step still progresses).
+     * 0 = unknown / cheap.
+     */
+    GS_NODISCARD virtual uint32_t next_step_cost_us() const noexcept
+    {
+        return 0;
+    }
+};
+
+// ============================================================================
+// Scheduler
+// ============================================================================
+
+template <size_t N = JOB_MAX_CONCURRENT> class JobScheduler
+{
+    static_assert(N > 0, "Scheduler needs at least one slot");
+
+public:
+    core::Result<void> submit(IIncrementalJob& job) noexcept
+    {
+        for (size_t idx = 0; idx < N; ++idx) {
+            if (jobs_[idx] == &job) {
+                return GS_MAKE_ERROR(core::ErrorCode::InvalidState);
+            }
+        }
+        for (size_t idx = 0; idx < N; ++idx) {
+            if (jobs_[idx] == nullptr) {
+                jobs_[idx] = &job;
+                ++active_;
+                return core::Result<void>{};
+            }
+        }
+        return GS_MAKE_ERROR(core::ErrorCode::ResourceExhausted);
+    }
+
+    /// Drop a job without running it further (e.g. its owner is going away).
+    void cancel(IIncrementalJob& job) noexcept
+    {
+        for (size_t idx = 0; idx < N; ++idx) {
+            if (jobs_[idx] == &job) {
+                jobs_[idx] = nullptr;
+                --active_;
+            }
+        }
+    }
+
+    /**
+     * @brief Run queued jobs round-robin for at most @p budget_us.
+     * @return Number of steps executed this cycle.
+     */
+    uint32_t run(platform::IPlatformTime& time, uint32_t budget_us) noexcept
+    {
+        if (active_ == 0) {
+            stats_.last_run_us = 0;
+            return 0;
+        }
+
+        const uint64_t start = time.get_timestamp_us();
+        uint32_t elapsed = 0;
+        uint32_t steps = 0;
+        size_t idle_probes = 0;
+
+        while (active_ > 0 && elapsed < budget_us && idle_probes < N) {
+            IIncrementalJob* job = jobs_[cursor_];
+            const size_t slot = cursor_;
+            cursor_ = (cursor_ + 1) % N;
+            if (job == nullptr) {
+                ++idle_probes;
+                continue;
+            }
+
+            const uint32_t cost = job->next_step_cost_us();
+            if (steps > 0 && cost > budget_us - elapsed) {
+                ++idle_probes; // does not fit this cycle, try the others
+                continue;
+            }
+            idle_probes = 0;
+
+            const JobStatus status = job->step();
+            ++steps;
+            if (status != JobStatus::Pending) {
+                jobs_[slot] = nullptr;
+                --active_;
+                if (status == JobStatus::Done) {
+                    ++stats_.jobs_completed;
+                } else {
+                    ++stats_.jobs_failed;
+                }
+            }
+            elapsed = static_cast<uint32_t>(time.get_timestamp_us() - start);
+        }
+
+        if (active_ > 0) {
+            ++stats_.budget_exhausted;
+        }
+        stats_.steps_run += steps;
+        stats_.last_run_us = elapsed;
+        if (elapsed > stats_.max_run_us) {
+            stats_.max_run_us = elapsed;
+        }
+        return steps;
+    }
+
+    GS_NODISCARD size_t active() const noexcept
+    {
+        return active_;
+    }
+
+    GS_NODISCARD bool is_queued(const IIncrementalJob& job) const noexcept
+    {
+        for (size_t idx = 0; idx < N; ++idx) {
+            if (jobs_[idx] == &job) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    GS_NODISCARD const JobSchedulerStats& stats() const noexcept
+    {
+        return stats_;
+    }
+
+private:
+    std::array<IIncrementalJob*, N> jobs_{};
+    size_t cursor_{0};
+    size_t active_{0};
+    JobSchedulerStats stats_{};
+};
+
+} // namespace gridshield::core
@@ -12,13 +12,18 @@
 #pragma once
 
 #include "analytics/detector.hpp"
+#include "analytics/phase_rules.hpp"
 #include "core/degradation.hpp"
 #include "core/error.hpp"
+#include "core/incremental_job.hpp"
 #include "core/telemetry.hpp"
 #include "core/types.hpp"
+#include "forensics/flight_recorder.hpp"
+#include "hardware/adaptive_sampling.hpp"
 #include "hardware/sensor_manager.hpp"
 #include "hardware/tamper.hpp"
 #include "network/packet.hpp"
+#include "network/report_policy.hpp"
 #include "platform/platform.hpp"
 #include "security/crypto.hpp"
 #include "system/ota_manager.hpp"
@@ -33,12 +38,18 @@ struct SystemConfig
 {
     static constexpr uint32_t DEFAULT_HEARTBEAT_INTERVAL_MS = 60000;
     static constexpr uint32_t DEFAULT_READING_INTERVAL_MS = 5000;
+    static constexpr uint32_t DEFAULT_CHECKPOINT_INTERVAL_MS = 900000; // 15 min
 
     core::meter_id_t meter_id{};
     hardware::TamperConfig tamper_config;
     analytics::ConsumptionProfile baseline_profile;
     uint32_t heartbeat_interval_ms{DEFAULT_HEARTBEAT_INTERVAL_MS};
     uint32_t reading_interval_ms{DEFAULT_READING_INTERVAL_MS};
+    uint32_t checkpoint_interval_ms{DEFAULT_CHECKPOINT_INTERVAL_MS}; // 0 = brownout only
+    uint32_t job_budget_us{core::JOB_DEFAULT_BUDGET_US}; // background work per cycle
+    network::ReportPolicyConfig report_policy{};          // report-by-exception (off by default)
+    analytics::PhaseRulesConfig phase_rules{};            // three-phase installations only
+    hardware::AdaptiveSamplingConfig adaptive_sampling{}; // idle cadence = reading_interval_ms
 
     // v2.2.0: Sensor, OTA, and Power configurations
     hardware::SensorManagerConfig sensor_config{};
@@ -97,9 +108,36 @@ public:
 
     // Operations
     core::Result<void> send_meter_reading(const core::MeterReading& reading) noexcept;
+    core::Result<void> send_three_phase_reading(const core::ThreePhaseReading& reading) noexcept;
+
     core::Result<void> send_tamper_alert() noexcept;
     core::Result<void> send_heartbeat() noexcept;
 
+    // Whole-meter view of a three-phase record for the consumption detector
+    // and the report policy: mean phase voltage, summed phase current. The
+    // sum is carried in AGGREGATE_CURRENT_UNIT_MA steps because it outgrows
+    // the 16-bit mA field at 65.5 A; the report policy's absolute current
+    // deadband is in the same unit on three-phase meters.
+    static constexpr uint32_t AGGREGATE_CURRENT_UNIT_MA = 100;
+    static core::MeterReading aggregate_reading(const core::ThreePhaseReading& reading) noexcept;
+
+    // Background work, resumed at the end of each process_cycle()
+    core::Result<void> submit_job(core::IIncrementalJob& job) noexcept
+    {
+        return jobs_.submit(job);
+    }
+
+    // Waveform flight recorder: fed by every reading the sensor front end
+    // (SystemConfig::sensor_config) takes, frozen on tamper and on High+
+    // anomalies, archived through the job scheduler. nullptr detaches.
+    void attach_flight_recorder(forensics::IFlightRecorder* recorder) noexcept;
+
+    // Warm-boot persistence. process_cycle() calls handle_power_loss() when
+    // the backup-power sense pin (tamper_config.backup_power_pin) drops and
+    // resumes once it returns; platforms with other brownout sources call it.
+    core::Result<void> checkpoint_state() noexcept;
+    core::Result<void> handle_power_loss() noexcept;
+
     // Degradation & Telemetry accessors
     GS_NODISCARD const core::DegradationManager& degradation() const noexcept
     {
@@ -109,6 +147,30 @@ public:
     {
         return telemetry_;
     }
+    GS_NODISCARD const core::BootTiming& boot_timing() const noexcept
+    {
+        return telemetry_.boot_timing();
+    }
+    GS_NODISCARD const analytics::AnomalyDetector& anomaly_detector() const noexcept
+    {
+        return anomaly_detector_;
+    }
+    GS_NODISCARD const analytics::PhaseRules& phase_rules() const noexcept
+    {
+        return phase_rules_;
+    }
+    GS_NODISCARD const core::JobScheduler<>& jobs() const noexcept
+    {
+        return jobs_;
+    }
+    GS_NODISCARD const network::ReportPolicy& report_policy() const noexcept
+    {
+        return report_policy_;
+    }
+    GS_NODISCARD const hardware::AdaptiveSampler& adaptive_sampler() const noexcept
+    {
+        return adaptive_sampler_;
+    }
 
     // v2.2.0 subsystem accessors
     GS_NODISCARD hardware::SensorManager& sensors() noexcept
@@ -126,9 +188,18 @@ public:
 
 private:
     core::Result<void> initialize_crypto() noexcept;
+    core::Result<void> restore_analytics_state() noexcept;
+    void mark_boot_phase(core::BootPhase phase) noexcept;
     core::Result<void> init_network_layer() noexcept;
     core::Result<void> handle_tamper_event() noexcept;
     core::Result<void> perform_cross_layer_validation() noexcept;
+    void trigger_flight_recorder(const forensics::FlightTrigger& info) noexcept;
+    core::Result<void> stamp_sequence(network::SecurePacket& packet) noexcept;
+    GS_NODISCARD uint32_t reading_interval_ms(core::timestamp_t now) const noexcept;
+    void observe_sampling(const hardware::SamplingObservation& obs,
+                          core::timestamp_t now) noexcept;
+    GS_NODISCARD bool supply_failed() noexcept;
+    void sync_sampling_profile() noexcept;
 
     void transition_state(core::SystemState new_state) noexcept;
     void set_mode(OperationMode new_mode) noexcept;
@@ -142,16 +213,20 @@ private:
     security::ECCKeyPair device_keypair_;
     security::ECCKeyPair server_public_key_;
     network::PacketTransport* packet_transport_{};
+    network::TxSequenceCounter tx_sequence_; // persisted, survives reboot
     analytics::AnomalyDetector anomaly_detector_;
+    analytics::PhaseRules phase_rules_;
 
     // State management
     core::SystemState state_{core::SystemState::Uninitialized};
+    core::SystemState resume_state_{core::SystemState::Operating}; // after PowerLoss
     OperationMode mode_{OperationMode::Normal};
     bool initialized_{false};
 
     // Timing
     core::timestamp_t last_heartbeat_{};
     core::timestamp_t last_reading_{};
+    core::timestamp_t last_checkpoint_{};
 
     // Cross-layer validation
     analytics::CrossLayerValidation validation_state_;
@@ -160,10 +235,21 @@ private:
     core::DegradationManager degradation_;
     core::SystemTelemetry telemetry_;
 
+    // Incremental background jobs (chain verify, keygen-ahead, ...)
+    core::JobScheduler<> jobs_;
+
+    // Report-by-exception filter in front of send_meter_reading()
+    network::ReportPolicy report_policy_;
+
+    // Reading cadence: idles at reading_interval_ms, bursts on suspected tamper
+    hardware::AdaptiveSampler adaptive_sampler_;
+
     // v2.2.0: Sensor, OTA, Power subsystems
     hardware::SensorManager sensor_manager_;
     system::OtaManager ota_manager_;
     system::PowerManager power_manager_;
+
+    forensics::IFlightRecorder* flight_recorder_{nullptr};
 };
 
 } // namespace gridshield
\ No newline at end of file
@@ -53,10 +53,50 @@ struct TelemetryCounters
     // Process cycles
     uint32_t cycle_count{};
     uint32_t cycle_overruns{}; // cycle took longer than reading_interval
+    uint32_t last_cycle_us{};
+    uint32_t max_cycle_us{}; // worst-case main-loop latency
 
     constexpr TelemetryCounters() noexcept = default;
 };
 
+// ============================================================================
+// BOOT PHASE TIMING
+// ============================================================================
+enum class BootPhase : uint8_t
+{
+    Reset = 0,             // initialize() entered (time since reset on ESP32)
+    TamperReady = 1,       // tamper detector armed
+    KeysReady = 2,         // device/server keys loaded (or generated on first boot)
+    NetworkReady = 3,      // transport constructed, comm initialised
+    AnalyticsRestored = 4, // detector state restored from warm-boot checkpoint
+    Ready = 5,             // SystemState::Ready
+    FirstSignedReading = 6,
+    Count = 7
+};
+
+struct BootTiming
+{
+    std::array<timestamp_t, static_cast<size_t>(BootPhase::Count)> phase_ms{};
+    uint8_t reached_mask{};
+    bool warm_keys{false};      // keys came from KeyStorage
+    bool warm_analytics{false}; // detector profile came from checkpoint
+
+    GS_NODISCARD bool reached(BootPhase phase) const noexcept
+    {
+        return (reached_mask & (1U << static_cast<uint8_t>(phase))) != 0;
+    }
+
+    /// Milliseconds from BootPhase::Reset to @p phase (0 if not reached yet).
+    GS_NODISCARD timestamp_t since_reset(BootPhase phase) const noexcept
+    {
+        if (!reached(phase) || !reached(BootPhase::Reset)) {
+            return 0;
+        }
+        return phase_ms[static_cast<size_t>(phase)] -
+               phase_ms[static_cast<size_t>(BootPhase::Reset)];
+    }
+};
+
 // ============================================================================
 // SYSTEM TELEMETRY
 // ============================================================================
@@ -135,12 +175,37 @@ public:
         }
     }
 
+    void record_cycle_latency(uint32_t elapsed_us, bool overrun = false) noexcept
+    {
+        record_cycle(overrun);
+        counters_.last_cycle_us = elapsed_us;
+        if (elapsed_us > counters_.max_cycle_us) {
+            counters_.max_cycle_us = elapsed_us;
+        }
+    }
+
     void record_boot(timestamp_t boot_time = 0) noexcept
     {
         ++counters_.boot_count;
         counters_.last_boot_time = boot_time;
     }
 
+    /// Record the first time a boot phase is reached; later calls are ignored.
+    void mark_boot_phase(BootPhase phase, timestamp_t now_ms) noexcept
+    {
+        if (phase >= BootPhase::Count || boot_timing_.reached(phase)) {
+            return;
+        }
+        boot_timing_.phase_ms[static_cast<size_t>(phase)] = now_ms;
+        boot_timing_.reached_mask |= static_cast<uint8_t>(1U << static_cast<uint8_t>(phase));
+    }
+
+    void set_warm_boot(bool keys, bool analytics) noexcept
+    {
+        boot_timing_.warm_keys = keys;
+        boot_timing_.warm_analytics = analytics;
+    }
+
     void update_uptime(timestamp_t current_ms) noexcept
     {
         if (counters_.last_boot_time > 0) {
@@ -155,13 +220,20 @@ public:
         return counters_;
     }
 
+    GS_NODISCARD const BootTiming& boot_timing() const noexcept
+    {
+        return boot_timing_;
+    }
+
     void reset() noexcept
     {
         counters_ = TelemetryCounters{};
+        boot_timing_ = BootTiming{};
     }
 
 private:
     TelemetryCounters counters_;
+    BootTiming boot_timing_;
 };
 
 } // namespace gridshield::core
@@ -90,6 +90,56 @@ struct GS_ALIGN(8) MeterReading
 };
 GS_STATIC_ASSERT(sizeof(MeterReading) == 24, "MeterReading must be 24 bytes");
 
+// ============================================================================
+// THREE-PHASE READING (56 bytes)
+// ============================================================================
+static constexpr size_t PHASE_COUNT = 3;
+
+enum class PhaseSequence : uint8_t
+{
+    Unknown = 0,
+    Abc = 1, // positive sequence: B lags A by 120 degrees
+    Acb = 2  // negative sequence (two phases swapped)
+};
+
+// ThreePhaseReading::flags
+static constexpr uint8_t PHASE_FLAG_NEUTRAL_CT = 0x01; // neutral measured, residual valid
+static constexpr uint8_t PHASE_FLAG_FREQ_VALID = 0x02; // >= 2 zero crossings on phase A
+static constexpr uint8_t PHASE_FLAG_LIVE_SHIFT = 4;    // bits 4..6: phase A..C energised
+
+struct PhaseSample
+{
+    int32_t power_w{};     // 4 bytes active power, negative = export
+    uint16_t voltage_dv{}; // 2 bytes RMS, 0.1 V
+    uint16_t current_ca{}; // 2 bytes RMS, 10 mA
+
+    constexpr PhaseSample() noexcept = default;
+};
+GS_STATIC_ASSERT(sizeof(PhaseSample) == 8, "PhaseSample must be 8 bytes");
+
+struct GS_ALIGN(8) ThreePhaseReading
+{
+    timestamp_t timestamp{};                        // 8 bytes
+    uint32_t energy_wh{};                           // 4 bytes total import
+    int32_t total_power_w{};                        // 4 bytes
+    std::array<PhaseSample, PHASE_COUNT> phases{};  // 24 bytes
+    uint16_t neutral_ca{};                          // 2 bytes RMS (measured or vector sum)
+    uint16_t residual_ca{};                         // 2 bytes RMS of In - (Ia + Ib + Ic)
+    uint16_t voltage_unbalance_permille{};          // 2 bytes max deviation from mean
+    uint16_t current_unbalance_permille{};          // 2 bytes
+    uint16_t frequency_chz{};                       // 2 bytes 0.01 Hz
+    PhaseSequence sequence{PhaseSequence::Unknown}; // 1 byte
+    uint8_t flags{};                                // 1 byte PHASE_FLAG_*
+
+    constexpr ThreePhaseReading() noexcept = default;
+
+    GS_NODISCARD constexpr bool phase_live(size_t phase) const noexcept
+    {
+        return (flags & (1U << (PHASE_FLAG_LIVE_SHIFT + phase))) != 0;
+    }
+};
+GS_STATIC_ASSERT(sizeof(ThreePhaseReading) == 56, "ThreePhaseReading must be 56 bytes");
+
 // ============================================================================
 // TAMPER EVENT (16 bytes)
 // ============================================================================
@@ -0,0 +1,221 @@
+/**
+ * @file warm_boot.hpp
+ * @author zuudevs (zuudevs@gmail.com)
+ * @brief Warm-boot checkpoint store for learned runtime state
+ * @version 1.0
+ * @date 2026-03-09
+ *
+ * Persists trivially-copyable state blobs (detector profile, time series
+ * windows) so a reboot resumes from learned state instead of the baseline.
+ * Each record has two banks (A/B). A save always goes to the older bank
+ * and writes the header last, so a brownout mid-write leaves the previous
+ * checkpoint intact.
+ *
+ * Storage Layout (per bank):
+ *   [MAGIC: 4B] [VERSION: 1B] [RECORD: 1B] [LENGTH: 2B] [SEQUENCE: 4B] [CRC32: 4B]
+ *   [PAYLOAD: LENGTH bytes]
+ *
+ * @copyright Copyright (c) 2026
+ */
+
+#pragma once
+
+#include "core/error.hpp"
+#include "platform/platform.hpp"
+
+#include <cstring>
+#include <type_traits>
+
+namespace gridshield::core {
+
+enum class WarmBootRecord : uint8_t
+{
+    Detector = 0,
+    TimeSeries = 1,
+    Count = 2
+};
+
+class WarmBootStore
+{
+public:
+    static constexpr uint32_t WB_MAGIC = 0x47535742; // "GSWB" (GridShield Warm Boot)
+    static constexpr uint8_t WB_VERSION = 2;
+    static constexpr uint32_t WB_BASE_ADDRESS = 1024; // After ConfigManager area
+    static constexpr size_t HEADER_SIZE = 16;
+    static constexpr size_t BANK_COUNT = 2;
+    static constexpr size_t DETECTOR_BANK_SIZE = 1344;
+    static constexpr size_t TIME_SERIES_BANK_SIZE = 896;
+    static constexpr size_t TOTAL_SIZE = BANK_COUNT * (DETECTOR_BANK_SIZE + TIME_SERIES_BANK_SIZE);
+
+    explicit WarmBootStore(platform::PlatformServices& platform) noexcept : platform_(platform)
+    {}
+
+    /**
+     * @brief Largest payload a record can hold
+     */
+    static constexpr size_t max_payload(WarmBootRecord record) noexcept
+    {
+        return bank_size(record) - HEADER_SIZE;
+    }
+
+    /**
+     * @brief Checkpoint @p state into the older bank of @p record
+     */
+    template <typename T> core::Result<void> save(WarmBootRecord record, const T& state) noexcept
+    {
+        static_assert(std::is_trivially_copyable<T>::value, "checkpoint state must be POD");
+        if (record >= WarmBootRecord::Count) {
+            return GS_MAKE_ERROR(core::ErrorCode::InvalidParameter);
+        }
+        if (sizeof(T) > max_payload(record)) {
+            return GS_MAKE_ERROR(core::ErrorCode::BufferOverflow);
+        }
+
+        BankHeader newest{};
+        size_t newest_bank = BANK_COUNT;
+        find_newest(record, sizeof(T), newest, newest_bank);
+        const size_t target = (newest_bank == 0) ? 1 : 0;
+        const uint32_t sequence = (newest_bank < BANK_COUNT) ? newest.sequence + 1 : 1;
+
+        const auto* payload = reinterpret_cast<const uint8_t*>(&state);
+        auto crc_res = platform_.crypto->crc32(payload, sizeof(T));
+        if (crc_res.is_error())
+            return crc_res.error();
+
+        // Payload first, header last: the header is the commit point
+        const uint32_t address = bank_address(record, target);
+        GS_TRY(platform_.storage->write(address + HEADER_SIZE, payload, sizeof(T)).as_void());
+
+        uint8_t header[HEADER_SIZE];
+        memset(header, 0, HEADER_SIZE);
+        uint32_t magic = WB_MAGIC;
+        uint16_t length = static_cast<uint16_t>(sizeof(T));
+        uint32_t crc = crc_res.value();
+        memcpy(header, &magic, 4);
+        header[4] = WB_VERSION;
+        header[5] = static_cast<uint8_t>(record);
+        memcpy(header + 6, &length, 2);
+        memcpy(header + 8, &sequence, 4);
+        memcpy(header + 12, &crc, 4);
+        return platform_.storage->write(address, header, HEADER_SIZE).as_void();
+    }
+
+    /**
+     * @brief Restore the newest valid checkpoint of @p record into @p state
+     *
+     * Falls back to the other bank if the newest one fails its CRC.
+     * @p state is untouched on error.
+     */
+    template <typename T> core::Result<void> load(WarmBootRecord record, T& state) noexcept
+    {
+        static_assert(std::is_trivially_copyable<T>::value, "checkpoint state must be POD");
+        if (record >= WarmBootRecord::Count || sizeof(T) > max_payload(record)) {
+            return GS_MAKE_ERROR(core::ErrorCode::InvalidParameter);
+        }
+
+        BankHeader headers[BANK_COUNT]{};
+        bool valid[BANK_COUNT]{};
+        for (size_t bank = 0; bank < BANK_COUNT; ++bank) {
+            valid[bank] = read_header(record, bank, sizeof(T), headers[bank]);
+        }
+
+        // Newest first
+        size_t order[BANK_COUNT] = {0, 1};
+        if (valid[1] && (!valid[0] || headers[1].sequence > headers[0].sequence)) {
+            order[0] = 1;
+            order[1] = 0;
+        }
+
+        T candidate;
+        auto* payload = reinterpret_cast<uint8_t*>(&candidate);
+        for (size_t idx = 0; idx < BANK_COUNT; ++idx) {
+            const size_t bank = order[idx];
+            if (!valid[bank]) {
+                continue;
+            }
+            auto read_res = platform_.storage->read(
+                bank_address(record, bank) + HEADER_SIZE, payload, sizeof(T));
+            if (read_res.is_error()) {
+                continue;
+            }
+            auto crc_res = platform_.crypto->crc32(payload, sizeof(T));
+            if (crc_res.is_ok() && crc_res.value() == headers[bank].crc) {
+                memcpy(&state, payload, sizeof(T));
+                return core::Result<void>{};
+            }
+        }
+        return GS_MAKE_ERROR(core::ErrorCode::IntegrityViolation);
+    }
+
+    /**
+     * @brief Erase both banks of a record (forces a cold start for it)
+     */
+    core::Result<void> erase(WarmBootRecord record) noexcept
+    {
+        if (record >= WarmBootRecord::Count) {
+            return GS_MAKE_ERROR(core::ErrorCode::InvalidParameter);
+        }
+        return platform_.storage->erase(bank_address(record, 0), BANK_COUNT * bank_size(record));
+    }
+
+private:
+    struct BankHeader
+    {
+        uint32_t sequence{};
+        uint32_t crc{};
+    };
+
+    static constexpr size_t bank_size(WarmBootRecord record) noexcept
+    {
+        return (record == WarmBootRecord::Detector) ? DETECTOR_BANK_SIZE : TIME_SERIES_BANK_SIZE;
+    }
+
+    static constexpr uint32_t bank_address(WarmBootRecord record, size_t bank) noexcept
+    {
+        return WB_BASE_ADDRESS +
+               static_cast<uint32_t>(record == WarmBootRecord::Detector
+                                         ? 0
+                                         : BANK_COUNT * DETECTOR_BANK_SIZE) +
+               static_cast<uint32_t>(bank * bank_size(record));
+    }
+
+    bool read_header(WarmBootRecord record, size_t bank, size_t length, BankHeader& out) noexcept
+    {
+        uint8_t header[HEADER_SIZE];
+        if (platform_.storage->read(bank_address(record, bank), header, HEADER_SIZE).is_error()) {
+            return false;
+        }
+
+        uint32_t magic;
+        uint16_t stored_length;
+        memcpy(&magic, header, 4);
+        memcpy(&stored_length, header + 6, 2);
+        if (magic != WB_MAGIC || header[4] != WB_VERSION ||
+            header[5] != static_cast<uint8_t>(record) || stored_length != length) {
+            return false;
+        }
+        memcpy(&out.sequence, header + 8, 4);
+        memcpy(&out.crc, header + 12, 4);
+        return true;
+    }
+
+    void find_newest(WarmBootRecord record,
+                     size_t length,
+                     BankHeader& newest,
+                     size_t& newest_bank) noexcept
+    {
+        newest_bank = BANK_COUNT;
+        for (size_t bank = 0; bank < BANK_COUNT; ++bank) {
+            BankHeader header{};
+            if (read_header(record, bank, length, header) &&
+                (newest_bank == BANK_COUNT || header.sequence > newest.sequence)) {
+                newest = header;
+                newest_bank = bank;
+            }
+        }
+    }
+
+    platform::PlatformServices& platform_;
+};
+
+} // namespace gridshield::core
@@ -45,6 +45,7 @@ enum class SecurityEventType : uint8_t
     ConsumptionSpike = 22,
     ZeroConsumption = 23,
     ProfileDeviation = 24,
+    PhaseAnomaly = 25, // analytics::PhaseRules (bypass, reversal, neutral residual, ...)
 
     // System events
     KeyRotation = 30,
@@ -133,7 +134,7 @@ public:
             ++count_;
         }
 
-        return core::Result<void>::ok();
+        return core::Result<void>{};
     }
 
     /**
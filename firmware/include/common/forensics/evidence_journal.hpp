@@ -0,0 +1,245 @@
+/**
+ * @file evidence_journal.hpp
+ * @author zuudevs (zuudevs@gmail.com)
+ * @brief Append-only flash journal that persists EvidenceStore snapshots
+ * @version 1.0
+ * @date 2026-03-13
+ *
+ * Records are appended into erased space, so a normal append only programs
+ * bytes and never erases. The oldest sector is erased when the ring wraps
+ * onto it. A record torn by power loss fails its CRC and is skipped on
+ * mount; appends continue after the newest valid record.
+ *
+ * Storage Layout (per record, records never straddle a sector):
+ *   [MAGIC: 4B] [SEQUENCE: 4B] [SNAPSHOT: sizeof(EvidenceSnapshot)] [CRC32: 4B]
+ *
+ * Needs a flash-backed storage larger than the 8 KB key/config/warm-boot
+ * area: the default region starts at 8192.
+ *
+ * @copyright Copyright (c) 2026
+ */
+
+#pragma once
+
+#include "core/error.hpp"
+#include "forensics/evidence_store.hpp"
+#include "platform/platform.hpp"
+
+#include <cstring>
+
+namespace gridshield::forensics {
+
+class EvidenceJournal
+{
+public:
+    static constexpr uint32_t JOURNAL_MAGIC = 0x47534A45; // "GSJE" (GridShield Journal Evidence)
+    static constexpr uint32_t DEFAULT_BASE_ADDRESS = 8192; // After the warm-boot area
+    static constexpr size_t DEFAULT_SECTOR_SIZE = 4096;
+    static constexpr size_t DEFAULT_SECTOR_COUNT = 4;
+    static constexpr size_t HEADER_SIZE = 8; // magic(4) + sequence(4)
+    static constexpr size_t FOOTER_SIZE = 4; // crc32(4)
+    static constexpr size_t RECORD_SIZE = HEADER_SIZE + sizeof(EvidenceSnapshot) + FOOTER_SIZE;
+
+    explicit EvidenceJournal(platform::PlatformServices& platform,
+                             uint32_t base_address = DEFAULT_BASE_ADDRESS,
+                             size_t sector_size = DEFAULT_SECTOR_SIZE,
+                             size_t sector_count = DEFAULT_SECTOR_COUNT) noexcept
+        : platform_(platform), base_(base_address), sector_size_(sector_size),
+          sector_count_(sector_count), slots_per_sector_(sector_size / RECORD_SIZE)
+    {}
+
+    /**
+     * @brief Scan the region and position the head after the newest record.
+     */
+    core::Result<void> mount() noexcept
+    {
+        if (GS_UNLIKELY(slots_per_sector_ == 0 || sector_count_ < 2)) {
+            return GS_MAKE_ERROR(core::ErrorCode::InvalidParameter);
+        }
+
+        bool found = false;
+        uint32_t newest_seq = 0;
+        size_t newest_slot = 0;
+        valid_records_ = 0;
+        for (size_t slot = 0; slot < total_slots(); ++slot) {
+            uint32_t seq = 0;
+            if (read_record(slot, seq, nullptr)) {
+                ++valid_records_;
+                if (!found || seq > newest_seq) {
+                    found = true;
+                    newest_seq = seq;
+                    newest_slot = slot;
+                }
+            }
+        }
+
+        head_ = found ? (newest_slot + 1) % total_slots() : 0;
+        next_sequence_ = found ? newest_seq + 1 : 1;
+        mounted_ = true;
+        return core::Result<void>{};
+    }
+
+    /**
+     * @brief Persist @p snapshot. Skips slots left dirty by a torn write and
+     * erases the oldest sector when the ring wraps onto it.
+     */
+    core::Result<void> append(const EvidenceSnapshot& snapshot) noexcept
+    {
+        if (GS_UNLIKELY(!mounted_)) {
+            return GS_MAKE_ERROR(core::ErrorCode::SystemNotInitialized);
+        }
+
+        for (size_t attempt = 0; attempt < slots_per_sector_; ++attempt) {
+            if (head_ % slots_per_sector_ == 0) {
+                GS_TRY(prepare_sector(head_ / slots_per_sector_));
+            }
+            auto blank = slot_is_blank(head_);
+            if (blank.is_error()) {
+                return blank.error();
+            }
+            if (blank.value()) {
+                break;
+            }
+            head_ = (head_ + 1) % total_slots();
+        }
+
+        uint8_t record[RECORD_SIZE];
+        const uint32_t magic = JOURNAL_MAGIC;
+        const uint32_t seq = next_sequence_;
+        memcpy(record, &magic, 4);
+        memcpy(record + 4, &seq, 4);
+        memcpy(record + HEADER_SIZE, &snapshot, sizeof(EvidenceSnapshot));
+        auto crc_res = platform_.crypto->crc32(record + 4, RECORD_SIZE - 4 - FOOTER_SIZE);
+        if (crc_res.is_error()) {
+            return crc_res.error();
+        }
+        const uint32_t crc = crc_res.value();
+        memcpy(record + RECORD_SIZE - FOOTER_SIZE, &crc, 4);
+
+        GS_TRY(platform_.storage->write(slot_address(head_), record, RECORD_SIZE).as_void());
+        GS_TRY(platform_.storage->flush());
+
+        head_ = (head_ + 1) % total_slots();
+        ++next_sequence_;
+        return core::Result<void>{};
+    }
+
+    /**
+     * @brief Replay every valid record, oldest first, into @p store.
+     * @return number of snapshots restored
+     */
+    core::Result<size_t> restore(EvidenceStore& store) noexcept
+    {
+        if (GS_UNLIKELY(!mounted_)) {
+            return core::Result<size_t>(GS_MAKE_ERROR(core::ErrorCode::SystemNotInitialized));
+        }
+
+        // Ring order from the head is sequence order
+        size_t restored = 0;
+        EvidenceSnapshot snapshot;
+        for (size_t i = 0; i < total_slots(); ++i) {
+            const size_t slot = (head_ + i) % total_slots();
+            uint32_t seq = 0;
+            if (read_record(slot, seq, &snapshot) && store.restore(snapshot).is_ok()) {
+                ++restored;
+            }
+        }
+        return core::Result<size_t>(restored);
+    }
+
+    /// Valid records found by the last mount().
+    GS_NODISCARD size_t valid_records() const noexcept
+    {
+        return valid_records_;
+    }
+
+    GS_NODISCARD size_t capacity() const noexcept
+    {
+        return total_slots();
+    }
+
+private:
+    GS_NODISCARD size_t total_slots() const noexcept
+    {
+        return slots_per_sector_ * sector_count_;
+    }
+
+    GS_NODISCARD uint32_t slot_address(size_t slot) const noexcept
+    {
+        const size_t sector = slot / slots_per_sector_;
+        const size_t index = slot % slots_per_sector_;
+        return base_ + static_cast<uint32_t>(sector * sector_size_ + index * RECORD_SIZE);
+    }
+
+    /// Erase @p sector unless every slot is already blank. Checking every
+    /// slot (not just the first) also catches a sector left half-erased.
+    core::Result<void> prepare_sector(size_t sector) noexcept
+    {
+        for (size_t i = 0; i < slots_per_sector_; ++i) {
+            auto blank = slot_is_blank(sector * slots_per_sector_ + i);
+            if (blank.is_error()) {
+                return blank.error();
+            }
+            if (!blank.value()) {
+                const uint32_t address = base_ + static_cast<uint32_t>(sector * sector_size_);
+                return platform_.storage->erase(address, sector_size_);
+            }
+        }
+        return core::Result<void>{};
+    }
+
+    /// Erased on either medium: all 0xFF (flash) or all 0x00 (RAM mocks).
+    core::Result<bool> slot_is_blank(size_t slot) noexcept
+    {
+        uint8_t record[RECORD_SIZE];
+        auto read_res = platform_.storage->read(slot_address(slot), record, RECORD_SIZE);
+        if (read_res.is_error()) {
+            return core::Result<bool>(read_res.error());
+        }
+        if (record[0] != 0xFF && record[0] != 0x00) {
+            return core::Result<bool>(false);
+        }
+        for (size_t i = 1; i < RECORD_SIZE; ++i) {
+            if (record[i] != record[0]) {
+                return core::Result<bool>(false);
+            }
+        }
+        return core::Result<bool>(true);
+    }
+
+    bool read_record(size_t slot, uint32_t& seq, EvidenceSnapshot* out) noexcept
+    {
+        uint8_t record[RECORD_SIZE];
+        if (platform_.storage->read(slot_address(slot), record, RECORD_SIZE).is_error()) {
+            return false;
+        }
+        uint32_t magic = 0;
+        memcpy(&magic, record, 4);
+        if (magic != JOURNAL_MAGIC) {
+            return false;
+        }
+        auto crc_res = platform_.crypto->crc32(record + 4, RECORD_SIZE - 4 - FOOTER_SIZE);
+        uint32_t stored_crc = 0;
+        memcpy(&stored_crc, record + RECORD_SIZE - FOOTER_SIZE, 4);
+        if (crc_res.is_error() || crc_res.value() != stored_crc) {
+            return false;
+        }
+        memcpy(&seq, record + 4, 4);
+        if (out != nullptr) {
+            memcpy(out, record + HEADER_SIZE, sizeof(EvidenceSnapshot));
+        }
+        return true;
+    }
+
+    platform::PlatformServices& platform_;
+    uint32_t base_;
+    size_t sector_size_;
+    size_t sector_count_;
+    size_t slots_per_sector_;
+    size_t head_{0};
+    uint32_t next_sequence_{1};
+    size_t valid_records_{0};
+    bool mounted_{false};
+};
+
+} // namespace gridshield::forensics
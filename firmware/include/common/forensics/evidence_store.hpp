@@ -14,6 +14,7 @@
 #pragma once
 
 #include "core/error.hpp"
+#include "core/incremental_job.hpp"
 #include "core/types.hpp"
 #include "forensics/event_logger.hpp"
 #include "utils/gs_macros.hpp"
@@ -158,8 +159,29 @@ public:
         if (count_ < EVIDENCE_STORE_CAPACITY) {
             ++count_;
         }
+        ++generation_;
 
-        return core::Result<void>::ok();
+        return core::Result<void>{};
+    }
+
+    /**
+     * @brief Re-insert a persisted snapshot verbatim (hash and chain link
+     * included), so verify_chain() checks what was originally recorded.
+     * Snapshots must be restored oldest first.
+     */
+    core::Result<void> restore(const EvidenceSnapshot& snapshot) noexcept
+    {
+        if (GS_UNLIKELY(!snapshot.is_valid())) {
+            return GS_MAKE_ERROR(core::ErrorCode::InvalidParameter);
+        }
+        snapshots_[write_index_] = snapshot;
+        write_index_ = (write_index_ + 1) % EVIDENCE_STORE_CAPACITY;
+        if (count_ < EVIDENCE_STORE_CAPACITY) {
+            ++count_;
+        }
+        sequence_ = static_cast<uint8_t>(snapshot.sequence + 1);
+        ++generation_;
+        return core::Result<void>{};
     }
 
     /**
@@ -205,41 +227,57 @@ public:
      */
     GS_NODISCARD bool verify_chain() const noexcept
     {
-        if (count_ == 0) {
-            return true;
-        }
-
         for (size_t i = 0; i < count_; ++i) {
-            auto result = get_evidence(i);
-            if (!result.is_ok()) {
+            if (!verify_entry(i)) {
                 return false;
             }
-            const auto& snap = result.value();
-
-            // Verify this snapshot's own hash
-            EvidenceSnapshot temp = snap;
-            std::memset(temp.hash, 0, EVIDENCE_HASH_SIZE);
-            uint8_t recomputed[EVIDENCE_HASH_SIZE]{};
-            compute_hash_raw(temp, recomputed);
-            if (std::memcmp(recomputed, snap.hash, EVIDENCE_HASH_SIZE) != 0) {
+        }
+        return true;
+    }
+
+    /**
+     * @brief Verify a single entry: its own hash and its link to entry i-1.
+     * Unit of work for ChainVerifyJob; cost is one snapshot hash.
+     */
+    GS_NODISCARD bool verify_entry(size_t index) const noexcept
+    {
+        auto result = get_evidence(index);
+        if (!result.is_ok()) {
+            return false;
+        }
+        const auto& snap = result.value();
+
+        // Verify this snapshot's own hash
+        EvidenceSnapshot temp = snap;
+        std::memset(temp.hash, 0, EVIDENCE_HASH_SIZE);
+        uint8_t recomputed[EVIDENCE_HASH_SIZE]{};
+        compute_hash_raw(temp, recomputed);
+        if (std::memcmp(recomputed, snap.hash, EVIDENCE_HASH_SIZE) != 0) {
+            return false;
+        }
+
+        // Verify chain link (skip first entry which has all-zero prev_hash)
+        if (index > 0) {
+            auto prev_result = get_evidence(index - 1);
+            if (!prev_result.is_ok()) {
                 return false;
             }
-
-            // Verify chain link (skip first entry which has all-zero prev_hash)
-            if (i > 0) {
-                auto prev_result = get_evidence(i - 1);
-                if (!prev_result.is_ok()) {
-                    return false;
-                }
-                if (std::memcmp(snap.prev_hash, prev_result.value().hash, EVIDENCE_HASH_SIZE) !=
-                    0) {
-                    return false;
-                }
+            if (std::memcmp(snap.prev_hash, prev_result.value().hash, EVIDENCE_HASH_SIZE) != 0) {
+                return false;
             }
         }
         return true;
     }
 
+    /**
+     * @brief Bumped on every mutation; lets incremental readers detect
+     * that the ring moved under them.
+     */
+    GS_NODISCARD uint32_t generation() const noexcept
+    {
+        return generation_;
+    }
+
     /**
      * @brief Clear all evidence.
      */
@@ -248,6 +286,7 @@ public:
         count_ = 0;
         write_index_ = 0;
         sequence_ = 0;
+        ++generation_;
         for (auto& snap : snapshots_) {
             snap = EvidenceSnapshot{};
         }
@@ -272,6 +311,78 @@ private:
     size_t write_index_{0};
     size_t count_{0};
     uint8_t sequence_{0};
+    uint32_t generation_{0};
+};
+
+// ============================================================================
+// CHAIN VERIFY JOB — verify_chain() split into one entry per step
+// ============================================================================
+class ChainVerifyJob final : public core::IIncrementalJob
+{
+public:
+    explicit ChainVerifyJob(const EvidenceStore& store) noexcept : store_(store) {}
+
+    core::JobStatus step() noexcept override
+    {
+        // Store mutated since we started: earlier verdicts no longer hold
+        if (started_ && store_.generation() != generation_) {
+            ++restarts_;
+            cursor_ = 0;
+        }
+        if (cursor_ == 0) {
+            generation_ = store_.generation();
+            started_ = true;
+        }
+
+        if (cursor_ >= store_.evidence_count()) {
+            intact_ = true;
+            complete_ = true;
+            return core::JobStatus::Done;
+        }
+        if (!store_.verify_entry(cursor_)) {
+            intact_ = false;
+            complete_ = true;
+            return core::JobStatus::Failed;
+        }
+        ++cursor_;
+        return core::JobStatus::Pending;
+    }
+
+    void reset() noexcept override
+    {
+        cursor_ = 0;
+        started_ = false;
+        complete_ = false;
+        intact_ = false;
+        restarts_ = 0;
+    }
+
+    /// Verdict of the last completed pass (false until one completes).
+    GS_NODISCARD bool is_complete() const noexcept
+    {
+        return complete_;
+    }
+    GS_NODISCARD bool is_intact() const noexcept
+    {
+        return complete_ && intact_;
+    }
+    GS_NODISCARD size_t progress() const noexcept
+    {
+        return cursor_;
+    }
+    GS_NODISCARD uint32_t restarts() const noexcept
+    {
+        return restarts_;
+    }
+
+private:
+    const EvidenceStore& store_;
+    size_t cursor_{0};
+    uint32_t generation_{0};
+    uint32_t restarts_{0};
+    bool started_{false};
+    bool complete_{false};
+    bool intact_{false};
 };
 
 } // namespace gridshield::forensics
@@ -0,0 +1,474 @@
+/**
+ * @file flight_recorder.hpp
+ * @author zuudevs (zuudevs@gmail.com)
+ * @brief Pre-trigger waveform flight recorder for tamper and anomaly events
+ * @version 1.0
+ * @date 2026-03-14
+ *
+ * The acquisition path pushes every WaveformSample into a power-of-two
+ * ring (one store, one increment, one predictable branch). trigger()
+ * marks the event; after post_samples more samples the window
+ * [pre_samples before .. post_samples after] is frozen. The archive job
+ * then compresses it a slice per scheduler step (per-channel delta,
+ * zigzag, varint), keeps it in a small archive and preserves an
+ * EvidenceStore snapshot whose notes carry the window id and hash, so the
+ * waveform is bound into the evidence hash chain.
+ *
+ * While a window is frozen or archiving, new samples are dropped (counted)
+ * and further triggers coalesce into the window being captured.
+ *
+ * Blob format: per sample, per channel (hardware::WAVEFORM_CHANNELS),
+ * zigzag(sample - previous) as a little-endian base-128 varint; the
+ * first sample is delta against zero. decode() reverses it.
+ *
+ * @copyright Copyright (c) 2026
+ */
+
+#pragma once
+
+#include "core/error.hpp"
+#include "core/incremental_job.hpp"
+#include "core/types.hpp"
+#include "forensics/event_logger.hpp"
+#include "forensics/evidence_store.hpp"
+#include "hardware/waveform.hpp"
+#include "utils/gs_macros.hpp"
+
+#include <array>
+#include <cstdint>
+#include <cstring>
+
+namespace gridshield::forensics {
+
+// ============================================================================
+// CONSTANTS
+// ============================================================================
+static constexpr size_t FLIGHT_DEFAULT_CAPACITY = 512; // samples, power of two
+static constexpr size_t FLIGHT_ARCHIVE_SLOTS = 2;
+static constexpr size_t FLIGHT_SAMPLES_PER_STEP = 64; // compression slice
+static constexpr size_t FLIGHT_MAX_BYTES_PER_SAMPLE = hardware::WAVEFORM_CHANNELS * 3;
+static constexpr size_t FLIGHT_NOTE_HASH_BYTES = 8; // hex-encoded into the evidence notes
+
+// ============================================================================
+// TYPES
+// ============================================================================
+enum class FlightState : uint8_t
+{
+    Armed = 0,     // recording into the ring
+    Capturing = 1, // triggered, collecting post-trigger samples
+    Frozen = 2,    // window complete, waiting for the archive job
+    Archiving = 3  // archive job compressing
+};
+
+struct FlightTrigger
+{
+    SecurityEventType type{SecurityEventType::None};
+    SecurityEventSeverity severity{SecurityEventSeverity::High};
+    SourceLayer layer{SourceLayer::Physical};
+    core::timestamp_t timestamp{0};
+
+    GS_CONSTEXPR FlightTrigger() noexcept = default;
+    GS_CONSTEXPR FlightTrigger(SecurityEventType t,
+                               SecurityEventSeverity s,
+                               SourceLayer l,
+                               core::timestamp_t ts) noexcept
+        : type(t), severity(s), layer(l), timestamp(ts)
+    {}
+};
+
+/// One archived, compressed window.
+struct FlightWindow
+{
+    uint32_t id{0}; // 0 = slot unused
+    FlightTrigger trigger{};
+    uint16_t sample_count{0};
+    uint16_t trigger_offset{0}; // index of the first post-trigger sample
+    uint32_t byte_count{0};
+    bool truncated{false};
+    uint8_t hash[EVIDENCE_HASH_SIZE]{};
+};
+
+struct FlightRecorderStats
+{
+    uint32_t dropped_samples{0}; // arrived while a window was frozen
+    uint32_t triggers{0};
+    uint32_t coalesced_triggers{0};
+    uint32_t windows_archived{0};
+    uint32_t raw_bytes{0};
+    uint32_t compressed_bytes{0};
+};
+
+// ============================================================================
+// INTERFACE — what GridShieldSystem needs to drive a recorder
+// ============================================================================
+class IFlightRecorder : public hardware::IWaveformSink
+{
+public:
+    /// Start capturing the post-trigger part of a window.
+    virtual core::Result<void> trigger(const FlightTrigger& info) noexcept = 0;
+
+    /// Background job that compresses and archives a frozen window.
+    virtual core::IIncrementalJob& archive_job() noexcept = 0;
+};
+
+// ============================================================================
+// FLIGHT RECORDER
+// ============================================================================
+
+/**
+ * @tparam Capacity  Ring size in samples (power of two, >= pre + post)
+ * @tparam BlobBytes Compressed bytes kept per archived window
+ */
+template <size_t Capacity = FLIGHT_DEFAULT_CAPACITY,
+          size_t BlobBytes = Capacity * FLIGHT_MAX_BYTES_PER_SAMPLE / 2>
+class FlightRecorder final : public IFlightRecorder
+{
+    static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0,
+                  "Capacity must be a power of two");
+    static_assert(Capacity <= UINT16_MAX, "window sizes are recorded as uint16_t");
+    static_assert(BlobBytes >= FLIGHT_MAX_BYTES_PER_SAMPLE, "blob cannot hold one sample");
+
+public:
+    FlightRecorder() noexcept : job_(*this) {}
+
+    FlightRecorder(const FlightRecorder&) = delete;
+    FlightRecorder& operator=(const FlightRecorder&) = delete;
+
+    core::Result<void>
+    init(EvidenceStore& store, uint16_t pre_samples, uint16_t post_samples) noexcept
+    {
+        if (pre_samples == 0 || static_cast<size_t>(pre_samples) + post_samples > Capacity) {
+            return GS_MAKE_ERROR(core::ErrorCode::InvalidParameter);
+        }
+        store_ = &store;
+        pre_samples_ = pre_samples;
+        post_samples_ = post_samples;
+        head_ = 0;
+        state_ = FlightState::Armed;
+        stats_ = FlightRecorderStats{};
+        for (auto& window : windows_) {
+            window = FlightWindow{};
+        }
+        return core::Result<void>{};
+    }
+
+    // === Hot path ===
+
+    void record(const hardware::WaveformSample& sample) noexcept override
+    {
+        push(sample);
+    }
+
+    /// Steady state: one 10-byte store, one increment, one predicted branch.
+    GS_INLINE void push(const hardware::WaveformSample& sample) noexcept
+    {
+        if (GS_UNLIKELY(state_ >= FlightState::Capturing)) {
+            push_slow(sample);
+            return;
+        }
+        ring_[head_ & MASK] = sample;
+        ++head_;
+    }
+
+    // === Trigger / archive ===
+
+    core::Result<void> trigger(const FlightTrigger& info) noexcept override
+    {
+        if (GS_UNLIKELY(store_ == nullptr)) {
+            return GS_MAKE_ERROR(core::ErrorCode::SystemNotInitialized);
+        }
+        ++stats_.triggers;
+        if (state_ != FlightState::Armed) {
+            ++stats_.coalesced_triggers;
+            return GS_MAKE_ERROR(core::ErrorCode::InvalidState);
+        }
+        if (head_ == 0) {
+            return GS_MAKE_ERROR(core::ErrorCode::InvalidState);
+        }
+
+        pending_.trigger = info;
+        const uint32_t before = head_ < pre_samples_ ? head_ : pre_samples_;
+        window_start_ = head_ - before;
+        pending_.trigger_offset = static_cast<uint16_t>(before);
+        post_remaining_ = post_samples_;
+        state_ = post_samples_ == 0 ? FlightState::Frozen : FlightState::Capturing;
+        return core::Result<void>{};
+    }
+
+    core::IIncrementalJob& archive_job() noexcept override
+    {
+        return job_;
+    }
+
+    // === Accessors ===
+
+    GS_NODISCARD FlightState state() const noexcept
+    {
+        return state_;
+    }
+    GS_NODISCARD const FlightRecorderStats& stats() const noexcept
+    {
+        return stats_;
+    }
+    /// Samples accepted into the ring (wraps at 2^32).
+    GS_NODISCARD uint32_t samples_recorded() const noexcept
+    {
+        return head_;
+    }
+
+    /// Archived window @p age (0 = newest), or nullptr.
+    GS_NODISCARD const FlightWindow* window(size_t age) const noexcept
+    {
+        if (age >= FLIGHT_ARCHIVE_SLOTS || archived_ <= age) {
+            return nullptr;
+        }
+        const size_t slot = (archived_ - 1 - age) % FLIGHT_ARCHIVE_SLOTS;
+        return &windows_[slot];
+    }
+    GS_NODISCARD const uint8_t* window_data(size_t age) const noexcept
+    {
+        if (window(age) == nullptr) {
+            return nullptr;
+        }
+        return blobs_[(archived_ - 1 - age) % FLIGHT_ARCHIVE_SLOTS].data();
+    }
+
+    /**
+     * @brief Expand a compressed window.
+     * @return Samples written to @p out (stops at @p max_samples).
+     */
+    static core::Result<size_t> decode(const uint8_t* blob,
+                                       size_t length,
+                                       hardware::WaveformSample* out,
+                                       size_t max_samples) noexcept
+    {
+        if (blob == nullptr || out == nullptr) {
+            return core::Result<size_t>{GS_MAKE_ERROR(core::ErrorCode::InvalidParameter)};
+        }
+        int32_t prev[hardware::WAVEFORM_CHANNELS]{};
+        size_t pos = 0;
+        size_t count = 0;
+        while (pos < length && count < max_samples) {
+            for (size_t ch = 0; ch < hardware::WAVEFORM_CHANNELS; ++ch) {
+                uint32_t zz = 0;
+                uint32_t shift = 0;
+                uint8_t byte = 0;
+                do {
+                    if (pos >= length || shift > 28) {
+                        return core::Result<size_t>{GS_MAKE_ERROR(core::ErrorCode::DataInvalid)};
+                    }
+                    byte = blob[pos++];
+                    zz |= static_cast<uint32_t>(byte & 0x7FU) << shift;
+                    shift += 7;
+                } while ((byte & 0x80U) != 0);
+                const auto delta = static_cast<int32_t>((zz >> 1) ^ (0U - (zz & 1U)));
+                prev[ch] += delta;
+                out[count].set_channel(ch, prev[ch]);
+            }
+            ++count;
+        }
+        return core::Result<size_t>{count};
+    }
+
+private:
+    static constexpr uint32_t MASK = static_cast<uint32_t>(Capacity - 1);
+
+    class ArchiveJob final : public core::IIncrementalJob
+    {
+    public:
+        explicit ArchiveJob(FlightRecorder& owner) noexcept : owner_(owner) {}
+
+        core::JobStatus step() noexcept override
+        {
+            return owner_.archive_step();
+        }
+        void reset() noexcept override {}
+
+    private:
+        FlightRecorder& owner_;
+    };
+
+    GS_NOINLINE void push_slow(const hardware::WaveformSample& sample) noexcept
+    {
+        if (state_ != FlightState::Capturing) {
+            ++stats_.dropped_samples; // window frozen: keep it intact
+            return;
+        }
+        ring_[head_ & MASK] = sample;
+        ++head_;
+        if (--post_remaining_ == 0) {
+            state_ = FlightState::Frozen;
+        }
+    }
+
+    core::JobStatus archive_step() noexcept
+    {
+        if (state_ == FlightState::Armed) {
+            return core::JobStatus::Done; // nothing to do (e.g. resubmitted)
+        }
+        if (state_ == FlightState::Capturing) {
+            return core::JobStatus::Pending; // post-trigger samples still arriving
+        }
+        if (state_ == FlightState::Frozen) {
+            begin_archive();
+        }
+
+        // Compress one slice
+        const size_t slot = archived_ % FLIGHT_ARCHIVE_SLOTS;
+        uint8_t* blob = blobs_[slot].data();
+        const uint32_t total = head_ - window_start_;
+        size_t budget = FLIGHT_SAMPLES_PER_STEP;
+        while (encoded_ < total && budget-- > 0) {
+            if (out_pos_ + FLIGHT_MAX_BYTES_PER_SAMPLE > BlobBytes) {
+                pending_.truncated = true;
+                break;
+            }
+            const hardware::WaveformSample& sample = ring_[(window_start_ + encoded_) & MASK];
+            for (size_t ch = 0; ch < hardware::WAVEFORM_CHANNELS; ++ch) {
+                const int32_t value = sample.channel(ch);
+                const int32_t delta = value - prev_[ch];
+                prev_[ch] = value;
+                uint32_t zz = (static_cast<uint32_t>(delta) << 1) ^
+                              static_cast<uint32_t>(delta >> 31);
+                while (zz >= 0x80U) {
+                    blob[out_pos_++] = static_cast<uint8_t>(zz | 0x80U);
+                    zz >>= 7;
+                }
+                blob[out_pos_++] = static_cast<uint8_t>(zz);
+            }
+            ++encoded_;
+        }
+        if (encoded_ < total && !pending_.truncated) {
+            return core::JobStatus::Pending;
+        }
+
+        return finish_archive(slot) ? core::JobStatus::Done : core::JobStatus::Failed;
+    }
+
+    void begin_archive() noexcept
+    {
+        state_ = FlightState::Archiving;
+        encoded_ = 0;
+        out_pos_ = 0;
+        pending_.truncated = false;
+        for (auto& p : prev_) {
+            p = 0;
+        }
+    }
+
+    bool finish_archive(size_t slot) noexcept
+    {
+        FlightWindow& window = windows_[slot];
+        window = pending_;
+        window.id = ++next_id_;
+        window.sample_count = static_cast<uint16_t>(encoded_);
+        window.byte_count = static_cast<uint32_t>(out_pos_);
+        detail::evidence_hash(blobs_[slot].data(), out_pos_, window.hash);
+        ++archived_;
+
+        stats_.windows_archived++;
+        stats_.raw_bytes += encoded_ * static_cast<uint32_t>(sizeof(hardware::WaveformSample));
+        stats_.compressed_bytes += static_cast<uint32_t>(out_pos_);
+
+        // Evidence snapshot at the trigger sample, linked to the blob by hash
+        const hardware::WaveformSample& at = ring_[(window_start_ + window.trigger_offset -
+                                                    (window.trigger_offset > 0 ? 1U : 0U)) &
+                                                   MASK];
+        SensorSnapshot sensors;
+        sensors.voltage_mv = static_cast<uint32_t>(at.voltage_dv) * 100U;
+        sensors.current_ma = static_cast<uint32_t>(at.current_ca < 0 ? 0 : at.current_ca) * 10U;
+        sensors.accelerometer_mg = peak_accel_mg(at);
+
+        char notes[EVIDENCE_NOTES_MAX];
+        format_notes(window, notes);
+        const auto preserved = store_->preserve(window.trigger.type,
+                                                window.trigger.severity,
+                                                window.trigger.layer,
+                                                window.trigger.timestamp,
+                                                sensors,
+                                                notes);
+        state_ = FlightState::Armed;
+        return preserved.is_ok();
+    }
+
+    static uint16_t peak_accel_mg(const hardware::WaveformSample& s) noexcept
+    {
+        int32_t peak = 0;
+        for (size_t ch = 2; ch < hardware::WAVEFORM_CHANNELS; ++ch) {
+            const int32_t v = s.channel(ch) < 0 ? -s.channel(ch) : s.channel(ch);
+            peak = v > peak ? v : peak;
+        }
+        return static_cast<uint16_t>(peak);
+    }
+
+    /// "wf <id> n<samples> t<offset> h<16 hex>" (+ " trunc")
+    static void format_notes(const FlightWindow& window, char out[EVIDENCE_NOTES_MAX]) noexcept
+    {
+        static constexpr char HEX[] = "0123456789abcdef";
+        size_t pos = 0;
+        auto put = [&](char c) {
+            if (pos < EVIDENCE_NOTES_MAX - 1) {
+                out[pos++] = c;
+            }
+        };
+        auto put_u32 = [&](uint32_t v) {
+            char digits[10];
+            size_t n = 0;
+            do {
+                digits[n++] = static_cast<char>('0' + v % 10U);
+                v /= 10U;
+            } while (v != 0 && n < sizeof(digits));
+            while (n > 0) {
+                put(digits[--n]);
+            }
+        };
+
+        put('w');
+        put('f');
+        put(' ');
+        put_u32(window.id);
+        put(' ');
+        put('n');
+        put_u32(window.sample_count);
+        put(' ');
+        put('t');
+        put_u32(window.trigger_offset);
+        put(' ');
+        put('h');
+        for (size_t i = 0; i < FLIGHT_NOTE_HASH_BYTES; ++i) {
+            put(HEX[window.hash[i] >> 4]);
+            put(HEX[window.hash[i] & 0x0F]);
+        }
+        if (window.truncated) {
+            for (const char c : " trunc") {
+                if (c != '\0') {
+                    put(c);
+                }
+            }
+        }
+        out[pos] = '\0';
+    }
+
+    std::array<hardware::WaveformSample, Capacity> ring_{};
+    std::array<std::array<uint8_t, BlobBytes>, FLIGHT_ARCHIVE_SLOTS> blobs_{};
+    std::array<FlightWindow, FLIGHT_ARCHIVE_SLOTS> windows_{};
+    EvidenceStore* store_{nullptr};
+    ArchiveJob job_;
+
+    uint32_t head_{0}; // total samples pushed (ring index = head_ & MASK)
+    FlightState state_{FlightState::Armed};
+    uint16_t pre_samples_{0};
+    uint16_t post_samples_{0};
+    uint32_t post_remaining_{0};
+    uint32_t window_start_{0};
+    FlightWindow pending_{};
+
+    uint32_t encoded_{0};
+    size_t out_pos_{0};
+    int32_t prev_[hardware::WAVEFORM_CHANNELS]{};
+    uint32_t archived_{0};
+    uint32_t next_id_{0};
+    FlightRecorderStats stats_{};
+};
+
+} // namespace gridshield::forensics
@@ -0,0 +1,473 @@
+/**
+ * @file adaptive_sampling.hpp
+ * @author zuudevs (zuudevs@gmail.com)
+ * @brief Adaptive acquisition rate: idle slowly, burst on suspected tamper
+ * @version 1.0
+ * @date 2026-03-26
+ *
+ * A fixed cadence is a bad trade either way: fast sampling all the time
+ * costs power, slow sampling smooths a short bypass or magnet event away
+ * before the detectors see it. The controller idles at a low rate and
+ * escalates to a burst profile (short reading interval, MPU6050 at full
+ * ODR, short three-phase windows) on cheap triggers: a tamper pin edge
+ * before debounce confirms it, a sudden current or power step, a
+ * temperature jump or a shock. It leaves the burst only after a minimum
+ * dwell and a run of settled readings, then stretches the interval back
+ * to idle over a decay period, so a flapping trigger cannot make the
+ * profile oscillate.
+ *
+ * The controller only decides cadence; whether a new level is theft
+ * stays with the consumption detector and the phase rules.
+ *
+ * @copyright Copyright (c) 2026
+ */
+
+#pragma once
+
+#include "analytics/time_series.hpp"
+#include "core/error.hpp"
+#include "core/types.hpp"
+#include "hardware/sensors/three_phase.hpp"
+#include "utils/fixed_point.hpp"
+
+#include <array>
+#include <cstdint>
+
+namespace gridshield::hardware {
+
+// ============================================================================
+// ADAPTIVE SAMPLING CONSTANTS
+// ============================================================================
+static constexpr uint32_t SAMPLING_IDLE_INTERVAL_MS = 5000; // SystemConfig reading interval
+static constexpr uint32_t SAMPLING_BURST_INTERVAL_MS = 250;
+static constexpr uint8_t SAMPLING_IDLE_MPU_DIVIDER = 99;  // 1 kHz / 100 = 10 Hz
+static constexpr uint8_t SAMPLING_BURST_MPU_DIVIDER = 0;  // full 1 kHz ODR
+static constexpr uint16_t SAMPLING_BURST_ROUNDS = 384;    // >= 2 cycles at ~7 kS/s per channel
+static constexpr uint32_t SAMPLING_MIN_INTERVAL_MS = 10;
+
+// Power model defaults: sleep floor plus per-profile front-end draw and a
+// charge per reading (ADC window + CPU). Estimates, override per board.
+static constexpr uint32_t SAMPLING_BASE_DRAW_UA = 2000;  // light sleep + radio DTIM
+static constexpr uint32_t SAMPLING_IDLE_ACTIVE_UA = 500;  // MPU6050 at low ODR
+static constexpr uint32_t SAMPLING_BURST_ACTIVE_UA = 3900; // MPU6050 accel + gyro at full ODR
+static constexpr uint32_t SAMPLING_IDLE_READING_UC = 1000;  // 40 mA for a 512-round window
+static constexpr uint32_t SAMPLING_BURST_READING_UC = 750;  // 384-round window
+
+// ============================================================================
+// MODES, TRIGGERS AND PROFILES
+// ============================================================================
+enum class SamplingMode : uint8_t
+{
+    Idle = 0,
+    Burst = 1,
+    Decay = 2 // interval stretching back from burst to idle
+};
+
+static constexpr size_t SAMPLING_MODE_COUNT = 3;
+
+enum class SamplingTrigger : uint8_t
+{
+    None = 0,
+    TamperEdge = 1,       // tamper pin interrupt, before debounce
+    SuddenDelta = 2,      // current or power stepped away from its baseline
+    TemperatureSpike = 3, // terminal temperature jumped (loose or bypassed contact)
+    Shock = 4             // MPU6050 threshold exceeded
+};
+
+static constexpr size_t SAMPLING_TRIGGER_COUNT = 5;
+
+struct SamplingProfile
+{
+    uint32_t interval_ms{SAMPLING_IDLE_INTERVAL_MS};
+    uint16_t three_phase_rounds{sensors::THREE_PHASE_DEFAULT_ROUNDS};
+    uint8_t mpu_rate_divider{SAMPLING_IDLE_MPU_DIVIDER};
+    uint8_t reserved{};
+    uint32_t active_ua{SAMPLING_IDLE_ACTIVE_UA};   // continuous draw on top of the floor
+    uint32_t reading_uc{SAMPLING_IDLE_READING_UC}; // charge per reading
+
+    GS_CONSTEXPR SamplingProfile() noexcept = default;
+};
+
+GS_NODISCARD GS_CONSTEXPR SamplingProfile burst_sampling_profile() noexcept
+{
+    SamplingProfile profile;
+    profile.interval_ms = SAMPLING_BURST_INTERVAL_MS;
+    profile.three_phase_rounds = SAMPLING_BURST_ROUNDS;
+    profile.mpu_rate_divider = SAMPLING_BURST_MPU_DIVIDER;
+    profile.active_ua = SAMPLING_BURST_ACTIVE_UA;
+    profile.reading_uc = SAMPLING_BURST_READING_UC;
+    return profile;
+}
+
+struct AdaptiveSamplingConfig
+{
+    bool enabled{false};
+    SamplingProfile idle{};
+    SamplingProfile burst{burst_sampling_profile()};
+    uint32_t base_draw_ua{SAMPLING_BASE_DRAW_UA};
+
+    uint16_t delta_trigger_permille{250}; // step of >= 25% from the baseline escalates
+    uint16_t delta_settle_permille{100};  // reading-to-reading change <= 10% counts as settled
+    uint32_t delta_floor_ma{500};         // ignore current steps below 0.5 A
+    uint32_t delta_floor_mw{100000};      // ... and power steps below 100 W
+    int16_t temperature_spike_c10{50};    // 5 C above the learned terminal temperature
+    uint16_t baseline_half_life{8};       // idle readings
+
+    uint32_t min_burst_ms{10000};
+    uint8_t settle_readings{8};
+    uint32_t decay_ms{30000};
+
+    GS_CONSTEXPR AdaptiveSamplingConfig() noexcept = default;
+};
+
+/// What the controller looks at per reading (see SensorManager::to_sampling_observation)
+struct SamplingObservation
+{
+    uint32_t current_ma{};
+    uint32_t power_mw{};
+    int16_t temperature_c10{};
+    bool temperature_valid{false};
+    bool shock_detected{false};
+
+    GS_CONSTEXPR SamplingObservation() noexcept = default;
+};
+
+struct SamplingStats
+{
+    std::array<uint64_t, SAMPLING_MODE_COUNT> time_in_mode_ms{};
+    std::array<uint32_t, SAMPLING_TRIGGER_COUNT> triggers{};
+    uint64_t charge_nc{}; // uA x ms
+    uint32_t readings{};
+    uint32_t escalations{};
+    core::timestamp_t last_escalation{};
+    SamplingTrigger last_trigger{SamplingTrigger::None};
+
+    GS_CONSTEXPR SamplingStats() noexcept = default;
+
+    GS_NODISCARD uint64_t elapsed_ms() const noexcept
+    {
+        uint64_t total = 0;
+        for (uint64_t ms : time_in_mode_ms) {
+            total += ms;
+        }
+        return total;
+    }
+
+    /// Modelled average supply current since initialize()
+    GS_NODISCARD uint32_t average_ua() const noexcept
+    {
+        const uint64_t elapsed = elapsed_ms();
+        return elapsed == 0 ? 0 : static_cast<uint32_t>(charge_nc / elapsed);
+    }
+};
+
+// ============================================================================
+// ADAPTIVE SAMPLER
+// ============================================================================
+class AdaptiveSampler
+{
+public:
+    AdaptiveSampler() noexcept = default;
+
+    core::Result<void> initialize(const AdaptiveSamplingConfig& config,
+                                  core::timestamp_t now) noexcept
+    {
+        if (GS_UNLIKELY(config.idle.interval_ms < SAMPLING_MIN_INTERVAL_MS ||
+                        config.burst.interval_ms < SAMPLING_MIN_INTERVAL_MS ||
+                        config.burst.interval_ms > config.idle.interval_ms ||
+                        config.delta_settle_permille > config.delta_trigger_permille ||
+                        config.settle_readings == 0)) {
+            return GS_MAKE_ERROR(core::ErrorCode::InvalidParameter);
+        }
+        config_ = config;
+        alpha_ = analytics::ema_alpha_for_half_life(config.baseline_half_life);
+        stats_ = SamplingStats{};
+        mode_ = SamplingMode::Idle;
+        tamper_edge_ = false;
+        profile_changed_ = false;
+        baseline_valid_ = false;
+        temperature_valid_ = false;
+        last_accounted_ = now;
+        last_reading_ = now;
+        mode_since_ = now;
+        last_trigger_time_ = now;
+        settled_ = 0;
+        initialized_ = true;
+        return core::Result<void>{};
+    }
+
+    /**
+     * @brief Report a tamper pin edge. ISR-safe: only sets a flag that
+     *        poll() turns into an escalation.
+     */
+    void notify_tamper() noexcept
+    {
+        tamper_edge_ = true;
+    }
+
+    /**
+     * @brief Advance timers: act on a pending tamper edge and finish the
+     *        decay. Call once per cycle before due().
+     */
+    void poll(core::timestamp_t now) noexcept
+    {
+        if (GS_UNLIKELY(!initialized_)) {
+            return;
+        }
+        account(now);
+        if (tamper_edge_) {
+            tamper_edge_ = false;
+            if (config_.enabled) {
+                escalate(SamplingTrigger::TamperEdge, now);
+            }
+        }
+        if (mode_ == SamplingMode::Decay && now - mode_since_ >= config_.decay_ms) {
+            enter(SamplingMode::Idle, now);
+        }
+    }
+
+    GS_NODISCARD bool due(core::timestamp_t now) const noexcept
+    {
+        return now - last_reading_ >= interval_ms(now);
+    }
+
+    /**
+     * @brief Feed one reading; returns the trigger it raised, if any.
+     *
+     * Idle and decay compare against baselines learned while idle, so a
+     * sustained step keeps escalating only until the burst has watched it
+     * settle. A burst re-arms on tamper edges and shocks; the step that
+     * started it only has to settle reading-to-reading before the
+     * baselines are re-seeded at the new level.
+     */
+    SamplingTrigger observe(const SamplingObservation& obs, core::timestamp_t now) noexcept
+    {
+        if (GS_UNLIKELY(!initialized_)) {
+            return SamplingTrigger::None;
+        }
+        account(now);
+        stats_.charge_nc += static_cast<uint64_t>(current_profile().reading_uc) * 1000U;
+        ++stats_.readings;
+        last_reading_ = now;
+
+        SamplingTrigger trigger = SamplingTrigger::None;
+        if (obs.shock_detected) {
+            trigger = SamplingTrigger::Shock;
+        } else if (mode_ != SamplingMode::Burst) {
+            trigger = baseline_trigger(obs);
+        }
+
+        if (!config_.enabled) {
+            trigger = SamplingTrigger::None;
+        } else if (trigger != SamplingTrigger::None) {
+            escalate(trigger, now);
+        } else if (mode_ == SamplingMode::Burst) {
+            if (!settled(obs)) {
+                settled_ = 0;
+            } else if (settled_ < UINT8_MAX) {
+                ++settled_;
+            }
+            if (settled_ >= config_.settle_readings &&
+                now - last_trigger_time_ >= config_.min_burst_ms) {
+                reseed(obs);
+                enter(SamplingMode::Decay, now);
+            }
+        }
+
+        if (mode_ == SamplingMode::Idle) {
+            learn(obs);
+        }
+        remember(obs);
+        return trigger;
+    }
+
+    /// Reading interval in effect at @p now (decay interpolates burst -> idle)
+    GS_NODISCARD uint32_t interval_ms(core::timestamp_t now) const noexcept
+    {
+        switch (mode_) {
+            case SamplingMode::Burst:
+                return config_.burst.interval_ms;
+            case SamplingMode::Decay: {
+                const uint64_t elapsed = now - mode_since_;
+                if (config_.decay_ms == 0 || elapsed >= config_.decay_ms) {
+                    return config_.idle.interval_ms;
+                }
+                const uint32_t span = config_.idle.interval_ms - config_.burst.interval_ms;
+                return config_.burst.interval_ms +
+                       static_cast<uint32_t>(span * elapsed / config_.decay_ms);
+            }
+            case SamplingMode::Idle:
+            default:
+                return config_.idle.interval_ms;
+        }
+    }
+
+    /// Front-end settings for the current mode; decay keeps the cadence
+    /// elevated but already runs the idle front end
+    GS_NODISCARD const SamplingProfile& current_profile() const noexcept
+    {
+        return mode_ == SamplingMode::Burst ? config_.burst : config_.idle;
+    }
+
+    /// True once after every change of current_profile()
+    GS_NODISCARD bool take_profile_change() noexcept
+    {
+        const bool changed = profile_changed_;
+        profile_changed_ = false;
+        return changed;
+    }
+
+    GS_NODISCARD SamplingMode mode() const noexcept
+    {
+        return mode_;
+    }
+
+    GS_NODISCARD const SamplingStats& stats() const noexcept
+    {
+        return stats_;
+    }
+
+    GS_NODISCARD bool is_enabled() const noexcept
+    {
+        return initialized_ && config_.enabled;
+    }
+
+private:
+    static uint32_t abs_diff(uint32_t a, uint32_t b) noexcept
+    {
+        return a > b ? a - b : b - a;
+    }
+
+    static bool
+    beyond(uint32_t value, uint32_t reference, uint16_t permille, uint32_t floor) noexcept
+    {
+        const uint64_t relative = static_cast<uint64_t>(reference) * permille / 1000U;
+        const uint64_t limit = relative > floor ? relative : floor;
+        return abs_diff(value, reference) > limit;
+    }
+
+    GS_NODISCARD SamplingTrigger baseline_trigger(const SamplingObservation& obs) const noexcept
+    {
+        if (obs.temperature_valid && temperature_valid_ &&
+            obs.temperature_c10 - base_temperature_c10_ >= config_.temperature_spike_c10) {
+            return SamplingTrigger::TemperatureSpike;
+        }
+        if (baseline_valid_ &&
+            (beyond(obs.current_ma,
+                    static_cast<uint32_t>(base_current_ma_),
+                    config_.delta_trigger_permille,
+                    config_.delta_floor_ma) ||
+             beyond(obs.power_mw,
+                    static_cast<uint32_t>(base_power_mw_),
+                    config_.delta_trigger_permille,
+                    config_.delta_floor_mw))) {
+            return SamplingTrigger::SuddenDelta;
+        }
+        return SamplingTrigger::None;
+    }
+
+    GS_NODISCARD bool settled(const SamplingObservation& obs) const noexcept
+    {
+        return !beyond(obs.current_ma,
+                       prev_current_ma_,
+                       config_.delta_settle_permille,
+                       config_.delta_floor_ma) &&
+               !beyond(obs.power_mw,
+                       prev_power_mw_,
+                       config_.delta_settle_permille,
+                       config_.delta_floor_mw);
+    }
+
+    void escalate(SamplingTrigger trigger, core::timestamp_t now) noexcept
+    {
+        ++stats_.triggers[static_cast<size_t>(trigger)];
+        stats_.last_trigger = trigger;
+        last_trigger_time_ = now;
+        settled_ = 0;
+        if (mode_ != SamplingMode::Burst) {
+            ++stats_.escalations;
+            stats_.last_escalation = now;
+            enter(SamplingMode::Burst, now);
+        }
+    }
+
+    void enter(SamplingMode mode, core::timestamp_t now) noexcept
+    {
+        // Decay and idle share the idle front end
+        if ((mode == SamplingMode::Burst) != (mode_ == SamplingMode::Burst)) {
+            profile_changed_ = true;
+        }
+        mode_ = mode;
+        mode_since_ = now;
+    }
+
+    void account(core::timestamp_t now) noexcept
+    {
+        if (now <= last_accounted_) {
+            return;
+        }
+        const uint64_t elapsed = now - last_accounted_;
+        const uint64_t draw = uint64_t{config_.base_draw_ua} + current_profile().active_ua;
+        stats_.time_in_mode_ms[static_cast<size_t>(mode_)] += elapsed;
+        stats_.charge_nc += draw * elapsed;
+        last_accounted_ = now;
+    }
+
+    void learn(const SamplingObservation& obs) noexcept
+    {
+        const auto current = static_cast<int32_t>(obs.current_ma);
+        const auto power = static_cast<int32_t>(obs.power_mw);
+        if (!baseline_valid_) {
+            reseed(obs);
+            return;
+        }
+        base_current_ma_ = utils::lerp(base_current_ma_, current, alpha_);
+        base_power_mw_ = utils::lerp(base_power_mw_, power, alpha_);
+        if (obs.temperature_valid) {
+            base_temperature_c10_ =
+                temperature_valid_
+                    ? utils::lerp(base_temperature_c10_, obs.temperature_c10, alpha_)
+                    : obs.temperature_c10;
+            temperature_valid_ = true;
+        }
+    }
+
+    void reseed(const SamplingObservation& obs) noexcept
+    {
+        base_current_ma_ = static_cast<int32_t>(obs.current_ma);
+        base_power_mw_ = static_cast<int32_t>(obs.power_mw);
+        baseline_valid_ = true;
+        if (obs.temperature_valid) {
+            base_temperature_c10_ = obs.temperature_c10;
+            temperature_valid_ = true;
+        }
+    }
+
+    void remember(const SamplingObservation& obs) noexcept
+    {
+        prev_current_ma_ = obs.current_ma;
+        prev_power_mw_ = obs.power_mw;
+    }
+
+    AdaptiveSamplingConfig config_{};
+    analytics::EmaAlpha alpha_{analytics::EmaAlpha::one()};
+    SamplingStats stats_{};
+    SamplingMode mode_{SamplingMode::Idle};
+    volatile bool tamper_edge_{false}; // set from ISR context
+    bool profile_changed_{false};
+    bool baseline_valid_{false};
+    bool temperature_valid_{false};
+    bool initialized_{false};
+    uint8_t settled_{0};
+    int32_t base_current_ma_{};
+    int32_t base_power_mw_{};
+    int32_t base_temperature_c10_{};
+    uint32_t prev_current_ma_{};
+    uint32_t prev_power_mw_{};
+    core::timestamp_t last_accounted_{};
+    core::timestamp_t last_reading_{};
+    core::timestamp_t mode_since_{};
+    core::timestamp_t last_trigger_time_{};
+};
+
+} // namespace gridshield::hardware
@@ -7,7 +7,8 @@
  *
  * Coordinates all sensor drivers, aggregates readings into
  * a unified SensorData struct, and converts to MeterReading
- * for the core system pipeline.
+ * for the core system pipeline. Three-phase installations use
+ * read_three_phase() for the per-phase record instead.
  *
  * @copyright Copyright (c) 2026
  */
@@ -16,12 +17,16 @@
 
 #include "core/error.hpp"
 #include "core/types.hpp"
+#include "hardware/adaptive_sampling.hpp"
 #include "hardware/sensors/acs712.hpp"
 #include "hardware/sensors/ds18b20.hpp"
 #include "hardware/sensors/mpu6050.hpp"
 #include "hardware/sensors/pzem004t.hpp"
+#include "hardware/sensors/three_phase.hpp"
 #include "hardware/sensors/zmpt101b.hpp"
+#include "hardware/waveform.hpp"
 #include "platform/platform.hpp"
+#include "platform/static_platform.hpp"
 
 #include <cstdint>
 
@@ -56,23 +61,41 @@ struct SensorManagerConfig
     bool enable_pzem004t{false};
     bool enable_ds18b20{false};
     bool enable_mpu6050{false};
+    bool enable_three_phase{false};
 
     sensors::ACS712Config acs712_config{};
     sensors::ZMPT101BConfig zmpt101b_config{};
     sensors::PzemConfig pzem_config{};
     sensors::DS18B20Config ds18b20_config{};
     sensors::MPU6050Config mpu6050_config{};
+    sensors::ThreePhaseConfig three_phase_config{};
 
     GS_CONSTEXPR SensorManagerConfig() noexcept = default;
+
+    GS_NODISCARD GS_CONSTEXPR bool any_enabled() const noexcept
+    {
+        return enable_acs712 || enable_zmpt101b || enable_pzem004t || enable_ds18b20 ||
+               enable_mpu6050 || enable_three_phase;
+    }
 };
 
 // ============================================================================
 // SENSOR MANAGER
 // ============================================================================
-class SensorManager
+
+/**
+ * @tparam Platform HAL policy (platform::StaticPlatform). Analog drivers are
+ *         bound to Platform::Adc; the digital buses stay virtual since they
+ *         are not per-sample paths.
+ */
+template <typename Platform = platform::DefaultPlatform> class SensorManagerT
 {
 public:
-    SensorManager() noexcept = default;
+    using Adc = typename Platform::Adc;
+    using Time = typename Platform::Time;
+    using ThreePhaseSampler = sensors::ThreePhaseSamplerT<Adc, Time>;
+
+    SensorManagerT() noexcept = default;
 
     /**
      * @brief Initialize all enabled sensors.
@@ -82,15 +105,39 @@ public:
     {
         config_ = config;
 
+        // A static policy only binds the objects its StaticPlatformServices registered
+        const bool analog =
+            config_.enable_acs712 || config_.enable_zmpt101b || config_.enable_three_phase;
+        if (analog && platform.adc != nullptr &&
+            !gridshield::platform::is_bound<Adc>(*platform.adc)) {
+            return GS_MAKE_ERROR(core::ErrorCode::InvalidParameter);
+        }
+        if (config_.enable_three_phase && platform.time != nullptr &&
+            !gridshield::platform::is_bound<Time>(*platform.time)) {
+            return GS_MAKE_ERROR(core::ErrorCode::InvalidParameter);
+        }
+
         if (config_.enable_acs712 && platform.adc != nullptr) {
-            auto result = acs712_.init(*platform.adc, config_.acs712_config);
+            auto result = acs712_.init(gridshield::platform::bind<Adc>(*platform.adc),
+                                       config_.acs712_config);
             if (result.is_error()) {
                 return result;
             }
         }
 
         if (config_.enable_zmpt101b && platform.adc != nullptr) {
-            auto result = zmpt101b_.init(*platform.adc, config_.zmpt101b_config);
+            auto result = zmpt101b_.init(gridshield::platform::bind<Adc>(*platform.adc),
+                                         config_.zmpt101b_config);
+            if (result.is_error()) {
+                return result;
+            }
+        }
+
+        if (config_.enable_three_phase && platform.adc != nullptr && platform.time != nullptr) {
+            auto result =
+                three_phase_.init(gridshield::platform::bind<Adc>(*platform.adc),
+                                  gridshield::platform::bind<Time>(*platform.time),
+                                  config_.three_phase_config);
             if (result.is_error()) {
                 return result;
             }
@@ -195,9 +242,30 @@ public:
             }
         }
 
+        if (waveform_sink_ != nullptr) {
+            waveform_sink_->record(to_waveform_sample(data));
+        }
+
         return core::Result<SensorData>{data};
     }
 
+    /**
+     * @brief Sample one three-phase window and pack it into the compact record.
+     */
+    core::Result<core::ThreePhaseReading> read_three_phase(core::timestamp_t timestamp) noexcept
+    {
+        if (GS_UNLIKELY(!initialized_ || !three_phase_.is_initialized())) {
+            return core::Result<core::ThreePhaseReading>{
+                GS_MAKE_ERROR(core::ErrorCode::SystemNotInitialized)};
+        }
+        auto result = three_phase_.sample();
+        if (result.is_error()) {
+            return core::Result<core::ThreePhaseReading>{result.error()};
+        }
+        return core::Result<core::ThreePhaseReading>{
+            ThreePhaseSampler::to_reading(result.value(), timestamp, three_phase_.energy_wh())};
+    }
+
     /**
      * @brief Convert SensorData to a MeterReading for the core pipeline.
      */
@@ -213,6 +281,65 @@ public:
         return reading;
     }
 
+    /**
+     * @brief Pack SensorData into the 10-byte waveform form (saturating).
+     */
+    static WaveformSample to_waveform_sample(const SensorData& data) noexcept
+    {
+        static constexpr uint32_t MV_PER_DV = 100;
+        static constexpr uint32_t MA_PER_CA = 10;
+        const uint32_t dv = data.voltage_mv / MV_PER_DV;
+        const uint32_t ca = data.current_ma / MA_PER_CA;
+
+        WaveformSample sample;
+        sample.voltage_dv = static_cast<uint16_t>(dv <= UINT16_MAX ? dv : UINT16_MAX);
+        sample.current_ca = static_cast<int16_t>(ca <= INT16_MAX ? ca : INT16_MAX);
+        sample.accel_x_mg = data.accel_x_mg;
+        sample.accel_y_mg = data.accel_y_mg;
+        sample.accel_z_mg = data.accel_z_mg;
+        return sample;
+    }
+
+    /**
+     * @brief Reduce SensorData to the inputs of the adaptive sampler.
+     */
+    GS_NODISCARD SamplingObservation to_sampling_observation(const SensorData& data) const noexcept
+    {
+        SamplingObservation obs;
+        obs.current_ma = data.current_ma;
+        obs.power_mw = data.power_mw;
+        obs.temperature_c10 = data.temperature_c10;
+        obs.temperature_valid = ds18b20_.is_initialized();
+        obs.shock_detected = data.shock_detected;
+        return obs;
+    }
+
+    /**
+     * @brief Switch the front end to @p profile: MPU6050 output data rate
+     *        and three-phase window length. Absent sensors are skipped.
+     */
+    core::Result<void> apply_sampling_profile(const SamplingProfile& profile) noexcept
+    {
+        if (GS_UNLIKELY(!initialized_)) {
+            return GS_MAKE_ERROR(core::ErrorCode::SystemNotInitialized);
+        }
+        if (mpu6050_.is_initialized()) {
+            GS_TRY(mpu6050_.set_sample_rate_divider(profile.mpu_rate_divider));
+        }
+        if (three_phase_.is_initialized()) {
+            GS_TRY(three_phase_.set_rounds(profile.three_phase_rounds));
+        }
+        return core::Result<void>{};
+    }
+
+    /**
+     * @brief Receive every sample read_all() acquires (nullptr to detach).
+     */
+    void set_waveform_sink(IWaveformSink* sink) noexcept
+    {
+        waveform_sink_ = sink;
+    }
+
     GS_NODISCARD bool is_initialized() const noexcept
     {
         return initialized_;
@@ -220,12 +347,16 @@ public:
 
 private:
     SensorManagerConfig config_{};
-    sensors::ACS712Driver acs712_;
-    sensors::ZMPT101BDriver zmpt101b_;
+    sensors::ACS712DriverT<Adc> acs712_;
+    sensors::ZMPT101BDriverT<Adc> zmpt101b_;
     sensors::PZEM004TDriver pzem_;
     sensors::DS18B20Driver ds18b20_;
     sensors::MPU6050Driver mpu6050_;
+    ThreePhaseSampler three_phase_;
+    IWaveformSink* waveform_sink_{nullptr};
     bool initialized_{false};
 };
 
+using SensorManager = SensorManagerT<>;
+
 } // namespace gridshield::hardware
@@ -14,7 +14,9 @@
 #pragma once
 
 #include "core/error.hpp"
-#include "platform/platform.hpp"
+#include "hardware/sensors/adc_sampling.hpp"
+#include "platform/static_platform.hpp"
+#include "utils/fixed_point.hpp"
 
 #include <array>
 #include <cstdint>
@@ -59,15 +61,22 @@ struct ACS712Config
 // ============================================================================
 // ACS712 DRIVER
 // ============================================================================
-class ACS712Driver
+
+/**
+ * @tparam Adc ADC implementation. IPlatformADC dispatches virtually; a final
+ *             concrete type (e.g. Esp32ADC) lets per-sample reads inline.
+ */
+template <typename Adc = platform::IPlatformADC> class ACS712DriverT
 {
+    static_assert(platform::is_adc_provider_v<Adc>, "Adc does not satisfy the IPlatformADC contract");
+
 public:
-    ACS712Driver() noexcept = default;
+    ACS712DriverT() noexcept = default;
 
     /**
      * @brief Initialize the sensor with ADC.
      */
-    core::Result<void> init(platform::IPlatformADC& adc, const ACS712Config& config) noexcept
+    core::Result<void> init(Adc& adc, const ACS712Config& config) noexcept
     {
         adc_ = &adc;
         config_ = config;
@@ -107,11 +116,35 @@ public:
 
         // Convert to mA: (delta_mv * 1000) / sensitivity
         static constexpr int32_t MA_PER_A = 1000;
-        int32_t current_ma = (delta_mv * MA_PER_A) / static_cast<int32_t>(sensitivity);
+        int32_t current_ma = utils::mul_div_i32(delta_mv, MA_PER_A, sensitivity);
 
         return core::Result<int32_t>{current_ma};
     }
 
+    /**
+     * @brief True-RMS current in milliamps over @p samples ADC reads.
+     */
+    core::Result<uint32_t> read_current_rms_ma(uint16_t samples = ACS712_SAMPLES_PER_READ) noexcept
+    {
+        // NOLINTNEXTLINE(readability-simplify-boolean-expr)
+        if (GS_UNLIKELY(!initialized_ || adc_ == nullptr)) {
+            return core::Result<uint32_t>{GS_MAKE_ERROR(core::ErrorCode::SystemNotInitialized)};
+        }
+
+        const int32_t bias_mv =
+            static_cast<int32_t>(ACS712_ZERO_CURRENT_MV) - config_.calibration_offset_mv;
+        auto rms_result = sample_rms_mv(*adc_, config_.adc_channel, bias_mv, samples);
+        if (rms_result.is_error()) {
+            return rms_result;
+        }
+
+        static constexpr uint32_t MA_PER_A = 1000;
+        const uint16_t sensitivity =
+            ACS712_SENSITIVITY_MV_PER_A[static_cast<uint8_t>(config_.variant)];
+        return core::Result<uint32_t>{
+            utils::mul_div_u32(rms_result.value(), MA_PER_A, sensitivity)};
+    }
+
     /**
      * @brief Check if the sensor is initialized.
      */
@@ -121,9 +154,11 @@ public:
     }
 
 private:
-    platform::IPlatformADC* adc_{};
+    Adc* adc_{};
     ACS712Config config_{};
     bool initialized_{false};
 };
 
+using ACS712Driver = ACS712DriverT<>;
+
 } // namespace gridshield::hardware::sensors
@@ -0,0 +1,51 @@
+/**
+ * @file adc_sampling.hpp
+ * @author zuudevs (zuudevs@gmail.com)
+ * @brief Shared multi-sample ADC loop for analog sensor drivers
+ * @version 1.0
+ * @date 2026-03-10
+ *
+ * True-RMS of an AC signal centred on a bias voltage. Templated on the
+ * ADC type so a statically bound platform inlines read_mv() into the loop.
+ *
+ * @copyright Copyright (c) 2026
+ */
+
+#pragma once
+
+#include "core/error.hpp"
+#include "platform/static_platform.hpp"
+#include "utils/fixed_point.hpp"
+
+#include <cstdint>
+
+namespace gridshield::hardware::sensors {
+
+/**
+ * @brief RMS of (sample_mv - bias_mv) over @p samples reads of @p channel.
+ *
+ * Fails on the first ADC error so a flaky channel never yields a partial RMS.
+ */
+template <typename Adc>
+core::Result<uint32_t>
+sample_rms_mv(Adc& adc, uint8_t channel, int32_t bias_mv, uint16_t samples) noexcept
+{
+    static_assert(platform::is_adc_provider_v<Adc>, "Adc does not satisfy the IPlatformADC contract");
+
+    if (GS_UNLIKELY(samples == 0)) {
+        return core::Result<uint32_t>{GS_MAKE_ERROR(core::ErrorCode::InvalidParameter)};
+    }
+
+    uint64_t sum_sq = 0;
+    for (uint16_t i = 0; i < samples; ++i) {
+        auto mv_result = adc.read_mv(channel);
+        if (GS_UNLIKELY(mv_result.is_error())) {
+            return core::Result<uint32_t>{mv_result.error()};
+        }
+        const int64_t delta = static_cast<int64_t>(mv_result.value()) - bias_mv;
+        sum_sq += static_cast<uint64_t>(delta * delta);
+    }
+    return core::Result<uint32_t>{utils::isqrt_u64(sum_sq / samples)};
+}
+
+} // namespace gridshield::hardware::sensors
@@ -33,6 +33,7 @@ static constexpr uint8_t MPU6050_ADDR_HIGH = 0x69; // AD0 = HIGH
 // Register addresses
 static constexpr uint8_t MPU6050_REG_ACCEL_XOUT_H = 0x3B;
 static constexpr uint8_t MPU6050_REG_GYRO_XOUT_H = 0x43;
+static constexpr uint8_t MPU6050_REG_SMPLRT_DIV = 0x19;
 static constexpr uint8_t MPU6050_REG_PWR_MGMT_1 = 0x6B;
 static constexpr uint8_t MPU6050_REG_WHO_AM_I = 0x75;
 static constexpr uint8_t MPU6050_REG_ACCEL_CONFIG = 0x1C;
@@ -45,6 +46,9 @@ static constexpr uint8_t MPU6050_WHO_AM_I_VALUE = 0x68;
 static constexpr uint8_t MPU6050_WAKEUP_VALUE = 0x00;
 static constexpr uint8_t MPU6050_SLEEP_VALUE = 0x40;
 
+// Output data rate = gyro output rate (1 kHz with the DLPF on) / (1 + divider)
+static constexpr uint16_t MPU6050_GYRO_OUTPUT_RATE_HZ = 1000;
+
 // Data sizes
 static constexpr size_t MPU6050_ACCEL_DATA_SIZE = 6; // 3 axes * 2 bytes
 static constexpr size_t MPU6050_GYRO_DATA_SIZE = 6;  // 3 axes * 2 bytes
@@ -199,6 +203,18 @@ public:
         return core::Result<bool>{shock};
     }
 
+    /**
+     * @brief Set the output data rate to 1 kHz / (1 + @p divider); 0 is full ODR.
+     */
+    core::Result<void> set_sample_rate_divider(uint8_t divider) noexcept
+    {
+        // NOLINTNEXTLINE(readability-simplify-boolean-expr)
+        if (GS_UNLIKELY(!initialized_ || i2c_ == nullptr)) {
+            return GS_MAKE_ERROR(core::ErrorCode::SystemNotInitialized);
+        }
+        return i2c_->write_reg(config_.i2c_addr, MPU6050_REG_SMPLRT_DIV, &divider, sizeof(divider));
+    }
+
     GS_NODISCARD bool is_initialized() const noexcept
     {
         return initialized_;
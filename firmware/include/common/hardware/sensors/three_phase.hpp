@@ -0,0 +1,596 @@
+/**
+ * @file three_phase.hpp
+ * @author zuudevs (zuudevs@gmail.com)
+ * @brief Interleaved three-phase voltage/current sampler
+ * @version 1.0
+ * @date 2026-03-24
+ *
+ * One ADC serves three ZMPT101B voltage channels, three ACS712 current
+ * channels and an optional neutral CT. Channels are read round-robin in
+ * slot order Va Ia Vb Ib Vc Ic [In], so each phase's V and I are adjacent;
+ * the remaining skew (one slot per channel) is removed by interpolating
+ * every slot back to the instant of slot 0, which keeps power and phase
+ * angles unbiased without simultaneous-sampling hardware.
+ *
+ * The per-round path is a subtract, a Q16 scale for currents, a lerp and
+ * a few multiply-accumulates; transformer ratios and square roots are
+ * applied once per window in finish().
+ *
+ * @copyright Copyright (c) 2026
+ */
+
+#pragma once
+
+#include "core/error.hpp"
+#include "core/types.hpp"
+#include "hardware/sensors/acs712.hpp"
+#include "hardware/sensors/zmpt101b.hpp"
+#include "platform/static_platform.hpp"
+#include "utils/fixed_point.hpp"
+
+#include <array>
+#include <cstdint>
+
+namespace gridshield::hardware::sensors {
+
+// ============================================================================
+// THREE-PHASE CONSTANTS
+// ============================================================================
+static constexpr uint8_t THREE_PHASE_NO_CHANNEL = 0xFF;
+static constexpr size_t THREE_PHASE_MAX_SLOTS = 7;        // 3 V + 3 I + neutral
+static constexpr size_t THREE_PHASE_NEUTRAL_SLOT = 6;
+static constexpr uint16_t THREE_PHASE_DEFAULT_ROUNDS = 512; // >= 3 cycles at ~7 kS/s per channel
+static constexpr uint16_t THREE_PHASE_MIN_ROUNDS = 8;
+static constexpr int32_t THREE_PHASE_DEFAULT_HYSTERESIS_MV = 20; // at the sensor output
+static constexpr uint32_t THREE_PHASE_DEFAULT_LIVE_MV = 50000;   // 50 V line RMS
+static constexpr uint32_t THREE_PHASE_MIN_UNBALANCE_MA = 200;    // below: no current unbalance
+static constexpr int32_t PHASE_ANGLE_FULL_DEG10 = 3600;
+static constexpr int32_t PHASE_ANGLE_TOLERANCE_DEG10 = 300;
+
+// ============================================================================
+// THREE-PHASE CONFIGURATION
+// ============================================================================
+struct ThreePhaseConfig
+{
+    std::array<uint8_t, core::PHASE_COUNT> voltage_channels{0, 2, 4};
+    std::array<uint8_t, core::PHASE_COUNT> current_channels{1, 3, 5};
+    uint8_t neutral_channel{THREE_PHASE_NO_CHANNEL};
+    platform::ADCAttenuation attenuation{platform::ADCAttenuation::Db12};
+
+    int32_t zero_point_mv{ZMPT101B_ZERO_POINT_MV};                  // shared mid-rail bias
+    std::array<int16_t, core::PHASE_COUNT> voltage_offset_mv{};    // per-channel calibration
+    std::array<int16_t, core::PHASE_COUNT> current_offset_mv{};
+    int16_t neutral_offset_mv{};
+
+    uint32_t voltage_ratio{ZMPT101B_DEFAULT_RATIO}; // x1000, same convention as ZMPT101BConfig
+    std::array<uint16_t, core::PHASE_COUNT> current_sensitivity_mv_per_a{100, 100, 100};
+    uint16_t neutral_sensitivity_mv_per_a{100};
+
+    uint16_t rounds{THREE_PHASE_DEFAULT_ROUNDS}; // ADC rounds (all slots) per window
+    int32_t zero_cross_hysteresis_mv{THREE_PHASE_DEFAULT_HYSTERESIS_MV};
+    uint32_t live_threshold_mv{THREE_PHASE_DEFAULT_LIVE_MV};
+
+    GS_CONSTEXPR ThreePhaseConfig() noexcept = default;
+
+    GS_NODISCARD GS_CONSTEXPR bool has_neutral() const noexcept
+    {
+        return neutral_channel != THREE_PHASE_NO_CHANNEL;
+    }
+};
+
+// ============================================================================
+// MEASUREMENT
+// ============================================================================
+struct PhaseMeasurement
+{
+    uint32_t voltage_mv{}; // line RMS
+    uint32_t current_ma{}; // RMS
+    int32_t power_mw{};    // active, negative = export
+    int16_t angle_deg10{}; // voltage zero crossing relative to phase A, 0..3599
+
+    GS_CONSTEXPR PhaseMeasurement() noexcept = default;
+};
+
+struct ThreePhaseMeasurement
+{
+    std::array<PhaseMeasurement, core::PHASE_COUNT> phases{};
+    int32_t total_power_mw{};
+    uint32_t neutral_ma{};  // measured In, or RMS of Ia + Ib + Ic without a neutral CT
+    uint32_t residual_ma{}; // RMS of In - (Ia + Ib + Ic); 0 without a neutral CT
+    uint16_t frequency_chz{};
+    uint16_t voltage_unbalance_permille{};
+    uint16_t current_unbalance_permille{};
+    uint16_t samples{};
+    core::PhaseSequence sequence{core::PhaseSequence::Unknown};
+    uint8_t flags{}; // core::PHASE_FLAG_*
+
+    GS_CONSTEXPR ThreePhaseMeasurement() noexcept = default;
+};
+
+namespace three_phase_detail {
+
+/// Largest deviation from the mean, in permille of the mean (NEMA definition).
+GS_CONSTEXPR uint16_t unbalance_permille(const uint32_t (&values)[core::PHASE_COUNT]) noexcept
+{
+    const uint64_t sum = uint64_t{values[0]} + values[1] + values[2];
+    if (sum == 0) {
+        return 0;
+    }
+    uint64_t worst = 0;
+    for (uint32_t v : values) {
+        const uint64_t scaled = uint64_t{v} * core::PHASE_COUNT;
+        const uint64_t dev = scaled > sum ? scaled - sum : sum - scaled;
+        worst = dev > worst ? dev : worst;
+    }
+    const uint64_t permille = (worst * 1000U + sum / 2) / sum;
+    return static_cast<uint16_t>(permille <= UINT16_MAX ? permille : UINT16_MAX);
+}
+
+GS_CONSTEXPR bool angle_near(int32_t angle, int32_t target) noexcept
+{
+    const int32_t diff = angle > target ? angle - target : target - angle;
+    return diff <= PHASE_ANGLE_TOLERANCE_DEG10;
+}
+
+} // namespace three_phase_detail
+
+// ============================================================================
+// ACCUMULATOR (platform independent)
+// ============================================================================
+
+/**
+ * @brief Phase-aligned running sums for one sampling window.
+ *
+ * push_round() takes one ADC round in slot order (raw sensor mV) and
+ * finish() turns the sums into RMS, power, frequency and sequence.
+ * The first round only primes the interpolation, so a window of R rounds
+ * yields R - 1 aligned samples. The sums are snapshotted at each rising
+ * zero crossing of phase A and finish() uses whole cycles only: a window
+ * ending mid-cycle would otherwise bias RMS and power by up to a few
+ * percent depending on where it cut the waveform.
+ */
+class ThreePhaseAccumulator
+{
+public:
+    ThreePhaseAccumulator() noexcept = default;
+
+    core::Result<void> configure(const ThreePhaseConfig& config) noexcept
+    {
+        for (size_t p = 0; p < core::PHASE_COUNT; ++p) {
+            if (GS_UNLIKELY(config.current_sensitivity_mv_per_a[p] == 0)) {
+                return GS_MAKE_ERROR(core::ErrorCode::InvalidParameter);
+            }
+        }
+        if (GS_UNLIKELY(config.rounds < THREE_PHASE_MIN_ROUNDS ||
+                        (config.has_neutral() && config.neutral_sensitivity_mv_per_a == 0))) {
+            return GS_MAKE_ERROR(core::ErrorCode::InvalidParameter);
+        }
+
+        config_ = config;
+        slots_ = config.has_neutral() ? THREE_PHASE_MAX_SLOTS : THREE_PHASE_MAX_SLOTS - 1;
+        for (size_t p = 0; p < core::PHASE_COUNT; ++p) {
+            bias_mv_[2 * p] = config.zero_point_mv - config.voltage_offset_mv[p];
+            bias_mv_[2 * p + 1] = config.zero_point_mv - config.current_offset_mv[p];
+            gain_[2 * p] = utils::Q16::one();
+            gain_[2 * p + 1] = utils::Q16::from_ratio(1000, config.current_sensitivity_mv_per_a[p]);
+        }
+        bias_mv_[THREE_PHASE_NEUTRAL_SLOT] = config.zero_point_mv - config.neutral_offset_mv;
+        gain_[THREE_PHASE_NEUTRAL_SLOT] =
+            config.has_neutral() ? utils::Q16::from_ratio(1000, config.neutral_sensitivity_mv_per_a)
+                                 : utils::Q16::zero();
+
+        // Slot k is read k/slots of a round after slot 0: pull it back by
+        // interpolating from the previous round's read of the same channel
+        for (size_t k = 0; k < slots_; ++k) {
+            weight_[k] = utils::Q30::from_ratio(static_cast<int64_t>(slots_ - k),
+                                                static_cast<int64_t>(slots_));
+        }
+        reset();
+        return core::Result<void>{};
+    }
+
+    void reset() noexcept
+    {
+        rounds_ = 0;
+        sums_ = Sums{};
+        cycle_start_ = Sums{};
+        cycle_end_ = Sums{};
+        prev_aligned_v_.fill(0);
+        below_.fill(false);
+        crossings_.fill(0);
+        first_cross_.fill(0);
+        last_cross_ = 0;
+    }
+
+    /// One ADC round, raw sensor millivolts in slot order Va Ia Vb Ib Vc Ic [In].
+    void push_round(const int32_t* sensor_mv) noexcept
+    {
+        std::array<int32_t, THREE_PHASE_MAX_SLOTS> aligned{};
+        for (size_t k = 0; k < slots_; ++k) {
+            const int32_t value = gain_[k].scale(sensor_mv[k] - bias_mv_[k]);
+            aligned[k] = utils::lerp(prev_[k], value, weight_[k]);
+            prev_[k] = value;
+        }
+        const uint32_t index = rounds_++;
+        if (GS_UNLIKELY(index == 0)) {
+            return; // priming round: no previous read to interpolate from
+        }
+
+        int32_t i_sum = 0;
+        for (size_t p = 0; p < core::PHASE_COUNT; ++p) {
+            const int64_t v = aligned[2 * p];
+            const int64_t i = aligned[2 * p + 1];
+            sums_.vv[p] += static_cast<uint64_t>(v * v);
+            sums_.ii[p] += static_cast<uint64_t>(i * i);
+            sums_.vi[p] += v * i;
+            i_sum += aligned[2 * p + 1];
+        }
+        if (slots_ == THREE_PHASE_MAX_SLOTS) {
+            const int64_t n = aligned[THREE_PHASE_NEUTRAL_SLOT];
+            const int64_t r = n - i_sum;
+            sums_.nn += static_cast<uint64_t>(n * n);
+            sums_.rr += static_cast<uint64_t>(r * r);
+        } else {
+            sums_.nn += static_cast<uint64_t>(int64_t{i_sum} * i_sum);
+        }
+        ++sums_.n;
+
+        for (size_t p = 0; p < core::PHASE_COUNT; ++p) {
+            track_crossing(p, aligned[2 * p], index);
+        }
+    }
+
+    /**
+     * @brief Reduce the window to a measurement.
+     * @param elapsed_us Wall time of all pushed rounds (for frequency).
+     */
+    GS_NODISCARD ThreePhaseMeasurement finish(uint64_t elapsed_us) const noexcept
+    {
+        ThreePhaseMeasurement m;
+        // Whole cycles between the first and last crossing of A when there
+        // are any (DC or a dead phase A: the whole window)
+        const Sums s = crossings_[0] >= 2 ? cycle_end_.minus(cycle_start_) : sums_;
+        if (s.n == 0) {
+            return m;
+        }
+        const uint64_t n = s.n;
+        m.samples = static_cast<uint16_t>(n <= UINT16_MAX ? n : UINT16_MAX);
+
+        uint32_t volts[core::PHASE_COUNT]{};
+        uint32_t amps[core::PHASE_COUNT]{};
+        int64_t total_mw = 0;
+        for (size_t p = 0; p < core::PHASE_COUNT; ++p) {
+            PhaseMeasurement& ph = m.phases[p];
+            // 4 fractional bits of sensor RMS before the (large) ratio is applied
+            const uint32_t rms_x16 = utils::isqrt_u64((s.vv[p] << 8) / n);
+            ph.voltage_mv = utils::mul_div_u32(rms_x16, config_.voltage_ratio, 16U * 1000U);
+            ph.current_ma = utils::isqrt_u64(s.ii[p] / n);
+            // sensor mV x mA averaged, scaled by ratio/1000 to line uW, then to mW
+            const int64_t mean_vi = s.vi[p] / static_cast<int64_t>(n);
+            ph.power_mw = utils::mul_div_i32(mean_vi, config_.voltage_ratio, 1000000);
+            total_mw += ph.power_mw;
+            volts[p] = ph.voltage_mv;
+            amps[p] = ph.current_ma;
+            if (ph.voltage_mv >= config_.live_threshold_mv) {
+                m.flags |= static_cast<uint8_t>(1U << (core::PHASE_FLAG_LIVE_SHIFT + p));
+            }
+        }
+        m.total_power_mw = static_cast<int32_t>(
+            total_mw > INT32_MAX ? INT32_MAX : (total_mw < INT32_MIN ? INT32_MIN : total_mw));
+        m.neutral_ma = utils::isqrt_u64(s.nn / n);
+        if (slots_ == THREE_PHASE_MAX_SLOTS) {
+            m.residual_ma = utils::isqrt_u64(s.rr / n);
+            m.flags |= core::PHASE_FLAG_NEUTRAL_CT;
+        }
+        m.voltage_unbalance_permille = three_phase_detail::unbalance_permille(volts);
+        if (amps[0] + amps[1] + amps[2] >= THREE_PHASE_MIN_UNBALANCE_MA * core::PHASE_COUNT) {
+            m.current_unbalance_permille = three_phase_detail::unbalance_permille(amps);
+        }
+
+        compute_timing(m, elapsed_us);
+        return m;
+    }
+
+    GS_NODISCARD uint32_t rounds() const noexcept
+    {
+        return rounds_;
+    }
+
+    GS_NODISCARD size_t slots() const noexcept
+    {
+        return slots_;
+    }
+
+private:
+    struct Sums
+    {
+        std::array<uint64_t, core::PHASE_COUNT> vv{};
+        std::array<uint64_t, core::PHASE_COUNT> ii{};
+        std::array<int64_t, core::PHASE_COUNT> vi{};
+        uint64_t nn{0};
+        uint64_t rr{0};
+        uint32_t n{0};
+
+        GS_NODISCARD Sums minus(const Sums& other) const noexcept
+        {
+            Sums out;
+            for (size_t p = 0; p < core::PHASE_COUNT; ++p) {
+                out.vv[p] = vv[p] - other.vv[p];
+                out.ii[p] = ii[p] - other.ii[p];
+                out.vi[p] = vi[p] - other.vi[p];
+            }
+            out.nn = nn - other.nn;
+            out.rr = rr - other.rr;
+            out.n = n - other.n;
+            return out;
+        }
+    };
+
+    // Rising zero crossings, re-armed only after the signal drops below
+    // -hysteresis so noise around zero cannot double count
+    void track_crossing(size_t phase, int32_t v, uint32_t index) noexcept
+    {
+        const int32_t prev = prev_aligned_v_[phase];
+        prev_aligned_v_[phase] = v;
+        if (v < -config_.zero_cross_hysteresis_mv) {
+            below_[phase] = true;
+            return;
+        }
+        if (!below_[phase] || v < 0 || prev >= 0) {
+            return;
+        }
+        below_[phase] = false;
+
+        // Crossing time in Q16 rounds, interpolated between the two samples
+        const int64_t frac = (int64_t{-prev} << 16) / (int64_t{v} - prev);
+        const int64_t when = (int64_t{index - 1} << 16) + frac;
+        if (phase != 0) {
+            if (crossings_[0] != 0 && crossings_[phase] == 0 && when >= first_cross_[0]) {
+                first_cross_[phase] = when; // B/C: first crossing after A's first one
+                ++crossings_[phase];
+            }
+            return;
+        }
+        if (crossings_[0] == 0) {
+            first_cross_[0] = when;
+            cycle_start_ = sums_;
+        }
+        last_cross_ = when;
+        cycle_end_ = sums_;
+        ++crossings_[0];
+    }
+
+    void compute_timing(ThreePhaseMeasurement& m, uint64_t elapsed_us) const noexcept
+    {
+        if (crossings_[0] < 2 || elapsed_us == 0) {
+            return;
+        }
+        const uint64_t cycles = crossings_[0] - 1U;
+        const auto span_q16 = static_cast<uint64_t>(last_cross_ - first_cross_[0]);
+        if (span_q16 == 0) {
+            return;
+        }
+        // period = span / cycles rounds; one round = elapsed / rounds us
+        const uint64_t period_ns = (span_q16 * elapsed_us * 1000U) / ((cycles * rounds_) << 16);
+        if (period_ns == 0) {
+            return;
+        }
+        static constexpr uint64_t NS_PER_S_X100 = 100000000000ULL;
+        const uint64_t chz = (NS_PER_S_X100 + period_ns / 2) / period_ns;
+        m.frequency_chz = static_cast<uint16_t>(chz <= UINT16_MAX ? chz : UINT16_MAX);
+        m.flags |= core::PHASE_FLAG_FREQ_VALID;
+
+        for (size_t p = 1; p < core::PHASE_COUNT; ++p) {
+            if (crossings_[p] == 0) {
+                continue;
+            }
+            const auto lag = static_cast<uint64_t>(first_cross_[p] - first_cross_[0]);
+            const uint64_t deg10 =
+                (lag * PHASE_ANGLE_FULL_DEG10 * cycles + span_q16 / 2) / span_q16;
+            m.phases[p].angle_deg10 = static_cast<int16_t>(deg10 % PHASE_ANGLE_FULL_DEG10);
+        }
+
+        if (crossings_[1] == 0 || crossings_[2] == 0) {
+            return;
+        }
+        const int32_t b = m.phases[1].angle_deg10;
+        const int32_t c = m.phases[2].angle_deg10;
+        static constexpr int32_t THIRD = PHASE_ANGLE_FULL_DEG10 / 3;
+        if (three_phase_detail::angle_near(b, THIRD) &&
+            three_phase_detail::angle_near(c, 2 * THIRD)) {
+            m.sequence = core::PhaseSequence::Abc;
+        } else if (three_phase_detail::angle_near(b, 2 * THIRD) &&
+                   three_phase_detail::angle_near(c, THIRD)) {
+            m.sequence = core::PhaseSequence::Acb;
+        }
+    }
+
+    ThreePhaseConfig config_{};
+    size_t slots_{THREE_PHASE_MAX_SLOTS - 1};
+    std::array<int32_t, THREE_PHASE_MAX_SLOTS> bias_mv_{};
+    std::array<utils::Q16, THREE_PHASE_MAX_SLOTS> gain_{};
+    std::array<utils::Q30, THREE_PHASE_MAX_SLOTS> weight_{};
+    std::array<int32_t, THREE_PHASE_MAX_SLOTS> prev_{};
+
+    uint32_t rounds_{0};
+    Sums sums_{};
+    Sums cycle_start_{}; // sums_ at A's first crossing
+    Sums cycle_end_{};   // sums_ at A's latest crossing
+
+    std::array<int32_t, core::PHASE_COUNT> prev_aligned_v_{};
+    std::array<bool, core::PHASE_COUNT> below_{};
+    std::array<uint16_t, core::PHASE_COUNT> crossings_{};
+    std::array<int64_t, core::PHASE_COUNT> first_cross_{};
+    int64_t last_cross_{0};
+};
+
+// ============================================================================
+// SAMPLER
+// ============================================================================
+
+/**
+ * @tparam Adc  ADC implementation (see ACS712DriverT).
+ * @tparam Time Clock used to time the window and integrate energy.
+ */
+template <typename Adc = platform::IPlatformADC, typename Time = platform::IPlatformTime>
+class ThreePhaseSamplerT
+{
+    static_assert(platform::is_adc_provider_v<Adc>, "Adc does not satisfy the IPlatformADC contract");
+    static_assert(platform::is_time_provider_v<Time>,
+                  "Time does not satisfy the IPlatformTime contract");
+
+public:
+    ThreePhaseSamplerT() noexcept = default;
+
+    core::Result<void> init(Adc& adc, Time& time, const ThreePhaseConfig& config) noexcept
+    {
+        GS_TRY(accumulator_.configure(config));
+        for (size_t p = 0; p < core::PHASE_COUNT; ++p) {
+            channels_[2 * p] = config.voltage_channels[p];
+            channels_[2 * p + 1] = config.current_channels[p];
+        }
+        channels_[THREE_PHASE_NEUTRAL_SLOT] = config.neutral_channel;
+
+        for (size_t k = 0; k < accumulator_.slots(); ++k) {
+            auto result = adc.init(channels_[k], config.attenuation);
+            if (result.is_error()) {
+                return result;
+            }
+        }
+
+        adc_ = &adc;
+        time_ = &time;
+        rounds_ = config.rounds;
+        last_sample_us_ = 0;
+        energy_mw_us_ = 0;
+        energy_wh_ = 0;
+        initialized_ = true;
+        return core::Result<void>{};
+    }
+
+    /**
+     * @brief Sample one window and integrate import energy up to its end.
+     *
+     * Fails on the first ADC error so a flaky channel never yields a
+     * partial measurement.
+     */
+    core::Result<ThreePhaseMeasurement> sample() noexcept
+    {
+        if (GS_UNLIKELY(!initialized_)) {
+            return core::Result<ThreePhaseMeasurement>{
+                GS_MAKE_ERROR(core::ErrorCode::SystemNotInitialized)};
+        }
+
+        accumulator_.reset();
+        const size_t slots = accumulator_.slots();
+        std::array<int32_t, THREE_PHASE_MAX_SLOTS> round{};
+        const uint64_t start_us = time_->get_timestamp_us();
+        for (uint16_t r = 0; r < rounds_; ++r) {
+            for (size_t k = 0; k < slots; ++k) {
+                auto mv_result = adc_->read_mv(channels_[k]);
+                if (GS_UNLIKELY(mv_result.is_error())) {
+                    return core::Result<ThreePhaseMeasurement>{mv_result.error()};
+                }
+                round[k] = static_cast<int32_t>(mv_result.value());
+            }
+            accumulator_.push_round(round.data());
+        }
+        const uint64_t end_us = time_->get_timestamp_us();
+
+        ThreePhaseMeasurement m = accumulator_.finish(end_us - start_us);
+        const uint64_t from_us = last_sample_us_ == 0 ? start_us : last_sample_us_;
+        integrate_energy(m.total_power_mw, from_us, end_us);
+        last_sample_us_ = end_us;
+        return core::Result<ThreePhaseMeasurement>{m};
+    }
+
+    /**
+     * @brief Change the window length; takes effect on the next sample().
+     */
+    core::Result<void> set_rounds(uint16_t rounds) noexcept
+    {
+        if (GS_UNLIKELY(rounds < THREE_PHASE_MIN_ROUNDS)) {
+            return GS_MAKE_ERROR(core::ErrorCode::InvalidParameter);
+        }
+        rounds_ = rounds;
+        return core::Result<void>{};
+    }
+
+    GS_NODISCARD uint16_t rounds() const noexcept
+    {
+        return rounds_;
+    }
+
+    /// Import energy since init(), Wh (export is not netted off).
+    GS_NODISCARD uint32_t energy_wh() const noexcept
+    {
+        return energy_wh_;
+    }
+
+    /**
+     * @brief Pack a measurement into the 56-byte record (saturating).
+     */
+    static core::ThreePhaseReading to_reading(const ThreePhaseMeasurement& m,
+                                              core::timestamp_t timestamp,
+                                              uint32_t energy_wh) noexcept
+    {
+        static constexpr uint32_t MV_PER_DV = 100;
+        static constexpr uint32_t MA_PER_CA = 10;
+        static constexpr int32_t MW_PER_W = 1000;
+
+        core::ThreePhaseReading reading;
+        reading.timestamp = timestamp;
+        reading.energy_wh = energy_wh;
+        reading.total_power_w = m.total_power_mw / MW_PER_W;
+        for (size_t p = 0; p < core::PHASE_COUNT; ++p) {
+            reading.phases[p].power_w = m.phases[p].power_mw / MW_PER_W;
+            reading.phases[p].voltage_dv = saturate_u16(m.phases[p].voltage_mv / MV_PER_DV);
+            reading.phases[p].current_ca = saturate_u16(m.phases[p].current_ma / MA_PER_CA);
+        }
+        reading.neutral_ca = saturate_u16(m.neutral_ma / MA_PER_CA);
+        reading.residual_ca = saturate_u16(m.residual_ma / MA_PER_CA);
+        reading.voltage_unbalance_permille = m.voltage_unbalance_permille;
+        reading.current_unbalance_permille = m.current_unbalance_permille;
+        reading.frequency_chz = m.frequency_chz;
+        reading.sequence = m.sequence;
+        reading.flags = m.flags;
+        return reading;
+    }
+
+    GS_NODISCARD bool is_initialized() const noexcept
+    {
+        return initialized_;
+    }
+
+private:
+    static uint16_t saturate_u16(uint32_t value) noexcept
+    {
+        return static_cast<uint16_t>(value <= UINT16_MAX ? value : UINT16_MAX);
+    }
+
+    void integrate_energy(int32_t power_mw, uint64_t from_us, uint64_t to_us) noexcept
+    {
+        static constexpr uint64_t MW_US_PER_WH = 3600ULL * 1000U * 1000000U;
+        if (power_mw <= 0 || to_us <= from_us) {
+            return;
+        }
+        energy_mw_us_ += static_cast<uint64_t>(power_mw) * (to_us - from_us);
+        const uint64_t whole = energy_mw_us_ / MW_US_PER_WH;
+        energy_mw_us_ -= whole * MW_US_PER_WH;
+        energy_wh_ += static_cast<uint32_t>(whole);
+    }
+
+    Adc* adc_{};
+    Time* time_{};
+    ThreePhaseAccumulator accumulator_;
+    std::array<uint8_t, THREE_PHASE_MAX_SLOTS> channels_{};
+    uint16_t rounds_{THREE_PHASE_DEFAULT_ROUNDS};
+    uint64_t last_sample_us_{0};
+    uint64_t energy_mw_us_{0};
+    uint32_t energy_wh_{0};
+    bool initialized_{false};
+};
+
+using ThreePhaseSampler = ThreePhaseSamplerT<>;
+
+} // namespace gridshield::hardware::sensors
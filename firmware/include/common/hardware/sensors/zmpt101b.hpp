@@ -14,7 +14,8 @@
 #pragma once
 
 #include "core/error.hpp"
-#include "platform/platform.hpp"
+#include "hardware/sensors/adc_sampling.hpp"
+#include "platform/static_platform.hpp"
 
 #include <cstdint>
 
@@ -45,15 +46,21 @@ struct ZMPT101BConfig
 // ============================================================================
 // ZMPT101B DRIVER
 // ============================================================================
-class ZMPT101BDriver
+
+/**
+ * @tparam Adc ADC implementation (see ACS712DriverT).
+ */
+template <typename Adc = platform::IPlatformADC> class ZMPT101BDriverT
 {
+    static_assert(platform::is_adc_provider_v<Adc>, "Adc does not satisfy the IPlatformADC contract");
+
 public:
-    ZMPT101BDriver() noexcept = default;
+    ZMPT101BDriverT() noexcept = default;
 
     /**
      * @brief Initialize the sensor with ADC.
      */
-    core::Result<void> init(platform::IPlatformADC& adc, const ZMPT101BConfig& config) noexcept
+    core::Result<void> init(Adc& adc, const ZMPT101BConfig& config) noexcept
     {
         adc_ = &adc;
         config_ = config;
@@ -70,8 +77,7 @@ public:
     /**
      * @brief Read AC voltage in millivolts (RMS approximation from single sample).
      *
-     * For production use, this should sample at least one full AC cycle
-     * and compute true RMS. This simplified version reads a single sample.
+     * Single sample; use read_voltage_rms_mv() for a full-cycle true RMS.
      */
     core::Result<uint32_t> read_voltage_mv() noexcept
     {
@@ -99,15 +105,40 @@ public:
         return core::Result<uint32_t>{voltage_mv};
     }
 
+    /**
+     * @brief True-RMS AC voltage in millivolts over @p samples ADC reads.
+     *
+     * The default sample count spans at least one mains cycle.
+     */
+    core::Result<uint32_t>
+    read_voltage_rms_mv(uint16_t samples = ZMPT101B_SAMPLES_PER_READ) noexcept
+    {
+        // NOLINTNEXTLINE(readability-simplify-boolean-expr)
+        if (GS_UNLIKELY(!initialized_ || adc_ == nullptr)) {
+            return core::Result<uint32_t>{GS_MAKE_ERROR(core::ErrorCode::SystemNotInitialized)};
+        }
+
+        const int32_t bias_mv =
+            static_cast<int32_t>(ZMPT101B_ZERO_POINT_MV) - config_.calibration_offset_mv;
+        auto rms_result = sample_rms_mv(*adc_, config_.adc_channel, bias_mv, samples);
+        if (rms_result.is_error()) {
+            return rms_result;
+        }
+        return core::Result<uint32_t>{(rms_result.value() * config_.voltage_ratio) /
+                                      ZMPT101B_RATIO_DIVISOR};
+    }
+
     GS_NODISCARD bool is_initialized() const noexcept
     {
         return initialized_;
     }
 
 private:
-    platform::IPlatformADC* adc_{};
+    Adc* adc_{};
     ZMPT101BConfig config_{};
     bool initialized_{false};
 };
 
+using ZMPT101BDriver = ZMPT101BDriverT<>;
+
 } // namespace gridshield::hardware::sensors
@@ -64,6 +64,8 @@ public:
     virtual core::Result<void> poll() noexcept = 0;
 
     GS_NODISCARD virtual bool is_tampered() const noexcept = 0;
+    // Edge seen by the ISR, not yet confirmed or discarded by poll()
+    GS_NODISCARD virtual bool is_trigger_pending() const noexcept = 0;
     GS_NODISCARD virtual TamperType get_tamper_type() const noexcept = 0;
     GS_NODISCARD virtual core::timestamp_t get_tamper_timestamp() const noexcept = 0;
 
@@ -87,6 +89,7 @@ public:
     core::Result<void> poll() noexcept override;
 
     GS_NODISCARD bool is_tampered() const noexcept override;
+    GS_NODISCARD bool is_trigger_pending() const noexcept override;
     GS_NODISCARD TamperType get_tamper_type() const noexcept override;
     GS_NODISCARD core::timestamp_t get_tamper_timestamp() const noexcept override;
 
@@ -0,0 +1,83 @@
+/**
+ * @file waveform.hpp
+ * @author zuudevs (zuudevs@gmail.com)
+ * @brief Compact per-sample acquisition record and its sink interface
+ * @version 1.0
+ * @date 2026-03-14
+ *
+ * The sensor acquisition path hands every sample to an IWaveformSink
+ * (e.g. forensics::FlightRecorder) in this 10-byte form, so consumers
+ * need no knowledge of the individual drivers.
+ *
+ * @copyright Copyright (c) 2026
+ */
+
+#pragma once
+
+#include "utils/gs_macros.hpp"
+
+#include <cstddef>
+#include <cstdint>
+
+namespace gridshield::hardware {
+
+// ============================================================================
+// WAVEFORM SAMPLE
+// ============================================================================
+static constexpr size_t WAVEFORM_CHANNELS = 5;
+
+struct WaveformSample
+{
+    uint16_t voltage_dv{}; // 0.1 V
+    int16_t current_ca{};  // 10 mA
+    int16_t accel_x_mg{};
+    int16_t accel_y_mg{};
+    int16_t accel_z_mg{};
+
+    GS_CONSTEXPR WaveformSample() noexcept = default;
+
+    /// Channel @p idx as a signed value (0 = voltage ... 4 = accel Z).
+    GS_NODISCARD GS_CONSTEXPR int32_t channel(size_t idx) const noexcept
+    {
+        return idx == 0   ? static_cast<int32_t>(voltage_dv)
+               : idx == 1 ? current_ca
+               : idx == 2 ? accel_x_mg
+               : idx == 3 ? accel_y_mg
+                          : accel_z_mg;
+    }
+
+    void set_channel(size_t idx, int32_t value) noexcept
+    {
+        switch (idx) {
+        case 0:
+            voltage_dv = static_cast<uint16_t>(value);
+            break;
+        case 1:
+            current_ca = static_cast<int16_t>(value);
+            break;
+        case 2:
+            accel_x_mg = static_cast<int16_t>(value);
+            break;
+        case 3:
+            accel_y_mg = static_cast<int16_t>(value);
+            break;
+        default:
+            accel_z_mg = static_cast<int16_t>(value);
+            break;
+        }
+    }
+};
+
+// ============================================================================
+// WAVEFORM SINK
+// ============================================================================
+class IWaveformSink
+{
+public:
+    virtual ~IWaveformSink() noexcept = default;
+
+    /// Called once per acquired sample; must stay O(1) and non-blocking.
+    virtual void record(const WaveformSample& sample) noexcept = 0;
+};
+
+} // namespace gridshield::hardware
@@ -0,0 +1,548 @@
+/**
+ * @file ack.hpp
+ * @author zuudevs (zuudevs@gmail.com)
+ * @brief Cumulative + selective acknowledgments (PacketType::Acknowledgment)
+ * @version 1.0
+ * @date 2026-03-19
+ *
+ * One signed ack covers a whole window of sequence numbers instead of one
+ * ack per frame, so the reverse direction costs a fraction of the airtime
+ * and sign/verify work — on a half-duplex link every ack frame is time the
+ * data direction cannot use.
+ *
+ * Receiver (AckReceiver, one per sending peer): records arriving sequence
+ * numbers as a cumulative point plus a SACK bitmap of the ACK_SACK_BITS
+ * sequences above it, and asks for an ack once ack_every frames are
+ * pending or the oldest pending one is ack_delay_ms old. A duplicate
+ * means the sender missed our last ack, so it makes one due at once.
+ *
+ * Sender (AckOutbox): keeps the signed bytes of every unacknowledged
+ * frame, releases all of them an ack covers in one pass and retransmits
+ * only the gaps — immediately for a frame an ack skipped over (first
+ * time only), otherwise after an exponentially backed-off timeout.
+ * Retransmissions resend the stored bytes: no new signature. With an
+ * IDeliveryFeedback attached, each frame remembers the link it last went
+ * out on; first-transmission acks report their RTT and timeouts or gaps
+ * report a loss on that link (TransportManager's link estimator).
+ *
+ * The sender never has more than ACK_SACK_BITS sequences outstanding, so
+ * a receiver that sees a sequence beyond its window can slide forward:
+ * whatever falls off the back was given up by the sender.
+ *
+ * Payload (packed, little-endian, 20 bytes):
+ *   [PEER_ID: 8B] [CUMULATIVE: 4B] [SACK: 8B]
+ *   bit i of SACK = sequence CUMULATIVE + 1 + i received.
+ *
+ * Sequence 0 means "unsequenced" and is never acknowledged.
+ *
+ * @copyright Copyright (c) 2026
+ */
+
+#pragma once
+
+#include "core/error.hpp"
+#include "core/types.hpp"
+#include "network/packet.hpp"
+#include "platform/platform.hpp"
+#include "utils/gs_macros.hpp"
+
+#include <array>
+#include <cstdint>
+#include <cstring>
+
+namespace gridshield::network {
+
+// ============================================================================
+// WIRE FORMAT
+// ============================================================================
+static constexpr size_t ACK_SACK_BITS = 64;
+
+#pragma pack(push, 1)
+struct AckPayload
+{
+    core::meter_id_t peer_id{};    // whose stream is acknowledged
+    core::sequence_t cumulative{}; // every sequence <= this was received
+    uint64_t sack{};               // bit i: cumulative + 1 + i received
+
+    /// True when @p seq is covered by this ack.
+    GS_NODISCARD bool covers(core::sequence_t seq) const noexcept
+    {
+        if (seq <= cumulative) {
+            return true;
+        }
+        const uint32_t offset = seq - cumulative - 1;
+        return offset < ACK_SACK_BITS && ((sack >> offset) & 1U) != 0;
+    }
+
+    /// Highest sequence this ack reports as received.
+    GS_NODISCARD core::sequence_t highest() const noexcept
+    {
+        core::sequence_t high = cumulative;
+        for (uint64_t bits = sack; bits != 0; bits >>= 1) {
+            ++high;
+        }
+        return high;
+    }
+};
+#pragma pack(pop)
+
+static_assert(sizeof(AckPayload) == 20, "AckPayload wire size");
+
+/// Decode a verified PacketType::Acknowledgment packet.
+inline core::Result<AckPayload> parse_ack(const SecurePacket& packet) noexcept
+{
+    if (packet.header().type != PacketType::Acknowledgment ||
+        packet.payload_length() != sizeof(AckPayload)) {
+        return core::Result<AckPayload>{GS_MAKE_ERROR(core::ErrorCode::InvalidPacket)};
+    }
+    AckPayload ack;
+    memcpy(&ack, packet.payload(), sizeof(AckPayload));
+    return core::Result<AckPayload>{ack};
+}
+
+// ============================================================================
+// RECEIVER
+// ============================================================================
+struct AckConfig
+{
+    static constexpr uint32_t DEFAULT_ACK_DELAY_MS = 500;
+
+    uint8_t ack_every{8};                        // 1 = classic per-packet ack
+    uint32_t ack_delay_ms{DEFAULT_ACK_DELAY_MS}; // 0 = only by count
+
+    GS_CONSTEXPR AckConfig() noexcept = default;
+    GS_CONSTEXPR AckConfig(uint8_t every, uint32_t delay_ms) noexcept
+        : ack_every(every), ack_delay_ms(delay_ms)
+    {}
+};
+
+struct AckReceiverStats
+{
+    uint32_t received{0}; // new frames recorded
+    uint32_t duplicates{0};
+    uint32_t slides{0};    // window jumped forward (sender gave up or rebooted)
+    uint32_t acks_sent{0}; // one signature each
+};
+
+class AckReceiver
+{
+public:
+    AckReceiver() noexcept = default;
+    explicit AckReceiver(const AckConfig& config) noexcept : config_(config) {}
+
+    /// Start over for @p peer_id; the next frame sets the cumulative point.
+    void reset(core::meter_id_t peer_id) noexcept
+    {
+        peer_id_ = peer_id;
+        cumulative_ = 0;
+        sack_ = 0;
+        started_ = false;
+        pending_ = 0;
+        force_ = false;
+    }
+
+    /**
+     * @brief Record a verified frame's sequence number.
+     * @return true for a new frame, false for a duplicate (or sequence 0).
+     */
+    bool on_receive(core::sequence_t seq, core::timestamp_t now_ms) noexcept
+    {
+        if (GS_UNLIKELY(seq == 0)) {
+            return false;
+        }
+        if (!started_) {
+            cumulative_ = seq - 1;
+            sack_ = 0;
+            started_ = true;
+        }
+        if (seq <= cumulative_) {
+            return duplicate();
+        }
+        uint32_t offset = seq - cumulative_ - 1;
+        if (offset >= ACK_SACK_BITS) {
+            // Beyond the window: the sender abandoned everything below seq - 63
+            const uint32_t slide = offset - static_cast<uint32_t>(ACK_SACK_BITS - 1);
+            sack_ = slide >= ACK_SACK_BITS ? 0 : sack_ >> slide;
+            cumulative_ += slide;
+            offset -= slide;
+            ++stats_.slides;
+        }
+        if (((sack_ >> offset) & 1U) != 0) {
+            return duplicate();
+        }
+        sack_ |= 1ULL << offset;
+        while ((sack_ & 1U) != 0) {
+            sack_ >>= 1;
+            ++cumulative_;
+        }
+        if (pending_++ == 0) {
+            first_pending_ms_ = now_ms;
+        }
+        ++stats_.received;
+        return true;
+    }
+
+    /// A verified frame was rejected upstream as a replay (e.g. by ReplayGuard).
+    void on_duplicate() noexcept
+    {
+        (void)duplicate();
+    }
+
+    GS_NODISCARD bool ack_due(core::timestamp_t now_ms) const noexcept
+    {
+        if (!started_) {
+            return false;
+        }
+        if (force_ || (pending_ != 0 && pending_ >= config_.ack_every)) {
+            return true;
+        }
+        return pending_ != 0 && config_.ack_delay_ms != 0 &&
+               now_ms - first_pending_ms_ >= config_.ack_delay_ms;
+    }
+
+    /// Current state as an ack; clears the pending count.
+    AckPayload take_ack() noexcept
+    {
+        AckPayload ack;
+        ack.peer_id = peer_id_;
+        ack.cumulative = cumulative_;
+        ack.sack = sack_;
+        pending_ = 0;
+        force_ = false;
+        return ack;
+    }
+
+    /**
+     * @brief Build the signed ack packet (stamp its sequence beforehand with
+     *        SecurePacket::set_sequence() if the link uses a ReplayGuard).
+     */
+    core::Result<void> build_ack(SecurePacket& packet,
+                                 core::meter_id_t own_id,
+                                 security::ICryptoEngine& crypto,
+                                 const security::ECCKeyPair& keypair) noexcept
+    {
+        const AckPayload ack = take_ack();
+        uint8_t payload[sizeof(AckPayload)];
+        memcpy(payload, &ack, sizeof(AckPayload));
+        GS_TRY(packet.build(PacketType::Acknowledgment,
+                            own_id,
+                            core::Priority::Normal,
+                            payload,
+                            sizeof(payload),
+                            crypto,
+                            keypair));
+        ++stats_.acks_sent;
+        return core::Result<void>{};
+    }
+
+    // === Accessors ===
+
+    GS_NODISCARD core::sequence_t cumulative() const noexcept
+    {
+        return cumulative_;
+    }
+    GS_NODISCARD uint32_t pending() const noexcept
+    {
+        return pending_;
+    }
+    GS_NODISCARD const AckReceiverStats& stats() const noexcept
+    {
+        return stats_;
+    }
+
+private:
+    bool duplicate() noexcept
+    {
+        ++stats_.duplicates;
+        force_ = true;
+        return false;
+    }
+
+    AckConfig config_{};
+    AckReceiverStats stats_{};
+    core::meter_id_t peer_id_{0};
+    core::sequence_t cumulative_{0};
+    uint64_t sack_{0};
+    core::timestamp_t first_pending_ms_{0};
+    uint32_t pending_{0};
+    bool started_{false};
+    bool force_{false}; // ack at the next opportunity regardless of count/delay
+};
+
+// ============================================================================
+// SENDER
+// ============================================================================
+struct RetransmitConfig
+{
+    uint32_t rto_ms{2000};        // first retransmission timeout
+    uint32_t max_rto_ms{30000};   // backoff ceiling
+    uint8_t max_transmissions{5}; // including the first; then the frame is dropped
+
+    GS_CONSTEXPR RetransmitConfig() noexcept = default;
+    GS_CONSTEXPR RetransmitConfig(uint32_t rto, uint32_t max_rto, uint8_t max_tx) noexcept
+        : rto_ms(rto), max_rto_ms(max_rto), max_transmissions(max_tx)
+    {}
+};
+
+static constexpr uint8_t ACK_NO_LINK = 0xFF;
+
+/// Per-link delivery outcomes for a multi-link uplink (TransportChannel).
+class IDeliveryFeedback
+{
+public:
+    virtual ~IDeliveryFeedback() = default;
+
+    /// Link the most recent send went out on; ACK_NO_LINK if none.
+    virtual uint8_t last_link() const noexcept = 0;
+    virtual void on_delivered(uint8_t link, uint32_t rtt_ms) noexcept = 0;
+    virtual void on_lost(uint8_t link) noexcept = 0;
+};
+
+struct AckOutboxStats
+{
+    uint32_t tracked{0};
+    uint32_t acked{0};            // frames released by acks
+    uint32_t acks_received{0};    // one signature verification each
+    uint32_t fast_retransmits{0}; // gap below a SACKed frame
+    uint32_t timeout_retransmits{0};
+    uint32_t expired{0}; // dropped after max_transmissions
+};
+
+/**
+ * @tparam Capacity   Unacknowledged frames held (at most ACK_SACK_BITS)
+ * @tparam FrameBytes Largest serialized frame stored
+ */
+template <size_t Capacity, size_t FrameBytes = PacketTransport::MAX_FRAME_SIZE> class AckOutbox
+{
+    static_assert(Capacity > 0 && Capacity <= ACK_SACK_BITS, "outbox exceeds the SACK window");
+    static_assert(FrameBytes >= sizeof(PacketHeader) + sizeof(PacketFooter), "frame too small");
+
+public:
+    AckOutbox() noexcept = default;
+    explicit AckOutbox(const RetransmitConfig& config) noexcept : config_(config) {}
+
+    /// Charge acks and losses to the link each frame went out on; nullptr detaches.
+    void set_feedback(IDeliveryFeedback* feedback) noexcept
+    {
+        feedback_ = feedback;
+    }
+
+    void configure(const RetransmitConfig& config) noexcept
+    {
+        config_ = config;
+        clear();
+        stats_ = AckOutboxStats{};
+    }
+
+    /// Forget every outstanding frame (e.g. after a rekey).
+    void clear() noexcept
+    {
+        for (auto& slot : slots_) {
+            slot.used = false;
+        }
+        count_ = 0;
+    }
+
+    /**
+     * @brief Keep a copy of @p packet (already sent) until it is acknowledged.
+     *
+     * ResourceExhausted when the outbox is full or @p packet would sit more
+     * than ACK_SACK_BITS sequences above the oldest unacknowledged frame:
+     * hold the reading back and poll() until space frees up.
+     */
+    core::Result<void> track(const SecurePacket& packet, core::timestamp_t now_ms) noexcept
+    {
+        const core::sequence_t seq = packet.header().sequence;
+        if (GS_UNLIKELY(seq == 0 || (count_ != 0 && seq <= newest_))) {
+            return GS_MAKE_ERROR(core::ErrorCode::InvalidParameter);
+        }
+        if (!can_track(seq)) {
+            return GS_MAKE_ERROR(core::ErrorCode::ResourceExhausted);
+        }
+        Slot* slot = free_slot();
+        auto n = packet.serialize(slot->frame.data(), FrameBytes);
+        if (n.is_error()) {
+            return n.error();
+        }
+        slot->seq = seq;
+        slot->length = static_cast<uint16_t>(n.value());
+        slot->sent_ms = now_ms;
+        slot->transmissions = 1;
+        slot->link = feedback_ != nullptr ? feedback_->last_link() : ACK_NO_LINK;
+        slot->gap = false;
+        slot->used = true;
+        ++count_;
+        newest_ = seq;
+        ++stats_.tracked;
+        return core::Result<void>{};
+    }
+
+    /// True when a frame with @p seq could be tracked now.
+    GS_NODISCARD bool can_track(core::sequence_t seq) const noexcept
+    {
+        if (count_ >= Capacity) {
+            return false;
+        }
+        return count_ == 0 || seq - oldest() < ACK_SACK_BITS;
+    }
+
+    /**
+     * @brief Release every frame @p ack covers; flag gaps below its highest.
+     * @return Frames released.
+     */
+    size_t on_ack(const AckPayload& ack) noexcept
+    {
+        return release(ack, false, 0);
+    }
+
+    /// As on_ack(), and report the RTT of each first transmission it covers
+    /// to the attached IDeliveryFeedback (Karn: retransmissions are ambiguous).
+    size_t on_ack(const AckPayload& ack, core::timestamp_t now_ms) noexcept
+    {
+        return release(ack, true, now_ms);
+    }
+
+    /**
+     * @brief Retransmit gaps and timed-out frames over @p comm.
+     * @return Frames retransmitted; send errors leave the frame due.
+     */
+    core::Result<size_t> poll(core::timestamp_t now_ms, platform::IPlatformComm& comm) noexcept
+    {
+        size_t sent = 0;
+        for (auto& slot : slots_) {
+            if (!slot.used) {
+                continue;
+            }
+            const bool timed_out = now_ms - slot.sent_ms >= rto(slot.transmissions);
+            if (!slot.gap && !timed_out) {
+                continue;
+            }
+            if (timed_out && !slot.gap && !slot.timeout_reported) {
+                report_lost(slot);
+                slot.timeout_reported = true;
+            }
+            if (slot.transmissions >= config_.max_transmissions) {
+                slot.used = false;
+                --count_;
+                ++stats_.expired;
+                continue;
+            }
+            auto r = comm.send(slot.frame.data(), slot.length);
+            if (r.is_error()) {
+                return core::Result<size_t>{r.error()};
+            }
+            ++(slot.gap ? stats_.fast_retransmits : stats_.timeout_retransmits);
+            slot.gap = false;
+            slot.timeout_reported = false;
+            slot.sent_ms = now_ms;
+            slot.link = feedback_ != nullptr ? feedback_->last_link() : ACK_NO_LINK;
+            ++slot.transmissions;
+            ++sent;
+        }
+        return core::Result<size_t>{sent};
+    }
+
+    // === Accessors ===
+
+    GS_NODISCARD size_t in_flight() const noexcept
+    {
+        return count_;
+    }
+    static constexpr size_t capacity() noexcept
+    {
+        return Capacity;
+    }
+    GS_NODISCARD const AckOutboxStats& stats() const noexcept
+    {
+        return stats_;
+    }
+
+private:
+    struct Slot
+    {
+        std::array<uint8_t, FrameBytes> frame{};
+        core::timestamp_t sent_ms{0};
+        core::sequence_t seq{0};
+        uint16_t length{0};
+        uint8_t transmissions{0};
+        uint8_t link{ACK_NO_LINK}; // where the last transmission went out
+        bool gap{false};           // an ack skipped over it: resend without waiting
+        bool timeout_reported{false};
+        bool used{false};
+    };
+
+    size_t release(const AckPayload& ack, bool timed, core::timestamp_t now_ms) noexcept
+    {
+        ++stats_.acks_received;
+        const core::sequence_t highest = ack.highest();
+        size_t released = 0;
+        for (auto& slot : slots_) {
+            if (!slot.used) {
+                continue;
+            }
+            if (ack.covers(slot.seq)) {
+                if (timed && slot.transmissions == 1 && feedback_ != nullptr &&
+                    slot.link != ACK_NO_LINK) {
+                    const core::timestamp_t rtt = now_ms - slot.sent_ms;
+                    feedback_->on_delivered(
+                        slot.link, static_cast<uint32_t>(rtt <= UINT32_MAX ? rtt : UINT32_MAX));
+                }
+                slot.used = false;
+                --count_;
+                ++released;
+            } else if (slot.seq < highest && slot.transmissions == 1 && !slot.gap) {
+                // The receiver got something newer: this one was lost
+                slot.gap = true;
+                report_lost(slot);
+            }
+        }
+        stats_.acked += static_cast<uint32_t>(released);
+        return released;
+    }
+
+    void report_lost(const Slot& slot) noexcept
+    {
+        if (feedback_ != nullptr && slot.link != ACK_NO_LINK) {
+            feedback_->on_lost(slot.link);
+        }
+    }
+
+    GS_NODISCARD core::sequence_t oldest() const noexcept
+    {
+        core::sequence_t low = newest_;
+        for (const auto& slot : slots_) {
+            if (slot.used && slot.seq < low) {
+                low = slot.seq;
+            }
+        }
+        return low;
+    }
+
+    Slot* free_slot() noexcept
+    {
+        for (auto& slot : slots_) {
+            if (!slot.used) {
+                return &slot;
+            }
+        }
+        return nullptr; // unreachable: count_ < Capacity checked
+    }
+
+    GS_NODISCARD uint32_t rto(uint8_t transmissions) const noexcept
+    {
+        uint32_t timeout = config_.rto_ms;
+        for (uint8_t i = 1; i < transmissions && timeout < config_.max_rto_ms; ++i) {
+            timeout *= 2;
+        }
+        return timeout < config_.max_rto_ms ? timeout : config_.max_rto_ms;
+    }
+
+    RetransmitConfig config_{};
+    AckOutboxStats stats_{};
+    IDeliveryFeedback* feedback_{nullptr};
+    std::array<Slot, Capacity> slots_{};
+    size_t count_{0};
+    core::sequence_t newest_{0};
+};
+
+} // namespace gridshield::network
@@ -0,0 +1,254 @@
+/**
+ * @file comm_links.hpp
+ * @author zuudevs (zuudevs@gmail.com)
+ * @brief IPlatformComm adapters for the LoRa, ESP-NOW, MQTT and CoAP clients
+ * @version 1.0
+ * @date 2026-03-28
+ *
+ * Lets TransportManager treat each radio or protocol client as one more
+ * uplink. The adapters do not own or configure the client: init() and
+ * connect() stay with whoever set it up, so init() here only checks that
+ * the adapter was given what it needs.
+ *
+ * Only LoRa has a blocking receive. The mesh adapter returns a queued
+ * packet if there is one; MQTT and CoAP deliver downlink through their own
+ * subscription and response paths, so receive() reports NetworkTimeout.
+ *
+ * @note Header-only, zero heap allocation.
+ */
+
+#pragma once
+
+#include "core/error.hpp"
+#include "network/coap.hpp"
+#include "network/esp_now_mesh.hpp"
+#include "network/lora.hpp"
+#include "network/mqtt.hpp"
+#include "platform/platform.hpp"
+
+#include <array>
+#include <cstdint>
+#include <cstring>
+
+namespace gridshield::network {
+
+// ============================================================================
+// LORA
+// ============================================================================
+class LoRaCommLink final : public platform::IPlatformComm
+{
+public:
+    explicit LoRaCommLink(ILoRaDriver& driver) noexcept : driver_(driver) {}
+
+    core::Result<void> init() noexcept override
+    {
+        return core::Result<void>{};
+    }
+
+    core::Result<void> shutdown() noexcept override
+    {
+        return driver_.sleep();
+    }
+
+    core::Result<size_t> send(const uint8_t* data, size_t length) noexcept override
+    {
+        if (GS_UNLIKELY(data == nullptr || length == 0 || length > LORA_MAX_PAYLOAD_SIZE)) {
+            return core::Result<size_t>(GS_MAKE_ERROR(core::ErrorCode::InvalidParameter));
+        }
+        GS_TRY(driver_.send(data, length));
+        return core::Result<size_t>(length);
+    }
+
+    core::Result<size_t>
+    receive(uint8_t* buffer, size_t max_length, uint32_t timeout_ms) noexcept override
+    {
+        return driver_.receive(buffer, max_length, timeout_ms);
+    }
+
+    /// Connectionless: failures surface through send().
+    bool is_connected() noexcept override
+    {
+        return true;
+    }
+
+private:
+    ILoRaDriver& driver_;
+};
+
+// ============================================================================
+// ESP-NOW MESH
+// ============================================================================
+class MeshCommLink final : public platform::IPlatformComm
+{
+public:
+    MeshCommLink(IEspNowMesh& mesh, const std::array<uint8_t, MESH_MAC_LENGTH>& gateway) noexcept
+        : mesh_(mesh), gateway_(gateway)
+    {}
+
+    core::Result<void> init() noexcept override
+    {
+        return core::Result<void>{};
+    }
+
+    core::Result<void> shutdown() noexcept override
+    {
+        return core::Result<void>{};
+    }
+
+    core::Result<size_t> send(const uint8_t* data, size_t length) noexcept override
+    {
+        if (GS_UNLIKELY(data == nullptr || length == 0 || length > MESH_MAX_PAYLOAD)) {
+            return core::Result<size_t>(GS_MAKE_ERROR(core::ErrorCode::InvalidParameter));
+        }
+        GS_TRY(mesh_.send(gateway_, data, length));
+        return core::Result<size_t>(length);
+    }
+
+    /// Non-blocking: @p timeout_ms is ignored.
+    core::Result<size_t>
+    receive(uint8_t* buffer, size_t max_length, uint32_t /*timeout_ms*/) noexcept override
+    {
+        if (GS_UNLIKELY(buffer == nullptr || max_length == 0)) {
+            return core::Result<size_t>(GS_MAKE_ERROR(core::ErrorCode::InvalidParameter));
+        }
+        if (!mesh_.has_pending_packet()) {
+            return core::Result<size_t>(GS_MAKE_ERROR(core::ErrorCode::NetworkTimeout));
+        }
+        auto packet = mesh_.receive();
+        if (packet.is_error()) {
+            return core::Result<size_t>(packet.error());
+        }
+        size_t length = packet.value().header.payload_len;
+        if (length > MESH_MAX_PAYLOAD) {
+            length = MESH_MAX_PAYLOAD;
+        }
+        if (length > max_length) {
+            length = max_length;
+        }
+        std::memcpy(buffer, packet.value().payload.data(), length);
+        return core::Result<size_t>(length);
+    }
+
+    bool is_connected() noexcept override
+    {
+        return mesh_.peer_count() > 0;
+    }
+
+private:
+    IEspNowMesh& mesh_;
+    std::array<uint8_t, MESH_MAC_LENGTH> gateway_;
+};
+
+// ============================================================================
+// MQTT
+// ============================================================================
+class MqttCommLink final : public platform::IPlatformComm
+{
+public:
+    /// @p topic must outlive the adapter.
+    MqttCommLink(IMqttClient& client, const char* topic, MqttQos qos) noexcept
+        : client_(client), topic_(topic), qos_(qos)
+    {}
+
+    core::Result<void> init() noexcept override
+    {
+        if (GS_UNLIKELY(topic_ == nullptr || topic_[0] == '\0')) {
+            return GS_MAKE_ERROR(core::ErrorCode::InvalidParameter);
+        }
+        return core::Result<void>{};
+    }
+
+    core::Result<void> shutdown() noexcept override
+    {
+        return core::Result<void>{};
+    }
+
+    core::Result<size_t> send(const uint8_t* data, size_t length) noexcept override
+    {
+        if (GS_UNLIKELY(data == nullptr || length == 0 || length > MQTT_MAX_PAYLOAD_SIZE)) {
+            return core::Result<size_t>(GS_MAKE_ERROR(core::ErrorCode::InvalidParameter));
+        }
+        GS_TRY(client_.publish(topic_, data, length, qos_));
+        return core::Result<size_t>(length);
+    }
+
+    /// Services the client; inbound messages arrive via its subscriptions.
+    core::Result<size_t>
+    receive(uint8_t* /*buffer*/, size_t /*max_length*/, uint32_t /*timeout_ms*/) noexcept override
+    {
+        GS_TRY(client_.poll());
+        return core::Result<size_t>(GS_MAKE_ERROR(core::ErrorCode::NetworkTimeout));
+    }
+
+    bool is_connected() noexcept override
+    {
+        return client_.is_connected();
+    }
+
+private:
+    IMqttClient& client_;
+    const char* topic_;
+    MqttQos qos_;
+};
+
+// ============================================================================
+// COAP
+// ============================================================================
+
+/// POSTs each message to one resource. Confirmable requests return once
+/// answered, so register it with LinkConfig::send_is_round_trip.
+class CoapCommLink final : public platform::IPlatformComm
+{
+public:
+    /// @p uri_path must outlive the adapter.
+    CoapCommLink(ICoapClient& client, const char* uri_path) noexcept
+        : client_(client), uri_path_(uri_path)
+    {}
+
+    core::Result<void> init() noexcept override
+    {
+        if (GS_UNLIKELY(uri_path_ == nullptr || uri_path_[0] == '\0')) {
+            return GS_MAKE_ERROR(core::ErrorCode::InvalidParameter);
+        }
+        return core::Result<void>{};
+    }
+
+    core::Result<void> shutdown() noexcept override
+    {
+        return core::Result<void>{};
+    }
+
+    core::Result<size_t> send(const uint8_t* data, size_t length) noexcept override
+    {
+        if (GS_UNLIKELY(data == nullptr || length == 0 || length > COAP_MAX_PAYLOAD_SIZE)) {
+            return core::Result<size_t>(GS_MAKE_ERROR(core::ErrorCode::InvalidParameter));
+        }
+        auto code = client_.request(CoapMethod::Post, uri_path_, data, length);
+        if (code.is_error()) {
+            return core::Result<size_t>(code.error());
+        }
+        // 2.xx success class
+        const auto raw = static_cast<uint8_t>(code.value());
+        if ((raw >> 5U) != 2U) {
+            return core::Result<size_t>(GS_MAKE_ERROR(core::ErrorCode::TransmissionFailed));
+        }
+        return core::Result<size_t>(length);
+    }
+
+    core::Result<size_t>
+    receive(uint8_t* /*buffer*/, size_t /*max_length*/, uint32_t /*timeout_ms*/) noexcept override
+    {
+        return core::Result<size_t>(GS_MAKE_ERROR(core::ErrorCode::NetworkTimeout));
+    }
+
+    bool is_connected() noexcept override
+    {
+        return true;
+    }
+
+private:
+    ICoapClient& client_;
+    const char* uri_path_;
+};
+
+} // namespace gridshield::network
@@ -11,6 +11,7 @@
 #pragma once
 
 #include "core/error.hpp"
+#include "utils/flat_map.hpp"
 #include "utils/gs_macros.hpp"
 
 #include <array>
@@ -119,15 +120,15 @@ public:
         if (GS_UNLIKELY(!initialized_)) {
             return GS_MAKE_ERROR(core::ErrorCode::SystemNotInitialized);
         }
-        for (auto& peer : peers_) {
-            if (!peer.active) {
-                peer.mac = mac;
-                peer.encrypted = encrypted;
-                peer.active = true;
-                return core::Result<void>{};
-            }
+        MeshPeer peer;
+        peer.mac = mac;
+        peer.encrypted = encrypted;
+        peer.active = true;
+        // Re-adding a known peer updates it in place
+        if (peers_.insert(mac, peer).is_error()) {
+            return GS_MAKE_ERROR(core::ErrorCode::MeshPeerFull);
         }
-        return GS_MAKE_ERROR(core::ErrorCode::MeshPeerFull);
+        return core::Result<void>{};
     }
 
     core::Result<void>
@@ -136,13 +137,10 @@ public:
         if (GS_UNLIKELY(!initialized_)) {
             return GS_MAKE_ERROR(core::ErrorCode::SystemNotInitialized);
         }
-        for (auto& peer : peers_) {
-            if (peer.active && peer.mac == mac) {
-                peer = MeshPeer{};
-                return core::Result<void>{};
-            }
+        if (!peers_.erase(mac)) {
+            return GS_MAKE_ERROR(core::ErrorCode::MeshInvalidPeer);
         }
-        return GS_MAKE_ERROR(core::ErrorCode::MeshInvalidPeer);
+        return core::Result<void>{};
     }
 
     core::Result<void> send(const std::array<uint8_t, MESH_MAC_LENGTH>& /*dst_mac*/,
@@ -198,12 +196,7 @@ public:
 
     uint8_t peer_count() const noexcept override
     {
-        uint8_t cnt = 0;
-        for (const auto& peer : peers_) {
-            if (peer.active)
-                cnt++;
-        }
-        return cnt;
+        return static_cast<uint8_t>(peers_.size());
     }
 
     // === Test helpers ===
@@ -220,7 +213,7 @@ public:
 
 private:
     MeshConfig config_{};
-    std::array<MeshPeer, MESH_MAX_PEERS> peers_{};
+    utils::FlatMap<std::array<uint8_t, MESH_MAC_LENGTH>, MeshPeer, MESH_MAX_PEERS> peers_{};
     MeshStats stats_{};
     MeshPacket injected_packet_{};
     bool initialized_{false};
@@ -13,6 +13,7 @@
 
 #include "core/error.hpp"
 #include "core/types.hpp"
+#include "network/replay_guard.hpp"
 #include "platform/platform.hpp"
 #include "security/crypto.hpp"
 #include <array>
@@ -38,7 +39,8 @@ enum class PacketType : uint8_t
     Heartbeat = 3,
     Command = 4,
     Acknowledgment = 5,
-    KeyExchange = 6
+    KeyExchange = 6,
+    ThreePhaseData = 7 // core::ThreePhaseReading
 };
 
 // ============================================================================
@@ -92,6 +94,12 @@ public:
 
     core::Result<size_t> serialize(uint8_t* buffer, size_t buffer_size) const noexcept;
 
+    /// Sequence number the next build() stamps (from a TxSequenceCounter).
+    void set_sequence(core::sequence_t sequence) noexcept
+    {
+        next_sequence_ = sequence;
+    }
+
     GS_NODISCARD const PacketHeader& header() const noexcept
     {
         return header_;
@@ -142,9 +150,20 @@ public:
 // ============================================================================
 // PACKET TRANSPORT IMPLEMENTATION
 // ============================================================================
+/**
+ * @brief Frames SecurePackets over an IPlatformComm.
+ *
+ * Received bytes are accumulated until a whole frame is present, so a frame
+ * split across several receive() calls (fragmenting links, byte streams) is
+ * reassembled. A frame that fails to parse only drops its first byte; the
+ * parser then resynchronises on the next MAGIC_HEADER.
+ */
 class PacketTransport final : public IPacketTransport
 {
 public:
+    static constexpr size_t MAX_FRAME_SIZE =
+        sizeof(PacketHeader) + MAX_PAYLOAD_SIZE + sizeof(PacketFooter);
+
     explicit PacketTransport(platform::IPlatformComm& comm) noexcept;
     ~PacketTransport() noexcept override = default;
 
@@ -156,8 +175,26 @@ public:
                                               const security::ECCKeyPair& keypair,
                                               uint32_t timeout_ms) noexcept override;
 
+    /// Bytes received but not yet consumed as a frame.
+    GS_NODISCARD size_t buffered_bytes() const noexcept
+    {
+        return rx_fill_;
+    }
+
+    /// Reject authenticated frames whose (meter_id, sequence) was already seen.
+    void set_replay_guard(IReplayGuard* guard) noexcept
+    {
+        replay_guard_ = guard;
+    }
+
 private:
+    void consume(size_t count) noexcept;
+    void resync() noexcept;
+
     platform::IPlatformComm& comm_;
+    std::array<uint8_t, 2 * MAX_FRAME_SIZE> rx_buffer_{};
+    size_t rx_fill_{0};
+    IReplayGuard* replay_guard_{nullptr};
 };
 
 } // namespace gridshield::network
\ No newline at end of file
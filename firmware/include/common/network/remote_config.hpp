@@ -8,6 +8,7 @@
 #pragma once
 
 #include "core/error.hpp"
+#include "utils/flat_map.hpp"
 #include "utils/gs_macros.hpp"
 
 #include <array>
@@ -98,6 +99,7 @@ public:
         }
 
         current_schema_ = schema;
+        rebuild_index();
         state_ = ConfigState::Applied;
         apply_count_++;
         return core::Result<void>{};
@@ -112,6 +114,7 @@ public:
             return GS_MAKE_ERROR(core::ErrorCode::InvalidState);
         }
         current_schema_ = previous_schema_;
+        rebuild_index();
         state_ = ConfigState::RolledBack;
         has_previous_ = false;
         return core::Result<void>{};
@@ -125,12 +128,16 @@ public:
         if (key == nullptr) {
             return core::Result<const char*>(GS_MAKE_ERROR(core::ErrorCode::InvalidParameter));
         }
-        for (uint16_t entry_idx = 0; entry_idx < current_schema_.entry_count; ++entry_idx) {
-            const auto& entry = current_schema_.entries[entry_idx];
-            if (entry.active && std::strncmp(entry.key.data(), key, CONFIG_MAX_KEY_LENGTH) == 0) {
+        const uint8_t* slot = key_index_.find(utils::hash_string(key, CONFIG_MAX_KEY_LENGTH));
+        if (slot != nullptr) {
+            const auto& entry = current_schema_.entries[*slot];
+            if (std::strncmp(entry.key.data(), key, CONFIG_MAX_KEY_LENGTH) == 0) {
                 return core::Result<const char*>(entry.value.data());
             }
         }
+        if (GS_UNLIKELY(index_collision_)) {
+            return find_linear(key);
+        }
         return core::Result<const char*>(GS_MAKE_ERROR(core::ErrorCode::ConfigurationError));
     }
 
@@ -152,6 +159,40 @@ public:
     }
 
 private:
+    /// Hash -> entry index of the active keys; the first of duplicate keys wins.
+    void rebuild_index() noexcept
+    {
+        key_index_.clear();
+        index_collision_ = false;
+        for (uint16_t entry_idx = 0; entry_idx < current_schema_.entry_count; ++entry_idx) {
+            const auto& entry = current_schema_.entries[entry_idx];
+            if (!entry.active) {
+                continue;
+            }
+            const uint32_t hash = utils::hash_string(entry.key.data(), CONFIG_MAX_KEY_LENGTH);
+            const uint8_t* existing = key_index_.find(hash);
+            if (existing != nullptr) {
+                // Same hash, different key: get() falls back to a scan
+                index_collision_ |= std::strncmp(current_schema_.entries[*existing].key.data(),
+                                                 entry.key.data(),
+                                                 CONFIG_MAX_KEY_LENGTH) != 0;
+                continue;
+            }
+            (void)key_index_.insert(hash, static_cast<uint8_t>(entry_idx));
+        }
+    }
+
+    core::Result<const char*> find_linear(const char* key) const noexcept
+    {
+        for (uint16_t entry_idx = 0; entry_idx < current_schema_.entry_count; ++entry_idx) {
+            const auto& entry = current_schema_.entries[entry_idx];
+            if (entry.active && std::strncmp(entry.key.data(), key, CONFIG_MAX_KEY_LENGTH) == 0) {
+                return core::Result<const char*>(entry.value.data());
+            }
+        }
+        return core::Result<const char*>(GS_MAKE_ERROR(core::ErrorCode::ConfigurationError));
+    }
+
     RemoteConfigSettings settings_{};
     ConfigSchema current_schema_{};
     ConfigSchema previous_schema_{};
@@ -159,6 +200,8 @@ private:
     bool initialized_{false};
     bool has_previous_{false};
     uint32_t apply_count_{0};
+    utils::FlatMap<uint32_t, uint8_t, CONFIG_MAX_ENTRIES> key_index_{};
+    bool index_collision_{false};
 };
 
 } // namespace gridshield::network
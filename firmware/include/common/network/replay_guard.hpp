@@ -0,0 +1,763 @@
+/**
+ * @file replay_guard.hpp
+ * @author zuudevs (zuudevs@gmail.com)
+ * @brief Sequence-number anti-replay: sliding windows per sender, persistent TX counter
+ * @version 1.0
+ * @date 2026-03-18
+ *
+ * Receive side: ReplayGuard keeps an IPsec-style sliding bitmap
+ * (ReplayWindow, RFC 4303 §3.4.3) per meter_id in a fixed-capacity
+ * open-addressed table (linear probing, load <= 1/2, backward-shift
+ * deletion) with an intrusive LRU list. check_and_update() is O(1):
+ * one probe sequence, a constant-size bitmap shift and two list splices.
+ * When the table is full the least recently heard sender is evicted; its
+ * next frame re-admits it at whatever sequence it carries, so size the
+ * table above the active fleet (stats().evictions shows pressure).
+ *
+ * Only call it for frames whose signature verified, otherwise a forger
+ * can advance a window or churn the LRU.
+ *
+ * High-water marks persist to two A/B banks (header written last). After
+ * restore() every sequence at or below a sender's mark counts as seen;
+ * frames accepted after the last save() are the only replay exposure.
+ *
+ * Bank layout:
+ *   [MAGIC: 4B] [SEQUENCE: 4B] [COUNT: 4B] [CRC32(sequence, count): 4B]
+ *   then per block of REPLAY_PERSIST_BLOCK records:
+ *   [meter_id: 8B, high_water: 4B] x N  [CRC32: 4B]
+ *   Records are written most recently heard first.
+ *
+ * Send side: TxSequenceCounter hands out monotonic sequence numbers and
+ * persists a reservation every RESERVE_STRIDE values, so a reboot resumes
+ * above anything already on the air without a write per packet.
+ *
+ * Sequence numbers are not expected to wrap (2^32 frames per key).
+ *
+ * @copyright Copyright (c) 2026
+ */
+
+#pragma once
+
+#include "core/error.hpp"
+#include "core/types.hpp"
+#include "platform/platform.hpp"
+#include "utils/gs_macros.hpp"
+
+#include <array>
+#include <cstdint>
+#include <cstring>
+
+namespace gridshield::network {
+
+// ============================================================================
+// CONSTANTS
+// ============================================================================
+static constexpr size_t REPLAY_WINDOW_BITS = 128;
+static constexpr size_t REPLAY_PERSIST_BLOCK = 32; // records per CRC block
+
+enum class ReplayVerdict : uint8_t
+{
+    Accepted = 0,
+    Duplicate = 1, // inside the window, already seen
+    TooOld = 2     // fell off the back of the window
+};
+
+// ============================================================================
+// SLIDING WINDOW — one sender
+// ============================================================================
+template <size_t Bits = REPLAY_WINDOW_BITS> class ReplayWindow
+{
+    static_assert(Bits >= 64 && Bits % 64 == 0, "window is a whole number of 64-bit words");
+
+public:
+    static constexpr size_t WORDS = Bits / 64;
+
+    GS_NODISCARD ReplayVerdict check(core::sequence_t seq) const noexcept
+    {
+        if (!started_ || seq > high_) {
+            return ReplayVerdict::Accepted;
+        }
+        const uint32_t offset = high_ - seq;
+        if (offset >= Bits) {
+            return ReplayVerdict::TooOld;
+        }
+        return test(offset) ? ReplayVerdict::Duplicate : ReplayVerdict::Accepted;
+    }
+
+    ReplayVerdict check_and_update(core::sequence_t seq) noexcept
+    {
+        const ReplayVerdict verdict = check(seq);
+        if (verdict != ReplayVerdict::Accepted) {
+            return verdict;
+        }
+        if (!started_) {
+            bits_ = {};
+            high_ = seq;
+            started_ = true;
+        } else if (seq > high_) {
+            shift(seq - high_);
+            high_ = seq;
+        }
+        const uint32_t offset = high_ - seq;
+        bits_[offset / 64] |= 1ULL << (offset % 64);
+        return ReplayVerdict::Accepted;
+    }
+
+    /// Resume from a persisted mark: everything at or below it counts as seen.
+    void restore(core::sequence_t high_water) noexcept
+    {
+        bits_.fill(~0ULL);
+        high_ = high_water;
+        started_ = true;
+    }
+
+    GS_NODISCARD core::sequence_t high_water() const noexcept
+    {
+        return high_;
+    }
+    GS_NODISCARD bool started() const noexcept
+    {
+        return started_;
+    }
+
+private:
+    GS_NODISCARD bool test(uint32_t offset) const noexcept
+    {
+        return (bits_[offset / 64] >> (offset % 64) & 1U) != 0;
+    }
+
+    /// Age every bit by @p n positions (bit i = sequence high_ - i).
+    void shift(uint32_t n) noexcept
+    {
+        if (n >= Bits) {
+            bits_ = {};
+            return;
+        }
+        const size_t words = n / 64;
+        const uint32_t bits = n % 64;
+        for (size_t i = WORDS; i-- > 0;) {
+            uint64_t v = i >= words ? bits_[i - words] << bits : 0;
+            if (bits != 0 && i > words) {
+                v |= bits_[i - words - 1] >> (64 - bits);
+            }
+            bits_[i] = v;
+        }
+    }
+
+    std::array<uint64_t, WORDS> bits_{};
+    core::sequence_t high_{0};
+    bool started_{false};
+};
+
+// ============================================================================
+// INTERFACE — what PacketTransport needs
+// ============================================================================
+class IReplayGuard
+{
+public:
+    virtual ~IReplayGuard() noexcept = default;
+
+    /// Verdict for (@p meter_id, @p seq); only Accepted updates the window.
+    virtual ReplayVerdict check_and_update(core::meter_id_t meter_id,
+                                           core::sequence_t seq) noexcept = 0;
+};
+
+// ============================================================================
+// REPLAY GUARD — many senders
+// ============================================================================
+struct ReplayGuardStats
+{
+    uint32_t accepted{0};
+    uint32_t duplicates{0};
+    uint32_t too_old{0};
+    uint32_t evictions{0};
+};
+
+struct ReplayPersistConfig
+{
+    uint32_t base_address{0}; // bank A; bank B follows at base + bank_size
+    size_t bank_size{0};
+
+    GS_CONSTEXPR ReplayPersistConfig() noexcept = default;
+    GS_CONSTEXPR ReplayPersistConfig(uint32_t base, size_t size) noexcept
+        : base_address(base), bank_size(size)
+    {}
+};
+
+/**
+ * @tparam Capacity   Senders tracked at once
+ * @tparam WindowBits Reordering tolerance per sender (64 or 128 typical)
+ */
+template <size_t Capacity, size_t WindowBits = REPLAY_WINDOW_BITS>
+class ReplayGuard final : public IReplayGuard
+{
+    static_assert(Capacity > 0 && Capacity < (1U << 30), "unsupported capacity");
+
+public:
+    static constexpr uint32_t PERSIST_MAGIC = 0x47535250; // "GSRP" (GridShield Replay Persist)
+    static constexpr size_t HEADER_SIZE = 16;
+    static constexpr size_t RECORD_SIZE = 12; // meter_id(8) + high_water(4)
+    static constexpr size_t BLOCK_SIZE = REPLAY_PERSIST_BLOCK * RECORD_SIZE + 4;
+
+    ReplayGuard() noexcept
+    {
+        reset();
+    }
+
+    ReplayGuard(const ReplayGuard&) = delete;
+    ReplayGuard& operator=(const ReplayGuard&) = delete;
+
+    void reset() noexcept
+    {
+        index_.fill(NIL);
+        count_ = 0;
+        head_ = NIL;
+        tail_ = NIL;
+        stats_ = ReplayGuardStats{};
+        dirty_ = 0;
+    }
+
+    // === Lookup ===
+
+    ReplayVerdict check_and_update(core::meter_id_t meter_id,
+                                   core::sequence_t seq) noexcept override
+    {
+        size_t pos = 0;
+        uint32_t e = NIL;
+        if (find(meter_id, pos)) {
+            e = index_[pos];
+            touch(e);
+        } else {
+            e = admit(meter_id);
+        }
+
+        const ReplayVerdict verdict = entries_[e].window.check_and_update(seq);
+        switch (verdict) {
+        case ReplayVerdict::Accepted:
+            ++stats_.accepted;
+            ++dirty_;
+            break;
+        case ReplayVerdict::Duplicate:
+            ++stats_.duplicates;
+            break;
+        default:
+            ++stats_.too_old;
+            break;
+        }
+        return verdict;
+    }
+
+    /// Verdict without recording the frame.
+    GS_NODISCARD ReplayVerdict check(core::meter_id_t meter_id, core::sequence_t seq) const noexcept
+    {
+        size_t pos = 0;
+        if (!find(meter_id, pos)) {
+            return ReplayVerdict::Accepted;
+        }
+        return entries_[index_[pos]].window.check(seq);
+    }
+
+    /// Highest accepted sequence of @p meter_id, or an error if untracked.
+    GS_NODISCARD core::Result<core::sequence_t> high_water(core::meter_id_t meter_id) const noexcept
+    {
+        size_t pos = 0;
+        if (!find(meter_id, pos)) {
+            return core::Result<core::sequence_t>{GS_MAKE_ERROR(core::ErrorCode::InvalidParameter)};
+        }
+        return core::Result<core::sequence_t>{entries_[index_[pos]].window.high_water()};
+    }
+
+    // === Persistence ===
+
+    /// Records that fit one bank of @p bank_size bytes.
+    static constexpr size_t bank_capacity(size_t bank_size) noexcept
+    {
+        return bank_size <= HEADER_SIZE
+                   ? 0
+                   : ((bank_size - HEADER_SIZE) / BLOCK_SIZE) * REPLAY_PERSIST_BLOCK;
+    }
+
+    /**
+     * @brief Write high-water marks into the older bank, most recent first.
+     * @return Senders persisted (fewer than size() if the bank is too small).
+     */
+    core::Result<size_t> save(platform::PlatformServices& platform,
+                              const ReplayPersistConfig& config) noexcept
+    {
+        if (platform.storage == nullptr || platform.crypto == nullptr ||
+            bank_capacity(config.bank_size) == 0) {
+            return core::Result<size_t>{GS_MAKE_ERROR(core::ErrorCode::InvalidParameter)};
+        }
+        uint32_t newest_seq = 0;
+        const size_t newest = newest_bank(platform, config, newest_seq);
+
+        // The batch is closed on every path, or a batching backend keeps
+        // staging all later writes until its deadline expires
+        GS_TRY(platform.storage->begin_batch());
+        auto written = write_bank(platform, config, newest, newest_seq);
+        auto commit_result = platform.storage->commit();
+        if (written.is_error()) {
+            return written;
+        }
+        if (commit_result.is_error()) {
+            return core::Result<size_t>{commit_result.error()};
+        }
+
+        dirty_ = 0;
+        return written;
+    }
+
+    /**
+     * @brief Replace the table with the newest intact bank.
+     * @return Senders restored; InvalidState if neither bank is usable.
+     */
+    core::Result<size_t> restore(platform::PlatformServices& platform,
+                                 const ReplayPersistConfig& config) noexcept
+    {
+        if (platform.storage == nullptr || platform.crypto == nullptr) {
+            return core::Result<size_t>{GS_MAKE_ERROR(core::ErrorCode::InvalidParameter)};
+        }
+        uint32_t seq[2]{};
+        uint32_t count[2]{};
+        const bool valid[2] = {read_header(platform, config, 0, seq[0], count[0]),
+                               read_header(platform, config, 1, seq[1], count[1])};
+        const size_t first = (valid[0] && (!valid[1] || seq[0] > seq[1])) ? 0 : 1;
+        const size_t order[2] = {first, first == 0 ? 1U : 0U};
+        for (const size_t bank : order) {
+            if (valid[bank] && load_bank(platform, config, bank, count[bank])) {
+                dirty_ = 0;
+                return core::Result<size_t>{static_cast<size_t>(count_)};
+            }
+        }
+        reset();
+        return core::Result<size_t>{GS_MAKE_ERROR(core::ErrorCode::InvalidState)};
+    }
+
+    // === Accessors ===
+
+    GS_NODISCARD size_t size() const noexcept
+    {
+        return count_;
+    }
+    static constexpr size_t capacity() noexcept
+    {
+        return Capacity;
+    }
+    GS_NODISCARD const ReplayGuardStats& stats() const noexcept
+    {
+        return stats_;
+    }
+    /// Windows advanced since the last save()/restore().
+    GS_NODISCARD uint32_t dirty() const noexcept
+    {
+        return dirty_;
+    }
+
+private:
+    static constexpr uint32_t NIL = UINT32_MAX;
+
+    static constexpr size_t index_size() noexcept
+    {
+        size_t n = 1;
+        while (n < 2 * Capacity) {
+            n <<= 1;
+        }
+        return n;
+    }
+    static constexpr size_t INDEX_SIZE = index_size();
+    static constexpr size_t INDEX_MASK = INDEX_SIZE - 1;
+
+    struct Entry
+    {
+        core::meter_id_t meter_id{0};
+        ReplayWindow<WindowBits> window{};
+        uint32_t prev{NIL}; // LRU neighbours (towards head = most recent)
+        uint32_t next{NIL};
+    };
+
+    static size_t home(core::meter_id_t meter_id) noexcept
+    {
+        // splitmix64 finalizer: meter ids are often sequential
+        uint64_t x = meter_id;
+        x ^= x >> 30;
+        x *= 0xBF58476D1CE4E5B9ULL;
+        x ^= x >> 27;
+        x *= 0x94D049BB133111EBULL;
+        x ^= x >> 31;
+        return static_cast<size_t>(x) & INDEX_MASK;
+    }
+
+    /// Index position of @p meter_id (true) or of the empty slot ending its probe (false).
+    bool find(core::meter_id_t meter_id, size_t& pos) const noexcept
+    {
+        pos = home(meter_id);
+        for (;;) {
+            const uint32_t e = index_[pos];
+            if (e == NIL) {
+                return false;
+            }
+            if (entries_[e].meter_id == meter_id) {
+                return true;
+            }
+            pos = (pos + 1) & INDEX_MASK;
+        }
+    }
+
+    uint32_t admit(core::meter_id_t meter_id) noexcept
+    {
+        uint32_t e = NIL;
+        if (count_ < Capacity) {
+            e = count_++;
+        } else {
+            e = tail_;
+            unlink(e);
+            erase_index(entries_[e].meter_id);
+            ++stats_.evictions;
+        }
+        size_t pos = 0;
+        (void)find(meter_id, pos);
+        entries_[e].meter_id = meter_id;
+        entries_[e].window = ReplayWindow<WindowBits>{};
+        index_[pos] = e;
+        push_front(e);
+        return e;
+    }
+
+    /// Backward-shift deletion: no tombstones, probe chains stay short.
+    void erase_index(core::meter_id_t meter_id) noexcept
+    {
+        size_t hole = 0;
+        if (!find(meter_id, hole)) {
+            return;
+        }
+        size_t next = (hole + 1) & INDEX_MASK;
+        while (index_[next] != NIL) {
+            const size_t want = home(entries_[index_[next]].meter_id);
+            if (((next - want) & INDEX_MASK) >= ((next - hole) & INDEX_MASK)) {
+                index_[hole] = index_[next];
+                hole = next;
+            }
+            next = (next + 1) & INDEX_MASK;
+        }
+        index_[hole] = NIL;
+    }
+
+    void touch(uint32_t e) noexcept
+    {
+        if (e != head_) {
+            unlink(e);
+            push_front(e);
+        }
+    }
+
+    void unlink(uint32_t e) noexcept
+    {
+        Entry& entry = entries_[e];
+        if (entry.prev != NIL) {
+            entries_[entry.prev].next = entry.next;
+        } else {
+            head_ = entry.next;
+        }
+        if (entry.next != NIL) {
+            entries_[entry.next].prev = entry.prev;
+        } else {
+            tail_ = entry.prev;
+        }
+        entry.prev = NIL;
+        entry.next = NIL;
+    }
+
+    void push_front(uint32_t e) noexcept
+    {
+        entries_[e].prev = NIL;
+        entries_[e].next = head_;
+        if (head_ != NIL) {
+            entries_[head_].prev = e;
+        }
+        head_ = e;
+        if (tail_ == NIL) {
+            tail_ = e;
+        }
+    }
+
+    static uint32_t bank_address(const ReplayPersistConfig& config, size_t bank) noexcept
+    {
+        return config.base_address + static_cast<uint32_t>(bank * config.bank_size);
+    }
+
+    /// Erase the bank after @p newest and fill it; the caller owns the batch.
+    core::Result<size_t> write_bank(platform::PlatformServices& platform,
+                                    const ReplayPersistConfig& config,
+                                    size_t newest,
+                                    uint32_t newest_seq) const noexcept
+    {
+        const size_t target = newest == 0 ? 1 : 0;
+        const uint32_t address = bank_address(config, target);
+        const size_t limit = bank_capacity(config.bank_size);
+        GS_TRY(platform.storage->erase(address, config.bank_size));
+
+        uint8_t block[BLOCK_SIZE];
+        size_t written = 0;
+        size_t in_block = 0;
+        uint32_t block_address = address + HEADER_SIZE;
+        for (uint32_t e = head_; e != NIL && written < limit; e = entries_[e].next) {
+            const core::sequence_t high = entries_[e].window.high_water();
+            memcpy(block + in_block * RECORD_SIZE, &entries_[e].meter_id, 8);
+            memcpy(block + in_block * RECORD_SIZE + 8, &high, 4);
+            ++written;
+            if (++in_block == REPLAY_PERSIST_BLOCK) {
+                GS_TRY(write_block(platform, block_address, block, in_block));
+                block_address += BLOCK_SIZE;
+                in_block = 0;
+            }
+        }
+        if (in_block != 0) {
+            GS_TRY(write_block(platform, block_address, block, in_block));
+        }
+
+        uint8_t header[HEADER_SIZE];
+        const uint32_t magic = PERSIST_MAGIC;
+        const uint32_t seq = newest < 2 ? newest_seq + 1 : 1;
+        const auto count = static_cast<uint32_t>(written);
+        memcpy(header, &magic, 4);
+        memcpy(header + 4, &seq, 4);
+        memcpy(header + 8, &count, 4);
+        auto crc_res = platform.crypto->crc32(header + 4, 8);
+        if (crc_res.is_error()) {
+            return core::Result<size_t>{crc_res.error()};
+        }
+        const uint32_t crc = crc_res.value();
+        memcpy(header + 12, &crc, 4);
+        GS_TRY(platform.storage->write(address, header, HEADER_SIZE).as_void());
+        return core::Result<size_t>{written};
+    }
+
+    static core::Result<void> write_block(platform::PlatformServices& platform,
+                                          uint32_t address,
+                                          uint8_t* block,
+                                          size_t records) noexcept
+    {
+        const size_t body = records * RECORD_SIZE;
+        auto crc_res = platform.crypto->crc32(block, body);
+        if (crc_res.is_error()) {
+            return crc_res.error();
+        }
+        const uint32_t crc = crc_res.value();
+        memcpy(block + body, &crc, 4);
+        return platform.storage->write(address, block, body + 4).as_void();
+    }
+
+    static bool read_header(platform::PlatformServices& platform,
+                            const ReplayPersistConfig& config,
+                            size_t bank,
+                            uint32_t& seq,
+                            uint32_t& count) noexcept
+    {
+        uint8_t header[HEADER_SIZE];
+        if (platform.storage->read(bank_address(config, bank), header, HEADER_SIZE).is_error()) {
+            return false;
+        }
+        uint32_t magic = 0;
+        uint32_t crc = 0;
+        memcpy(&magic, header, 4);
+        memcpy(&seq, header + 4, 4);
+        memcpy(&count, header + 8, 4);
+        memcpy(&crc, header + 12, 4);
+        auto crc_res = platform.crypto->crc32(header + 4, 8);
+        return magic == PERSIST_MAGIC && crc_res.is_ok() && crc_res.value() == crc &&
+               count <= bank_capacity(config.bank_size);
+    }
+
+    /// Bank holding the newest valid header (2 = none).
+    static size_t newest_bank(platform::PlatformServices& platform,
+                              const ReplayPersistConfig& config,
+                              uint32_t& newest_seq) noexcept
+    {
+        size_t newest = 2;
+        for (size_t bank = 0; bank < 2; ++bank) {
+            uint32_t seq = 0;
+            uint32_t count = 0;
+            if (read_header(platform, config, bank, seq, count) &&
+                (newest == 2 || seq > newest_seq)) {
+                newest = bank;
+                newest_seq = seq;
+            }
+        }
+        return newest;
+    }
+
+    bool load_bank(platform::PlatformServices& platform,
+                   const ReplayPersistConfig& config,
+                   size_t bank,
+                   uint32_t count) noexcept
+    {
+        reset();
+        uint8_t block[BLOCK_SIZE];
+        uint32_t address = bank_address(config, bank) + HEADER_SIZE;
+        uint32_t remaining = count;
+        while (remaining > 0) {
+            const size_t records =
+                remaining < REPLAY_PERSIST_BLOCK ? remaining : REPLAY_PERSIST_BLOCK;
+            const size_t body = records * RECORD_SIZE;
+            if (platform.storage->read(address, block, body + 4).is_error()) {
+                return false;
+            }
+            uint32_t crc = 0;
+            memcpy(&crc, block + body, 4);
+            auto crc_res = platform.crypto->crc32(block, body);
+            if (crc_res.is_error() || crc_res.value() != crc) {
+                return false;
+            }
+            for (size_t i = 0; i < records && count_ < Capacity; ++i) {
+                core::meter_id_t meter_id = 0;
+                core::sequence_t high = 0;
+                memcpy(&meter_id, block + i * RECORD_SIZE, 8);
+                memcpy(&high, block + i * RECORD_SIZE + 8, 4);
+                size_t pos = 0;
+                if (find(meter_id, pos)) {
+                    continue;
+                }
+                // Saved most recent first: append at the LRU tail
+                const uint32_t e = count_++;
+                entries_[e].meter_id = meter_id;
+                entries_[e].window.restore(high);
+                entries_[e].prev = tail_;
+                entries_[e].next = NIL;
+                if (tail_ != NIL) {
+                    entries_[tail_].next = e;
+                } else {
+                    head_ = e;
+                }
+                tail_ = e;
+                index_[pos] = e;
+            }
+            remaining -= static_cast<uint32_t>(records);
+            address += static_cast<uint32_t>(BLOCK_SIZE);
+        }
+        return true;
+    }
+
+    std::array<Entry, Capacity> entries_{};
+    std::array<uint32_t, INDEX_SIZE> index_{};
+    uint32_t count_{0};
+    uint32_t head_{NIL};
+    uint32_t tail_{NIL};
+    uint32_t dirty_{0};
+    ReplayGuardStats stats_{};
+};
+
+// ============================================================================
+// TX SEQUENCE COUNTER — sender side
+// ============================================================================
+
+/**
+ * Storage Layout (two banks, newer reservation wins):
+ *   [MAGIC: 4B] [RESERVED_UNTIL: 4B] [CRC32: 4B]
+ */
+class TxSequenceCounter
+{
+public:
+    static constexpr uint32_t SEQ_MAGIC = 0x47535351; // "GSSQ" (GridShield Sequence)
+    static constexpr uint32_t DEFAULT_ADDRESS = 448;  // between key slots and config
+    static constexpr size_t RECORD_SIZE = 12;
+    static constexpr size_t TOTAL_SIZE = 2 * RECORD_SIZE;
+    static constexpr uint32_t RESERVE_STRIDE = 256;
+
+    TxSequenceCounter() noexcept = default;
+
+    /**
+     * @brief Resume above the last persisted reservation.
+     * Without storage the counter still works, starting at 1 every boot.
+     */
+    core::Result<void> init(platform::PlatformServices& platform,
+                            uint32_t address = DEFAULT_ADDRESS) noexcept
+    {
+        platform_ = &platform;
+        address_ = address;
+        next_ = 1;
+        bank_ = 0;
+        for (uint32_t bank = 0; bank < 2; ++bank) {
+            uint32_t reserved = 0;
+            if (read_bank(bank, reserved) && reserved > next_) {
+                next_ = reserved;
+                bank_ = bank == 0 ? 1U : 0U; // overwrite the other one next
+            }
+        }
+        reserved_ = next_;
+        return core::Result<void>{};
+    }
+
+    /// Next sequence number; persists a new reservation every RESERVE_STRIDE.
+    core::Result<core::sequence_t> next() noexcept
+    {
+        if (GS_UNLIKELY(next_ == UINT32_MAX)) {
+            return core::Result<core::sequence_t>{
+                GS_MAKE_ERROR(core::ErrorCode::ResourceExhausted)}; // rekey
+        }
+        if (next_ >= reserved_) {
+            auto reserve_res = reserve();
+            if (reserve_res.is_error()) {
+                return core::Result<core::sequence_t>{reserve_res.error()};
+            }
+        }
+        return core::Result<core::sequence_t>{next_++};
+    }
+
+    GS_NODISCARD core::sequence_t peek() const noexcept
+    {
+        return next_;
+    }
+
+private:
+    core::Result<void> reserve() noexcept
+    {
+        const uint32_t target = UINT32_MAX - next_ < RESERVE_STRIDE ? UINT32_MAX
+                                                                   : next_ + RESERVE_STRIDE;
+        if (platform_ != nullptr && platform_->storage != nullptr &&
+            platform_->crypto != nullptr) {
+            uint8_t record[RECORD_SIZE];
+            const uint32_t magic = SEQ_MAGIC;
+            memcpy(record, &magic, 4);
+            memcpy(record + 4, &target, 4);
+            auto crc_res = platform_->crypto->crc32(record + 4, 4);
+            if (crc_res.is_error()) {
+                return crc_res.error();
+            }
+            const uint32_t crc = crc_res.value();
+            memcpy(record + 8, &crc, 4);
+            GS_TRY(platform_->storage->write(address_ + bank_ * RECORD_SIZE, record, RECORD_SIZE)
+                       .as_void());
+            GS_TRY(platform_->storage->flush());
+            bank_ ^= 1U;
+        }
+        reserved_ = target;
+        return core::Result<void>{};
+    }
+
+    bool read_bank(uint32_t bank, uint32_t& reserved) const noexcept
+    {
+        if (platform_->storage == nullptr || platform_->crypto == nullptr) {
+            return false;
+        }
+        uint8_t record[RECORD_SIZE];
+        if (platform_->storage->read(address_ + bank * RECORD_SIZE, record, RECORD_SIZE)
+                .is_error()) {
+            return false;
+        }
+        uint32_t magic = 0;
+        uint32_t crc = 0;
+        memcpy(&magic, record, 4);
+        memcpy(&reserved, record + 4, 4);
+        memcpy(&crc, record + 8, 4);
+        auto crc_res = platform_->crypto->crc32(record + 4, 4);
+        return magic == SEQ_MAGIC && crc_res.is_ok() && crc_res.value() == crc;
+    }
+
+    platform::PlatformServices* platform_{nullptr};
+    uint32_t address_{DEFAULT_ADDRESS};
+    core::sequence_t next_{1};
+    core::sequence_t reserved_{1};
+    uint32_t bank_{0};
+};
+
+} // namespace gridshield::network
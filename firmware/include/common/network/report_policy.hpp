@@ -0,0 +1,243 @@
+/**
+ * @file report_policy.hpp
+ * @author zuudevs (zuudevs@gmail.com)
+ * @brief Report-by-exception policy for periodic meter readings
+ * @version 1.0
+ * @date 2026-03-17
+ *
+ * Decides per reading whether it is worth airtime. The server reconstructs
+ * suppressed intervals by holding the last reported reading, so:
+ *
+ *   - voltage / current / power factor / energy are sent when they leave a
+ *     deadband (absolute or percent, 0 = off) around the last reported value;
+ *   - energy additionally carries an integral-error bound: the running sum
+ *     of (actual - held) over suppressed intervals is sent once it would
+ *     exceed the bound, and whatever the report cannot absorb is folded
+ *     into the reported energy_wh (saturating), so the server-side energy
+ *     total never drifts by more than the bound;
+ *   - a maximum silence interval acts as a heartbeat;
+ *   - urgent readings (tamper, High+ anomaly) always go out.
+ *
+ * Flow: evaluate() → if not Suppressed, send outgoing() → commit() on
+ * success. A failed send simply leaves the reference untouched.
+ *
+ * @copyright Copyright (c) 2026
+ */
+
+#pragma once
+
+#include "core/types.hpp"
+#include "utils/gs_macros.hpp"
+
+#include <array>
+#include <cstdint>
+
+namespace gridshield::network {
+
+// ============================================================================
+// CONFIGURATION
+// ============================================================================
+struct Deadband
+{
+    uint32_t absolute{0};     // same unit as the field, 0 = off
+    uint16_t percent_x10{0};  // of the last reported value, 0 = off
+
+    GS_CONSTEXPR Deadband() noexcept = default;
+    GS_CONSTEXPR Deadband(uint32_t abs, uint16_t pct_x10) noexcept
+        : absolute(abs), percent_x10(pct_x10)
+    {}
+
+    /// True when @p value has left the band around @p reference.
+    GS_NODISCARD GS_CONSTEXPR bool exceeded(uint32_t value, uint32_t reference) const noexcept
+    {
+        const uint32_t delta = value > reference ? value - reference : reference - value;
+        if (absolute != 0 && delta > absolute) {
+            return true;
+        }
+        return percent_x10 != 0 &&
+               static_cast<uint64_t>(delta) * 1000U >
+                   static_cast<uint64_t>(reference) * percent_x10;
+    }
+};
+
+struct ReportPolicyConfig
+{
+    static constexpr uint32_t DEFAULT_MAX_SILENCE_MS = 900000; // 15 min
+    static constexpr uint32_t DEFAULT_ENERGY_ERROR_WH = 50;
+
+    bool enabled{false}; // false = every reading is sent (legacy behaviour)
+    Deadband energy_wh{0, 250};       // 25 %
+    Deadband voltage_mv{0, 20};       // 2 %
+    Deadband current_ma{200, 100};    // 200 mA or 10 %
+    Deadband power_factor{30, 0};     // 0.03
+    uint32_t energy_error_bound_wh{DEFAULT_ENERGY_ERROR_WH}; // 0 = off
+    uint32_t max_silence_ms{DEFAULT_MAX_SILENCE_MS};         // 0 = off
+
+    GS_CONSTEXPR ReportPolicyConfig() noexcept = default;
+};
+
+// ============================================================================
+// DECISION
+// ============================================================================
+enum class ReportReason : uint8_t
+{
+    Suppressed = 0,
+    Disabled = 1,      // policy off: send everything
+    First = 2,         // no reference yet
+    Urgent = 3,        // tamper / anomaly
+    Heartbeat = 4,     // max silence reached
+    Deadband = 5,      // a field left its band
+    IntegralError = 6, // energy reconstruction error would exceed the bound
+    COUNT = 7
+};
+
+struct ReportPolicyStats
+{
+    uint32_t evaluated{0};
+    uint32_t sent{0}; // committed reports
+    std::array<uint32_t, static_cast<size_t>(ReportReason::COUNT)> by_reason{};
+
+    GS_NODISCARD uint32_t suppressed() const noexcept
+    {
+        return by_reason[static_cast<size_t>(ReportReason::Suppressed)];
+    }
+};
+
+// ============================================================================
+// REPORT POLICY
+// ============================================================================
+class ReportPolicy
+{
+public:
+    ReportPolicy() noexcept = default;
+    explicit ReportPolicy(const ReportPolicyConfig& config) noexcept : config_(config) {}
+
+    void configure(const ReportPolicyConfig& config) noexcept
+    {
+        config_ = config;
+        reset();
+    }
+
+    /// Forget the reference (e.g. after reconnecting): next reading is sent.
+    void reset() noexcept
+    {
+        has_reference_ = false;
+        reference_ = core::MeterReading{};
+        residual_wh_ = 0;
+        pending_residual_wh_ = 0;
+    }
+
+    /**
+     * @brief Classify @p reading; Suppressed means do not transmit.
+     *
+     * A suppressed reading is final (its energy error is booked now); any
+     * other verdict is only booked by commit().
+     */
+    ReportReason evaluate(const core::MeterReading& reading, bool urgent = false) noexcept
+    {
+        ++stats_.evaluated;
+        const ReportReason reason = classify(reading, urgent);
+        ++stats_.by_reason[static_cast<size_t>(reason)];
+        if (reason == ReportReason::Suppressed) {
+            residual_wh_ = pending_residual_wh_;
+        }
+        return reason;
+    }
+
+    /// What to transmit for a reading evaluate() let through.
+    GS_NODISCARD core::MeterReading outgoing(const core::MeterReading& reading) const noexcept
+    {
+        core::MeterReading out = reading;
+        if (config_.enabled && has_reference_) {
+            out.energy_wh = absorb(reading.energy_wh, residual_wh_);
+        }
+        return out;
+    }
+
+    /// Record that @p sent (the outgoing() value) reached the transport.
+    void commit(const core::MeterReading& actual, const core::MeterReading& sent) noexcept
+    {
+        if (has_reference_) {
+            residual_wh_ -= static_cast<int64_t>(sent.energy_wh) -
+                            static_cast<int64_t>(actual.energy_wh);
+        }
+        reference_ = sent;
+        has_reference_ = true;
+        ++stats_.sent;
+    }
+
+    // === Accessors ===
+
+    GS_NODISCARD const ReportPolicyConfig& config() const noexcept
+    {
+        return config_;
+    }
+    GS_NODISCARD const ReportPolicyStats& stats() const noexcept
+    {
+        return stats_;
+    }
+    /// Energy the server has not yet been told about (actual - reconstructed).
+    GS_NODISCARD int64_t residual_wh() const noexcept
+    {
+        return residual_wh_;
+    }
+
+private:
+    ReportReason classify(const core::MeterReading& reading, bool urgent) noexcept
+    {
+        if (!config_.enabled) {
+            return ReportReason::Disabled;
+        }
+        if (!has_reference_) {
+            return ReportReason::First;
+        }
+
+        // Error if this interval is reconstructed as the held value
+        pending_residual_wh_ = residual_wh_ + static_cast<int64_t>(reading.energy_wh) -
+                               static_cast<int64_t>(reference_.energy_wh);
+
+        if (urgent) {
+            return ReportReason::Urgent;
+        }
+        if (config_.max_silence_ms != 0 && reading.timestamp >= reference_.timestamp &&
+            reading.timestamp - reference_.timestamp >= config_.max_silence_ms) {
+            return ReportReason::Heartbeat;
+        }
+        if (config_.energy_wh.exceeded(reading.energy_wh, reference_.energy_wh) ||
+            config_.voltage_mv.exceeded(reading.voltage_mv, reference_.voltage_mv) ||
+            config_.current_ma.exceeded(reading.current_ma, reference_.current_ma) ||
+            config_.power_factor.exceeded(reading.power_factor, reference_.power_factor)) {
+            return ReportReason::Deadband;
+        }
+        if (config_.energy_error_bound_wh != 0) {
+            const int64_t magnitude =
+                pending_residual_wh_ < 0 ? -pending_residual_wh_ : pending_residual_wh_;
+            if (magnitude > static_cast<int64_t>(config_.energy_error_bound_wh)) {
+                return ReportReason::IntegralError;
+            }
+        }
+        return ReportReason::Suppressed;
+    }
+
+    /// energy_wh + residual, clamped to the field's range.
+    static uint32_t absorb(uint32_t energy_wh, int64_t residual) noexcept
+    {
+        const int64_t total = static_cast<int64_t>(energy_wh) + residual;
+        if (total < 0) {
+            return 0;
+        }
+        if (total > static_cast<int64_t>(UINT32_MAX)) {
+            return UINT32_MAX;
+        }
+        return static_cast<uint32_t>(total);
+    }
+
+    ReportPolicyConfig config_{};
+    ReportPolicyStats stats_{};
+    core::MeterReading reference_{}; // last reported (as the server holds it)
+    bool has_reference_{false};
+    int64_t residual_wh_{0};         // booked: sum of (actual - held) not yet sent
+    int64_t pending_residual_wh_{0}; // residual_wh_ including the reading in evaluate()
+};
+
+} // namespace gridshield::network
@@ -0,0 +1,751 @@
+/**
+ * @file transport_manager.hpp
+ * @author zuudevs (zuudevs@gmail.com)
+ * @brief Multi-link uplink with link-quality estimation and per-class routing
+ * @version 1.0
+ * @date 2026-03-28
+ *
+ * Owns up to TRANSPORT_MAX_LINKS uplinks (WiFi, MQTT, CoAP, LoRa, ESP-NOW
+ * mesh; see network/comm_links.hpp) and keeps an EWMA estimate of each
+ * one's round-trip time, loss and throughput. Every message carries a
+ * traffic class; the manager ranks the links that accept the class and
+ * fit the message, tries the best one and, if it fails, the next one in
+ * the same send() call. A link that keeps failing is taken down and
+ * probed with exponential backoff until it answers again.
+ *
+ * channel() gives an IPlatformComm view, so PacketTransport and
+ * AckOutbox run unchanged on top of the manager. The channel is also the
+ * outbox's IDeliveryFeedback: acknowledgement RTTs and timeouts are
+ * charged to the link each frame went out on.
+ *
+ * @note Header-only, zero heap allocation.
+ */
+
+#pragma once
+
+#include "analytics/time_series.hpp"
+#include "core/degradation.hpp"
+#include "core/error.hpp"
+#include "network/ack.hpp"
+#include "network/packet.hpp"
+#include "platform/platform.hpp"
+#include "utils/gs_macros.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace gridshield::network {
+
+// ============================================================================
+// CONSTANTS
+// ============================================================================
+static constexpr size_t TRANSPORT_MAX_LINKS = 4;
+static constexpr size_t TRAFFIC_CLASS_COUNT = 3;
+static constexpr int32_t TRANSPORT_LOSS_SCALE = 1000000;    // loss estimate in ppm
+static constexpr int32_t TRANSPORT_MAX_LOSS_PPM = 990000;   // caps the 1/(1-p) penalty
+static constexpr uint16_t TRANSPORT_DEFAULT_HALF_LIFE = 8;  // samples
+static constexpr uint8_t TRANSPORT_DEFAULT_DOWN_AFTER = 2;  // consecutive failures
+static constexpr uint32_t TRANSPORT_DEFAULT_PROBE_MS = 1000;
+static constexpr uint32_t TRANSPORT_DEFAULT_PROBE_MAX_MS = 60000;
+
+// ============================================================================
+// TRAFFIC CLASS
+// ============================================================================
+enum class TrafficClass : uint8_t
+{
+    TamperAlert = 0, // small, urgent: fastest link
+    Telemetry = 1,   // periodic readings: cheapest link within budget
+    Evidence = 2     // forensic export: bulk, needs a large MTU
+};
+
+GS_NODISCARD GS_CONSTEXPR uint8_t traffic_class_bit(TrafficClass cls) noexcept
+{
+    return static_cast<uint8_t>(1U << static_cast<uint8_t>(cls));
+}
+
+static constexpr uint8_t TRAFFIC_ALL_CLASSES = 0x07;
+
+/// Class of a serialized SecurePacket: tamper alerts and Critical or
+/// Emergency frames are alerts, everything else is telemetry.
+GS_NODISCARD inline TrafficClass classify_frame(const uint8_t* frame, size_t length) noexcept
+{
+    if (frame == nullptr || length < sizeof(PacketHeader) || frame[0] != MAGIC_HEADER) {
+        return TrafficClass::Telemetry;
+    }
+    const auto type = static_cast<PacketType>(frame[offsetof(PacketHeader, type)]);
+    const auto priority = static_cast<core::Priority>(frame[offsetof(PacketHeader, priority)]);
+    if (type == PacketType::TamperAlert || priority >= core::Priority::Critical) {
+        return TrafficClass::TamperAlert;
+    }
+    return TrafficClass::Telemetry;
+}
+
+// ============================================================================
+// CONFIGURATION
+// ============================================================================
+struct LinkConfig
+{
+    uint16_t mtu{0};                      // largest single send; 0 = no limit (learned)
+    uint8_t cost{1};                      // relative per-message cost (tariff, airtime)
+    uint8_t classes{TRAFFIC_ALL_CLASSES}; // traffic_class_bit() mask
+    uint32_t nominal_rtt_ms{200};         // prior until the first RTT sample
+    uint32_t nominal_bytes_per_s{100000}; // prior until the first throughput sample
+    bool send_is_round_trip{false};       // send() returns once acknowledged (CoAP CON)
+};
+
+struct ClassPolicy
+{
+    uint32_t latency_budget_ms{};
+    bool least_cost{false}; // cheapest link inside the budget instead of the fastest
+};
+
+struct TransportConfig
+{
+    std::array<ClassPolicy, TRAFFIC_CLASS_COUNT> classes{{
+        {2000, false},   // TamperAlert
+        {30000, true},   // Telemetry
+        {600000, false}, // Evidence
+    }};
+    uint16_t estimator_half_life{TRANSPORT_DEFAULT_HALF_LIFE};
+    uint8_t down_after_failures{TRANSPORT_DEFAULT_DOWN_AFTER};
+    uint32_t probe_base_ms{TRANSPORT_DEFAULT_PROBE_MS};
+    uint32_t probe_max_ms{TRANSPORT_DEFAULT_PROBE_MAX_MS};
+};
+
+// ============================================================================
+// LINK ESTIMATOR
+// ============================================================================
+
+/**
+ * @brief EWMA of one link's round-trip time, loss and throughput.
+ *
+ * Starts from the configured priors; the first RTT and throughput samples
+ * replace them outright, later ones blend in with the configured half-life.
+ * Loss is the smoothed rate of failed sends and acknowledgement timeouts.
+ */
+class LinkEstimator
+{
+public:
+    void reset(const LinkConfig& config, analytics::EmaAlpha alpha) noexcept
+    {
+        alpha_ = alpha;
+        rtt_us_ = clamp_i32(static_cast<uint64_t>(config.nominal_rtt_ms) * 1000U);
+        bytes_per_s_ = clamp_i32(config.nominal_bytes_per_s);
+        loss_ppm_ = 0;
+        rtt_samples_ = 0;
+        throughput_samples_ = 0;
+    }
+
+    void record_rtt(uint64_t rtt_us) noexcept
+    {
+        rtt_us_ = blend(rtt_us_, clamp_i32(rtt_us), rtt_samples_);
+    }
+
+    /// Serialization rate of a send that took @p duration_us; 0 is no sample.
+    void record_throughput(size_t bytes, uint64_t duration_us) noexcept
+    {
+        if (duration_us == 0 || bytes == 0) {
+            return;
+        }
+        const uint64_t rate = static_cast<uint64_t>(bytes) * 1000000U / duration_us;
+        bytes_per_s_ = blend(bytes_per_s_, clamp_i32(rate == 0 ? 1 : rate), throughput_samples_);
+    }
+
+    void record_delivery() noexcept
+    {
+        loss_ppm_ = utils::lerp(loss_ppm_, 0, alpha_);
+    }
+
+    void record_loss() noexcept
+    {
+        loss_ppm_ = utils::lerp(loss_ppm_, TRANSPORT_LOSS_SCALE, alpha_);
+    }
+
+    /// Forget the loss history (a probed link came back).
+    void clear_loss() noexcept
+    {
+        loss_ppm_ = 0;
+    }
+
+    GS_NODISCARD uint32_t rtt_ms() const noexcept
+    {
+        return static_cast<uint32_t>(rtt_us_) / 1000U;
+    }
+    GS_NODISCARD uint32_t loss_permille() const noexcept
+    {
+        return static_cast<uint32_t>(loss_ppm_) / 1000U;
+    }
+    GS_NODISCARD uint32_t bytes_per_s() const noexcept
+    {
+        return static_cast<uint32_t>(bytes_per_s_);
+    }
+
+    /// Expected time to deliver @p bytes: (RTT + serialization) / (1 - loss).
+    GS_NODISCARD uint64_t expected_delivery_us(size_t bytes) const noexcept
+    {
+        const uint64_t serialize_us =
+            static_cast<uint64_t>(bytes) * 1000000U / static_cast<uint64_t>(bytes_per_s_);
+        const int32_t loss = loss_ppm_ < TRANSPORT_MAX_LOSS_PPM ? loss_ppm_
+                                                                : TRANSPORT_MAX_LOSS_PPM;
+        return (static_cast<uint64_t>(rtt_us_) + serialize_us) *
+               static_cast<uint64_t>(TRANSPORT_LOSS_SCALE) /
+               static_cast<uint64_t>(TRANSPORT_LOSS_SCALE - loss);
+    }
+
+private:
+    static int32_t clamp_i32(uint64_t value) noexcept
+    {
+        return value > static_cast<uint64_t>(INT32_MAX) ? INT32_MAX : static_cast<int32_t>(value);
+    }
+
+    int32_t blend(int32_t current, int32_t sample, uint32_t& samples) const noexcept
+    {
+        const int32_t next = samples == 0 ? sample : utils::lerp(current, sample, alpha_);
+        ++samples;
+        return next < 1 ? 1 : next;
+    }
+
+    analytics::EmaAlpha alpha_{analytics::EmaAlpha::one()};
+    int32_t rtt_us_{1};
+    int32_t bytes_per_s_{1};
+    int32_t loss_ppm_{0};
+    uint32_t rtt_samples_{0};
+    uint32_t throughput_samples_{0};
+};
+
+// ============================================================================
+// STATISTICS
+// ============================================================================
+enum class LinkState : uint8_t
+{
+    Up = 0,
+    Down = 1 // skipped by routing, probed by poll()
+};
+
+struct LinkStats
+{
+    uint32_t sent{};
+    uint32_t failed{};
+    uint32_t probes{};
+    uint32_t recoveries{};
+    uint64_t bytes{};
+};
+
+struct TransportStats
+{
+    uint32_t delivered{};
+    uint32_t failovers{};     // delivered, but not on the first link tried
+    uint32_t undeliverable{}; // every eligible link failed, or none was up
+};
+
+class TransportManager;
+
+// ============================================================================
+// CHANNEL
+// ============================================================================
+
+/**
+ * @brief IPlatformComm face of the manager for one traffic class.
+ *
+ * The classifying channel (TransportManager::channel()) reads the header of
+ * each SecurePacket frame instead, so a single PacketTransport can carry
+ * both alerts and telemetry. receive() listens on the link (and class) of
+ * this channel's most recent send, where the reply to it will arrive.
+ */
+class TransportChannel final : public platform::IPlatformComm, public IDeliveryFeedback
+{
+public:
+    TransportChannel(TransportManager& manager, TrafficClass cls, bool classify) noexcept
+        : manager_(manager), class_(cls), last_class_(cls), classify_(classify)
+    {}
+
+    core::Result<void> init() noexcept override;
+    core::Result<void> shutdown() noexcept override;
+    core::Result<size_t> send(const uint8_t* data, size_t length) noexcept override;
+    core::Result<size_t>
+    receive(uint8_t* buffer, size_t max_length, uint32_t timeout_ms) noexcept override;
+    bool is_connected() noexcept override;
+
+    uint8_t last_link() const noexcept override
+    {
+        return last_link_;
+    }
+    void on_delivered(uint8_t link, uint32_t rtt_ms) noexcept override;
+    void on_lost(uint8_t link) noexcept override;
+
+private:
+    TransportManager& manager_;
+    TrafficClass class_;
+    TrafficClass last_class_;
+    uint8_t last_link_{ACK_NO_LINK};
+    bool classify_;
+};
+
+// ============================================================================
+// TRANSPORT MANAGER
+// ============================================================================
+class TransportManager
+{
+public:
+    explicit TransportManager(platform::IPlatformTime& time,
+                              const TransportConfig& config = TransportConfig{}) noexcept
+        : time_(time), config_(config),
+          alpha_(analytics::ema_alpha_for_half_life(config.estimator_half_life)),
+          class_channels_{{TransportChannel(*this, TrafficClass::TamperAlert, false),
+                           TransportChannel(*this, TrafficClass::Telemetry, false),
+                           TransportChannel(*this, TrafficClass::Evidence, false)}},
+          frame_channel_(*this, TrafficClass::Telemetry, true)
+    {}
+
+    TransportManager(const TransportManager&) = delete;
+    TransportManager& operator=(const TransportManager&) = delete;
+
+    /// Register an uplink; links are numbered in registration order.
+    core::Result<uint8_t> add_link(platform::IPlatformComm& comm, const LinkConfig& config) noexcept
+    {
+        if (GS_UNLIKELY(link_count_ >= TRANSPORT_MAX_LINKS || config.classes == 0)) {
+            return core::Result<uint8_t>(GS_MAKE_ERROR(core::ErrorCode::ResourceExhausted));
+        }
+        Link& link = links_[link_count_];
+        link = Link{};
+        link.comm = &comm;
+        link.config = config;
+        link.estimator.reset(config, alpha_);
+        return core::Result<uint8_t>(static_cast<uint8_t>(link_count_++));
+    }
+
+    /// Mirror aggregate link health into the Network service.
+    void set_degradation(core::DegradationManager* degradation) noexcept
+    {
+        degradation_ = degradation;
+        reported_ = core::ServiceHealth::Healthy;
+        update_health();
+    }
+
+    /// Frame to send when probing a down link; without one a probe only
+    /// checks is_connected().
+    void set_probe_frame(const uint8_t* frame, size_t length) noexcept
+    {
+        probe_frame_ = frame;
+        probe_length_ = frame == nullptr ? 0 : length;
+    }
+
+    /// init() every link; those that fail start down. Errors only if none came up.
+    core::Result<void> init_links() noexcept
+    {
+        const uint32_t now = now_ms();
+        for (size_t i = 0; i < link_count_; ++i) {
+            if (links_[i].comm->init().is_error()) {
+                mark_down(links_[i], now);
+            }
+        }
+        update_health();
+        return up_count() > 0 ? core::Result<void>{}
+                              : GS_MAKE_ERROR(core::ErrorCode::NetworkDisconnected);
+    }
+
+    void shutdown_links() noexcept
+    {
+        for (size_t i = 0; i < link_count_; ++i) {
+            (void)links_[i].comm->shutdown();
+        }
+    }
+
+    /**
+     * @brief Send @p data on the best link for @p cls, failing over to the
+     *        next-ranked link on error within this call.
+     * @return Index of the link that took the message.
+     */
+    core::Result<uint8_t> send(TrafficClass cls, const uint8_t* data, size_t length) noexcept
+    {
+        if (GS_UNLIKELY(data == nullptr || length == 0 ||
+                        static_cast<size_t>(cls) >= TRAFFIC_CLASS_COUNT)) {
+            return core::Result<uint8_t>(GS_MAKE_ERROR(core::ErrorCode::InvalidParameter));
+        }
+
+        std::array<uint8_t, TRANSPORT_MAX_LINKS> order{};
+        const size_t candidates = rank(cls, length, order);
+        for (size_t attempt = 0; attempt < candidates; ++attempt) {
+            Link& link = links_[order[attempt]];
+            if (!link.comm->is_connected()) {
+                mark_down(link, now_ms());
+                continue;
+            }
+            const uint64_t start_us = time_.get_timestamp_us();
+            auto result = link.comm->send(data, length);
+            const uint64_t elapsed_us = time_.get_timestamp_us() - start_us;
+            if (result.is_error() && result.error().code == core::ErrorCode::InvalidParameter) {
+                // The adapter refused the frame (too large for it): learn the
+                // limit instead of charging the link with a loss
+                if (length > 1) {
+                    link.config.mtu =
+                        static_cast<uint16_t>(length - 1 < UINT16_MAX ? length - 1 : UINT16_MAX);
+                }
+                continue;
+            }
+            if (result.is_ok() && result.value() == length) {
+                record_success(link, length, elapsed_us);
+                last_link_[static_cast<size_t>(cls)] = order[attempt];
+                ++stats_.delivered;
+                if (attempt > 0) {
+                    ++stats_.failovers;
+                }
+                update_health();
+                return core::Result<uint8_t>(order[attempt]);
+            }
+            record_failure(link);
+        }
+
+        ++stats_.undeliverable;
+        update_health();
+        return core::Result<uint8_t>(GS_MAKE_ERROR(candidates == 0
+                                                       ? core::ErrorCode::NetworkDisconnected
+                                                       : core::ErrorCode::TransmissionFailed));
+    }
+
+    /// Acknowledgement for a message sent on @p link after @p rtt_ms.
+    void record_ack(uint8_t link, uint32_t rtt_ms) noexcept
+    {
+        if (link < link_count_) {
+            links_[link].estimator.record_rtt(static_cast<uint64_t>(rtt_ms) * 1000U);
+            links_[link].estimator.record_delivery();
+            links_[link].consecutive_failures = 0;
+        }
+    }
+
+    /// A message sent on @p link was never acknowledged.
+    void record_timeout(uint8_t link) noexcept
+    {
+        if (link < link_count_) {
+            record_failure(links_[link]);
+            update_health();
+        }
+    }
+
+    /// Probe down links whose backoff has expired; call from the main loop.
+    void poll() noexcept
+    {
+        const uint32_t now = now_ms();
+        for (size_t i = 0; i < link_count_; ++i) {
+            Link& link = links_[i];
+            if (link.state != LinkState::Down ||
+                static_cast<int32_t>(now - link.next_probe_ms) < 0) {
+                continue;
+            }
+            ++link.stats.probes;
+            if (probe(link)) {
+                link.state = LinkState::Up;
+                link.consecutive_failures = 0;
+                link.estimator.clear_loss();
+                ++link.stats.recoveries;
+            } else {
+                link.probe_backoff_ms = link.probe_backoff_ms >= config_.probe_max_ms / 2
+                                            ? config_.probe_max_ms
+                                            : link.probe_backoff_ms * 2;
+                link.next_probe_ms = now_ms() + link.probe_backoff_ms;
+            }
+        }
+        update_health();
+    }
+
+    /// Receive on the link @p cls last went out on, else the first up link.
+    core::Result<size_t> receive(TrafficClass cls,
+                                 uint8_t* buffer,
+                                 size_t max_length,
+                                 uint32_t timeout_ms) noexcept
+    {
+        return receive(cls,
+                       last_link_[static_cast<size_t>(cls) % TRAFFIC_CLASS_COUNT],
+                       buffer,
+                       max_length,
+                       timeout_ms);
+    }
+
+    /// Receive on @p last while it is up, else the first up link for @p cls.
+    core::Result<size_t> receive(TrafficClass cls,
+                                 uint8_t last,
+                                 uint8_t* buffer,
+                                 size_t max_length,
+                                 uint32_t timeout_ms) noexcept
+    {
+        size_t index = link_count_;
+        if (last < link_count_ && links_[last].state == LinkState::Up) {
+            index = last;
+        } else {
+            for (size_t i = 0; i < link_count_; ++i) {
+                if (accepts(links_[i], cls)) {
+                    index = i;
+                    break;
+                }
+            }
+        }
+        if (index == link_count_) {
+            return core::Result<size_t>(GS_MAKE_ERROR(core::ErrorCode::NetworkDisconnected));
+        }
+        return links_[index].comm->receive(buffer, max_length, timeout_ms);
+    }
+
+    GS_NODISCARD bool is_available(TrafficClass cls) const noexcept
+    {
+        for (size_t i = 0; i < link_count_; ++i) {
+            if (accepts(links_[i], cls)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /// Comm view fixed to one traffic class.
+    TransportChannel& channel(TrafficClass cls) noexcept
+    {
+        return class_channels_[static_cast<size_t>(cls) % TRAFFIC_CLASS_COUNT];
+    }
+
+    /// Comm view that classifies each frame with classify_frame().
+    TransportChannel& channel() noexcept
+    {
+        return frame_channel_;
+    }
+
+    GS_NODISCARD size_t link_count() const noexcept
+    {
+        return link_count_;
+    }
+    GS_NODISCARD LinkState link_state(uint8_t link) const noexcept
+    {
+        return link < link_count_ ? links_[link].state : LinkState::Down;
+    }
+    GS_NODISCARD const LinkEstimator& estimator(uint8_t link) const noexcept
+    {
+        return links_[link < link_count_ ? link : 0].estimator;
+    }
+    GS_NODISCARD const LinkStats& link_stats(uint8_t link) const noexcept
+    {
+        return links_[link < link_count_ ? link : 0].stats;
+    }
+    GS_NODISCARD const TransportStats& stats() const noexcept
+    {
+        return stats_;
+    }
+
+private:
+    struct Link
+    {
+        platform::IPlatformComm* comm{nullptr};
+        LinkConfig config{};
+        LinkEstimator estimator{};
+        LinkState state{LinkState::Up};
+        uint8_t consecutive_failures{0};
+        uint32_t next_probe_ms{0};
+        uint32_t probe_backoff_ms{0};
+        LinkStats stats{};
+    };
+
+    uint32_t now_ms() noexcept
+    {
+        return static_cast<uint32_t>(time_.get_timestamp_ms());
+    }
+
+    GS_NODISCARD static bool accepts(const Link& link, TrafficClass cls) noexcept
+    {
+        return link.state == LinkState::Up && (link.config.classes & traffic_class_bit(cls)) != 0;
+    }
+
+    /**
+     * Up links that accept @p cls and fit @p length, best first: inside the
+     * latency budget before outside it, then (least-cost classes) cheapest,
+     * then shortest expected delivery. Links over budget stay as a last resort.
+     */
+    size_t rank(TrafficClass cls,
+                size_t length,
+                std::array<uint8_t, TRANSPORT_MAX_LINKS>& order) const noexcept
+    {
+        const ClassPolicy& policy = config_.classes[static_cast<size_t>(cls)];
+        const uint64_t budget_us = static_cast<uint64_t>(policy.latency_budget_ms) * 1000U;
+        std::array<uint64_t, TRANSPORT_MAX_LINKS> expected{};
+        std::array<uint8_t, TRANSPORT_MAX_LINKS> cost{};
+        size_t count = 0;
+
+        for (size_t i = 0; i < link_count_; ++i) {
+            const Link& link = links_[i];
+            if (!accepts(link, cls) || (link.config.mtu != 0 && length > link.config.mtu)) {
+                continue;
+            }
+            const uint64_t exp_us = link.estimator.expected_delivery_us(length);
+            const bool over = budget_us != 0 && exp_us > budget_us;
+            // Insertion sort on (over budget, cost, expected time)
+            const uint8_t key_cost = policy.least_cost ? link.config.cost : 0;
+            size_t pos = count;
+            while (pos > 0) {
+                const size_t prev = pos - 1;
+                const bool prev_over = budget_us != 0 && expected[prev] > budget_us;
+                const bool before = over != prev_over ? !over
+                                    : key_cost != cost[prev] ? key_cost < cost[prev]
+                                                             : exp_us < expected[prev];
+                if (!before) {
+                    break;
+                }
+                order[pos] = order[prev];
+                expected[pos] = expected[prev];
+                cost[pos] = cost[prev];
+                pos = prev;
+            }
+            order[pos] = static_cast<uint8_t>(i);
+            expected[pos] = exp_us;
+            cost[pos] = key_cost;
+            ++count;
+        }
+        return count;
+    }
+
+    void record_success(Link& link, size_t length, uint64_t elapsed_us) noexcept
+    {
+        if (link.config.send_is_round_trip) {
+            link.estimator.record_rtt(elapsed_us);
+        } else {
+            link.estimator.record_throughput(length, elapsed_us);
+        }
+        link.estimator.record_delivery();
+        link.consecutive_failures = 0;
+        ++link.stats.sent;
+        link.stats.bytes += length;
+    }
+
+    void record_failure(Link& link) noexcept
+    {
+        link.estimator.record_loss();
+        ++link.stats.failed;
+        if (link.consecutive_failures < UINT8_MAX) {
+            ++link.consecutive_failures;
+        }
+        if (link.consecutive_failures >= config_.down_after_failures) {
+            mark_down(link, now_ms());
+        }
+    }
+
+    void mark_down(Link& link, uint32_t now) noexcept
+    {
+        if (link.state == LinkState::Down) {
+            return;
+        }
+        link.state = LinkState::Down;
+        link.probe_backoff_ms = config_.probe_base_ms;
+        link.next_probe_ms = now + config_.probe_base_ms;
+    }
+
+    bool probe(Link& link) noexcept
+    {
+        if (!link.comm->is_connected()) {
+            return false;
+        }
+        if (probe_frame_ == nullptr) {
+            return true;
+        }
+        const uint64_t start_us = time_.get_timestamp_us();
+        auto result = link.comm->send(probe_frame_, probe_length_);
+        if (result.is_error() || result.value() != probe_length_) {
+            return false;
+        }
+        if (link.config.send_is_round_trip) {
+            link.estimator.record_rtt(time_.get_timestamp_us() - start_us);
+        }
+        return true;
+    }
+
+    GS_NODISCARD size_t up_count() const noexcept
+    {
+        size_t up = 0;
+        for (size_t i = 0; i < link_count_; ++i) {
+            up += links_[i].state == LinkState::Up ? 1U : 0U;
+        }
+        return up;
+    }
+
+    /// Report transitions only, so the failure counter counts outages.
+    void update_health() noexcept
+    {
+        if (degradation_ == nullptr || link_count_ == 0) {
+            return;
+        }
+        const size_t up = up_count();
+        const core::ServiceHealth health = up == 0           ? core::ServiceHealth::Failed
+                                           : up < link_count_ ? core::ServiceHealth::Degraded
+                                                              : core::ServiceHealth::Healthy;
+        if (health == reported_) {
+            return;
+        }
+        reported_ = health;
+        if (health == core::ServiceHealth::Failed) {
+            (void)degradation_->report_failure(core::ServiceId::Network,
+                                               core::ErrorCode::NetworkDisconnected);
+        } else if (health == core::ServiceHealth::Degraded) {
+            degradation_->report_degraded(core::ServiceId::Network);
+        } else {
+            degradation_->report_recovery(core::ServiceId::Network);
+        }
+    }
+
+    platform::IPlatformTime& time_;
+    TransportConfig config_;
+    analytics::EmaAlpha alpha_;
+    std::array<Link, TRANSPORT_MAX_LINKS> links_{};
+    size_t link_count_{0};
+    std::array<uint8_t, TRAFFIC_CLASS_COUNT> last_link_{{0xFF, 0xFF, 0xFF}};
+    TransportStats stats_{};
+    core::DegradationManager* degradation_{nullptr};
+    core::ServiceHealth reported_{core::ServiceHealth::Healthy};
+    const uint8_t* probe_frame_{nullptr};
+    size_t probe_length_{0};
+    std::array<TransportChannel, TRAFFIC_CLASS_COUNT> class_channels_;
+    TransportChannel frame_channel_;
+};
+
+// ============================================================================
+// CHANNEL IMPLEMENTATION
+// ============================================================================
+inline core::Result<void> TransportChannel::init() noexcept
+{
+    return manager_.init_links();
+}
+
+inline core::Result<void> TransportChannel::shutdown() noexcept
+{
+    manager_.shutdown_links();
+    return core::Result<void>{};
+}
+
+inline core::Result<size_t> TransportChannel::send(const uint8_t* data, size_t length) noexcept
+{
+    const TrafficClass cls = classify_ ? classify_frame(data, length) : class_;
+    auto result = manager_.send(cls, data, length);
+    if (result.is_error()) {
+        return core::Result<size_t>(result.error());
+    }
+    last_class_ = cls;
+    last_link_ = result.value();
+    return core::Result<size_t>(length);
+}
+
+inline core::Result<size_t>
+TransportChannel::receive(uint8_t* buffer, size_t max_length, uint32_t timeout_ms) noexcept
+{
+    return manager_.receive(last_class_, last_link_, buffer, max_length, timeout_ms);
+}
+
+inline void TransportChannel::on_delivered(uint8_t link, uint32_t rtt_ms) noexcept
+{
+    manager_.record_ack(link, rtt_ms);
+}
+
+inline void TransportChannel::on_lost(uint8_t link) noexcept
+{
+    manager_.record_timeout(link);
+}
+
+inline bool TransportChannel::is_connected() noexcept
+{
+    return manager_.is_available(class_);
+}
+
+} // namespace gridshield::network
@@ -0,0 +1,476 @@
+/**
+ * @file wifi_manager.hpp
+ * @author zuudevs (zuudevs@gmail.com)
+ * @brief WiFi connection manager: cached fast reconnect and wake-window batching
+ * @version 1.0
+ * @date 2026-03-30
+ *
+ * Keeps the BSSID, channel and DHCP lease of the last association so a
+ * reconnect can skip the scan and DHCP, falling back to a full connect and,
+ * if DHCP does not answer, to a configured static address. Once connected
+ * it puts the radio in DTIM modem sleep and holds outgoing frames in a
+ * small queue, sending them together once per batch window (rounded to
+ * whole wake periods) so the radio wakes for one burst instead of once per
+ * reading. Tamper alerts and Critical/Emergency frames (classify_frame())
+ * go out at once, draining the queue ahead of them.
+ *
+ * WiFiManager is itself an IPlatformComm over the socket uplink, so it can
+ * stand in for PlatformServices::comm or be a TransportManager link. The
+ * cache is trivially copyable; keep it in RTC memory across deep sleep and
+ * hand it back with restore_cache().
+ *
+ * @note Header-only, zero heap allocation.
+ */
+
+#pragma once
+
+#include "core/error.hpp"
+#include "network/transport_manager.hpp"
+#include "platform/platform.hpp"
+#include "utils/gs_macros.hpp"
+
+#include <array>
+#include <cstdint>
+#include <cstring>
+
+namespace gridshield::network {
+
+// ============================================================================
+// CONSTANTS
+// ============================================================================
+static constexpr uint32_t WIFI_CACHE_MAGIC = 0x47535746; // "GSWF"
+static constexpr size_t WIFI_BATCH_CAPACITY = 4096;      // bytes
+static constexpr size_t WIFI_BATCH_MAX_MESSAGES = 32;
+static constexpr uint32_t WIFI_DEFAULT_BATCH_INTERVAL_MS = 60000;
+static constexpr uint8_t WIFI_DEFAULT_LISTEN_INTERVAL = 3; // beacons
+static constexpr uint32_t WIFI_RECONNECT_BASE_MS = 1000;
+static constexpr uint32_t WIFI_RECONNECT_MAX_MS = 60000;
+static constexpr uint32_t WIFI_TU_US = 1024;
+
+// ============================================================================
+// CONFIGURATION
+// ============================================================================
+struct WiFiManagerConfig
+{
+    const char* ssid{nullptr}; // must outlive the manager
+    const char* password{nullptr};
+    bool use_cache{true}; // false: full scan + DHCP on every connect
+    platform::WiFiIpConfig static_fallback{}; // tried when DHCP times out
+    platform::WiFiPowerSave power_save{platform::WiFiPowerSave::MaxModem};
+    uint8_t listen_interval{WIFI_DEFAULT_LISTEN_INTERVAL};
+    uint32_t batch_interval_ms{WIFI_DEFAULT_BATCH_INTERVAL_MS}; // 0 = send at once
+    uint32_t reconnect_base_ms{WIFI_RECONNECT_BASE_MS};
+    uint32_t reconnect_max_ms{WIFI_RECONNECT_MAX_MS};
+};
+
+/// Last association, kept for the next reconnect.
+struct WiFiCache
+{
+    uint32_t magic{0};
+    std::array<uint8_t, platform::WIFI_BSSID_LENGTH> bssid{};
+    uint8_t channel{0};
+    platform::WiFiIpConfig ip{}; // unset after a static-fallback connect
+    uint32_t lease_s{0};
+    uint64_t lease_start_ms{0};
+
+    GS_NODISCARD bool is_valid() const noexcept
+    {
+        return magic == WIFI_CACHE_MAGIC && channel != 0;
+    }
+
+    /// The address is reused until half the lease has run (DHCP T1).
+    GS_NODISCARD bool ip_reusable(uint64_t now_ms) const noexcept
+    {
+        if (!ip.is_set()) {
+            return false;
+        }
+        return lease_s == 0 || now_ms - lease_start_ms < static_cast<uint64_t>(lease_s) * 500U;
+    }
+};
+
+enum class WiFiState : uint8_t
+{
+    Disconnected = 0,
+    Connected = 1
+};
+
+enum class WiFiConnectPath : uint8_t
+{
+    None = 0,
+    Fast = 1,    // cached BSSID and channel (and lease)
+    Full = 2,    // scan + DHCP
+    Fallback = 3 // scan + configured static address
+};
+
+struct WiFiStats
+{
+    uint32_t fast_connects{};
+    uint32_t full_connects{};
+    uint32_t fallback_connects{};
+    uint32_t failed_attempts{};
+    uint32_t drops{};
+    uint32_t last_connect_ms{};  // first attempt to connected, last cycle
+    uint32_t worst_connect_ms{};
+    uint64_t connect_ms_total{}; // over successful cycles
+    uint32_t windows{};          // flushes that sent something
+    uint32_t batched{};          // frames sent from the queue
+    uint32_t immediate{};        // frames sent as they arrived
+    uint32_t overflows{};        // frames refused: queue full while offline
+
+    GS_NODISCARD uint32_t connects() const noexcept
+    {
+        return fast_connects + full_connects + fallback_connects;
+    }
+};
+
+// ============================================================================
+// WIFI MANAGER
+// ============================================================================
+class WiFiManager final : public platform::IPlatformComm
+{
+public:
+    WiFiManager(platform::IPlatformWiFi& wifi,
+                platform::IPlatformComm& uplink,
+                platform::IPlatformTime& time) noexcept
+        : wifi_(wifi), uplink_(uplink), time_(time)
+    {}
+
+    WiFiManager(const WiFiManager&) = delete;
+    WiFiManager& operator=(const WiFiManager&) = delete;
+
+    core::Result<void> configure(const WiFiManagerConfig& config) noexcept
+    {
+        if (GS_UNLIKELY(config.ssid == nullptr || config.ssid[0] == '\0' ||
+                        config.reconnect_base_ms == 0 ||
+                        config.reconnect_max_ms < config.reconnect_base_ms)) {
+            return GS_MAKE_ERROR(core::ErrorCode::InvalidParameter);
+        }
+        config_ = config;
+        configured_ = true;
+        return core::Result<void>{};
+    }
+
+    /// Seed the cache (e.g. from RTC memory after deep sleep).
+    void restore_cache(const WiFiCache& cache) noexcept
+    {
+        cache_ = cache.is_valid() ? cache : WiFiCache{};
+    }
+
+    // === IPlatformComm ===
+
+    /// Brings up the radio and uplink and tries once to connect; a failed
+    /// connect is not an error, poll() keeps retrying.
+    core::Result<void> init() noexcept override
+    {
+        if (GS_UNLIKELY(!configured_)) {
+            return GS_MAKE_ERROR(core::ErrorCode::ConfigurationError);
+        }
+        GS_TRY(wifi_.init());
+        GS_TRY(uplink_.init());
+        connect_now();
+        return core::Result<void>{};
+    }
+
+    core::Result<void> shutdown() noexcept override
+    {
+        if (state_ == WiFiState::Connected) {
+            (void)flush();
+        }
+        (void)uplink_.shutdown();
+        state_ = WiFiState::Disconnected;
+        return wifi_.disconnect();
+    }
+
+    /**
+     * @brief Queue @p data for the next wake window, or send it now if it
+     *        is an alert frame or batching is off.
+     * @return @p length once accepted; queued frames are not yet on the air.
+     */
+    core::Result<size_t> send(const uint8_t* data, size_t length) noexcept override
+    {
+        if (GS_UNLIKELY(data == nullptr || length == 0)) {
+            return core::Result<size_t>(GS_MAKE_ERROR(core::ErrorCode::InvalidParameter));
+        }
+        const bool urgent = classify_frame(data, length) == TrafficClass::TamperAlert;
+        const bool connected = state_ == WiFiState::Connected;
+        const bool direct =
+            urgent || config_.batch_interval_ms == 0 || length > WIFI_BATCH_CAPACITY;
+        if (connected && direct) {
+            // Earlier frames first, in the same wake-up
+            (void)flush();
+            auto result = uplink_.send(data, length);
+            if (result.is_ok()) {
+                ++stats_.immediate;
+            }
+            return result;
+        }
+        if (!fits(length)) {
+            if (!connected || flush().is_error() || !fits(length)) {
+                ++stats_.overflows;
+                return core::Result<size_t>(GS_MAKE_ERROR(core::ErrorCode::BufferOverflow));
+            }
+        }
+        std::memcpy(queue_.data() + queued_bytes_, data, length);
+        lengths_[queued_count_++] = static_cast<uint16_t>(length);
+        queued_bytes_ += length;
+        urgent_pending_ = urgent_pending_ || urgent;
+        return core::Result<size_t>(length);
+    }
+
+    core::Result<size_t>
+    receive(uint8_t* buffer, size_t max_length, uint32_t timeout_ms) noexcept override
+    {
+        if (state_ != WiFiState::Connected) {
+            return core::Result<size_t>(GS_MAKE_ERROR(core::ErrorCode::WiFiNotConnected));
+        }
+        return uplink_.receive(buffer, max_length, timeout_ms);
+    }
+
+    bool is_connected() noexcept override
+    {
+        return state_ == WiFiState::Connected;
+    }
+
+    // === Scheduling ===
+
+    /// Detect drops, reconnect when the backoff allows, flush due windows.
+    void poll() noexcept
+    {
+        if (state_ == WiFiState::Connected && !wifi_.is_connected()) {
+            state_ = WiFiState::Disconnected;
+            ++stats_.drops;
+            backoff_ms_ = 0;
+            next_attempt_ms_ = time_.get_timestamp_ms();
+        }
+        if (state_ == WiFiState::Disconnected) {
+            if (configured_ && time_.get_timestamp_ms() >= next_attempt_ms_) {
+                connect_now();
+            }
+            if (state_ == WiFiState::Disconnected) {
+                return;
+            }
+        }
+
+        const uint64_t now_us = time_.get_timestamp_us();
+        const bool window_due = now_us >= next_window_us_;
+        if (queued_count_ > 0 &&
+            (urgent_pending_ || window_due || config_.batch_interval_ms == 0)) {
+            (void)flush();
+        }
+        if (window_due && window_us_ > 0) {
+            const uint64_t behind = (now_us - next_window_us_) / window_us_ + 1U;
+            next_window_us_ += behind * window_us_;
+        }
+    }
+
+    /// Send everything queued; stops at the first failure, keeping the rest.
+    core::Result<void> flush() noexcept
+    {
+        if (queued_count_ == 0) {
+            return core::Result<void>{};
+        }
+        if (state_ != WiFiState::Connected) {
+            return GS_MAKE_ERROR(core::ErrorCode::WiFiNotConnected);
+        }
+        size_t sent = 0;
+        size_t offset = 0;
+        core::Result<void> status{};
+        while (sent < queued_count_) {
+            auto result = uplink_.send(queue_.data() + offset, lengths_[sent]);
+            if (result.is_error()) {
+                status = result.error();
+                break;
+            }
+            offset += lengths_[sent];
+            ++sent;
+        }
+        if (sent > 0) {
+            ++stats_.windows;
+            stats_.batched += static_cast<uint32_t>(sent);
+            std::memmove(queue_.data(), queue_.data() + offset, queued_bytes_ - offset);
+            for (size_t i = sent; i < queued_count_; ++i) {
+                lengths_[i - sent] = lengths_[i];
+            }
+            queued_count_ -= sent;
+            queued_bytes_ -= offset;
+        }
+        urgent_pending_ = urgent_pending_ && queued_count_ > 0;
+        return status;
+    }
+
+    // === Observability ===
+
+    GS_NODISCARD WiFiState state() const noexcept
+    {
+        return state_;
+    }
+    GS_NODISCARD WiFiConnectPath last_path() const noexcept
+    {
+        return last_path_;
+    }
+    GS_NODISCARD const WiFiCache& cache() const noexcept
+    {
+        return cache_;
+    }
+    GS_NODISCARD const WiFiStats& stats() const noexcept
+    {
+        return stats_;
+    }
+    GS_NODISCARD size_t queued() const noexcept
+    {
+        return queued_count_;
+    }
+    /// Radio sleep period under the configured power save; 0 = always on.
+    GS_NODISCARD uint32_t wake_period_us() const noexcept
+    {
+        return wake_period_us_;
+    }
+    /// Batch interval rounded up to whole wake periods.
+    GS_NODISCARD uint64_t batch_window_us() const noexcept
+    {
+        return window_us_;
+    }
+
+private:
+    GS_NODISCARD bool fits(size_t length) const noexcept
+    {
+        return queued_count_ < WIFI_BATCH_MAX_MESSAGES &&
+               queued_bytes_ + length <= WIFI_BATCH_CAPACITY;
+    }
+
+    /// @return ok once connected, else the driver's error.
+    core::Result<void> attempt(WiFiConnectPath path, const platform::WiFiConnectHint& hint) noexcept
+    {
+        auto result = wifi_.connect_with_hint(config_.ssid, config_.password, hint);
+        if (result.is_ok() && wifi_.is_connected()) {
+            last_path_ = path;
+            return result;
+        }
+        ++stats_.failed_attempts;
+        return result.is_error() ? result : GS_MAKE_ERROR(core::ErrorCode::WiFiConnectionFailed);
+    }
+
+    /// Fast path from the cache, then a full connect, then the static
+    /// fallback if the full connect associated but DHCP did not answer.
+    void connect_now() noexcept
+    {
+        const uint64_t start_ms = time_.get_timestamp_ms();
+        bool connected = false;
+
+        platform::WiFiConnectHint hint;
+        if (config_.use_cache && cache_.is_valid()) {
+            hint.bssid = cache_.bssid;
+            hint.channel = cache_.channel;
+            if (cache_.ip_reusable(start_ms)) {
+                hint.static_ip = cache_.ip;
+            }
+            connected = attempt(WiFiConnectPath::Fast, hint).is_ok();
+        }
+        if (!connected) {
+            hint = platform::WiFiConnectHint{};
+            auto full = attempt(WiFiConnectPath::Full, hint);
+            connected = full.is_ok();
+            if (!connected && config_.static_fallback.is_set() &&
+                full.error().code == core::ErrorCode::NetworkTimeout) {
+                hint.static_ip = config_.static_fallback;
+                connected = attempt(WiFiConnectPath::Fallback, hint).is_ok();
+            }
+        }
+
+        const uint64_t now_ms = time_.get_timestamp_ms();
+        if (!connected) {
+            backoff_ms_ = backoff_ms_ == 0                           ? config_.reconnect_base_ms
+                          : backoff_ms_ >= config_.reconnect_max_ms / 2 ? config_.reconnect_max_ms
+                                                                       : backoff_ms_ * 2;
+            next_attempt_ms_ = now_ms + backoff_ms_;
+            return;
+        }
+
+        state_ = WiFiState::Connected;
+        backoff_ms_ = 0;
+        const auto elapsed = static_cast<uint32_t>(now_ms - start_ms);
+        stats_.last_connect_ms = elapsed;
+        stats_.connect_ms_total += elapsed;
+        if (elapsed > stats_.worst_connect_ms) {
+            stats_.worst_connect_ms = elapsed;
+        }
+        switch (last_path_) {
+        case WiFiConnectPath::Fast:
+            ++stats_.fast_connects;
+            break;
+        case WiFiConnectPath::Full:
+            ++stats_.full_connects;
+            break;
+        default:
+            ++stats_.fallback_connects;
+            break;
+        }
+        on_connected(hint, now_ms);
+    }
+
+    void on_connected(const platform::WiFiConnectHint& hint, uint64_t now_ms) noexcept
+    {
+        uint8_t dtim_period = 1;
+        uint16_t beacon_tu = 100;
+        auto info = wifi_.get_link_info();
+        if (info.is_ok()) {
+            const platform::WiFiLinkInfo& link = info.value();
+            dtim_period = link.dtim_period == 0 ? 1 : link.dtim_period;
+            beacon_tu = link.beacon_interval_tu == 0 ? 100 : link.beacon_interval_tu;
+            const bool reused = hint.static_ip.is_set() && last_path_ == WiFiConnectPath::Fast &&
+                                link.ip.address == cache_.ip.address;
+            cache_.magic = WIFI_CACHE_MAGIC;
+            cache_.bssid = link.bssid;
+            cache_.channel = link.channel;
+            if (last_path_ == WiFiConnectPath::Fallback) {
+                cache_.ip = platform::WiFiIpConfig{}; // try DHCP again next time
+                cache_.lease_s = 0;
+            } else if (!reused) {
+                cache_.ip = link.ip;
+                cache_.lease_s = link.lease_s;
+                cache_.lease_start_ms = now_ms;
+            }
+        }
+
+        // Sleep period of the radio; windows land on it so a flush rides a wake-up
+        wake_period_us_ = 0;
+        if (config_.power_save != platform::WiFiPowerSave::None &&
+            wifi_.set_power_save(config_.power_save, config_.listen_interval).is_ok()) {
+            const uint32_t beacons = config_.power_save == platform::WiFiPowerSave::MaxModem &&
+                                             config_.listen_interval > dtim_period
+                                         ? config_.listen_interval
+                                         : dtim_period;
+            wake_period_us_ = static_cast<uint32_t>(beacon_tu) * WIFI_TU_US * beacons;
+        }
+        window_us_ = static_cast<uint64_t>(config_.batch_interval_ms) * 1000U;
+        if (wake_period_us_ > 0 && window_us_ > 0) {
+            window_us_ = (window_us_ + wake_period_us_ - 1) / wake_period_us_ * wake_period_us_;
+        }
+        next_window_us_ = time_.get_timestamp_us() + window_us_;
+        if (urgent_pending_) {
+            (void)flush();
+        }
+    }
+
+    platform::IPlatformWiFi& wifi_;
+    platform::IPlatformComm& uplink_;
+    platform::IPlatformTime& time_;
+    WiFiManagerConfig config_{};
+    bool configured_{false};
+    WiFiState state_{WiFiState::Disconnected};
+    WiFiConnectPath last_path_{WiFiConnectPath::None};
+    WiFiCache cache_{};
+    WiFiStats stats_{};
+    uint64_t next_attempt_ms_{0};
+    uint32_t backoff_ms_{0};
+    uint32_t wake_period_us_{0};
+    uint64_t window_us_{0};
+    uint64_t next_window_us_{0};
+    std::array<uint8_t, WIFI_BATCH_CAPACITY> queue_{};
+    std::array<uint16_t, WIFI_BATCH_MAX_MESSAGES> lengths_{};
+    size_t queued_count_{0};
+    size_t queued_bytes_{0};
+    bool urgent_pending_{false};
+};
+
+} // namespace gridshield::network
@@ -6,9 +6,12 @@
 
 #pragma once
 
+#include "core/incremental_job.hpp"
 #include "security/crypto.hpp"
 #include "security/key_storage.hpp"
 
+#include <cstring>
+
 namespace gridshield::security {
 
 class KeyRotationService
@@ -25,6 +28,23 @@ public:
      */
     core::Result<void> rotate() noexcept
     {
+        ECCKeyPair new_primary;
+        GS_TRY(crypto_.generate_keypair(new_primary));
+        return rotate_with(new_primary);
+    }
+
+    /**
+     * @brief Rotate to a key that was generated ahead of time
+     *
+     * Same workflow as rotate() minus keygen, so the critical section is
+     * just two slot writes. Pair with KeygenAheadJob.
+     */
+    core::Result<void> rotate_with(const ECCKeyPair& new_primary) noexcept
+    {
+        if (!new_primary.has_private_key() || !new_primary.has_public_key()) {
+            return GS_MAKE_ERROR(core::ErrorCode::InvalidParameter);
+        }
+
         ECCKeyPair current_primary;
 
         // 1. Backup current primary (if exists)
@@ -33,14 +53,10 @@ public:
             GS_TRY(storage_.save(current_primary, KeySlot::Backup));
         }
 
-        // 2. Generate new primary
-        ECCKeyPair new_primary;
-        GS_TRY(crypto_.generate_keypair(new_primary));
-
-        // 3. Save new primary
+        // 2. Save new primary
         GS_TRY(storage_.save(new_primary, KeySlot::Primary));
 
-        // 4. Verify the new key was stored correctly
+        // 3. Verify the new key was stored correctly
         return verify_slot(KeySlot::Primary);
     }
 
@@ -104,4 +120,114 @@ private:
     ICryptoEngine& crypto_;
 };
 
+/**
+ * @brief Generate the next rotation key in the background
+ *
+ * Steps: Generate → Sign probe → Verify probe → Ready. A single ECC
+ * operation cannot be split further, so each step is one uECC call; the
+ * cost hint makes the scheduler give each one a cycle of its own.
+ * The signature self-test catches a faulty keypair before it is committed.
+ */
+class KeygenAheadJob final : public core::IIncrementalJob
+{
+public:
+    static constexpr uint32_t DEFAULT_STEP_COST_US = 50000;
+
+    explicit KeygenAheadJob(ICryptoEngine& crypto,
+                            uint32_t step_cost_us = DEFAULT_STEP_COST_US) noexcept
+        : crypto_(crypto), step_cost_us_(step_cost_us)
+    {}
+
+    core::JobStatus step() noexcept override
+    {
+        switch (phase_) {
+            case Phase::Generate:
+                staged_.clear();
+                if (crypto_.generate_keypair(staged_).is_error()) {
+                    return fail();
+                }
+                phase_ = Phase::Sign;
+                return core::JobStatus::Pending;
+
+            case Phase::Sign:
+                if (crypto_.sign(staged_, PROBE, sizeof(PROBE), signature_).is_error()) {
+                    return fail();
+                }
+                phase_ = Phase::Verify;
+                return core::JobStatus::Pending;
+
+            case Phase::Verify: {
+                auto verified = crypto_.verify(staged_, PROBE, sizeof(PROBE), signature_);
+                if (verified.is_error() || !verified.value()) {
+                    return fail();
+                }
+                phase_ = Phase::Ready;
+                return core::JobStatus::Done;
+            }
+
+            case Phase::Ready:
+                return core::JobStatus::Done;
+            case Phase::Failed:
+            default:
+                return core::JobStatus::Failed;
+        }
+    }
+
+    void reset() noexcept override
+    {
+        staged_.clear();
+        std::memset(signature_, 0, sizeof(signature_));
+        phase_ = Phase::Generate;
+    }
+
+    GS_NODISCARD uint32_t next_step_cost_us() const noexcept override
+    {
+        return (phase_ == Phase::Ready || phase_ == Phase::Failed) ? 0 : step_cost_us_;
+    }
+
+    GS_NODISCARD bool is_ready() const noexcept
+    {
+        return phase_ == Phase::Ready;
+    }
+
+    /**
+     * @brief Move the staged key out; the job rewinds for the next round
+     */
+    core::Result<ECCKeyPair> take() noexcept
+    {
+        if (phase_ != Phase::Ready) {
+            return GS_MAKE_ERROR(core::ErrorCode::InvalidState);
+        }
+        ECCKeyPair out = GS_MOVE(staged_);
+        reset();
+        return core::Result<ECCKeyPair>(GS_MOVE(out));
+    }
+
+private:
+    enum class Phase : uint8_t
+    {
+        Generate,
+        Sign,
+        Verify,
+        Ready,
+        Failed
+    };
+
+    static constexpr uint8_t PROBE[16] = {'G', 'S', '-', 'K', 'E', 'Y', 'G', 'E',
+                                          'N', '-', 'P', 'R', 'O', 'B', 'E', 0};
+
+    core::JobStatus fail() noexcept
+    {
+        staged_.clear();
+        phase_ = Phase::Failed;
+        return core::JobStatus::Failed;
+    }
+
+    ICryptoEngine& crypto_;
+    uint32_t step_cost_us_;
+    ECCKeyPair staged_;
+    uint8_t signature_[ECC_SIGNATURE_SIZE]{};
+    Phase phase_{Phase::Generate};
+};
+
 } // namespace gridshield::security
@@ -22,7 +22,8 @@ enum class KeySlot : uint8_t
 {
     Primary = 0,
     Backup = 1,
-    Count = 2
+    ServerPublic = 2, // Public key only (private region zeroed)
+    Count = 3
 };
 
 /**
@@ -75,8 +76,9 @@ public:
         uint32_t crc = crc_res.value();
         memcpy(buffer + SLOT_SIZE - 4, &crc, 4);
 
-        // Write to storage
-        return platform_.storage->write(address, buffer, SLOT_SIZE).as_void();
+        // Write to storage; keys must be durable before they are used
+        GS_TRY(platform_.storage->write(address, buffer, SLOT_SIZE).as_void());
+        return platform_.storage->flush();
     }
 
     /**
@@ -123,6 +125,66 @@ public:
         return core::Result<void>{};
     }
 
+    /**
+     * @brief Save a public-only key (e.g. the server key) to a slot
+     */
+    core::Result<void> save_public_key(const ECCKeyPair& keypair,
+                                       KeySlot slot = KeySlot::ServerPublic) noexcept
+    {
+        if (!keypair.has_public_key()) {
+            return GS_MAKE_ERROR(core::ErrorCode::InvalidParameter);
+        }
+
+        uint8_t buffer[SLOT_SIZE];
+        memset(buffer, 0, SLOT_SIZE);
+
+        uint32_t magic = STORAGE_MAGIC;
+        memcpy(buffer, &magic, 4);
+        buffer[4] = STORAGE_VERSION;
+        memcpy(buffer + 8, keypair.get_public_key(), ECCKeyPair::PUBLIC_KEY_SIZE);
+
+        auto crc_res = platform_.crypto->crc32(buffer, SLOT_SIZE - 4);
+        if (crc_res.is_error())
+            return crc_res.error();
+
+        uint32_t crc = crc_res.value();
+        memcpy(buffer + SLOT_SIZE - 4, &crc, 4);
+
+        GS_TRY(platform_.storage->write(get_address(slot), buffer, SLOT_SIZE).as_void());
+        return platform_.storage->flush();
+    }
+
+    /**
+     * @brief Load only the public key from a slot
+     */
+    core::Result<void> load_public_key(ECCKeyPair& keypair,
+                                       KeySlot slot = KeySlot::ServerPublic) noexcept
+    {
+        uint8_t buffer[SLOT_SIZE];
+
+        auto read_res = platform_.storage->read(get_address(slot), buffer, SLOT_SIZE);
+        if (read_res.is_error())
+            return read_res.error();
+
+        uint32_t magic;
+        memcpy(&magic, buffer, 4);
+        if (magic != STORAGE_MAGIC) {
+            return GS_MAKE_ERROR(core::ErrorCode::IntegrityViolation);
+        }
+
+        auto crc_res = platform_.crypto->crc32(buffer, SLOT_SIZE - 4);
+        if (crc_res.is_error())
+            return crc_res.error();
+
+        uint32_t stored_crc;
+        memcpy(&stored_crc, buffer + SLOT_SIZE - 4, 4);
+        if (crc_res.value() != stored_crc) {
+            return GS_MAKE_ERROR(core::ErrorCode::IntegrityViolation);
+        }
+
+        return keypair.load_public_key(buffer + 8, ECCKeyPair::PUBLIC_KEY_SIZE);
+    }
+
     /**
      * @brief Erase keys from a specific slot
      */
@@ -0,0 +1,682 @@
+/**
+ * @file deferred_log.hpp
+ * @author zuudevs (zuudevs@gmail.com)
+ * @brief Deferred binary logging for hot paths
+ * @version 1.0
+ * @date 2026-03-21
+ *
+ * GS_DLOGx(tag, fmt, args...) records a format id, a timestamp and the raw
+ * argument words into a lock-free ring; nothing is formatted and nothing
+ * touches the UART on the calling path. A low-priority task later calls
+ * drain() to format records on the device, or drain_raw() to ship the
+ * binary stream to a host where native/log_decode.cpp formats it with the
+ * strings read back from the firmware ELF.
+ *
+ * Format id: the "<level><tag>\x1f<fmt>" string is a constexpr constant in
+ * .rodata. On 32-bit targets the id is its address; on 64-bit hosts it is
+ * the offset from gs_dlog_anchor. Either way the decoder resolves it from
+ * the ELF alone.
+ *
+ * Arguments are checked against the format at compile time (integers of
+ * 32/64 bits, double, %p, %c; no %s or '*' width since the pointee would
+ * be gone by the time the record is formatted). Levels above GS_DLOG_LEVEL
+ * compile to nothing.
+ *
+ * Record: [0xA5 | word count] [format id] [timestamp] [argument words...],
+ * little-endian 32-bit words; 64-bit values are low word first.
+ *
+ * Ring: multi-producer (CAS reservation, release-publish of the first word),
+ * single consumer. A full ring drops the new record and counts it.
+ *
+ * @note Header-only, zero heap allocation.
+ */
+
+#pragma once
+
+#include "utils/gs_macros.hpp"
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <type_traits>
+
+// ============================================================================
+// CONFIGURATION
+// ============================================================================
+#define GS_DLOG_LEVEL_NONE 0
+#define GS_DLOG_LEVEL_ERROR 1
+#define GS_DLOG_LEVEL_WARN 2
+#define GS_DLOG_LEVEL_INFO 3
+#define GS_DLOG_LEVEL_DEBUG 4
+#define GS_DLOG_LEVEL_VERBOSE 5
+
+/// Compile-time filter: call sites above this level generate no code.
+#ifndef GS_DLOG_LEVEL
+#define GS_DLOG_LEVEL GS_DLOG_LEVEL_INFO
+#endif
+
+/// Ring size in 32-bit words (power of two).
+#ifndef GS_DLOG_RING_WORDS
+#define GS_DLOG_RING_WORDS 1024
+#endif
+
+namespace gridshield::utils {
+
+static constexpr size_t DLOG_MAX_ARGS = 8;
+static constexpr size_t DLOG_HEADER_WORDS = 3;
+static constexpr size_t DLOG_MAX_RECORD_WORDS = DLOG_HEADER_WORDS + 2 * DLOG_MAX_ARGS;
+static constexpr uint32_t DLOG_RECORD_MAGIC = 0xA5000000U;
+static constexpr uint32_t DLOG_MAGIC_MASK = 0xFF000000U;
+static constexpr char DLOG_TAG_SEPARATOR = '\x1f';
+static constexpr size_t DLOG_LINE_SIZE = 160;
+
+/// Fixed reference for format ids on 64-bit hosts.
+inline constexpr char gs_dlog_anchor[] = "gs_dlog";
+
+// ============================================================================
+// COMPILE-TIME FORMAT DESCRIPTORS
+// ============================================================================
+namespace dlog_detail {
+
+// Argument classes, one base-4 digit per argument in a signature
+static constexpr uint64_t ARG_WORD = 1;   // 32-bit integer
+static constexpr uint64_t ARG_DWORD = 2;  // 64-bit integer
+static constexpr uint64_t ARG_DOUBLE = 3; // double (two words)
+static constexpr uint64_t SIG_INVALID = UINT64_MAX;
+
+GS_CONSTEXPR uint64_t int_class(size_t bytes) noexcept
+{
+    return bytes > 4 ? ARG_DWORD : ARG_WORD;
+}
+
+/**
+ * @brief Signature of a printf format for this target, SIG_INVALID if the
+ *        format uses something a deferred record cannot carry.
+ */
+GS_CONSTEXPR uint64_t format_signature(const char* fmt) noexcept
+{
+    uint64_t sig = 0;
+    uint64_t digit = 1;
+    size_t args = 0;
+    for (size_t i = 0; fmt[i] != '\0'; ++i) {
+        if (fmt[i] != '%') {
+            continue;
+        }
+        ++i;
+        if (fmt[i] == '%') {
+            continue;
+        }
+        while (fmt[i] == '-' || fmt[i] == '+' || fmt[i] == ' ' || fmt[i] == '#' ||
+               fmt[i] == '0' || (fmt[i] >= '1' && fmt[i] <= '9') || fmt[i] == '.') {
+            ++i;
+        }
+        size_t int_bytes = sizeof(int);
+        if (fmt[i] == 'h') {
+            i += (fmt[i + 1] == 'h') ? 2 : 1;
+        } else if (fmt[i] == 'l' && fmt[i + 1] == 'l') {
+            int_bytes = sizeof(long long);
+            i += 2;
+        } else if (fmt[i] == 'l') {
+            int_bytes = sizeof(long);
+            ++i;
+        } else if (fmt[i] == 'j') {
+            int_bytes = sizeof(intmax_t);
+            ++i;
+        } else if (fmt[i] == 'z' || fmt[i] == 't') {
+            int_bytes = sizeof(size_t);
+            ++i;
+        }
+        uint64_t cls = 0;
+        switch (fmt[i]) {
+        case 'd':
+        case 'i':
+        case 'u':
+        case 'o':
+        case 'x':
+        case 'X':
+        case 'c':
+            cls = int_class(int_bytes);
+            break;
+        case 'f':
+        case 'F':
+        case 'e':
+        case 'E':
+        case 'g':
+        case 'G':
+        case 'a':
+        case 'A':
+            cls = ARG_DOUBLE;
+            break;
+        case 'p':
+            cls = int_class(sizeof(void*));
+            break;
+        default: // %s, %n, '*', L, end of string
+            return SIG_INVALID;
+        }
+        if (args == DLOG_MAX_ARGS) {
+            return SIG_INVALID;
+        }
+        sig += cls * digit;
+        digit *= 4;
+        ++args;
+    }
+    return sig;
+}
+
+template <typename T> GS_CONSTEXPR uint64_t arg_class() noexcept
+{
+    using U = typename std::decay<T>::type;
+    if constexpr (std::is_floating_point<U>::value) {
+        return ARG_DOUBLE;
+    } else if constexpr (std::is_pointer<U>::value) {
+        return int_class(sizeof(void*));
+    } else {
+        static_assert(std::is_integral<U>::value || std::is_enum<U>::value,
+                      "deferred log arguments must be integers, enums, floats or pointers");
+        return int_class(sizeof(U));
+    }
+}
+
+template <typename... Args> struct Signature
+{
+    static constexpr uint64_t value = []() {
+        uint64_t sig = 0;
+        uint64_t digit = 1;
+        for (uint64_t cls : {uint64_t{0}, arg_class<Args>()...}) {
+            if (cls != 0) {
+                sig += cls * digit;
+                digit *= 4;
+            }
+        }
+        return sig;
+    }();
+};
+
+/// Unevaluated helper: decltype(signature_of(args...))::value.
+template <typename... Args> Signature<Args...> signature_of(const Args&...) noexcept;
+
+template <typename T> GS_CONSTEXPR size_t arg_words() noexcept
+{
+    return arg_class<T>() == ARG_WORD ? 1 : 2;
+}
+
+/// "<level><tag>\x1f<fmt>" as one constant.
+template <size_t TagLen, size_t FmtLen>
+GS_CONSTEXPR std::array<char, TagLen + FmtLen + 1>
+make_descriptor(char level, const char (&tag)[TagLen], const char (&fmt)[FmtLen]) noexcept
+{
+    std::array<char, TagLen + FmtLen + 1> out{};
+    out[0] = level;
+    for (size_t i = 0; i + 1 < TagLen; ++i) {
+        out[1 + i] = tag[i];
+    }
+    out[TagLen] = DLOG_TAG_SEPARATOR;
+    for (size_t i = 0; i < FmtLen; ++i) {
+        out[TagLen + 1 + i] = fmt[i];
+    }
+    return out;
+}
+
+} // namespace dlog_detail
+
+// ============================================================================
+// RECORD FORMATTING (device drain and host decoder)
+// ============================================================================
+/// Target word sizes needed to walk a format written for that target.
+struct DeferredLogTarget
+{
+    uint8_t long_words{static_cast<uint8_t>(sizeof(long) / 4)};
+    uint8_t pointer_words{static_cast<uint8_t>(sizeof(void*) / 4)};
+};
+
+/// Split "<level><tag>\x1f<fmt>" into its parts; false if malformed.
+inline bool split_descriptor(const char* descriptor,
+                             char& level,
+                             const char*& tag,
+                             size_t& tag_len,
+                             const char*& fmt) noexcept
+{
+    if (descriptor == nullptr || descriptor[0] == '\0') {
+        return false;
+    }
+    const char* sep = std::strchr(descriptor + 1, DLOG_TAG_SEPARATOR);
+    if (sep == nullptr) {
+        return false;
+    }
+    level = descriptor[0];
+    tag = descriptor + 1;
+    tag_len = static_cast<size_t>(sep - tag);
+    fmt = sep + 1;
+    return true;
+}
+
+/**
+ * @brief printf @p fmt with arguments taken from recorded words.
+ *
+ * Each conversion is re-issued to snprintf on its own with a normalised
+ * length modifier, so a format written for a 32-bit target formats the
+ * same on a 64-bit host.
+ * @return Characters written (excluding NUL), truncated to @p cap - 1.
+ */
+inline size_t format_record(const char* fmt,
+                            const uint32_t* args,
+                            size_t arg_words,
+                            char* out,
+                            size_t cap,
+                            DeferredLogTarget target = DeferredLogTarget{}) noexcept
+{
+    if (cap == 0) {
+        return 0;
+    }
+    size_t len = 0;
+    size_t word = 0;
+    auto append = [&](const char* text, size_t n) {
+        for (size_t k = 0; k < n && len + 1 < cap; ++k) {
+            out[len++] = text[k];
+        }
+    };
+    auto take = [&](size_t words) -> uint64_t {
+        uint64_t value = 0;
+        for (size_t k = 0; k < words && word < arg_words; ++k) {
+            value |= static_cast<uint64_t>(args[word++]) << (32 * k);
+        }
+        return value;
+    };
+
+    for (size_t i = 0; fmt[i] != '\0';) {
+        if (fmt[i] != '%') {
+            append(&fmt[i++], 1);
+            continue;
+        }
+        if (fmt[i + 1] == '%') {
+            append("%", 1);
+            i += 2;
+            continue;
+        }
+
+        // Rebuild the spec as "%<flags/width/precision>ll<conv>"
+        char spec[24];
+        size_t spec_len = 0;
+        spec[spec_len++] = fmt[i++];
+        while ((fmt[i] == '-' || fmt[i] == '+' || fmt[i] == ' ' || fmt[i] == '#' ||
+                fmt[i] == '.' || (fmt[i] >= '0' && fmt[i] <= '9')) &&
+               spec_len < sizeof(spec) - 4) {
+            spec[spec_len++] = fmt[i++];
+        }
+        size_t words = 1;
+        int narrow = 0; // 1 = h, 2 = hh
+        if (fmt[i] == 'h') {
+            narrow = (fmt[i + 1] == 'h') ? 2 : 1;
+            i += narrow;
+        } else if (fmt[i] == 'l' && fmt[i + 1] == 'l') {
+            words = 2;
+            i += 2;
+        } else if (fmt[i] == 'l') {
+            words = target.long_words;
+            ++i;
+        } else if (fmt[i] == 'j') {
+            words = 2;
+            ++i;
+        } else if (fmt[i] == 'z' || fmt[i] == 't') {
+            words = target.pointer_words;
+            ++i;
+        }
+        const char conv = fmt[i];
+        if (conv == '\0') {
+            break;
+        }
+        ++i;
+
+        char piece[64];
+        int written = 0;
+        if (conv == 'f' || conv == 'F' || conv == 'e' || conv == 'E' || conv == 'g' ||
+            conv == 'G' || conv == 'a' || conv == 'A') {
+            const uint64_t bits = take(2);
+            double value = 0.0;
+            std::memcpy(&value, &bits, sizeof(value));
+            spec[spec_len++] = conv;
+            spec[spec_len] = '\0';
+            written = std::snprintf(piece, sizeof(piece), spec, value);
+        } else if (conv == 'p') {
+            const uint64_t value = take(target.pointer_words);
+            written = std::snprintf(piece, sizeof(piece), "0x%llx",
+                                    static_cast<unsigned long long>(value));
+        } else if (conv == 'c') {
+            const auto value = static_cast<int>(take(1) & 0xFFU);
+            spec[spec_len++] = 'c';
+            spec[spec_len] = '\0';
+            written = std::snprintf(piece, sizeof(piece), spec, value);
+        } else if (conv == 'd' || conv == 'i' || conv == 'u' || conv == 'o' || conv == 'x' ||
+                   conv == 'X') {
+            uint64_t raw = take(words);
+            const bool is_signed = conv == 'd' || conv == 'i';
+            if (narrow == 2) {
+                raw &= 0xFFU;
+            } else if (narrow == 1) {
+                raw &= 0xFFFFU;
+            } else if (words == 1) {
+                raw &= 0xFFFFFFFFU;
+            }
+            long long value = static_cast<long long>(raw);
+            if (is_signed) {
+                const unsigned bits = narrow == 2 ? 8U : narrow == 1 ? 16U : 32U * words;
+                if (bits < 64 && (raw >> (bits - 1)) & 1U) {
+                    value = static_cast<long long>(raw | (~0ULL << bits));
+                }
+            }
+            spec[spec_len++] = 'l';
+            spec[spec_len++] = 'l';
+            spec[spec_len++] = conv;
+            spec[spec_len] = '\0';
+            written = is_signed ? std::snprintf(piece, sizeof(piece), spec, value)
+                                : std::snprintf(piece, sizeof(piece), spec,
+                                                static_cast<unsigned long long>(raw));
+        } else {
+            append("<?>", 3);
+            continue;
+        }
+        if (written > 0) {
+            append(piece, static_cast<size_t>(written) < sizeof(piece)
+                              ? static_cast<size_t>(written)
+                              : sizeof(piece) - 1);
+        }
+    }
+    out[len] = '\0';
+    return len;
+}
+
+// ============================================================================
+// RING
+// ============================================================================
+struct DeferredLogStats
+{
+    uint32_t recorded{0};
+    uint32_t dropped{0};  // ring full
+    uint32_t drained{0};
+};
+
+/// One formatted record handed to a drain sink.
+struct DeferredLogLine
+{
+    char level{'I'};
+    const char* tag{nullptr};
+    size_t tag_len{0};
+    uint32_t timestamp{0};
+    const char* text{nullptr};
+};
+
+using DeferredLogSink = void (*)(void* ctx, const DeferredLogLine& line);
+using DeferredLogClock = uint32_t (*)();
+
+template <size_t Words> class DeferredLog
+{
+    static_assert(Words >= 2 * DLOG_MAX_RECORD_WORDS && (Words & (Words - 1)) == 0,
+                  "DeferredLog ring must be a power of two holding two maximal records");
+
+public:
+    GS_CONSTEXPR DeferredLog() noexcept = default;
+
+    /// Timestamp source (e.g. milliseconds since boot); records 0 if unset.
+    void set_clock(DeferredLogClock clock) noexcept
+    {
+        clock_.store(clock, std::memory_order_relaxed);
+    }
+
+    // === Producer side (any context) ===
+
+    template <typename... Args> bool record(const char* descriptor, Args... args) noexcept
+    {
+        static_assert(sizeof...(Args) <= DLOG_MAX_ARGS, "too many deferred log arguments");
+        constexpr auto len =
+            static_cast<uint32_t>(DLOG_HEADER_WORDS + (dlog_detail::arg_words<Args>() + ... + 0));
+
+        uint32_t head = head_.load(std::memory_order_relaxed);
+        do {
+            if (GS_UNLIKELY(head + len - tail_.load(std::memory_order_acquire) > Words)) {
+                dropped_.fetch_add(1, std::memory_order_relaxed);
+                return false;
+            }
+        } while (!head_.compare_exchange_weak(
+            head, head + len, std::memory_order_acq_rel, std::memory_order_relaxed));
+
+        const DeferredLogClock clock = clock_.load(std::memory_order_relaxed);
+        uint32_t pos = head + 1;
+        put(pos, format_id(descriptor));
+        put(pos, clock != nullptr ? clock() : 0U);
+        (put_arg(pos, args), ...);
+        // Publishing the first word hands the record to the consumer
+        words_[head & MASK].store(DLOG_RECORD_MAGIC | len, std::memory_order_release);
+        recorded_.fetch_add(1, std::memory_order_relaxed);
+        return true;
+    }
+
+    // === Consumer side (one task) ===
+
+    /**
+     * @brief Format up to @p max_records records and pass each to @p sink.
+     * @return Records drained.
+     */
+    size_t drain(DeferredLogSink sink, void* ctx, size_t max_records = SIZE_MAX) noexcept
+    {
+        uint32_t record_words[DLOG_MAX_RECORD_WORDS];
+        char text[DLOG_LINE_SIZE];
+        size_t count = 0;
+        while (count < max_records) {
+            const size_t len = pop(record_words);
+            if (len == 0) {
+                break;
+            }
+            DeferredLogLine line;
+            const char* fmt = nullptr;
+            if (!split_descriptor(resolve(record_words[1]), line.level, line.tag,
+                                  line.tag_len, fmt)) {
+                continue;
+            }
+            format_record(fmt, &record_words[DLOG_HEADER_WORDS], len - DLOG_HEADER_WORDS,
+                          text, sizeof(text));
+            line.timestamp = record_words[2];
+            line.text = text;
+            if (sink != nullptr) {
+                sink(ctx, line);
+            }
+            ++count;
+        }
+        return count;
+    }
+
+    /**
+     * @brief Copy whole records, little-endian, into @p out for a host decoder.
+     * @return Bytes written; records that do not fit stay in the ring.
+     */
+    size_t drain_raw(uint8_t* out, size_t cap) noexcept
+    {
+        size_t written = 0;
+        for (;;) {
+            const uint32_t tail = tail_.load(std::memory_order_relaxed);
+            const uint32_t first = words_[tail & MASK].load(std::memory_order_acquire);
+            if ((first & DLOG_MAGIC_MASK) != DLOG_RECORD_MAGIC) {
+                break;
+            }
+            const uint32_t len = first & ~DLOG_MAGIC_MASK;
+            if (written + len * 4 > cap) {
+                break;
+            }
+            for (uint32_t k = 0; k < len; ++k) {
+                const uint32_t w = k == 0 ? first : words_[(tail + k) & MASK].load(
+                                                        std::memory_order_relaxed);
+                out[written++] = static_cast<uint8_t>(w);
+                out[written++] = static_cast<uint8_t>(w >> 8);
+                out[written++] = static_cast<uint8_t>(w >> 16);
+                out[written++] = static_cast<uint8_t>(w >> 24);
+            }
+            release(tail, len);
+        }
+        return written;
+    }
+
+    // === Format ids ===
+
+    static uint32_t format_id(const char* descriptor) noexcept
+    {
+        if constexpr (sizeof(void*) <= 4) {
+            return static_cast<uint32_t>(reinterpret_cast<uintptr_t>(descriptor));
+        } else {
+            return static_cast<uint32_t>(reinterpret_cast<intptr_t>(descriptor) -
+                                         reinterpret_cast<intptr_t>(gs_dlog_anchor));
+        }
+    }
+
+    static const char* resolve(uint32_t id) noexcept
+    {
+        if constexpr (sizeof(void*) <= 4) {
+            return reinterpret_cast<const char*>(static_cast<uintptr_t>(id));
+        } else {
+            return gs_dlog_anchor + static_cast<int32_t>(id);
+        }
+    }
+
+    // === Accessors ===
+
+    GS_NODISCARD DeferredLogStats stats() const noexcept
+    {
+        DeferredLogStats s;
+        s.recorded = recorded_.load(std::memory_order_relaxed);
+        s.dropped = dropped_.load(std::memory_order_relaxed);
+        s.drained = drained_;
+        return s;
+    }
+
+    /// Words currently reserved or waiting to be drained.
+    GS_NODISCARD size_t pending_words() const noexcept
+    {
+        return head_.load(std::memory_order_relaxed) - tail_.load(std::memory_order_relaxed);
+    }
+
+    static constexpr size_t capacity_words() noexcept
+    {
+        return Words;
+    }
+
+private:
+    static constexpr uint32_t MASK = static_cast<uint32_t>(Words - 1);
+
+    void put(uint32_t& pos, uint32_t value) noexcept
+    {
+        words_[pos++ & MASK].store(value, std::memory_order_relaxed);
+    }
+
+    template <typename T> void put_arg(uint32_t& pos, T value) noexcept
+    {
+        using U = typename std::decay<T>::type;
+        if constexpr (std::is_floating_point<U>::value) {
+            const double d = static_cast<double>(value);
+            uint64_t bits = 0;
+            std::memcpy(&bits, &d, sizeof(bits));
+            put(pos, static_cast<uint32_t>(bits));
+            put(pos, static_cast<uint32_t>(bits >> 32));
+        } else {
+            uint64_t bits = 0;
+            if constexpr (std::is_pointer<U>::value) {
+                bits = static_cast<uint64_t>(reinterpret_cast<uintptr_t>(value));
+            } else {
+                bits = static_cast<uint64_t>(value);
+            }
+            put(pos, static_cast<uint32_t>(bits));
+            if constexpr (dlog_detail::arg_words<U>() == 2) {
+                put(pos, static_cast<uint32_t>(bits >> 32));
+            }
+        }
+    }
+
+    /// Copy the oldest committed record out; 0 if none is ready.
+    size_t pop(uint32_t (&out)[DLOG_MAX_RECORD_WORDS]) noexcept
+    {
+        const uint32_t tail = tail_.load(std::memory_order_relaxed);
+        const uint32_t first = words_[tail & MASK].load(std::memory_order_acquire);
+        if ((first & DLOG_MAGIC_MASK) != DLOG_RECORD_MAGIC) {
+            return 0;
+        }
+        const uint32_t len = first & ~DLOG_MAGIC_MASK;
+        for (uint32_t k = 0; k < len && k < DLOG_MAX_RECORD_WORDS; ++k) {
+            out[k] = words_[(tail + k) & MASK].load(std::memory_order_relaxed);
+        }
+        release(tail, len);
+        return len;
+    }
+
+    /// Zero the record (any word may be the next first word) and free it.
+    void release(uint32_t tail, uint32_t len) noexcept
+    {
+        for (uint32_t k = 0; k < len; ++k) {
+            words_[(tail + k) & MASK].store(0, std::memory_order_relaxed);
+        }
+        tail_.store(tail + len, std::memory_order_release);
+        ++drained_;
+    }
+
+    std::array<std::atomic<uint32_t>, Words> words_{};
+    std::atomic<uint32_t> head_{0}; // next word to reserve
+    std::atomic<uint32_t> tail_{0}; // oldest unconsumed word
+    std::atomic<uint32_t> recorded_{0};
+    std::atomic<uint32_t> dropped_{0};
+    std::atomic<DeferredLogClock> clock_{nullptr};
+    uint32_t drained_{0};
+};
+
+/// Process-wide ring used by the GS_DLOGx macros.
+inline DeferredLog<GS_DLOG_RING_WORDS>& deferred_log() noexcept
+{
+    static DeferredLog<GS_DLOG_RING_WORDS> log;
+    return log;
+}
+
+} // namespace gridshield::utils
+
+// ============================================================================
+// CALL-SITE MACROS
+// ============================================================================
+// tag: string literal or constexpr char array; fmt: string literal
+#define GS_DLOG_RECORD_(level, tag, fmt, ...)                                                      \
+    do {                                                                                           \
+        static_assert(::gridshield::utils::dlog_detail::format_signature(fmt) ==                   \
+                          decltype(::gridshield::utils::dlog_detail::signature_of(                 \
+                              __VA_ARGS__))::value,                                                \
+                      "deferred log arguments do not match the format");                           \
+        static constexpr auto gs_dlog_descriptor_ =                                                \
+            ::gridshield::utils::dlog_detail::make_descriptor(level, tag, fmt);                    \
+        (void)::gridshield::utils::deferred_log().record(gs_dlog_descriptor_.data(),               \
+                                                         ##__VA_ARGS__);                           \
+    } while (0)
+
+#if GS_DLOG_LEVEL >= GS_DLOG_LEVEL_ERROR
+#define GS_DLOGE(tag, fmt, ...) GS_DLOG_RECORD_('E', tag, fmt, ##__VA_ARGS__)
+#else
+#define GS_DLOGE(tag, fmt, ...) ((void)0)
+#endif
+
+#if GS_DLOG_LEVEL >= GS_DLOG_LEVEL_WARN
+#define GS_DLOGW(tag, fmt, ...) GS_DLOG_RECORD_('W', tag, fmt, ##__VA_ARGS__)
+#else
+#define GS_DLOGW(tag, fmt, ...) ((void)0)
+#endif
+
+#if GS_DLOG_LEVEL >= GS_DLOG_LEVEL_INFO
+#define GS_DLOGI(tag, fmt, ...) GS_DLOG_RECORD_('I', tag, fmt, ##__VA_ARGS__)
+#else
+#define GS_DLOGI(tag, fmt, ...) ((void)0)
+#endif
+
+#if GS_DLOG_LEVEL >= GS_DLOG_LEVEL_DEBUG
+#define GS_DLOGD(tag, fmt, ...) GS_DLOG_RECORD_('D', tag, fmt, ##__VA_ARGS__)
+#else
+#define GS_DLOGD(tag, fmt, ...) ((void)0)
+#endif
+
+#if GS_DLOG_LEVEL >= GS_DLOG_LEVEL_VERBOSE
+#define GS_DLOGV(tag, fmt, ...) GS_DLOG_RECORD_('V', tag, fmt, ##__VA_ARGS__)
+#else
+#define GS_DLOGV(tag, fmt, ...) ((void)0)
+#endif
@@ -0,0 +1,495 @@
+/**
+ * @file fixed_point.hpp
+ * @author zuudevs (zuudevs@gmail.com)
+ * @brief Typed Q-format fixed-point arithmetic and integer math kernels
+ * @version 1.0
+ * @date 2026-03-22
+ *
+ * Q<IntBits, FracBits> is a signed 32-bit value with IntBits integer bits
+ * (excluding the sign) and FracBits fraction bits, e.g. Q<15, 16> for
+ * general analytics values and Q<1, 30> for weights in [0, 1]. Every
+ * operation widens to int64 and saturates to the format's range instead
+ * of wrapping, so an out-of-range intermediate pins at the rail.
+ *
+ * Kernels (no FPU, no libm):
+ *  - isqrt_u32 / isqrt_u64: exact floor(sqrt), branch-free digit-by-digit from the top set bit
+ *  - sqrt(Q): via isqrt_u64 on the pre-shifted raw value
+ *  - log2 / ln: 64-segment table with linear interpolation (|err| < 6e-5)
+ *  - exp2 / exp: 64-segment table with linear interpolation (rel. err < 2e-5)
+ *  - reciprocal: three Newton steps from a linear seed (no divide)
+ *  - mul_div_i32 / mul_div_u32: a * b / c with a 64-bit product, saturating
+ *
+ * The operator/ division is a 64-bit divide (a libgcc call on Xtensa);
+ * multiply by reciprocal() when the divisor repeats.
+ *
+ * @note Header-only, zero heap allocation.
+ *
+ * @copyright Copyright (c) 2026
+ */
+
+#pragma once
+
+#include "utils/gs_macros.hpp"
+
+#include <cstddef>
+#include <cstdint>
+
+namespace gridshield::utils {
+
+// ============================================================================
+// INTEGER KERNELS
+// ============================================================================
+namespace fixed_detail {
+
+/// Leading zero count of a non-zero 32-bit value.
+GS_CONSTEXPR int clz32(uint32_t value) noexcept
+{
+#if GS_COMPILER_GCC || GS_COMPILER_CLANG
+    return __builtin_clz(value);
+#else
+    int n = 0;
+    while ((value & 0x80000000U) == 0) {
+        value <<= 1;
+        ++n;
+    }
+    return n;
+#endif
+}
+
+/// Leading zero count of a non-zero 64-bit value.
+GS_CONSTEXPR int clz64(uint64_t value) noexcept
+{
+    const auto high = static_cast<uint32_t>(value >> 32);
+    return high != 0 ? clz32(high) : 32 + clz32(static_cast<uint32_t>(value));
+}
+
+GS_CONSTEXPR int32_t clamp_i32(int64_t value) noexcept
+{
+    return value > INT32_MAX ? INT32_MAX
+                             : (value < INT32_MIN ? INT32_MIN : static_cast<int32_t>(value));
+}
+
+/// value * 2^-shift rounded to nearest (half up); shift <= 0 scales up.
+GS_CONSTEXPR int64_t round_shift(int64_t value, int shift) noexcept
+{
+    if (shift <= 0) {
+        return value * (int64_t{1} << -shift);
+    }
+    if (shift >= 63) {
+        return 0;
+    }
+    return (value + (int64_t{1} << (shift - 1))) >> shift;
+}
+
+} // namespace fixed_detail
+
+/// floor(sqrt(value)) for 64-bit input.
+GS_CONSTEXPR uint32_t isqrt_u64(uint64_t value) noexcept
+{
+    if (value == 0) {
+        return 0;
+    }
+    uint64_t result = 0;
+    // Highest power of four <= value
+    uint64_t bit = uint64_t{1} << ((63 - fixed_detail::clz64(value)) & ~1);
+    while (bit != 0) {
+        // Branch-free digit step: the compare is data dependent and unpredictable
+        const uint64_t trial = result + bit;
+        const uint64_t take = uint64_t{0} - static_cast<uint64_t>(value >= trial);
+        value -= trial & take;
+        result = (result >> 1) + (bit & take);
+        bit >>= 2;
+    }
+    return static_cast<uint32_t>(result);
+}
+
+/// floor(sqrt(value)) for 32-bit input (32-bit operations only).
+GS_CONSTEXPR uint16_t isqrt_u32(uint32_t value) noexcept
+{
+    if (value == 0) {
+        return 0;
+    }
+    uint32_t result = 0;
+    uint32_t bit = uint32_t{1} << ((31 - fixed_detail::clz32(value)) & ~1);
+    while (bit != 0) {
+        // Branch-free digit step: the compare is data dependent and unpredictable
+        const uint32_t trial = result + bit;
+        const uint32_t take = uint32_t{0} - static_cast<uint32_t>(value >= trial);
+        value -= trial & take;
+        result = (result >> 1) + (bit & take);
+        bit >>= 2;
+    }
+    return static_cast<uint16_t>(result);
+}
+
+/// a * b / c (truncated toward zero) with a 64-bit product, saturated to int32.
+/// |a * b| must fit int64; c == 0 saturates by the sign of a * b.
+GS_CONSTEXPR int32_t mul_div_i32(int64_t a, int64_t b, int64_t c) noexcept
+{
+    const int64_t product = a * b;
+    if (GS_UNLIKELY(c == 0)) {
+        return product == 0 ? 0 : (product > 0 ? INT32_MAX : INT32_MIN);
+    }
+    return fixed_detail::clamp_i32(product / c);
+}
+
+/// a * b / c (truncated) with a 64-bit product, saturated to uint32.
+GS_CONSTEXPR uint32_t mul_div_u32(uint32_t a, uint32_t b, uint32_t c) noexcept
+{
+    if (GS_UNLIKELY(c == 0)) {
+        return (a == 0 || b == 0) ? 0 : UINT32_MAX;
+    }
+    const uint64_t q = (static_cast<uint64_t>(a) * b) / c;
+    return q > UINT32_MAX ? UINT32_MAX : static_cast<uint32_t>(q);
+}
+
+// ============================================================================
+// Q FORMAT
+// ============================================================================
+
+/**
+ * @brief Signed saturating fixed-point number, value = raw / 2^FracBits.
+ *
+ * Trivially copyable (it is stored in warm-boot checkpoints). Products and
+ * format conversions round to nearest; division truncates toward zero.
+ */
+template <int IntBits, int FracBits> class Q
+{
+    static_assert(IntBits >= 0 && FracBits >= 1 && FracBits <= 30,
+                  "Q needs 1..30 fraction bits");
+    static_assert(IntBits + FracBits <= 31, "Q is stored in 32 bits including the sign");
+
+public:
+    static constexpr int INT_BITS = IntBits;
+    static constexpr int FRAC_BITS = FracBits;
+    static constexpr int32_t ONE_RAW = int32_t{1} << FracBits;
+    static constexpr int32_t MAX_RAW =
+        static_cast<int32_t>((int64_t{1} << (IntBits + FracBits)) - 1);
+    static constexpr int32_t MIN_RAW = -MAX_RAW - 1;
+
+    constexpr Q() noexcept = default;
+
+    /// Raw value, saturated to the format's range.
+    GS_NODISCARD static GS_CONSTEXPR Q from_raw(int64_t raw) noexcept
+    {
+        Q q;
+        q.raw_ = raw > MAX_RAW ? MAX_RAW : (raw < MIN_RAW ? MIN_RAW : static_cast<int32_t>(raw));
+        return q;
+    }
+
+    GS_NODISCARD static GS_CONSTEXPR Q from_int(int32_t value) noexcept
+    {
+        return from_raw(static_cast<int64_t>(value) * ONE_RAW);
+    }
+
+    /// num / den rounded to nearest, e.g. from_ratio(alpha_x1000, 1000).
+    GS_NODISCARD static GS_CONSTEXPR Q from_ratio(int64_t num, int64_t den) noexcept
+    {
+        if (GS_UNLIKELY(den == 0)) {
+            return from_raw(num == 0 ? 0 : (num > 0 ? MAX_RAW : MIN_RAW));
+        }
+        if (den < 0) {
+            num = -num;
+            den = -den;
+        }
+        const int64_t scaled = num * ONE_RAW;
+        return from_raw((scaled + (scaled >= 0 ? den / 2 : -(den / 2))) / den);
+    }
+
+    /// Compile-time constants and host-side tests only; never on a target hot path.
+    GS_NODISCARD static GS_CONSTEXPR Q from_double(double value) noexcept
+    {
+        const double scaled = value * ONE_RAW;
+        if (scaled >= static_cast<double>(MAX_RAW)) {
+            return from_raw(MAX_RAW);
+        }
+        if (scaled <= static_cast<double>(MIN_RAW)) {
+            return from_raw(MIN_RAW);
+        }
+        return from_raw(static_cast<int64_t>(scaled >= 0.0 ? scaled + 0.5 : scaled - 0.5));
+    }
+
+    GS_NODISCARD static GS_CONSTEXPR Q zero() noexcept
+    {
+        return Q{};
+    }
+    GS_NODISCARD static GS_CONSTEXPR Q one() noexcept
+    {
+        return from_raw(ONE_RAW);
+    }
+    GS_NODISCARD static GS_CONSTEXPR Q max() noexcept
+    {
+        return from_raw(MAX_RAW);
+    }
+    GS_NODISCARD static GS_CONSTEXPR Q min() noexcept
+    {
+        return from_raw(MIN_RAW);
+    }
+
+    GS_NODISCARD GS_CONSTEXPR int32_t raw() const noexcept
+    {
+        return raw_;
+    }
+
+    /// Integer part, rounded toward negative infinity.
+    GS_NODISCARD GS_CONSTEXPR int32_t floor_int() const noexcept
+    {
+        return raw_ >> FracBits;
+    }
+
+    /// Nearest integer (half up).
+    GS_NODISCARD GS_CONSTEXPR int32_t round_int() const noexcept
+    {
+        return static_cast<int32_t>(fixed_detail::round_shift(raw_, FracBits));
+    }
+
+    GS_NODISCARD GS_CONSTEXPR double to_double() const noexcept
+    {
+        return static_cast<double>(raw_) / ONE_RAW;
+    }
+
+    /// @p value * this, rounded, saturated to int32 (e.g. a gain applied to a reading).
+    GS_NODISCARD GS_CONSTEXPR int32_t scale(int32_t value) const noexcept
+    {
+        return fixed_detail::clamp_i32(
+            fixed_detail::round_shift(static_cast<int64_t>(value) * raw_, FracBits));
+    }
+
+    /// Same value in another format (rounded, saturated).
+    template <int I2, int F2> GS_NODISCARD GS_CONSTEXPR Q<I2, F2> as() const noexcept
+    {
+        return Q<I2, F2>::from_raw(fixed_detail::round_shift(raw_, FracBits - F2));
+    }
+
+    // ---- arithmetic (saturating) ----
+    GS_NODISCARD friend GS_CONSTEXPR Q operator+(Q a, Q b) noexcept
+    {
+        return from_raw(static_cast<int64_t>(a.raw_) + b.raw_);
+    }
+    GS_NODISCARD friend GS_CONSTEXPR Q operator-(Q a, Q b) noexcept
+    {
+        return from_raw(static_cast<int64_t>(a.raw_) - b.raw_);
+    }
+    GS_NODISCARD friend GS_CONSTEXPR Q operator-(Q a) noexcept
+    {
+        return from_raw(-static_cast<int64_t>(a.raw_));
+    }
+    GS_NODISCARD friend GS_CONSTEXPR Q operator*(Q a, Q b) noexcept
+    {
+        return from_raw(fixed_detail::round_shift(static_cast<int64_t>(a.raw_) * b.raw_, FracBits));
+    }
+    GS_NODISCARD friend GS_CONSTEXPR Q operator/(Q a, Q b) noexcept
+    {
+        if (GS_UNLIKELY(b.raw_ == 0)) {
+            return from_raw(a.raw_ == 0 ? 0 : (a.raw_ > 0 ? MAX_RAW : MIN_RAW));
+        }
+        return from_raw((static_cast<int64_t>(a.raw_) * ONE_RAW) / b.raw_);
+    }
+    GS_CONSTEXPR Q& operator+=(Q other) noexcept
+    {
+        return *this = *this + other;
+    }
+    GS_CONSTEXPR Q& operator-=(Q other) noexcept
+    {
+        return *this = *this - other;
+    }
+    GS_CONSTEXPR Q& operator*=(Q other) noexcept
+    {
+        return *this = *this * other;
+    }
+    GS_CONSTEXPR Q& operator/=(Q other) noexcept
+    {
+        return *this = *this / other;
+    }
+
+    // ---- comparison ----
+    friend GS_CONSTEXPR bool operator==(Q a, Q b) noexcept
+    {
+        return a.raw_ == b.raw_;
+    }
+    friend GS_CONSTEXPR bool operator!=(Q a, Q b) noexcept
+    {
+        return a.raw_ != b.raw_;
+    }
+    friend GS_CONSTEXPR bool operator<(Q a, Q b) noexcept
+    {
+        return a.raw_ < b.raw_;
+    }
+    friend GS_CONSTEXPR bool operator<=(Q a, Q b) noexcept
+    {
+        return a.raw_ <= b.raw_;
+    }
+    friend GS_CONSTEXPR bool operator>(Q a, Q b) noexcept
+    {
+        return a.raw_ > b.raw_;
+    }
+    friend GS_CONSTEXPR bool operator>=(Q a, Q b) noexcept
+    {
+        return a.raw_ >= b.raw_;
+    }
+
+private:
+    int32_t raw_{0};
+};
+
+using Q16 = Q<15, 16>; ///< General analytics values, +-32768 at 1.5e-5 resolution
+using Q30 = Q<1, 30>;  ///< Weights and fractions in [-2, 2)
+
+/// (1 - t) * from + t * to with a single rounding; t is normally in [0, 1].
+template <int I, int F>
+GS_NODISCARD GS_CONSTEXPR int32_t lerp(int32_t from, int32_t to, Q<I, F> t) noexcept
+{
+    const int64_t mixed = static_cast<int64_t>(from) * (Q<I, F>::ONE_RAW - int64_t{t.raw()}) +
+                          static_cast<int64_t>(to) * t.raw();
+    return fixed_detail::clamp_i32(fixed_detail::round_shift(mixed, F));
+}
+
+// ============================================================================
+// TRANSCENDENTALS
+// ============================================================================
+namespace fixed_detail {
+
+static constexpr int TABLE_BITS = 6; // 64 segments over [1, 2) / [0, 1)
+static constexpr int SEGMENT_SHIFT = 30 - TABLE_BITS;
+static constexpr uint32_t SEGMENT_MASK = (uint32_t{1} << SEGMENT_SHIFT) - 1;
+static constexpr int64_t LN2_Q30 = 744261118;    // ln(2)
+static constexpr int64_t LOG2E_Q30 = 1549082005; // 1 / ln(2)
+static constexpr uint64_t RECIP_SEED_A = 3031741621ULL; // 48/17 in Q2.30
+static constexpr uint64_t RECIP_SEED_B = 4042322161ULL; // 32/17 in Q1.31
+
+/// log2(1 + i / 64) in Q0.30, i = 0..64.
+inline constexpr uint32_t LOG2_TABLE[(1 << TABLE_BITS) + 1] = {
+    0U, 24017256U, 47667823U, 70962728U, 93912511U, 116527248U, 138816582U, 160789745U,
+    182455581U, 203822568U, 224898839U, 245692198U, 266210141U, 286459867U, 306448299U,
+    326182095U, 345667660U, 364911162U, 383918542U, 402695523U, 421247625U, 439580170U,
+    457698295U, 475606957U, 493310944U, 510814882U, 528123241U, 545240343U, 562170370U,
+    578917365U, 595485245U, 611877800U, 628098702U, 644151509U, 660039669U, 675766525U,
+    691335320U, 706749198U, 722011213U, 737124328U, 752091421U, 766915285U, 781598637U,
+    796144114U, 810554283U, 824831638U, 838978604U, 852997541U, 866890747U, 880660455U,
+    894308843U, 907838029U, 921250079U, 934547002U, 947730758U, 960803257U, 973766362U,
+    986621888U, 999371606U, 1012017244U, 1024560487U, 1037002979U, 1049346328U, 1061592099U,
+    1073741824U};
+
+/// 2^(i / 64) in Q1.30, i = 0..64.
+inline constexpr uint32_t EXP2_TABLE[(1 << TABLE_BITS) + 1] = {
+    1073741824U, 1085434106U, 1097253708U, 1109202018U, 1121280436U, 1133490379U, 1145833280U,
+    1158310587U, 1170923762U, 1183674286U, 1196563654U, 1209593378U, 1222764986U, 1236080024U,
+    1249540052U, 1263146652U, 1276901417U, 1290805962U, 1304861917U, 1319070932U, 1333434672U,
+    1347954824U, 1362633090U, 1377471191U, 1392470869U, 1407633882U, 1422962010U, 1438457051U,
+    1454120821U, 1469955159U, 1485961921U, 1502142985U, 1518500250U, 1535035634U, 1551751076U,
+    1568648537U, 1585730000U, 1602997467U, 1620452965U, 1638098541U, 1655936265U, 1673968228U,
+    1692196547U, 1710623359U, 1729250827U, 1748081133U, 1767116489U, 1786359126U, 1805811301U,
+    1825475297U, 1845353420U, 1865448001U, 1885761398U, 1906295993U, 1927054196U, 1948038440U,
+    1969251188U, 1990694927U, 2012372174U, 2034285470U, 2056437387U, 2078830522U, 2101467502U,
+    2124350982U, 2147483648U};
+
+/// Table lookup with linear interpolation; @p frac30 is a Q0.30 position in [0, 1).
+GS_CONSTEXPR uint32_t interpolate(const uint32_t* table, uint32_t frac30) noexcept
+{
+    const uint32_t idx = frac30 >> SEGMENT_SHIFT;
+    const uint32_t rem = frac30 & SEGMENT_MASK;
+    const uint32_t lo = table[idx];
+    const uint32_t step = table[idx + 1] - lo;
+    return lo + static_cast<uint32_t>((static_cast<uint64_t>(step) * rem) >> SEGMENT_SHIFT);
+}
+
+/// log2(raw / 2^frac_bits) in Q30 for raw > 0.
+GS_CONSTEXPR int64_t log2_q30(uint32_t raw, int frac_bits) noexcept
+{
+    const int msb = 31 - clz32(raw);
+    // Mantissa in [1, 2) as Q1.30
+    const uint32_t mantissa = msb >= 30 ? raw >> (msb - 30) : raw << (30 - msb);
+    const uint32_t frac30 = mantissa - (uint32_t{1} << 30);
+    return static_cast<int64_t>(msb - frac_bits) * (int64_t{1} << 30) +
+           interpolate(LOG2_TABLE, frac30);
+}
+
+/// 2^(value / 2^frac_bits) as a raw value with @p out_frac fraction bits,
+/// saturated to int64 (the caller's from_raw() then saturates to its format).
+GS_CONSTEXPR int64_t exp2_raw(int64_t value, int frac_bits, int out_frac) noexcept
+{
+    const int64_t whole = value >> frac_bits; // floor
+    const auto frac = static_cast<uint64_t>(value - whole * (int64_t{1} << frac_bits));
+    const auto frac30 = static_cast<uint32_t>(frac_bits >= 30 ? frac >> (frac_bits - 30)
+                                                              : frac << (30 - frac_bits));
+    const int64_t mantissa = interpolate(EXP2_TABLE, frac30); // Q1.30 in [1, 2]
+    const int64_t shift = whole + out_frac - 30;
+    if (shift > 31) {
+        return INT64_MAX;
+    }
+    return shift < -62 ? 0 : round_shift(mantissa, static_cast<int>(-shift));
+}
+
+} // namespace fixed_detail
+
+/// sqrt(x), truncated; negative input gives 0.
+template <int I, int F> GS_NODISCARD GS_CONSTEXPR Q<I, F> sqrt(Q<I, F> x) noexcept
+{
+    if (x.raw() <= 0) {
+        return Q<I, F>::zero();
+    }
+    return Q<I, F>::from_raw(isqrt_u64(static_cast<uint64_t>(x.raw()) << F));
+}
+
+/// log2(x); x <= 0 saturates to min().
+template <int I, int F> GS_NODISCARD GS_CONSTEXPR Q<I, F> log2(Q<I, F> x) noexcept
+{
+    if (x.raw() <= 0) {
+        return Q<I, F>::min();
+    }
+    return Q<I, F>::from_raw(fixed_detail::round_shift(
+        fixed_detail::log2_q30(static_cast<uint32_t>(x.raw()), F), 30 - F));
+}
+
+/// Natural logarithm; x <= 0 saturates to min().
+template <int I, int F> GS_NODISCARD GS_CONSTEXPR Q<I, F> ln(Q<I, F> x) noexcept
+{
+    if (x.raw() <= 0) {
+        return Q<I, F>::min();
+    }
+    const int64_t l2 = fixed_detail::log2_q30(static_cast<uint32_t>(x.raw()), F);
+    // |l2| < 2^36: drop two bits from each factor so the product fits int64
+    const int64_t q30 = ((l2 >> 2) * (fixed_detail::LN2_Q30 >> 2)) >> 26;
+    return Q<I, F>::from_raw(fixed_detail::round_shift(q30, 30 - F));
+}
+
+/// 2^x, saturating at max(); underflow gives 0.
+template <int I, int F> GS_NODISCARD GS_CONSTEXPR Q<I, F> exp2(Q<I, F> x) noexcept
+{
+    return Q<I, F>::from_raw(fixed_detail::exp2_raw(x.raw(), F, F));
+}
+
+/// e^x, saturating at max(); underflow gives 0.
+template <int I, int F> GS_NODISCARD GS_CONSTEXPR Q<I, F> exp(Q<I, F> x) noexcept
+{
+    return Q<I, F>::from_raw(
+        fixed_detail::exp2_raw(static_cast<int64_t>(x.raw()) * fixed_detail::LOG2E_Q30, F + 30, F));
+}
+
+/// 1 / x by Newton-Raphson (no divide); 0 saturates to max().
+template <int I, int F> GS_NODISCARD GS_CONSTEXPR Q<I, F> reciprocal(Q<I, F> x) noexcept
+{
+    if (x.raw() == 0) {
+        return Q<I, F>::max();
+    }
+    if (x.raw() < 0) {
+        return -reciprocal(Q<I, F>::from_raw(-static_cast<int64_t>(x.raw())));
+    }
+    const auto raw = static_cast<uint32_t>(x.raw());
+    const int msb = 31 - fixed_detail::clz32(raw);
+    // d in [0.5, 1) as Q0.32, 1/d in [1, 2] as Q2.30
+    const uint64_t d = static_cast<uint64_t>(raw) << (32 - msb - 1);
+    uint64_t inv = fixed_detail::RECIP_SEED_A - ((fixed_detail::RECIP_SEED_B * d) >> 33);
+    for (int step = 0; step < 3; ++step) {
+        const uint64_t dx = (d * inv) >> 32; // ~1.0 in Q2.30
+        inv = (inv * ((uint64_t{2} << 30) - dx)) >> 30;
+    }
+    // 1/x = (1/d) * 2^(F - msb - 1); raw result = inv * 2^(2F - msb - 31)
+    const int shift = msb + 31 - 2 * F;
+    if (shift < -31) {
+        return Q<I, F>::max();
+    }
+    return Q<I, F>::from_raw(fixed_detail::round_shift(static_cast<int64_t>(inv), shift));
+}
+
+} // namespace gridshield::utils
@@ -0,0 +1,420 @@
+/**
+ * @file flat_map.hpp
+ * @author zuudevs (zuudevs@gmail.com)
+ * @brief Fixed-capacity open-addressing FlatMap / FlatSet
+ * @version 1.0
+ * @date 2026-03-20
+ *
+ * Associative lookups without heap or exceptions. Entries live in a dense
+ * array (iteration is a plain array walk); a power-of-two bucket table of
+ * {hash, entry index, probe distance} indexes them with Robin-Hood linear
+ * probing, so probe lengths stay short even at the 80 % worst-case load,
+ * and a miss stops as soon as it meets a bucket closer to home than itself.
+ * Erase uses backward-shift deletion: no tombstones, no periodic rehash.
+ *
+ * FlatOrder::Insertion keeps the dense array in insertion order (erase is
+ * then O(N) — fine for the config/peer sized maps it is meant for);
+ * FlatOrder::Unordered fills an erased entry with the last one in O(1).
+ *
+ * Hash is pluggable: FlatHash covers integers, enums and byte arrays;
+ * hash_string() / "..."_gs_hash give the same FNV-1a value at compile
+ * time and at run time, so string keys can be stored as their hash.
+ *
+ * @note Header-only, zero heap allocation.
+ */
+
+#pragma once
+
+#include "core/error.hpp"
+#include "utils/gs_macros.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+namespace gridshield::utils {
+
+// ============================================================================
+// HASHING
+// ============================================================================
+static constexpr uint32_t FNV1A_OFFSET = 2166136261U;
+static constexpr uint32_t FNV1A_PRIME = 16777619U;
+
+/// FNV-1a over a NUL-terminated string (at most @p max_len bytes).
+GS_CONSTEXPR uint32_t hash_string(const char* str, size_t max_len = SIZE_MAX) noexcept
+{
+    uint32_t h = FNV1A_OFFSET;
+    for (size_t i = 0; str != nullptr && i < max_len && str[i] != '\0'; ++i) {
+        h = (h ^ static_cast<uint8_t>(str[i])) * FNV1A_PRIME;
+    }
+    return h;
+}
+
+/// FNV-1a over @p len bytes.
+GS_CONSTEXPR uint32_t hash_bytes(const uint8_t* data, size_t len) noexcept
+{
+    uint32_t h = FNV1A_OFFSET;
+    for (size_t i = 0; i < len; ++i) {
+        h = (h ^ data[i]) * FNV1A_PRIME;
+    }
+    return h;
+}
+
+namespace literals {
+
+/// "interval_ms"_gs_hash == hash_string("interval_ms"), usable as a case label.
+GS_CONSTEXPR uint32_t operator""_gs_hash(const char* str, size_t len) noexcept
+{
+    return hash_string(str, len);
+}
+
+} // namespace literals
+
+/// Default hash: integers/enums (64-bit finalizer), byte arrays (FNV-1a).
+template <typename K, typename = void> struct FlatHash;
+
+template <typename K>
+struct FlatHash<K,
+                typename std::enable_if<std::is_integral<K>::value ||
+                                        std::is_enum<K>::value>::type>
+{
+    GS_CONSTEXPR uint32_t operator()(K key) const noexcept
+    {
+        // murmur3 fmix64: sequential ids spread over the whole table
+        uint64_t x = static_cast<uint64_t>(key);
+        x ^= x >> 33;
+        x *= 0xFF51AFD7ED558CCDULL;
+        x ^= x >> 33;
+        x *= 0xC4CEB9FE1A85EC53ULL;
+        x ^= x >> 33;
+        return static_cast<uint32_t>(x);
+    }
+};
+
+template <size_t Len> struct FlatHash<std::array<uint8_t, Len>>
+{
+    GS_CONSTEXPR uint32_t operator()(const std::array<uint8_t, Len>& key) const noexcept
+    {
+        return hash_bytes(key.data(), Len);
+    }
+};
+
+// ============================================================================
+// FLAT MAP
+// ============================================================================
+enum class FlatOrder : uint8_t
+{
+    Unordered = 0, // O(1) erase; iteration order arbitrary
+    Insertion = 1  // iteration in insertion order; O(N) erase
+};
+
+/**
+ * @tparam K     Key (equality-comparable, copyable)
+ * @tparam V     Mapped value (default-constructible, copyable)
+ * @tparam N     Maximum entries
+ * @tparam Hash  uint32_t operator()(const K&) const noexcept
+ * @tparam Order FlatOrder::Unordered or FlatOrder::Insertion
+ */
+template <typename K,
+          typename V,
+          size_t N,
+          typename Hash = FlatHash<K>,
+          FlatOrder Order = FlatOrder::Unordered>
+class FlatMap
+{
+    static_assert(N > 0 && N <= 32768, "FlatMap capacity must be 1..32768");
+
+public:
+    struct Entry
+    {
+        K key{};
+        V value{};
+    };
+
+    FlatMap() noexcept
+    {
+        clear();
+    }
+
+    void clear() noexcept
+    {
+        buckets_.fill(Bucket{});
+        size_ = 0;
+    }
+
+    // === Lookup ===
+
+    GS_NODISCARD V* find(const K& key) noexcept
+    {
+        const size_t pos = locate(key);
+        return pos == NPOS ? nullptr : &entries_[buckets_[pos].index].value;
+    }
+
+    GS_NODISCARD const V* find(const K& key) const noexcept
+    {
+        const size_t pos = locate(key);
+        return pos == NPOS ? nullptr : &entries_[buckets_[pos].index].value;
+    }
+
+    GS_NODISCARD bool contains(const K& key) const noexcept
+    {
+        return locate(key) != NPOS;
+    }
+
+    // === Modification ===
+
+    /**
+     * @brief Insert @p key or overwrite its value.
+     * @return Pointer to the stored value; ResourceExhausted when full.
+     */
+    core::Result<V*> insert(const K& key, const V& value) noexcept
+    {
+        V* existing = find(key);
+        if (existing != nullptr) {
+            *existing = value;
+            return core::Result<V*>{existing};
+        }
+        if (GS_UNLIKELY(size_ >= N)) {
+            return core::Result<V*>{GS_MAKE_ERROR(core::ErrorCode::ResourceExhausted)};
+        }
+        const auto index = static_cast<uint16_t>(size_++);
+        entries_[index].key = key;
+        entries_[index].value = value;
+        place(Bucket{hash_(key), index, 1});
+        return core::Result<V*>{&entries_[index].value};
+    }
+
+    /// Remove @p key; false if it was not present.
+    bool erase(const K& key) noexcept
+    {
+        size_t pos = locate(key);
+        if (pos == NPOS) {
+            return false;
+        }
+        const uint16_t index = buckets_[pos].index;
+
+        // Backward shift: pull the rest of the cluster one step closer to home
+        size_t next = (pos + 1) & MASK;
+        while (buckets_[next].dist > 1) {
+            buckets_[pos] = buckets_[next];
+            --buckets_[pos].dist;
+            pos = next;
+            next = (next + 1) & MASK;
+        }
+        buckets_[pos] = Bucket{};
+
+        remove_entry(index);
+        return true;
+    }
+
+    // === Iteration (dense entries) ===
+
+    GS_NODISCARD Entry* begin() noexcept
+    {
+        return entries_.data();
+    }
+    GS_NODISCARD Entry* end() noexcept
+    {
+        return entries_.data() + size_;
+    }
+    GS_NODISCARD const Entry* begin() const noexcept
+    {
+        return entries_.data();
+    }
+    GS_NODISCARD const Entry* end() const noexcept
+    {
+        return entries_.data() + size_;
+    }
+
+    // === Accessors ===
+
+    GS_NODISCARD size_t size() const noexcept
+    {
+        return size_;
+    }
+    GS_NODISCARD bool empty() const noexcept
+    {
+        return size_ == 0;
+    }
+    GS_NODISCARD bool full() const noexcept
+    {
+        return size_ >= N;
+    }
+    static constexpr size_t capacity() noexcept
+    {
+        return N;
+    }
+    static constexpr size_t bucket_count() noexcept
+    {
+        return BUCKETS;
+    }
+
+    /// Longest probe sequence in the table (1 = every key at home).
+    GS_NODISCARD uint16_t max_probe() const noexcept
+    {
+        uint16_t worst = 0;
+        for (const auto& bucket : buckets_) {
+            worst = bucket.dist > worst ? bucket.dist : worst;
+        }
+        return worst;
+    }
+
+private:
+    static constexpr size_t NPOS = SIZE_MAX;
+
+    /// Smallest power of two keeping the load at or under 80 %.
+    static constexpr size_t bucket_count_for(size_t n) noexcept
+    {
+        size_t b = 4;
+        while (b * 4 < n * 5) {
+            b <<= 1;
+        }
+        return b;
+    }
+    static constexpr size_t BUCKETS = bucket_count_for(N);
+    static constexpr size_t MASK = BUCKETS - 1;
+
+    struct Bucket
+    {
+        uint32_t hash{0};
+        uint16_t index{0};
+        uint16_t dist{0}; // probe distance + 1; 0 = empty
+    };
+
+    size_t locate(const K& key) const noexcept
+    {
+        const uint32_t h = hash_(key);
+        size_t pos = h & MASK;
+        for (uint16_t dist = 1;; ++dist) {
+            const Bucket& bucket = buckets_[pos];
+            // Robin-Hood invariant: the key would have displaced a richer bucket
+            if (bucket.dist < dist) {
+                return NPOS;
+            }
+            if (bucket.hash == h && entries_[bucket.index].key == key) {
+                return pos;
+            }
+            pos = (pos + 1) & MASK;
+        }
+    }
+
+    void place(Bucket incoming) noexcept
+    {
+        size_t pos = incoming.hash & MASK;
+        for (;;) {
+            Bucket& bucket = buckets_[pos];
+            if (bucket.dist == 0) {
+                bucket = incoming;
+                return;
+            }
+            if (bucket.dist < incoming.dist) {
+                // Take from the rich: the resident is closer to home than we are
+                const Bucket resident = bucket;
+                bucket = incoming;
+                incoming = resident;
+            }
+            pos = (pos + 1) & MASK;
+            ++incoming.dist;
+        }
+    }
+
+    /// Bucket pointing at entry @p index (must exist).
+    size_t bucket_of(uint16_t index) const noexcept
+    {
+        size_t pos = hash_(entries_[index].key) & MASK;
+        while (buckets_[pos].dist == 0 || buckets_[pos].index != index) {
+            pos = (pos + 1) & MASK;
+        }
+        return pos;
+    }
+
+    void remove_entry(uint16_t index) noexcept
+    {
+        const auto last = static_cast<uint16_t>(size_ - 1);
+        if constexpr (Order == FlatOrder::Insertion) {
+            for (uint16_t i = index; i < last; ++i) {
+                entries_[i] = entries_[i + 1];
+            }
+            for (auto& bucket : buckets_) {
+                if (bucket.dist != 0 && bucket.index > index) {
+                    --bucket.index;
+                }
+            }
+        } else {
+            if (index != last) {
+                buckets_[bucket_of(last)].index = index;
+                entries_[index] = entries_[last];
+            }
+        }
+        entries_[last] = Entry{};
+        --size_;
+    }
+
+    std::array<Entry, N> entries_{};
+    std::array<Bucket, BUCKETS> buckets_{};
+    size_t size_{0};
+    Hash hash_{};
+};
+
+// ============================================================================
+// FLAT SET
+// ============================================================================
+template <typename K,
+          size_t N,
+          typename Hash = FlatHash<K>,
+          FlatOrder Order = FlatOrder::Unordered>
+class FlatSet
+{
+public:
+    using Map = FlatMap<K, uint8_t, N, Hash, Order>;
+
+    /// true if inserted, false if already present; ResourceExhausted when full.
+    core::Result<bool> insert(const K& key) noexcept
+    {
+        if (map_.contains(key)) {
+            return core::Result<bool>{false};
+        }
+        auto r = map_.insert(key, 0);
+        if (r.is_error()) {
+            return core::Result<bool>{r.error()};
+        }
+        return core::Result<bool>{true};
+    }
+
+    GS_NODISCARD bool contains(const K& key) const noexcept
+    {
+        return map_.contains(key);
+    }
+    bool erase(const K& key) noexcept
+    {
+        return map_.erase(key);
+    }
+    void clear() noexcept
+    {
+        map_.clear();
+    }
+
+    /// Entries expose .key (the .value byte is unused).
+    GS_NODISCARD const typename Map::Entry* begin() const noexcept
+    {
+        return map_.begin();
+    }
+    GS_NODISCARD const typename Map::Entry* end() const noexcept
+    {
+        return map_.end();
+    }
+    GS_NODISCARD size_t size() const noexcept
+    {
+        return map_.size();
+    }
+    static constexpr size_t capacity() noexcept
+    {
+        return N;
+    }
+
+private:
+    Map map_{};
+};
+
+} // namespace gridshield::utils
@@ -5,23 +5,36 @@
  * @version 1.0
  * @date 2026-02-23
  *
- * Provides hardware-backed crypto (esp_random, mbedTLS), NVS storage,
- * and Task Watchdog Timer for production and QEMU builds.
+ * Provides hardware-backed crypto (esp_random, mbedTLS), batched NVS storage,
+ * raw data-partition flash storage, esp_timer clock, oneshot ADC and
+ * Task Watchdog Timer for production and QEMU builds. Classes are final
+ * so a statically bound platform (see static_platform.hpp) can inline them.
  *
  * @copyright Copyright (c) 2026
  */
 
 #pragma once
 
+#include "platform/flash_storage.hpp"
+#include "platform/nvs_storage.hpp"
 #include "platform/platform.hpp"
+#include "utils/deferred_log.hpp"
 #include "utils/gs_macros.hpp"
 
 #include <cstring>
 
 // ESP-IDF APIs
+#include "esp_adc/adc_cali.h"
+#include "esp_adc/adc_cali_scheme.h"
+#include "esp_adc/adc_oneshot.h"
 #include "esp_crc.h"
+#include "esp_log.h"
+#include "esp_partition.h"
 #include "esp_random.h"
 #include "esp_task_wdt.h"
+#include "esp_timer.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
 #include "nvs.h"
 #include "nvs_flash.h"
 
@@ -33,7 +46,7 @@ namespace gridshield::platform::esp32 {
 // ============================================================================
 // ESP32 CRYPTO — Hardware RNG + mbedTLS SHA-256 + CRC32
 // ============================================================================
-class Esp32Crypto : public IPlatformCrypto
+class Esp32Crypto final : public IPlatformCrypto
 {
 public:
     Esp32Crypto() noexcept = default;
@@ -79,131 +92,338 @@ public:
 };
 
 // ============================================================================
-// ESP32 NVS STORAGE — Non-Volatile Storage backed key/config store
+// ESP32 TIME — esp_timer (64-bit µs since boot)
 // ============================================================================
-class Esp32Storage : public IPlatformStorage
+class Esp32Time final : public IPlatformTime
 {
 public:
-    static constexpr size_t MAX_BLOB_SIZE = 4096;
-    static constexpr const char* NVS_NAMESPACE = "gridshield";
+    core::timestamp_t get_timestamp_ms() noexcept override
+    {
+        static constexpr int64_t US_PER_MS = 1000;
+        return static_cast<core::timestamp_t>(esp_timer_get_time() / US_PER_MS);
+    }
 
-    Esp32Storage() noexcept = default;
+    uint64_t get_timestamp_us() noexcept override
+    {
+        return static_cast<uint64_t>(esp_timer_get_time());
+    }
 
-    /**
-     * @brief Initialize NVS flash. Must be called once before use.
-     */
-    core::Result<void> init() noexcept
+    void delay_ms(uint32_t milliseconds) noexcept override
     {
-        esp_err_t err = nvs_flash_init();
-        if (err == ESP_ERR_NVS_NO_FREE_PAGES || err == ESP_ERR_NVS_NEW_VERSION_FOUND) {
-            // NVS partition was truncated — erase and re-init
-            nvs_flash_erase();
-            err = nvs_flash_init();
+        vTaskDelay(pdMS_TO_TICKS(milliseconds));
+    }
+};
+
+// ============================================================================
+// ESP32 ADC — ADC1 oneshot driver with per-channel calibration
+// ============================================================================
+class Esp32ADC final : public IPlatformADC
+{
+public:
+    static constexpr uint8_t MAX_CHANNELS = 10;
+
+    Esp32ADC() noexcept = default;
+    ~Esp32ADC() noexcept override
+    {
+        for (auto& cali : cali_) {
+            release_cali(cali);
         }
+        if (unit_ != nullptr) {
+            adc_oneshot_del_unit(unit_);
+        }
+    }
 
-        if (err != ESP_OK) {
+    Esp32ADC(const Esp32ADC&) = delete;
+    Esp32ADC& operator=(const Esp32ADC&) = delete;
+
+    core::Result<void> init(uint8_t channel, Attenuation atten) noexcept override
+    {
+        if (GS_UNLIKELY(channel >= MAX_CHANNELS)) {
+            return GS_MAKE_ERROR(core::ErrorCode::InvalidParameter);
+        }
+        if (unit_ == nullptr) {
+            adc_oneshot_unit_init_cfg_t unit_cfg{};
+            unit_cfg.unit_id = ADC_UNIT_1;
+            if (adc_oneshot_new_unit(&unit_cfg, &unit_) != ESP_OK) {
+                return GS_MAKE_ERROR(core::ErrorCode::HardwareFailure);
+            }
+        }
+
+        adc_oneshot_chan_cfg_t chan_cfg{};
+        chan_cfg.atten = to_idf(atten);
+        chan_cfg.bitwidth = ADC_BITWIDTH_DEFAULT;
+        const auto idf_channel = static_cast<adc_channel_t>(channel);
+        if (adc_oneshot_config_channel(unit_, idf_channel, &chan_cfg) != ESP_OK) {
             return GS_MAKE_ERROR(core::ErrorCode::HardwareFailure);
         }
 
-        initialized_ = true;
+        // Calibration is optional (eFuse may be blank): fall back to linear
+        release_cali(cali_[channel]);
+        cali_[channel] = create_cali(idf_channel, chan_cfg.atten);
+        configured_mask_ |= static_cast<uint16_t>(1U << channel);
         return core::Result<void>{};
     }
 
-    core::Result<size_t> read(uint32_t address, uint8_t* buffer, size_t length) noexcept override
+    core::Result<uint32_t> read_raw(uint8_t channel) noexcept override
     {
-        if (GS_UNLIKELY(buffer == nullptr || length == 0)) {
-            return core::Result<size_t>(GS_MAKE_ERROR(core::ErrorCode::InvalidParameter));
+        if (GS_UNLIKELY(!is_configured(channel))) {
+            return core::Result<uint32_t>(GS_MAKE_ERROR(core::ErrorCode::ADCReadError));
+        }
+        int raw = 0;
+        if (adc_oneshot_read(unit_, static_cast<adc_channel_t>(channel), &raw) != ESP_OK) {
+            return core::Result<uint32_t>(GS_MAKE_ERROR(core::ErrorCode::ADCReadError));
+        }
+        return core::Result<uint32_t>(static_cast<uint32_t>(raw));
+    }
+
+    core::Result<uint32_t> read_mv(uint8_t channel) noexcept override
+    {
+        auto raw = read_raw(channel);
+        if (raw.is_error()) {
+            return raw;
         }
+        if (cali_[channel] != nullptr) {
+            int mv = 0;
+            if (adc_cali_raw_to_voltage(cali_[channel], static_cast<int>(raw.value()), &mv) ==
+                ESP_OK) {
+                return core::Result<uint32_t>(static_cast<uint32_t>(mv));
+            }
+        }
+        static constexpr uint32_t ADC_MAX_RAW = 4095;
+        static constexpr uint32_t ADC_MAX_MV = 3300;
+        return core::Result<uint32_t>((raw.value() * ADC_MAX_MV) / ADC_MAX_RAW);
+    }
 
-        nvs_handle_t handle;
-        esp_err_t err = nvs_open(NVS_NAMESPACE, NVS_READONLY, &handle);
+private:
+    GS_NODISCARD bool is_configured(uint8_t channel) const noexcept
+    {
+        return channel < MAX_CHANNELS && (configured_mask_ & (1U << channel)) != 0;
+    }
+
+    static adc_atten_t to_idf(Attenuation atten) noexcept
+    {
+        switch (atten) {
+            case Attenuation::Db0:
+                return ADC_ATTEN_DB_0;
+            case Attenuation::Db2_5:
+                return ADC_ATTEN_DB_2_5;
+            case Attenuation::Db6:
+                return ADC_ATTEN_DB_6;
+            case Attenuation::Db12:
+            default:
+                return ADC_ATTEN_DB_12;
+        }
+    }
+
+    static adc_cali_handle_t create_cali(adc_channel_t channel, adc_atten_t atten) noexcept
+    {
+        adc_cali_handle_t handle = nullptr;
+#if ADC_CALI_SCHEME_CURVE_FITTING_SUPPORTED
+        adc_cali_curve_fitting_config_t cfg{};
+        cfg.unit_id = ADC_UNIT_1;
+        cfg.chan = channel;
+        cfg.atten = atten;
+        cfg.bitwidth = ADC_BITWIDTH_DEFAULT;
+        if (adc_cali_create_scheme_curve_fitting(&cfg, &handle) != ESP_OK) {
+            handle = nullptr;
+        }
+#elif ADC_CALI_SCHEME_LINE_FITTING_SUPPORTED
+        (void)channel;
+        adc_cali_line_fitting_config_t cfg{};
+        cfg.unit_id = ADC_UNIT_1;
+        cfg.atten = atten;
+        cfg.bitwidth = ADC_BITWIDTH_DEFAULT;
+        if (adc_cali_create_scheme_line_fitting(&cfg, &handle) != ESP_OK) {
+            handle = nullptr;
+        }
+#else
+        (void)channel;
+        (void)atten;
+#endif
+        return handle;
+    }
+
+    static void release_cali(adc_cali_handle_t& handle) noexcept
+    {
+        if (handle == nullptr) {
+            return;
+        }
+#if ADC_CALI_SCHEME_CURVE_FITTING_SUPPORTED
+        adc_cali_delete_scheme_curve_fitting(handle);
+#elif ADC_CALI_SCHEME_LINE_FITTING_SUPPORTED
+        adc_cali_delete_scheme_line_fitting(handle);
+#endif
+        handle = nullptr;
+    }
+
+    adc_oneshot_unit_handle_t unit_{nullptr};
+    adc_cali_handle_t cali_[MAX_CHANNELS]{};
+    uint16_t configured_mask_{0};
+};
+
+// ============================================================================
+// ESP32 NVS BACKEND — persistent namespace handle for BatchedNvsStorage
+// ============================================================================
+class Esp32NvsBackend
+{
+public:
+    static constexpr const char* NVS_NAMESPACE = "gridshield";
+
+    /// Initialize NVS flash and open the namespace once.
+    core::Result<void> open() noexcept
+    {
+        if (handle_open_) {
+            return core::Result<void>{};
+        }
+        esp_err_t err = nvs_flash_init();
+        if (err == ESP_ERR_NVS_NO_FREE_PAGES || err == ESP_ERR_NVS_NEW_VERSION_FOUND) {
+            // NVS partition was truncated — erase and re-init
+            nvs_flash_erase();
+            err = nvs_flash_init();
+        }
+        if (err == ESP_OK) {
+            err = nvs_open(NVS_NAMESPACE, NVS_READWRITE, &handle_);
+        }
         if (err != ESP_OK) {
-            // No data stored yet — return zeroed buffer
-            memset(buffer, 0xFF, length);
-            return core::Result<size_t>(length);
+            return GS_MAKE_ERROR(core::ErrorCode::HardwareFailure);
         }
+        handle_open_ = true;
+        return core::Result<void>{};
+    }
 
-        // Use address as key name: "blk_0000", "blk_0001", etc.
-        char key[16];
-        snprintf(key, sizeof(key), "blk_%04X", static_cast<unsigned>(address));
+    void close() noexcept
+    {
+        if (handle_open_) {
+            nvs_close(handle_);
+            handle_open_ = false;
+        }
+    }
 
+    core::Result<size_t> get_blob(const char* key, uint8_t* buffer, size_t length) noexcept
+    {
         size_t required_size = length;
-        err = nvs_get_blob(handle, key, buffer, &required_size);
-        nvs_close(handle);
-
+        const esp_err_t err = nvs_get_blob(handle_, key, buffer, &required_size);
         if (err == ESP_ERR_NVS_NOT_FOUND) {
-            // Key doesn't exist — simulate empty flash (0xFF)
-            memset(buffer, 0xFF, length);
-            return core::Result<size_t>(length);
+            return core::Result<size_t>(static_cast<size_t>(0));
         }
-
         if (err != ESP_OK) {
             return core::Result<size_t>(GS_MAKE_ERROR(core::ErrorCode::HardwareFailure));
         }
-
         return core::Result<size_t>(required_size);
     }
 
-    core::Result<size_t>
-    write(uint32_t address, const uint8_t* data, size_t length) noexcept override
+    core::Result<void> set_blob(const char* key, const uint8_t* data, size_t length) noexcept
     {
-        if (GS_UNLIKELY(data == nullptr || length == 0)) {
-            return core::Result<size_t>(GS_MAKE_ERROR(core::ErrorCode::InvalidParameter));
+        if (nvs_set_blob(handle_, key, data, length) != ESP_OK) {
+            return GS_MAKE_ERROR(core::ErrorCode::HardwareFailure);
         }
+        return core::Result<void>{};
+    }
 
-        if (length > MAX_BLOB_SIZE) {
-            return core::Result<size_t>(GS_MAKE_ERROR(core::ErrorCode::BufferOverflow));
+    core::Result<void> erase_key(const char* key) noexcept
+    {
+        const esp_err_t err = nvs_erase_key(handle_, key);
+        if (err != ESP_OK && err != ESP_ERR_NVS_NOT_FOUND) {
+            return GS_MAKE_ERROR(core::ErrorCode::HardwareFailure);
         }
+        return core::Result<void>{};
+    }
 
-        nvs_handle_t handle;
-        esp_err_t err = nvs_open(NVS_NAMESPACE, NVS_READWRITE, &handle);
-        if (err != ESP_OK) {
-            return core::Result<size_t>(GS_MAKE_ERROR(core::ErrorCode::HardwareFailure));
+    core::Result<void> commit() noexcept
+    {
+        if (nvs_commit(handle_) != ESP_OK) {
+            return GS_MAKE_ERROR(core::ErrorCode::HardwareFailure);
         }
+        return core::Result<void>{};
+    }
+
+    uint64_t now_ms() noexcept
+    {
+        return static_cast<uint64_t>(esp_timer_get_time()) / 1000U;
+    }
 
-        char key[16];
-        snprintf(key, sizeof(key), "blk_%04X", static_cast<unsigned>(address));
+private:
+    nvs_handle_t handle_{};
+    bool handle_open_{false};
+};
 
-        err = nvs_set_blob(handle, key, data, length);
-        if (err == ESP_OK) {
-            err = nvs_commit(handle);
-        }
+/// NVS-backed key/config store: persistent handle, begin_batch()/commit().
+using Esp32Storage = BatchedNvsStorage<Esp32NvsBackend>;
 
-        nvs_close(handle);
+// ============================================================================
+// ESP32 PARTITION DEVICE — raw esp_partition access for PageCachedStorage
+// ============================================================================
+class Esp32PartitionDevice
+{
+public:
+    static constexpr size_t SECTOR_SIZE = 4096; // SPI flash erase unit
+    static constexpr const char* DEFAULT_LABEL = "gsdata";
 
-        if (err != ESP_OK) {
-            return core::Result<size_t>(GS_MAKE_ERROR(core::ErrorCode::HardwareFailure));
-        }
+    Esp32PartitionDevice() noexcept = default;
 
-        return core::Result<size_t>(length);
+    /**
+     * @brief Bind to the data partition named @p label (see partitions.csv).
+     */
+    core::Result<void> init(const char* label = DEFAULT_LABEL) noexcept
+    {
+        partition_ =
+            esp_partition_find_first(ESP_PARTITION_TYPE_DATA, ESP_PARTITION_SUBTYPE_ANY, label);
+        if (partition_ == nullptr) {
+            return GS_MAKE_ERROR(core::ErrorCode::NotSupported);
+        }
+        return core::Result<void>{};
     }
 
-    core::Result<void> erase(uint32_t address, size_t length) noexcept override
+    GS_NODISCARD size_t size_bytes() const noexcept
     {
-        (void)length; // NVS erases by key, not by range
+        return (partition_ != nullptr) ? partition_->size : 0;
+    }
 
-        nvs_handle_t handle;
-        esp_err_t err = nvs_open(NVS_NAMESPACE, NVS_READWRITE, &handle);
-        if (err != ESP_OK) {
-            return GS_MAKE_ERROR(core::ErrorCode::HardwareFailure);
+    core::Result<void> read(uint32_t offset, uint8_t* buffer, size_t length) noexcept
+    {
+        if (GS_UNLIKELY(partition_ == nullptr)) {
+            return GS_MAKE_ERROR(core::ErrorCode::SystemNotInitialized);
         }
+        return check(esp_partition_read(partition_, offset, buffer, length));
+    }
 
-        char key[16];
-        snprintf(key, sizeof(key), "blk_%04X", static_cast<unsigned>(address));
+    /// NOR program (bits 1 → 0 only). Not valid on encrypted partitions.
+    core::Result<void> program(uint32_t offset, const uint8_t* data, size_t length) noexcept
+    {
+        if (GS_UNLIKELY(partition_ == nullptr)) {
+            return GS_MAKE_ERROR(core::ErrorCode::SystemNotInitialized);
+        }
+        return check(esp_partition_write(partition_, offset, data, length));
+    }
 
-        err = nvs_erase_key(handle, key);
-        if (err == ESP_OK || err == ESP_ERR_NVS_NOT_FOUND) {
-            nvs_commit(handle);
+    core::Result<void> erase_sector(uint32_t offset) noexcept
+    {
+        if (GS_UNLIKELY(partition_ == nullptr)) {
+            return GS_MAKE_ERROR(core::ErrorCode::SystemNotInitialized);
         }
+        return check(esp_partition_erase_range(partition_, offset, SECTOR_SIZE));
+    }
 
-        nvs_close(handle);
-        return core::Result<void>{};
+    core::Result<void> sync() noexcept
+    {
+        return core::Result<void>{}; // esp_partition_write is synchronous
     }
 
 private:
-    bool initialized_{false};
+    static core::Result<void> check(esp_err_t err) noexcept
+    {
+        if (err != ESP_OK) {
+            return GS_MAKE_ERROR(core::ErrorCode::HardwareFailure);
+        }
+        return core::Result<void>{};
+    }
+
+    const esp_partition_t* partition_{nullptr};
 };
 
+/// Raw-partition storage: byte-addressable, sector-aware, 2 × 4 KB write-back cache.
+using Esp32FlashStorage = PageCachedStorage<Esp32PartitionDevice>;
+
 // ============================================================================
 // ESP32 WATCHDOG — Task Watchdog Timer
 // ============================================================================
@@ -251,4 +471,68 @@ public:
     }
 };
 
+// ============================================================================
+// ESP32 DEFERRED LOG DRAIN — formats GS_DLOGx records off the hot path
+// ============================================================================
+class Esp32LogDrain
+{
+public:
+    static constexpr uint32_t DEFAULT_PERIOD_MS = 50;
+    static constexpr uint32_t STACK_BYTES = 3072;
+
+    /**
+     * @brief Stamp records with esp_log_timestamp() and start a drain task
+     *        just above idle priority that prints them through esp_log.
+     */
+    static core::Result<void> start(uint32_t period_ms = DEFAULT_PERIOD_MS,
+                                    UBaseType_t priority = tskIDLE_PRIORITY + 1) noexcept
+    {
+        utils::deferred_log().set_clock(&esp_log_timestamp);
+        period_ms_ = period_ms;
+        if (xTaskCreate(&run, "gs_log", STACK_BYTES, nullptr, priority, nullptr) != pdPASS) {
+            return GS_MAKE_ERROR(core::ErrorCode::ResourceExhausted);
+        }
+        return core::Result<void>{};
+    }
+
+private:
+    static void run(void* /*arg*/) noexcept
+    {
+        for (;;) {
+            (void)utils::deferred_log().drain(&print, nullptr);
+            vTaskDelay(pdMS_TO_TICKS(period_ms_));
+        }
+    }
+
+    static void print(void* /*ctx*/, const utils::DeferredLogLine& line) noexcept
+    {
+        char tag[24];
+        const size_t tag_len = line.tag_len < sizeof(tag) - 1 ? line.tag_len : sizeof(tag) - 1;
+        std::memcpy(tag, line.tag, tag_len);
+        tag[tag_len] = '\0';
+
+        esp_log_level_t level = ESP_LOG_INFO;
+        switch (line.level) {
+        case 'E':
+            level = ESP_LOG_ERROR;
+            break;
+        case 'W':
+            level = ESP_LOG_WARN;
+            break;
+        case 'D':
+            level = ESP_LOG_DEBUG;
+            break;
+        case 'V':
+            level = ESP_LOG_VERBOSE;
+            break;
+        default:
+            break;
+        }
+        esp_log_write(level, tag, "%c (%u) %s: %s\n", line.level,
+                      static_cast<unsigned>(line.timestamp), tag, line.text);
+    }
+
+    static inline uint32_t period_ms_{DEFAULT_PERIOD_MS};
+};
+
 } // namespace gridshield::platform::esp32
@@ -0,0 +1,370 @@
+/**
+ * @file flash_sim.hpp
+ * @author zuudevs (zuudevs@gmail.com)
+ * @brief NOR/NAND flash simulator with wear counters and power-cut injection
+ * @version 1.0
+ * @date 2026-03-13
+ *
+ * SimFlashDevice satisfies the flash device contract of flash_storage.hpp,
+ * so SimFlashStorage (PageCachedStorage over it) is an IPlatformStorage
+ * with real erase-before-write, sector granularity and torn-write
+ * behaviour. Every operation is charged the chip's typical latency (and
+ * optionally advances a SimClock); every erase bumps a per-sector counter.
+ *
+ * Fault hooks:
+ *   cut_power_after(n)          - the next n programmed bytes land, then power dies
+ *   cut_power_during_erase(k)   - the k-th erase from now stops half way
+ * While unpowered every operation fails with HardwareFailure; power_on()
+ * restores access with the array content as the cut left it.
+ *
+ * @copyright Copyright (c) 2026
+ */
+
+#pragma once
+
+#include "platform/flash_storage.hpp"
+#include "platform/sim_clock.hpp"
+#include "utils/gs_macros.hpp"
+
+#include <cstring>
+
+namespace gridshield::platform::sim {
+
+// ============================================================================
+// CHIP MODELS
+// ============================================================================
+struct FlashChipModel
+{
+    uint16_t page_size{256};         // program granularity
+    uint32_t read_ns_per_byte{100};  // bus-limited
+    uint32_t program_setup_ns{20000};
+    uint32_t program_ns_per_byte{1500};
+    uint32_t erase_sector_us{45000};
+    uint32_t endurance_cycles{100000};
+    bool program_once{false}; // NAND: a page must be erased before it is programmed again
+};
+
+namespace chips {
+
+/// ESP32 module SPI NOR (W25Q32/GD25Q32 class) at 40 MHz DIO.
+/// 256 B page ≈ 0.4 ms, 4 KB sector erase ≈ 45 ms (datasheet typical).
+inline FlashChipModel esp32_nor() noexcept
+{
+    return FlashChipModel{};
+}
+
+/// SLC SPI NAND (W25N01GV class): 2 KB pages, tPROG ≈ 250 µs, block erase ≈ 2 ms.
+inline FlashChipModel spi_nand() noexcept
+{
+    FlashChipModel m;
+    m.page_size = 2048;
+    m.read_ns_per_byte = 20;
+    m.program_setup_ns = 200000;
+    m.program_ns_per_byte = 25;
+    m.erase_sector_us = 2000;
+    m.endurance_cycles = 100000;
+    m.program_once = true;
+    return m;
+}
+
+} // namespace chips
+
+// ============================================================================
+// SIMULATED DEVICE
+// ============================================================================
+struct SimFlashStats
+{
+    uint32_t reads{0};
+    uint32_t programs{0};
+    uint32_t erases{0};
+    uint64_t bytes_read{0};
+    uint64_t bytes_programmed{0};
+    uint64_t busy_ns{0}; // modelled chip time
+    uint32_t program_violations{0}; // NAND re-program without erase
+    uint32_t failed_ops{0};         // rejected while unpowered
+    uint32_t power_cuts{0};
+};
+
+template <size_t SectorSize, size_t SectorCount> class SimFlashDevice
+{
+    static_assert(SectorSize >= 256 && (SectorSize & (SectorSize - 1)) == 0,
+                  "sector size must be a power of two >= 256");
+    static_assert(SectorCount > 0, "need at least one sector");
+
+public:
+    static constexpr size_t SECTOR_SIZE = SectorSize;
+    static constexpr size_t SECTOR_COUNT = SectorCount;
+    static constexpr size_t CAPACITY = SectorSize * SectorCount;
+
+    explicit SimFlashDevice(const FlashChipModel& model = chips::esp32_nor()) noexcept
+    {
+        set_model(model);
+        std::memset(cells_, 0xFF, sizeof(cells_));
+    }
+
+    SimFlashDevice(const SimFlashDevice&) = delete;
+    SimFlashDevice& operator=(const SimFlashDevice&) = delete;
+
+    void set_model(const FlashChipModel& model) noexcept
+    {
+        model_ = model;
+        // Page tracking is kept at 256 B resolution at most
+        if (model_.page_size < 256 || model_.page_size > SectorSize) {
+            model_.page_size = 256;
+        }
+    }
+
+    /// Charge every operation's modelled latency to @p clock as well.
+    void attach_clock(SimClock& clock) noexcept
+    {
+        clock_ = &clock;
+    }
+
+    void detach_clock() noexcept
+    {
+        clock_ = nullptr;
+    }
+
+    // ------------------------------------------------------------------------
+    // Flash device contract
+    // ------------------------------------------------------------------------
+    GS_NODISCARD size_t size_bytes() const noexcept
+    {
+        return CAPACITY;
+    }
+
+    GS_NODISCARD bool program_once() const noexcept
+    {
+        return model_.program_once;
+    }
+
+    core::Result<void> read(uint32_t offset, uint8_t* buffer, size_t length) noexcept
+    {
+        GS_TRY(check(offset, length));
+        std::memcpy(buffer, cells_ + offset, length);
+        ++stats_.reads;
+        stats_.bytes_read += length;
+        charge_ns(static_cast<uint64_t>(length) * model_.read_ns_per_byte);
+        return core::Result<void>{};
+    }
+
+    /// NOR program: clears bits only. Split at page boundaries like the chip.
+    core::Result<void> program(uint32_t offset, const uint8_t* data, size_t length) noexcept
+    {
+        GS_TRY(check(offset, length));
+
+        size_t done = 0;
+        while (done < length) {
+            const uint32_t addr = offset + static_cast<uint32_t>(done);
+            const size_t page = addr / model_.page_size;
+            const size_t in_page = model_.page_size - (addr % model_.page_size);
+            size_t chunk = (length - done) < in_page ? (length - done) : in_page;
+
+            if (model_.program_once && page_programmed_[page]) {
+                ++stats_.program_violations;
+                return GS_MAKE_ERROR(core::ErrorCode::HardwareFailure);
+            }
+
+            bool cut = false;
+            if (cut_armed_ && chunk > cut_budget_) {
+                chunk = cut_budget_;
+                cut = true;
+            }
+            if (chunk > 0) {
+                for (size_t i = 0; i < chunk; ++i) {
+                    cells_[addr + i] &= data[done + i];
+                }
+                page_programmed_[page] = true;
+                ++stats_.programs;
+                stats_.bytes_programmed += chunk;
+                charge_ns(model_.program_setup_ns +
+                          static_cast<uint64_t>(chunk) * model_.program_ns_per_byte);
+            }
+
+            if (cut) {
+                power_fail();
+                return GS_MAKE_ERROR(core::ErrorCode::HardwareFailure);
+            }
+            if (cut_armed_) {
+                cut_budget_ -= static_cast<uint32_t>(chunk);
+            }
+            done += chunk;
+        }
+        return core::Result<void>{};
+    }
+
+    core::Result<void> erase_sector(uint32_t offset) noexcept
+    {
+        if (GS_UNLIKELY(offset % SectorSize != 0)) {
+            return GS_MAKE_ERROR(core::ErrorCode::InvalidParameter);
+        }
+        GS_TRY(check(offset, SectorSize));
+
+        const size_t sector = offset / SectorSize;
+        ++erase_counts_[sector];
+        ++stats_.erases;
+
+        if (erase_tear_countdown_ > 0 && --erase_tear_countdown_ == 0) {
+            // Interrupted erase: only part of the array reached the erased state
+            std::memset(cells_ + offset, 0xFF, SectorSize / 2);
+            charge_ns(static_cast<uint64_t>(model_.erase_sector_us) * 500U);
+            power_fail();
+            return GS_MAKE_ERROR(core::ErrorCode::HardwareFailure);
+        }
+
+        std::memset(cells_ + offset, 0xFF, SectorSize);
+        clear_page_flags(offset);
+        charge_ns(static_cast<uint64_t>(model_.erase_sector_us) * 1000U);
+        return core::Result<void>{};
+    }
+
+    core::Result<void> sync() noexcept
+    {
+        if (GS_UNLIKELY(!powered_)) {
+            ++stats_.failed_ops;
+            return GS_MAKE_ERROR(core::ErrorCode::HardwareFailure);
+        }
+        return core::Result<void>{};
+    }
+
+    // ------------------------------------------------------------------------
+    // Fault injection
+    // ------------------------------------------------------------------------
+
+    /// Let the next @p bytes programmed bytes land, then drop power.
+    void cut_power_after(uint32_t bytes) noexcept
+    {
+        cut_armed_ = true;
+        cut_budget_ = bytes;
+    }
+
+    /// Tear the @p erases_from_now -th erase (1 = the next one).
+    void cut_power_during_erase(uint32_t erases_from_now) noexcept
+    {
+        erase_tear_countdown_ = erases_from_now;
+    }
+
+    /// Restore power and disarm pending faults. Array content is kept.
+    void power_on() noexcept
+    {
+        powered_ = true;
+        cut_armed_ = false;
+        erase_tear_countdown_ = 0;
+    }
+
+    GS_NODISCARD bool powered() const noexcept
+    {
+        return powered_;
+    }
+
+    // ------------------------------------------------------------------------
+    // Wear and statistics
+    // ------------------------------------------------------------------------
+    GS_NODISCARD uint32_t erase_count(size_t sector) const noexcept
+    {
+        return sector < SectorCount ? erase_counts_[sector] : 0;
+    }
+
+    GS_NODISCARD uint32_t max_erase_count() const noexcept
+    {
+        uint32_t worst = 0;
+        for (const auto count : erase_counts_) {
+            worst = count > worst ? count : worst;
+        }
+        return worst;
+    }
+
+    /// Sectors past the model's rated endurance.
+    GS_NODISCARD size_t worn_sectors() const noexcept
+    {
+        size_t worn = 0;
+        for (const auto count : erase_counts_) {
+            worn += (count >= model_.endurance_cycles) ? 1U : 0U;
+        }
+        return worn;
+    }
+
+    GS_NODISCARD const SimFlashStats& stats() const noexcept
+    {
+        return stats_;
+    }
+
+    void reset_stats() noexcept
+    {
+        stats_ = SimFlashStats{};
+    }
+
+    /// Raw array view for assertions (bypasses timing and faults).
+    GS_NODISCARD const uint8_t* raw() const noexcept
+    {
+        return cells_;
+    }
+
+    /// Back to a factory-fresh, powered, erased chip with no clock attached.
+    void reset() noexcept
+    {
+        std::memset(cells_, 0xFF, sizeof(cells_));
+        std::memset(page_programmed_, 0, sizeof(page_programmed_));
+        std::memset(erase_counts_, 0, sizeof(erase_counts_));
+        stats_ = SimFlashStats{};
+        clock_ = nullptr;
+        power_on();
+    }
+
+private:
+    static constexpr size_t MAX_PAGES = CAPACITY / 256;
+
+    core::Result<void> check(uint32_t offset, size_t length) noexcept
+    {
+        if (GS_UNLIKELY(!powered_)) {
+            ++stats_.failed_ops;
+            return GS_MAKE_ERROR(core::ErrorCode::HardwareFailure);
+        }
+        if (GS_UNLIKELY(offset > CAPACITY || length > CAPACITY - offset)) {
+            return GS_MAKE_ERROR(core::ErrorCode::InvalidParameter);
+        }
+        return core::Result<void>{};
+    }
+
+    void clear_page_flags(uint32_t sector_offset) noexcept
+    {
+        const size_t first = sector_offset / model_.page_size;
+        const size_t count = SectorSize / model_.page_size;
+        for (size_t i = 0; i < count; ++i) {
+            page_programmed_[first + i] = false;
+        }
+    }
+
+    void power_fail() noexcept
+    {
+        powered_ = false;
+        cut_armed_ = false;
+        erase_tear_countdown_ = 0;
+        ++stats_.power_cuts;
+    }
+
+    void charge_ns(uint64_t ns) noexcept
+    {
+        stats_.busy_ns += ns;
+        if (clock_ != nullptr) {
+            clock_->advance_us(ns / 1000U);
+        }
+    }
+
+    FlashChipModel model_{};
+    SimClock* clock_{nullptr};
+    bool powered_{true};
+    bool cut_armed_{false};
+    uint32_t cut_budget_{0};
+    uint32_t erase_tear_countdown_{0};
+    uint32_t erase_counts_[SectorCount]{};
+    bool page_programmed_[MAX_PAGES]{};
+    SimFlashStats stats_{};
+    uint8_t cells_[CAPACITY];
+};
+
+/// IPlatformStorage over simulated flash.
+template <size_t SectorSize, size_t SectorCount, size_t CachePages = 2>
+using SimFlashStorage = PageCachedStorage<SimFlashDevice<SectorSize, SectorCount>, CachePages>;
+
+} // namespace gridshield::platform::sim
@@ -0,0 +1,609 @@
+/**
+ * @file flash_storage.hpp
+ * @author zuudevs (zuudevs@gmail.com)
+ * @brief Sector-aware raw flash storage with a write-back page cache
+ * @version 1.0
+ * @date 2026-03-11
+ *
+ * Presents byte-addressable IPlatformStorage on top of a NOR flash device
+ * (erase = whole sector to 0xFF, program = clear bits only). Writes land in
+ * a small sector cache; a dirty sector is written back on eviction or
+ * flush(). On write-back the sector is only erased if some bit went 0 → 1,
+ * otherwise just the dirty byte range is programmed, so appends into erased
+ * space never pay for an erase. Devices reporting program_once() (NAND)
+ * always take the erase path.
+ *
+ * The erase path is copy-on-write: the new image is first programmed into a
+ * shadow sector and a sealed commit record names its target; only then is
+ * the target erased and rewritten, and the record retired. A power cut
+ * before the record is sealed keeps the old sector, a later one is rolled
+ * forward on the next access, so records sharing a sector (keys, config,
+ * warm-boot banks) never take each other down. The last two device sectors
+ * hold the shadow and the commit records and are not addressable.
+ *
+ * Device backends: Esp32PartitionDevice (esp32_platform.hpp) and
+ * MmapFlashDevice (mmap_flash.hpp, host).
+ *
+ * @copyright Copyright (c) 2026
+ */
+
+#pragma once
+
+#include "platform/platform.hpp"
+#include "utils/gs_macros.hpp"
+
+#include <cstddef>
+#include <cstring>
+#include <type_traits>
+#include <utility>
+
+namespace gridshield::platform {
+
+// ============================================================================
+// FLASH DEVICE CONTRACT
+// ============================================================================
+namespace detail {
+
+template <typename T, typename = void> struct is_flash_device : std::false_type
+{};
+
+template <typename T>
+struct is_flash_device<
+    T,
+    std::void_t<decltype(T::SECTOR_SIZE),
+                decltype(std::declval<const T&>().size_bytes()),
+                decltype(std::declval<T&>().read(uint32_t{}, std::declval<uint8_t*>(), size_t{})),
+                decltype(std::declval<T&>().program(
+                    uint32_t{}, std::declval<const uint8_t*>(), size_t{})),
+                decltype(std::declval<T&>().erase_sector(uint32_t{})),
+                decltype(std::declval<T&>().sync())>> : std::true_type
+{};
+
+/// Optional: devices that cannot re-program a page before erasing (NAND).
+template <typename T, typename = void> struct has_program_once : std::false_type
+{};
+
+template <typename T>
+struct has_program_once<T, std::void_t<decltype(std::declval<const T&>().program_once())>>
+    : std::true_type
+{};
+
+/// Bitwise CRC-32 (IEEE, reflected); only runs on the copy-on-write path.
+inline uint32_t flash_crc32(uint32_t crc, const uint8_t* data, size_t length) noexcept
+{
+    crc = ~crc;
+    for (size_t i = 0; i < length; ++i) {
+        crc ^= data[i];
+        for (int bit = 0; bit < 8; ++bit) {
+            crc = (crc >> 1) ^ (0xEDB88320U & (0U - (crc & 1U)));
+        }
+    }
+    return ~crc;
+}
+
+} // namespace detail
+
+template <typename T> inline constexpr bool is_flash_device_v = detail::is_flash_device<T>::value;
+
+struct FlashStorageStats
+{
+    uint32_t cache_hits{0};
+    uint32_t cache_misses{0}; // sector loads
+    uint32_t write_backs{0};
+    uint32_t sector_erases{0};   // including shadow and record sectors
+    uint32_t shadow_commits{0};  // erase-path write-backs (copy-on-write)
+    uint32_t roll_forwards{0};   // interrupted rewrites completed on mount
+    uint32_t program_ops{0};
+    uint32_t bytes_written{0};    // requested by callers
+    uint32_t bytes_programmed{0}; // actually sent to flash
+};
+
+// ============================================================================
+// PAGE-CACHED FLASH STORAGE
+// ============================================================================
+template <typename Device, size_t CachePages = 2>
+class PageCachedStorage final : public IPlatformStorage
+{
+    static_assert(is_flash_device_v<Device>, "Device does not satisfy the flash device contract");
+    static_assert(CachePages > 0, "need at least one cache page");
+
+public:
+    static constexpr size_t SECTOR_SIZE = Device::SECTOR_SIZE;
+    static constexpr uint8_t ERASED = 0xFF;
+    static constexpr size_t RESERVED_SECTORS = 2; // shadow image + commit records
+
+    explicit PageCachedStorage(Device& device) noexcept : device_(device) {}
+
+    ~PageCachedStorage() noexcept override
+    {
+        (void)flush();
+    }
+
+    PageCachedStorage(const PageCachedStorage&) = delete;
+    PageCachedStorage& operator=(const PageCachedStorage&) = delete;
+
+    core::Result<size_t> read(uint32_t address, uint8_t* buffer, size_t length) noexcept override
+    {
+        if (GS_UNLIKELY(buffer == nullptr || !in_range(address, length))) {
+            return core::Result<size_t>(GS_MAKE_ERROR(core::ErrorCode::InvalidParameter));
+        }
+        GS_TRY(mount());
+
+        size_t done = 0;
+        while (done < length) {
+            const uint32_t addr = address + static_cast<uint32_t>(done);
+            const uint32_t base = sector_base(addr);
+            const size_t offset = addr - base;
+            const size_t chunk = min_size(length - done, SECTOR_SIZE - offset);
+
+            Page* page = find(base);
+            if (page != nullptr) {
+                ++stats_.cache_hits;
+                std::memcpy(buffer + done, page->data + offset, chunk);
+            } else if (device_.read(addr, buffer + done, chunk).is_error()) {
+                return core::Result<size_t>(GS_MAKE_ERROR(core::ErrorCode::HardwareFailure));
+            }
+            done += chunk;
+        }
+        return core::Result<size_t>(length);
+    }
+
+    core::Result<size_t>
+    write(uint32_t address, const uint8_t* data, size_t length) noexcept override
+    {
+        if (GS_UNLIKELY(data == nullptr || !in_range(address, length))) {
+            return core::Result<size_t>(GS_MAKE_ERROR(core::ErrorCode::InvalidParameter));
+        }
+        GS_TRY(mount());
+
+        size_t done = 0;
+        while (done < length) {
+            const uint32_t addr = address + static_cast<uint32_t>(done);
+            const uint32_t base = sector_base(addr);
+            const size_t offset = addr - base;
+            const size_t chunk = min_size(length - done, SECTOR_SIZE - offset);
+
+            auto page_res = acquire(base);
+            if (page_res.is_error()) {
+                return core::Result<size_t>(page_res.error());
+            }
+            stage(*page_res.value(), offset, data + done, chunk);
+            done += chunk;
+        }
+        stats_.bytes_written += static_cast<uint32_t>(length);
+        return core::Result<size_t>(length);
+    }
+
+    /**
+     * @brief Reset a range to the erased state (0xFF).
+     *
+     * Whole sectors are erased on the device immediately; partial sectors
+     * go through the cache like a write.
+     */
+    core::Result<void> erase(uint32_t address, size_t length) noexcept override
+    {
+        if (GS_UNLIKELY(!in_range(address, length))) {
+            return GS_MAKE_ERROR(core::ErrorCode::InvalidParameter);
+        }
+        GS_TRY(mount());
+
+        size_t done = 0;
+        while (done < length) {
+            const uint32_t addr = address + static_cast<uint32_t>(done);
+            const uint32_t base = sector_base(addr);
+            const size_t offset = addr - base;
+            const size_t chunk = min_size(length - done, SECTOR_SIZE - offset);
+
+            if (chunk == SECTOR_SIZE) {
+                Page* page = find(base);
+                if (page != nullptr) {
+                    page->valid = false;
+                    page->dirty = false;
+                }
+                GS_TRY(erase_device_sector(base));
+            } else {
+                auto page_res = acquire(base);
+                if (page_res.is_error()) {
+                    return page_res.error();
+                }
+                Page& page = *page_res.value();
+                for (size_t i = 0; i < chunk; ++i) {
+                    if (page.data[offset + i] != ERASED) {
+                        page.data[offset + i] = ERASED;
+                        page.needs_erase = true;
+                    }
+                }
+                mark_dirty(page, offset, chunk);
+            }
+            done += chunk;
+        }
+        return core::Result<void>{};
+    }
+
+    /**
+     * @brief Write back every dirty sector and sync the device.
+     */
+    core::Result<void> flush() noexcept override
+    {
+        GS_TRY(mount());
+        for (auto& page : pages_) {
+            GS_TRY(write_back(page));
+        }
+        return device_.sync();
+    }
+
+    /// Addressable bytes: the device minus the reserved sectors.
+    GS_NODISCARD size_t capacity() const noexcept
+    {
+        const size_t size = device_.size_bytes();
+        const size_t reserved = RESERVED_SECTORS * SECTOR_SIZE;
+        return (size > reserved) ? size - reserved : 0;
+    }
+
+    GS_NODISCARD size_t dirty_pages() const noexcept
+    {
+        size_t count = 0;
+        for (const auto& page : pages_) {
+            count += (page.valid && page.dirty) ? 1U : 0U;
+        }
+        return count;
+    }
+
+    GS_NODISCARD const FlashStorageStats& stats() const noexcept
+    {
+        return stats_;
+    }
+
+    void reset_stats() noexcept
+    {
+        stats_ = FlashStorageStats{};
+    }
+
+private:
+    struct Page
+    {
+        uint32_t base{0};
+        uint32_t last_use{0};
+        uint16_t dirty_lo{0};
+        uint16_t dirty_hi{0}; // exclusive
+        bool valid{false};
+        bool dirty{false};
+        bool needs_erase{false}; // some byte went 0 → 1 since load
+        uint8_t data[SECTOR_SIZE];
+    };
+
+    /// Names the sector the shadow image belongs to; programmed in one go.
+    struct CommitRecord
+    {
+        uint32_t magic{0};
+        uint32_t target{0};
+        uint32_t image_crc{0}; // over target address + shadow image
+        uint32_t seal{0};      // over the fields above
+    };
+
+    static constexpr uint32_t COMMIT_MAGIC = 0x47534357; // "GSCW" (GridShield Copy-on-Write)
+    static constexpr size_t RECORD_SLOTS = SECTOR_SIZE / sizeof(CommitRecord);
+
+    static_assert(SECTOR_SIZE <= UINT16_MAX, "dirty range is tracked in 16 bits");
+    static_assert(sizeof(CommitRecord) == 16, "commit record is four words");
+
+    GS_NODISCARD bool in_range(uint32_t address, size_t length) const noexcept
+    {
+        const size_t usable = capacity();
+        return address <= usable && length <= usable - address;
+    }
+
+    GS_NODISCARD uint32_t shadow_base() const noexcept
+    {
+        return static_cast<uint32_t>(capacity());
+    }
+
+    GS_NODISCARD uint32_t record_base() const noexcept
+    {
+        return static_cast<uint32_t>(capacity() + SECTOR_SIZE);
+    }
+
+    static uint32_t sector_base(uint32_t address) noexcept
+    {
+        return address - (address % static_cast<uint32_t>(SECTOR_SIZE));
+    }
+
+    static size_t min_size(size_t a, size_t b) noexcept
+    {
+        return a < b ? a : b;
+    }
+
+    Page* find(uint32_t base) noexcept
+    {
+        for (auto& page : pages_) {
+            if (page.valid && page.base == base) {
+                page.last_use = ++clock_;
+                return &page;
+            }
+        }
+        return nullptr;
+    }
+
+    /// Cached page for @p base, loading it (and evicting the LRU page) if needed.
+    core::Result<Page*> acquire(uint32_t base) noexcept
+    {
+        Page* page = find(base);
+        if (page != nullptr) {
+            ++stats_.cache_hits;
+            return core::Result<Page*>(page);
+        }
+        ++stats_.cache_misses;
+
+        Page* victim = &pages_[0];
+        for (auto& candidate : pages_) {
+            if (!candidate.valid) {
+                victim = &candidate;
+                break;
+            }
+            if (candidate.last_use < victim->last_use) {
+                victim = &candidate;
+            }
+        }
+        auto wb = write_back(*victim);
+        if (wb.is_error()) {
+            return core::Result<Page*>(wb.error());
+        }
+
+        if (device_.read(base, victim->data, SECTOR_SIZE).is_error()) {
+            victim->valid = false;
+            return core::Result<Page*>(GS_MAKE_ERROR(core::ErrorCode::HardwareFailure));
+        }
+        victim->base = base;
+        victim->valid = true;
+        victim->dirty = false;
+        victim->needs_erase = false;
+        victim->last_use = ++clock_;
+        return core::Result<Page*>(victim);
+    }
+
+    void stage(Page& page, size_t offset, const uint8_t* data, size_t length) noexcept
+    {
+        for (size_t i = 0; i < length; ++i) {
+            const uint8_t current = page.data[offset + i];
+            const uint8_t next = data[i];
+            // NOR program can only clear bits; any 0 → 1 needs an erase
+            if ((current & next) != next) {
+                page.needs_erase = true;
+            }
+            page.data[offset + i] = next;
+        }
+        mark_dirty(page, offset, length);
+    }
+
+    static void mark_dirty(Page& page, size_t offset, size_t length) noexcept
+    {
+        const auto lo = static_cast<uint16_t>(offset);
+        const auto hi = static_cast<uint16_t>(offset + length);
+        if (!page.dirty) {
+            page.dirty_lo = lo;
+            page.dirty_hi = hi;
+            page.dirty = true;
+            return;
+        }
+        page.dirty_lo = (lo < page.dirty_lo) ? lo : page.dirty_lo;
+        page.dirty_hi = (hi > page.dirty_hi) ? hi : page.dirty_hi;
+    }
+
+    core::Result<void> write_back(Page& page) noexcept
+    {
+        if (!page.valid || !page.dirty) {
+            return core::Result<void>{};
+        }
+
+        if (page.needs_erase || program_once()) {
+            GS_TRY(replace_sector(page.base, page.data));
+        } else {
+            GS_TRY(program_range(page.base, page.data, page.dirty_lo, page.dirty_hi));
+        }
+
+        ++stats_.write_backs;
+        page.dirty = false;
+        page.needs_erase = false;
+        return core::Result<void>{};
+    }
+
+    core::Result<void>
+    program_range(uint32_t base, const uint8_t* image, size_t lo, size_t hi) noexcept
+    {
+        if (hi > lo) {
+            if (device_.program(base + static_cast<uint32_t>(lo), image + lo, hi - lo)
+                    .is_error()) {
+                return GS_MAKE_ERROR(core::ErrorCode::HardwareFailure);
+            }
+            ++stats_.program_ops;
+            stats_.bytes_programmed += static_cast<uint32_t>(hi - lo);
+        }
+        return core::Result<void>{};
+    }
+
+    /// Program a whole image into a freshly erased sector, skipping 0xFF ends.
+    core::Result<void> program_image(uint32_t base, const uint8_t* image) noexcept
+    {
+        size_t lo = 0;
+        size_t hi = SECTOR_SIZE;
+        while (lo < hi && image[lo] == ERASED) {
+            ++lo;
+        }
+        while (hi > lo && image[hi - 1] == ERASED) {
+            --hi;
+        }
+        return program_range(base, image, lo, hi);
+    }
+
+    core::Result<void> sync_device() noexcept
+    {
+        if (device_.sync().is_error()) {
+            return GS_MAKE_ERROR(core::ErrorCode::HardwareFailure);
+        }
+        return core::Result<void>{};
+    }
+
+    static uint32_t image_crc(uint32_t target, const uint8_t* image) noexcept
+    {
+        uint8_t address[4];
+        std::memcpy(address, &target, sizeof(address));
+        return detail::flash_crc32(
+            detail::flash_crc32(0, address, sizeof(address)), image, SECTOR_SIZE);
+    }
+
+    static uint32_t seal_of(const CommitRecord& record) noexcept
+    {
+        return detail::flash_crc32(
+            0, reinterpret_cast<const uint8_t*>(&record), offsetof(CommitRecord, seal));
+    }
+
+    /// Copy-on-write replacement of the sector at @p base with @p image.
+    core::Result<void> replace_sector(uint32_t base, const uint8_t* image) noexcept
+    {
+        // 1. Stage the image; a cut here leaves the target untouched
+        GS_TRY(erase_device_sector(shadow_base()));
+        GS_TRY(program_image(shadow_base(), image));
+        GS_TRY(sync_device());
+
+        // 2. Seal the commit: from here on a cut is rolled forward on mount
+        CommitRecord record;
+        record.magic = COMMIT_MAGIC;
+        record.target = base;
+        record.image_crc = image_crc(base, image);
+        record.seal = seal_of(record);
+        GS_TRY(append_record(record));
+
+        // 3. Rewrite the target in place, then retire the record
+        GS_TRY(erase_device_sector(base));
+        GS_TRY(program_image(base, image));
+        GS_TRY(sync_device());
+        ++stats_.shadow_commits;
+        return retire_record();
+    }
+
+    core::Result<void> append_record(const CommitRecord& record) noexcept
+    {
+        if (next_slot_ >= RECORD_SLOTS) {
+            // Every record before this one has been retired
+            GS_TRY(erase_device_sector(record_base()));
+            next_slot_ = 0;
+        }
+        const auto address = record_base() + static_cast<uint32_t>(next_slot_ * sizeof(record));
+        if (device_.program(address, reinterpret_cast<const uint8_t*>(&record), sizeof(record))
+                .is_error()) {
+            return GS_MAKE_ERROR(core::ErrorCode::HardwareFailure);
+        }
+        live_slot_ = next_slot_++;
+        return sync_device();
+    }
+
+    /// Invalidate the live record: clear its magic (NOR) or erase the sector (NAND).
+    core::Result<void> retire_record() noexcept
+    {
+        if (program_once()) {
+            GS_TRY(erase_device_sector(record_base()));
+            next_slot_ = 0;
+            return core::Result<void>{};
+        }
+        static constexpr uint8_t RETIRED[4] = {0, 0, 0, 0};
+        const auto address =
+            record_base() + static_cast<uint32_t>(live_slot_ * sizeof(CommitRecord));
+        if (device_.program(address, RETIRED, sizeof(RETIRED)).is_error()) {
+            return GS_MAKE_ERROR(core::ErrorCode::HardwareFailure);
+        }
+        return sync_device();
+    }
+
+    /**
+     * @brief Find the record log's end and finish an interrupted rewrite.
+     *
+     * Runs once, before the first access. A sealed record whose shadow still
+     * matches its CRC is replayed onto the target; replaying is idempotent,
+     * so a cut during recovery just repeats it on the next mount.
+     */
+    core::Result<void> mount() noexcept
+    {
+        if (GS_LIKELY(mounted_)) {
+            return core::Result<void>{};
+        }
+        if (GS_UNLIKELY(capacity() == 0)) {
+            return GS_MAKE_ERROR(core::ErrorCode::InvalidParameter);
+        }
+
+        bool live = false;
+        CommitRecord pending;
+        next_slot_ = 0;
+        for (size_t slot = 0; slot < RECORD_SLOTS; ++slot) {
+            CommitRecord record;
+            const auto address = record_base() + static_cast<uint32_t>(slot * sizeof(record));
+            if (device_.read(address, reinterpret_cast<uint8_t*>(&record), sizeof(record))
+                    .is_error()) {
+                return GS_MAKE_ERROR(core::ErrorCode::HardwareFailure);
+            }
+            const auto* bytes = reinterpret_cast<const uint8_t*>(&record);
+            bool blank = true;
+            for (size_t i = 0; i < sizeof(record); ++i) {
+                blank = blank && bytes[i] == ERASED;
+            }
+            if (!blank) {
+                next_slot_ = slot + 1; // torn records still occupy their slot
+            }
+            if (record.magic == COMMIT_MAGIC && record.seal == seal_of(record) &&
+                record.target < shadow_base() && record.target % SECTOR_SIZE == 0) {
+                live = true;
+                pending = record;
+                live_slot_ = slot;
+            }
+        }
+
+        if (live) {
+            // Nothing is cached before the first mount: borrow a page buffer
+            uint8_t* image = pages_[0].data;
+            pages_[0].valid = false;
+            if (device_.read(shadow_base(), image, SECTOR_SIZE).is_error()) {
+                return GS_MAKE_ERROR(core::ErrorCode::HardwareFailure);
+            }
+            if (image_crc(pending.target, image) == pending.image_crc) {
+                GS_TRY(erase_device_sector(pending.target));
+                GS_TRY(program_image(pending.target, image));
+                GS_TRY(sync_device());
+                ++stats_.roll_forwards;
+            }
+            GS_TRY(retire_record());
+        } else if (program_once() && next_slot_ != 0) {
+            // Torn record on program-once media: the page cannot be reused
+            GS_TRY(erase_device_sector(record_base()));
+            next_slot_ = 0;
+        }
+        mounted_ = true;
+        return core::Result<void>{};
+    }
+
+    GS_NODISCARD bool program_once() const noexcept
+    {
+        if constexpr (detail::has_program_once<Device>::value) {
+            return device_.program_once();
+        } else {
+            return false;
+        }
+    }
+
+    core::Result<void> erase_device_sector(uint32_t base) noexcept
+    {
+        if (device_.erase_sector(base).is_error()) {
+            return GS_MAKE_ERROR(core::ErrorCode::HardwareFailure);
+        }
+        ++stats_.sector_erases;
+        return core::Result<void>{};
+    }
+
+    Device& device_;
+    Page pages_[CachePages]{};
+    uint32_t clock_{0};
+    size_t next_slot_{0}; // first free commit-record slot
+    size_t live_slot_{0};
+    bool mounted_{false};
+    FlashStorageStats stats_{};
+};
+
+} // namespace gridshield::platform
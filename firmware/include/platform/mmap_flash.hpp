@@ -0,0 +1,166 @@
+/**
+ * @file mmap_flash.hpp
+ * @author zuudevs (zuudevs@gmail.com)
+ * @brief Host flash device backed by an mmap'd file
+ * @version 1.0
+ * @date 2026-03-11
+ *
+ * Host-side stand-in for Esp32PartitionDevice: the same NOR semantics
+ * (erase → 0xFF per sector, program ANDs bits) over a file image, so
+ * PageCachedStorage behaves identically on the host and survives process
+ * restarts like a real partition survives reboots.
+ *
+ * @copyright Copyright (c) 2026
+ */
+
+#pragma once
+
+#include "platform/flash_storage.hpp"
+#include "utils/gs_macros.hpp"
+
+#if GS_PLATFORM_NATIVE
+
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace gridshield::platform::native {
+
+class MmapFlashDevice
+{
+public:
+    static constexpr size_t SECTOR_SIZE = 4096;
+
+    MmapFlashDevice() noexcept = default;
+    ~MmapFlashDevice() noexcept
+    {
+        close();
+    }
+
+    MmapFlashDevice(const MmapFlashDevice&) = delete;
+    MmapFlashDevice& operator=(const MmapFlashDevice&) = delete;
+
+    /**
+     * @brief Map @p path as a flash image of @p size bytes.
+     *
+     * A new (or shorter) file is extended with erased (0xFF) sectors; an
+     * existing image keeps its content.
+     */
+    core::Result<void> open(const char* path, size_t size) noexcept
+    {
+        if (GS_UNLIKELY(path == nullptr || size == 0 || size % SECTOR_SIZE != 0)) {
+            return GS_MAKE_ERROR(core::ErrorCode::InvalidParameter);
+        }
+        close();
+
+        fd_ = ::open(path, O_RDWR | O_CREAT, 0644);
+        if (fd_ < 0) {
+            return GS_MAKE_ERROR(core::ErrorCode::HardwareFailure);
+        }
+
+        struct stat st
+        {};
+        if (::fstat(fd_, &st) != 0) {
+            close();
+            return GS_MAKE_ERROR(core::ErrorCode::HardwareFailure);
+        }
+        const auto existing = static_cast<size_t>(st.st_size);
+        if (existing < size && ::ftruncate(fd_, static_cast<off_t>(size)) != 0) {
+            close();
+            return GS_MAKE_ERROR(core::ErrorCode::HardwareFailure);
+        }
+
+        void* map = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd_, 0);
+        if (map == MAP_FAILED) {
+            close();
+            return GS_MAKE_ERROR(core::ErrorCode::HardwareFailure);
+        }
+        base_ = static_cast<uint8_t*>(map);
+        size_ = size;
+        if (existing < size) {
+            std::memset(base_ + existing, 0xFF, size - existing);
+        }
+        return core::Result<void>{};
+    }
+
+    void close() noexcept
+    {
+        if (base_ != nullptr) {
+            ::msync(base_, size_, MS_SYNC);
+            ::munmap(base_, size_);
+            base_ = nullptr;
+            size_ = 0;
+        }
+        if (fd_ >= 0) {
+            ::close(fd_);
+            fd_ = -1;
+        }
+    }
+
+    GS_NODISCARD bool is_open() const noexcept
+    {
+        return base_ != nullptr;
+    }
+
+    GS_NODISCARD size_t size_bytes() const noexcept
+    {
+        return size_;
+    }
+
+    core::Result<void> read(uint32_t offset, uint8_t* buffer, size_t length) noexcept
+    {
+        if (GS_UNLIKELY(!in_range(offset, length))) {
+            return GS_MAKE_ERROR(core::ErrorCode::InvalidParameter);
+        }
+        std::memcpy(buffer, base_ + offset, length);
+        return core::Result<void>{};
+    }
+
+    /// NOR program: bits can only be cleared.
+    core::Result<void> program(uint32_t offset, const uint8_t* data, size_t length) noexcept
+    {
+        if (GS_UNLIKELY(!in_range(offset, length))) {
+            return GS_MAKE_ERROR(core::ErrorCode::InvalidParameter);
+        }
+        uint8_t* dst = base_ + offset;
+        for (size_t i = 0; i < length; ++i) {
+            dst[i] &= data[i];
+        }
+        return core::Result<void>{};
+    }
+
+    core::Result<void> erase_sector(uint32_t offset) noexcept
+    {
+        if (GS_UNLIKELY(offset % SECTOR_SIZE != 0 || !in_range(offset, SECTOR_SIZE))) {
+            return GS_MAKE_ERROR(core::ErrorCode::InvalidParameter);
+        }
+        std::memset(base_ + offset, 0xFF, SECTOR_SIZE);
+        return core::Result<void>{};
+    }
+
+    core::Result<void> sync() noexcept
+    {
+        if (base_ != nullptr && ::msync(base_, size_, MS_SYNC) != 0) {
+            return GS_MAKE_ERROR(core::ErrorCode::HardwareFailure);
+        }
+        return core::Result<void>{};
+    }
+
+private:
+    GS_NODISCARD bool in_range(uint32_t offset, size_t length) const noexcept
+    {
+        return base_ != nullptr && offset <= size_ && length <= size_ - offset;
+    }
+
+    int fd_{-1};
+    uint8_t* base_{nullptr};
+    size_t size_{0};
+};
+
+using MmapFlashStorage = PageCachedStorage<MmapFlashDevice>;
+
+} // namespace gridshield::platform::native
+
+#endif // GS_PLATFORM_NATIVE
@@ -53,6 +53,17 @@ public:
 #endif
     }
 
+    uint64_t get_timestamp_us() noexcept override
+    {
+#if GS_PLATFORM_NATIVE || defined(GS_QEMU_BUILD)
+        auto now = std::chrono::steady_clock::now();
+        auto duration = std::chrono::duration_cast<std::chrono::microseconds>(now - start_time_);
+        return static_cast<uint64_t>(duration.count());
+#else
+        return static_cast<uint64_t>(micros());
+#endif
+    }
+
     void delay_ms(uint32_t milliseconds) noexcept override
     {
 #if GS_PLATFORM_NATIVE || defined(GS_QEMU_BUILD)
@@ -300,7 +311,7 @@ public:
         size_t received = 0;
         while (received < max_length && !rx_buffer_.empty()) {
             uint8_t byte;
-            if (rx_buffer_.pop(byte)) {
+            if (rx_buffer_.pop_front(byte)) { // FIFO, like the wire
                 buffer[received++] = byte;
             }
         }
@@ -351,7 +362,7 @@ private:
 class MockStorage : public IPlatformStorage
 {
 public:
-    static constexpr size_t STORAGE_SIZE = 4096;
+    static constexpr size_t STORAGE_SIZE = 8192;
 
     MockStorage() noexcept
     {
@@ -451,15 +462,71 @@ public:
         return core::Result<void>{};
     }
 
+    core::Result<void> connect_with_hint(const char* ssid,
+                                         const char* password,
+                                         const WiFiConnectHint& hint) noexcept override
+    {
+        last_hint_ = hint;
+        return connect(ssid, password);
+    }
+
+    core::Result<WiFiLinkInfo> get_link_info() noexcept override
+    {
+        if (GS_UNLIKELY(!connected_)) {
+            return core::Result<WiFiLinkInfo>(GS_MAKE_ERROR(core::ErrorCode::WiFiNotConnected));
+        }
+        WiFiLinkInfo info;
+        info.bssid = {{0x02, 0x00, 0x00, 0x00, 0x00, 0x01}};
+        info.channel = last_hint_.channel != 0 ? last_hint_.channel : 6;
+        info.ip = last_hint_.static_ip.is_set() ? last_hint_.static_ip : mock_lease();
+        info.lease_s = last_hint_.static_ip.is_set() ? 0 : 86400;
+        return core::Result<WiFiLinkInfo>(info);
+    }
+
+    core::Result<void> set_power_save(WiFiPowerSave mode, uint8_t listen_interval) noexcept override
+    {
+        power_save_ = mode;
+        listen_interval_ = listen_interval;
+        return core::Result<void>{};
+    }
+
     // Test helpers
     void set_connected(bool state)
     {
         connected_ = state;
     }
 
+    const WiFiConnectHint& last_hint() const
+    {
+        return last_hint_;
+    }
+
+    WiFiPowerSave power_save() const
+    {
+        return power_save_;
+    }
+
+    uint8_t listen_interval() const
+    {
+        return listen_interval_;
+    }
+
 private:
+    static WiFiIpConfig mock_lease()
+    {
+        WiFiIpConfig ip;
+        ip.address = 0xC0A80164; // 192.168.1.100
+        ip.gateway = 0xC0A80101;
+        ip.netmask = 0xFFFFFF00;
+        ip.dns = 0xC0A80101;
+        return ip;
+    }
+
     bool initialized_{false};
     bool connected_{false};
+    WiFiConnectHint last_hint_{};
+    WiFiPowerSave power_save_{WiFiPowerSave::None};
+    uint8_t listen_interval_{0};
 };
 
 // ============================================================================
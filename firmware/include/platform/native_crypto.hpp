@@ -0,0 +1,1044 @@
+/**
+ * @file native_crypto.hpp
+ * @author zuudevs (zuudevs@gmail.com)
+ * @brief Host (x86-64 / portable) crypto backend for native builds
+ * @version 1.0
+ * @date 2026-03-02
+ *
+ * Real SHA-256, HMAC-SHA256, AES-256-GCM and CRC32 for tests, the coverage
+ * runner, gateways and simulators. Output is bit-identical to the ESP32
+ * path (mbedTLS SHA-256, esp_crc32_le, mbedTLS GCM).
+ *
+ * Dispatch is resolved once per process from CPUID:
+ *   - SHA-256 : SHA-NI            -> portable C++
+ *   - AES     : AES-NI            -> portable C++ (S-box)
+ *   - GHASH   : PCLMULQDQ         -> portable C++ (bitwise GF(2^128))
+ *
+ * @note Header-only, zero heap allocation. Native builds only.
+ * @copyright Copyright (c) 2026
+ */
+
+#pragma once
+
+#include "platform/platform.hpp"
+#include "security/hw_crypto.hpp"
+#include "utils/gs_macros.hpp"
+
+#if GS_PLATFORM_NATIVE
+
+#include <array>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+
+#if defined(__linux__)
+#include <sys/random.h>
+#endif
+
+#if (defined(__x86_64__) || defined(__i386__)) && (GS_COMPILER_GCC || GS_COMPILER_CLANG)
+#define GS_NATIVE_CRYPTO_X86 1
+#include <cpuid.h>
+#include <immintrin.h>
+#else
+#define GS_NATIVE_CRYPTO_X86 0
+#endif
+
+namespace gridshield::platform::native {
+
+// ============================================================================
+// Constants
+// ============================================================================
+static constexpr size_t NC_SHA256_BLOCK_SIZE = 64;
+static constexpr size_t NC_SHA256_DIGEST_SIZE = 32;
+static constexpr size_t NC_SHA256_STATE_WORDS = 8;
+static constexpr size_t NC_AES_BLOCK_SIZE = 16;
+static constexpr size_t NC_AES256_ROUNDS = 14;
+static constexpr size_t NC_AES256_KEY_WORDS = 8;
+static constexpr size_t NC_AES256_SCHEDULE_WORDS = 4 * (NC_AES256_ROUNDS + 1);
+static constexpr size_t NC_GCM_PARALLEL_BLOCKS = 4;
+static constexpr uint32_t NC_CRC32_POLY_REFLECTED = 0xEDB88320U;
+
+// ============================================================================
+// CPU feature detection
+// ============================================================================
+struct CpuFeatures
+{
+    bool sha_ni{false};
+    bool aes_ni{false};
+    bool pclmul{false};
+
+    static CpuFeatures detect() noexcept
+    {
+        CpuFeatures features{};
+#if GS_NATIVE_CRYPTO_X86
+        unsigned int eax = 0;
+        unsigned int ebx = 0;
+        unsigned int ecx = 0;
+        unsigned int edx = 0;
+        if (__get_cpuid(1, &eax, &ebx, &ecx, &edx) == 0) {
+            return features;
+        }
+        const bool ssse3 = (ecx & bit_SSSE3) != 0;
+        const bool sse41 = (ecx & bit_SSE4_1) != 0;
+        features.aes_ni = ssse3 && (ecx & bit_AES) != 0;
+        features.pclmul = ssse3 && (ecx & bit_PCLMUL) != 0;
+
+        if (__get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx) != 0) {
+            features.sha_ni = sse41 && (ebx & bit_SHA) != 0;
+        }
+#endif
+        return features;
+    }
+
+    /// Process-wide, detected on first use.
+    static const CpuFeatures& host() noexcept
+    {
+        static const CpuFeatures features = detect();
+        return features;
+    }
+};
+
+namespace detail {
+
+// ============================================================================
+// Byte order helpers
+// ============================================================================
+GS_INLINE uint32_t load_be32(const uint8_t* src) noexcept
+{
+    return (static_cast<uint32_t>(src[0]) << 24) | (static_cast<uint32_t>(src[1]) << 16) |
+           (static_cast<uint32_t>(src[2]) << 8) | static_cast<uint32_t>(src[3]);
+}
+
+GS_INLINE void store_be32(uint8_t* dst, uint32_t val) noexcept
+{
+    dst[0] = static_cast<uint8_t>(val >> 24);
+    dst[1] = static_cast<uint8_t>(val >> 16);
+    dst[2] = static_cast<uint8_t>(val >> 8);
+    dst[3] = static_cast<uint8_t>(val);
+}
+
+GS_INLINE uint64_t load_be64(const uint8_t* src) noexcept
+{
+    return (static_cast<uint64_t>(load_be32(src)) << 32) | load_be32(src + 4);
+}
+
+GS_INLINE void store_be64(uint8_t* dst, uint64_t val) noexcept
+{
+    store_be32(dst, static_cast<uint32_t>(val >> 32));
+    store_be32(dst + 4, static_cast<uint32_t>(val));
+}
+
+GS_INLINE uint32_t rotr32(uint32_t val, unsigned shift) noexcept
+{
+    return (val >> shift) | (val << (32U - shift));
+}
+
+// ============================================================================
+// SHA-256 (FIPS 180-4)
+// ============================================================================
+alignas(16) static constexpr uint32_t SHA256_K[64] = {
+    0x428A2F98, 0x71374491, 0xB5C0FBCF, 0xE9B5DBA5, 0x3956C25B, 0x59F111F1, 0x923F82A4,
+    0xAB1C5ED5, 0xD807AA98, 0x12835B01, 0x243185BE, 0x550C7DC3, 0x72BE5D74, 0x80DEB1FE,
+    0x9BDC06A7, 0xC19BF174, 0xE49B69C1, 0xEFBE4786, 0x0FC19DC6, 0x240CA1CC, 0x2DE92C6F,
+    0x4A7484AA, 0x5CB0A9DC, 0x76F988DA, 0x983E5152, 0xA831C66D, 0xB00327C8, 0xBF597FC7,
+    0xC6E00BF3, 0xD5A79147, 0x06CA6351, 0x14292967, 0x27B70A85, 0x2E1B2138, 0x4D2C6DFC,
+    0x53380D13, 0x650A7354, 0x766A0ABB, 0x81C2C92E, 0x92722C85, 0xA2BFE8A1, 0xA81A664B,
+    0xC24B8B70, 0xC76C51A3, 0xD192E819, 0xD6990624, 0xF40E3585, 0x106AA070, 0x19A4C116,
+    0x1E376C08, 0x2748774C, 0x34B0BCB5, 0x391C0CB3, 0x4ED8AA4A, 0x5B9CCA4F, 0x682E6FF3,
+    0x748F82EE, 0x78A5636F, 0x84C87814, 0x8CC70208, 0x90BEFFFA, 0xA4506CEB, 0xBEF9A3F7,
+    0xC67178F2};
+
+static constexpr uint32_t SHA256_IV[NC_SHA256_STATE_WORDS] = {
+    0x6A09E667, 0xBB67AE85, 0x3C6EF372, 0xA54FF53A, 0x510E527F, 0x9B05688C, 0x1F83D9AB, 0x5BE0CD19};
+
+inline void sha256_blocks_portable(uint32_t* state, const uint8_t* data, size_t blocks) noexcept
+{
+    std::array<uint32_t, 64> sched{};
+    for (size_t blk = 0; blk < blocks; ++blk, data += NC_SHA256_BLOCK_SIZE) {
+        for (size_t idx = 0; idx < 16; ++idx) {
+            sched[idx] = load_be32(data + (idx * 4));
+        }
+        for (size_t idx = 16; idx < 64; ++idx) {
+            const uint32_t s0 = rotr32(sched[idx - 15], 7) ^ rotr32(sched[idx - 15], 18) ^
+                                (sched[idx - 15] >> 3);
+            const uint32_t s1 = rotr32(sched[idx - 2], 17) ^ rotr32(sched[idx - 2], 19) ^
+                                (sched[idx - 2] >> 10);
+            sched[idx] = sched[idx - 16] + s0 + sched[idx - 7] + s1;
+        }
+
+        uint32_t a = state[0];
+        uint32_t b = state[1];
+        uint32_t c = state[2];
+        uint32_t d = state[3];
+        uint32_t e = state[4];
+        uint32_t f = state[5];
+        uint32_t g = state[6];
+        uint32_t h = state[7];
+
+        for (size_t idx = 0; idx < 64; ++idx) {
+            const uint32_t big_s1 = rotr32(e, 6) ^ rotr32(e, 11) ^ rotr32(e, 25);
+            const uint32_t choose = (e & f) ^ (~e & g);
+            const uint32_t temp1 = h + big_s1 + choose + SHA256_K[idx] + sched[idx];
+            const uint32_t big_s0 = rotr32(a, 2) ^ rotr32(a, 13) ^ rotr32(a, 22);
+            const uint32_t majority = (a & b) ^ (a & c) ^ (b & c);
+            const uint32_t temp2 = big_s0 + majority;
+            h = g;
+            g = f;
+            f = e;
+            e = d + temp1;
+            d = c;
+            c = b;
+            b = a;
+            a = temp1 + temp2;
+        }
+
+        state[0] += a;
+        state[1] += b;
+        state[2] += c;
+        state[3] += d;
+        state[4] += e;
+        state[5] += f;
+        state[6] += g;
+        state[7] += h;
+    }
+}
+
+#if GS_NATIVE_CRYPTO_X86
+__attribute__((target("sha,sse4.1"))) inline void
+sha256_blocks_shani(uint32_t* state, const uint8_t* data, size_t blocks) noexcept
+{
+    const __m128i byte_swap = _mm_set_epi64x(0x0C0D0E0F08090A0BULL, 0x0405060700010203ULL);
+
+    // Repack {A..H} into the ABEF / CDGH lanes expected by SHA256RNDS2
+    __m128i tmp = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&state[0]));
+    __m128i state1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&state[4]));
+    tmp = _mm_shuffle_epi32(tmp, 0xB1);
+    state1 = _mm_shuffle_epi32(state1, 0x1B);
+    __m128i state0 = _mm_alignr_epi8(tmp, state1, 8);
+    state1 = _mm_blend_epi16(state1, tmp, 0xF0);
+
+    for (size_t blk = 0; blk < blocks; ++blk, data += NC_SHA256_BLOCK_SIZE) {
+        const __m128i abef_save = state0;
+        const __m128i cdgh_save = state1;
+        __m128i msg[4];
+        for (size_t idx = 0; idx < 4; ++idx) {
+            msg[idx] = _mm_shuffle_epi8(
+                _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + (idx * 16))), byte_swap);
+        }
+
+        // 16 groups of 4 rounds; W[t..t+3] for t >= 16 is scheduled in place
+        for (size_t grp = 0; grp < 16; ++grp) {
+            if (grp >= 4) {
+                __m128i next = _mm_sha256msg1_epu32(msg[grp & 3], msg[(grp + 1) & 3]);
+                next = _mm_add_epi32(next, _mm_alignr_epi8(msg[(grp + 3) & 3], msg[(grp + 2) & 3], 4));
+                msg[grp & 3] = _mm_sha256msg2_epu32(next, msg[(grp + 3) & 3]);
+            }
+            __m128i wk = _mm_add_epi32(
+                msg[grp & 3], _mm_load_si128(reinterpret_cast<const __m128i*>(&SHA256_K[grp * 4])));
+            state1 = _mm_sha256rnds2_epu32(state1, state0, wk);
+            wk = _mm_shuffle_epi32(wk, 0x0E);
+            state0 = _mm_sha256rnds2_epu32(state0, state1, wk);
+        }
+
+        state0 = _mm_add_epi32(state0, abef_save);
+        state1 = _mm_add_epi32(state1, cdgh_save);
+    }
+
+    tmp = _mm_shuffle_epi32(state0, 0x1B);
+    state1 = _mm_shuffle_epi32(state1, 0xB1);
+    state0 = _mm_blend_epi16(tmp, state1, 0xF0);
+    state1 = _mm_alignr_epi8(state1, tmp, 8);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(&state[0]), state0);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(&state[4]), state1);
+}
+#endif
+
+// ============================================================================
+// AES-256 forward cipher (FIPS 197) — only encryption is needed for GCM
+// ============================================================================
+static constexpr uint8_t AES_SBOX[256] = {
+    0x63, 0x7C, 0x77, 0x7B, 0xF2, 0x6B, 0x6F, 0xC5, 0x30, 0x01, 0x67, 0x2B, 0xFE, 0xD7, 0xAB, 0x76,
+    0xCA, 0x82, 0xC9, 0x7D, 0xFA, 0x59, 0x47, 0xF0, 0xAD, 0xD4, 0xA2, 0xAF, 0x9C, 0xA4, 0x72, 0xC0,
+    0xB7, 0xFD, 0x93, 0x26, 0x36, 0x3F, 0xF7, 0xCC, 0x34, 0xA5, 0xE5, 0xF1, 0x71, 0xD8, 0x31, 0x15,
+    0x04, 0xC7, 0x23, 0xC3, 0x18, 0x96, 0x05, 0x9A, 0x07, 0x12, 0x80, 0xE2, 0xEB, 0x27, 0xB2, 0x75,
+    0x09, 0x83, 0x2C, 0x1A, 0x1B, 0x6E, 0x5A, 0xA0, 0x52, 0x3B, 0xD6, 0xB3, 0x29, 0xE3, 0x2F, 0x84,
+    0x53, 0xD1, 0x00, 0xED, 0x20, 0xFC, 0xB1, 0x5B, 0x6A, 0xCB, 0xBE, 0x39, 0x4A, 0x4C, 0x58, 0xCF,
+    0xD0, 0xEF, 0xAA, 0xFB, 0x43, 0x4D, 0x33, 0x85, 0x45, 0xF9, 0x02, 0x7F, 0x50, 0x3C, 0x9F, 0xA8,
+    0x51, 0xA3, 0x40, 0x8F, 0x92, 0x9D, 0x38, 0xF5, 0xBC, 0xB6, 0xDA, 0x21, 0x10, 0xFF, 0xF3, 0xD2,
+    0xCD, 0x0C, 0x13, 0xEC, 0x5F, 0x97, 0x44, 0x17, 0xC4, 0xA7, 0x7E, 0x3D, 0x64, 0x5D, 0x19, 0x73,
+    0x60, 0x81, 0x4F, 0xDC, 0x22, 0x2A, 0x90, 0x88, 0x46, 0xEE, 0xB8, 0x14, 0xDE, 0x5E, 0x0B, 0xDB,
+    0xE0, 0x32, 0x3A, 0x0A, 0x49, 0x06, 0x24, 0x5C, 0xC2, 0xD3, 0xAC, 0x62, 0x91, 0x95, 0xE4, 0x79,
+    0xE7, 0xC8, 0x37, 0x6D, 0x8D, 0xD5, 0x4E, 0xA9, 0x6C, 0x56, 0xF4, 0xEA, 0x65, 0x7A, 0xAE, 0x08,
+    0xBA, 0x78, 0x25, 0x2E, 0x1C, 0xA6, 0xB4, 0xC6, 0xE8, 0xDD, 0x74, 0x1F, 0x4B, 0xBD, 0x8B, 0x8A,
+    0x70, 0x3E, 0xB5, 0x66, 0x48, 0x03, 0xF6, 0x0E, 0x61, 0x35, 0x57, 0xB9, 0x86, 0xC1, 0x1D, 0x9E,
+    0xE1, 0xF8, 0x98, 0x11, 0x69, 0xD9, 0x8E, 0x94, 0x9B, 0x1E, 0x87, 0xE9, 0xCE, 0x55, 0x28, 0xDF,
+    0x8C, 0xA1, 0x89, 0x0D, 0xBF, 0xE6, 0x42, 0x68, 0x41, 0x99, 0x2D, 0x0F, 0xB0, 0x54, 0xBB, 0x16};
+
+static constexpr uint8_t AES_RCON[7] = {0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40};
+
+/// Expanded AES-256 key, stored as round-key bytes so both paths share it.
+struct Aes256Schedule
+{
+    alignas(16) std::array<uint8_t, NC_AES256_SCHEDULE_WORDS * 4> bytes{};
+
+    void expand(const uint8_t* key) noexcept
+    {
+        std::array<uint32_t, NC_AES256_SCHEDULE_WORDS> words{};
+        for (size_t idx = 0; idx < NC_AES256_KEY_WORDS; ++idx) {
+            words[idx] = load_be32(key + (idx * 4));
+        }
+        for (size_t idx = NC_AES256_KEY_WORDS; idx < NC_AES256_SCHEDULE_WORDS; ++idx) {
+            uint32_t temp = words[idx - 1];
+            if (idx % NC_AES256_KEY_WORDS == 0) {
+                temp = (temp << 8) | (temp >> 24);
+                temp = sub_word(temp) ^
+                       (static_cast<uint32_t>(AES_RCON[(idx / NC_AES256_KEY_WORDS) - 1]) << 24);
+            } else if (idx % NC_AES256_KEY_WORDS == 4) {
+                temp = sub_word(temp);
+            }
+            words[idx] = words[idx - NC_AES256_KEY_WORDS] ^ temp;
+        }
+        for (size_t idx = 0; idx < NC_AES256_SCHEDULE_WORDS; ++idx) {
+            store_be32(&bytes[idx * 4], words[idx]);
+        }
+        // Key material is wiped by the owner via wipe()
+        std::memset(words.data(), 0, sizeof(words));
+    }
+
+    void wipe() noexcept
+    {
+        volatile uint8_t* ptr = bytes.data();
+        for (size_t idx = 0; idx < bytes.size(); ++idx) {
+            ptr[idx] = 0;
+        }
+    }
+
+private:
+    static uint32_t sub_word(uint32_t word) noexcept
+    {
+        return (static_cast<uint32_t>(AES_SBOX[(word >> 24) & 0xFF]) << 24) |
+               (static_cast<uint32_t>(AES_SBOX[(word >> 16) & 0xFF]) << 16) |
+               (static_cast<uint32_t>(AES_SBOX[(word >> 8) & 0xFF]) << 8) |
+               static_cast<uint32_t>(AES_SBOX[word & 0xFF]);
+    }
+};
+
+GS_INLINE uint8_t xtime(uint8_t val) noexcept
+{
+    return static_cast<uint8_t>((val << 1) ^ ((val & 0x80U) != 0 ? 0x1BU : 0x00U));
+}
+
+inline void aes256_encrypt_block_portable(const Aes256Schedule& ks,
+                                          const uint8_t* in,
+                                          uint8_t* out) noexcept
+{
+    uint8_t st[NC_AES_BLOCK_SIZE];
+    for (size_t idx = 0; idx < NC_AES_BLOCK_SIZE; ++idx) {
+        st[idx] = in[idx] ^ ks.bytes[idx];
+    }
+
+    for (size_t round = 1; round <= NC_AES256_ROUNDS; ++round) {
+        // SubBytes + ShiftRows (column-major state, row r rotates left by r)
+        uint8_t tmp[NC_AES_BLOCK_SIZE];
+        for (size_t col = 0; col < 4; ++col) {
+            for (size_t row = 0; row < 4; ++row) {
+                tmp[(col * 4) + row] = AES_SBOX[st[(((col + row) & 3) * 4) + row]];
+            }
+        }
+        // MixColumns (skipped in the final round)
+        if (round != NC_AES256_ROUNDS) {
+            for (size_t col = 0; col < 4; ++col) {
+                uint8_t* column = &tmp[col * 4];
+                const uint8_t all = column[0] ^ column[1] ^ column[2] ^ column[3];
+                const uint8_t first = column[0];
+                column[0] ^= all ^ xtime(column[0] ^ column[1]);
+                column[1] ^= all ^ xtime(column[1] ^ column[2]);
+                column[2] ^= all ^ xtime(column[2] ^ column[3]);
+                column[3] ^= all ^ xtime(column[3] ^ first);
+            }
+        }
+        const uint8_t* round_key = &ks.bytes[round * NC_AES_BLOCK_SIZE];
+        for (size_t idx = 0; idx < NC_AES_BLOCK_SIZE; ++idx) {
+            st[idx] = tmp[idx] ^ round_key[idx];
+        }
+    }
+    std::memcpy(out, st, NC_AES_BLOCK_SIZE);
+}
+
+// ============================================================================
+// GCM (NIST SP 800-38D) — portable path
+// ============================================================================
+
+/// 128-bit field element, big-endian halves (hi holds bytes 0..7).
+struct Gf128
+{
+    uint64_t hi{0};
+    uint64_t lo{0};
+
+    static Gf128 load(const uint8_t* src) noexcept
+    {
+        return Gf128{load_be64(src), load_be64(src + 8)};
+    }
+
+    void store(uint8_t* dst) const noexcept
+    {
+        store_be64(dst, hi);
+        store_be64(dst + 8, lo);
+    }
+};
+
+/// Bitwise GF(2^128) multiply (SP 800-38D Algorithm 1). Constant-time.
+inline Gf128 gf128_mul_portable(Gf128 lhs, Gf128 rhs) noexcept
+{
+    static constexpr uint64_t GCM_R = 0xE100000000000000ULL;
+    Gf128 acc{};
+    Gf128 val = rhs;
+    for (size_t bit = 0; bit < 128; ++bit) {
+        const uint64_t word = (bit < 64) ? lhs.hi : lhs.lo;
+        const uint64_t mask = 0U - ((word >> (63U - (bit & 63U))) & 1U);
+        acc.hi ^= val.hi & mask;
+        acc.lo ^= val.lo & mask;
+        const uint64_t carry = 0U - (val.lo & 1U);
+        val.lo = (val.lo >> 1) | (val.hi << 63);
+        val.hi = (val.hi >> 1) ^ (GCM_R & carry);
+    }
+    return acc;
+}
+
+GS_INLINE void gcm_inc32(uint8_t* counter) noexcept
+{
+    store_be32(counter + 12, load_be32(counter + 12) + 1U);
+}
+
+/// GHASH over a byte stream, zero-padding the final partial block.
+inline void ghash_portable(Gf128& acc, const Gf128& hkey, const uint8_t* data, size_t len) noexcept
+{
+    while (len > 0) {
+        uint8_t block[NC_AES_BLOCK_SIZE] = {};
+        const size_t take = (len < NC_AES_BLOCK_SIZE) ? len : NC_AES_BLOCK_SIZE;
+        std::memcpy(block, data, take);
+        const Gf128 in = Gf128::load(block);
+        acc.hi ^= in.hi;
+        acc.lo ^= in.lo;
+        acc = gf128_mul_portable(acc, hkey);
+        data += take;
+        len -= take;
+    }
+}
+
+/**
+ * @brief Portable AES-256-GCM with a 96-bit IV.
+ * Writes the keystream-XORed output to @p out and S = GHASH(A, C) to @p ghash_out.
+ * @param encrypt true: ghash over output; false: ghash over input.
+ */
+inline void gcm_crypt_portable(const Aes256Schedule& ks,
+                               const uint8_t* iv,
+                               const uint8_t* in,
+                               size_t len,
+                               const uint8_t* aad,
+                               size_t aad_len,
+                               uint8_t* out,
+                               uint8_t* tag_out,
+                               bool encrypt) noexcept
+{
+    uint8_t zero[NC_AES_BLOCK_SIZE] = {};
+    uint8_t h_bytes[NC_AES_BLOCK_SIZE];
+    aes256_encrypt_block_portable(ks, zero, h_bytes);
+    const Gf128 hkey = Gf128::load(h_bytes);
+
+    uint8_t j0[NC_AES_BLOCK_SIZE] = {};
+    std::memcpy(j0, iv, security::HW_AES_GCM_IV_SIZE);
+    j0[15] = 1;
+
+    Gf128 acc{};
+    ghash_portable(acc, hkey, aad, aad_len);
+    if (!encrypt) {
+        ghash_portable(acc, hkey, in, len);
+    }
+
+    uint8_t counter[NC_AES_BLOCK_SIZE];
+    std::memcpy(counter, j0, NC_AES_BLOCK_SIZE);
+    for (size_t off = 0; off < len; off += NC_AES_BLOCK_SIZE) {
+        gcm_inc32(counter);
+        uint8_t stream[NC_AES_BLOCK_SIZE];
+        aes256_encrypt_block_portable(ks, counter, stream);
+        const size_t take = (len - off < NC_AES_BLOCK_SIZE) ? (len - off) : NC_AES_BLOCK_SIZE;
+        for (size_t idx = 0; idx < take; ++idx) {
+            out[off + idx] = in[off + idx] ^ stream[idx];
+        }
+    }
+    if (encrypt) {
+        ghash_portable(acc, hkey, out, len);
+    }
+
+    uint8_t len_block[NC_AES_BLOCK_SIZE];
+    store_be64(len_block, static_cast<uint64_t>(aad_len) * 8U);
+    store_be64(len_block + 8, static_cast<uint64_t>(len) * 8U);
+    ghash_portable(acc, hkey, len_block, NC_AES_BLOCK_SIZE);
+
+    uint8_t ek_j0[NC_AES_BLOCK_SIZE];
+    aes256_encrypt_block_portable(ks, j0, ek_j0);
+    acc.store(tag_out);
+    for (size_t idx = 0; idx < NC_AES_BLOCK_SIZE; ++idx) {
+        tag_out[idx] ^= ek_j0[idx];
+    }
+}
+
+// ============================================================================
+// GCM — AES-NI + PCLMULQDQ path
+// ============================================================================
+#if GS_NATIVE_CRYPTO_X86
+
+#define GS_NC_AESNI_TARGET __attribute__((target("aes,pclmul,ssse3,sse4.1")))
+
+GS_NC_AESNI_TARGET GS_INLINE __m128i bswap128(__m128i val) noexcept
+{
+    return _mm_shuffle_epi8(val, _mm_set_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15));
+}
+
+/// Carry-less multiply + reduction on byte-reflected operands (Intel CLMUL white paper).
+GS_NC_AESNI_TARGET GS_INLINE __m128i gf128_mul_clmul(__m128i lhs, __m128i rhs) noexcept
+{
+    __m128i lo = _mm_clmulepi64_si128(lhs, rhs, 0x00);
+    __m128i mid = _mm_xor_si128(_mm_clmulepi64_si128(lhs, rhs, 0x10),
+                                _mm_clmulepi64_si128(lhs, rhs, 0x01));
+    __m128i hi = _mm_clmulepi64_si128(lhs, rhs, 0x11);
+    lo = _mm_xor_si128(lo, _mm_slli_si128(mid, 8));
+    hi = _mm_xor_si128(hi, _mm_srli_si128(mid, 8));
+
+    // Shift the 256-bit product left by one (bit-reflected representation)
+    __m128i lo_carry = _mm_srli_epi32(lo, 31);
+    __m128i hi_carry = _mm_srli_epi32(hi, 31);
+    lo = _mm_slli_epi32(lo, 1);
+    hi = _mm_slli_epi32(hi, 1);
+    const __m128i cross = _mm_srli_si128(lo_carry, 12);
+    hi_carry = _mm_slli_si128(hi_carry, 4);
+    lo_carry = _mm_slli_si128(lo_carry, 4);
+    lo = _mm_or_si128(lo, lo_carry);
+    hi = _mm_or_si128(hi, hi_carry);
+    hi = _mm_or_si128(hi, cross);
+
+    // Reduce modulo x^128 + x^7 + x^2 + x + 1
+    __m128i red = _mm_xor_si128(_mm_xor_si128(_mm_slli_epi32(lo, 31), _mm_slli_epi32(lo, 30)),
+                                _mm_slli_epi32(lo, 25));
+    const __m128i red_hi = _mm_srli_si128(red, 4);
+    red = _mm_slli_si128(red, 12);
+    lo = _mm_xor_si128(lo, red);
+    __m128i fold = _mm_xor_si128(_mm_xor_si128(_mm_srli_epi32(lo, 1), _mm_srli_epi32(lo, 2)),
+                                 _mm_srli_epi32(lo, 7));
+    fold = _mm_xor_si128(fold, red_hi);
+    lo = _mm_xor_si128(lo, fold);
+    return _mm_xor_si128(hi, lo);
+}
+
+GS_NC_AESNI_TARGET GS_INLINE __m128i aes256_encrypt_ni(const __m128i* rk, __m128i block) noexcept
+{
+    block = _mm_xor_si128(block, rk[0]);
+    for (size_t round = 1; round < NC_AES256_ROUNDS; ++round) {
+        block = _mm_aesenc_si128(block, rk[round]);
+    }
+    return _mm_aesenclast_si128(block, rk[NC_AES256_ROUNDS]);
+}
+
+GS_NC_AESNI_TARGET GS_INLINE __m128i load_partial(const uint8_t* src, size_t len) noexcept
+{
+    alignas(16) uint8_t block[NC_AES_BLOCK_SIZE] = {};
+    std::memcpy(block, src, len);
+    return _mm_load_si128(reinterpret_cast<const __m128i*>(block));
+}
+
+GS_NC_AESNI_TARGET inline void ghash_clmul(__m128i& acc,
+                                           const __m128i* hpow,
+                                           const uint8_t* data,
+                                           size_t len) noexcept
+{
+    // Aggregated 4-block GHASH: X' = (X+C0)H^4 + C1 H^3 + C2 H^2 + C3 H
+    while (len >= NC_GCM_PARALLEL_BLOCKS * NC_AES_BLOCK_SIZE) {
+        const __m128i* src = reinterpret_cast<const __m128i*>(data);
+        const __m128i c0 = _mm_xor_si128(acc, bswap128(_mm_loadu_si128(src)));
+        const __m128i c1 = bswap128(_mm_loadu_si128(src + 1));
+        const __m128i c2 = bswap128(_mm_loadu_si128(src + 2));
+        const __m128i c3 = bswap128(_mm_loadu_si128(src + 3));
+        acc = _mm_xor_si128(_mm_xor_si128(gf128_mul_clmul(c0, hpow[3]), gf128_mul_clmul(c1, hpow[2])),
+                            _mm_xor_si128(gf128_mul_clmul(c2, hpow[1]), gf128_mul_clmul(c3, hpow[0])));
+        data += NC_GCM_PARALLEL_BLOCKS * NC_AES_BLOCK_SIZE;
+        len -= NC_GCM_PARALLEL_BLOCKS * NC_AES_BLOCK_SIZE;
+    }
+    while (len > 0) {
+        const size_t take = (len < NC_AES_BLOCK_SIZE) ? len : NC_AES_BLOCK_SIZE;
+        acc = gf128_mul_clmul(_mm_xor_si128(acc, bswap128(load_partial(data, take))), hpow[0]);
+        data += take;
+        len -= take;
+    }
+}
+
+GS_NC_AESNI_TARGET inline void gcm_crypt_aesni(const Aes256Schedule& ks,
+                                               const uint8_t* iv,
+                                               const uint8_t* in,
+                                               size_t len,
+                                               const uint8_t* aad,
+                                               size_t aad_len,
+                                               uint8_t* out,
+                                               uint8_t* tag_out,
+                                               bool encrypt) noexcept
+{
+    __m128i rk[NC_AES256_ROUNDS + 1];
+    for (size_t round = 0; round <= NC_AES256_ROUNDS; ++round) {
+        rk[round] =
+            _mm_load_si128(reinterpret_cast<const __m128i*>(&ks.bytes[round * NC_AES_BLOCK_SIZE]));
+    }
+
+    // H^1..H^4 in reflected form
+    __m128i hpow[NC_GCM_PARALLEL_BLOCKS];
+    hpow[0] = bswap128(aes256_encrypt_ni(rk, _mm_setzero_si128()));
+    for (size_t idx = 1; idx < NC_GCM_PARALLEL_BLOCKS; ++idx) {
+        hpow[idx] = gf128_mul_clmul(hpow[idx - 1], hpow[0]);
+    }
+
+    alignas(16) uint8_t j0_bytes[NC_AES_BLOCK_SIZE] = {};
+    std::memcpy(j0_bytes, iv, security::HW_AES_GCM_IV_SIZE);
+    j0_bytes[15] = 1;
+    const __m128i j0 = _mm_load_si128(reinterpret_cast<const __m128i*>(j0_bytes));
+
+    __m128i acc = _mm_setzero_si128();
+    ghash_clmul(acc, hpow, aad, aad_len);
+    if (!encrypt) {
+        ghash_clmul(acc, hpow, in, len);
+    }
+
+    // Counter kept little-endian in lane 0 after bswap so a 32-bit add works
+    const __m128i one = _mm_set_epi32(0, 0, 0, 1);
+    __m128i ctr = _mm_add_epi32(bswap128(j0), one);
+    size_t off = 0;
+    while (len - off >= NC_GCM_PARALLEL_BLOCKS * NC_AES_BLOCK_SIZE) {
+        __m128i blk[NC_GCM_PARALLEL_BLOCKS];
+        for (size_t lane = 0; lane < NC_GCM_PARALLEL_BLOCKS; ++lane) {
+            blk[lane] = _mm_xor_si128(bswap128(ctr), rk[0]);
+            ctr = _mm_add_epi32(ctr, one);
+        }
+        for (size_t round = 1; round < NC_AES256_ROUNDS; ++round) {
+            for (size_t lane = 0; lane < NC_GCM_PARALLEL_BLOCKS; ++lane) {
+                blk[lane] = _mm_aesenc_si128(blk[lane], rk[round]);
+            }
+        }
+        for (size_t lane = 0; lane < NC_GCM_PARALLEL_BLOCKS; ++lane) {
+            blk[lane] = _mm_aesenclast_si128(blk[lane], rk[NC_AES256_ROUNDS]);
+            const __m128i* src = reinterpret_cast<const __m128i*>(in + off) + lane;
+            __m128i* dst = reinterpret_cast<__m128i*>(out + off) + lane;
+            _mm_storeu_si128(dst, _mm_xor_si128(blk[lane], _mm_loadu_si128(src)));
+        }
+        off += NC_GCM_PARALLEL_BLOCKS * NC_AES_BLOCK_SIZE;
+    }
+    while (off < len) {
+        const __m128i stream = aes256_encrypt_ni(rk, bswap128(ctr));
+        ctr = _mm_add_epi32(ctr, one);
+        alignas(16) uint8_t ks_bytes[NC_AES_BLOCK_SIZE];
+        _mm_store_si128(reinterpret_cast<__m128i*>(ks_bytes), stream);
+        const size_t take = (len - off < NC_AES_BLOCK_SIZE) ? (len - off) : NC_AES_BLOCK_SIZE;
+        for (size_t idx = 0; idx < take; ++idx) {
+            out[off + idx] = in[off + idx] ^ ks_bytes[idx];
+        }
+        off += take;
+    }
+    if (encrypt) {
+        ghash_clmul(acc, hpow, out, len);
+    }
+
+    alignas(16) uint8_t len_block[NC_AES_BLOCK_SIZE];
+    store_be64(len_block, static_cast<uint64_t>(aad_len) * 8U);
+    store_be64(len_block + 8, static_cast<uint64_t>(len) * 8U);
+    ghash_clmul(acc, hpow, len_block, NC_AES_BLOCK_SIZE);
+
+    const __m128i tag = _mm_xor_si128(bswap128(acc), aes256_encrypt_ni(rk, j0));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(tag_out), tag);
+}
+
+#undef GS_NC_AESNI_TARGET
+
+#endif // GS_NATIVE_CRYPTO_X86
+
+/// Constant-time tag comparison.
+GS_INLINE bool ct_equal(const uint8_t* lhs, const uint8_t* rhs, size_t len) noexcept
+{
+    uint8_t diff = 0;
+    for (size_t idx = 0; idx < len; ++idx) {
+        diff |= static_cast<uint8_t>(lhs[idx] ^ rhs[idx]);
+    }
+    return diff == 0;
+}
+
+// ============================================================================
+// CRC-32 (IEEE 802.3, reflected) — matches esp_crc32_le(0, ...)
+// ============================================================================
+struct Crc32Table
+{
+    std::array<uint32_t, 256> entries{};
+
+    GS_CONSTEXPR Crc32Table() noexcept
+    {
+        for (uint32_t idx = 0; idx < 256; ++idx) {
+            uint32_t crc = idx;
+            for (int bit = 0; bit < 8; ++bit) {
+                crc = (crc & 1U) != 0 ? (crc >> 1) ^ NC_CRC32_POLY_REFLECTED : crc >> 1;
+            }
+            entries[idx] = crc;
+        }
+    }
+};
+
+static constexpr Crc32Table CRC32_TABLE{};
+
+} // namespace detail
+
+// ============================================================================
+// Streaming SHA-256 with runtime dispatch
+// ============================================================================
+class Sha256
+{
+public:
+    using BlockFn = void (*)(uint32_t*, const uint8_t*, size_t) noexcept;
+
+    explicit Sha256(bool allow_hw = true) noexcept : blocks_fn_(select(allow_hw))
+    {
+        reset();
+    }
+
+    void reset() noexcept
+    {
+        std::memcpy(state_.data(), detail::SHA256_IV, sizeof(detail::SHA256_IV));
+        buffered_ = 0;
+        total_len_ = 0;
+    }
+
+    void update(const uint8_t* data, size_t len) noexcept
+    {
+        total_len_ += len;
+        if (buffered_ > 0) {
+            const size_t take = (len < NC_SHA256_BLOCK_SIZE - buffered_)
+                                    ? len
+                                    : (NC_SHA256_BLOCK_SIZE - buffered_);
+            std::memcpy(&buffer_[buffered_], data, take);
+            buffered_ += take;
+            data += take;
+            len -= take;
+            if (buffered_ < NC_SHA256_BLOCK_SIZE) {
+                return;
+            }
+            blocks_fn_(state_.data(), buffer_.data(), 1);
+            buffered_ = 0;
+        }
+        const size_t blocks = len / NC_SHA256_BLOCK_SIZE;
+        if (blocks > 0) {
+            blocks_fn_(state_.data(), data, blocks);
+            data += blocks * NC_SHA256_BLOCK_SIZE;
+            len -= blocks * NC_SHA256_BLOCK_SIZE;
+        }
+        if (len > 0) {
+            std::memcpy(buffer_.data(), data, len);
+            buffered_ = len;
+        }
+    }
+
+    void finish(uint8_t* digest_out) noexcept
+    {
+        static constexpr size_t LENGTH_FIELD = 8;
+        const uint64_t bit_len = total_len_ * 8U;
+        buffer_[buffered_++] = 0x80;
+        if (buffered_ > NC_SHA256_BLOCK_SIZE - LENGTH_FIELD) {
+            std::memset(&buffer_[buffered_], 0, NC_SHA256_BLOCK_SIZE - buffered_);
+            blocks_fn_(state_.data(), buffer_.data(), 1);
+            buffered_ = 0;
+        }
+        std::memset(&buffer_[buffered_], 0, NC_SHA256_BLOCK_SIZE - LENGTH_FIELD - buffered_);
+        detail::store_be64(&buffer_[NC_SHA256_BLOCK_SIZE - LENGTH_FIELD], bit_len);
+        blocks_fn_(state_.data(), buffer_.data(), 1);
+
+        for (size_t idx = 0; idx < NC_SHA256_STATE_WORDS; ++idx) {
+            detail::store_be32(digest_out + (idx * 4), state_[idx]);
+        }
+        reset();
+    }
+
+    GS_NODISCARD bool uses_hw() const noexcept
+    {
+        return blocks_fn_ != &detail::sha256_blocks_portable;
+    }
+
+private:
+    static BlockFn select(bool allow_hw) noexcept
+    {
+#if GS_NATIVE_CRYPTO_X86
+        if (allow_hw && CpuFeatures::host().sha_ni) {
+            return &detail::sha256_blocks_shani;
+        }
+#else
+        (void)allow_hw;
+#endif
+        return &detail::sha256_blocks_portable;
+    }
+
+    BlockFn blocks_fn_;
+    std::array<uint32_t, NC_SHA256_STATE_WORDS> state_{};
+    std::array<uint8_t, NC_SHA256_BLOCK_SIZE> buffer_{};
+    size_t buffered_{0};
+    uint64_t total_len_{0};
+};
+
+// ============================================================================
+// NATIVE PLATFORM CRYPTO — OS RNG + table CRC32 + SHA-256
+// ============================================================================
+class NativeCrypto final : public IPlatformCrypto
+{
+public:
+    NativeCrypto() noexcept = default;
+
+    core::Result<void> random_bytes(uint8_t* buffer, size_t length) noexcept override
+    {
+        if (GS_UNLIKELY(buffer == nullptr || length == 0)) {
+            return GS_MAKE_ERROR(core::ErrorCode::InvalidParameter);
+        }
+#if defined(__linux__)
+        size_t filled = 0;
+        while (filled < length) {
+            const ssize_t got = getrandom(buffer + filled, length - filled, 0);
+            if (got <= 0) {
+                return GS_MAKE_ERROR(core::ErrorCode::CryptoFailure);
+            }
+            filled += static_cast<size_t>(got);
+        }
+#else
+        FILE* urandom = std::fopen("/dev/urandom", "rb");
+        if (urandom == nullptr) {
+            return GS_MAKE_ERROR(core::ErrorCode::CryptoFailure);
+        }
+        const size_t got = std::fread(buffer, 1, length, urandom);
+        std::fclose(urandom);
+        if (got != length) {
+            return GS_MAKE_ERROR(core::ErrorCode::CryptoFailure);
+        }
+#endif
+        return core::Result<void>{};
+    }
+
+    core::Result<uint32_t> crc32(const uint8_t* data, size_t length) noexcept override
+    {
+        if (GS_UNLIKELY(data == nullptr)) {
+            return core::Result<uint32_t>(GS_MAKE_ERROR(core::ErrorCode::InvalidParameter));
+        }
+
+        uint32_t crc = 0xFFFFFFFFU;
+        for (size_t idx = 0; idx < length; ++idx) {
+            crc = detail::CRC32_TABLE.entries[(crc ^ data[idx]) & 0xFFU] ^ (crc >> 8);
+        }
+        return core::Result<uint32_t>(crc ^ 0xFFFFFFFFU);
+    }
+
+    core::Result<void>
+    sha256(const uint8_t* data, size_t length, uint8_t* hash_out) noexcept override
+    {
+        if (GS_UNLIKELY((data == nullptr && length > 0) || hash_out == nullptr)) {
+            return GS_MAKE_ERROR(core::ErrorCode::InvalidParameter);
+        }
+
+        Sha256 ctx;
+        ctx.update(data, length);
+        ctx.finish(hash_out);
+        return core::Result<void>{};
+    }
+};
+
+// ============================================================================
+// NATIVE HW CRYPTO — AES-256-GCM / SHA-256 / HMAC with CPU dispatch
+// ============================================================================
+class NativeHwCrypto final : public security::IHwCrypto
+{
+public:
+    NativeHwCrypto() noexcept = default;
+
+    core::Result<void> init() noexcept override
+    {
+        const CpuFeatures& cpu = CpuFeatures::host();
+        use_aesni_ = allow_hw_ && cpu.aes_ni && cpu.pclmul;
+        use_shani_ = allow_hw_ && cpu.sha_ni;
+        initialized_ = true;
+        return core::Result<void>{};
+    }
+
+    core::Result<security::CryptoOutput> aes_gcm_encrypt(const uint8_t* key,
+                                                         const uint8_t* iv,
+                                                         const uint8_t* plaintext,
+                                                         size_t plaintext_len,
+                                                         const uint8_t* aad,
+                                                         size_t aad_len) noexcept override
+    {
+        using security::CryptoOutput;
+        GS_TRY(check_gcm_args(key, iv, plaintext, plaintext_len, aad, aad_len));
+
+        CryptoOutput output{};
+        run_gcm(key, iv, plaintext, plaintext_len, aad, aad_len, output.data.data(),
+                output.tag.data(), true);
+        output.length = plaintext_len;
+        return core::Result<CryptoOutput>(GS_MOVE(output));
+    }
+
+    core::Result<security::CryptoOutput> aes_gcm_decrypt(const uint8_t* key,
+                                                         const uint8_t* iv,
+                                                         const uint8_t* ciphertext,
+                                                         size_t ciphertext_len,
+                                                         const uint8_t* tag,
+                                                         const uint8_t* aad,
+                                                         size_t aad_len) noexcept override
+    {
+        using security::CryptoOutput;
+        GS_TRY(check_gcm_args(key, iv, ciphertext, ciphertext_len, aad, aad_len));
+        if (tag == nullptr) {
+            return core::Result<CryptoOutput>(GS_MAKE_ERROR(core::ErrorCode::InvalidParameter));
+        }
+
+        CryptoOutput output{};
+        std::array<uint8_t, security::HW_AES_GCM_TAG_SIZE> expected{};
+        run_gcm(key, iv, ciphertext, ciphertext_len, aad, aad_len, output.data.data(),
+                expected.data(), false);
+        if (!detail::ct_equal(expected.data(), tag, security::HW_AES_GCM_TAG_SIZE)) {
+            std::memset(output.data.data(), 0, ciphertext_len);
+            return core::Result<CryptoOutput>(GS_MAKE_ERROR(core::ErrorCode::AuthenticationFailed));
+        }
+        output.length = ciphertext_len;
+        output.tag = expected;
+        return core::Result<CryptoOutput>(GS_MOVE(output));
+    }
+
+    core::Result<security::Sha256Digest> sha256(const uint8_t* data, size_t len) noexcept override
+    {
+        using security::Sha256Digest;
+        if (GS_UNLIKELY(!initialized_)) {
+            return core::Result<Sha256Digest>(GS_MAKE_ERROR(core::ErrorCode::SystemNotInitialized));
+        }
+        if (data == nullptr && len > 0) {
+            return core::Result<Sha256Digest>(GS_MAKE_ERROR(core::ErrorCode::InvalidParameter));
+        }
+
+        Sha256Digest digest{};
+        Sha256 ctx(use_shani_);
+        ctx.update(data, len);
+        ctx.finish(digest.data());
+        return core::Result<Sha256Digest>(digest);
+    }
+
+    core::Result<security::HmacDigest> hmac_sha256(const uint8_t* key,
+                                                   size_t key_len,
+                                                   const uint8_t* data,
+                                                   size_t data_len) noexcept override
+    {
+        using security::HmacDigest;
+        if (GS_UNLIKELY(!initialized_)) {
+            return core::Result<HmacDigest>(GS_MAKE_ERROR(core::ErrorCode::SystemNotInitialized));
+        }
+        if ((key == nullptr && key_len > 0) || (data == nullptr && data_len > 0)) {
+            return core::Result<HmacDigest>(GS_MAKE_ERROR(core::ErrorCode::InvalidParameter));
+        }
+
+        // RFC 2104: keys longer than a block are hashed first
+        std::array<uint8_t, NC_SHA256_BLOCK_SIZE> block_key{};
+        Sha256 ctx(use_shani_);
+        if (key_len > NC_SHA256_BLOCK_SIZE) {
+            ctx.update(key, key_len);
+            ctx.finish(block_key.data());
+        } else if (key_len > 0) {
+            std::memcpy(block_key.data(), key, key_len);
+        }
+
+        static constexpr uint8_t HMAC_IPAD = 0x36;
+        static constexpr uint8_t HMAC_OPAD = 0x5C;
+        std::array<uint8_t, NC_SHA256_BLOCK_SIZE> pad{};
+        for (size_t idx = 0; idx < NC_SHA256_BLOCK_SIZE; ++idx) {
+            pad[idx] = block_key[idx] ^ HMAC_IPAD;
+        }
+        HmacDigest inner{};
+        ctx.update(pad.data(), pad.size());
+        ctx.update(data, data_len);
+        ctx.finish(inner.data());
+
+        for (size_t idx = 0; idx < NC_SHA256_BLOCK_SIZE; ++idx) {
+            pad[idx] = block_key[idx] ^ HMAC_OPAD;
+        }
+        HmacDigest mac{};
+        ctx.update(pad.data(), pad.size());
+        ctx.update(inner.data(), inner.size());
+        ctx.finish(mac.data());
+
+        std::memset(block_key.data(), 0, block_key.size());
+        std::memset(pad.data(), 0, pad.size());
+        return core::Result<HmacDigest>(mac);
+    }
+
+    bool has_hw_acceleration() const noexcept override
+    {
+        return use_aesni_;
+    }
+
+    GS_NODISCARD bool has_sha_acceleration() const noexcept
+    {
+        return use_shani_;
+    }
+
+    // === Test helpers ===
+    /// Force the portable paths (takes effect on next init()).
+    void set_allow_hw(bool allow) noexcept
+    {
+        allow_hw_ = allow;
+    }
+
+private:
+    core::Result<void> check_gcm_args(const uint8_t* key,
+                                      const uint8_t* iv,
+                                      const uint8_t* input,
+                                      size_t input_len,
+                                      const uint8_t* aad,
+                                      size_t aad_len) const noexcept
+    {
+        if (GS_UNLIKELY(!initialized_)) {
+            return GS_MAKE_ERROR(core::ErrorCode::SystemNotInitialized);
+        }
+        if (key == nullptr || iv == nullptr || (input == nullptr && input_len > 0) ||
+            (aad == nullptr && aad_len > 0)) {
+            return GS_MAKE_ERROR(core::ErrorCode::InvalidParameter);
+        }
+        if (input_len > security::HW_CRYPTO_MAX_DATA_SIZE) {
+            return GS_MAKE_ERROR(core::ErrorCode::InvalidParameter);
+        }
+        return core::Result<void>{};
+    }
+
+    void run_gcm(const uint8_t* key,
+                 const uint8_t* iv,
+                 const uint8_t* input,
+                 size_t len,
+                 const uint8_t* aad,
+                 size_t aad_len,
+                 uint8_t* out,
+                 uint8_t* tag_out,
+                 bool encrypt) const noexcept
+    {
+        detail::Aes256Schedule schedule;
+        schedule.expand(key);
+#if GS_NATIVE_CRYPTO_X86
+        if (use_aesni_) {
+            detail::gcm_crypt_aesni(schedule, iv, input, len, aad, aad_len, out, tag_out, encrypt);
+            schedule.wipe();
+            return;
+        }
+#endif
+        detail::gcm_crypt_portable(schedule, iv, input, len, aad, aad_len, out, tag_out, encrypt);
+        schedule.wipe();
+    }
+
+    bool initialized_{false};
+    bool allow_hw_{true};
+    bool use_aesni_{false};
+    bool use_shani_{false};
+};
+
+} // namespace gridshield::platform::native
+
+#endif // GS_PLATFORM_NATIVE
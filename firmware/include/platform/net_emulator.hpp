@@ -0,0 +1,566 @@
+/**
+ * @file net_emulator.hpp
+ * @author zuudevs (zuudevs@gmail.com)
+ * @brief Seeded discrete-event network emulator behind IPlatformComm
+ * @version 1.0
+ * @date 2026-03-12
+ *
+ * Two IPlatformComm endpoints joined by a pair of one-way links. Each link
+ * applies, per segment: MTU fragmentation, a bandwidth cap with a bounded
+ * bottleneck queue (tail drop), Gilbert-Elliott burst loss, latency plus a
+ * jitter distribution, explicit reordering, duplication and single-bit
+ * corruption. Stream links additionally hand bytes to receive() in arbitrary
+ * chunk sizes. All randomness comes from a per-link seeded PRNG and all
+ * timing from IPlatformTime, so a run on SimClock is exactly reproducible.
+ *
+ * @copyright Copyright (c) 2026
+ */
+
+#pragma once
+
+#include "platform/platform.hpp"
+#include "platform/sim_clock.hpp"
+#include "utils/gs_macros.hpp"
+
+#include <cmath>
+#include <cstring>
+
+namespace gridshield::platform::sim {
+
+// ============================================================================
+// CONSTANTS
+// ============================================================================
+static constexpr size_t NET_SIM_MAX_SEGMENTS = 64;
+static constexpr size_t NET_SIM_SEGMENT_MAX = 1536;
+
+// ============================================================================
+// LINK PROFILE
+// ============================================================================
+enum class JitterModel : uint8_t
+{
+    None = 0,
+    Uniform = 1,     // U[0, 2 * mean]
+    Exponential = 2, // memoryless queueing delay
+    Pareto = 3       // heavy tail (alpha 2.5), capped at 20 x mean
+};
+
+/// Two-state burst loss: per-segment transition, then loss with the state's rate.
+struct GilbertElliott
+{
+    float p_good_to_bad{0.0F};
+    float p_bad_to_good{1.0F};
+    float loss_good{0.0F};
+    float loss_bad{0.0F};
+};
+
+struct LinkProfile
+{
+    uint32_t latency_us{0};
+    uint32_t jitter_us{0}; // mean of the jitter distribution
+    JitterModel jitter_model{JitterModel::None};
+    uint32_t bandwidth_bps{0}; // 0 = unlimited
+    uint32_t queue_bytes{0};   // bottleneck buffer; 0 = unbounded
+    GilbertElliott loss{};
+    float reorder_prob{0.0F};
+    uint32_t reorder_delay_us{0}; // extra delay that lets later segments overtake
+    float duplicate_prob{0.0F};
+    float corrupt_prob{0.0F}; // flips one random bit of the segment
+    uint16_t mtu{0};          // send() splits into segments of at most mtu bytes; 0 = no split
+    bool stream{false};       // receive() returns arbitrary chunk sizes across segment bounds
+};
+
+namespace presets {
+
+/// Home/office WiFi, UDP-like: a few ms, rare short loss bursts.
+inline LinkProfile good_wifi() noexcept
+{
+    LinkProfile p;
+    p.latency_us = 3000;
+    p.jitter_us = 1000;
+    p.jitter_model = JitterModel::Uniform;
+    p.bandwidth_bps = 20000000;
+    p.queue_bytes = 64 * 1024;
+    p.loss = {0.002F, 0.5F, 0.0005F, 0.2F};
+    p.reorder_prob = 0.001F;
+    p.reorder_delay_us = 2000;
+    p.mtu = 1460;
+    return p;
+}
+
+/// Loaded cell, TCP-like byte stream: long heavy-tailed delay, bursty loss.
+inline LinkProfile congested_cellular() noexcept
+{
+    LinkProfile p;
+    p.latency_us = 80000;
+    p.jitter_us = 40000;
+    p.jitter_model = JitterModel::Pareto;
+    p.bandwidth_bps = 256000;
+    p.queue_bytes = 8 * 1024;
+    p.loss = {0.02F, 0.25F, 0.005F, 0.3F};
+    p.reorder_prob = 0.02F;
+    p.reorder_delay_us = 30000;
+    p.duplicate_prob = 0.005F;
+    p.corrupt_prob = 0.002F;
+    p.mtu = 536;
+    p.stream = true;
+    return p;
+}
+
+/// LoRa SF9/125 kHz-like: ~1.8 kbit/s, small frames, airtime dominates.
+inline LinkProfile lora_like() noexcept
+{
+    LinkProfile p;
+    p.latency_us = 20000;
+    p.jitter_us = 10000;
+    p.jitter_model = JitterModel::Exponential;
+    p.bandwidth_bps = 1760;
+    p.queue_bytes = 2 * 1024;
+    p.loss = {0.01F, 0.3F, 0.01F, 0.4F};
+    p.corrupt_prob = 0.005F;
+    p.mtu = 222;
+    return p;
+}
+
+} // namespace presets
+
+// ============================================================================
+// LINK
+// ============================================================================
+struct NetLinkStats
+{
+    uint32_t segments_offered{0};
+    uint32_t segments_delivered{0};
+    uint32_t dropped_loss{0};
+    uint32_t dropped_queue{0}; // bottleneck buffer or segment pool full
+    uint32_t duplicated{0};
+    uint32_t reordered{0};
+    uint32_t corrupted{0};
+    uint64_t bytes_offered{0};
+    uint64_t bytes_delivered{0};
+};
+
+/// One direction of the emulated path.
+class NetLink
+{
+public:
+    NetLink() noexcept = default;
+    NetLink(const LinkProfile& profile, uint64_t seed) noexcept
+    {
+        configure(profile, seed);
+    }
+
+    void configure(const LinkProfile& profile, uint64_t seed) noexcept
+    {
+        profile_ = profile;
+        rng_ = seed ^ 0x9E3779B97F4A7C15ULL;
+        (void)next_u64(); // decorrelate adjacent seeds
+        bad_state_ = false;
+        link_free_at_us_ = 0;
+        last_arrival_us_ = 0;
+        order_ = 0;
+        for (auto& slot : slots_) {
+            slot.used = false;
+        }
+        stats_ = NetLinkStats{};
+    }
+
+    /// Offer @p length bytes at time @p now_us. Lost bytes still count as sent.
+    void transmit(uint64_t now_us, const uint8_t* data, size_t length) noexcept
+    {
+        const size_t mtu = profile_.mtu != 0 ? profile_.mtu : NET_SIM_SEGMENT_MAX;
+        const size_t max_segment = mtu < NET_SIM_SEGMENT_MAX ? mtu : NET_SIM_SEGMENT_MAX;
+        size_t offset = 0;
+        while (offset < length) {
+            const size_t chunk = (length - offset) < max_segment ? (length - offset) : max_segment;
+            transmit_segment(now_us, data + offset, chunk);
+            offset += chunk;
+        }
+    }
+
+    GS_NODISCARD bool has_deliverable(uint64_t now_us) noexcept
+    {
+        return next_ready(now_us) != nullptr;
+    }
+
+    /// Earliest pending arrival time, or UINT64_MAX when nothing is in flight.
+    GS_NODISCARD uint64_t next_arrival_us() const noexcept
+    {
+        uint64_t earliest = UINT64_MAX;
+        for (const auto& slot : slots_) {
+            if (slot.used && slot.arrival_us < earliest) {
+                earliest = slot.arrival_us;
+            }
+        }
+        return earliest;
+    }
+
+    /**
+     * @brief Hand arrived bytes to the receiver.
+     *
+     * Datagram links return one segment (truncated to @p max_length like
+     * UDP). Stream links return a random-sized chunk that may span segments.
+     */
+    size_t deliver(uint64_t now_us, uint8_t* buffer, size_t max_length) noexcept
+    {
+        if (!profile_.stream) {
+            Segment* seg = next_ready(now_us);
+            if (seg == nullptr) {
+                return 0;
+            }
+            const size_t n = seg->length < max_length ? seg->length : max_length;
+            std::memcpy(buffer, seg->data, n);
+            release(*seg);
+            return n;
+        }
+
+        const size_t want = 1 + static_cast<size_t>(next_u64() % max_length);
+        size_t copied = 0;
+        while (copied < want) {
+            Segment* seg = next_ready(now_us);
+            if (seg == nullptr) {
+                break;
+            }
+            const size_t left = seg->length - seg->consumed;
+            const size_t n = (want - copied) < left ? (want - copied) : left;
+            std::memcpy(buffer + copied, seg->data + seg->consumed, n);
+            seg->consumed = static_cast<uint16_t>(seg->consumed + n);
+            copied += n;
+            if (seg->consumed == seg->length) {
+                release(*seg);
+            }
+        }
+        return copied;
+    }
+
+    GS_NODISCARD const NetLinkStats& stats() const noexcept
+    {
+        return stats_;
+    }
+
+    GS_NODISCARD const LinkProfile& profile() const noexcept
+    {
+        return profile_;
+    }
+
+private:
+    struct Segment
+    {
+        uint64_t arrival_us{0};
+        uint32_t order{0};
+        uint16_t length{0};
+        uint16_t consumed{0};
+        bool used{false};
+        uint8_t data[NET_SIM_SEGMENT_MAX];
+    };
+
+    // xorshift64*: tiny, fast, and fully determined by the seed
+    uint64_t next_u64() noexcept
+    {
+        rng_ ^= rng_ >> 12;
+        rng_ ^= rng_ << 25;
+        rng_ ^= rng_ >> 27;
+        return rng_ * 0x2545F4914F6CDD1DULL;
+    }
+
+    double next_unit() noexcept
+    {
+        return static_cast<double>(next_u64() >> 11) * (1.0 / 9007199254740992.0);
+    }
+
+    bool chance(float probability) noexcept
+    {
+        return probability > 0.0F && next_unit() < static_cast<double>(probability);
+    }
+
+    uint64_t sample_jitter_us() noexcept
+    {
+        const double mean = profile_.jitter_us;
+        if (mean <= 0.0) {
+            return 0;
+        }
+        double value = 0.0;
+        switch (profile_.jitter_model) {
+            case JitterModel::None:
+                return 0;
+            case JitterModel::Uniform:
+                value = next_unit() * 2.0 * mean;
+                break;
+            case JitterModel::Exponential:
+                value = -mean * std::log(1.0 - next_unit());
+                break;
+            case JitterModel::Pareto: {
+                constexpr double alpha = 2.5;
+                const double scale = mean * (alpha - 1.0); // shifted Pareto with this mean
+                value = scale * (std::pow(1.0 - next_unit(), -1.0 / alpha) - 1.0);
+                value = value < 20.0 * mean ? value : 20.0 * mean;
+                break;
+            }
+        }
+        return static_cast<uint64_t>(value);
+    }
+
+    bool lost() noexcept
+    {
+        const auto& ge = profile_.loss;
+        bad_state_ = bad_state_ ? !chance(ge.p_bad_to_good) : chance(ge.p_good_to_bad);
+        return chance(bad_state_ ? ge.loss_bad : ge.loss_good);
+    }
+
+    void transmit_segment(uint64_t now_us, const uint8_t* data, size_t length) noexcept
+    {
+        ++stats_.segments_offered;
+        stats_.bytes_offered += length;
+
+        // Bottleneck: serialise behind whatever is already queued
+        uint64_t depart_us = now_us;
+        if (profile_.bandwidth_bps != 0) {
+            const uint64_t start_us = link_free_at_us_ > now_us ? link_free_at_us_ : now_us;
+            const uint64_t backlog_bytes =
+                (start_us - now_us) * profile_.bandwidth_bps / 8000000ULL;
+            if (profile_.queue_bytes != 0 && backlog_bytes + length > profile_.queue_bytes) {
+                ++stats_.dropped_queue;
+                return;
+            }
+            depart_us = start_us + (static_cast<uint64_t>(length) * 8000000ULL) /
+                                       profile_.bandwidth_bps;
+            link_free_at_us_ = depart_us;
+        }
+
+        if (lost()) {
+            ++stats_.dropped_loss;
+            return;
+        }
+
+        enqueue(depart_us, data, length);
+        if (chance(profile_.duplicate_prob)) {
+            ++stats_.duplicated;
+            enqueue(depart_us, data, length);
+        }
+    }
+
+    void enqueue(uint64_t depart_us, const uint8_t* data, size_t length) noexcept
+    {
+        Segment* seg = nullptr;
+        for (auto& slot : slots_) {
+            if (!slot.used) {
+                seg = &slot;
+                break;
+            }
+        }
+        if (seg == nullptr) {
+            ++stats_.dropped_queue;
+            return;
+        }
+
+        uint64_t arrival_us = depart_us + profile_.latency_us + sample_jitter_us();
+        if (chance(profile_.reorder_prob)) {
+            ++stats_.reordered;
+            arrival_us += profile_.reorder_delay_us;
+        } else {
+            // Jitter alone never reorders: a path is FIFO unless told otherwise
+            arrival_us = arrival_us > last_arrival_us_ ? arrival_us : last_arrival_us_;
+            last_arrival_us_ = arrival_us;
+        }
+
+        std::memcpy(seg->data, data, length);
+        seg->length = static_cast<uint16_t>(length);
+        seg->consumed = 0;
+        seg->arrival_us = arrival_us;
+        seg->order = order_++;
+        seg->used = true;
+
+        if (chance(profile_.corrupt_prob)) {
+            ++stats_.corrupted;
+            const size_t bit = static_cast<size_t>(next_u64() % (length * 8U));
+            seg->data[bit / 8U] ^= static_cast<uint8_t>(1U << (bit % 8U));
+        }
+    }
+
+    /// Arrived segment with the earliest arrival (ties broken by send order).
+    Segment* next_ready(uint64_t now_us) noexcept
+    {
+        Segment* best = nullptr;
+        for (auto& slot : slots_) {
+            if (!slot.used || slot.arrival_us > now_us) {
+                continue;
+            }
+            if (slot.consumed > 0) {
+                best = &slot; // a partially read stream segment stays at the head
+                break;
+            }
+            if (best == nullptr || slot.arrival_us < best->arrival_us ||
+                (slot.arrival_us == best->arrival_us && slot.order < best->order)) {
+                best = &slot;
+            }
+        }
+        return best;
+    }
+
+    void release(Segment& seg) noexcept
+    {
+        seg.used = false;
+        ++stats_.segments_delivered;
+        stats_.bytes_delivered += seg.length;
+    }
+
+    LinkProfile profile_{};
+    uint64_t rng_{0};
+    bool bad_state_{false};
+    uint64_t link_free_at_us_{0};
+    uint64_t last_arrival_us_{0};
+    uint32_t order_{0};
+    Segment slots_[NET_SIM_MAX_SEGMENTS]{};
+    NetLinkStats stats_{};
+};
+
+// ============================================================================
+// ENDPOINT
+// ============================================================================
+
+/// IPlatformComm face of one side of the emulated path.
+class NetEndpoint final : public IPlatformComm
+{
+public:
+    NetEndpoint(IPlatformTime& time, NetLink& tx, NetLink& rx) noexcept
+        : time_(time), tx_(tx), rx_(rx)
+    {}
+
+    core::Result<void> init() noexcept override
+    {
+        initialized_ = true;
+        return core::Result<void>{};
+    }
+
+    core::Result<void> shutdown() noexcept override
+    {
+        initialized_ = false;
+        return core::Result<void>{};
+    }
+
+    core::Result<size_t> send(const uint8_t* data, size_t length) noexcept override
+    {
+        if (GS_UNLIKELY(!initialized_ || !connected_)) {
+            return core::Result<size_t>(GS_MAKE_ERROR(core::ErrorCode::NetworkDisconnected));
+        }
+        if (GS_UNLIKELY(data == nullptr || length == 0)) {
+            return core::Result<size_t>(GS_MAKE_ERROR(core::ErrorCode::InvalidParameter));
+        }
+        tx_.transmit(time_.get_timestamp_us(), data, length);
+        return core::Result<size_t>(length);
+    }
+
+    /**
+     * @brief Wait (on the platform clock) up to @p timeout_ms for bytes.
+     *
+     * Sleeps straight to the next arrival, so on SimClock a wait costs no
+     * wall time and lands on millisecond boundaries.
+     */
+    core::Result<size_t>
+    receive(uint8_t* buffer, size_t max_length, uint32_t timeout_ms) noexcept override
+    {
+        if (GS_UNLIKELY(!initialized_ || !connected_)) {
+            return core::Result<size_t>(GS_MAKE_ERROR(core::ErrorCode::NetworkDisconnected));
+        }
+        if (GS_UNLIKELY(buffer == nullptr || max_length == 0)) {
+            return core::Result<size_t>(GS_MAKE_ERROR(core::ErrorCode::InvalidParameter));
+        }
+
+        const uint64_t deadline_us =
+            time_.get_timestamp_us() + static_cast<uint64_t>(timeout_ms) * 1000U;
+        for (;;) {
+            const uint64_t now_us = time_.get_timestamp_us();
+            if (rx_.has_deliverable(now_us)) {
+                return core::Result<size_t>(rx_.deliver(now_us, buffer, max_length));
+            }
+            if (now_us >= deadline_us) {
+                return core::Result<size_t>(GS_MAKE_ERROR(core::ErrorCode::NetworkTimeout));
+            }
+            const uint64_t next_us = rx_.next_arrival_us();
+            const uint64_t wake_us = next_us < deadline_us ? next_us : deadline_us;
+            const uint64_t wait_ms = (wake_us - now_us + 999U) / 1000U;
+            time_.delay_ms(static_cast<uint32_t>(wait_ms));
+        }
+    }
+
+    bool is_connected() noexcept override
+    {
+        return connected_;
+    }
+
+    /// Simulate an outage: send/receive fail with NetworkDisconnected.
+    void set_connected(bool state) noexcept
+    {
+        connected_ = state;
+    }
+
+private:
+    IPlatformTime& time_;
+    NetLink& tx_;
+    NetLink& rx_;
+    bool initialized_{false};
+    bool connected_{true};
+};
+
+// ============================================================================
+// EMULATOR
+// ============================================================================
+
+/**
+ * @brief Point-to-point path: endpoint a() sends over link a→b, b() over b→a.
+ *
+ * Roughly 200 KB of segment slots: give it static storage and reuse it
+ * through configure() rather than constructing one per scenario.
+ */
+class NetEmulator
+{
+public:
+    NetEmulator(IPlatformTime& time,
+                const LinkProfile& a_to_b,
+                const LinkProfile& b_to_a,
+                uint64_t seed) noexcept
+        : link_ab_(a_to_b, seed), link_ba_(b_to_a, seed + 1), a_(time, link_ab_, link_ba_),
+          b_(time, link_ba_, link_ab_)
+    {}
+
+    NetEmulator(IPlatformTime& time, const LinkProfile& symmetric, uint64_t seed) noexcept
+        : NetEmulator(time, symmetric, symmetric, seed)
+    {}
+
+    NetEmulator(const NetEmulator&) = delete;
+    NetEmulator& operator=(const NetEmulator&) = delete;
+
+    /// Re-seed and re-profile both links, dropping everything in flight.
+    void configure(const LinkProfile& a_to_b, const LinkProfile& b_to_a, uint64_t seed) noexcept
+    {
+        link_ab_.configure(a_to_b, seed);
+        link_ba_.configure(b_to_a, seed + 1);
+        a_.set_connected(true);
+        b_.set_connected(true);
+    }
+
+    NetEndpoint& a() noexcept
+    {
+        return a_;
+    }
+    NetEndpoint& b() noexcept
+    {
+        return b_;
+    }
+
+    GS_NODISCARD const NetLinkStats& a_to_b_stats() const noexcept
+    {
+        return link_ab_.stats();
+    }
+    GS_NODISCARD const NetLinkStats& b_to_a_stats() const noexcept
+    {
+        return link_ba_.stats();
+    }
+
+private:
+    NetLink link_ab_;
+    NetLink link_ba_;
+    NetEndpoint a_;
+    NetEndpoint b_;
+};
+
+} // namespace gridshield::platform::sim
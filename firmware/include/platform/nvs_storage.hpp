@@ -0,0 +1,367 @@
+/**
+ * @file nvs_storage.hpp
+ * @author zuudevs (zuudevs@gmail.com)
+ * @brief Key/value (NVS) storage with a persistent handle and batched commits
+ * @version 1.0
+ * @date 2026-03-15
+ *
+ * Maps IPlatformStorage onto a key/value store, one blob per address
+ * ("blk_%04X"). The namespace handle is opened once in init() and kept for
+ * the object's lifetime.
+ *
+ * Outside a batch every write is set + commit, as before. Inside
+ * begin_batch()/commit() writes are staged in RAM and a key rewritten
+ * within the batch reaches flash once. Staged blobs are written in the
+ * order of each key's last write, so "payload, then header" commit points
+ * keep their ordering. Durability stays bounded: the stage is drained
+ * when it fills, on flush(), and once the oldest staged write is older
+ * than the commit deadline (checked on every write and by poll()).
+ *
+ * Backend contract (see Esp32NvsBackend in esp32_platform.hpp):
+ *   open(), close(), get_blob(key, buf, len) -> size (0 = not found),
+ *   set_blob(key, data, len), erase_key(key), commit(), now_ms()
+ *
+ * @copyright Copyright (c) 2026
+ */
+
+#pragma once
+
+#include "platform/platform.hpp"
+#include "utils/gs_macros.hpp"
+
+#include <cstdio>
+#include <cstring>
+
+namespace gridshield::platform {
+
+struct NvsStorageStats
+{
+    uint32_t writes{0};          // write() calls
+    uint32_t blob_sets{0};       // set_blob() reaching the backend
+    uint32_t commits{0};         // backend commits
+    uint32_t coalesced{0};       // staged writes superseded before reaching flash
+    uint32_t deadline_drains{0}; // batches drained by the commit deadline
+    uint32_t capacity_drains{0}; // batches drained because the stage filled
+    uint32_t entries_written{0}; // estimated 32-byte NVS entries programmed
+};
+
+/// NVS v2 blob: index entry + data-chunk header + ceil(len / 32) data entries.
+GS_NODISCARD constexpr uint32_t nvs_blob_entries(size_t length) noexcept
+{
+    return 2U + static_cast<uint32_t>((length + 31U) / 32U);
+}
+
+/// Entries per 4 KB NVS page; each page's worth of entries costs one erase.
+static constexpr uint32_t NVS_ENTRIES_PER_PAGE = 126;
+
+template <typename Backend, size_t StageBytes = 1024, size_t StageSlots = 8>
+class BatchedNvsStorage final : public IPlatformStorage
+{
+    static_assert(StageSlots > 0 && StageBytes > 0, "stage must hold at least one write");
+    static_assert(StageBytes <= UINT16_MAX, "stage offsets are 16-bit");
+
+public:
+    static constexpr size_t MAX_BLOB_SIZE = 4096;
+    static constexpr uint32_t DEFAULT_COMMIT_DEADLINE_MS = 1000;
+
+    BatchedNvsStorage() noexcept = default;
+
+    ~BatchedNvsStorage() noexcept override
+    {
+        (void)flush();
+        backend_.close();
+    }
+
+    BatchedNvsStorage(const BatchedNvsStorage&) = delete;
+    BatchedNvsStorage& operator=(const BatchedNvsStorage&) = delete;
+
+    /**
+     * @brief Initialize the store and open the namespace handle. Must be
+     * called once before use.
+     */
+    core::Result<void> init() noexcept
+    {
+        GS_TRY(backend_.open());
+        initialized_ = true;
+        return core::Result<void>{};
+    }
+
+    core::Result<size_t> read(uint32_t address, uint8_t* buffer, size_t length) noexcept override
+    {
+        if (GS_UNLIKELY(buffer == nullptr || length == 0)) {
+            return core::Result<size_t>(GS_MAKE_ERROR(core::ErrorCode::InvalidParameter));
+        }
+
+        // Read-your-writes: staged data wins over flash
+        const Slot* slot = find_slot(address);
+        if (slot != nullptr) {
+            if (GS_UNLIKELY(slot->length > length)) {
+                return core::Result<size_t>(GS_MAKE_ERROR(core::ErrorCode::HardwareFailure));
+            }
+            std::memcpy(buffer, stage_ + slot->offset, slot->length);
+            return core::Result<size_t>(slot->length);
+        }
+
+        size_t got = 0;
+        if (initialized_) {
+            char key[KEY_SIZE];
+            make_key(address, key);
+            auto res = backend_.get_blob(key, buffer, length);
+            if (res.is_error()) {
+                return res;
+            }
+            got = res.value();
+        }
+        if (got == 0) {
+            // Key doesn't exist — simulate empty flash (0xFF)
+            std::memset(buffer, 0xFF, length);
+            return core::Result<size_t>(length);
+        }
+        return core::Result<size_t>(got);
+    }
+
+    core::Result<size_t>
+    write(uint32_t address, const uint8_t* data, size_t length) noexcept override
+    {
+        if (GS_UNLIKELY(data == nullptr || length == 0)) {
+            return core::Result<size_t>(GS_MAKE_ERROR(core::ErrorCode::InvalidParameter));
+        }
+        if (length > MAX_BLOB_SIZE) {
+            return core::Result<size_t>(GS_MAKE_ERROR(core::ErrorCode::BufferOverflow));
+        }
+        if (GS_UNLIKELY(!initialized_)) {
+            return core::Result<size_t>(GS_MAKE_ERROR(core::ErrorCode::SystemNotInitialized));
+        }
+        ++stats_.writes;
+
+        if (batch_depth_ == 0 || length > StageBytes) {
+            // Unbatched (or unstageable): write through in order after staged data
+            GS_TRY(drain());
+            GS_TRY(set_blob(address, data, length));
+            if (batch_depth_ == 0) {
+                GS_TRY(backend_commit());
+            }
+            return core::Result<size_t>(length);
+        }
+
+        GS_TRY(stage(address, data, length));
+        GS_TRY(poll());
+        return core::Result<size_t>(length);
+    }
+
+    core::Result<void> erase(uint32_t address, size_t length) noexcept override
+    {
+        (void)length; // NVS erases by key, not by range
+        if (GS_UNLIKELY(!initialized_)) {
+            return GS_MAKE_ERROR(core::ErrorCode::SystemNotInitialized);
+        }
+
+        // Keep ordering: anything staged before the erase lands first
+        GS_TRY(drain());
+        char key[KEY_SIZE];
+        make_key(address, key);
+        GS_TRY(backend_.erase_key(key));
+        return batch_depth_ == 0 ? backend_commit() : core::Result<void>{};
+    }
+
+    /// Drain staged writes and commit, without closing an open batch.
+    core::Result<void> flush() noexcept override
+    {
+        if (!initialized_) {
+            return core::Result<void>{};
+        }
+        const bool pending = slot_count_ > 0 || uncommitted_;
+        GS_TRY(drain());
+        return pending ? backend_commit() : core::Result<void>{};
+    }
+
+    core::Result<void> begin_batch() noexcept override
+    {
+        if (GS_UNLIKELY(!initialized_)) {
+            return GS_MAKE_ERROR(core::ErrorCode::SystemNotInitialized);
+        }
+        ++batch_depth_;
+        return core::Result<void>{};
+    }
+
+    /// End the innermost batch; the outermost commit() persists everything.
+    core::Result<void> commit() noexcept override
+    {
+        if (GS_UNLIKELY(batch_depth_ == 0)) {
+            return GS_MAKE_ERROR(core::ErrorCode::InvalidState);
+        }
+        --batch_depth_;
+        return batch_depth_ == 0 ? flush() : core::Result<void>{};
+    }
+
+    /// Enforce the commit deadline; call from the main loop while a batch
+    /// may stay open across cycles.
+    core::Result<void> poll() noexcept
+    {
+        if (slot_count_ == 0 && !uncommitted_) {
+            return core::Result<void>{};
+        }
+        if (backend_.now_ms() - oldest_ms_ < commit_deadline_ms_) {
+            return core::Result<void>{};
+        }
+        ++stats_.deadline_drains;
+        return flush();
+    }
+
+    /// Upper bound on how long a staged write may wait for flash.
+    void set_commit_deadline_ms(uint32_t deadline_ms) noexcept
+    {
+        commit_deadline_ms_ = deadline_ms;
+    }
+
+    GS_NODISCARD bool in_batch() const noexcept
+    {
+        return batch_depth_ > 0;
+    }
+
+    GS_NODISCARD size_t staged_writes() const noexcept
+    {
+        return slot_count_;
+    }
+
+    GS_NODISCARD const NvsStorageStats& stats() const noexcept
+    {
+        return stats_;
+    }
+
+    void reset_stats() noexcept
+    {
+        stats_ = NvsStorageStats{};
+    }
+
+    GS_NODISCARD Backend& backend() noexcept
+    {
+        return backend_;
+    }
+
+private:
+    static constexpr size_t KEY_SIZE = 16;
+
+    struct Slot
+    {
+        uint32_t address{0};
+        uint16_t offset{0};
+        uint16_t length{0};
+    };
+
+    static void make_key(uint32_t address, char (&key)[KEY_SIZE]) noexcept
+    {
+        // Use address as key name: "blk_0000", "blk_0001", etc.
+        std::snprintf(key, sizeof(key), "blk_%04X", static_cast<unsigned>(address));
+    }
+
+    const Slot* find_slot(uint32_t address) const noexcept
+    {
+        for (size_t i = slot_count_; i > 0; --i) {
+            if (slots_[i - 1].address == address) {
+                return &slots_[i - 1];
+            }
+        }
+        return nullptr;
+    }
+
+    core::Result<void> stage(uint32_t address, const uint8_t* data, size_t length) noexcept
+    {
+        // Rewrite of the newest staged key with the same size: in place
+        if (slot_count_ > 0) {
+            Slot& last = slots_[slot_count_ - 1];
+            if (last.address == address && last.length == length) {
+                std::memcpy(stage_ + last.offset, data, length);
+                ++stats_.coalesced;
+                return core::Result<void>{};
+            }
+        }
+
+        // Older staged copy: drop it so the key moves to its new position
+        for (size_t i = 0; i < slot_count_; ++i) {
+            if (slots_[i].address == address) {
+                remove_slot(i);
+                ++stats_.coalesced;
+                break;
+            }
+        }
+
+        if (slot_count_ == StageSlots || stage_used_ + length > StageBytes) {
+            ++stats_.capacity_drains;
+            GS_TRY(drain());
+        }
+        if (slot_count_ == 0 && !uncommitted_) {
+            oldest_ms_ = backend_.now_ms();
+        }
+
+        Slot& slot = slots_[slot_count_++];
+        slot.address = address;
+        slot.offset = static_cast<uint16_t>(stage_used_);
+        slot.length = static_cast<uint16_t>(length);
+        std::memcpy(stage_ + stage_used_, data, length);
+        stage_used_ += length;
+        return core::Result<void>{};
+    }
+
+    /// Remove slot @p index and compact the arena behind it.
+    void remove_slot(size_t index) noexcept
+    {
+        const Slot removed = slots_[index];
+        const size_t tail = stage_used_ - (removed.offset + removed.length);
+        std::memmove(stage_ + removed.offset, stage_ + removed.offset + removed.length, tail);
+        stage_used_ -= removed.length;
+        for (size_t i = index; i + 1 < slot_count_; ++i) {
+            slots_[i] = slots_[i + 1];
+            slots_[i].offset = static_cast<uint16_t>(slots_[i].offset - removed.length);
+        }
+        --slot_count_;
+    }
+
+    /// Hand staged blobs to the backend in order. Not committed yet.
+    core::Result<void> drain() noexcept
+    {
+        for (size_t i = 0; i < slot_count_; ++i) {
+            const Slot& slot = slots_[i];
+            GS_TRY(set_blob(slot.address, stage_ + slot.offset, slot.length));
+        }
+        slot_count_ = 0;
+        stage_used_ = 0;
+        return core::Result<void>{};
+    }
+
+    core::Result<void> set_blob(uint32_t address, const uint8_t* data, size_t length) noexcept
+    {
+        char key[KEY_SIZE];
+        make_key(address, key);
+        GS_TRY(backend_.set_blob(key, data, length));
+        if (!uncommitted_ && slot_count_ == 0) {
+            oldest_ms_ = backend_.now_ms();
+        }
+        uncommitted_ = true;
+        ++stats_.blob_sets;
+        stats_.entries_written += nvs_blob_entries(length);
+        return core::Result<void>{};
+    }
+
+    core::Result<void> backend_commit() noexcept
+    {
+        GS_TRY(backend_.commit());
+        uncommitted_ = false;
+        ++stats_.commits;
+        return core::Result<void>{};
+    }
+
+    Backend backend_{};
+    bool initialized_{false};
+    bool uncommitted_{false};
+    uint32_t batch_depth_{0};
+    uint32_t commit_deadline_ms_{DEFAULT_COMMIT_DEADLINE_MS};
+    uint64_t oldest_ms_{0};
+    size_t slot_count_{0};
+    size_t stage_used_{0};
+    NvsStorageStats stats_{};
+    Slot slots_[StageSlots]{};
+    uint8_t stage_[StageBytes]{};
+};
+
+} // namespace gridshield::platform
@@ -24,6 +24,7 @@ namespace gridshield::platform {
 static constexpr size_t MAX_SSID_LENGTH = 32;
 static constexpr size_t MAX_PASSWORD_LENGTH = 64;
 static constexpr size_t MAX_IP_STRING_LENGTH = 16;
+static constexpr size_t WIFI_BSSID_LENGTH = 6;
 static constexpr size_t MAX_ADC_CHANNELS = 8;
 static constexpr size_t MAX_UART_PORTS = 3;
 
@@ -37,6 +38,12 @@ public:
 
     virtual core::timestamp_t get_timestamp_ms() noexcept = 0;
     virtual void delay_ms(uint32_t milliseconds) noexcept = 0;
+
+    /// Microsecond clock for latency budgets. Defaults to ms resolution.
+    virtual uint64_t get_timestamp_us() noexcept
+    {
+        return static_cast<uint64_t>(get_timestamp_ms()) * 1000U;
+    }
 };
 
 // ============================================================================
@@ -118,6 +125,24 @@ public:
     virtual core::Result<size_t>
     write(uint32_t address, const uint8_t* data, size_t length) noexcept = 0;
     virtual core::Result<void> erase(uint32_t address, size_t length) noexcept = 0;
+
+    /// Persist any buffered writes. Write-through backends need not override.
+    virtual core::Result<void> flush() noexcept
+    {
+        return core::Result<void>{};
+    }
+
+    /// Open a write batch: backends may coalesce writes until the matching
+    /// commit(). Batches nest; only the outermost commit() persists.
+    virtual core::Result<void> begin_batch() noexcept
+    {
+        return core::Result<void>{};
+    }
+
+    virtual core::Result<void> commit() noexcept
+    {
+        return flush();
+    }
 };
 
 // ============================================================================
@@ -139,6 +164,49 @@ public:
 // ============================================================================
 // WIFI INTERFACE
 // ============================================================================
+
+/// IPv4 settings (host byte order, a.b.c.d = a << 24 | ...).
+struct WiFiIpConfig
+{
+    uint32_t address{}; // 0 = none / use DHCP
+    uint32_t gateway{};
+    uint32_t netmask{};
+    uint32_t dns{};
+
+    GS_NODISCARD GS_CONSTEXPR bool is_set() const noexcept
+    {
+        return address != 0;
+    }
+};
+
+/// What the caller already knows about the network: a BSSID and channel
+/// skip the scan, a static address skips DHCP.
+struct WiFiConnectHint
+{
+    std::array<uint8_t, WIFI_BSSID_LENGTH> bssid{};
+    uint8_t channel{0}; // 0 = scan all channels, BSSID ignored
+    WiFiIpConfig static_ip{};
+};
+
+/// Association and address of the current connection.
+struct WiFiLinkInfo
+{
+    std::array<uint8_t, WIFI_BSSID_LENGTH> bssid{};
+    uint8_t channel{};
+    int8_t rssi_dbm{};
+    uint8_t dtim_period{1};
+    uint16_t beacon_interval_tu{100}; // 1 TU = 1024 us
+    WiFiIpConfig ip{};
+    uint32_t lease_s{}; // DHCP lease time; 0 = static or unknown
+};
+
+enum class WiFiPowerSave : uint8_t
+{
+    None = 0,     // radio always on
+    MinModem = 1, // sleep between DTIM beacons
+    MaxModem = 2  // sleep for listen_interval beacons
+};
+
 class IPlatformWiFi
 {
 public:
@@ -149,6 +217,27 @@ public:
     virtual core::Result<void> disconnect() noexcept = 0;
     virtual bool is_connected() noexcept = 0;
     virtual core::Result<void> get_ip(char* buf, size_t len) noexcept = 0;
+
+    /// Connect using what @p hint already knows. Default: full connect.
+    /// Fails with NetworkTimeout when associated but no address was obtained.
+    virtual core::Result<void> connect_with_hint(const char* ssid,
+                                                 const char* password,
+                                                 const WiFiConnectHint& /*hint*/) noexcept
+    {
+        return connect(ssid, password);
+    }
+
+    virtual core::Result<WiFiLinkInfo> get_link_info() noexcept
+    {
+        return core::Result<WiFiLinkInfo>(GS_MAKE_ERROR(core::ErrorCode::NotSupported));
+    }
+
+    /// @p listen_interval (beacons) applies to MaxModem only.
+    virtual core::Result<void> set_power_save(WiFiPowerSave /*mode*/,
+                                              uint8_t /*listen_interval*/) noexcept
+    {
+        return GS_MAKE_ERROR(core::ErrorCode::NotSupported);
+    }
 };
 
 // ============================================================================
@@ -0,0 +1,1186 @@
+/**
+ * @file posix_platform.hpp
+ * @author zuudevs (zuudevs@gmail.com)
+ * @brief Native POSIX backend: the full firmware stack as a Linux process
+ * @version 1.0
+ * @date 2026-03-14
+ *
+ * Real host services behind the HAL interfaces, for soak tests, profiling
+ * under perf, and gateway duty:
+ *   - PosixTime      : CLOCK_MONOTONIC, drift-free absolute sleeps
+ *   - PosixUdpComm   : non-blocking UDP socket, poll()-bounded receive
+ *   - PosixTcpComm   : non-blocking TCP client or single-peer listener
+ *   - storage        : native::MmapFlashStorage (NOR semantics over a file)
+ *   - crypto         : native::NativeCrypto (getrandom RNG, CRC32, SHA-256)
+ *   - ReplayADC/I2C/UART : peripherals fed from timestamped capture files
+ *
+ * Replay files are text, one record per line, fields separated by spaces
+ * or commas, numbers in decimal or 0x-hex, '#' starts a comment:
+ *   ADC  : <t_ms> <raw_ch0> [<raw_ch1> ...]         sample-and-hold per channel
+ *   I2C  : <t_ms> <dev_addr> <reg> <byte> [...]     loads a device register bank
+ *   UART : <t_ms> <port> <byte> [...]               bytes arrive on the RX line
+ * t_ms is relative to open(); a record takes effect once the platform clock
+ * passes it. With loop enabled the file restarts after its last record.
+ *
+ * @note Native builds only. No heap: every buffer is a fixed-size member.
+ * @copyright Copyright (c) 2026
+ */
+
+#pragma once
+
+#include "platform/mmap_flash.hpp"
+#include "platform/mock_platform.hpp"
+#include "platform/native_crypto.hpp"
+#include "platform/platform.hpp"
+#include "utils/gs_macros.hpp"
+
+#if GS_PLATFORM_NATIVE
+
+#include <arpa/inet.h>
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+namespace gridshield::platform::posix {
+
+// ============================================================================
+// TIME
+// ============================================================================
+class PosixTime final : public IPlatformTime
+{
+public:
+    PosixTime() noexcept : epoch_ns_(monotonic_ns()) {}
+
+    core::timestamp_t get_timestamp_ms() noexcept override
+    {
+        return static_cast<core::timestamp_t>((monotonic_ns() - epoch_ns_) / 1000000U);
+    }
+
+    uint64_t get_timestamp_us() noexcept override
+    {
+        return (monotonic_ns() - epoch_ns_) / 1000U;
+    }
+
+    void delay_ms(uint32_t milliseconds) noexcept override
+    {
+        timespec request{};
+        request.tv_sec = static_cast<time_t>(milliseconds / 1000U);
+        request.tv_nsec = static_cast<long>((milliseconds % 1000U) * 1000000L);
+        timespec remaining{};
+        while (::nanosleep(&request, &remaining) != 0 && errno == EINTR) {
+            request = remaining;
+        }
+    }
+
+    /// Sleep until @p deadline_us on this clock. Periodic loops built on
+    /// absolute deadlines do not accumulate the jitter of relative sleeps.
+    void sleep_until_us(uint64_t deadline_us) noexcept
+    {
+        const uint64_t target_ns = epoch_ns_ + deadline_us * 1000U;
+        timespec deadline{};
+        deadline.tv_sec = static_cast<time_t>(target_ns / 1000000000U);
+        deadline.tv_nsec = static_cast<long>(target_ns % 1000000000U);
+        while (::clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &deadline, nullptr) == EINTR) {
+        }
+    }
+
+    /// Wall-clock milliseconds since the Unix epoch (for logs, not intervals).
+    static uint64_t unix_time_ms() noexcept
+    {
+        timespec now{};
+        ::clock_gettime(CLOCK_REALTIME, &now);
+        return static_cast<uint64_t>(now.tv_sec) * 1000U +
+               static_cast<uint64_t>(now.tv_nsec) / 1000000U;
+    }
+
+private:
+    static uint64_t monotonic_ns() noexcept
+    {
+        timespec now{};
+        ::clock_gettime(CLOCK_MONOTONIC, &now);
+        return static_cast<uint64_t>(now.tv_sec) * 1000000000U + static_cast<uint64_t>(now.tv_nsec);
+    }
+
+    uint64_t epoch_ns_;
+};
+
+// ============================================================================
+// SOCKET HELPERS
+// ============================================================================
+namespace detail {
+
+/// IPv4 dotted-quad only; name resolution is left to the caller.
+inline bool make_ipv4(const char* host, uint16_t port, sockaddr_in& out) noexcept
+{
+    std::memset(&out, 0, sizeof(out));
+    out.sin_family = AF_INET;
+    out.sin_port = htons(port);
+    return host != nullptr && ::inet_pton(AF_INET, host, &out.sin_addr) == 1;
+}
+
+inline bool set_nonblocking(int fd) noexcept
+{
+    const int flags = ::fcntl(fd, F_GETFL, 0);
+    return flags >= 0 && ::fcntl(fd, F_SETFL, flags | O_NONBLOCK) == 0;
+}
+
+/// @return >0 ready, 0 timed out, <0 error or hang-up without @p events
+inline int wait_fd(int fd, short events, uint32_t timeout_ms) noexcept
+{
+    pollfd pfd{};
+    pfd.fd = fd;
+    pfd.events = events;
+    int ready = 0;
+    do {
+        ready = ::poll(&pfd, 1, static_cast<int>(timeout_ms));
+    } while (ready < 0 && errno == EINTR);
+    if (ready > 0 && (pfd.revents & events) == 0) {
+        return -1;
+    }
+    return ready;
+}
+
+inline uint16_t local_port(int fd) noexcept
+{
+    sockaddr_in addr{};
+    socklen_t len = sizeof(addr);
+    if (fd < 0 || ::getsockname(fd, reinterpret_cast<sockaddr*>(&addr), &len) != 0) {
+        return 0;
+    }
+    return ntohs(addr.sin_port);
+}
+
+} // namespace detail
+
+// ============================================================================
+// UDP TRANSPORT
+// ============================================================================
+struct UdpConfig
+{
+    const char* bind_host{"0.0.0.0"};
+    uint16_t bind_port{0};            // 0 = ephemeral
+    const char* peer_host{"127.0.0.1"};
+    uint16_t peer_port{0};            // 0 = reply to the last sender
+};
+
+/**
+ * @brief One datagram per send(); receive() returns at most one datagram.
+ *
+ * With no fixed peer the socket answers whoever sent last, which is what a
+ * gateway collecting meters on a well-known port needs.
+ */
+class PosixUdpComm final : public IPlatformComm
+{
+public:
+    explicit PosixUdpComm(const UdpConfig& config = UdpConfig{}) noexcept : config_(config) {}
+
+    ~PosixUdpComm() noexcept override
+    {
+        (void)shutdown();
+    }
+
+    PosixUdpComm(const PosixUdpComm&) = delete;
+    PosixUdpComm& operator=(const PosixUdpComm&) = delete;
+
+    /// Takes effect on the next init().
+    void configure(const UdpConfig& config) noexcept
+    {
+        config_ = config;
+    }
+
+    core::Result<void> init() noexcept override
+    {
+        if (fd_ >= 0) {
+            return core::Result<void>{};
+        }
+        sockaddr_in local{};
+        if (GS_UNLIKELY(!detail::make_ipv4(config_.bind_host, config_.bind_port, local))) {
+            return GS_MAKE_ERROR(core::ErrorCode::InvalidParameter);
+        }
+        has_peer_ = false;
+        if (config_.peer_port != 0) {
+            if (GS_UNLIKELY(!detail::make_ipv4(config_.peer_host, config_.peer_port, peer_))) {
+                return GS_MAKE_ERROR(core::ErrorCode::InvalidParameter);
+            }
+            has_peer_ = true;
+        }
+
+        fd_ = ::socket(AF_INET, SOCK_DGRAM | SOCK_CLOEXEC, 0);
+        if (fd_ < 0) {
+            return GS_MAKE_ERROR(core::ErrorCode::HardwareFailure);
+        }
+        const int reuse = 1;
+        (void)::setsockopt(fd_, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+        if (!detail::set_nonblocking(fd_) ||
+            ::bind(fd_, reinterpret_cast<const sockaddr*>(&local), sizeof(local)) != 0) {
+            (void)shutdown();
+            return GS_MAKE_ERROR(core::ErrorCode::HardwareFailure);
+        }
+        return core::Result<void>{};
+    }
+
+    core::Result<void> shutdown() noexcept override
+    {
+        if (fd_ >= 0) {
+            ::close(fd_);
+            fd_ = -1;
+        }
+        return core::Result<void>{};
+    }
+
+    core::Result<size_t> send(const uint8_t* data, size_t length) noexcept override
+    {
+        if (GS_UNLIKELY(fd_ < 0)) {
+            return core::Result<size_t>(GS_MAKE_ERROR(core::ErrorCode::NetworkDisconnected));
+        }
+        if (GS_UNLIKELY(data == nullptr || length == 0)) {
+            return core::Result<size_t>(GS_MAKE_ERROR(core::ErrorCode::InvalidParameter));
+        }
+        if (GS_UNLIKELY(!has_peer_)) {
+            return core::Result<size_t>(GS_MAKE_ERROR(core::ErrorCode::InvalidState));
+        }
+
+        ssize_t sent = -1;
+        do {
+            sent = ::sendto(fd_, data, length, MSG_NOSIGNAL,
+                            reinterpret_cast<const sockaddr*>(&peer_), sizeof(peer_));
+        } while (sent < 0 && errno == EINTR);
+        if (sent < 0) {
+            // EAGAIN included: a datagram is never partially queued
+            return core::Result<size_t>(GS_MAKE_ERROR(core::ErrorCode::TransmissionFailed));
+        }
+        return core::Result<size_t>(static_cast<size_t>(sent));
+    }
+
+    core::Result<size_t>
+    receive(uint8_t* buffer, size_t max_length, uint32_t timeout_ms) noexcept override
+    {
+        if (GS_UNLIKELY(fd_ < 0)) {
+            return core::Result<size_t>(GS_MAKE_ERROR(core::ErrorCode::NetworkDisconnected));
+        }
+        if (GS_UNLIKELY(buffer == nullptr || max_length == 0)) {
+            return core::Result<size_t>(GS_MAKE_ERROR(core::ErrorCode::InvalidParameter));
+        }
+
+        const int ready = detail::wait_fd(fd_, POLLIN, timeout_ms);
+        if (ready == 0) {
+            return core::Result<size_t>(GS_MAKE_ERROR(core::ErrorCode::NetworkTimeout));
+        }
+        if (ready < 0) {
+            return core::Result<size_t>(GS_MAKE_ERROR(core::ErrorCode::NetworkDisconnected));
+        }
+
+        sockaddr_in from{};
+        socklen_t from_len = sizeof(from);
+        const ssize_t got = ::recvfrom(
+            fd_, buffer, max_length, 0, reinterpret_cast<sockaddr*>(&from), &from_len);
+        if (got < 0) {
+            return core::Result<size_t>(GS_MAKE_ERROR(
+                errno == EAGAIN ? core::ErrorCode::NetworkTimeout : core::ErrorCode::TransmissionFailed));
+        }
+        if (config_.peer_port == 0) {
+            peer_ = from;
+            has_peer_ = true;
+        }
+        return core::Result<size_t>(static_cast<size_t>(got));
+    }
+
+    bool is_connected() noexcept override
+    {
+        return fd_ >= 0;
+    }
+
+    /// Bound port, useful after binding to port 0.
+    GS_NODISCARD uint16_t local_port() const noexcept
+    {
+        return detail::local_port(fd_);
+    }
+
+private:
+    UdpConfig config_;
+    int fd_{-1};
+    sockaddr_in peer_{};
+    bool has_peer_{false};
+};
+
+// ============================================================================
+// TCP TRANSPORT
+// ============================================================================
+struct TcpConfig
+{
+    enum class Role : uint8_t
+    {
+        Client = 0, // connect to host:port
+        Server = 1  // listen on host:port, serve one peer at a time
+    };
+
+    Role role{Role::Client};
+    const char* host{"127.0.0.1"};
+    uint16_t port{0};
+    uint32_t connect_timeout_ms{3000};
+    uint32_t send_timeout_ms{1000}; // bound on draining a full socket buffer
+};
+
+/**
+ * @brief Byte-stream transport. PacketTransport reassembles frames, so
+ * receive() simply returns whatever bytes have arrived.
+ *
+ * Servers accept lazily: the first send()/receive() after a peer connects
+ * picks it up, and a peer hang-up returns the server to accepting.
+ */
+class PosixTcpComm final : public IPlatformComm
+{
+public:
+    explicit PosixTcpComm(const TcpConfig& config = TcpConfig{}) noexcept : config_(config) {}
+
+    ~PosixTcpComm() noexcept override
+    {
+        (void)shutdown();
+    }
+
+    PosixTcpComm(const PosixTcpComm&) = delete;
+    PosixTcpComm& operator=(const PosixTcpComm&) = delete;
+
+    /// Takes effect on the next init().
+    void configure(const TcpConfig& config) noexcept
+    {
+        config_ = config;
+    }
+
+    core::Result<void> init() noexcept override
+    {
+        sockaddr_in addr{};
+        if (GS_UNLIKELY(!detail::make_ipv4(config_.host, config_.port, addr))) {
+            return GS_MAKE_ERROR(core::ErrorCode::InvalidParameter);
+        }
+        return config_.role == TcpConfig::Role::Server ? listen_on(addr) : connect_to(addr);
+    }
+
+    core::Result<void> shutdown() noexcept override
+    {
+        drop_peer();
+        if (listen_fd_ >= 0) {
+            ::close(listen_fd_);
+            listen_fd_ = -1;
+        }
+        return core::Result<void>{};
+    }
+
+    core::Result<size_t> send(const uint8_t* data, size_t length) noexcept override
+    {
+        if (GS_UNLIKELY(data == nullptr || length == 0)) {
+            return core::Result<size_t>(GS_MAKE_ERROR(core::ErrorCode::InvalidParameter));
+        }
+        if (GS_UNLIKELY(!has_peer(0))) {
+            return core::Result<size_t>(GS_MAKE_ERROR(core::ErrorCode::NetworkDisconnected));
+        }
+
+        size_t sent = 0;
+        while (sent < length) {
+            const ssize_t n = ::send(fd_, data + sent, length - sent, MSG_NOSIGNAL);
+            if (n > 0) {
+                sent += static_cast<size_t>(n);
+                continue;
+            }
+            if (n < 0 && errno == EINTR) {
+                continue;
+            }
+            if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK) &&
+                detail::wait_fd(fd_, POLLOUT, config_.send_timeout_ms) > 0) {
+                continue;
+            }
+            if (n < 0 && errno != EAGAIN && errno != EWOULDBLOCK) {
+                drop_peer();
+            }
+            break;
+        }
+        if (sent == 0) {
+            return core::Result<size_t>(GS_MAKE_ERROR(core::ErrorCode::TransmissionFailed));
+        }
+        return core::Result<size_t>(sent);
+    }
+
+    core::Result<size_t>
+    receive(uint8_t* buffer, size_t max_length, uint32_t timeout_ms) noexcept override
+    {
+        if (GS_UNLIKELY(buffer == nullptr || max_length == 0)) {
+            return core::Result<size_t>(GS_MAKE_ERROR(core::ErrorCode::InvalidParameter));
+        }
+        if (!has_peer(timeout_ms)) {
+            return core::Result<size_t>(GS_MAKE_ERROR(
+                listen_fd_ >= 0 ? core::ErrorCode::NetworkTimeout
+                                : core::ErrorCode::NetworkDisconnected));
+        }
+
+        const int ready = detail::wait_fd(fd_, POLLIN, timeout_ms);
+        if (ready == 0) {
+            return core::Result<size_t>(GS_MAKE_ERROR(core::ErrorCode::NetworkTimeout));
+        }
+
+        ssize_t got = -1;
+        do {
+            got = ::recv(fd_, buffer, max_length, 0);
+        } while (got < 0 && errno == EINTR);
+        if (got > 0) {
+            return core::Result<size_t>(static_cast<size_t>(got));
+        }
+        if (got < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+            return core::Result<size_t>(GS_MAKE_ERROR(core::ErrorCode::NetworkTimeout));
+        }
+        // Orderly close (0) or reset
+        drop_peer();
+        return core::Result<size_t>(GS_MAKE_ERROR(core::ErrorCode::NetworkDisconnected));
+    }
+
+    bool is_connected() noexcept override
+    {
+        return fd_ >= 0;
+    }
+
+    /// Listening (server) or local (client) port, useful after port 0.
+    GS_NODISCARD uint16_t local_port() const noexcept
+    {
+        return detail::local_port(listen_fd_ >= 0 ? listen_fd_ : fd_);
+    }
+
+private:
+    core::Result<void> connect_to(const sockaddr_in& addr) noexcept
+    {
+        drop_peer();
+        fd_ = ::socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+        if (fd_ < 0 || !detail::set_nonblocking(fd_)) {
+            drop_peer();
+            return GS_MAKE_ERROR(core::ErrorCode::HardwareFailure);
+        }
+
+        if (::connect(fd_, reinterpret_cast<const sockaddr*>(&addr), sizeof(addr)) != 0) {
+            if (errno != EINPROGRESS ||
+                detail::wait_fd(fd_, POLLOUT, config_.connect_timeout_ms) <= 0) {
+                drop_peer();
+                return GS_MAKE_ERROR(core::ErrorCode::NetworkTimeout);
+            }
+            int so_error = 0;
+            socklen_t len = sizeof(so_error);
+            if (::getsockopt(fd_, SOL_SOCKET, SO_ERROR, &so_error, &len) != 0 || so_error != 0) {
+                drop_peer();
+                return GS_MAKE_ERROR(core::ErrorCode::NetworkDisconnected);
+            }
+        }
+        tune_peer_socket();
+        return core::Result<void>{};
+    }
+
+    core::Result<void> listen_on(const sockaddr_in& addr) noexcept
+    {
+        (void)shutdown();
+        listen_fd_ = ::socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+        if (listen_fd_ < 0) {
+            return GS_MAKE_ERROR(core::ErrorCode::HardwareFailure);
+        }
+        const int reuse = 1;
+        (void)::setsockopt(listen_fd_, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+        if (!detail::set_nonblocking(listen_fd_) ||
+            ::bind(listen_fd_, reinterpret_cast<const sockaddr*>(&addr), sizeof(addr)) != 0 ||
+            ::listen(listen_fd_, 1) != 0) {
+            (void)shutdown();
+            return GS_MAKE_ERROR(core::ErrorCode::HardwareFailure);
+        }
+        return core::Result<void>{};
+    }
+
+    /// Ensure a connected peer, accepting one (waiting up to @p timeout_ms)
+    /// when listening.
+    bool has_peer(uint32_t timeout_ms) noexcept
+    {
+        if (fd_ >= 0) {
+            return true;
+        }
+        if (listen_fd_ < 0 || detail::wait_fd(listen_fd_, POLLIN, timeout_ms) <= 0) {
+            return false;
+        }
+        fd_ = ::accept4(listen_fd_, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (fd_ < 0) {
+            return false;
+        }
+        tune_peer_socket();
+        return true;
+    }
+
+    /// Frames are small and latency-bound: disable Nagle.
+    void tune_peer_socket() noexcept
+    {
+        const int nodelay = 1;
+        (void)::setsockopt(fd_, IPPROTO_TCP, TCP_NODELAY, &nodelay, sizeof(nodelay));
+    }
+
+    void drop_peer() noexcept
+    {
+        if (fd_ >= 0) {
+            ::close(fd_);
+            fd_ = -1;
+        }
+    }
+
+    TcpConfig config_;
+    int fd_{-1};
+    int listen_fd_{-1};
+};
+
+// ============================================================================
+// REPLAY FILES
+// ============================================================================
+namespace detail {
+
+/**
+ * @brief Streaming reader for timestamped capture files.
+ *
+ * Holds one look-ahead record, so memory use is independent of file length.
+ */
+class ReplayFile
+{
+public:
+    static constexpr size_t MAX_LINE = 512;
+    static constexpr size_t MAX_FIELDS = 64;
+
+    struct Record
+    {
+        uint64_t t_ms{0};
+        size_t count{0};
+        uint32_t fields[MAX_FIELDS]{};
+    };
+
+    ReplayFile() noexcept = default;
+    ~ReplayFile() noexcept
+    {
+        close();
+    }
+
+    ReplayFile(const ReplayFile&) = delete;
+    ReplayFile& operator=(const ReplayFile&) = delete;
+
+    bool open(const char* path, bool loop) noexcept
+    {
+        close();
+        file_ = (path != nullptr) ? std::fopen(path, "r") : nullptr;
+        loop_ = loop;
+        offset_ms_ = 0;
+        last_ms_ = 0;
+        has_pending_ = file_ != nullptr && fetch();
+        return file_ != nullptr;
+    }
+
+    void close() noexcept
+    {
+        if (file_ != nullptr) {
+            std::fclose(file_);
+            file_ = nullptr;
+        }
+        has_pending_ = false;
+    }
+
+    GS_NODISCARD bool is_open() const noexcept
+    {
+        return file_ != nullptr;
+    }
+
+    /// Move the next record due at or before @p elapsed_ms into @p out.
+    bool next_due(uint64_t elapsed_ms, Record& out) noexcept
+    {
+        if (!has_pending_ || pending_.t_ms > elapsed_ms) {
+            return false;
+        }
+        out = pending_;
+        has_pending_ = fetch();
+        return true;
+    }
+
+    /// Time of the next record, or UINT64_MAX once exhausted.
+    GS_NODISCARD uint64_t next_time_ms() const noexcept
+    {
+        return has_pending_ ? pending_.t_ms : UINT64_MAX;
+    }
+
+    GS_NODISCARD uint32_t malformed_lines() const noexcept
+    {
+        return malformed_;
+    }
+
+private:
+    bool fetch() noexcept
+    {
+        char line[MAX_LINE];
+        for (;;) {
+            if (std::fgets(line, sizeof(line), file_) == nullptr) {
+                if (!loop_ || !seen_record_) {
+                    return false;
+                }
+                // Next pass starts one millisecond after the last record
+                offset_ms_ += last_ms_ + 1U;
+                last_ms_ = 0;
+                std::rewind(file_);
+                continue;
+            }
+            if (parse(line, pending_)) {
+                seen_record_ = true;
+                last_ms_ = pending_.t_ms;
+                pending_.t_ms += offset_ms_;
+                return true;
+            }
+        }
+    }
+
+    bool parse(char* line, Record& out) noexcept
+    {
+        char* hash = std::strchr(line, '#');
+        if (hash != nullptr) {
+            *hash = '\0';
+        }
+        char* cursor = line;
+        bool have_time = false;
+        out.count = 0;
+        for (;;) {
+            while (*cursor == ' ' || *cursor == ',' || *cursor == '\t' || *cursor == '\r' ||
+                   *cursor == '\n') {
+                ++cursor;
+            }
+            if (*cursor == '\0') {
+                break;
+            }
+            char* end = nullptr;
+            const unsigned long long value = std::strtoull(cursor, &end, 0);
+            if (end == cursor) {
+                ++malformed_;
+                return false;
+            }
+            cursor = end;
+            if (!have_time) {
+                out.t_ms = static_cast<uint64_t>(value);
+                have_time = true;
+            } else if (out.count < MAX_FIELDS) {
+                out.fields[out.count++] = static_cast<uint32_t>(value);
+            }
+        }
+        if (have_time && out.count == 0) {
+            ++malformed_;
+        }
+        return have_time && out.count > 0;
+    }
+
+    FILE* file_{nullptr};
+    bool loop_{false};
+    bool has_pending_{false};
+    bool seen_record_{false};
+    uint64_t offset_ms_{0};
+    uint64_t last_ms_{0};
+    uint32_t malformed_{0};
+    Record pending_{};
+};
+
+} // namespace detail
+
+// ============================================================================
+// REPLAY ADC
+// ============================================================================
+class ReplayADC final : public IPlatformADC
+{
+public:
+    static constexpr uint32_t ADC_MAX_RAW = 4095;
+    static constexpr uint32_t ADC_MAX_MV = 3300;
+
+    explicit ReplayADC(IPlatformTime& time) noexcept : time_(time) {}
+
+    core::Result<void> open(const char* path, bool loop = false) noexcept
+    {
+        if (!file_.open(path, loop)) {
+            return GS_MAKE_ERROR(core::ErrorCode::InvalidParameter);
+        }
+        start_ms_ = time_.get_timestamp_ms();
+        return core::Result<void>{};
+    }
+
+    core::Result<void> init(uint8_t channel, Attenuation /*atten*/) noexcept override
+    {
+        if (GS_UNLIKELY(channel >= MAX_ADC_CHANNELS)) {
+            return GS_MAKE_ERROR(core::ErrorCode::InvalidParameter);
+        }
+        initialized_[channel] = true;
+        return core::Result<void>{};
+    }
+
+    core::Result<uint32_t> read_raw(uint8_t channel) noexcept override
+    {
+        if (GS_UNLIKELY(channel >= MAX_ADC_CHANNELS || !initialized_[channel])) {
+            return core::Result<uint32_t>(GS_MAKE_ERROR(core::ErrorCode::ADCReadError));
+        }
+        pump();
+        return core::Result<uint32_t>(values_[channel]);
+    }
+
+    core::Result<uint32_t> read_mv(uint8_t channel) noexcept override
+    {
+        auto raw = read_raw(channel);
+        if (raw.is_error()) {
+            return raw;
+        }
+        return core::Result<uint32_t>((raw.value() * ADC_MAX_MV) / ADC_MAX_RAW);
+    }
+
+    /// Records applied so far.
+    GS_NODISCARD uint32_t frames() const noexcept
+    {
+        return frames_;
+    }
+
+private:
+    void pump() noexcept
+    {
+        const uint64_t elapsed = time_.get_timestamp_ms() - start_ms_;
+        detail::ReplayFile::Record record;
+        while (file_.next_due(elapsed, record)) {
+            for (size_t ch = 0; ch < record.count && ch < MAX_ADC_CHANNELS; ++ch) {
+                values_[ch] = record.fields[ch] > ADC_MAX_RAW ? ADC_MAX_RAW : record.fields[ch];
+            }
+            ++frames_;
+        }
+    }
+
+    IPlatformTime& time_;
+    detail::ReplayFile file_;
+    core::timestamp_t start_ms_{0};
+    uint32_t frames_{0};
+    std::array<uint32_t, MAX_ADC_CHANNELS> values_{};
+    std::array<bool, MAX_ADC_CHANNELS> initialized_{};
+};
+
+// ============================================================================
+// REPLAY I2C
+// ============================================================================
+/**
+ * @brief Register banks per device address, loaded from the capture.
+ *
+ * Drivers' own register writes land in the bank too, so configure-then-read
+ * sequences behave. Addresses never named by the capture NACK (I2CError).
+ */
+class ReplayI2C final : public IPlatformI2C
+{
+public:
+    static constexpr size_t MAX_DEVICES = 8;
+    static constexpr size_t REGISTER_COUNT = 256;
+
+    explicit ReplayI2C(IPlatformTime& time) noexcept : time_(time) {}
+
+    core::Result<void> open(const char* path, bool loop = false) noexcept
+    {
+        if (!file_.open(path, loop)) {
+            return GS_MAKE_ERROR(core::ErrorCode::InvalidParameter);
+        }
+        start_ms_ = time_.get_timestamp_ms();
+        pump();
+        return core::Result<void>{};
+    }
+
+    core::Result<void>
+    init(uint8_t /*sda_pin*/, uint8_t /*scl_pin*/, uint32_t /*freq_hz*/) noexcept override
+    {
+        initialized_ = true;
+        return core::Result<void>{};
+    }
+
+    core::Result<void>
+    read_reg(uint8_t dev_addr, uint8_t reg_addr, uint8_t* buf, size_t len) noexcept override
+    {
+        if (GS_UNLIKELY(!initialized_ || buf == nullptr)) {
+            return GS_MAKE_ERROR(core::ErrorCode::I2CError);
+        }
+        pump();
+        Bank* bank = find(dev_addr);
+        if (bank == nullptr) {
+            return GS_MAKE_ERROR(core::ErrorCode::I2CError);
+        }
+        for (size_t i = 0; i < len; ++i) {
+            buf[i] = bank->regs[(reg_addr + i) % REGISTER_COUNT];
+        }
+        return core::Result<void>{};
+    }
+
+    core::Result<void> write_reg(uint8_t dev_addr,
+                                 uint8_t reg_addr,
+                                 const uint8_t* buf,
+                                 size_t len) noexcept override
+    {
+        if (GS_UNLIKELY(!initialized_ || buf == nullptr)) {
+            return GS_MAKE_ERROR(core::ErrorCode::I2CError);
+        }
+        pump();
+        Bank* bank = find(dev_addr);
+        if (bank == nullptr) {
+            return GS_MAKE_ERROR(core::ErrorCode::I2CError);
+        }
+        for (size_t i = 0; i < len; ++i) {
+            bank->regs[(reg_addr + i) % REGISTER_COUNT] = buf[i];
+        }
+        return core::Result<void>{};
+    }
+
+    core::Result<void> shutdown() noexcept override
+    {
+        initialized_ = false;
+        return core::Result<void>{};
+    }
+
+private:
+    struct Bank
+    {
+        bool used{false};
+        uint8_t address{0};
+        uint8_t regs[REGISTER_COUNT]{};
+    };
+
+    Bank* find(uint8_t address) noexcept
+    {
+        for (auto& bank : banks_) {
+            if (bank.used && bank.address == address) {
+                return &bank;
+            }
+        }
+        return nullptr;
+    }
+
+    Bank* find_or_add(uint8_t address) noexcept
+    {
+        Bank* bank = find(address);
+        if (bank != nullptr) {
+            return bank;
+        }
+        for (auto& slot : banks_) {
+            if (!slot.used) {
+                slot.used = true;
+                slot.address = address;
+                return &slot;
+            }
+        }
+        return nullptr;
+    }
+
+    void pump() noexcept
+    {
+        const uint64_t elapsed = time_.get_timestamp_ms() - start_ms_;
+        detail::ReplayFile::Record record;
+        while (file_.next_due(elapsed, record)) {
+            if (record.count < 3) {
+                continue;
+            }
+            Bank* bank = find_or_add(static_cast<uint8_t>(record.fields[0]));
+            if (bank == nullptr) {
+                continue;
+            }
+            const uint32_t reg = record.fields[1];
+            for (size_t i = 2; i < record.count; ++i) {
+                bank->regs[(reg + i - 2) % REGISTER_COUNT] = static_cast<uint8_t>(record.fields[i]);
+            }
+        }
+    }
+
+    IPlatformTime& time_;
+    detail::ReplayFile file_;
+    core::timestamp_t start_ms_{0};
+    bool initialized_{false};
+    Bank banks_[MAX_DEVICES]{};
+};
+
+// ============================================================================
+// REPLAY UART
+// ============================================================================
+/**
+ * @brief RX bytes arrive at their recorded times; read() with a timeout
+ * sleeps until the next arrival instead of polling.
+ *
+ * TX can be captured to a file in the same format, so a session's output
+ * is itself replayable.
+ */
+class ReplayUART final : public IPlatformUART
+{
+public:
+    static constexpr size_t RX_BUFFER_SIZE = 512;
+
+    explicit ReplayUART(IPlatformTime& time) noexcept : time_(time) {}
+
+    ~ReplayUART() noexcept override
+    {
+        if (tx_log_ != nullptr) {
+            std::fclose(tx_log_);
+        }
+    }
+
+    ReplayUART(const ReplayUART&) = delete;
+    ReplayUART& operator=(const ReplayUART&) = delete;
+
+    core::Result<void>
+    open(const char* path, bool loop = false, const char* tx_log_path = nullptr) noexcept
+    {
+        if (!file_.open(path, loop)) {
+            return GS_MAKE_ERROR(core::ErrorCode::InvalidParameter);
+        }
+        if (tx_log_path != nullptr) {
+            tx_log_ = std::fopen(tx_log_path, "w");
+            if (tx_log_ == nullptr) {
+                return GS_MAKE_ERROR(core::ErrorCode::InvalidParameter);
+            }
+        }
+        start_ms_ = time_.get_timestamp_ms();
+        return core::Result<void>{};
+    }
+
+    core::Result<void> init(uint8_t port,
+                            uint32_t /*baud_rate*/,
+                            uint8_t /*tx_pin*/,
+                            uint8_t /*rx_pin*/) noexcept override
+    {
+        if (GS_UNLIKELY(port >= MAX_UART_PORTS)) {
+            return GS_MAKE_ERROR(core::ErrorCode::InvalidParameter);
+        }
+        ports_[port].initialized = true;
+        return core::Result<void>{};
+    }
+
+    core::Result<size_t> write(uint8_t port, const uint8_t* data, size_t length) noexcept override
+    {
+        if (GS_UNLIKELY(port >= MAX_UART_PORTS || !ports_[port].initialized)) {
+            return core::Result<size_t>(GS_MAKE_ERROR(core::ErrorCode::UARTError));
+        }
+        if (GS_UNLIKELY(data == nullptr || length == 0)) {
+            return core::Result<size_t>(GS_MAKE_ERROR(core::ErrorCode::InvalidParameter));
+        }
+        if (tx_log_ != nullptr) {
+            std::fprintf(tx_log_,
+                         "%llu %u",
+                         static_cast<unsigned long long>(time_.get_timestamp_ms() - start_ms_),
+                         static_cast<unsigned>(port));
+            for (size_t i = 0; i < length; ++i) {
+                std::fprintf(tx_log_, " 0x%02X", data[i]);
+            }
+            std::fputc('\n', tx_log_);
+            std::fflush(tx_log_);
+        }
+        tx_bytes_ += length;
+        return core::Result<size_t>(length);
+    }
+
+    core::Result<size_t> read(uint8_t port,
+                              uint8_t* buffer,
+                              size_t max_length,
+                              uint32_t timeout_ms) noexcept override
+    {
+        if (GS_UNLIKELY(port >= MAX_UART_PORTS || !ports_[port].initialized)) {
+            return core::Result<size_t>(GS_MAKE_ERROR(core::ErrorCode::UARTError));
+        }
+        if (GS_UNLIKELY(buffer == nullptr || max_length == 0)) {
+            return core::Result<size_t>(GS_MAKE_ERROR(core::ErrorCode::InvalidParameter));
+        }
+
+        Port& rx = ports_[port];
+        pump();
+        if (rx.count == 0 && timeout_ms > 0) {
+            const uint64_t now = time_.get_timestamp_ms() - start_ms_;
+            const uint64_t next = file_.next_time_ms();
+            const uint64_t wait = (next > now) ? next - now : 0;
+            time_.delay_ms(static_cast<uint32_t>(wait < timeout_ms ? wait : timeout_ms));
+            pump();
+        }
+
+        size_t n = 0;
+        while (n < max_length && rx.count > 0) {
+            buffer[n++] = rx.data[rx.head];
+            rx.head = (rx.head + 1) % RX_BUFFER_SIZE;
+            --rx.count;
+        }
+        return core::Result<size_t>(n);
+    }
+
+    core::Result<void> shutdown(uint8_t port) noexcept override
+    {
+        if (port < MAX_UART_PORTS) {
+            ports_[port].initialized = false;
+        }
+        return core::Result<void>{};
+    }
+
+    GS_NODISCARD uint64_t tx_bytes() const noexcept
+    {
+        return tx_bytes_;
+    }
+
+    /// RX bytes dropped because the consumer fell behind.
+    GS_NODISCARD uint32_t rx_overruns() const noexcept
+    {
+        return rx_overruns_;
+    }
+
+private:
+    struct Port
+    {
+        bool initialized{false};
+        size_t head{0};
+        size_t count{0};
+        uint8_t data[RX_BUFFER_SIZE]{};
+    };
+
+    void pump() noexcept
+    {
+        const uint64_t elapsed = time_.get_timestamp_ms() - start_ms_;
+        detail::ReplayFile::Record record;
+        while (file_.next_due(elapsed, record)) {
+            if (record.fields[0] >= MAX_UART_PORTS) {
+                continue;
+            }
+            Port& rx = ports_[record.fields[0]];
+            for (size_t i = 1; i < record.count; ++i) {
+                if (rx.count == RX_BUFFER_SIZE) {
+                    ++rx_overruns_;
+                    continue;
+                }
+                rx.data[(rx.head + rx.count) % RX_BUFFER_SIZE] =
+                    static_cast<uint8_t>(record.fields[i]);
+                ++rx.count;
+            }
+        }
+    }
+
+    IPlatformTime& time_;
+    detail::ReplayFile file_;
+    FILE* tx_log_{nullptr};
+    core::timestamp_t start_ms_{0};
+    uint64_t tx_bytes_{0};
+    uint32_t rx_overruns_{0};
+    Port ports_[MAX_UART_PORTS]{};
+};
+
+// ============================================================================
+// PLATFORM BUNDLE
+// ============================================================================
+struct PosixPlatformConfig
+{
+    enum class Transport : uint8_t
+    {
+        None = 0, // loopback mock, nothing leaves the process
+        Udp = 1,
+        Tcp = 2
+    };
+
+    const char* flash_path{"gridshield_flash.bin"};
+    size_t flash_size{64 * 1024}; // keys/config/warm-boot + evidence journal
+    Transport transport{Transport::None};
+    UdpConfig udp{};
+    TcpConfig tcp{};
+    const char* adc_replay{nullptr};
+    const char* i2c_replay{nullptr};
+    const char* uart_replay{nullptr};
+    const char* uart_tx_log{nullptr};
+    bool loop_replay{true};
+};
+
+/**
+ * @brief Owns every backend and hands out PlatformServices.
+ *
+ * GPIO and interrupts have no host counterpart and stay mocks; tamper
+ * inputs are driven through MockGPIO/MockInterrupt as in tests.
+ */
+class PosixPlatform
+{
+public:
+    PosixPlatform() noexcept = default;
+
+    PosixPlatform(const PosixPlatform&) = delete;
+    PosixPlatform& operator=(const PosixPlatform&) = delete;
+
+    core::Result<void> init(const PosixPlatformConfig& config) noexcept
+    {
+        GS_TRY(flash_device_.open(config.flash_path, config.flash_size));
+
+        services_.time = &time_;
+        services_.gpio = &gpio_;
+        services_.interrupt = &interrupt_;
+        services_.crypto = &crypto_;
+        services_.storage = &storage_;
+
+        switch (config.transport) {
+        case PosixPlatformConfig::Transport::Udp:
+            udp_.configure(config.udp);
+            services_.comm = &udp_;
+            break;
+        case PosixPlatformConfig::Transport::Tcp:
+            tcp_.configure(config.tcp);
+            services_.comm = &tcp_;
+            break;
+        default:
+            services_.comm = &loopback_;
+            break;
+        }
+
+        if (config.adc_replay != nullptr) {
+            GS_TRY(adc_.open(config.adc_replay, config.loop_replay));
+            services_.adc = &adc_;
+        }
+        if (config.i2c_replay != nullptr) {
+            GS_TRY(i2c_.open(config.i2c_replay, config.loop_replay));
+            services_.i2c = &i2c_;
+        }
+        if (config.uart_replay != nullptr) {
+            GS_TRY(uart_.open(config.uart_replay, config.loop_replay, config.uart_tx_log));
+            services_.uart = &uart_;
+        }
+        return core::Result<void>{};
+    }
+
+    GS_NODISCARD PlatformServices& services() noexcept
+    {
+        return services_;
+    }
+
+    GS_NODISCARD PosixTime& time() noexcept
+    {
+        return time_;
+    }
+
+    GS_NODISCARD mock::MockGPIO& gpio() noexcept
+    {
+        return gpio_;
+    }
+
+    GS_NODISCARD mock::MockInterrupt& interrupt() noexcept
+    {
+        return interrupt_;
+    }
+
+    GS_NODISCARD native::MmapFlashStorage& storage() noexcept
+    {
+        return storage_;
+    }
+
+private:
+    PosixTime time_;
+    mock::MockGPIO gpio_;
+    mock::MockInterrupt interrupt_;
+    native::NativeCrypto crypto_;
+    native::MmapFlashDevice flash_device_;
+    native::MmapFlashStorage storage_{flash_device_};
+    PosixUdpComm udp_;
+    PosixTcpComm tcp_;
+    mock::MockComm loopback_;
+    ReplayADC adc_{time_};
+    ReplayI2C i2c_{time_};
+    ReplayUART uart_{time_};
+    PlatformServices services_{};
+};
+
+} // namespace gridshield::platform::posix
+
+#endif // GS_PLATFORM_NATIVE
@@ -0,0 +1,48 @@
+/**
+ * @file sim_clock.hpp
+ * @author zuudevs (zuudevs@gmail.com)
+ * @brief Virtual clock for discrete-event simulators
+ * @version 1.0
+ * @date 2026-03-12
+ *
+ * Shared by NetEmulator and SimFlashDevice so a simulated run accrues
+ * network and flash latency on one timeline without sleeping.
+ *
+ * @copyright Copyright (c) 2026
+ */
+
+#pragma once
+
+#include "platform/platform.hpp"
+
+namespace gridshield::platform::sim {
+
+/// Manually advanced clock: delay_ms() moves time instead of sleeping.
+class SimClock final : public IPlatformTime
+{
+public:
+    core::timestamp_t get_timestamp_ms() noexcept override
+    {
+        return static_cast<core::timestamp_t>(now_us_ / 1000U);
+    }
+
+    uint64_t get_timestamp_us() noexcept override
+    {
+        return now_us_;
+    }
+
+    void delay_ms(uint32_t milliseconds) noexcept override
+    {
+        now_us_ += static_cast<uint64_t>(milliseconds) * 1000U;
+    }
+
+    void advance_us(uint64_t microseconds) noexcept
+    {
+        now_us_ += microseconds;
+    }
+
+private:
+    uint64_t now_us_{0};
+};
+
+} // namespace gridshield::platform::sim
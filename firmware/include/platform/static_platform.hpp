@@ -0,0 +1,197 @@
+/**
+ * @file static_platform.hpp
+ * @author zuudevs (zuudevs@gmail.com)
+ * @brief Compile-time platform binding for hot HAL paths
+ * @version 1.0
+ * @date 2026-03-10
+ *
+ * Per-sample code (ADC loops, timestamps, hashing) is templated on a
+ * platform policy instead of calling through PlatformServices pointers.
+ * With a policy of final concrete classes the compiler sees the exact
+ * callee and can inline it; with the interface types (VirtualPlatform)
+ * the same template behaves exactly like the virtual path.
+ *
+ * The provider traits below are the C++17 stand-in for concepts: every
+ * policy member and every templated driver static_asserts on them, so a
+ * type that does not satisfy the HAL contract fails at the binding site
+ * with a readable message rather than deep inside a driver.
+ *
+ * @copyright Copyright (c) 2026
+ */
+
+#pragma once
+
+#include "platform/platform.hpp"
+
+#include <type_traits>
+#include <utility>
+
+#if defined(GS_STATIC_PLATFORM) && GS_STATIC_PLATFORM && defined(ESP_PLATFORM)
+#include "platform/esp32_platform.hpp"
+#endif
+
+namespace gridshield::platform {
+
+// ============================================================================
+// PROVIDER TRAITS (concept-like checks)
+// ============================================================================
+namespace detail {
+
+template <typename T, typename = void> struct is_time_provider : std::false_type
+{};
+
+template <typename T>
+struct is_time_provider<
+    T,
+    std::void_t<decltype(std::declval<T&>().get_timestamp_ms()),
+                decltype(std::declval<T&>().get_timestamp_us()),
+                decltype(std::declval<T&>().delay_ms(uint32_t{}))>>
+    : std::is_convertible<decltype(std::declval<T&>().get_timestamp_us()), uint64_t>
+{};
+
+template <typename T, typename = void> struct is_adc_provider : std::false_type
+{};
+
+template <typename T>
+struct is_adc_provider<
+    T,
+    std::void_t<decltype(std::declval<T&>().init(uint8_t{}, ADCAttenuation{})),
+                decltype(std::declval<T&>().read_raw(uint8_t{})),
+                decltype(std::declval<T&>().read_mv(uint8_t{}))>>
+    : std::is_same<decltype(std::declval<T&>().read_mv(uint8_t{})), core::Result<uint32_t>>
+{};
+
+template <typename T, typename = void> struct is_crypto_provider : std::false_type
+{};
+
+template <typename T>
+struct is_crypto_provider<
+    T,
+    std::void_t<decltype(std::declval<T&>().random_bytes(std::declval<uint8_t*>(), size_t{})),
+                decltype(std::declval<T&>().crc32(std::declval<const uint8_t*>(), size_t{})),
+                decltype(std::declval<T&>().sha256(
+                    std::declval<const uint8_t*>(), size_t{}, std::declval<uint8_t*>()))>>
+    : std::true_type
+{};
+
+} // namespace detail
+
+template <typename T> inline constexpr bool is_time_provider_v = detail::is_time_provider<T>::value;
+template <typename T> inline constexpr bool is_adc_provider_v = detail::is_adc_provider<T>::value;
+template <typename T>
+inline constexpr bool is_crypto_provider_v = detail::is_crypto_provider<T>::value;
+
+// ============================================================================
+// PLATFORM POLICY
+// ============================================================================
+
+/**
+ * @brief Bundle of HAL types a component is compiled against.
+ *
+ * Each type must also derive from its interface, so a PlatformServices
+ * populated with these objects can be rebound without copying.
+ */
+template <typename TimeT, typename AdcT, typename CryptoT> struct StaticPlatform
+{
+    static_assert(is_time_provider_v<TimeT>, "TimeT does not satisfy the IPlatformTime contract");
+    static_assert(is_adc_provider_v<AdcT>, "AdcT does not satisfy the IPlatformADC contract");
+    static_assert(is_crypto_provider_v<CryptoT>,
+                  "CryptoT does not satisfy the IPlatformCrypto contract");
+    static_assert(std::is_base_of<IPlatformTime, TimeT>::value, "TimeT must implement IPlatformTime");
+    static_assert(std::is_base_of<IPlatformADC, AdcT>::value, "AdcT must implement IPlatformADC");
+    static_assert(std::is_base_of<IPlatformCrypto, CryptoT>::value,
+                  "CryptoT must implement IPlatformCrypto");
+
+    using Time = TimeT;
+    using Adc = AdcT;
+    using Crypto = CryptoT;
+
+    /// True when calls bind to concrete classes (no vtable dispatch).
+    static constexpr bool is_static = std::is_final<TimeT>::value && std::is_final<AdcT>::value &&
+                                      std::is_final<CryptoT>::value;
+};
+
+/// Interface types: dispatch through vtables (tests, mocks, host builds).
+using VirtualPlatform = StaticPlatform<IPlatformTime, IPlatformADC, IPlatformCrypto>;
+
+#if defined(GS_STATIC_PLATFORM) && GS_STATIC_PLATFORM && defined(ESP_PLATFORM)
+using Esp32StaticPlatform = StaticPlatform<esp32::Esp32Time, esp32::Esp32ADC, esp32::Esp32Crypto>;
+using DefaultPlatform = Esp32StaticPlatform;
+#else
+using DefaultPlatform = VirtualPlatform;
+#endif
+
+// ============================================================================
+// BINDING
+// ============================================================================
+namespace detail {
+
+/// Interface address each concrete HAL object was registered under.
+template <typename Concrete> struct bound_object
+{
+    static inline const void* address = nullptr;
+};
+
+template <typename Interface, typename Concrete> void register_bound(Concrete& object) noexcept
+{
+    bound_object<Concrete>::address =
+        static_cast<const void*>(static_cast<const Interface*>(&object));
+}
+
+} // namespace detail
+
+/**
+ * @brief PlatformServices whose per-sample slots are typed by the policy.
+ *
+ * The constructor only accepts the policy's concrete objects, so wiring a
+ * clock or ADC of another type fails to compile. Each object is also
+ * registered, letting consumers check with is_bound() that the slot was
+ * not reassigned after construction.
+ */
+template <typename Policy> struct StaticPlatformServices : PlatformServices
+{
+    StaticPlatformServices(typename Policy::Time& time_provider,
+                           typename Policy::Adc& adc_provider,
+                           typename Policy::Crypto& crypto_provider) noexcept
+    {
+        time = &time_provider;
+        adc = &adc_provider;
+        crypto = &crypto_provider;
+        detail::register_bound<IPlatformTime>(time_provider);
+        detail::register_bound<IPlatformADC>(adc_provider);
+        detail::register_bound<IPlatformCrypto>(crypto_provider);
+    }
+};
+
+/**
+ * @brief True when @p iface may be viewed as @p Concrete.
+ *
+ * Always true for interface types. For a concrete type, @p iface must be
+ * the object a StaticPlatformServices registered (RTTI is disabled, so
+ * identity is the only check available).
+ */
+template <typename Concrete, typename Interface>
+GS_NODISCARD bool is_bound(const Interface& iface) noexcept
+{
+    if constexpr (std::is_same<Concrete, Interface>::value) {
+        return true;
+    } else {
+        return detail::bound_object<Concrete>::address == static_cast<const void*>(&iface);
+    }
+}
+
+/**
+ * @brief View an interface object as the policy's concrete type.
+ *
+ * Identity for VirtualPlatform. For a static policy this is an unchecked
+ * cast: callers confirm is_bound<Concrete>(iface) first, as
+ * SensorManagerT::initialize() does.
+ */
+template <typename Concrete, typename Interface> GS_INLINE Concrete& bind(Interface& iface) noexcept
+{
+    static_assert(std::is_base_of<Interface, Concrete>::value,
+                  "policy type must implement the bound interface");
+    return static_cast<Concrete&>(iface);
+}
+
+} // namespace gridshield::platform
@@ -21,6 +21,7 @@
 #include "core/system.hpp"
 #include "platform/esp32_platform.hpp"
 #include "platform/mock_platform.hpp"
+#include "platform/static_platform.hpp"
 
 #include <cstdio>
 #include <cstring>
@@ -40,7 +41,6 @@ using namespace gridshield;
 // ============================================================================
 // PLATFORM INSTANCES (static, no heap)
 // ============================================================================
-static platform::mock::MockTime mock_time;
 static platform::mock::MockGPIO mock_gpio;
 static platform::mock::MockInterrupt mock_interrupt;
 static platform::mock::MockComm mock_comm;
@@ -51,7 +51,20 @@ static platform::esp32::Esp32Crypto esp32_crypto;
 // Real ESP32 NVS storage (persists across reboots on real HW, RAM-backed on QEMU)
 static platform::esp32::Esp32Storage esp32_storage;
 
+// Raw "gsdata" partition behind the write-back sector cache (see partitions.csv)
+static platform::esp32::Esp32PartitionDevice gsdata_partition;
+static platform::esp32::Esp32FlashStorage gsdata_storage(gsdata_partition);
+
+#if defined(GS_STATIC_PLATFORM) && GS_STATIC_PLATFORM
+// Statically bound HAL: the sensor drivers call these objects directly
+static platform::esp32::Esp32Time esp32_time;
+static platform::esp32::Esp32ADC esp32_adc;
+static platform::StaticPlatformServices<platform::Esp32StaticPlatform>
+    services(esp32_time, esp32_adc, esp32_crypto);
+#else
+static platform::mock::MockTime mock_time;
 static platform::PlatformServices services;
+#endif
 static GridShieldSystem* system_ptr = nullptr;
 
 // ============================================================================
@@ -130,6 +143,17 @@ void app_main(void)
     }
     ESP_LOGI(TAG, "NVS storage initialized");
 
+    // Prefer the raw data partition; images without "gsdata" keep NVS
+    platform::IPlatformStorage* storage = &esp32_storage;
+    if (gsdata_partition.init().is_ok()) {
+        storage = &gsdata_storage;
+        ESP_LOGI(TAG,
+                 "Raw flash storage on 'gsdata' (%u KB usable)",
+                 static_cast<unsigned>(gsdata_storage.capacity() / 1024U));
+    } else {
+        ESP_LOGW(TAG, "No 'gsdata' partition — storing to NVS");
+    }
+
     // Initialize Watchdog Timer (30s timeout)
     auto wdt_result = platform::esp32::Esp32Watchdog::init(30);
     if (wdt_result.is_error()) {
@@ -140,15 +164,23 @@ void app_main(void)
         ESP_LOGI(TAG, "Watchdog timer initialized (30s)");
     }
 
-    // Assemble platform services (real crypto + NVS, mock GPIO/Interrupt/Comm)
+    // Hot paths record GS_DLOGx entries; a low-priority task prints them
+    auto drain_result = platform::esp32::Esp32LogDrain::start();
+    if (drain_result.is_error()) {
+        ESP_LOGW(TAG, "Deferred log drain not started — GS_DLOG records will be dropped");
+    }
+
+    // Assemble platform services (real crypto + flash, mock GPIO/Interrupt/Comm)
+#if !(defined(GS_STATIC_PLATFORM) && GS_STATIC_PLATFORM)
     services.time = &mock_time;
+    services.crypto = &esp32_crypto;
+#endif
     services.gpio = &mock_gpio;
     services.interrupt = &mock_interrupt;
-    services.crypto = &esp32_crypto;
-    services.storage = &esp32_storage;
+    services.storage = storage;
     services.comm = &mock_comm;
 
-    // Load config: try NVS first, fallback to compiled defaults
+    // Load config: try storage first, fallback to compiled defaults
     core::ConfigManager config_mgr(services);
     SystemConfig default_config = create_config();
     SystemConfig config = config_mgr.load_or_default(default_config);
@@ -163,8 +195,7 @@ void app_main(void)
     // Persist validated config for next boot
     auto save_res = config_mgr.save(config);
     if (save_res.is_error()) {
-        ESP_LOGW(
-            TAG, "Failed to save config to NVS (code=%d)", static_cast<int>(save_res.error().code));
+        ESP_LOGW(TAG, "Failed to save config (code=%d)", static_cast<int>(save_res.error().code));
     }
     ESP_LOGI(TAG, "Configuration validated and persisted");
 
@@ -210,6 +241,11 @@ void app_main(void)
         // Feed watchdog
         platform::esp32::Esp32Watchdog::feed();
 
+        // Bound the durability of any NVS batch left open across cycles
+        if (services.storage == &esp32_storage) {
+            (void)esp32_storage.poll();
+        }
+
         // Use FreeRTOS delay for proper QEMU time advancement
         vTaskDelay(pdMS_TO_TICKS(100));
 
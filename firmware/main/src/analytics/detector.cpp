@@ -10,6 +10,7 @@
  */
 
 #include "analytics/detector.hpp"
+#include "utils/fixed_point.hpp"
 
 namespace gridshield::analytics {
 
@@ -22,6 +23,7 @@ core::Result<void> AnomalyDetector::initialize(const ConsumptionProfile& baselin
 
     profile_ = baseline_profile;
     recent_readings_.clear();
+    reset_quantiles();
     initialized_ = true;
 
     return core::Result<void>{};
@@ -97,14 +99,26 @@ core::Result<AnomalyReport> AnomalyDetector::analyze(const core::MeterReading& r
 
         uint32_t abs_diff = (diff < 0) ? static_cast<uint32_t>(-diff) : static_cast<uint32_t>(diff);
 
-        report.deviation_percent = (abs_diff * DEVIATION_FULL) / report.expected_value;
+        report.deviation_percent =
+            utils::mul_div_u32(abs_diff, DEVIATION_FULL, report.expected_value);
     } else {
         report.deviation_percent = 0;
     }
 
-    // Detect anomalies based on deviation threshold
-    if (report.deviation_percent > profile_.variance_threshold) {
-        if (reading.energy_wh < report.expected_value) {
+    // Detect anomalies against this hour's threshold, then learn the
+    // (winsorized) deviation so one theft window cannot drag p99 up with it
+    const size_t hour_index = (reading.timestamp / MS_PER_HOUR) % PROFILE_HISTORY_SIZE;
+    const bool drop = reading.energy_wh < report.expected_value;
+    const uint32_t threshold = deviation_threshold(hour_index, drop);
+    if (report.expected_value > 0) {
+        const uint32_t cap = threshold * QUANTILE_WINSOR_FACTOR;
+        auto& quantiles = drop ? drop_quantiles_ : spike_quantiles_;
+        quantiles[hour_index].add(static_cast<int32_t>(
+            report.deviation_percent < cap ? report.deviation_percent : cap));
+    }
+
+    if (report.deviation_percent > threshold) {
+        if (drop) {
             report.type = AnomalyType::UnexpectedDrop;
         } else {
             report.type = AnomalyType::UnexpectedSpike;
@@ -139,6 +153,48 @@ core::Result<void> AnomalyDetector::reset_profile() noexcept
 
     profile_ = ConsumptionProfile();
     recent_readings_.clear();
+    reset_quantiles();
+
+    return core::Result<void>{};
+}
+
+void AnomalyDetector::export_state(DetectorCheckpoint& out) const noexcept
+{
+    out = DetectorCheckpoint();
+    out.profile = profile_;
+    out.recent_count = static_cast<uint16_t>(recent_readings_.size());
+    for (size_t i = 0; i < recent_readings_.size(); ++i) {
+        out.recent_energy_wh[i] = recent_readings_[i].energy_wh;
+    }
+    for (size_t i = 0; i < PROFILE_HISTORY_SIZE; ++i) {
+        drop_quantiles_[i].save(out.drop_quantiles[i]);
+        spike_quantiles_[i].save(out.spike_quantiles[i]);
+    }
+}
+
+core::Result<void> AnomalyDetector::restore_state(const DetectorCheckpoint& state) noexcept
+{
+    if (!initialized_) {
+        return GS_MAKE_ERROR(core::ErrorCode::SystemNotInitialized);
+    }
+    if (state.version != DetectorCheckpoint::VERSION || state.recent_count > MAX_RECENT_READINGS ||
+        state.profile.profile_confidence > CONFIDENCE_MAX) {
+        return GS_MAKE_ERROR(core::ErrorCode::DataInvalid);
+    }
+
+    profile_ = state.profile;
+    recent_readings_.clear();
+    for (size_t i = 0; i < state.recent_count; ++i) {
+        core::MeterReading reading;
+        reading.energy_wh = state.recent_energy_wh[i];
+        (void)recent_readings_.push(reading);
+    }
+
+    // An inconsistent bin is re-learned on its own (load() leaves it reset)
+    for (size_t i = 0; i < PROFILE_HISTORY_SIZE; ++i) {
+        (void)drop_quantiles_[i].load(state.drop_quantiles[i], DEVIATION_QUANTILE_X1000);
+        (void)spike_quantiles_[i].load(state.spike_quantiles[i], DEVIATION_QUANTILE_X1000);
+    }
 
     return core::Result<void>{};
 }
@@ -176,4 +232,31 @@ uint32_t AnomalyDetector::calculate_expected_value(core::timestamp_t timestamp)
     return profile_.daily_avg_wh;
 }
 
-} // namespace gridshield::analytics
\ No newline at end of file
+uint32_t AnomalyDetector::deviation_threshold(size_t hour_index, bool drop) const noexcept
+{
+    const auto& quantiles = drop ? drop_quantiles_ : spike_quantiles_;
+    const P2Quantile& quantile = quantiles[hour_index % PROFILE_HISTORY_SIZE];
+    if (quantile.count() < QUANTILE_MIN_SAMPLES) {
+        return profile_.variance_threshold;
+    }
+
+    // Below the Low band a "deviation" is just noise; above the High band a
+    // noisy bin would start hiding real theft (the expected value is the
+    // rolling mean, not a per-hour forecast), so p99 only moves the
+    // threshold inside [Low, High]
+    const auto p99 = static_cast<uint32_t>(quantile.value());
+    if (p99 < SEVERITY_LOW_THRESHOLD) {
+        return SEVERITY_LOW_THRESHOLD;
+    }
+    return p99 < SEVERITY_HIGH_THRESHOLD ? p99 : SEVERITY_HIGH_THRESHOLD;
+}
+
+void AnomalyDetector::reset_quantiles() noexcept
+{
+    for (size_t i = 0; i < PROFILE_HISTORY_SIZE; ++i) {
+        drop_quantiles_[i].init(DEVIATION_QUANTILE_X1000);
+        spike_quantiles_[i].init(DEVIATION_QUANTILE_X1000);
+    }
+}
+
+} // namespace gridshield::analytics
@@ -9,7 +9,11 @@
  */
 
 #include "core/system.hpp"
+#include "core/config_manager.hpp"
+#include "core/warm_boot.hpp"
 #include "esp_log.h"
+#include "forensics/evidence_journal.hpp"
+#include "security/key_storage.hpp"
 
 static const char* TAG = "GS_System";
 
@@ -27,8 +31,115 @@ constexpr uint32_t MOCK_POWER_FACTOR = 950;
 
 constexpr uint8_t BITS_PER_BYTE = 8;
 constexpr uint8_t BYTE_MASK = 0xFF;
+
+static_assert(core::ConfigManager::CONFIG_ADDRESS + core::ConfigManager::TOTAL_SIZE <=
+                  core::WarmBootStore::WB_BASE_ADDRESS,
+              "SystemConfig overlaps the warm-boot checkpoint area");
+static_assert(security::KeyStorage::BASE_ADDRESS +
+                      static_cast<uint32_t>(security::KeySlot::Count) *
+                          security::KeyStorage::SLOT_SIZE <=
+                  network::TxSequenceCounter::DEFAULT_ADDRESS,
+              "TX sequence record overlaps the key slots");
+static_assert(network::TxSequenceCounter::DEFAULT_ADDRESS +
+                      network::TxSequenceCounter::TOTAL_SIZE <=
+                  core::ConfigManager::CONFIG_ADDRESS,
+              "TX sequence record overlaps SystemConfig");
+static_assert(sizeof(analytics::DetectorCheckpoint) <=
+                  core::WarmBootStore::max_payload(core::WarmBootRecord::Detector),
+              "DetectorCheckpoint does not fit its warm-boot bank");
+static_assert(core::WarmBootStore::WB_BASE_ADDRESS + core::WarmBootStore::TOTAL_SIZE <=
+                  forensics::EvidenceJournal::DEFAULT_BASE_ADDRESS,
+              "Warm-boot banks overlap the evidence journal");
+
+forensics::SecurityEventType tamper_event_type(hardware::TamperType type) noexcept
+{
+    switch (type) {
+    case hardware::TamperType::CasingOpened:
+        return forensics::SecurityEventType::CasingOpened;
+    case hardware::TamperType::MagneticInterference:
+        return forensics::SecurityEventType::MagneticInterference;
+    case hardware::TamperType::PowerCutAttempt:
+        return forensics::SecurityEventType::PowerCutAttempt;
+    default:
+        return forensics::SecurityEventType::PhysicalShock;
+    }
+}
+
+forensics::SecurityEventType anomaly_event_type(analytics::AnomalyType type) noexcept
+{
+    switch (type) {
+    case analytics::AnomalyType::UnexpectedDrop:
+        return forensics::SecurityEventType::ConsumptionDrop;
+    case analytics::AnomalyType::UnexpectedSpike:
+        return forensics::SecurityEventType::ConsumptionSpike;
+    case analytics::AnomalyType::ZeroConsumption:
+        return forensics::SecurityEventType::ZeroConsumption;
+    default:
+        return forensics::SecurityEventType::AnomalyDetected;
+    }
+}
+
+forensics::SecurityEventSeverity event_severity(analytics::AnomalySeverity severity) noexcept
+{
+    return severity == analytics::AnomalySeverity::Critical
+               ? forensics::SecurityEventSeverity::Critical
+               : forensics::SecurityEventSeverity::High;
+}
+
+// Adaptive sampler input when no sensor sample is behind the reading
+hardware::SamplingObservation meter_observation(const core::MeterReading& reading) noexcept
+{
+    static constexpr uint64_t UW_PER_MW = 1000;
+
+    hardware::SamplingObservation obs;
+    obs.current_ma = reading.current_ma;
+    obs.power_mw =
+        static_cast<uint32_t>(uint64_t{reading.voltage_mv} * reading.current_ma / UW_PER_MW);
+    return obs;
+}
+
+// Adaptive sampler input from a three-phase record: whole-meter current and
+// active power, unsaturated
+hardware::SamplingObservation
+three_phase_observation(const core::ThreePhaseReading& reading) noexcept
+{
+    static constexpr uint32_t MA_PER_CA = 10;
+    static constexpr uint32_t MW_PER_W = 1000;
+
+    hardware::SamplingObservation obs;
+    for (const core::PhaseSample& phase : reading.phases) {
+        obs.current_ma += uint32_t{phase.current_ca} * MA_PER_CA;
+    }
+    const uint64_t power_w =
+        reading.total_power_w > 0 ? static_cast<uint64_t>(reading.total_power_w) : 0;
+    const uint64_t power_mw = power_w * MW_PER_W;
+    obs.power_mw = static_cast<uint32_t>(power_mw <= UINT32_MAX ? power_mw : UINT32_MAX);
+    return obs;
+}
 } // namespace
 
+core::MeterReading
+GridShieldSystem::aggregate_reading(const core::ThreePhaseReading& reading) noexcept
+{
+    static constexpr uint32_t MV_PER_DV = 100;
+    static constexpr uint32_t CA_PER_UNIT = AGGREGATE_CURRENT_UNIT_MA / 10;
+
+    uint32_t voltage_dv = 0;
+    uint32_t current_ca = 0;
+    for (const core::PhaseSample& phase : reading.phases) {
+        voltage_dv += phase.voltage_dv;
+        current_ca += phase.current_ca;
+    }
+
+    core::MeterReading total;
+    total.timestamp = reading.timestamp;
+    total.energy_wh = reading.energy_wh;
+    total.voltage_mv = voltage_dv * MV_PER_DV / core::PHASE_COUNT;
+    // 3 x 655.35 A in 100 mA units is 19 660: never saturates
+    total.current_ma = static_cast<uint16_t>((current_ca + CA_PER_UNIT / 2) / CA_PER_UNIT);
+    return total;
+}
+
 GridShieldSystem::~GridShieldSystem() noexcept
 {
     if (crypto_engine_ != nullptr) {
@@ -57,6 +168,7 @@ core::Result<void> GridShieldSystem::initialize(const SystemConfig& config,
 
     config_ = config;
     platform_ = &platform;
+    mark_boot_phase(core::BootPhase::Reset);
 
     transition_state(core::SystemState::Initializing);
     ESP_LOGI(
@@ -64,13 +176,39 @@ core::Result<void> GridShieldSystem::initialize(const SystemConfig& config,
 
     // Initialize layers
     GS_TRY(tamper_detector_.initialize(config_.tamper_config, platform));
+    if (config_.sensor_config.any_enabled()) {
+        GS_TRY(sensor_manager_.initialize(platform, config_.sensor_config));
+    }
+    mark_boot_phase(core::BootPhase::TamperReady);
     GS_TRY(initialize_crypto());
+    mark_boot_phase(core::BootPhase::KeysReady);
     GS_TRY(init_network_layer());
+    GS_TRY(tx_sequence_.init(platform));
+    mark_boot_phase(core::BootPhase::NetworkReady);
     GS_TRY(anomaly_detector_.initialize(config_.baseline_profile));
+    GS_TRY(phase_rules_.initialize(config_.phase_rules));
+    report_policy_.configure(config_.report_policy);
+    if (config_.adaptive_sampling.enabled) {
+        hardware::AdaptiveSamplingConfig sampling = config_.adaptive_sampling;
+        sampling.idle.interval_ms = config_.reading_interval_ms;
+        GS_TRY(adaptive_sampler_.initialize(sampling, platform_->time->get_timestamp_ms()));
+    }
+
+    // Resume learned analytics state; a cold start keeps the baseline profile
+    const bool warm_analytics = restore_analytics_state().is_ok();
+    telemetry_.set_warm_boot(telemetry_.boot_timing().warm_keys, warm_analytics);
+    mark_boot_phase(core::BootPhase::AnalyticsRestored);
 
     initialized_ = true;
+    last_checkpoint_ = platform_->time->get_timestamp_ms();
     transition_state(core::SystemState::Ready);
-    ESP_LOGI(TAG, "Initialization complete");
+    mark_boot_phase(core::BootPhase::Ready);
+    ESP_LOGI(TAG,
+             "Initialization complete in %llu ms (keys=%s, analytics=%s)",
+             static_cast<unsigned long long>(
+                 telemetry_.boot_timing().since_reset(core::BootPhase::Ready)),
+             telemetry_.boot_timing().warm_keys ? "warm" : "cold",
+             warm_analytics ? "warm" : "cold");
 
     return core::Result<void>{};
 }
@@ -114,6 +252,9 @@ core::Result<void> GridShieldSystem::shutdown() noexcept
     if (platform_ != nullptr && platform_->comm != nullptr) {
         (void)platform_->comm->shutdown();
     }
+    if (platform_ != nullptr && platform_->storage != nullptr) {
+        (void)platform_->storage->flush();
+    }
 
     device_keypair_.clear();
     server_public_key_.clear();
@@ -127,12 +268,37 @@ core::Result<void> GridShieldSystem::shutdown() noexcept
 
 core::Result<void> GridShieldSystem::process_cycle() noexcept
 {
+    // Running on hold-up energy: stay idle until the supply comes back
+    if (state_ == core::SystemState::PowerLoss) {
+        if (supply_failed()) {
+            return GS_MAKE_ERROR(core::ErrorCode::PowerLossDetected);
+        }
+        ESP_LOGI(TAG, "Supply restored — resuming");
+        transition_state(resume_state_);
+    }
+
     if (state_ != core::SystemState::Operating && state_ != core::SystemState::Tampered) {
         return GS_MAKE_ERROR(core::ErrorCode::InvalidState);
     }
 
+    // Supply-fail sense comes first: checkpoint before any radio work
+    if (supply_failed()) {
+        GS_TRY(handle_power_loss());
+        return GS_MAKE_ERROR(core::ErrorCode::PowerLossDetected);
+    }
+
+    const uint64_t cycle_start_us = platform_->time->get_timestamp_us();
     core::timestamp_t current_time = platform_->time->get_timestamp_ms();
 
+    // A tamper edge escalates the sampling rate before debounce confirms it
+    if (adaptive_sampler_.is_enabled()) {
+        if (tamper_detector_.is_trigger_pending()) {
+            adaptive_sampler_.notify_tamper();
+        }
+        adaptive_sampler_.poll(current_time);
+        sync_sampling_profile();
+    }
+
     // Process deferred tamper debounce (ISR sets flag, poll confirms)
     {
         auto poll_result = tamper_detector_.poll();
@@ -156,25 +322,71 @@ core::Result<void> GridShieldSystem::process_cycle() noexcept
     }
 
     // Process periodic reading
-    if (current_time - last_reading_ >= config_.reading_interval_ms) {
-        // PRODUCTION: Read actual meter hardware
+    const bool reading_due = adaptive_sampler_.is_enabled()
+                                 ? adaptive_sampler_.due(current_time)
+                                 : current_time - last_reading_ >= config_.reading_interval_ms;
+    if (reading_due && config_.sensor_config.enable_three_phase &&
+        sensor_manager_.is_initialized()) {
+        // Three-phase front end: one sampled window per reading
+        auto phase_result = sensor_manager_.read_three_phase(current_time);
+        if (phase_result.is_ok()) {
+            auto result = send_three_phase_reading(phase_result.value());
+            // Non-critical error
+            (void)result;
+            observe_sampling(three_phase_observation(phase_result.value()), current_time);
+        }
+        last_reading_ = current_time;
+    } else if (reading_due) {
+        // Sensor front end when configured (this also feeds the flight
+        // recorder), else a simulated reading
+        auto sensor_result = sensor_manager_.is_initialized()
+                                 ? sensor_manager_.read_all()
+                                 : core::Result<hardware::SensorData>{
+                                       GS_MAKE_ERROR(core::ErrorCode::SystemNotInitialized)};
         core::MeterReading reading;
-        reading.timestamp = current_time;
-        reading.energy_wh = MOCK_ENERGY_WH;
-        reading.voltage_mv = MOCK_VOLTAGE_MV;
-        reading.current_ma = MOCK_CURRENT_MA;
-        reading.power_factor = MOCK_POWER_FACTOR;
+        if (sensor_result.is_ok()) {
+            reading =
+                hardware::SensorManager::to_meter_reading(sensor_result.value(), current_time);
+        } else {
+            reading.timestamp = current_time;
+            reading.energy_wh = MOCK_ENERGY_WH;
+            reading.voltage_mv = MOCK_VOLTAGE_MV;
+            reading.current_ma = MOCK_CURRENT_MA;
+            reading.power_factor = MOCK_POWER_FACTOR;
+        }
 
         auto result = send_meter_reading(reading);
         // Non-critical error
         (void)result;
         last_reading_ = current_time;
+        observe_sampling(sensor_result.is_ok()
+                             ? sensor_manager_.to_sampling_observation(sensor_result.value())
+                             : meter_observation(reading),
+                         current_time);
     }
 
     // Perform cross-layer validation periodically
     auto validation_result = perform_cross_layer_validation();
     (void)validation_result;
 
+    // Periodic warm-boot checkpoint of learned analytics state
+    if (config_.checkpoint_interval_ms > 0 &&
+        current_time - last_checkpoint_ >= config_.checkpoint_interval_ms) {
+        auto checkpoint_result = checkpoint_state();
+        // Non-critical: retried next interval
+        (void)checkpoint_result;
+        last_checkpoint_ = current_time;
+    }
+
+    // Background jobs: a bounded slice after the foreground work, so they
+    // always progress but never stretch a cycle by more than one step
+    (void)jobs_.run(*platform_->time, config_.job_budget_us);
+
+    const auto cycle_us =
+        static_cast<uint32_t>(platform_->time->get_timestamp_us() - cycle_start_us);
+    telemetry_.record_cycle_latency(
+        cycle_us, cycle_us > static_cast<uint64_t>(reading_interval_ms(current_time)) * 1000U);
+
     return core::Result<void>{};
 }
 
@@ -186,29 +398,112 @@ core::Result<void> GridShieldSystem::send_meter_reading(const core::MeterReading
     }
 
     // Analyze for anomalies first
+    bool urgent = tamper_detector_.is_tampered();
     auto analysis_result = anomaly_detector_.analyze(reading);
     if (analysis_result.is_ok()) {
         const auto& report = analysis_result.value();
         if (report.severity >= analytics::AnomalySeverity::High) {
+            urgent = true;
             validation_state_.consumption_anomaly_detected = true;
+            trigger_flight_recorder(forensics::FlightTrigger{anomaly_event_type(report.type),
+                                                             event_severity(report.severity),
+                                                             forensics::SourceLayer::Analytics,
+                                                             report.timestamp});
         }
     }
 
-    // Update consumption profile
-    GS_TRY(anomaly_detector_.update_profile(reading));
+    // Update consumption profile; burst readings around a suspected tamper
+    // are analysed but not learned
+    if (adaptive_sampler_.mode() == hardware::SamplingMode::Idle) {
+        GS_TRY(anomaly_detector_.update_profile(reading));
+    }
+
+    // Report by exception: unchanged readings stay off the air
+    if (report_policy_.evaluate(reading, urgent) == network::ReportReason::Suppressed) {
+        return core::Result<void>{};
+    }
+    const core::MeterReading outgoing = report_policy_.outgoing(reading);
 
     // Build packet
     network::SecurePacket packet;
+    GS_TRY(stamp_sequence(packet));
     GS_TRY(packet.build(network::PacketType::MeterData,
                         config_.meter_id,
                         core::Priority::Normal,
-                        reinterpret_cast<const uint8_t*>(&reading),
+                        reinterpret_cast<const uint8_t*>(&outgoing),
                         sizeof(core::MeterReading),
                         *crypto_engine_,
                         device_keypair_));
 
     // Send packet
-    return packet_transport_->send_packet(packet, *crypto_engine_, device_keypair_);
+    GS_TRY(packet_transport_->send_packet(packet, *crypto_engine_, device_keypair_));
+    report_policy_.commit(reading, outgoing);
+    mark_boot_phase(core::BootPhase::FirstSignedReading);
+    return core::Result<void>{};
+}
+
+core::Result<void>
+GridShieldSystem::send_three_phase_reading(const core::ThreePhaseReading& reading) noexcept
+{
+    if (!initialized_ || crypto_engine_ == nullptr || packet_transport_ == nullptr) {
+        return GS_MAKE_ERROR(core::ErrorCode::SystemNotInitialized);
+    }
+
+    // Phase rules see what the whole-meter detector cannot (one phase bypassed)
+    bool urgent = tamper_detector_.is_tampered();
+    auto phase_result = phase_rules_.evaluate(reading);
+    if (phase_result.is_ok()) {
+        const auto& report = phase_result.value();
+        if (report.severity >= analytics::AnomalySeverity::High) {
+            urgent = true;
+            validation_state_.consumption_anomaly_detected = true;
+            trigger_flight_recorder(
+                forensics::FlightTrigger{forensics::SecurityEventType::PhaseAnomaly,
+                                         event_severity(report.severity),
+                                         forensics::SourceLayer::Analytics,
+                                         report.timestamp});
+        }
+    }
+
+    const core::MeterReading total = aggregate_reading(reading);
+    auto analysis_result = anomaly_detector_.analyze(total);
+    if (analysis_result.is_ok()) {
+        const auto& report = analysis_result.value();
+        if (report.severity >= analytics::AnomalySeverity::High) {
+            urgent = true;
+            validation_state_.consumption_anomaly_detected = true;
+            trigger_flight_recorder(forensics::FlightTrigger{anomaly_event_type(report.type),
+                                                             event_severity(report.severity),
+                                                             forensics::SourceLayer::Analytics,
+                                                             report.timestamp});
+        }
+    }
+    if (adaptive_sampler_.mode() == hardware::SamplingMode::Idle) {
+        GS_TRY(anomaly_detector_.update_profile(total));
+    }
+
+    // Report by exception on the totals; the record carries the absorbed energy
+    if (report_policy_.evaluate(total, urgent) == network::ReportReason::Suppressed) {
+        return core::Result<void>{};
+    }
+    const core::MeterReading outgoing_total = report_policy_.outgoing(total);
+    core::ThreePhaseReading outgoing = reading;
+    outgoing.energy_wh = outgoing_total.energy_wh;
+
+    network::SecurePacket packet;
+    GS_TRY(stamp_sequence(packet));
+    GS_TRY(packet.build(network::PacketType::ThreePhaseData,
+                        config_.meter_id,
+                        core::Priority::Normal,
+                        reinterpret_cast<const uint8_t*>(&outgoing),
+                        sizeof(core::ThreePhaseReading),
+                        *crypto_engine_,
+                        device_keypair_));
+
+    GS_TRY(packet_transport_->send_packet(packet, *crypto_engine_, device_keypair_));
+    report_policy_.commit(total, outgoing_total);
+    mark_boot_phase(core::BootPhase::FirstSignedReading);
+    return core::Result<void>{};
 }
 
 core::Result<void> GridShieldSystem::send_tamper_alert() noexcept
@@ -224,6 +519,7 @@ core::Result<void> GridShieldSystem::send_tamper_alert() noexcept
     event.sensor_id = config_.tamper_config.sensor_pin;
 
     network::SecurePacket packet;
+    GS_TRY(stamp_sequence(packet));
     GS_TRY(packet.build(network::PacketType::TamperAlert,
                         config_.meter_id,
                         core::Priority::Emergency,
@@ -250,6 +546,7 @@ core::Result<void> GridShieldSystem::send_heartbeat() noexcept
     }
 
     network::SecurePacket packet;
+    GS_TRY(stamp_sequence(packet));
     GS_TRY(packet.build(network::PacketType::Heartbeat,
                         config_.meter_id,
                         core::Priority::Low,
@@ -261,6 +558,71 @@ core::Result<void> GridShieldSystem::send_heartbeat() noexcept
     return packet_transport_->send_packet(packet, *crypto_engine_, device_keypair_);
 }
 
+core::Result<void> GridShieldSystem::checkpoint_state() noexcept
+{
+    if (!initialized_) {
+        return GS_MAKE_ERROR(core::ErrorCode::SystemNotInitialized);
+    }
+    if (platform_->storage == nullptr) {
+        return GS_MAKE_ERROR(core::ErrorCode::NotSupported);
+    }
+
+    analytics::DetectorCheckpoint checkpoint;
+    anomaly_detector_.export_state(checkpoint);
+
+    core::WarmBootStore store(*platform_);
+    // Payload and header go out under one commit; the checkpoint is only
+    // durable once the batch is committed (write-back backends flush here)
+    GS_TRY(platform_->storage->begin_batch());
+    auto save_result = store.save(core::WarmBootRecord::Detector, checkpoint);
+    auto commit_result = platform_->storage->commit();
+    GS_TRY(save_result);
+    return commit_result;
+}
+
+core::Result<void> GridShieldSystem::handle_power_loss() noexcept
+{
+    if (!initialized_) {
+        return GS_MAKE_ERROR(core::ErrorCode::SystemNotInitialized);
+    }
+
+    // Last gasp: logged immediately, the deferred ring would not drain in time
+    ESP_LOGW(TAG, "Brownout — checkpointing state");
+    if (state_ != core::SystemState::PowerLoss) {
+        resume_state_ = state_;
+    }
+    transition_state(core::SystemState::PowerLoss);
+    return checkpoint_state();
+}
+
+bool GridShieldSystem::supply_failed() noexcept
+{
+    // The backup-power sense line reads low once mains is gone
+    const uint8_t pin = config_.tamper_config.backup_power_pin;
+    if (pin == 0 || platform_->gpio == nullptr) {
+        return false;
+    }
+    auto level = platform_->gpio->read(pin);
+    return level.is_ok() && !level.value();
+}
+
+core::Result<void> GridShieldSystem::restore_analytics_state() noexcept
+{
+    if (platform_->storage == nullptr) {
+        return GS_MAKE_ERROR(core::ErrorCode::NotSupported);
+    }
+
+    analytics::DetectorCheckpoint checkpoint;
+    core::WarmBootStore store(*platform_);
+    GS_TRY(store.load(core::WarmBootRecord::Detector, checkpoint));
+    GS_TRY(anomaly_detector_.restore_state(checkpoint));
+    ESP_LOGI(TAG,
+             "Analytics restored (confidence=%u, window=%u)",
+             static_cast<unsigned>(checkpoint.profile.profile_confidence),
+             static_cast<unsigned>(checkpoint.recent_count));
+    return core::Result<void>{};
+}
+
 core::Result<void> GridShieldSystem::init_network_layer() noexcept
 {
     if (platform_->comm == nullptr) {
@@ -297,14 +659,35 @@ core::Result<void> GridShieldSystem::initialize_crypto() noexcept
         return GS_MAKE_ERROR(core::ErrorCode::ResourceExhausted);
     }
 
-    // Generate device keypair
-    GS_TRY(crypto_engine_->generate_keypair(device_keypair_));
-    ESP_LOGI(TAG, "Device keypair generated");
+    // No persistent storage: ephemeral identity (legacy behaviour)
+    if (platform_->storage == nullptr) {
+        GS_TRY(crypto_engine_->generate_keypair(device_keypair_));
+        GS_TRY(crypto_engine_->generate_keypair(server_public_key_));
+        return core::Result<void>{};
+    }
 
-    // PRODUCTION: Load server public key from secure storage
-    // For now: Generate placeholder
-    GS_TRY(crypto_engine_->generate_keypair(server_public_key_));
+    // Device identity: Primary slot, then Backup; keygen only on first boot
+    security::KeyStorage key_storage(*platform_);
+    bool warm_keys = true;
+    if (key_storage.load(device_keypair_, security::KeySlot::Primary).is_error() &&
+        key_storage.load(device_keypair_, security::KeySlot::Backup).is_error()) {
+        warm_keys = false;
+        device_keypair_.clear();
+        GS_TRY(crypto_engine_->generate_keypair(device_keypair_));
+        GS_TRY(key_storage.save(device_keypair_, security::KeySlot::Primary));
+        ESP_LOGI(TAG, "First boot — device keypair generated and stored");
+    }
 
+    // PRODUCTION: server public key is provisioned into KeySlot::ServerPublic.
+    // Until then a placeholder is generated once and persisted.
+    if (key_storage.load_public_key(server_public_key_).is_error()) {
+        warm_keys = false;
+        server_public_key_.clear();
+        GS_TRY(crypto_engine_->generate_keypair(server_public_key_));
+        GS_TRY(key_storage.save_public_key(server_public_key_));
+    }
+
+    telemetry_.set_warm_boot(warm_keys, false);
     return core::Result<void>{};
 }
 
@@ -317,6 +700,12 @@ core::Result<void> GridShieldSystem::handle_tamper_event() noexcept
     validation_state_.physical_tamper_detected = true;
     validation_state_.validation_timestamp = platform_->time->get_timestamp_ms();
 
+    trigger_flight_recorder(
+        forensics::FlightTrigger{tamper_event_type(tamper_detector_.get_tamper_type()),
+                                 forensics::SecurityEventSeverity::Critical,
+                                 forensics::SourceLayer::Physical,
+                                 validation_state_.validation_timestamp});
+
     // Send immediate tamper alert
     auto result = send_tamper_alert();
     if (result.is_error()) {
@@ -326,6 +715,58 @@ core::Result<void> GridShieldSystem::handle_tamper_event() noexcept
     return core::Result<void>{};
 }
 
+core::Result<void> GridShieldSystem::stamp_sequence(network::SecurePacket& packet) noexcept
+{
+    auto seq = tx_sequence_.next();
+    if (seq.is_error()) {
+        return seq.error();
+    }
+    packet.set_sequence(seq.value());
+    return core::Result<void>{};
+}
+
+uint32_t GridShieldSystem::reading_interval_ms(core::timestamp_t now) const noexcept
+{
+    return adaptive_sampler_.is_enabled() ? adaptive_sampler_.interval_ms(now)
+                                          : config_.reading_interval_ms;
+}
+
+void GridShieldSystem::observe_sampling(const hardware::SamplingObservation& obs,
+                                        core::timestamp_t now) noexcept
+{
+    if (!adaptive_sampler_.is_enabled()) {
+        return;
+    }
+    (void)adaptive_sampler_.observe(obs, now);
+    sync_sampling_profile();
+}
+
+void GridShieldSystem::sync_sampling_profile() noexcept
+{
+    if (adaptive_sampler_.take_profile_change() && sensor_manager_.is_initialized()) {
+        // Best effort: a sensor that rejects the profile keeps its old rate
+        (void)sensor_manager_.apply_sampling_profile(adaptive_sampler_.current_profile());
+    }
+}
+
+void GridShieldSystem::attach_flight_recorder(forensics::IFlightRecorder* recorder) noexcept
+{
+    flight_recorder_ = recorder;
+    sensor_manager_.set_waveform_sink(recorder);
+}
+
+void GridShieldSystem::trigger_flight_recorder(const forensics::FlightTrigger& info) noexcept
+{
+    if (flight_recorder_ == nullptr) {
+        return;
+    }
+    // InvalidState = a window is already capturing (trigger coalesced) or
+    // its archive job is already queued; both are fine.
+    if (flight_recorder_->trigger(info).is_ok()) {
+        (void)jobs_.submit(flight_recorder_->archive_job());
+    }
+}
+
 core::Result<void> GridShieldSystem::perform_cross_layer_validation() noexcept
 {
     validation_state_.validation_timestamp = platform_->time->get_timestamp_ms();
@@ -349,6 +790,11 @@ void GridShieldSystem::transition_state(core::SystemState new_state) noexcept
     state_ = new_state;
 }
 
+void GridShieldSystem::mark_boot_phase(core::BootPhase phase) noexcept
+{
+    telemetry_.mark_boot_phase(phase, platform_->time->get_timestamp_ms());
+}
+
 void GridShieldSystem::set_mode(OperationMode new_mode) noexcept
 {
     mode_ = new_mode;
@@ -77,6 +77,11 @@ bool TamperDetector::is_tampered() const noexcept
     return is_tampered_;
 }
 
+bool TamperDetector::is_trigger_pending() const noexcept
+{
+    return pending_tamper_;
+}
+
 TamperType TamperDetector::get_tamper_type() const noexcept
 {
     return tamper_type_;
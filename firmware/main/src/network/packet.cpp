@@ -9,9 +9,9 @@
  */
 
 #include "network/packet.hpp"
-#include "esp_log.h"
+#include "utils/deferred_log.hpp"
 
-static const char* TAG = "GS_Packet";
+static constexpr char TAG[] = "GS_Packet";
 
 #include <cstring>
 
@@ -65,7 +65,7 @@ core::Result<void> SecurePacket::build(PacketType type,
     GS_TRY(compute_signature(crypto, keypair));
 
     is_valid_ = true;
-    ESP_LOGD(TAG,
+    GS_DLOGD(TAG,
              "Packet built: type=%d meter=0x%llx len=%u",
              static_cast<int>(type),
              static_cast<unsigned long long>(meter_id),
@@ -96,7 +96,7 @@ core::Result<void> SecurePacket::parse(const uint8_t* buffer,
 
     // Verify magic numbers
     if (GS_UNLIKELY(header_.magic_header != MAGIC_HEADER)) {
-        ESP_LOGW(TAG, "Parse failed: invalid magic header");
+        GS_DLOGW(TAG, "Parse failed: invalid magic header");
         return GS_MAKE_ERROR(core::ErrorCode::InvalidPacket);
     }
 
@@ -150,7 +150,7 @@ core::Result<void> SecurePacket::parse(const uint8_t* buffer,
                                     footer_.signature.data());
 
     if (sig_verify.is_error() || !sig_verify.value()) {
-        ESP_LOGW(TAG, "Parse failed: signature verification failed");
+        GS_DLOGW(TAG, "Parse failed: signature verification failed");
         return GS_MAKE_ERROR(core::ErrorCode::SignatureInvalid);
     }
 
@@ -257,7 +257,7 @@ core::Result<void> PacketTransport::send_packet(const SecurePacket& packet,
     }
 
     if (GS_UNLIKELY(send_result.value() != packet_size)) {
-        ESP_LOGE(TAG,
+        GS_DLOGE(TAG,
                  "Send incomplete: sent %u of %u bytes",
                  static_cast<unsigned>(send_result.value()),
                  static_cast<unsigned>(packet_size));
@@ -271,29 +271,75 @@ core::Result<SecurePacket> PacketTransport::receive_packet(security::ICryptoEngi
                                                            const security::ECCKeyPair& keypair,
                                                            uint32_t timeout_ms) noexcept
 {
-
-    std::array<uint8_t, sizeof(PacketHeader) + MAX_PAYLOAD_SIZE + sizeof(PacketFooter)> buffer{};
-
-    auto recv_result = comm_.receive(buffer.data(), sizeof(buffer), timeout_ms);
-    if (recv_result.is_error()) {
-        return core::Result<SecurePacket>{recv_result.error()};
-    }
-
-    const size_t received_bytes = recv_result.value();
     const size_t min_size = sizeof(PacketHeader) + sizeof(PacketFooter);
 
-    if (GS_UNLIKELY(received_bytes < min_size)) {
-        return core::Result<SecurePacket>{GS_MAKE_ERROR(core::ErrorCode::InvalidPacket)};
+    for (;;) {
+        resync();
+
+        if (rx_fill_ >= sizeof(PacketHeader)) {
+            PacketHeader header;
+            memcpy(&header, rx_buffer_.data(), sizeof(PacketHeader));
+            if (GS_UNLIKELY(header.version != PROTOCOL_VERSION ||
+                            header.payload_length > MAX_PAYLOAD_SIZE)) {
+                consume(1); // false magic, keep scanning
+                continue;
+            }
+
+            const size_t frame_size = min_size + header.payload_length;
+            if (rx_fill_ >= frame_size) {
+                SecurePacket packet;
+                auto parse_result = packet.parse(rx_buffer_.data(), frame_size, crypto, keypair);
+                if (parse_result.is_error()) {
+                    // Drop only the magic byte: a truncated frame may hide the next one
+                    consume(1);
+                    return core::Result<SecurePacket>{parse_result.error()};
+                }
+                consume(frame_size);
+                // After the signature check, so forged frames cannot move a window
+                if (replay_guard_ != nullptr &&
+                    replay_guard_->check_and_update(packet.header().meter_id,
+                                                    packet.header().sequence) !=
+                        ReplayVerdict::Accepted) {
+                    GS_DLOGW(TAG,
+                             "Replay rejected: meter=0x%llx seq=%u",
+                             static_cast<unsigned long long>(packet.header().meter_id),
+                             static_cast<unsigned>(packet.header().sequence));
+                    return core::Result<SecurePacket>{
+                        GS_MAKE_ERROR(core::ErrorCode::ReplayDetected)};
+                }
+                return core::Result<SecurePacket>{GS_MOVE(packet)};
+            }
+        }
+
+        const size_t space = rx_buffer_.size() - rx_fill_;
+        auto recv_result = comm_.receive(rx_buffer_.data() + rx_fill_, space, timeout_ms);
+        if (recv_result.is_error()) {
+            return core::Result<SecurePacket>{recv_result.error()};
+        }
+        if (recv_result.value() == 0) {
+            return core::Result<SecurePacket>{GS_MAKE_ERROR(core::ErrorCode::NetworkTimeout)};
+        }
+        rx_fill_ += recv_result.value();
     }
+}
 
-    SecurePacket packet;
-    auto parse_result = packet.parse(buffer.data(), received_bytes, crypto, keypair);
+void PacketTransport::consume(size_t count) noexcept
+{
+    count = count < rx_fill_ ? count : rx_fill_;
+    memmove(rx_buffer_.data(), rx_buffer_.data() + count, rx_fill_ - count);
+    rx_fill_ -= count;
+}
 
-    if (parse_result.is_error()) {
-        return core::Result<SecurePacket>{parse_result.error()};
+void PacketTransport::resync() noexcept
+{
+    size_t skip = 0;
+    while (skip < rx_fill_ && rx_buffer_[skip] != MAGIC_HEADER) {
+        ++skip;
+    }
+    if (skip > 0) {
+        GS_DLOGD(TAG, "Resync: skipped %u bytes", static_cast<unsigned>(skip));
+        consume(skip);
     }
-
-    return core::Result<SecurePacket>{GS_MOVE(packet)};
 }
 
 } // namespace gridshield::network
\ No newline at end of file
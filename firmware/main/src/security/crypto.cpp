@@ -14,8 +14,9 @@
 
 #include "security/crypto.hpp"
 #include "esp_log.h"
+#include "utils/deferred_log.hpp"
 
-static const char* TAG = "GS_Crypto";
+static constexpr char TAG[] = "GS_Crypto";
 
 #include <cstring>
 
@@ -217,7 +218,7 @@ core::Result<void> CryptoEngine::sign(const ECCKeyPair& keypair,
         return GS_MAKE_ERROR(core::ErrorCode::SignatureInvalid);
     }
 
-    ESP_LOGD(TAG, "ECDSA sign OK (msg_len=%u)", static_cast<unsigned>(msg_len));
+    GS_DLOGD(TAG, "ECDSA sign OK (msg_len=%u)", static_cast<unsigned>(msg_len));
     return core::Result<void>{};
 
 #else
@@ -326,7 +327,7 @@ core::Result<size_t> CryptoEngine::encrypt_aes_gcm(const uint8_t* key,
         return core::Result<size_t>{GS_MAKE_ERROR(core::ErrorCode::EncryptionFailed)};
     }
 
-    ESP_LOGD(TAG, "AES-GCM encrypt OK (len=%u)", static_cast<unsigned>(pt_len));
+    GS_DLOGD(TAG, "AES-GCM encrypt OK (len=%u)", static_cast<unsigned>(pt_len));
     return core::Result<size_t>{pt_len};
 
 #else
@@ -375,7 +376,7 @@ core::Result<size_t> CryptoEngine::decrypt_aes_gcm(const uint8_t* key,
 
     if (ret != 0) {
         // Auth tag mismatch or decrypt error
-        ESP_LOGW(TAG, "AES-GCM auth failed (integrity violation)");
+        GS_DLOGW(TAG, "AES-GCM auth failed (integrity violation)");
         return core::Result<size_t>{GS_MAKE_ERROR(core::ErrorCode::IntegrityViolation)};
     }
 
@@ -0,0 +1,307 @@
+/**
+ * @file log_decode.cpp
+ * @author zuudevs (zuudevs@gmail.com)
+ * @brief Host decoder for deferred binary log streams
+ * @version 1.0
+ * @date 2026-03-21
+ *
+ * Formats a GS_DLOGx record stream (DeferredLog::drain_raw() output, e.g.
+ * captured from the UART or a flash dump) using the format strings of the
+ * firmware ELF that produced it. Format ids are addresses on 32-bit
+ * targets and offsets from the gs_dlog_anchor symbol on 64-bit hosts, so
+ * the ELF must be the exact build that ran; 64-bit images also need their
+ * symbol table (unstripped).
+ *
+ *   gridshield_log_decode --elf build/gridshield.elf [--input log.bin]
+ *
+ * Reads stdin when --input is omitted. Bytes that do not start a record
+ * are skipped, so a capture may begin mid-record.
+ *
+ * @copyright Copyright (c) 2026
+ */
+
+#include "utils/deferred_log.hpp"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+using namespace gridshield;
+
+// ============================================================================
+// ELF IMAGE
+// ============================================================================
+namespace {
+
+constexpr uint32_t SHT_SYMTAB = 2;
+constexpr uint64_t SHF_ALLOC = 0x2;
+constexpr uint32_t SHT_NOBITS = 8;
+
+struct Section
+{
+    uint64_t addr{0};
+    uint64_t offset{0};
+    uint64_t size{0};
+};
+
+class ElfImage
+{
+public:
+    bool load(const char* path)
+    {
+        FILE* f = std::fopen(path, "rb");
+        if (f == nullptr) {
+            std::fprintf(stderr, "cannot open %s\n", path);
+            return false;
+        }
+        uint8_t chunk[65536];
+        size_t n = 0;
+        while ((n = std::fread(chunk, 1, sizeof(chunk), f)) > 0) {
+            bytes_.insert(bytes_.end(), chunk, chunk + n);
+        }
+        std::fclose(f);
+
+        if (bytes_.size() < 64 || std::memcmp(bytes_.data(), "\x7f" "ELF", 4) != 0 ||
+            bytes_[5] != 1) {
+            std::fprintf(stderr, "%s: not a little-endian ELF file\n", path);
+            return false;
+        }
+        is64_ = bytes_[4] == 2;
+        target_.long_words = is64_ ? 2 : 1;
+        target_.pointer_words = is64_ ? 2 : 1;
+        return read_sections() && (!is64_ || find_anchor());
+    }
+
+    /// NUL-terminated string at virtual address @p addr, or nullptr.
+    const char* string_at(uint64_t addr) const
+    {
+        for (const auto& s : sections_) {
+            if (addr >= s.addr && addr < s.addr + s.size) {
+                const uint64_t off = s.offset + (addr - s.addr);
+                const uint64_t end = s.offset + s.size;
+                const void* nul = std::memchr(&bytes_[off], '\0', end - off);
+                return nul == nullptr ? nullptr : reinterpret_cast<const char*>(&bytes_[off]);
+            }
+        }
+        return nullptr;
+    }
+
+    const char* descriptor(uint32_t id) const
+    {
+        if (!is64_) {
+            return string_at(id);
+        }
+        return string_at(anchor_ + static_cast<uint64_t>(static_cast<int64_t>(
+                                       static_cast<int32_t>(id))));
+    }
+
+    utils::DeferredLogTarget target() const
+    {
+        return target_;
+    }
+
+private:
+    uint64_t read(uint64_t off, size_t width) const
+    {
+        uint64_t v = 0;
+        if (off + width > bytes_.size()) {
+            return 0;
+        }
+        for (size_t i = 0; i < width; ++i) {
+            v |= static_cast<uint64_t>(bytes_[off + i]) << (8 * i);
+        }
+        return v;
+    }
+
+    struct RawSection
+    {
+        uint32_t type;
+        uint64_t flags;
+        uint64_t addr;
+        uint64_t offset;
+        uint64_t size;
+        uint32_t link;
+        uint64_t entsize;
+    };
+
+    RawSection section_header(size_t index) const
+    {
+        const uint64_t shoff = is64_ ? read(0x28, 8) : read(0x20, 4);
+        const uint64_t shentsize = read(is64_ ? 0x3A : 0x2E, 2);
+        const uint64_t h = shoff + index * shentsize;
+        RawSection s{};
+        s.type = static_cast<uint32_t>(read(h + 4, 4));
+        if (is64_) {
+            s.flags = read(h + 8, 8);
+            s.addr = read(h + 16, 8);
+            s.offset = read(h + 24, 8);
+            s.size = read(h + 32, 8);
+            s.link = static_cast<uint32_t>(read(h + 40, 4));
+            s.entsize = read(h + 56, 8);
+        } else {
+            s.flags = read(h + 8, 4);
+            s.addr = read(h + 12, 4);
+            s.offset = read(h + 16, 4);
+            s.size = read(h + 20, 4);
+            s.link = static_cast<uint32_t>(read(h + 24, 4));
+            s.entsize = read(h + 36, 4);
+        }
+        return s;
+    }
+
+    size_t section_count() const
+    {
+        return static_cast<size_t>(read(is64_ ? 0x3C : 0x30, 2));
+    }
+
+    bool read_sections()
+    {
+        for (size_t i = 0; i < section_count(); ++i) {
+            const RawSection s = section_header(i);
+            if ((s.flags & SHF_ALLOC) != 0 && s.type != SHT_NOBITS && s.size > 0 &&
+                s.offset + s.size <= bytes_.size()) {
+                sections_.push_back(Section{s.addr, s.offset, s.size});
+            }
+        }
+        if (sections_.empty()) {
+            std::fprintf(stderr, "ELF has no loadable data\n");
+            return false;
+        }
+        return true;
+    }
+
+    bool find_anchor()
+    {
+        for (size_t i = 0; i < section_count(); ++i) {
+            const RawSection symtab = section_header(i);
+            if (symtab.type != SHT_SYMTAB || symtab.entsize == 0) {
+                continue;
+            }
+            const RawSection strtab = section_header(symtab.link);
+            for (uint64_t off = symtab.offset; off + symtab.entsize <= symtab.offset + symtab.size;
+                 off += symtab.entsize) {
+                const uint64_t name = read(off, 4);
+                const uint64_t value = read(off + 8, 8);
+                if (strtab.offset + name >= bytes_.size()) {
+                    continue;
+                }
+                const char* sym = reinterpret_cast<const char*>(&bytes_[strtab.offset + name]);
+                if (std::strstr(sym, "gs_dlog_anchor") != nullptr && value != 0) {
+                    anchor_ = value;
+                    return true;
+                }
+            }
+        }
+        std::fprintf(stderr, "gs_dlog_anchor not found (64-bit ELF must not be stripped)\n");
+        return false;
+    }
+
+    std::vector<uint8_t> bytes_;
+    std::vector<Section> sections_;
+    utils::DeferredLogTarget target_{};
+    uint64_t anchor_{0};
+    bool is64_{false};
+};
+
+uint32_t word_at(const std::vector<uint8_t>& data, size_t off)
+{
+    return static_cast<uint32_t>(data[off]) | (static_cast<uint32_t>(data[off + 1]) << 8) |
+           (static_cast<uint32_t>(data[off + 2]) << 16) |
+           (static_cast<uint32_t>(data[off + 3]) << 24);
+}
+
+} // namespace
+
+// ============================================================================
+// ENTRY POINT
+// ============================================================================
+int main(int argc, char** argv)
+{
+    const char* elf_path = nullptr;
+    const char* input_path = nullptr;
+    for (int i = 1; i + 1 < argc; i += 2) {
+        if (std::strcmp(argv[i], "--elf") == 0) {
+            elf_path = argv[i + 1];
+        } else if (std::strcmp(argv[i], "--input") == 0) {
+            input_path = argv[i + 1];
+        }
+    }
+    if (elf_path == nullptr || (argc % 2) == 0) {
+        std::printf("usage: %s --elf FIRMWARE.elf [--input LOG.bin]\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    ElfImage elf;
+    if (!elf.load(elf_path)) {
+        return EXIT_FAILURE;
+    }
+
+    FILE* in = input_path == nullptr ? stdin : std::fopen(input_path, "rb");
+    if (in == nullptr) {
+        std::fprintf(stderr, "cannot open %s\n", input_path);
+        return EXIT_FAILURE;
+    }
+    std::vector<uint8_t> data;
+    uint8_t chunk[4096];
+    size_t n = 0;
+    while ((n = std::fread(chunk, 1, sizeof(chunk), in)) > 0) {
+        data.insert(data.end(), chunk, chunk + n);
+    }
+    if (in != stdin) {
+        std::fclose(in);
+    }
+
+    size_t records = 0;
+    size_t skipped = 0;
+    size_t unknown = 0;
+    char text[utils::DLOG_LINE_SIZE];
+    for (size_t off = 0; off + 4 * utils::DLOG_HEADER_WORDS <= data.size();) {
+        const uint32_t first = word_at(data, off);
+        const uint32_t len = first & ~utils::DLOG_MAGIC_MASK;
+        if ((first & utils::DLOG_MAGIC_MASK) != utils::DLOG_RECORD_MAGIC ||
+            len < utils::DLOG_HEADER_WORDS || len > utils::DLOG_MAX_RECORD_WORDS ||
+            off + 4 * len > data.size()) {
+            ++off; // resync byte by byte
+            ++skipped;
+            continue;
+        }
+        uint32_t words[utils::DLOG_MAX_RECORD_WORDS];
+        for (uint32_t k = 0; k < len; ++k) {
+            words[k] = word_at(data, off + 4 * k);
+        }
+        off += 4 * len;
+
+        char level = '?';
+        const char* tag = nullptr;
+        size_t tag_len = 0;
+        const char* fmt = nullptr;
+        if (!utils::split_descriptor(elf.descriptor(words[1]), level, tag, tag_len, fmt)) {
+            std::printf("? (%u) <unknown format id 0x%08x>\n",
+                        static_cast<unsigned>(words[2]),
+                        static_cast<unsigned>(words[1]));
+            ++unknown;
+            continue;
+        }
+        utils::format_record(fmt,
+                             &words[utils::DLOG_HEADER_WORDS],
+                             len - utils::DLOG_HEADER_WORDS,
+                             text,
+                             sizeof(text),
+                             elf.target());
+        std::printf("%c (%u) %.*s: %s\n",
+                    level,
+                    static_cast<unsigned>(words[2]),
+                    static_cast<int>(tag_len),
+                    tag,
+                    text);
+        ++records;
+    }
+
+    std::fprintf(stderr,
+                 "%zu records, %zu unknown ids, %zu bytes skipped\n",
+                 records,
+                 unknown,
+                 skipped);
+    return unknown == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,301 @@
+/**
+ * @file native_main.cpp
+ * @author zuudevs (zuudevs@gmail.com)
+ * @brief Linux entry point: GridShieldSystem on the POSIX platform in real time
+ * @version 1.0
+ * @date 2026-03-14
+ *
+ * Runs process_cycle() on a fixed period against real sockets, a persistent
+ * flash image and replayed sensor captures. Intended for soak tests, perf
+ * profiling and gateway duty.
+ *
+ *   gridshield_native [--flash PATH] [--udp HOST:PORT | --tcp HOST:PORT |
+ *                      --listen PORT] [--adc FILE] [--i2c FILE] [--uart FILE]
+ *                     [--uart-tx FILE] [--period MS] [--cycles N] [--no-loop]
+ *
+ * Signals: SIGINT/SIGTERM shut down cleanly (flash image flushed);
+ *          SIGUSR1 asserts the tamper input; SIGUSR2 prints counters.
+ *
+ * @copyright Copyright (c) 2026
+ */
+
+#include "core/system.hpp"
+#include "platform/posix_platform.hpp"
+#include "utils/deferred_log.hpp"
+
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include "esp_log.h"
+
+static const char* TAG = "GS-Native";
+
+using namespace gridshield;
+
+// ============================================================================
+// STATE (static, no heap)
+// ============================================================================
+static platform::posix::PosixPlatform posix_platform;
+static GridShieldSystem gs_system;
+
+static volatile sig_atomic_t stop_requested = 0;
+static volatile sig_atomic_t tamper_requested = 0;
+static volatile sig_atomic_t stats_requested = 0;
+
+static constexpr uint8_t TAMPER_PIN = 4;
+static constexpr size_t MAX_HOST_LENGTH = 64;
+
+struct NativeOptions
+{
+    platform::posix::PosixPlatformConfig platform{};
+    char host[MAX_HOST_LENGTH]{"127.0.0.1"};
+    uint32_t period_ms{100};
+    uint64_t cycles{0}; // 0 = run until signalled
+};
+
+// ============================================================================
+// SIGNALS
+// ============================================================================
+static void on_signal(int signum)
+{
+    switch (signum) {
+    case SIGUSR1:
+        tamper_requested = 1;
+        break;
+    case SIGUSR2:
+        stats_requested = 1;
+        break;
+    default:
+        stop_requested = 1;
+        break;
+    }
+}
+
+static void install_signal_handlers()
+{
+    struct sigaction action
+    {};
+    action.sa_handler = on_signal;
+    sigemptyset(&action.sa_mask);
+    sigaction(SIGINT, &action, nullptr);
+    sigaction(SIGTERM, &action, nullptr);
+    sigaction(SIGUSR1, &action, nullptr);
+    sigaction(SIGUSR2, &action, nullptr);
+    signal(SIGPIPE, SIG_IGN);
+}
+
+// ============================================================================
+// COMMAND LINE
+// ============================================================================
+static void print_usage(const char* argv0)
+{
+    std::printf("usage: %s [--flash PATH] [--udp HOST:PORT | --tcp HOST:PORT | --listen PORT]\n"
+                "          [--adc FILE] [--i2c FILE] [--uart FILE] [--uart-tx FILE]\n"
+                "          [--period MS] [--cycles N] [--no-loop]\n",
+                argv0);
+}
+
+/// Split HOST:PORT into @p opts.host and return the port (0 on error).
+static uint16_t parse_endpoint(const char* text, NativeOptions& opts)
+{
+    const char* colon = std::strrchr(text, ':');
+    if (colon == nullptr || static_cast<size_t>(colon - text) >= MAX_HOST_LENGTH) {
+        return 0;
+    }
+    std::memcpy(opts.host, text, static_cast<size_t>(colon - text));
+    opts.host[colon - text] = '\0';
+    const long port = std::strtol(colon + 1, nullptr, 10);
+    return (port > 0 && port <= 65535) ? static_cast<uint16_t>(port) : 0;
+}
+
+static bool parse_args(int argc, char** argv, NativeOptions& opts)
+{
+    auto& cfg = opts.platform;
+    for (int i = 1; i < argc; ++i) {
+        const char* arg = argv[i];
+        const char* value = (i + 1 < argc) ? argv[i + 1] : nullptr;
+        const bool takes_value = std::strcmp(arg, "--no-loop") != 0;
+        if (takes_value && value == nullptr) {
+            return false;
+        }
+
+        if (std::strcmp(arg, "--flash") == 0) {
+            cfg.flash_path = value;
+        } else if (std::strcmp(arg, "--udp") == 0) {
+            cfg.transport = platform::posix::PosixPlatformConfig::Transport::Udp;
+            cfg.udp.peer_port = parse_endpoint(value, opts);
+            cfg.udp.peer_host = opts.host;
+            if (cfg.udp.peer_port == 0) {
+                return false;
+            }
+        } else if (std::strcmp(arg, "--tcp") == 0) {
+            cfg.transport = platform::posix::PosixPlatformConfig::Transport::Tcp;
+            cfg.tcp.port = parse_endpoint(value, opts);
+            cfg.tcp.host = opts.host;
+            if (cfg.tcp.port == 0) {
+                return false;
+            }
+        } else if (std::strcmp(arg, "--listen") == 0) {
+            cfg.transport = platform::posix::PosixPlatformConfig::Transport::Tcp;
+            cfg.tcp.role = platform::posix::TcpConfig::Role::Server;
+            cfg.tcp.host = "0.0.0.0";
+            cfg.tcp.port = static_cast<uint16_t>(std::strtol(value, nullptr, 10));
+        } else if (std::strcmp(arg, "--adc") == 0) {
+            cfg.adc_replay = value;
+        } else if (std::strcmp(arg, "--i2c") == 0) {
+            cfg.i2c_replay = value;
+        } else if (std::strcmp(arg, "--uart") == 0) {
+            cfg.uart_replay = value;
+        } else if (std::strcmp(arg, "--uart-tx") == 0) {
+            cfg.uart_tx_log = value;
+        } else if (std::strcmp(arg, "--period") == 0) {
+            opts.period_ms = static_cast<uint32_t>(std::strtoul(value, nullptr, 10));
+        } else if (std::strcmp(arg, "--cycles") == 0) {
+            opts.cycles = std::strtoull(value, nullptr, 10);
+        } else if (std::strcmp(arg, "--no-loop") == 0) {
+            cfg.loop_replay = false;
+            continue;
+        } else {
+            return false;
+        }
+        ++i;
+    }
+    return opts.period_ms > 0;
+}
+
+// ============================================================================
+// SYSTEM CONFIGURATION
+// ============================================================================
+static SystemConfig create_config()
+{
+    SystemConfig config;
+    config.meter_id = 0x1234567890ABCDEF;
+    config.heartbeat_interval_ms = 60000;
+    config.reading_interval_ms = 5000;
+    config.tamper_config.sensor_pin = TAMPER_PIN;
+    config.tamper_config.debounce_ms = 50;
+
+    for (size_t i = 0; i < analytics::PROFILE_HISTORY_SIZE; ++i) {
+        config.baseline_profile.hourly_avg_wh[i] = 1200;
+    }
+    config.baseline_profile.daily_avg_wh = 1200;
+    config.baseline_profile.variance_threshold = 30;
+
+    return config;
+}
+
+static void print_counters()
+{
+    const auto& c = gs_system.telemetry().counters();
+    ESP_LOGI(TAG,
+             "cycles=%u overruns=%u last=%uus max=%uus sent=%u failed=%u",
+             static_cast<unsigned>(c.cycle_count),
+             static_cast<unsigned>(c.cycle_overruns),
+             static_cast<unsigned>(c.last_cycle_us),
+             static_cast<unsigned>(c.max_cycle_us),
+             static_cast<unsigned>(c.packets_sent),
+             static_cast<unsigned>(c.packets_failed));
+}
+
+// ============================================================================
+// DEFERRED LOG
+// ============================================================================
+static uint32_t log_clock_ms()
+{
+    return static_cast<uint32_t>(posix_platform.time().get_timestamp_ms());
+}
+
+/// Same shape as the esp_log shim: errors/warnings to stderr, the rest to stdout.
+static void print_deferred(void* /*ctx*/, const utils::DeferredLogLine& line)
+{
+    FILE* out = (line.level == 'E' || line.level == 'W') ? stderr : stdout;
+    std::fprintf(out,
+                 "%c (%.*s) [%ums] %s\n",
+                 line.level,
+                 static_cast<int>(line.tag_len),
+                 line.tag,
+                 static_cast<unsigned>(line.timestamp),
+                 line.text);
+}
+
+// ============================================================================
+// ENTRY POINT
+// ============================================================================
+int main(int argc, char** argv)
+{
+    NativeOptions opts;
+    if (!parse_args(argc, argv, opts)) {
+        print_usage(argv[0]);
+        return EXIT_FAILURE;
+    }
+    install_signal_handlers();
+
+    auto result = posix_platform.init(opts.platform);
+    if (result.is_error()) {
+        ESP_LOGE(TAG, "Platform init failed (code=%d)", static_cast<int>(result.error().code));
+        return EXIT_FAILURE;
+    }
+    auto& services = posix_platform.services();
+    utils::deferred_log().set_clock(&log_clock_ms);
+
+    // Tamper input idles high (pull-up), like the board
+    posix_platform.gpio().simulate_trigger(TAMPER_PIN, true);
+
+    result = gs_system.initialize(create_config(), services);
+    if (result.is_error()) {
+        ESP_LOGE(TAG, "Init failed (code=%d)", static_cast<int>(result.error().code));
+        return EXIT_FAILURE;
+    }
+    result = gs_system.start();
+    if (result.is_error()) {
+        ESP_LOGE(TAG, "Start failed (code=%d)", static_cast<int>(result.error().code));
+        return EXIT_FAILURE;
+    }
+    ESP_LOGI(TAG, "Running (period=%ums, flash=%s)", opts.period_ms, opts.platform.flash_path);
+
+    auto& time = posix_platform.time();
+    const uint64_t period_us = static_cast<uint64_t>(opts.period_ms) * 1000U;
+    uint64_t deadline_us = time.get_timestamp_us();
+    uint64_t cycle = 0;
+
+    while (stop_requested == 0 && (opts.cycles == 0 || cycle < opts.cycles)) {
+        if (tamper_requested != 0) {
+            tamper_requested = 0;
+            posix_platform.gpio().simulate_trigger(TAMPER_PIN, false);
+            posix_platform.interrupt().simulate_interrupt(TAMPER_PIN);
+            ESP_LOGW(TAG, "Tamper input asserted");
+        }
+        if (stats_requested != 0) {
+            stats_requested = 0;
+            print_counters();
+        }
+
+        result = gs_system.process_cycle();
+        if (result.is_error()) {
+            ESP_LOGW(TAG,
+                     "Cycle %llu error (code=%d)",
+                     static_cast<unsigned long long>(cycle),
+                     static_cast<int>(result.error().code));
+        }
+        ++cycle;
+
+        // Hot-path records are formatted here, outside the timed cycle
+        (void)utils::deferred_log().drain(&print_deferred, nullptr);
+
+        // Fixed-rate schedule; after an overrun, resynchronise instead of bursting
+        deadline_us += period_us;
+        const uint64_t now_us = time.get_timestamp_us();
+        if (deadline_us < now_us) {
+            deadline_us = now_us;
+        }
+        time.sleep_until_us(deadline_us);
+    }
+
+    print_counters();
+    gs_system.shutdown();
+    (void)utils::deferred_log().drain(&print_deferred, nullptr);
+    ESP_LOGI(TAG, "Stopped after %llu cycles", static_cast<unsigned long long>(cycle));
+    return EXIT_SUCCESS;
+}
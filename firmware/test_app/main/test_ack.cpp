@@ -0,0 +1,470 @@
+/**
+ * @file test_ack.cpp
+ * @brief Unit tests for cumulative/selective acknowledgments (network/ack.hpp)
+ *
+ * Covers the receiver window (cumulative point, SACK bits, sliding, ack
+ * timing), the sender outbox (bulk release, gap and timeout
+ * retransmission, expiry, window limit, per-link feedback) and a
+ * comparison against per-packet acks over emulated lossy links.
+ */
+
+#include "network/ack.hpp"
+#include "platform/mock_platform.hpp"
+#include "platform/net_emulator.hpp"
+#include "unity.h"
+
+#include <cstdio>
+#include <cstring>
+
+using namespace gridshield;
+using namespace gridshield::network;
+using namespace gridshield::platform::sim;
+
+// ============================================================================
+// Helpers
+// ============================================================================
+
+static platform::mock::MockCrypto ack_platform_crypto;
+static security::CryptoEngine* ack_crypto = nullptr;
+static security::ECCKeyPair ack_keypair;
+
+static SimClock ack_clock;
+static NetEmulator ack_net(ack_clock, LinkProfile{}, 0);
+
+static constexpr core::meter_id_t METER_ID = 0x1122334455667788ULL;
+static constexpr core::meter_id_t HEAD_END_ID = 0x00000000000000A1ULL;
+static constexpr size_t FRAME_BYTES = 160;
+
+static void ack_setup(void)
+{
+    if (ack_crypto == nullptr) {
+        ack_crypto = new security::CryptoEngine(ack_platform_crypto);
+        TEST_ASSERT_TRUE(ack_crypto->generate_keypair(ack_keypair).is_ok());
+    }
+}
+
+static SecurePacket make_data(core::sequence_t seq)
+{
+    uint8_t payload[16]{};
+    std::memcpy(payload, &seq, sizeof(seq));
+    SecurePacket packet;
+    packet.set_sequence(seq);
+    (void)packet.build(PacketType::MeterData,
+                       METER_ID,
+                       core::Priority::Normal,
+                       payload,
+                       sizeof(payload),
+                       *ack_crypto,
+                       ack_keypair);
+    return packet;
+}
+
+static AckPayload make_ack(core::sequence_t cumulative, uint64_t sack)
+{
+    AckPayload ack;
+    ack.peer_id = METER_ID;
+    ack.cumulative = cumulative;
+    ack.sack = sack;
+    return ack;
+}
+
+// ============================================================================
+// Receiver
+// ============================================================================
+
+static void test_ack_receiver_cumulative_and_sack(void)
+{
+    AckReceiver rx;
+    rx.reset(METER_ID);
+    TEST_ASSERT_TRUE(rx.on_receive(10, 0)); // first frame sets the start
+    TEST_ASSERT_TRUE(rx.on_receive(11, 0));
+    TEST_ASSERT_TRUE(rx.on_receive(13, 0)); // 12 missing
+    TEST_ASSERT_TRUE(rx.on_receive(15, 0));
+    TEST_ASSERT_FALSE(rx.on_receive(13, 0));
+    TEST_ASSERT_FALSE(rx.on_receive(9, 0));
+    TEST_ASSERT_FALSE(rx.on_receive(0, 0));
+
+    AckPayload ack = rx.take_ack();
+    TEST_ASSERT_EQUAL_UINT32(11, ack.cumulative);
+    TEST_ASSERT_TRUE(ack.covers(13));
+    TEST_ASSERT_TRUE(ack.covers(15));
+    TEST_ASSERT_FALSE(ack.covers(12));
+    TEST_ASSERT_FALSE(ack.covers(14));
+    TEST_ASSERT_EQUAL_UINT32(15, ack.highest());
+
+    TEST_ASSERT_TRUE(rx.on_receive(12, 0));
+    TEST_ASSERT_TRUE(rx.on_receive(14, 0));
+    TEST_ASSERT_EQUAL_UINT32(15, rx.cumulative());
+    TEST_ASSERT_EQUAL_UINT32(6, rx.stats().received);
+    TEST_ASSERT_EQUAL_UINT32(2, rx.stats().duplicates);
+}
+
+static void test_ack_receiver_timing(void)
+{
+    AckReceiver rx(AckConfig{4, 500});
+    rx.reset(METER_ID);
+    TEST_ASSERT_FALSE(rx.ack_due(0));
+    (void)rx.on_receive(1, 1000);
+    (void)rx.on_receive(2, 1100);
+    TEST_ASSERT_FALSE(rx.ack_due(1499));
+    TEST_ASSERT_TRUE(rx.ack_due(1500)); // oldest pending is 500 ms old
+    (void)rx.on_receive(3, 1200);
+    (void)rx.on_receive(4, 1300);
+    TEST_ASSERT_TRUE(rx.ack_due(1300)); // count reached
+
+    (void)rx.take_ack();
+    TEST_ASSERT_FALSE(rx.ack_due(5000));
+    (void)rx.on_receive(4, 5000); // duplicate: the sender missed our ack
+    TEST_ASSERT_TRUE(rx.ack_due(5000));
+    (void)rx.take_ack();
+    rx.on_duplicate();
+    TEST_ASSERT_TRUE(rx.ack_due(5000));
+}
+
+static void test_ack_receiver_slides_window(void)
+{
+    AckReceiver rx;
+    rx.reset(METER_ID);
+    (void)rx.on_receive(1, 0);
+    (void)rx.on_receive(3, 0); // 2 missing
+    (void)rx.on_receive(40, 0);
+
+    // 100 is beyond cumulative(1) + 64: everything below 100 - 63 is given up
+    TEST_ASSERT_TRUE(rx.on_receive(100, 0));
+    AckPayload ack = rx.take_ack();
+    TEST_ASSERT_EQUAL_UINT32(36, ack.cumulative);
+    TEST_ASSERT_TRUE(ack.covers(40));
+    TEST_ASSERT_TRUE(ack.covers(100));
+    TEST_ASSERT_FALSE(ack.covers(41));
+    TEST_ASSERT_EQUAL_UINT32(1, rx.stats().slides);
+
+    // A sender reboot jumps far ahead
+    TEST_ASSERT_TRUE(rx.on_receive(5000, 0));
+    TEST_ASSERT_EQUAL_UINT32(4936, rx.take_ack().cumulative);
+}
+
+static void test_ack_build_and_parse(void)
+{
+    ack_setup();
+    AckReceiver rx;
+    rx.reset(METER_ID);
+    (void)rx.on_receive(7, 0);
+    (void)rx.on_receive(9, 0);
+
+    SecurePacket packet;
+    TEST_ASSERT_TRUE(rx.build_ack(packet, HEAD_END_ID, *ack_crypto, ack_keypair).is_ok());
+    TEST_ASSERT_EQUAL_UINT32(1, rx.stats().acks_sent);
+    TEST_ASSERT_EQUAL_UINT32(0, rx.pending());
+
+    uint8_t wire[FRAME_BYTES];
+    auto n = packet.serialize(wire, sizeof(wire));
+    TEST_ASSERT_TRUE(n.is_ok());
+    SecurePacket received;
+    TEST_ASSERT_TRUE(received.parse(wire, n.value(), *ack_crypto, ack_keypair).is_ok());
+    auto ack = parse_ack(received);
+    TEST_ASSERT_TRUE(ack.is_ok());
+    TEST_ASSERT_TRUE(ack.value().peer_id == METER_ID);
+    TEST_ASSERT_EQUAL_UINT32(7, ack.value().cumulative);
+    TEST_ASSERT_TRUE(ack.value().covers(9));
+
+    TEST_ASSERT_TRUE(parse_ack(make_data(3)).is_error());
+}
+
+// ============================================================================
+// Sender outbox
+// ============================================================================
+
+static void test_ack_outbox_bulk_release(void)
+{
+    ack_setup();
+    static AckOutbox<16, FRAME_BYTES> outbox;
+    outbox.configure(RetransmitConfig{});
+    for (core::sequence_t seq = 1; seq <= 10; ++seq) {
+        TEST_ASSERT_TRUE(outbox.track(make_data(seq), 0).is_ok());
+    }
+    TEST_ASSERT_TRUE(outbox.track(make_data(10), 0).is_error()); // not increasing
+    TEST_ASSERT_EQUAL_UINT32(10, outbox.in_flight());
+
+    // One ack: 1..6 cumulative, 8 and 10 selectively
+    TEST_ASSERT_EQUAL_UINT32(8, outbox.on_ack(make_ack(6, 0b1010)));
+    TEST_ASSERT_EQUAL_UINT32(2, outbox.in_flight());
+    TEST_ASSERT_EQUAL_UINT32(8, outbox.stats().acked);
+    TEST_ASSERT_EQUAL_UINT32(1, outbox.stats().acks_received);
+}
+
+static void test_ack_outbox_retransmits_only_gaps(void)
+{
+    ack_setup();
+    platform::mock::MockComm comm;
+    TEST_ASSERT_TRUE(comm.init().is_ok());
+    static AckOutbox<16, FRAME_BYTES> outbox;
+    outbox.configure(RetransmitConfig{1000, 8000, 3});
+    for (core::sequence_t seq = 1; seq <= 6; ++seq) {
+        TEST_ASSERT_TRUE(outbox.track(make_data(seq), 0).is_ok());
+    }
+    const size_t tx_before = comm.get_tx_buffer().size();
+    (void)outbox.on_ack(make_ack(2, 0b101)); // 3, 5 received; 4 lost; 6 unknown
+
+    // Gap 4 goes out at once; 6 waits for its timeout
+    auto sent = outbox.poll(10, comm);
+    TEST_ASSERT_TRUE(sent.is_ok());
+    TEST_ASSERT_EQUAL_UINT32(1, sent.value());
+    TEST_ASSERT_EQUAL_UINT32(1, outbox.stats().fast_retransmits);
+    TEST_ASSERT_GREATER_THAN(tx_before, comm.get_tx_buffer().size());
+
+    // A later ack still missing 4 does not trigger a second fast retransmit
+    (void)outbox.on_ack(make_ack(3, 0b10));
+    TEST_ASSERT_EQUAL_UINT32(0, outbox.poll(20, comm).value());
+
+    // 6 times out at 1000 ms; 4 (sent again at 10 ms) backs off to 2000 ms
+    TEST_ASSERT_EQUAL_UINT32(1, outbox.poll(1000, comm).value());
+    TEST_ASSERT_EQUAL_UINT32(1, outbox.stats().timeout_retransmits);
+    TEST_ASSERT_EQUAL_UINT32(0, outbox.poll(2000, comm).value());
+    TEST_ASSERT_EQUAL_UINT32(1, outbox.poll(2010, comm).value());
+
+    TEST_ASSERT_EQUAL_UINT32(1, outbox.poll(3000, comm).value());
+
+    // Both are on their last transmission: the next timeout drops them
+    TEST_ASSERT_EQUAL_UINT32(0, outbox.poll(10000, comm).value());
+    TEST_ASSERT_EQUAL_UINT32(2, outbox.stats().expired);
+    TEST_ASSERT_EQUAL_UINT32(0, outbox.in_flight());
+}
+
+static void test_ack_outbox_window_limit(void)
+{
+    ack_setup();
+    static AckOutbox<4, FRAME_BYTES> small;
+    small.configure(RetransmitConfig{});
+    for (core::sequence_t seq = 1; seq <= 4; ++seq) {
+        TEST_ASSERT_TRUE(small.track(make_data(seq), 0).is_ok());
+    }
+    auto full = small.track(make_data(5), 0);
+    TEST_ASSERT_TRUE(full.is_error());
+    TEST_ASSERT_EQUAL(core::ErrorCode::ResourceExhausted, full.error().code);
+
+    // The receiver's SACK window bounds how far ahead of the oldest frame we go
+    static AckOutbox<8, FRAME_BYTES> windowed;
+    windowed.configure(RetransmitConfig{});
+    TEST_ASSERT_TRUE(windowed.track(make_data(100), 0).is_ok());
+    TEST_ASSERT_TRUE(windowed.can_track(163));
+    TEST_ASSERT_FALSE(windowed.can_track(164));
+    (void)windowed.on_ack(make_ack(100, 0));
+    TEST_ASSERT_TRUE(windowed.can_track(164));
+}
+
+/// Delivery feedback that records what the outbox reports per link.
+class LinkFeedbackLog final : public IDeliveryFeedback
+{
+public:
+    uint8_t last_link() const noexcept override
+    {
+        return link;
+    }
+    void on_delivered(uint8_t l, uint32_t rtt_ms) noexcept override
+    {
+        ++delivered[l];
+        last_rtt_ms = rtt_ms;
+    }
+    void on_lost(uint8_t l) noexcept override
+    {
+        ++lost[l];
+    }
+
+    uint8_t link{0};
+    uint32_t delivered[2]{};
+    uint32_t lost[2]{};
+    uint32_t last_rtt_ms{0};
+};
+
+static void test_ack_outbox_link_feedback(void)
+{
+    ack_setup();
+    platform::mock::MockComm comm;
+    TEST_ASSERT_TRUE(comm.init().is_ok());
+    LinkFeedbackLog feedback;
+    static AckOutbox<16, FRAME_BYTES> outbox;
+    outbox.configure(RetransmitConfig{1000, 8000, 3});
+    outbox.set_feedback(&feedback);
+
+    // 1 and 2 went out on link 0, 3 and 4 on link 1
+    TEST_ASSERT_TRUE(outbox.track(make_data(1), 0).is_ok());
+    TEST_ASSERT_TRUE(outbox.track(make_data(2), 0).is_ok());
+    feedback.link = 1;
+    TEST_ASSERT_TRUE(outbox.track(make_data(3), 10).is_ok());
+    TEST_ASSERT_TRUE(outbox.track(make_data(4), 10).is_ok());
+
+    // 1 and 3 acked: one RTT sample per link; 2 is a gap, lost on link 0
+    TEST_ASSERT_EQUAL_UINT32(2, outbox.on_ack(make_ack(1, 0b10), 250));
+    TEST_ASSERT_EQUAL_UINT32(1, feedback.delivered[0]);
+    TEST_ASSERT_EQUAL_UINT32(1, feedback.delivered[1]);
+    TEST_ASSERT_EQUAL_UINT32(240, feedback.last_rtt_ms);
+    TEST_ASSERT_EQUAL_UINT32(1, feedback.lost[0]);
+    TEST_ASSERT_EQUAL_UINT32(0, feedback.lost[1]);
+
+    // 2 resent on link 0 now; 4 times out once on link 1, resent there
+    feedback.link = 0;
+    TEST_ASSERT_EQUAL_UINT32(1, outbox.poll(20, comm).value());
+    TEST_ASSERT_EQUAL_UINT32(1, feedback.lost[0]); // fast retransmit is not a timeout
+    feedback.link = 1;
+    TEST_ASSERT_EQUAL_UINT32(1, outbox.poll(1010, comm).value());
+    TEST_ASSERT_EQUAL_UINT32(1, feedback.lost[1]);
+
+    // Acks of retransmitted frames are ambiguous: no RTT sample (Karn)
+    TEST_ASSERT_EQUAL_UINT32(2, outbox.on_ack(make_ack(4, 0), 1100));
+    TEST_ASSERT_EQUAL_UINT32(1, feedback.delivered[0]);
+    TEST_ASSERT_EQUAL_UINT32(1, feedback.delivered[1]);
+    outbox.set_feedback(nullptr);
+}
+
+// ============================================================================
+// Emulated links: cumulative vs per-packet acks
+// ============================================================================
+
+struct AckRunReport
+{
+    uint32_t offered{0};
+    uint32_t delivered{0};   // unique data frames at the receiver
+    uint32_t ack_frames{0};  // signed acks sent (one sign + one verify each)
+    uint64_t ack_bytes{0};   // reverse-direction airtime
+    uint32_t retransmits{0};
+    uint32_t expired{0};
+};
+
+static AckRunReport run_ack_scenario(const LinkProfile& profile,
+                                     const AckConfig& ack_config,
+                                     const RetransmitConfig& rtx_config,
+                                     uint32_t packets,
+                                     uint32_t interval_ms,
+                                     uint64_t seed)
+{
+    static constexpr uint32_t MAX_PACKETS = 128;
+    static constexpr uint64_t TIME_LIMIT_MS = 3600000;
+
+    ack_clock = SimClock{};
+    ack_net.configure(profile, profile, seed);
+    ack_net.a().init();
+    ack_net.b().init();
+    PacketTransport tx(ack_net.a());
+    PacketTransport rx(ack_net.b());
+    static AckOutbox<32, FRAME_BYTES> outbox;
+    outbox.configure(rtx_config);
+    AckReceiver receiver(ack_config);
+    receiver.reset(METER_ID);
+
+    AckRunReport report;
+    bool seen[MAX_PACKETS + 1]{};
+    packets = packets < MAX_PACKETS ? packets : MAX_PACKETS;
+    core::sequence_t next_seq = 1;
+    uint64_t next_send_ms = 0;
+
+    for (;;) {
+        const uint64_t now_ms = ack_clock.get_timestamp_us() / 1000U;
+        if (next_seq <= packets && now_ms >= next_send_ms && outbox.can_track(next_seq)) {
+            const SecurePacket packet = make_data(next_seq);
+            (void)tx.send_packet(packet, *ack_crypto, ack_keypair);
+            (void)outbox.track(packet, now_ms);
+            ++report.offered;
+            ++next_seq;
+            next_send_ms = now_ms + interval_ms;
+        }
+
+        auto data = rx.receive_packet(*ack_crypto, ack_keypair, 5);
+        if (data.is_ok() && data.value().header().type == PacketType::MeterData) {
+            const core::sequence_t seq = data.value().header().sequence;
+            if (receiver.on_receive(seq, ack_clock.get_timestamp_us() / 1000U) &&
+                seq <= packets && !seen[seq]) {
+                seen[seq] = true;
+                ++report.delivered;
+            }
+        }
+        if (receiver.ack_due(ack_clock.get_timestamp_us() / 1000U)) {
+            SecurePacket ack;
+            if (receiver.build_ack(ack, HEAD_END_ID, *ack_crypto, ack_keypair).is_ok()) {
+                (void)rx.send_packet(ack, *ack_crypto, ack_keypair);
+            }
+        }
+
+        auto ack = tx.receive_packet(*ack_crypto, ack_keypair, 5);
+        if (ack.is_ok()) {
+            auto payload = parse_ack(ack.value());
+            if (payload.is_ok()) {
+                (void)outbox.on_ack(payload.value());
+            }
+        }
+        (void)outbox.poll(ack_clock.get_timestamp_us() / 1000U, ack_net.a());
+
+        if ((next_seq > packets && outbox.in_flight() == 0) || now_ms > TIME_LIMIT_MS) {
+            break;
+        }
+    }
+
+    report.ack_frames = receiver.stats().acks_sent;
+    report.ack_bytes = ack_net.b_to_a_stats().bytes_offered;
+    report.retransmits = outbox.stats().fast_retransmits + outbox.stats().timeout_retransmits;
+    report.expired = outbox.stats().expired;
+    return report;
+}
+
+static void print_ack_report(const char* name, const AckRunReport& per, const AckRunReport& cum)
+{
+    printf("  [ack] %-18s delivered %3u/%-3u vs %3u/%-3u  ack frames %4u -> %-4u "
+           "ack bytes %6llu -> %-6llu sign+verify %4u -> %-4u retx %3u / %3u\n",
+           name,
+           static_cast<unsigned>(per.delivered),
+           static_cast<unsigned>(per.offered),
+           static_cast<unsigned>(cum.delivered),
+           static_cast<unsigned>(cum.offered),
+           static_cast<unsigned>(per.ack_frames),
+           static_cast<unsigned>(cum.ack_frames),
+           static_cast<unsigned long long>(per.ack_bytes),
+           static_cast<unsigned long long>(cum.ack_bytes),
+           static_cast<unsigned>(2 * per.ack_frames),
+           static_cast<unsigned>(2 * cum.ack_frames),
+           static_cast<unsigned>(per.retransmits),
+           static_cast<unsigned>(cum.retransmits));
+}
+
+static void check_savings(const AckRunReport& per, const AckRunReport& cum)
+{
+    // Reliability is not traded away: what was not delivered was given up on
+    TEST_ASSERT_EQUAL_UINT32(cum.offered, cum.delivered + cum.expired);
+    TEST_ASSERT_TRUE(cum.delivered + 2 >= per.delivered);
+    // At least a 3x cut in reverse airtime and signature work
+    TEST_ASSERT_TRUE(cum.ack_frames * 3 <= per.ack_frames);
+    TEST_ASSERT_TRUE(cum.ack_bytes * 3 <= per.ack_bytes);
+}
+
+static void test_ack_lossy_links_vs_per_packet(void)
+{
+    ack_setup();
+
+    const LinkProfile cell = presets::congested_cellular();
+    const RetransmitConfig cell_rtx{2000, 16000, 6};
+    const AckRunReport cell_per = run_ack_scenario(cell, AckConfig{1, 0}, cell_rtx, 100, 100, 3);
+    const AckRunReport cell_cum = run_ack_scenario(cell, AckConfig{8, 500}, cell_rtx, 100, 100, 3);
+
+    const LinkProfile lora = presets::lora_like();
+    const RetransmitConfig lora_rtx{20000, 120000, 6};
+    const AckRunReport lora_per = run_ack_scenario(lora, AckConfig{1, 0}, lora_rtx, 40, 2000, 3);
+    const AckRunReport lora_cum =
+        run_ack_scenario(lora, AckConfig{8, 10000}, lora_rtx, 40, 2000, 3);
+
+    print_ack_report("congested_cellular", cell_per, cell_cum);
+    print_ack_report("lora_like", lora_per, lora_cum);
+
+    check_savings(cell_per, cell_cum);
+    check_savings(lora_per, lora_cum);
+}
+
+void test_ack_suite(void)
+{
+    RUN_TEST(test_ack_receiver_cumulative_and_sack);
+    RUN_TEST(test_ack_receiver_timing);
+    RUN_TEST(test_ack_receiver_slides_window);
+    RUN_TEST(test_ack_build_and_parse);
+    RUN_TEST(test_ack_outbox_bulk_release);
+    RUN_TEST(test_ack_outbox_retransmits_only_gaps);
+    RUN_TEST(test_ack_outbox_window_limit);
+    RUN_TEST(test_ack_outbox_link_feedback);
+    RUN_TEST(test_ack_lossy_links_vs_per_packet);
+}
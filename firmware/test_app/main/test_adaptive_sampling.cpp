@@ -0,0 +1,353 @@
+/**
+ * @file test_adaptive_sampling.cpp
+ * @brief Unit tests for the adaptive acquisition controller
+ *
+ * Covers the idle cadence and power model, escalation on each trigger,
+ * hysteresis (minimum dwell, settle run, decay), the sensor front-end
+ * profile switch and the system path from a tamper pin edge to burst
+ * readings.
+ */
+
+#include "unity.h"
+
+#include "core/system.hpp"
+#include "hardware/adaptive_sampling.hpp"
+#include "hardware/sensor_manager.hpp"
+#include "platform/mock_platform.hpp"
+#include "platform/sim_clock.hpp"
+
+#include <cstdint>
+
+using namespace gridshield;
+using namespace gridshield::hardware;
+
+namespace {
+
+hardware::AdaptiveSamplingConfig enabled_config()
+{
+    hardware::AdaptiveSamplingConfig config;
+    config.enabled = true;
+    return config;
+}
+
+SamplingObservation load(uint32_t current_ma)
+{
+    SamplingObservation obs;
+    obs.current_ma = current_ma;
+    obs.power_mw = current_ma * 230U; // 230 V
+    return obs;
+}
+
+/// Feed @p obs at the sampler's own cadence until @p until; returns the clock.
+core::timestamp_t run(AdaptiveSampler& sampler,
+                      core::timestamp_t now,
+                      core::timestamp_t until,
+                      const SamplingObservation& obs)
+{
+    for (; now <= until; now += 10) {
+        sampler.poll(now);
+        if (sampler.due(now)) {
+            (void)sampler.observe(obs, now);
+        }
+    }
+    return now;
+}
+
+} // namespace
+
+// ============================================================================
+// IDLE CADENCE AND POWER MODEL
+// ============================================================================
+
+void test_adaptive_idle_cadence(void)
+{
+    AdaptiveSampler sampler;
+    TEST_ASSERT_TRUE(sampler.initialize(enabled_config(), 0).is_ok());
+    TEST_ASSERT_TRUE(sampler.mode() == SamplingMode::Idle);
+    TEST_ASSERT_EQUAL_UINT32(SAMPLING_IDLE_INTERVAL_MS, sampler.interval_ms(0));
+    TEST_ASSERT_FALSE(sampler.due(4999));
+    TEST_ASSERT_TRUE(sampler.due(5000));
+
+    // Steady load with +-2% noise never escalates
+    core::timestamp_t now = 0;
+    for (uint32_t i = 1; i <= 24; ++i) {
+        now = static_cast<core::timestamp_t>(i) * SAMPLING_IDLE_INTERVAL_MS;
+        sampler.poll(now);
+        TEST_ASSERT_TRUE(sampler.observe(load(i % 2 == 0 ? 10200 : 9800), now) ==
+                         SamplingTrigger::None);
+    }
+    TEST_ASSERT_TRUE(sampler.mode() == SamplingMode::Idle);
+    TEST_ASSERT_EQUAL_UINT32(24, sampler.stats().readings);
+    TEST_ASSERT_EQUAL_UINT32(0, sampler.stats().escalations);
+
+    // floor + idle front end + 1000 uC every 5 s
+    TEST_ASSERT_EQUAL_UINT32(SAMPLING_BASE_DRAW_UA + SAMPLING_IDLE_ACTIVE_UA + 200,
+                             sampler.stats().average_ua());
+    TEST_ASSERT_FALSE(sampler.take_profile_change());
+}
+
+// ============================================================================
+// ESCALATION, SETTLE AND DECAY
+// ============================================================================
+
+void test_adaptive_delta_escalates_and_decays(void)
+{
+    const hardware::AdaptiveSamplingConfig config = enabled_config();
+    AdaptiveSampler sampler;
+    TEST_ASSERT_TRUE(sampler.initialize(config, 0).is_ok());
+    core::timestamp_t now = run(sampler, 0, 60000, load(10000));
+    TEST_ASSERT_TRUE(sampler.mode() == SamplingMode::Idle);
+
+    // Magnet on the CT: current reads 40% low
+    now += SAMPLING_IDLE_INTERVAL_MS;
+    sampler.poll(now);
+    TEST_ASSERT_TRUE(sampler.observe(load(6000), now) == SamplingTrigger::SuddenDelta);
+    TEST_ASSERT_TRUE(sampler.mode() == SamplingMode::Burst);
+    TEST_ASSERT_EQUAL_UINT32(SAMPLING_BURST_INTERVAL_MS, sampler.interval_ms(now));
+    TEST_ASSERT_TRUE(sampler.take_profile_change());
+    TEST_ASSERT_FALSE(sampler.take_profile_change());
+    TEST_ASSERT_EQUAL_UINT8(SAMPLING_BURST_MPU_DIVIDER,
+                            sampler.current_profile().mpu_rate_divider);
+    TEST_ASSERT_EQUAL_UINT32(1, sampler.stats().triggers[2]);
+    const core::timestamp_t escalated = now;
+
+    // Settled at the new level, but the minimum dwell holds the burst
+    now = run(sampler, now + 10, escalated + config.min_burst_ms - 20, load(6000));
+    TEST_ASSERT_TRUE(sampler.mode() == SamplingMode::Burst);
+    now = run(sampler, now, escalated + config.min_burst_ms + 500, load(6000));
+    TEST_ASSERT_TRUE(sampler.mode() == SamplingMode::Decay);
+    TEST_ASSERT_TRUE(sampler.take_profile_change()); // front end back to idle
+
+    // Interval stretches towards idle, and the new level is the baseline
+    const uint32_t early = sampler.interval_ms(now);
+    TEST_ASSERT_GREATER_THAN(SAMPLING_BURST_INTERVAL_MS - 1, early);
+    TEST_ASSERT_LESS_THAN(SAMPLING_IDLE_INTERVAL_MS, early);
+    TEST_ASSERT_GREATER_THAN(early, sampler.interval_ms(now + config.decay_ms / 2));
+    now = run(sampler, now, now + config.decay_ms + 100, load(6000));
+    TEST_ASSERT_TRUE(sampler.mode() == SamplingMode::Idle);
+    TEST_ASSERT_EQUAL_UINT32(1, sampler.stats().escalations);
+    TEST_ASSERT_FALSE(sampler.take_profile_change()); // decay -> idle keeps the front end
+
+    // Burst time costs more than idle time
+    const SamplingStats& stats = sampler.stats();
+    TEST_ASSERT_GREATER_THAN(uint64_t{config.min_burst_ms - 1}, stats.time_in_mode_ms[1]);
+    TEST_ASSERT_GREATER_THAN(SAMPLING_BASE_DRAW_UA + SAMPLING_IDLE_ACTIVE_UA + 200,
+                             stats.average_ua());
+}
+
+void test_adaptive_hysteresis(void)
+{
+    const hardware::AdaptiveSamplingConfig config = enabled_config();
+    AdaptiveSampler sampler;
+    TEST_ASSERT_TRUE(sampler.initialize(config, 0).is_ok());
+    core::timestamp_t now = run(sampler, 0, 30000, load(10000));
+    now += SAMPLING_IDLE_INTERVAL_MS;
+    (void)sampler.observe(load(2000), now);
+    TEST_ASSERT_TRUE(sampler.mode() == SamplingMode::Burst);
+
+    // A flapping load never settles: the burst holds well past the dwell
+    for (uint32_t i = 0; i < 200; ++i) {
+        now += SAMPLING_BURST_INTERVAL_MS;
+        sampler.poll(now);
+        (void)sampler.observe(load(i % 2 == 0 ? 2000 : 9000), now);
+    }
+    TEST_ASSERT_TRUE(sampler.mode() == SamplingMode::Burst);
+    TEST_ASSERT_EQUAL_UINT32(1, sampler.stats().escalations);
+
+    // Once settled it decays; a new step during decay escalates again
+    now = run(sampler, now, now + config.min_burst_ms, load(9000));
+    TEST_ASSERT_TRUE(sampler.mode() == SamplingMode::Decay);
+    now += 1000;
+    sampler.poll(now);
+    TEST_ASSERT_TRUE(sampler.observe(load(1000), now) == SamplingTrigger::SuddenDelta);
+    TEST_ASSERT_TRUE(sampler.mode() == SamplingMode::Burst);
+    TEST_ASSERT_EQUAL_UINT32(2, sampler.stats().escalations);
+
+    // Small absolute changes stay under the floor at light load
+    AdaptiveSampler light;
+    TEST_ASSERT_TRUE(light.initialize(config, 0).is_ok());
+    now = run(light, 0, 30000, load(300));
+    now += SAMPLING_IDLE_INTERVAL_MS;
+    TEST_ASSERT_TRUE(light.observe(load(700), now) == SamplingTrigger::None);
+}
+
+// ============================================================================
+// CHEAP TRIGGERS
+// ============================================================================
+
+void test_adaptive_tamper_shock_temperature(void)
+{
+    const hardware::AdaptiveSamplingConfig config = enabled_config();
+    AdaptiveSampler sampler;
+    TEST_ASSERT_TRUE(sampler.initialize(config, 0).is_ok());
+    core::timestamp_t now = run(sampler, 0, 20000, load(10000));
+
+    // Tamper edge: escalates on the next poll, next reading one burst interval on
+    sampler.notify_tamper();
+    TEST_ASSERT_TRUE(sampler.mode() == SamplingMode::Idle);
+    sampler.poll(now);
+    TEST_ASSERT_TRUE(sampler.mode() == SamplingMode::Burst);
+    TEST_ASSERT_TRUE(sampler.stats().last_trigger == SamplingTrigger::TamperEdge);
+    TEST_ASSERT_EQUAL_UINT32(now, sampler.stats().last_escalation);
+    TEST_ASSERT_TRUE(sampler.due(now + SAMPLING_BURST_INTERVAL_MS));
+
+    // A shock inside the burst re-arms the minimum dwell
+    now = run(sampler, now, now + config.min_burst_ms - 1000, load(10000));
+    SamplingObservation shock = load(10000);
+    shock.shock_detected = true;
+    TEST_ASSERT_TRUE(sampler.observe(shock, now) == SamplingTrigger::Shock);
+    const core::timestamp_t rearmed = now;
+    now = run(sampler, now + 10, rearmed + config.min_burst_ms - 20, load(10000));
+    TEST_ASSERT_TRUE(sampler.mode() == SamplingMode::Burst);
+    now = run(sampler, now, now + config.decay_ms + 2000, load(10000));
+    TEST_ASSERT_TRUE(sampler.mode() == SamplingMode::Idle);
+
+    // Terminal temperature jump
+    SamplingObservation warm = load(10000);
+    warm.temperature_valid = true;
+    warm.temperature_c10 = 300;
+    now = run(sampler, now, now + 30000, warm);
+    warm.temperature_c10 = 360;
+    now += SAMPLING_IDLE_INTERVAL_MS;
+    TEST_ASSERT_TRUE(sampler.observe(warm, now) == SamplingTrigger::TemperatureSpike);
+    TEST_ASSERT_EQUAL_UINT32(1, sampler.stats().triggers[1]);
+    TEST_ASSERT_EQUAL_UINT32(1, sampler.stats().triggers[3]);
+    TEST_ASSERT_EQUAL_UINT32(1, sampler.stats().triggers[4]);
+}
+
+void test_adaptive_disabled_and_config(void)
+{
+    // Disabled: fixed idle cadence, triggers ignored, power still modelled
+    AdaptiveSampler fixed;
+    TEST_ASSERT_TRUE(fixed.initialize(hardware::AdaptiveSamplingConfig{}, 0).is_ok());
+    TEST_ASSERT_FALSE(fixed.is_enabled());
+    core::timestamp_t now = run(fixed, 0, 30000, load(10000));
+    fixed.notify_tamper();
+    fixed.poll(now);
+    now += SAMPLING_IDLE_INTERVAL_MS;
+    TEST_ASSERT_TRUE(fixed.observe(load(1000), now) == SamplingTrigger::None);
+    TEST_ASSERT_TRUE(fixed.mode() == SamplingMode::Idle);
+    TEST_ASSERT_GREATER_THAN(0U, fixed.stats().average_ua());
+
+    AdaptiveSampler sampler;
+    hardware::AdaptiveSamplingConfig bad = enabled_config();
+    bad.burst.interval_ms = bad.idle.interval_ms + 1;
+    TEST_ASSERT_TRUE(sampler.initialize(bad, 0).is_error());
+    bad = enabled_config();
+    bad.delta_settle_permille = bad.delta_trigger_permille + 1;
+    TEST_ASSERT_TRUE(sampler.initialize(bad, 0).is_error());
+    bad = enabled_config();
+    bad.settle_readings = 0;
+    TEST_ASSERT_TRUE(sampler.initialize(bad, 0).is_error());
+    TEST_ASSERT_TRUE(sampler.observe(load(1), 0) == SamplingTrigger::None);
+}
+
+// ============================================================================
+// SENSOR FRONT END
+// ============================================================================
+
+void test_adaptive_sensor_profile(void)
+{
+    platform::mock::MockI2C i2c;
+    i2c.set_register(sensors::MPU6050_REG_WHO_AM_I, sensors::MPU6050_WHO_AM_I_VALUE);
+    platform::PlatformServices services;
+    services.i2c = &i2c;
+
+    SensorManager manager;
+    TEST_ASSERT_TRUE(manager.apply_sampling_profile(SamplingProfile{}).is_error());
+    SensorManagerConfig config;
+    config.enable_mpu6050 = true;
+    TEST_ASSERT_TRUE(manager.initialize(services, config).is_ok());
+
+    TEST_ASSERT_TRUE(manager.apply_sampling_profile(burst_sampling_profile()).is_ok());
+    TEST_ASSERT_EQUAL_UINT8(SAMPLING_BURST_MPU_DIVIDER,
+                            i2c.get_register(sensors::MPU6050_REG_SMPLRT_DIV));
+    TEST_ASSERT_TRUE(manager.apply_sampling_profile(SamplingProfile{}).is_ok());
+    TEST_ASSERT_EQUAL_UINT8(SAMPLING_IDLE_MPU_DIVIDER,
+                            i2c.get_register(sensors::MPU6050_REG_SMPLRT_DIV));
+
+    SensorData data;
+    data.current_ma = 1234;
+    data.power_mw = 5678;
+    data.shock_detected = true;
+    const SamplingObservation obs = manager.to_sampling_observation(data);
+    TEST_ASSERT_EQUAL_UINT32(1234, obs.current_ma);
+    TEST_ASSERT_EQUAL_UINT32(5678, obs.power_mw);
+    TEST_ASSERT_TRUE(obs.shock_detected);
+    TEST_ASSERT_FALSE(obs.temperature_valid); // no DS18B20 configured
+
+    sensors::ThreePhaseSampler sampler;
+    TEST_ASSERT_TRUE(sampler.set_rounds(sensors::THREE_PHASE_MIN_ROUNDS - 1).is_error());
+    TEST_ASSERT_TRUE(sampler.set_rounds(SAMPLING_BURST_ROUNDS).is_ok());
+    TEST_ASSERT_EQUAL_UINT16(SAMPLING_BURST_ROUNDS, sampler.rounds());
+}
+
+// ============================================================================
+// SYSTEM PATH
+// ============================================================================
+
+void test_adaptive_system_tamper_edge(void)
+{
+    platform::sim::SimClock clock;
+    platform::mock::MockGPIO gpio;
+    platform::mock::MockInterrupt interrupt;
+    platform::mock::MockCrypto crypto;
+    platform::mock::MockComm comm;
+    platform::mock::MockStorage storage;
+    platform::PlatformServices services;
+    services.time = &clock;
+    services.gpio = &gpio;
+    services.interrupt = &interrupt;
+    services.crypto = &crypto;
+    services.storage = &storage;
+    services.comm = &comm;
+    comm.set_connected(true);
+
+    GridShieldSystem system;
+    SystemConfig config;
+    config.meter_id = 0x97;
+    config.tamper_config.sensor_pin = 4;
+    config.adaptive_sampling.enabled = true;
+    TEST_ASSERT_TRUE(system.initialize(config, services).is_ok());
+    TEST_ASSERT_TRUE(system.start().is_ok());
+
+    auto cycle_for = [&](uint32_t ms) {
+        for (uint32_t t = 0; t < ms; t += 50) {
+            (void)system.process_cycle();
+            clock.advance_us(50000);
+        }
+    };
+
+    cycle_for(20000);
+    const uint32_t idle_readings = system.adaptive_sampler().stats().readings;
+    TEST_ASSERT_INT32_WITHIN(1, 4, static_cast<int32_t>(idle_readings));
+    TEST_ASSERT_TRUE(system.adaptive_sampler().mode() == SamplingMode::Idle);
+
+    // Bounced edge: debounce discards it (pin back high), sampling still bursts
+    gpio.simulate_trigger(4, true);
+    interrupt.simulate_interrupt(4);
+    cycle_for(2000);
+    TEST_ASSERT_TRUE(system.adaptive_sampler().mode() == SamplingMode::Burst);
+    TEST_ASSERT_TRUE(system.adaptive_sampler().stats().last_trigger == SamplingTrigger::TamperEdge);
+    TEST_ASSERT_FALSE(system.get_state() == core::SystemState::Tampered);
+    TEST_ASSERT_GREATER_OR_EQUAL(idle_readings + 7, system.adaptive_sampler().stats().readings);
+
+    // Steady mock load settles; back to idle after dwell and decay
+    cycle_for(config.adaptive_sampling.min_burst_ms + config.adaptive_sampling.decay_ms);
+    TEST_ASSERT_TRUE(system.adaptive_sampler().mode() == SamplingMode::Idle);
+}
+
+// ============================================================================
+// TEST SUITE RUNNER
+// ============================================================================
+
+void test_adaptive_sampling_suite(void)
+{
+    RUN_TEST(test_adaptive_idle_cadence);
+    RUN_TEST(test_adaptive_delta_escalates_and_decays);
+    RUN_TEST(test_adaptive_hysteresis);
+    RUN_TEST(test_adaptive_tamper_shock_temperature);
+    RUN_TEST(test_adaptive_disabled_and_config);
+    RUN_TEST(test_adaptive_sensor_profile);
+    RUN_TEST(test_adaptive_system_tamper_edge);
+}
@@ -167,6 +167,33 @@ static void test_ts_stats()
     TEST_ASSERT_EQUAL(EXPECTED_MEAN, st.value().mean_value);
 }
 
+static void test_ts_stats_extreme_deviation()
+{
+    TimeSeriesBuffer<16> ts;
+    ts.init();
+
+    // |INT32_MIN - mean| > 3.03e9: its square overflows int64, not uint64
+    ts.push(INT32_MIN, 1000);
+    for (uint32_t i = 0; i < 3; ++i) {
+        ts.push(INT32_MAX, 2000 + i);
+    }
+    auto st = ts.stats();
+    TEST_ASSERT_TRUE(st.is_ok());
+    TEST_ASSERT_EQUAL_INT32(1073741823, st.value().mean_value);
+    TEST_ASSERT_EQUAL_INT32(1859775392, st.value().std_dev);
+
+    // Sum of squares past UINT64_MAX saturates instead of wrapping to a small value
+    TimeSeriesBuffer<16> wide;
+    wide.init();
+    for (uint32_t i = 0; i < 8; ++i) {
+        wide.push(INT32_MIN, 1000 + i);
+        wide.push(INT32_MAX, 2000 + i);
+    }
+    st = wide.stats();
+    TEST_ASSERT_TRUE(st.is_ok());
+    TEST_ASSERT_EQUAL_INT32(1073741823, st.value().std_dev);
+}
+
 // ============================================================================
 // ML Anomaly Tests
 // ============================================================================
@@ -267,6 +294,7 @@ extern "C" void test_analytics_suite(void)
     RUN_TEST(test_ts_exponential_smooth);
     RUN_TEST(test_ts_forecast);
     RUN_TEST(test_ts_stats);
+    RUN_TEST(test_ts_stats_extreme_deviation);
 
     // ML Anomaly
     RUN_TEST(test_ml_init);
@@ -0,0 +1,412 @@
+/**
+ * @file test_cascade.cpp
+ * @brief Unit tests for the cascaded anomaly gate and a labeled replay
+ */
+
+#include "unity.h"
+
+#include "analytics/cascade.hpp"
+
+#include <cstdio>
+#include <cstring>
+
+using namespace gridshield;
+using namespace gridshield::analytics;
+
+// ============================================================================
+// Helpers
+// ============================================================================
+
+static constexpr uint32_t EXPECTED_WH = 1000;
+
+/// Feed @p count samples at the expected value (±jitter) and return scored count.
+static uint32_t feed_normal(CascadeGate& gate, uint32_t count, uint32_t jitter_wh = 0)
+{
+    uint32_t scored = 0;
+    for (uint32_t i = 0; i < count; ++i) {
+        const uint32_t value = EXPECTED_WH + ((i & 1U) != 0 ? jitter_wh : 0U);
+        const auto decision = gate.evaluate(value, EXPECTED_WH);
+        gate.report(decision, false);
+        scored += decision.score ? 1U : 0U;
+    }
+    return scored;
+}
+
+static CascadeConfig no_audit_config()
+{
+    CascadeConfig config;
+    config.audit_period = 0;
+    return config;
+}
+
+// ============================================================================
+// Gate Tests
+// ============================================================================
+
+static void test_cascade_quiet_samples_skip()
+{
+    CascadeGate gate;
+    gate.init(no_audit_config());
+
+    TEST_ASSERT_EQUAL(0, feed_normal(gate, 100, 10));
+    TEST_ASSERT_EQUAL(100, gate.stats().samples);
+    TEST_ASSERT_EQUAL(100, gate.stats().skipped());
+    TEST_ASSERT_EQUAL(1000, gate.stats().skip_fraction_x1000());
+    // 1% jitter stays inside the 2% deadband after the first full check
+    TEST_ASSERT_EQUAL(99, gate.stats().deadband_skips);
+    TEST_ASSERT_FALSE(gate.escalated());
+}
+
+static void test_cascade_profile_score_escalates()
+{
+    CascadeGate gate;
+    gate.init(no_audit_config());
+    feed_normal(gate, 20, 30);
+
+    // 40% below profile, reached gradually so only the profile gate fires
+    CascadeDecision decision{};
+    for (uint32_t wh = 980; wh >= 600; wh -= 19) {
+        decision = gate.evaluate(wh, EXPECTED_WH);
+        if (decision.score) {
+            break;
+        }
+    }
+    TEST_ASSERT_TRUE(decision.score);
+    TEST_ASSERT_EQUAL(static_cast<uint8_t>(CascadeReason::ProfileScore),
+                      static_cast<uint8_t>(decision.reason));
+    TEST_ASSERT_TRUE(gate.escalated());
+    TEST_ASSERT_EQUAL(1, gate.stats().escalations);
+}
+
+static void test_cascade_rate_of_change_escalates()
+{
+    CascadeConfig config = no_audit_config();
+    config.score_enter_x1000 = 100000; // profile gate effectively off
+    CascadeGate gate;
+    gate.init(config);
+    feed_normal(gate, 10);
+
+    const auto decision = gate.evaluate(EXPECTED_WH * 2, EXPECTED_WH);
+    TEST_ASSERT_TRUE(decision.score);
+    TEST_ASSERT_EQUAL(static_cast<uint8_t>(CascadeReason::RateOfChange),
+                      static_cast<uint8_t>(decision.reason));
+}
+
+static void test_cascade_hysteresis_exit()
+{
+    CascadeConfig config = no_audit_config();
+    config.exit_calm_samples = 4;
+    CascadeGate gate;
+    gate.init(config);
+    feed_normal(gate, 10);
+
+    auto decision = gate.evaluate(300, EXPECTED_WH);
+    gate.report(decision, true);
+    TEST_ASSERT_TRUE(gate.escalated());
+
+    // Back to normal, but the model still flags it: stays escalated
+    for (int i = 0; i < 6; ++i) {
+        decision = gate.evaluate(EXPECTED_WH, EXPECTED_WH);
+        TEST_ASSERT_EQUAL(static_cast<uint8_t>(CascadeReason::Escalated),
+                          static_cast<uint8_t>(decision.reason));
+        gate.report(decision, true);
+    }
+    TEST_ASSERT_TRUE(gate.escalated());
+
+    // Between exit and entry thresholds: scored, but not calm
+    for (int i = 0; i < 6; ++i) {
+        decision = gate.evaluate(920, EXPECTED_WH);
+        gate.report(decision, false);
+    }
+    TEST_ASSERT_TRUE(gate.escalated());
+
+    // Calm run of exit_calm_samples de-escalates
+    for (int i = 0; i < 4; ++i) {
+        decision = gate.evaluate(EXPECTED_WH, EXPECTED_WH);
+        TEST_ASSERT_TRUE(decision.score);
+        gate.report(decision, false);
+    }
+    TEST_ASSERT_FALSE(gate.escalated());
+    decision = gate.evaluate(EXPECTED_WH, EXPECTED_WH);
+    TEST_ASSERT_FALSE(decision.score);
+}
+
+static void test_cascade_audit_miss_tightens()
+{
+    CascadeConfig config;
+    config.audit_period = 1; // audit every quiet sample
+    CascadeGate gate;
+    gate.init(config);
+
+    auto decision = gate.evaluate(EXPECTED_WH, EXPECTED_WH);
+    TEST_ASSERT_TRUE(decision.score);
+    TEST_ASSERT_EQUAL(static_cast<uint8_t>(CascadeReason::Audit),
+                      static_cast<uint8_t>(decision.reason));
+    TEST_ASSERT_EQUAL(0, gate.stats().skipped());
+
+    // The model disagrees with the gate: counted, escalated, threshold cut
+    gate.report(decision, true);
+    TEST_ASSERT_EQUAL(1, gate.stats().audit_misses);
+    TEST_ASSERT_TRUE(gate.escalated());
+    TEST_ASSERT_EQUAL(config.score_enter_x1000 - config.audit_tighten_x1000,
+                      gate.score_enter_x1000());
+
+    // Clean audits restore it
+    for (int i = 0; i < 20; ++i) {
+        decision = gate.evaluate(EXPECTED_WH, EXPECTED_WH);
+        gate.report(decision, false);
+    }
+    TEST_ASSERT_FALSE(gate.escalated());
+    TEST_ASSERT_EQUAL(config.score_enter_x1000, gate.score_enter_x1000());
+}
+
+static void test_cascade_learns_noise_scale()
+{
+    CascadeGate gate;
+    gate.init(no_audit_config());
+    // ±6% alternating: 12% steps, so the scale converges near 120 permille
+    for (uint32_t i = 0; i < 200; ++i) {
+        const uint32_t value = (i & 1U) != 0 ? 1060 : 940;
+        gate.report(gate.evaluate(value, EXPECTED_WH), false);
+    }
+    TEST_ASSERT_INT32_WITHIN(10, 120, gate.noise_scale_permille());
+    TEST_ASSERT_FALSE(gate.escalated());
+}
+
+// ============================================================================
+// Cascaded ML Detector
+// ============================================================================
+
+static void test_cascade_ml_skips_inference()
+{
+    TfliteRunner runner;
+    static constexpr uint8_t MODEL[] = {0x01};
+    runner.load_model(MODEL, sizeof(MODEL));
+    static constexpr int32_t LOW_SCORE[] = {100};
+    runner.set_mock_output(LOW_SCORE, 1);
+
+    CascadedMlDetector detector;
+    TEST_ASSERT_TRUE(detector.init(&runner, no_audit_config()).is_ok());
+
+    SensorSnapshot snap{};
+    snap.energy_wh = EXPECTED_WH;
+    for (int i = 0; i < 50; ++i) {
+        auto result = detector.score(snap, EXPECTED_WH);
+        TEST_ASSERT_TRUE(result.is_ok());
+        TEST_ASSERT_FALSE(result.value().valid);
+    }
+    TEST_ASSERT_EQUAL(0, runner.invoke_count());
+
+    snap.energy_wh = 0;
+    auto result = detector.score(snap, EXPECTED_WH);
+    TEST_ASSERT_TRUE(result.is_ok());
+    TEST_ASSERT_TRUE(result.value().valid);
+    TEST_ASSERT_EQUAL(1, runner.invoke_count());
+
+    CascadedMlDetector uninit;
+    TEST_ASSERT_TRUE(uninit.score(snap, EXPECTED_WH).is_error());
+}
+
+// ============================================================================
+// Labeled Replay: skip fraction and recall vs always-on scoring
+// ============================================================================
+
+static constexpr uint32_t REPLAY_DAYS = 14;
+static constexpr uint32_t REPLAY_INTERVAL_S = 900; // 15-min readings
+static constexpr uint32_t SAMPLES_PER_DAY = 86400 / REPLAY_INTERVAL_S;
+static constexpr uint32_t SAMPLES_PER_HOUR = 3600 / REPLAY_INTERVAL_S;
+static constexpr uint32_t REPLAY_SAMPLES = REPLAY_DAYS * SAMPLES_PER_DAY;
+static constexpr uint32_t MODEL_DEVIATION_PCT = 25;
+
+static constexpr uint32_t REPLAY_PROFILE_WH[24] = {
+    420, 380, 360, 350, 360, 420, 650, 900, 820, 700, 650, 640,
+    700, 680, 650, 700, 850, 1200, 1500, 1600, 1450, 1100, 800, 550};
+
+static uint32_t replay_expected(uint64_t timestamp_s)
+{
+    return REPLAY_PROFILE_WH[(timestamp_s % 86400U) / 3600U];
+}
+
+/// Stand-in model: flags readings ≥25% off the profile. Counts invocations.
+class ReplayModel final : public ITfliteRunner
+{
+public:
+    core::Result<void> load_model(const uint8_t*, size_t) noexcept override
+    {
+        return core::Result<void>{};
+    }
+    core::Result<void> set_input(const int32_t* input, size_t count) noexcept override
+    {
+        if (count < ML_FEATURE_COUNT) {
+            return GS_MAKE_ERROR(core::ErrorCode::TensorMismatch);
+        }
+        energy_wh_ = input[2];   // energy_wh * 1000 / 1000
+        second_of_day_ = input[5];
+        return core::Result<void>{};
+    }
+    core::Result<InferenceResult> invoke() noexcept override
+    {
+        ++invocations;
+        const int32_t expected = static_cast<int32_t>(
+            replay_expected(static_cast<uint64_t>(second_of_day_)));
+        const int32_t diff = energy_wh_ - expected;
+        const int32_t abs_diff = diff < 0 ? -diff : diff;
+        InferenceResult result{};
+        result.output[0] =
+            (abs_diff * 100 >= expected * static_cast<int32_t>(MODEL_DEVIATION_PCT)) ? 1000 : 0;
+        result.output_count = 1;
+        result.valid = true;
+        return core::Result<InferenceResult>(GS_MOVE(result));
+    }
+    ModelInfo get_model_info() const noexcept override
+    {
+        return ModelInfo{};
+    }
+    bool is_loaded() const noexcept override
+    {
+        return true;
+    }
+    void unload() noexcept override {}
+
+    uint32_t invocations{0};
+
+private:
+    int32_t energy_wh_{0};
+    int32_t second_of_day_{0};
+};
+
+struct ReplaySample
+{
+    uint32_t energy_wh;
+    uint8_t event; // 0 = normal, otherwise labeled theft event id
+};
+
+/// Deterministic 14-day trace with four labeled theft events.
+static void build_replay(ReplaySample* out)
+{
+    uint32_t lcg = 12345;
+    for (uint32_t i = 0; i < REPLAY_SAMPLES; ++i) {
+        lcg = lcg * 1664525U + 1013904223U;
+        const uint32_t expected = replay_expected(static_cast<uint64_t>(i) * REPLAY_INTERVAL_S);
+        // ±8% noise
+        const int32_t noise_pct_x10 = static_cast<int32_t>((lcg >> 8) % 161U) - 80;
+        uint32_t value = static_cast<uint32_t>(static_cast<int32_t>(expected) +
+                                               (static_cast<int32_t>(expected) * noise_pct_x10) /
+                                                   1000);
+        uint8_t event = 0;
+        const uint32_t day = i / SAMPLES_PER_DAY;
+        const uint32_t slot = i % SAMPLES_PER_DAY;
+
+        if (day == 3 && slot >= 10 * SAMPLES_PER_HOUR && slot < 16 * SAMPLES_PER_HOUR) {
+            value = value * 35 / 100; // meter bypass
+            event = 1;
+        } else if (day == 6 && (slot == 30 || slot == 51 || slot == 77)) {
+            value *= 3; // injected spikes
+            event = 2;
+        } else if (day == 9 || (day == 10 && slot < 48)) {
+            // Slow diversion: ramps to -45% over 48 samples, then holds
+            const uint32_t t = (day - 9) * SAMPLES_PER_DAY + slot;
+            const uint32_t cut_pct = (t < 48) ? (45 * t) / 48 : 45;
+            value = value * (100 - cut_pct) / 100;
+            event = (cut_pct >= MODEL_DEVIATION_PCT) ? 3 : 0;
+        } else if (day == 12 && slot >= 8 * SAMPLES_PER_HOUR && slot < 12 * SAMPLES_PER_HOUR) {
+            value = 0; // zero consumption
+            event = 4;
+        }
+        out[i] = ReplaySample{value, event};
+    }
+}
+
+struct ReplayResult
+{
+    uint32_t labeled{0};
+    uint32_t detected{0};
+    uint32_t false_positives{0};
+    uint32_t inferences{0};
+    bool event_hit[5]{};
+};
+
+static ReplayResult run_replay(const ReplaySample* trace, bool cascaded)
+{
+    ReplayModel model;
+    CascadedMlDetector cascade;
+    MlAnomalyDetector always_on;
+    (void)cascade.init(&model);
+    (void)always_on.init(&model);
+
+    ReplayResult r;
+    for (uint32_t i = 0; i < REPLAY_SAMPLES; ++i) {
+        SensorSnapshot snap{};
+        snap.energy_wh = trace[i].energy_wh;
+        snap.timestamp = static_cast<uint64_t>(i) * REPLAY_INTERVAL_S;
+
+        auto result = cascaded ? cascade.score(snap, replay_expected(snap.timestamp))
+                               : always_on.score(snap);
+        const bool flagged = result.is_ok() && result.value().valid && result.value().is_anomaly;
+        if (trace[i].event != 0) {
+            ++r.labeled;
+            if (flagged) {
+                ++r.detected;
+                r.event_hit[trace[i].event] = true;
+            }
+        } else if (flagged) {
+            ++r.false_positives;
+        }
+    }
+    r.inferences = model.invocations;
+    return r;
+}
+
+static ReplaySample replay_trace[REPLAY_SAMPLES];
+
+static void test_cascade_replay_recall()
+{
+    build_replay(replay_trace);
+    const ReplayResult always = run_replay(replay_trace, false);
+    const ReplayResult cascade = run_replay(replay_trace, true);
+
+    const uint32_t skip_x1000 = 1000U - (cascade.inferences * 1000U) / REPLAY_SAMPLES;
+    const uint32_t recall_always_x1000 = (always.detected * 1000U) / always.labeled;
+    const uint32_t recall_cascade_x1000 = (cascade.detected * 1000U) / cascade.labeled;
+
+    printf("  [cascade] %u samples, %u labeled: always-on %u inferences, recall %u.%u%%, "
+           "fp %u\n",
+           static_cast<unsigned>(REPLAY_SAMPLES),
+           static_cast<unsigned>(always.labeled),
+           static_cast<unsigned>(always.inferences),
+           static_cast<unsigned>(recall_always_x1000 / 10),
+           static_cast<unsigned>(recall_always_x1000 % 10),
+           static_cast<unsigned>(always.false_positives));
+    printf("  [cascade] cascaded: %u inferences (%u.%u%% skipped), recall %u.%u%%, fp %u\n",
+           static_cast<unsigned>(cascade.inferences),
+           static_cast<unsigned>(skip_x1000 / 10),
+           static_cast<unsigned>(skip_x1000 % 10),
+           static_cast<unsigned>(recall_cascade_x1000 / 10),
+           static_cast<unsigned>(recall_cascade_x1000 % 10),
+           static_cast<unsigned>(cascade.false_positives));
+
+    TEST_ASSERT_EQUAL(REPLAY_SAMPLES, always.inferences);
+    TEST_ASSERT_GREATER_OR_EQUAL(700, skip_x1000);
+    // Within 2% of always-on recall, and every event caught
+    TEST_ASSERT_GREATER_OR_EQUAL(recall_always_x1000 * 98 / 100, recall_cascade_x1000);
+    for (int event = 1; event <= 4; ++event) {
+        TEST_ASSERT_TRUE(cascade.event_hit[event]);
+    }
+    TEST_ASSERT_TRUE(cascade.false_positives <= always.false_positives);
+}
+
+// ============================================================================
+// TEST SUITE ENTRY POINT
+// ============================================================================
+
+void test_cascade_suite(void)
+{
+    RUN_TEST(test_cascade_quiet_samples_skip);
+    RUN_TEST(test_cascade_profile_score_escalates);
+    RUN_TEST(test_cascade_rate_of_change_escalates);
+    RUN_TEST(test_cascade_hysteresis_exit);
+    RUN_TEST(test_cascade_audit_miss_tightens);
+    RUN_TEST(test_cascade_learns_noise_scale);
+    RUN_TEST(test_cascade_ml_skips_inference);
+    RUN_TEST(test_cascade_replay_recall);
+}
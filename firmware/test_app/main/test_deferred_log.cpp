@@ -0,0 +1,230 @@
+/**
+ * @file test_deferred_log.cpp
+ * @brief Unit tests for deferred binary logging (utils/deferred_log.hpp)
+ *
+ * Covers compile-time format checking, record/drain round trips, the
+ * compile-time level filter, ring overflow and wrap-around, the raw stream
+ * read by the host decoder, and the hot-path call sites in packet.cpp.
+ */
+
+#include "unity.h"
+
+#include "network/packet.hpp"
+#include "platform/mock_platform.hpp"
+#include "security/crypto.hpp"
+#include "utils/deferred_log.hpp"
+
+#include <cstdio>
+#include <cstring>
+
+using namespace gridshield;
+using namespace gridshield::utils;
+
+namespace {
+
+static constexpr char TAG[] = "GS_Test";
+
+using dlog_detail::format_signature;
+using dlog_detail::SIG_INVALID;
+
+// The call-site check: a format and its arguments must agree per conversion
+static_assert(format_signature("no args") == 0, "plain text has no arguments");
+static_assert(format_signature("%u %d %x %c %%") ==
+                  decltype(dlog_detail::signature_of(1U, 1, 1U, 'c'))::value,
+              "32-bit conversions");
+static_assert(format_signature("%llx %.2f") ==
+                  decltype(dlog_detail::signature_of(1ULL, 1.0F))::value,
+              "64-bit and floating conversions");
+static_assert(format_signature("%llx") != decltype(dlog_detail::signature_of(1U))::value,
+              "a 32-bit argument for %llx is rejected");
+static_assert(format_signature("%s") == SIG_INVALID, "%s cannot be deferred");
+static_assert(format_signature("%*d") == SIG_INVALID, "'*' width cannot be deferred");
+
+struct Captured
+{
+    char level{0};
+    char tag[16]{};
+    char text[DLOG_LINE_SIZE]{};
+    uint32_t timestamp{0};
+    size_t count{0};
+};
+
+void capture(void* ctx, const DeferredLogLine& line)
+{
+    auto* out = static_cast<Captured*>(ctx);
+    out->level = line.level;
+    std::snprintf(out->tag, sizeof(out->tag), "%.*s", static_cast<int>(line.tag_len), line.tag);
+    std::snprintf(out->text, sizeof(out->text), "%s", line.text);
+    out->timestamp = line.timestamp;
+    ++out->count;
+}
+
+void discard(void* /*ctx*/, const DeferredLogLine& /*line*/) {}
+
+uint32_t fixed_clock()
+{
+    return 1234U;
+}
+
+} // namespace
+
+// ============================================================================
+// RECORD / DRAIN
+// ============================================================================
+
+void test_dlog_round_trip(void)
+{
+    auto& log = deferred_log();
+    (void)log.drain(&discard, nullptr);
+    log.set_clock(&fixed_clock);
+
+    GS_DLOGW(TAG,
+             "meter=0x%llx seq=%u delta=%d pf=%.3f ch=%c %%",
+             0x4753000000000042ULL,
+             7U,
+             -12,
+             0.875,
+             'A');
+    Captured out;
+    TEST_ASSERT_EQUAL(1, log.drain(&capture, &out));
+    TEST_ASSERT_EQUAL('W', out.level);
+    TEST_ASSERT_EQUAL_STRING("GS_Test", out.tag);
+    TEST_ASSERT_EQUAL_STRING("meter=0x4753000000000042 seq=7 delta=-12 pf=0.875 ch=A %", out.text);
+    TEST_ASSERT_EQUAL_UINT32(1234U, out.timestamp);
+
+    GS_DLOGE("Lit", "no arguments");
+    TEST_ASSERT_EQUAL(1, log.drain(&capture, &out));
+    TEST_ASSERT_EQUAL('E', out.level);
+    TEST_ASSERT_EQUAL_STRING("Lit", out.tag);
+    TEST_ASSERT_EQUAL_STRING("no arguments", out.text);
+
+    GS_DLOGI(TAG, "[%5u|%-4d|%08x|%hhd]", 42U, -3, 0xBEEFU, static_cast<int8_t>(-2));
+    TEST_ASSERT_EQUAL(1, log.drain(&capture, &out));
+    TEST_ASSERT_EQUAL_STRING("[   42|-3  |0000beef|-2]", out.text);
+    log.set_clock(nullptr);
+}
+
+void test_dlog_level_filter(void)
+{
+    auto& log = deferred_log();
+    (void)log.drain(&discard, nullptr);
+    const uint32_t before = log.stats().recorded;
+
+    // GS_DLOG_LEVEL defaults to INFO: debug/verbose sites compile to nothing
+    GS_DLOGD(TAG, "debug %u", 1U);
+    GS_DLOGV(TAG, "verbose %u", 2U);
+    TEST_ASSERT_EQUAL_UINT32(before, log.stats().recorded);
+    TEST_ASSERT_EQUAL(0, log.pending_words());
+
+    GS_DLOGI(TAG, "info %u", 3U);
+    TEST_ASSERT_EQUAL_UINT32(before + 1, log.stats().recorded);
+    TEST_ASSERT_EQUAL(1, log.drain(&discard, nullptr));
+}
+
+void test_dlog_overflow_and_wrap(void)
+{
+    static DeferredLog<64> ring;
+    static constexpr auto descriptor = dlog_detail::make_descriptor('I', TAG, "n=%u");
+
+    // 4-word records: 16 fit, the 17th is dropped and counted
+    for (uint32_t n = 0; n < 17; ++n) {
+        TEST_ASSERT_EQUAL(n < 16, ring.record(descriptor.data(), n));
+    }
+    TEST_ASSERT_EQUAL_UINT32(16, ring.stats().recorded);
+    TEST_ASSERT_EQUAL_UINT32(1, ring.stats().dropped);
+
+    // Drain part, refill: records straddle the end of the ring
+    Captured out;
+    TEST_ASSERT_EQUAL(5, ring.drain(&capture, &out, 5));
+    TEST_ASSERT_EQUAL_STRING("n=4", out.text);
+    for (uint32_t n = 100; n < 105; ++n) {
+        TEST_ASSERT_TRUE(ring.record(descriptor.data(), n));
+    }
+    uint32_t expected = 5;
+    for (uint32_t round = 0; round < 200; ++round) {
+        TEST_ASSERT_EQUAL(1, ring.drain(&capture, &out, 1));
+        char want[16];
+        std::snprintf(want, sizeof(want), "n=%u", static_cast<unsigned>(expected));
+        TEST_ASSERT_EQUAL_STRING(want, out.text);
+        expected = expected == 15 ? 100 : expected + 1;
+        TEST_ASSERT_TRUE(ring.record(descriptor.data(), 1000U + round));
+        if (expected == 105) {
+            expected = 1000;
+        }
+    }
+    TEST_ASSERT_EQUAL(16, ring.drain(&discard, nullptr));
+    TEST_ASSERT_EQUAL(0, ring.pending_words());
+}
+
+void test_dlog_raw_stream(void)
+{
+    static DeferredLog<64> ring;
+    static constexpr auto descriptor =
+        dlog_detail::make_descriptor('W', TAG, "id=%llx v=%u");
+    TEST_ASSERT_TRUE(ring.record(descriptor.data(), 0x1122334455667788ULL, 9U));
+
+    uint8_t raw[64];
+    const size_t n = ring.drain_raw(raw, sizeof(raw));
+    TEST_ASSERT_EQUAL(6 * 4, n);
+    TEST_ASSERT_EQUAL(0, ring.pending_words());
+
+    uint32_t words[6];
+    for (size_t k = 0; k < 6; ++k) {
+        words[k] = static_cast<uint32_t>(raw[4 * k]) |
+                   (static_cast<uint32_t>(raw[4 * k + 1]) << 8) |
+                   (static_cast<uint32_t>(raw[4 * k + 2]) << 16) |
+                   (static_cast<uint32_t>(raw[4 * k + 3]) << 24);
+    }
+    TEST_ASSERT_EQUAL_UINT32(DLOG_RECORD_MAGIC | 6U, words[0]);
+    TEST_ASSERT_TRUE(DeferredLog<64>::resolve(words[1]) == descriptor.data());
+    TEST_ASSERT_EQUAL_UINT32(0x55667788U, words[3]); // low word first
+    TEST_ASSERT_EQUAL_UINT32(0x11223344U, words[4]);
+
+    // What the host decoder does with the stream
+    char level = 0;
+    const char* tag = nullptr;
+    size_t tag_len = 0;
+    const char* fmt = nullptr;
+    TEST_ASSERT_TRUE(
+        split_descriptor(DeferredLog<64>::resolve(words[1]), level, tag, tag_len, fmt));
+    TEST_ASSERT_EQUAL('W', level);
+    TEST_ASSERT_EQUAL(sizeof(TAG) - 1, tag_len);
+    char text[64];
+    format_record(fmt, &words[3], 3, text, sizeof(text));
+    TEST_ASSERT_EQUAL_STRING("id=1122334455667788 v=9", text);
+
+    // A 32-bit target's %ld / %p take one word, whatever the host's sizes
+    const uint32_t target_words[] = {0xFFFFFFFBU, 0x3FF40010U};
+    format_record("%ld %p", target_words, 2, text, sizeof(text), DeferredLogTarget{1, 1});
+    TEST_ASSERT_EQUAL_STRING("-5 0x3ff40010", text);
+}
+
+void test_dlog_packet_hot_path(void)
+{
+    platform::mock::MockCrypto platform_crypto;
+    security::CryptoEngine crypto(platform_crypto);
+    security::ECCKeyPair keypair;
+    TEST_ASSERT_TRUE(crypto.generate_keypair(keypair).is_ok());
+
+    auto& log = deferred_log();
+    (void)log.drain(&discard, nullptr);
+
+    uint8_t garbage[sizeof(network::PacketHeader) + sizeof(network::PacketFooter)]{};
+    network::SecurePacket packet;
+    TEST_ASSERT_TRUE(packet.parse(garbage, sizeof(garbage), crypto, keypair).is_error());
+
+    Captured out;
+    TEST_ASSERT_EQUAL(1, log.drain(&capture, &out));
+    TEST_ASSERT_EQUAL('W', out.level);
+    TEST_ASSERT_EQUAL_STRING("GS_Packet", out.tag);
+    TEST_ASSERT_EQUAL_STRING("Parse failed: invalid magic header", out.text);
+}
+
+void test_deferred_log_suite(void)
+{
+    RUN_TEST(test_dlog_round_trip);
+    RUN_TEST(test_dlog_level_filter);
+    RUN_TEST(test_dlog_overflow_and_wrap);
+    RUN_TEST(test_dlog_raw_stream);
+    RUN_TEST(test_dlog_packet_hot_path);
+}
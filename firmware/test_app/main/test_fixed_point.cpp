@@ -0,0 +1,199 @@
+/**
+ * @file test_fixed_point.cpp
+ * @brief Unit tests for Q-format fixed-point math (utils/fixed_point.hpp)
+ *
+ * Accuracy of the log2/exp2/ln/exp tables, reciprocal and sqrt is checked
+ * against double over sweeps of each format's range; arithmetic is checked
+ * for rounding and saturation at the rails. Also covers the analytics
+ * modules ported onto the library (EMA weights, time-series std dev).
+ */
+
+#include "unity.h"
+
+#include "analytics/time_series.hpp"
+#include "utils/fixed_point.hpp"
+
+#include <cmath>
+#include <cstdint>
+
+using namespace gridshield;
+using namespace gridshield::utils;
+
+namespace {
+
+// Compile-time usable: constants can be folded into tables
+static_assert(Q16::from_int(3).raw() == 3 * 65536, "from_int scales by 2^16");
+static_assert(Q16::from_ratio(1, 3).raw() == 21845, "from_ratio rounds to nearest");
+static_assert((Q16::from_int(30000) + Q16::from_int(30000)) == Q16::max(), "add saturates");
+static_assert(isqrt_u32(0xFFFFFFFFU) == 0xFFFFU, "isqrt_u32 at the top of the range");
+static_assert(isqrt_u64(UINT64_MAX) == 0xFFFFFFFFU, "isqrt_u64 at the top of the range");
+
+double abs_diff(double a, double b)
+{
+    return a > b ? a - b : b - a;
+}
+
+} // namespace
+
+// ============================================================================
+// ARITHMETIC
+// ============================================================================
+
+void test_fixed_arithmetic_and_saturation(void)
+{
+    const Q16 a = Q16::from_double(1.5);
+    const Q16 b = Q16::from_double(-2.25);
+    TEST_ASSERT_TRUE((a + b) == Q16::from_double(-0.75));
+    TEST_ASSERT_TRUE((a - b) == Q16::from_double(3.75));
+    TEST_ASSERT_TRUE((a * b) == Q16::from_double(-3.375));
+    TEST_ASSERT_TRUE((b / a) == Q16::from_double(-1.5));
+    TEST_ASSERT_EQUAL_INT32(-4, (a * b).floor_int());
+    TEST_ASSERT_EQUAL_INT32(-3, (a * b).round_int());
+
+    // Rails: products, quotients and negation pin instead of wrapping
+    const Q16 big = Q16::from_int(20000);
+    TEST_ASSERT_TRUE((big * big) == Q16::max());
+    TEST_ASSERT_TRUE((-big * big) == Q16::min());
+    TEST_ASSERT_TRUE((-Q16::min()) == Q16::max());
+    TEST_ASSERT_TRUE((big / Q16::zero()) == Q16::max());
+    TEST_ASSERT_TRUE((Q16::from_double(1e-4) / Q16::from_double(1e-4)) == Q16::one());
+    TEST_ASSERT_EQUAL_INT32(INT32_MAX, Q16::from_int(4).scale(INT32_MAX / 2));
+    TEST_ASSERT_EQUAL_INT32(-6, Q16::from_double(0.5).scale(-13)); // -6.5 rounds half up
+
+    // Format conversion rounds and saturates
+    TEST_ASSERT_TRUE((Q16::from_double(0.75).as<1, 30>()) == Q30::from_double(0.75));
+    TEST_ASSERT_TRUE((Q16::from_int(5).as<1, 30>()) == Q30::max());
+
+    // Helpers used by the analytics/sensor ports
+    TEST_ASSERT_EQUAL_UINT32(UINT32_MAX, mul_div_u32(4000000000U, 100U, 3U));
+    TEST_ASSERT_EQUAL_UINT32(250U, mul_div_u32(1000U, 1000U, 4000U));
+    TEST_ASSERT_EQUAL_INT32(-1515, mul_div_i32(-100, 1000, 66)); // truncates toward zero
+    TEST_ASSERT_EQUAL_INT32(INT32_MAX, mul_div_i32(4000000000LL, 1000, 240));
+    TEST_ASSERT_EQUAL_INT32(300, lerp(100, 1100, Q30::from_double(0.2)));
+}
+
+// ============================================================================
+// ACCURACY AGAINST DOUBLE
+// ============================================================================
+
+void test_fixed_isqrt_exhaustive_edges(void)
+{
+    for (uint32_t r = 0; r < 65536U; r += 7U) {
+        const uint32_t sq = r * r;
+        TEST_ASSERT_EQUAL_UINT32(r, isqrt_u32(sq));
+        if (sq != 0) {
+            TEST_ASSERT_EQUAL_UINT32(r - 1, isqrt_u32(sq - 1));
+        }
+    }
+    uint64_t x = 0x9E3779B97F4A7C15ULL;
+    for (int i = 0; i < 2000; ++i) {
+        x ^= x << 13;
+        x ^= x >> 7;
+        x ^= x << 17;
+        const uint64_t r = isqrt_u64(x);
+        TEST_ASSERT_TRUE(r * r <= x);
+        TEST_ASSERT_TRUE((r + 1) * (r + 1) > x || r == 0xFFFFFFFFULL);
+    }
+}
+
+void test_fixed_log2_exp2_accuracy(void)
+{
+    double worst_log = 0.0;
+    for (double v = 1.0 / 4096; v < 32000.0; v *= 1.0137) {
+        const Q16 q = Q16::from_double(v);
+        worst_log = std::fmax(worst_log, abs_diff(log2(q).to_double(), std::log2(q.to_double())));
+    }
+    TEST_ASSERT_TRUE(worst_log < 6e-5);
+
+    double worst_exp = 0.0;
+    for (double v = -12.0; v < 14.9; v += 0.0173) {
+        const Q16 q = Q16::from_double(v);
+        const double want = std::exp2(q.to_double());
+        // Relative error plus one output LSB of quantization
+        const double err = abs_diff(exp2(q).to_double(), want) / want - 1.0 / 65536 / want;
+        worst_exp = std::fmax(worst_exp, err);
+    }
+    TEST_ASSERT_TRUE(worst_exp < 2e-5);
+
+    // Natural log/exp in the Q30 format the EMA uses (ln >= -2 above 0.136)
+    for (double v = 0.14; v < 1.95; v += 0.01) {
+        const Q30 q = Q30::from_double(v);
+        TEST_ASSERT_TRUE(abs_diff(ln(q).to_double(), std::log(v)) < 5e-5);
+        if (v < 0.6) {
+            TEST_ASSERT_TRUE(abs_diff(exp(q).to_double(), std::exp(v)) < 1e-4);
+        }
+    }
+
+    // Domain edges saturate
+    TEST_ASSERT_TRUE(log2(Q16::zero()) == Q16::min());
+    TEST_ASSERT_TRUE(exp2(Q16::from_int(20)) == Q16::max());
+    TEST_ASSERT_TRUE(exp2(Q16::from_int(-20)) == Q16::zero());
+    TEST_ASSERT_TRUE(exp2(Q16::zero()) == Q16::one());
+    TEST_ASSERT_TRUE(log2(Q16::from_int(1024)) == Q16::from_int(10));
+}
+
+void test_fixed_reciprocal_and_sqrt_accuracy(void)
+{
+    for (double v = 1.0 / 1024; v < 30000.0; v *= 1.021) {
+        const Q16 q = Q16::from_double(v);
+        const double want = 1.0 / q.to_double();
+        if (want < 32767.0) {
+            // Exact to the output LSB (rounded)
+            TEST_ASSERT_TRUE(abs_diff(reciprocal(q).to_double(), want) <= 1.0 / 65536);
+            TEST_ASSERT_TRUE(abs_diff(reciprocal(-q).to_double(), -want) <= 1.0 / 65536);
+        }
+        TEST_ASSERT_TRUE(abs_diff(sqrt(q).to_double(), std::sqrt(q.to_double())) <= 1.0 / 65536);
+    }
+    TEST_ASSERT_TRUE(reciprocal(Q16::zero()) == Q16::max());
+    TEST_ASSERT_TRUE(reciprocal(Q16::from_double(1e-5)) == Q16::max());
+    TEST_ASSERT_TRUE(sqrt(Q16::from_int(-4)) == Q16::zero());
+
+    for (double v = 0.51; v < 1.99; v += 0.013) {
+        const Q30 q = Q30::from_double(v);
+        TEST_ASSERT_TRUE(abs_diff(reciprocal(q).to_double(), 1.0 / q.to_double()) < 4e-9);
+    }
+}
+
+// ============================================================================
+// ANALYTICS PORT
+// ============================================================================
+
+void test_fixed_time_series_port(void)
+{
+    // Half-life weight: after h pushes of a step the EMA covers half of it
+    const analytics::EmaAlpha alpha = analytics::ema_alpha_for_half_life(8);
+    TEST_ASSERT_TRUE(abs_diff(alpha.to_double(), 1.0 - std::exp2(-1.0 / 8)) < 5e-5);
+    TEST_ASSERT_TRUE(analytics::ema_alpha_for_half_life(0) == analytics::EmaAlpha::one());
+
+    analytics::TimeSeriesBuffer<32> ts;
+    TEST_ASSERT_TRUE(ts.init(alpha).is_ok());
+    TEST_ASSERT_TRUE(ts.push(0, 0).is_ok());
+    for (uint32_t i = 1; i <= 8; ++i) {
+        TEST_ASSERT_TRUE(ts.push(10000, i).is_ok());
+    }
+    TEST_ASSERT_INT32_WITHIN(2, 5000, ts.exponential_smooth().value());
+    TEST_ASSERT_TRUE(ts.init(analytics::EmaAlpha::from_double(1.5)).is_error());
+
+    // Legacy permille weights still map exactly: 0.2 * 200 + 0.8 * 100
+    TEST_ASSERT_TRUE(ts.init(200).is_ok());
+    TEST_ASSERT_TRUE(ts.push(-100, 0).is_ok());
+    TEST_ASSERT_TRUE(ts.push(-200, 1).is_ok());
+    TEST_ASSERT_EQUAL_INT32(-120, ts.exponential_smooth().value());
+
+    // Population std dev of {2, 4, 4, 4, 5, 5, 7, 9} is exactly 2
+    TEST_ASSERT_TRUE(ts.init().is_ok());
+    const int32_t values[] = {2, 4, 4, 4, 5, 5, 7, 9};
+    for (int32_t v : values) {
+        TEST_ASSERT_TRUE(ts.push(v * 1000, 0).is_ok());
+    }
+    TEST_ASSERT_EQUAL_INT32(2000, ts.stats().value().std_dev);
+}
+
+void test_fixed_point_suite(void)
+{
+    RUN_TEST(test_fixed_arithmetic_and_saturation);
+    RUN_TEST(test_fixed_isqrt_exhaustive_edges);
+    RUN_TEST(test_fixed_log2_exp2_accuracy);
+    RUN_TEST(test_fixed_reciprocal_and_sqrt_accuracy);
+    RUN_TEST(test_fixed_time_series_port);
+}
@@ -0,0 +1,384 @@
+/**
+ * @file test_flash_storage.cpp
+ * @brief Unit tests for PageCachedStorage, MmapFlashDevice and the append benchmark
+ */
+
+#include "core/config_manager.hpp"
+#include "platform/flash_storage.hpp"
+#include "platform/mock_platform.hpp"
+#include "security/crypto.hpp"
+#include "security/key_storage.hpp"
+#include "unity.h"
+
+#if GS_PLATFORM_NATIVE
+#include "platform/mmap_flash.hpp"
+#include <unistd.h>
+#endif
+
+#if defined(GS_QEMU_BUILD) && GS_PLATFORM_ESP32
+#include "platform/esp32_platform.hpp"
+#endif
+
+#include <cstdio>
+#include <cstring>
+
+using namespace gridshield;
+using namespace gridshield::platform;
+using namespace gridshield::platform::mock;
+
+// ============================================================================
+// Helpers
+// ============================================================================
+
+/// In-RAM NOR flash: erase → 0xFF per sector, program ANDs bits.
+class RamFlashDevice
+{
+public:
+    static constexpr size_t SECTOR_SIZE = 4096;
+    static constexpr size_t SECTORS = 6; // last two hold the copy-on-write shadow
+
+    RamFlashDevice() noexcept
+    {
+        std::memset(cells_, 0xFF, sizeof(cells_));
+    }
+
+    size_t size_bytes() const noexcept
+    {
+        return sizeof(cells_);
+    }
+    core::Result<void> read(uint32_t offset, uint8_t* buffer, size_t length) noexcept
+    {
+        std::memcpy(buffer, cells_ + offset, length);
+        return core::Result<void>{};
+    }
+    core::Result<void> program(uint32_t offset, const uint8_t* data, size_t length) noexcept
+    {
+        for (size_t i = 0; i < length; ++i) {
+            cells_[offset + i] &= data[i];
+        }
+        ++programs_;
+        return core::Result<void>{};
+    }
+    core::Result<void> erase_sector(uint32_t offset) noexcept
+    {
+        std::memset(cells_ + offset, 0xFF, SECTOR_SIZE);
+        ++erases_[offset / SECTOR_SIZE];
+        return core::Result<void>{};
+    }
+    core::Result<void> sync() noexcept
+    {
+        return core::Result<void>{};
+    }
+
+    uint8_t cells_[SECTOR_SIZE * SECTORS];
+    uint32_t erases_[SECTORS]{};
+    uint32_t programs_{0};
+};
+
+using RamFlashStorage = PageCachedStorage<RamFlashDevice, 2>;
+static_assert(is_flash_device_v<RamFlashDevice>, "test device satisfies the contract");
+
+static constexpr size_t RECORD_SIZE = 32;
+
+// ============================================================================
+// PageCachedStorage
+// ============================================================================
+
+static void test_flash_write_back_on_flush(void)
+{
+    RamFlashDevice device;
+    RamFlashStorage flash(device);
+
+    static constexpr uint8_t DATA[4] = {0x12, 0x34, 0x56, 0x78};
+    TEST_ASSERT_TRUE(flash.write(100, DATA, sizeof(DATA)).is_ok());
+    TEST_ASSERT_EQUAL(1, flash.dirty_pages());
+    TEST_ASSERT_EQUAL_UINT8(0xFF, device.cells_[100]); // still buffered
+
+    uint8_t out[4]{};
+    TEST_ASSERT_TRUE(flash.read(100, out, sizeof(out)).is_ok());
+    TEST_ASSERT_EQUAL_MEMORY(DATA, out, sizeof(DATA));
+
+    TEST_ASSERT_TRUE(flash.flush().is_ok());
+    TEST_ASSERT_EQUAL(0, flash.dirty_pages());
+    TEST_ASSERT_EQUAL_MEMORY(DATA, device.cells_ + 100, sizeof(DATA));
+}
+
+static void test_flash_append_needs_no_erase(void)
+{
+    RamFlashDevice device;
+    RamFlashStorage flash(device);
+
+    uint8_t record[RECORD_SIZE];
+    for (uint32_t i = 0; i < 64; ++i) {
+        std::memset(record, static_cast<int>(i), sizeof(record));
+        flash.write(i * RECORD_SIZE, record, sizeof(record));
+    }
+    flash.flush();
+
+    TEST_ASSERT_EQUAL(0, flash.stats().sector_erases);
+    TEST_ASSERT_EQUAL(1, flash.stats().program_ops); // one coalesced dirty range
+    TEST_ASSERT_EQUAL(64 * RECORD_SIZE, flash.stats().bytes_programmed);
+}
+
+static void test_flash_rewrite_erases_and_preserves_sector(void)
+{
+    RamFlashDevice device;
+    RamFlashStorage flash(device);
+
+    static constexpr uint8_t A[2] = {0x00, 0x00};
+    static constexpr uint8_t B[2] = {0xAA, 0x55};
+    flash.write(10, A, 2);
+    flash.write(4000, A, 2);
+    flash.flush();
+
+    flash.write(10, B, 2); // 0 → 1 bits: sector must be erased
+    flash.flush();
+    TEST_ASSERT_EQUAL(1, device.erases_[0]);
+    TEST_ASSERT_EQUAL(1, device.erases_[RamFlashDevice::SECTORS - 2]); // staged in the shadow
+    TEST_ASSERT_EQUAL(1, flash.stats().shadow_commits);
+    TEST_ASSERT_EQUAL_MEMORY(B, device.cells_ + 10, 2);
+    TEST_ASSERT_EQUAL_MEMORY(A, device.cells_ + 4000, 2);
+}
+
+static void test_flash_write_spans_sectors(void)
+{
+    RamFlashDevice device;
+    RamFlashStorage flash(device);
+
+    uint8_t data[64];
+    for (size_t i = 0; i < sizeof(data); ++i) {
+        data[i] = static_cast<uint8_t>(i);
+    }
+    const uint32_t address = RamFlashDevice::SECTOR_SIZE - 16;
+    TEST_ASSERT_TRUE(flash.write(address, data, sizeof(data)).is_ok());
+    TEST_ASSERT_EQUAL(2, flash.dirty_pages());
+    flash.flush();
+    TEST_ASSERT_EQUAL_MEMORY(data, device.cells_ + address, sizeof(data));
+}
+
+static void test_flash_lru_eviction_writes_back(void)
+{
+    RamFlashDevice device;
+    RamFlashStorage flash(device);
+
+    static constexpr uint8_t V = 0x42;
+    for (uint32_t sector = 0; sector < 3; ++sector) {
+        flash.write(sector * RamFlashDevice::SECTOR_SIZE, &V, 1);
+    }
+    // Two cache pages: sector 0 was evicted to make room for sector 2
+    TEST_ASSERT_EQUAL_UINT8(V, device.cells_[0]);
+    TEST_ASSERT_EQUAL(2, flash.dirty_pages());
+    TEST_ASSERT_EQUAL(3, flash.stats().cache_misses);
+}
+
+static void test_flash_erase_full_and_partial(void)
+{
+    RamFlashDevice device;
+    RamFlashStorage flash(device);
+
+    uint8_t zeros[64]{};
+    flash.write(0, zeros, sizeof(zeros));
+    flash.write(RamFlashDevice::SECTOR_SIZE, zeros, sizeof(zeros));
+    flash.flush();
+
+    TEST_ASSERT_TRUE(flash.erase(0, RamFlashDevice::SECTOR_SIZE).is_ok());
+    TEST_ASSERT_EQUAL_UINT8(0xFF, device.cells_[0]);
+
+    TEST_ASSERT_TRUE(flash.erase(RamFlashDevice::SECTOR_SIZE + 8, 8).is_ok());
+    flash.flush();
+    TEST_ASSERT_EQUAL_UINT8(0x00, device.cells_[RamFlashDevice::SECTOR_SIZE + 7]);
+    TEST_ASSERT_EQUAL_UINT8(0xFF, device.cells_[RamFlashDevice::SECTOR_SIZE + 8]);
+    TEST_ASSERT_EQUAL_UINT8(0x00, device.cells_[RamFlashDevice::SECTOR_SIZE + 16]);
+}
+
+static void test_flash_rejects_out_of_range(void)
+{
+    RamFlashDevice device;
+    RamFlashStorage flash(device);
+
+    uint8_t byte = 0;
+    TEST_ASSERT_EQUAL(device.size_bytes() - 2 * RamFlashDevice::SECTOR_SIZE, flash.capacity());
+    TEST_ASSERT_TRUE(flash.write(static_cast<uint32_t>(flash.capacity()), &byte, 1).is_error());
+    const auto last = static_cast<uint32_t>(flash.capacity()) - 1;
+    TEST_ASSERT_TRUE(flash.read(last, &byte, 2).is_error());
+}
+
+static void test_flash_backs_key_and_config_storage(void)
+{
+    RamFlashDevice device;
+    RamFlashStorage flash(device);
+    MockCrypto crypto;
+    PlatformServices services;
+    services.crypto = &crypto;
+    services.storage = &flash;
+
+    security::KeyStorage keys(services);
+    security::CryptoEngine engine(crypto);
+    security::ECCKeyPair pair;
+    TEST_ASSERT_TRUE(engine.generate_keypair(pair).is_ok());
+    TEST_ASSERT_TRUE(keys.save(pair, security::KeySlot::Primary).is_ok());
+    TEST_ASSERT_EQUAL(0, flash.dirty_pages()); // KeyStorage flushes
+
+    core::ConfigManager config_manager(services);
+    SystemConfig config;
+    config.meter_id = 0xC0FFEE;
+    TEST_ASSERT_TRUE(config_manager.save(config).is_ok());
+
+    // A fresh cache over the same device sees everything
+    RamFlashStorage reopened(device);
+    services.storage = &reopened;
+    security::KeyStorage keys2(services);
+    security::ECCKeyPair loaded;
+    TEST_ASSERT_TRUE(keys2.load(loaded, security::KeySlot::Primary).is_ok());
+    TEST_ASSERT_EQUAL_MEMORY(
+        pair.get_public_key(), loaded.get_public_key(), security::ECCKeyPair::PUBLIC_KEY_SIZE);
+
+    core::ConfigManager config_manager2(services);
+    auto loaded_config = config_manager2.load();
+    TEST_ASSERT_TRUE(loaded_config.is_ok());
+    TEST_ASSERT_EQUAL_UINT32(0xC0FFEE, loaded_config.value().meter_id);
+}
+
+// ============================================================================
+// Host mmap device
+// ============================================================================
+
+#if GS_PLATFORM_NATIVE
+
+static constexpr size_t MMAP_IMAGE_SIZE = 64 * 1024;
+
+static void test_mmap_flash_persists_across_reopen(void)
+{
+    char path[] = "/tmp/gs_flash_XXXXXX";
+    const int fd = mkstemp(path);
+    TEST_ASSERT_TRUE(fd >= 0);
+    close(fd);
+
+    static constexpr uint8_t DATA[5] = {'h', 'e', 'l', 'l', 'o'};
+    {
+        native::MmapFlashDevice device;
+        TEST_ASSERT_TRUE(device.open(path, MMAP_IMAGE_SIZE).is_ok());
+        native::MmapFlashStorage flash(device);
+        uint8_t blank = 0;
+        flash.read(9000, &blank, 1);
+        TEST_ASSERT_EQUAL_UINT8(0xFF, blank); // new image is erased
+        flash.write(9000, DATA, sizeof(DATA));
+    } // destructor flushes
+
+    native::MmapFlashDevice device;
+    TEST_ASSERT_TRUE(device.open(path, MMAP_IMAGE_SIZE).is_ok());
+    native::MmapFlashStorage flash(device);
+    uint8_t out[5]{};
+    flash.read(9000, out, sizeof(out));
+    TEST_ASSERT_EQUAL_MEMORY(DATA, out, sizeof(DATA));
+    unlink(path);
+}
+
+#endif
+
+// ============================================================================
+// Append benchmark: small records, write-back vs per-record commit
+// ============================================================================
+
+static constexpr uint32_t BENCH_RECORDS = 512;
+
+struct AppendResult
+{
+    uint64_t total_us{0};
+    uint64_t worst_us{0};
+};
+
+/// Append BENCH_RECORDS records, flushing every @p flush_every records.
+static AppendResult
+bench_append(IPlatformStorage& storage, IPlatformTime& time, uint32_t flush_every)
+{
+    AppendResult result;
+    uint8_t record[RECORD_SIZE];
+    const uint64_t start = time.get_timestamp_us();
+    for (uint32_t i = 0; i < BENCH_RECORDS; ++i) {
+        std::memset(record, static_cast<int>(i & 0x7F), sizeof(record));
+        const uint64_t t0 = time.get_timestamp_us();
+        (void)storage.write(i * RECORD_SIZE, record, sizeof(record));
+        if ((i + 1) % flush_every == 0) {
+            (void)storage.flush();
+        }
+        const uint64_t dt = time.get_timestamp_us() - t0;
+        result.worst_us = (dt > result.worst_us) ? dt : result.worst_us;
+    }
+    (void)storage.flush();
+    result.total_us = time.get_timestamp_us() - start;
+    return result;
+}
+
+static void report_append(const char* label, const AppendResult& r)
+{
+    const double total_s = static_cast<double>(r.total_us) / 1e6;
+    const double kib = static_cast<double>(BENCH_RECORDS * RECORD_SIZE) / 1024.0;
+    printf("  [flash] %-22s avg=%7.2f us/rec worst=%6u us  %8.1f KiB/s\n",
+           label,
+           static_cast<double>(r.total_us) / BENCH_RECORDS,
+           static_cast<unsigned>(r.worst_us),
+           (total_s > 0.0) ? kib / total_s : 0.0);
+}
+
+static void test_flash_append_benchmark(void)
+{
+    MockTime time;
+
+    RamFlashDevice ram_device;
+    RamFlashStorage ram_flash(ram_device);
+    report_append("ram cached (flush/64)", bench_append(ram_flash, time, 64));
+
+#if GS_PLATFORM_NATIVE
+    char path[] = "/tmp/gs_flash_bench_XXXXXX";
+    const int fd = mkstemp(path);
+    TEST_ASSERT_TRUE(fd >= 0);
+    close(fd);
+    native::MmapFlashDevice device;
+    TEST_ASSERT_TRUE(device.open(path, MMAP_IMAGE_SIZE).is_ok());
+    {
+        native::MmapFlashStorage flash(device);
+        report_append("mmap cached (flush/64)", bench_append(flash, time, 64));
+        for (uint32_t s = 0; s < 4; ++s) {
+            device.erase_sector(s * native::MmapFlashDevice::SECTOR_SIZE);
+        }
+        report_append("mmap commit per record", bench_append(flash, time, 1));
+    }
+    unlink(path);
+#endif
+
+#if defined(GS_QEMU_BUILD) && GS_PLATFORM_ESP32
+    esp32::Esp32Storage nvs;
+    if (nvs.init().is_ok()) {
+        report_append("nvs blob per record", bench_append(nvs, time, 1));
+    }
+    esp32::Esp32PartitionDevice partition;
+    if (partition.init().is_ok()) {
+        esp32::Esp32FlashStorage flash(partition);
+        flash.erase(0, 4 * esp32::Esp32PartitionDevice::SECTOR_SIZE);
+        report_append("partition cached", bench_append(flash, time, 64));
+    } else {
+        printf("  [flash] no 'gsdata' partition in this image, skipping raw path\n");
+    }
+#endif
+}
+
+// ============================================================================
+// Suite Registration
+// ============================================================================
+
+void test_flash_storage_suite(void)
+{
+    RUN_TEST(test_flash_write_back_on_flush);
+    RUN_TEST(test_flash_append_needs_no_erase);
+    RUN_TEST(test_flash_rewrite_erases_and_preserves_sector);
+    RUN_TEST(test_flash_write_spans_sectors);
+    RUN_TEST(test_flash_lru_eviction_writes_back);
+    RUN_TEST(test_flash_erase_full_and_partial);
+    RUN_TEST(test_flash_rejects_out_of_range);
+    RUN_TEST(test_flash_backs_key_and_config_storage);
+#if GS_PLATFORM_NATIVE
+    RUN_TEST(test_mmap_flash_persists_across_reopen);
+#endif
+    RUN_TEST(test_flash_append_benchmark);
+}
@@ -0,0 +1,299 @@
+/**
+ * @file test_flat_map.cpp
+ * @brief Unit tests for the fixed-capacity hash map (utils/flat_map.hpp)
+ *
+ * Covers insert/overwrite/full, backward-shift erase under forced
+ * collisions, insertion-order iteration, compile-time string hashes,
+ * FlatSet and the RemoteConfig / EspNowMesh lookups built on top.
+ */
+
+#include "unity.h"
+
+#include "network/esp_now_mesh.hpp"
+#include "network/remote_config.hpp"
+#include "utils/flat_map.hpp"
+
+#include <cstdio>
+
+using namespace gridshield;
+using namespace gridshield::utils;
+using namespace gridshield::utils::literals;
+
+namespace {
+
+/// Every key lands in the same home bucket: worst case for probing/erase.
+struct CollidingHash
+{
+    uint32_t operator()(uint32_t /*key*/) const noexcept
+    {
+        return 7U;
+    }
+};
+
+/// Few distinct home buckets: long clusters that wrap around the table.
+struct ClusteredHash
+{
+    uint32_t operator()(uint32_t key) const noexcept
+    {
+        return (key % 3U) * 0x1000U + 0xFFFFFFFEU;
+    }
+};
+
+uint64_t next_random(uint64_t& state)
+{
+    state ^= state >> 12;
+    state ^= state << 25;
+    state ^= state >> 27;
+    return state * 0x2545F4914F6CDD1DULL;
+}
+
+static_assert(hash_string("interval_ms") == "interval_ms"_gs_hash,
+              "compile-time and run-time hashes must agree");
+static_assert(hash_string("abc", 2) == "ab"_gs_hash, "max_len bounds the hash");
+
+/// Randomized insert/erase against a reference presence array.
+template <typename Map> void churn_against_reference(Map& map, uint32_t key_space, uint64_t seed)
+{
+    static constexpr uint32_t NONE = 0xFFFFFFFFU;
+    uint32_t reference[64];
+    for (auto& v : reference) {
+        v = NONE;
+    }
+    uint64_t rng = seed;
+    for (int step = 0; step < 4000; ++step) {
+        const auto key = static_cast<uint32_t>(next_random(rng) % key_space);
+        const auto value = static_cast<uint32_t>(step);
+        if (next_random(rng) % 3 == 0) {
+            TEST_ASSERT_EQUAL(reference[key] != NONE, map.erase(key));
+            reference[key] = NONE;
+        } else if (reference[key] != NONE || !map.full()) {
+            TEST_ASSERT_TRUE(map.insert(key, value).is_ok());
+            reference[key] = value;
+        } else {
+            TEST_ASSERT_TRUE(map.insert(key, value).is_error());
+        }
+
+        size_t expected = 0;
+        for (uint32_t k = 0; k < key_space; ++k) {
+            const uint32_t* found = map.find(k);
+            if (reference[k] == NONE) {
+                TEST_ASSERT_NULL(found);
+            } else {
+                TEST_ASSERT_NOT_NULL(found);
+                TEST_ASSERT_EQUAL_UINT32(reference[k], *found);
+                ++expected;
+            }
+        }
+        TEST_ASSERT_EQUAL(expected, map.size());
+    }
+}
+
+} // namespace
+
+// ============================================================================
+// FLAT MAP
+// ============================================================================
+
+void test_flat_map_insert_find_overwrite(void)
+{
+    FlatMap<uint32_t, uint32_t, 8> map;
+    TEST_ASSERT_TRUE(map.empty());
+    TEST_ASSERT_NULL(map.find(1));
+
+    for (uint32_t k = 0; k < 8; ++k) {
+        auto r = map.insert(k * 1000U, k);
+        TEST_ASSERT_TRUE(r.is_ok());
+        TEST_ASSERT_EQUAL_UINT32(k, *r.value());
+    }
+    TEST_ASSERT_TRUE(map.full());
+    TEST_ASSERT_EQUAL(8, map.size());
+
+    // Overwrite does not need a free slot
+    TEST_ASSERT_TRUE(map.insert(3000U, 33U).is_ok());
+    TEST_ASSERT_EQUAL_UINT32(33U, *map.find(3000U));
+    TEST_ASSERT_EQUAL(8, map.size());
+
+    auto full = map.insert(9999U, 1U);
+    TEST_ASSERT_TRUE(full.is_error());
+    TEST_ASSERT_EQUAL(core::ErrorCode::ResourceExhausted, full.error().code);
+
+    TEST_ASSERT_TRUE(map.erase(0U));
+    TEST_ASSERT_FALSE(map.erase(0U));
+    TEST_ASSERT_TRUE(map.insert(9999U, 1U).is_ok());
+    TEST_ASSERT_TRUE(map.contains(9999U));
+    TEST_ASSERT_FALSE(map.contains(0U));
+
+    map.clear();
+    TEST_ASSERT_TRUE(map.empty());
+    TEST_ASSERT_NULL(map.find(9999U));
+    TEST_ASSERT_TRUE(map.bucket_count() * 4 >= map.capacity() * 5);
+}
+
+void test_flat_map_erase_under_collisions(void)
+{
+    FlatMap<uint32_t, uint32_t, 24, CollidingHash> colliding;
+    churn_against_reference(colliding, 40, 1);
+
+    FlatMap<uint32_t, uint32_t, 24, ClusteredHash> clustered;
+    churn_against_reference(clustered, 40, 2);
+
+    FlatMap<uint32_t, uint32_t, 48> mixed;
+    churn_against_reference(mixed, 64, 3);
+    TEST_ASSERT_TRUE(mixed.max_probe() <= 8);
+}
+
+void test_flat_map_insertion_order(void)
+{
+    FlatMap<uint32_t, uint32_t, 16, CollidingHash, FlatOrder::Insertion> map;
+    for (uint32_t k = 10; k < 20; ++k) {
+        TEST_ASSERT_TRUE(map.insert(k, k * 2).is_ok());
+    }
+    TEST_ASSERT_TRUE(map.erase(10U));
+    TEST_ASSERT_TRUE(map.erase(15U));
+    TEST_ASSERT_TRUE(map.insert(12U, 99U).is_ok()); // overwrite keeps its place
+    TEST_ASSERT_TRUE(map.insert(10U, 1U).is_ok());  // re-insert goes last
+
+    const uint32_t expected[] = {11, 12, 13, 14, 16, 17, 18, 19, 10};
+    size_t i = 0;
+    for (const auto& entry : map) {
+        TEST_ASSERT_EQUAL_UINT32(expected[i], entry.key);
+        ++i;
+    }
+    TEST_ASSERT_EQUAL(sizeof(expected) / sizeof(expected[0]), i);
+    TEST_ASSERT_EQUAL_UINT32(99U, *map.find(12U));
+    TEST_ASSERT_EQUAL_UINT32(36U, *map.find(18U));
+
+    FlatMap<uint32_t, uint32_t, 24, CollidingHash, FlatOrder::Insertion> ordered;
+    churn_against_reference(ordered, 40, 4);
+}
+
+void test_flat_map_string_and_mac_keys(void)
+{
+    // String keys stored as their hash; a switch can use the same literal hash
+    FlatMap<uint32_t, int, 4> by_name;
+    TEST_ASSERT_TRUE(by_name.insert(hash_string("interval_ms"), 1).is_ok());
+    TEST_ASSERT_TRUE(by_name.insert(hash_string("threshold"), 2).is_ok());
+    switch (hash_string("threshold")) {
+    case "threshold"_gs_hash:
+        TEST_ASSERT_EQUAL(2, *by_name.find("threshold"_gs_hash));
+        break;
+    default:
+        TEST_FAIL_MESSAGE("literal hash mismatch");
+    }
+
+    using Mac = std::array<uint8_t, 6>;
+    FlatMap<Mac, int, 4> by_mac;
+    const Mac a{0x24, 0x6F, 0x28, 0x00, 0x00, 0x01};
+    const Mac b{0x24, 0x6F, 0x28, 0x00, 0x00, 0x02};
+    TEST_ASSERT_TRUE(by_mac.insert(a, 1).is_ok());
+    TEST_ASSERT_TRUE(by_mac.insert(b, 2).is_ok());
+    TEST_ASSERT_EQUAL(1, *by_mac.find(a));
+    TEST_ASSERT_EQUAL(2, *by_mac.find(b));
+    TEST_ASSERT_TRUE(by_mac.erase(a));
+    TEST_ASSERT_NULL(by_mac.find(a));
+    TEST_ASSERT_EQUAL(2, *by_mac.find(b));
+}
+
+void test_flat_set(void)
+{
+    FlatSet<uint64_t, 4, FlatHash<uint64_t>, FlatOrder::Insertion> set;
+    TEST_ASSERT_TRUE(set.insert(7).value());
+    TEST_ASSERT_FALSE(set.insert(7).value());
+    TEST_ASSERT_TRUE(set.insert(3).value());
+    TEST_ASSERT_TRUE(set.insert(5).value());
+    TEST_ASSERT_TRUE(set.insert(1).value());
+    TEST_ASSERT_TRUE(set.insert(9).is_error());
+    TEST_ASSERT_TRUE(set.erase(3));
+    TEST_ASSERT_FALSE(set.contains(3));
+
+    const uint64_t expected[] = {7, 5, 1};
+    size_t i = 0;
+    for (const auto& entry : set) {
+        TEST_ASSERT_TRUE(entry.key == expected[i]);
+        ++i;
+    }
+    TEST_ASSERT_EQUAL(3, set.size());
+}
+
+// ============================================================================
+// USERS
+// ============================================================================
+
+void test_flat_map_remote_config_lookup(void)
+{
+    network::RemoteConfigManager config;
+    network::RemoteConfigSettings settings{};
+    settings.config_topic = "gs/config";
+    TEST_ASSERT_TRUE(config.init(settings).is_ok());
+
+    network::ConfigSchema schema{};
+    schema.version[0] = '1';
+    for (uint16_t i = 0; i < network::CONFIG_MAX_ENTRIES; ++i) {
+        auto& entry = schema.entries[i];
+        std::snprintf(entry.key.data(), entry.key.size(), "key_%u", static_cast<unsigned>(i));
+        std::snprintf(entry.value.data(), entry.value.size(), "%u", static_cast<unsigned>(i * 7));
+        entry.active = (i != 5);
+    }
+    schema.entry_count = network::CONFIG_MAX_ENTRIES;
+    schema.checksum = 1;
+    TEST_ASSERT_TRUE(config.apply(schema).is_ok());
+
+    auto v = config.get("key_9");
+    TEST_ASSERT_TRUE(v.is_ok());
+    TEST_ASSERT_EQUAL_STRING("63", v.value());
+    TEST_ASSERT_TRUE(config.get("key_5").is_error()); // inactive
+    TEST_ASSERT_TRUE(config.get("missing").is_error());
+
+    // Rollback re-indexes the previous schema
+    network::ConfigSchema next{};
+    next.version[0] = '2';
+    std::snprintf(next.entries[0].key.data(), next.entries[0].key.size(), "key_9");
+    std::snprintf(next.entries[0].value.data(), next.entries[0].value.size(), "override");
+    next.entries[0].active = true;
+    next.entry_count = 1;
+    next.checksum = 2;
+    TEST_ASSERT_TRUE(config.apply(next).is_ok());
+    TEST_ASSERT_EQUAL_STRING("override", config.get("key_9").value());
+    TEST_ASSERT_TRUE(config.get("key_1").is_error());
+
+    TEST_ASSERT_TRUE(config.rollback().is_ok());
+    TEST_ASSERT_EQUAL_STRING("63", config.get("key_9").value());
+    TEST_ASSERT_EQUAL_STRING("7", config.get("key_1").value());
+}
+
+void test_flat_map_mesh_peers(void)
+{
+    network::EspNowMesh mesh;
+    TEST_ASSERT_TRUE(mesh.init(network::MeshConfig{}).is_ok());
+
+    std::array<uint8_t, network::MESH_MAC_LENGTH> mac{0xAA, 0xBB, 0xCC, 0x00, 0x00, 0x00};
+    for (size_t i = 0; i < network::MESH_MAX_PEERS; ++i) {
+        mac[5] = static_cast<uint8_t>(i);
+        TEST_ASSERT_TRUE(mesh.add_peer(mac, false).is_ok());
+    }
+    // Re-adding an existing peer updates it rather than taking a new slot
+    mac[5] = 0;
+    TEST_ASSERT_TRUE(mesh.add_peer(mac, true).is_ok());
+    TEST_ASSERT_EQUAL(network::MESH_MAX_PEERS, mesh.peer_count());
+
+    mac[5] = 0xFF;
+    TEST_ASSERT_TRUE(mesh.add_peer(mac, false).is_error());
+    TEST_ASSERT_TRUE(mesh.remove_peer(mac).is_error());
+
+    mac[5] = 3;
+    TEST_ASSERT_TRUE(mesh.remove_peer(mac).is_ok());
+    TEST_ASSERT_EQUAL(network::MESH_MAX_PEERS - 1, mesh.peer_count());
+    mac[5] = 0xFF;
+    TEST_ASSERT_TRUE(mesh.add_peer(mac, false).is_ok());
+}
+
+void test_flat_map_suite(void)
+{
+    RUN_TEST(test_flat_map_insert_find_overwrite);
+    RUN_TEST(test_flat_map_erase_under_collisions);
+    RUN_TEST(test_flat_map_insertion_order);
+    RUN_TEST(test_flat_map_string_and_mac_keys);
+    RUN_TEST(test_flat_set);
+    RUN_TEST(test_flat_map_remote_config_lookup);
+    RUN_TEST(test_flat_map_mesh_peers);
+}
@@ -0,0 +1,468 @@
+/**
+ * @file test_flight_recorder.cpp
+ * @brief Unit tests for the pre-trigger waveform flight recorder
+ *
+ * Covers pre/post windowing, freeze-and-drop, the delta/varint round trip,
+ * evidence chain binding, trigger coalescing and the sensor/system hooks.
+ */
+
+#include "unity.h"
+
+#include "core/system.hpp"
+#include "forensics/flight_recorder.hpp"
+#include "hardware/sensor_manager.hpp"
+#include "platform/mock_platform.hpp"
+
+#include <chrono>
+#include <cstring>
+
+using namespace gridshield;
+using namespace gridshield::forensics;
+
+namespace {
+
+using Recorder = FlightRecorder<64, 64 * FLIGHT_MAX_BYTES_PER_SAMPLE>;
+
+constexpr uint16_t PRE = 16;
+constexpr uint16_t POST = 8;
+
+hardware::WaveformSample mains_sample(uint32_t i)
+{
+    // 230 V with a little ripple, ~5 A, resting accelerometer (1 g on Z)
+    hardware::WaveformSample s;
+    s.voltage_dv = static_cast<uint16_t>(2300 + static_cast<int32_t>(i % 7) - 3);
+    s.current_ca = static_cast<int16_t>(500 + static_cast<int32_t>(i % 5) - 2);
+    s.accel_x_mg = static_cast<int16_t>(static_cast<int32_t>(i % 3) - 1);
+    s.accel_y_mg = 0;
+    s.accel_z_mg = 1000;
+    return s;
+}
+
+FlightTrigger tamper_trigger()
+{
+    return FlightTrigger{SecurityEventType::CasingOpened,
+                         SecurityEventSeverity::Critical,
+                         SourceLayer::Physical,
+                         12345};
+}
+
+core::JobStatus run_job(Recorder& recorder)
+{
+    core::JobStatus status = core::JobStatus::Pending;
+    for (int i = 0; i < 100 && status == core::JobStatus::Pending; ++i) {
+        status = recorder.archive_job().step();
+    }
+    return status;
+}
+
+} // namespace
+
+// ============================================================================
+// Windowing
+// ============================================================================
+
+static void test_flight_init_validation(void)
+{
+    EvidenceStore store;
+    Recorder recorder;
+    TEST_ASSERT_TRUE(recorder.init(store, 0, 8).is_error());
+    TEST_ASSERT_TRUE(recorder.init(store, 60, 8).is_error()); // 68 > 64
+    TEST_ASSERT_TRUE(recorder.init(store, PRE, POST).is_ok());
+    TEST_ASSERT_TRUE(recorder.trigger(tamper_trigger()).is_error()); // no samples yet
+}
+
+static void test_flight_pre_post_window(void)
+{
+    EvidenceStore store;
+    Recorder recorder;
+    TEST_ASSERT_TRUE(recorder.init(store, PRE, POST).is_ok());
+
+    for (uint32_t i = 0; i < 100; ++i) {
+        recorder.push(mains_sample(i));
+    }
+    TEST_ASSERT_TRUE(recorder.trigger(tamper_trigger()).is_ok());
+    TEST_ASSERT_EQUAL_UINT8(static_cast<uint8_t>(FlightState::Capturing),
+                            static_cast<uint8_t>(recorder.state()));
+
+    // Job waits for the post-trigger samples
+    TEST_ASSERT_EQUAL_UINT8(static_cast<uint8_t>(core::JobStatus::Pending),
+                            static_cast<uint8_t>(recorder.archive_job().step()));
+
+    for (uint32_t i = 100; i < 100 + POST; ++i) {
+        recorder.push(mains_sample(i));
+    }
+    TEST_ASSERT_EQUAL_UINT8(static_cast<uint8_t>(FlightState::Frozen),
+                            static_cast<uint8_t>(recorder.state()));
+
+    // Frozen: further samples are dropped, not written over the window
+    recorder.push(mains_sample(999));
+    TEST_ASSERT_EQUAL_UINT32(1, recorder.stats().dropped_samples);
+
+    TEST_ASSERT_EQUAL_UINT8(static_cast<uint8_t>(core::JobStatus::Done),
+                            static_cast<uint8_t>(run_job(recorder)));
+    TEST_ASSERT_EQUAL_UINT8(static_cast<uint8_t>(FlightState::Armed),
+                            static_cast<uint8_t>(recorder.state()));
+
+    const FlightWindow* window = recorder.window(0);
+    TEST_ASSERT_NOT_NULL(window);
+    TEST_ASSERT_EQUAL_UINT16(PRE + POST, window->sample_count);
+    TEST_ASSERT_EQUAL_UINT16(PRE, window->trigger_offset);
+    TEST_ASSERT_FALSE(window->truncated);
+
+    // Round trip: samples 84..107
+    hardware::WaveformSample decoded[PRE + POST];
+    auto count = Recorder::decode(
+        recorder.window_data(0), window->byte_count, decoded, PRE + POST);
+    TEST_ASSERT_TRUE(count.is_ok());
+    TEST_ASSERT_EQUAL_UINT32(PRE + POST, count.value());
+    for (uint32_t i = 0; i < PRE + POST; ++i) {
+        const auto expected = mains_sample(100 - PRE + i);
+        TEST_ASSERT_EQUAL_MEMORY(&expected, &decoded[i], sizeof(expected));
+    }
+}
+
+static void test_flight_short_history(void)
+{
+    EvidenceStore store;
+    Recorder recorder;
+    TEST_ASSERT_TRUE(recorder.init(store, PRE, 0).is_ok());
+
+    for (uint32_t i = 0; i < 5; ++i) {
+        recorder.push(mains_sample(i));
+    }
+    TEST_ASSERT_TRUE(recorder.trigger(tamper_trigger()).is_ok());
+    TEST_ASSERT_EQUAL_UINT8(static_cast<uint8_t>(FlightState::Frozen),
+                            static_cast<uint8_t>(recorder.state()));
+    TEST_ASSERT_EQUAL_UINT8(static_cast<uint8_t>(core::JobStatus::Done),
+                            static_cast<uint8_t>(run_job(recorder)));
+    TEST_ASSERT_EQUAL_UINT16(5, recorder.window(0)->sample_count);
+    TEST_ASSERT_EQUAL_UINT16(5, recorder.window(0)->trigger_offset);
+}
+
+// ============================================================================
+// Compression
+// ============================================================================
+
+static void test_flight_compression_ratio(void)
+{
+    EvidenceStore store;
+    Recorder recorder;
+    TEST_ASSERT_TRUE(recorder.init(store, 48, 16).is_ok());
+
+    for (uint32_t i = 0; i < 200; ++i) {
+        recorder.push(mains_sample(i));
+    }
+    TEST_ASSERT_TRUE(recorder.trigger(tamper_trigger()).is_ok());
+    for (uint32_t i = 200; i < 216; ++i) {
+        recorder.push(mains_sample(i));
+    }
+    TEST_ASSERT_EQUAL_UINT8(static_cast<uint8_t>(core::JobStatus::Done),
+                            static_cast<uint8_t>(run_job(recorder)));
+
+    // Slowly varying channels: ~1 byte per channel vs 2 raw
+    const auto& stats = recorder.stats();
+    TEST_ASSERT_EQUAL_UINT32(64 * sizeof(hardware::WaveformSample), stats.raw_bytes);
+    TEST_ASSERT_LESS_THAN(stats.raw_bytes * 6 / 10, stats.compressed_bytes);
+}
+
+static void test_flight_decode_extremes(void)
+{
+    EvidenceStore store;
+    Recorder recorder;
+    TEST_ASSERT_TRUE(recorder.init(store, 4, 0).is_ok());
+
+    hardware::WaveformSample a;
+    a.voltage_dv = 65535;
+    a.current_ca = -32768;
+    a.accel_x_mg = 32767;
+    a.accel_y_mg = -1;
+    a.accel_z_mg = 0;
+    hardware::WaveformSample b;
+    b.voltage_dv = 0;
+    b.current_ca = 32767;
+    b.accel_x_mg = -32768;
+    b.accel_y_mg = 1;
+    b.accel_z_mg = -32768;
+    recorder.push(a);
+    recorder.push(b);
+    recorder.push(a);
+    recorder.push(b);
+    TEST_ASSERT_TRUE(recorder.trigger(tamper_trigger()).is_ok());
+    TEST_ASSERT_EQUAL_UINT8(static_cast<uint8_t>(core::JobStatus::Done),
+                            static_cast<uint8_t>(run_job(recorder)));
+
+    hardware::WaveformSample decoded[4];
+    auto count = Recorder::decode(
+        recorder.window_data(0), recorder.window(0)->byte_count, decoded, 4);
+    TEST_ASSERT_TRUE(count.is_ok());
+    TEST_ASSERT_EQUAL_UINT32(4, count.value());
+    TEST_ASSERT_EQUAL_MEMORY(&a, &decoded[0], sizeof(a));
+    TEST_ASSERT_EQUAL_MEMORY(&b, &decoded[1], sizeof(b));
+    TEST_ASSERT_EQUAL_MEMORY(&b, &decoded[3], sizeof(b));
+
+    // A cut-off varint is rejected
+    TEST_ASSERT_TRUE(Recorder::decode(recorder.window_data(0), 1, decoded, 4).is_error());
+}
+
+// ============================================================================
+// Evidence binding
+// ============================================================================
+
+static void test_flight_evidence_chain(void)
+{
+    EvidenceStore store;
+    Recorder recorder;
+    TEST_ASSERT_TRUE(recorder.init(store, PRE, POST).is_ok());
+
+    for (uint32_t i = 0; i < 40; ++i) {
+        recorder.push(mains_sample(i));
+    }
+    TEST_ASSERT_TRUE(recorder.trigger(tamper_trigger()).is_ok());
+    for (uint32_t i = 40; i < 40 + POST; ++i) {
+        recorder.push(mains_sample(i));
+    }
+    TEST_ASSERT_EQUAL_UINT8(static_cast<uint8_t>(core::JobStatus::Done),
+                            static_cast<uint8_t>(run_job(recorder)));
+
+    TEST_ASSERT_EQUAL_UINT32(1, store.evidence_count());
+    TEST_ASSERT_TRUE(store.verify_chain());
+
+    auto latest = store.latest();
+    TEST_ASSERT_TRUE(latest.is_ok());
+    const EvidenceSnapshot& snap = latest.value();
+    TEST_ASSERT_EQUAL_UINT8(static_cast<uint8_t>(SecurityEventType::CasingOpened),
+                            static_cast<uint8_t>(snap.event_type));
+    TEST_ASSERT_EQUAL_UINT32(12345, static_cast<uint32_t>(snap.timestamp));
+    TEST_ASSERT_EQUAL_UINT32(1000, snap.sensors.accelerometer_mg);
+    TEST_ASSERT_EQUAL_UINT32(mains_sample(39).voltage_dv * 100U, snap.sensors.voltage_mv);
+
+    // Notes carry the window id and the leading bytes of its hash
+    const FlightWindow* window = recorder.window(0);
+    uint8_t hash[EVIDENCE_HASH_SIZE];
+    detail::evidence_hash(recorder.window_data(0), window->byte_count, hash);
+    TEST_ASSERT_EQUAL_MEMORY(hash, window->hash, EVIDENCE_HASH_SIZE);
+
+    char expected[8];
+    static constexpr char HEX[] = "0123456789abcdef";
+    for (size_t i = 0; i < 3; ++i) {
+        expected[2 * i] = HEX[hash[i] >> 4];
+        expected[2 * i + 1] = HEX[hash[i] & 0x0F];
+    }
+    expected[6] = '\0';
+    TEST_ASSERT_EQUAL_INT(0, std::strncmp(snap.notes, "wf 1 n24 t16 h", 14));
+    TEST_ASSERT_EQUAL_INT(0, std::strncmp(snap.notes + 14, expected, 6));
+}
+
+static void test_flight_coalesce_and_rearm(void)
+{
+    EvidenceStore store;
+    Recorder recorder;
+    TEST_ASSERT_TRUE(recorder.init(store, PRE, POST).is_ok());
+
+    for (uint32_t i = 0; i < 30; ++i) {
+        recorder.push(mains_sample(i));
+    }
+    TEST_ASSERT_TRUE(recorder.trigger(tamper_trigger()).is_ok());
+    TEST_ASSERT_TRUE(recorder.trigger(tamper_trigger()).is_error()); // coalesced
+    for (uint32_t i = 30; i < 30 + POST; ++i) {
+        recorder.push(mains_sample(i));
+    }
+    TEST_ASSERT_TRUE(recorder.trigger(tamper_trigger()).is_error()); // still frozen
+    TEST_ASSERT_EQUAL_UINT8(static_cast<uint8_t>(core::JobStatus::Done),
+                            static_cast<uint8_t>(run_job(recorder)));
+
+    // Re-armed: a second event produces a second window
+    for (uint32_t i = 0; i < 30; ++i) {
+        recorder.push(mains_sample(i));
+    }
+    TEST_ASSERT_TRUE(recorder.trigger(tamper_trigger()).is_ok());
+    for (uint32_t i = 0; i < POST; ++i) {
+        recorder.push(mains_sample(i));
+    }
+    TEST_ASSERT_EQUAL_UINT8(static_cast<uint8_t>(core::JobStatus::Done),
+                            static_cast<uint8_t>(run_job(recorder)));
+
+    TEST_ASSERT_EQUAL_UINT32(3 + 1, recorder.stats().triggers);
+    TEST_ASSERT_EQUAL_UINT32(2, recorder.stats().coalesced_triggers);
+    TEST_ASSERT_EQUAL_UINT32(2, recorder.stats().windows_archived);
+    TEST_ASSERT_EQUAL_UINT32(2, recorder.window(0)->id);
+    TEST_ASSERT_EQUAL_UINT32(1, recorder.window(1)->id);
+    TEST_ASSERT_NULL(recorder.window(2));
+    TEST_ASSERT_EQUAL_UINT32(2, store.evidence_count());
+    TEST_ASSERT_TRUE(store.verify_chain());
+}
+
+// ============================================================================
+// Hot path
+// ============================================================================
+
+static void test_flight_push_cost(void)
+{
+    EvidenceStore store;
+    static FlightRecorder<> recorder;
+    TEST_ASSERT_TRUE(recorder.init(store, 256, 128).is_ok());
+
+    static constexpr uint32_t N = 200000;
+    const auto start = std::chrono::steady_clock::now();
+    for (uint32_t i = 0; i < N; ++i) {
+        recorder.push(mains_sample(i));
+    }
+    const auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                        std::chrono::steady_clock::now() - start)
+                        .count();
+    TEST_ASSERT_EQUAL_UINT32(N, recorder.samples_recorded());
+    // Loose bound (unoptimised host builds): well under 100 ns per sample
+    TEST_ASSERT_LESS_THAN(100, static_cast<uint32_t>(ns / N));
+}
+
+// ============================================================================
+// Acquisition / system hooks
+// ============================================================================
+
+static void test_flight_sensor_manager_sink(void)
+{
+    EvidenceStore store;
+    Recorder recorder;
+    TEST_ASSERT_TRUE(recorder.init(store, 4, 0).is_ok());
+
+    platform::mock::MockADC adc;
+    platform::PlatformServices platform{};
+    platform.adc = &adc;
+    hardware::SensorManager manager;
+    hardware::SensorManagerConfig config{};
+    config.enable_acs712 = true;
+    TEST_ASSERT_TRUE(manager.initialize(platform, config).is_ok());
+    manager.set_waveform_sink(&recorder);
+
+    adc.set_raw_value(0, 3500);
+    TEST_ASSERT_TRUE(manager.read_all().is_ok());
+    TEST_ASSERT_TRUE(manager.read_all().is_ok());
+    TEST_ASSERT_TRUE(recorder.trigger(tamper_trigger()).is_ok());
+    TEST_ASSERT_EQUAL_UINT8(static_cast<uint8_t>(core::JobStatus::Done),
+                            static_cast<uint8_t>(run_job(recorder)));
+    TEST_ASSERT_EQUAL_UINT16(2, recorder.window(0)->sample_count);
+
+    hardware::SensorData saturated{};
+    saturated.voltage_mv = 10000000;
+    saturated.current_ma = 1000000;
+    const auto sample = hardware::SensorManager::to_waveform_sample(saturated);
+    TEST_ASSERT_EQUAL_UINT16(UINT16_MAX, sample.voltage_dv);
+    TEST_ASSERT_EQUAL_INT16(INT16_MAX, sample.current_ca);
+}
+
+static void test_flight_system_tamper_trigger(void)
+{
+    using namespace gridshield::platform::mock;
+    MockTime time;
+    MockGPIO gpio;
+    MockInterrupt interrupt;
+    MockCrypto crypto;
+    MockComm comm;
+    MockStorage storage;
+    platform::PlatformServices services;
+    services.time = &time;
+    services.gpio = &gpio;
+    services.interrupt = &interrupt;
+    services.crypto = &crypto;
+    services.storage = &storage;
+    services.comm = &comm;
+    comm.set_connected(true);
+
+    static GridShieldSystem system;
+    SystemConfig config;
+    config.meter_id = 0xDEADBEEF;
+    config.tamper_config.sensor_pin = 4;
+    config.tamper_config.debounce_ms = 0;
+    for (size_t i = 0; i < analytics::PROFILE_HISTORY_SIZE; ++i) {
+        config.baseline_profile.hourly_avg_wh[i] = 1000;
+    }
+    config.baseline_profile.daily_avg_wh = 1000;
+    config.baseline_profile.variance_threshold = 30;
+    TEST_ASSERT_TRUE(system.initialize(config, services).is_ok());
+    TEST_ASSERT_TRUE(system.start().is_ok());
+
+    EvidenceStore store;
+    Recorder recorder;
+    TEST_ASSERT_TRUE(recorder.init(store, PRE, 0).is_ok());
+    system.attach_flight_recorder(&recorder);
+    for (uint32_t i = 0; i < 20; ++i) {
+        recorder.push(mains_sample(i));
+    }
+
+    gpio.simulate_trigger(4, false);
+    interrupt.simulate_interrupt(4);
+    TEST_ASSERT_TRUE(system.process_cycle().is_ok());
+
+    // Frozen by the tamper handler, archived by the same cycle's job run
+    TEST_ASSERT_EQUAL_UINT32(1, recorder.stats().windows_archived);
+    TEST_ASSERT_EQUAL_UINT32(1, store.evidence_count());
+    TEST_ASSERT_EQUAL_UINT8(static_cast<uint8_t>(SecurityEventType::CasingOpened),
+                            static_cast<uint8_t>(store.latest().value().event_type));
+
+    system.attach_flight_recorder(nullptr);
+    (void)system.shutdown();
+}
+
+static void test_flight_system_sensor_reads_feed_recorder(void)
+{
+    using namespace gridshield::platform::mock;
+    MockTime time;
+    MockGPIO gpio;
+    MockInterrupt interrupt;
+    MockCrypto crypto;
+    MockComm comm;
+    MockStorage storage;
+    MockADC adc;
+    platform::PlatformServices services;
+    services.time = &time;
+    services.gpio = &gpio;
+    services.interrupt = &interrupt;
+    services.crypto = &crypto;
+    services.storage = &storage;
+    services.comm = &comm;
+    services.adc = &adc;
+    comm.set_connected(true);
+    adc.set_raw_value(0, 3500);
+
+    static GridShieldSystem system;
+    SystemConfig config;
+    config.meter_id = 0xDEADBEEF;
+    config.tamper_config.sensor_pin = 4;
+    config.reading_interval_ms = 1;
+    config.sensor_config.enable_acs712 = true;
+    TEST_ASSERT_TRUE(system.initialize(config, services).is_ok());
+    TEST_ASSERT_TRUE(system.start().is_ok());
+
+    EvidenceStore store;
+    Recorder recorder;
+    TEST_ASSERT_TRUE(recorder.init(store, PRE, 0).is_ok());
+    system.attach_flight_recorder(&recorder);
+
+    // No caller-driven read_all(): the system's own reading path feeds the sink
+    for (uint32_t i = 0; i < 3; ++i) {
+        time.delay_ms(2);
+        TEST_ASSERT_TRUE(system.process_cycle().is_ok());
+    }
+    TEST_ASSERT_TRUE(recorder.trigger(tamper_trigger()).is_ok());
+    TEST_ASSERT_EQUAL_UINT8(static_cast<uint8_t>(core::JobStatus::Done),
+                            static_cast<uint8_t>(run_job(recorder)));
+    TEST_ASSERT_EQUAL_UINT16(3, recorder.window(0)->sample_count);
+
+    system.attach_flight_recorder(nullptr);
+    (void)system.shutdown();
+}
+
+void test_flight_recorder_suite(void)
+{
+    RUN_TEST(test_flight_init_validation);
+    RUN_TEST(test_flight_pre_post_window);
+    RUN_TEST(test_flight_short_history);
+    RUN_TEST(test_flight_compression_ratio);
+    RUN_TEST(test_flight_decode_extremes);
+    RUN_TEST(test_flight_evidence_chain);
+    RUN_TEST(test_flight_coalesce_and_rearm);
+    RUN_TEST(test_flight_push_cost);
+    RUN_TEST(test_flight_sensor_manager_sink);
+    RUN_TEST(test_flight_system_tamper_trigger);
+    RUN_TEST(test_flight_system_sensor_reads_feed_recorder);
+}
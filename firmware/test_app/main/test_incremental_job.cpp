@@ -0,0 +1,365 @@
+/**
+ * @file test_incremental_job.cpp
+ * @brief Unit tests for JobScheduler, ChainVerifyJob, KeygenAheadJob and main-loop latency
+ */
+
+#include "core/incremental_job.hpp"
+#include "core/system.hpp"
+#include "forensics/evidence_store.hpp"
+#include "platform/mock_platform.hpp"
+#include "security/key_rotation.hpp"
+#include "unity.h"
+
+#include <cstdio>
+
+using namespace gridshield;
+using namespace gridshield::platform;
+using namespace gridshield::platform::mock;
+
+// ============================================================================
+// Helpers
+// ============================================================================
+
+struct JobFixture
+{
+    MockTime time;
+    MockGPIO gpio;
+    MockInterrupt interrupt;
+    MockCrypto crypto;
+    MockComm comm;
+    MockStorage storage;
+    PlatformServices services;
+
+    JobFixture() noexcept
+    {
+        services.time = &time;
+        services.gpio = &gpio;
+        services.interrupt = &interrupt;
+        services.crypto = &crypto;
+        services.storage = &storage;
+        services.comm = &comm;
+        comm.set_connected(true);
+    }
+
+    SystemConfig make_config()
+    {
+        SystemConfig config;
+        config.meter_id = 0xDEADBEEF;
+        config.tamper_config.sensor_pin = 4;
+        config.tamper_config.debounce_ms = 50;
+        config.reading_interval_ms = 0; // a reading every cycle: worst-case load
+        config.checkpoint_interval_ms = 0;
+        for (size_t i = 0; i < analytics::PROFILE_HISTORY_SIZE; ++i) {
+            config.baseline_profile.hourly_avg_wh[i] = 1200;
+        }
+        config.baseline_profile.daily_avg_wh = 1200;
+        return config;
+    }
+};
+
+/// Counts down a fixed number of steps.
+class CountingJob final : public core::IIncrementalJob
+{
+public:
+    explicit CountingJob(uint32_t steps, uint32_t cost_us = 0) noexcept
+        : total_(steps), cost_us_(cost_us)
+    {}
+
+    core::JobStatus step() noexcept override
+    {
+        ++done_;
+        return (done_ >= total_) ? core::JobStatus::Done : core::JobStatus::Pending;
+    }
+    void reset() noexcept override
+    {
+        done_ = 0;
+    }
+    uint32_t next_step_cost_us() const noexcept override
+    {
+        return cost_us_;
+    }
+
+    uint32_t done_{0};
+
+private:
+    uint32_t total_;
+    uint32_t cost_us_;
+};
+
+static void fill_evidence(forensics::EvidenceStore& store, size_t count)
+{
+    forensics::SensorSnapshot sensors;
+    for (size_t i = 0; i < count; ++i) {
+        sensors.energy_wh = static_cast<uint32_t>(1000 + i);
+        store.preserve(forensics::SecurityEventType::AnomalyDetected,
+                       forensics::SecurityEventSeverity::Medium,
+                       forensics::SourceLayer::Analytics,
+                       static_cast<core::timestamp_t>(1000 + i),
+                       sensors,
+                       "load");
+    }
+}
+
+// ============================================================================
+// JobScheduler
+// ============================================================================
+
+static void test_job_scheduler_runs_to_completion(void)
+{
+    MockTime time;
+    core::JobScheduler<4> scheduler;
+    CountingJob job(5);
+
+    TEST_ASSERT_TRUE(scheduler.submit(job).is_ok());
+    TEST_ASSERT_EQUAL(1, scheduler.active());
+
+    for (int cycle = 0; cycle < 10 && scheduler.active() > 0; ++cycle) {
+        scheduler.run(time, 1000000);
+    }
+    TEST_ASSERT_EQUAL(0, scheduler.active());
+    TEST_ASSERT_EQUAL(5, job.done_);
+    TEST_ASSERT_EQUAL(1, scheduler.stats().jobs_completed);
+}
+
+static void test_job_scheduler_rejects_duplicate_and_full(void)
+{
+    core::JobScheduler<2> scheduler;
+    CountingJob a(1);
+    CountingJob b(1);
+    CountingJob c(1);
+
+    TEST_ASSERT_TRUE(scheduler.submit(a).is_ok());
+    TEST_ASSERT_TRUE(scheduler.submit(a).is_error());
+    TEST_ASSERT_TRUE(scheduler.submit(b).is_ok());
+
+    auto full = scheduler.submit(c);
+    TEST_ASSERT_TRUE(full.is_error());
+    TEST_ASSERT_EQUAL(core::ErrorCode::ResourceExhausted, full.error().code);
+
+    scheduler.cancel(a);
+    TEST_ASSERT_FALSE(scheduler.is_queued(a));
+    TEST_ASSERT_TRUE(scheduler.submit(c).is_ok());
+}
+
+static void test_job_scheduler_defers_step_over_budget(void)
+{
+    MockTime time;
+    core::JobScheduler<4> scheduler;
+    CountingJob cheap(3);
+    CountingJob heavy(2, 100000); // never fits after another step
+
+    scheduler.submit(cheap);
+    scheduler.submit(heavy);
+
+    // First step of a cycle always runs; the heavy job then waits its turn
+    const uint32_t steps = scheduler.run(time, 50000);
+    TEST_ASSERT_GREATER_OR_EQUAL(1, steps);
+    TEST_ASSERT_TRUE(heavy.done_ <= 1);
+
+    for (int cycle = 0; cycle < 10 && scheduler.active() > 0; ++cycle) {
+        scheduler.run(time, 50000);
+    }
+    TEST_ASSERT_EQUAL(3, cheap.done_);
+    TEST_ASSERT_EQUAL(2, heavy.done_);
+}
+
+// ============================================================================
+// ChainVerifyJob
+// ============================================================================
+
+static void test_chain_verify_job_matches_monolithic(void)
+{
+    MockTime time;
+    forensics::EvidenceStore store;
+    fill_evidence(store, forensics::EVIDENCE_STORE_CAPACITY + 4);
+    TEST_ASSERT_TRUE(store.verify_chain());
+
+    forensics::ChainVerifyJob job(store);
+    core::JobScheduler<> scheduler;
+    scheduler.submit(job);
+
+    for (size_t cycle = 0; cycle < 1000 && scheduler.active() > 0; ++cycle) {
+        scheduler.run(time, 1); // ~one entry per cycle
+    }
+    TEST_ASSERT_TRUE(job.is_complete());
+    TEST_ASSERT_TRUE(job.is_intact());
+}
+
+static void test_chain_verify_job_detects_tamper(void)
+{
+    forensics::EvidenceStore store;
+    fill_evidence(store, 8);
+
+    // Corrupt one stored snapshot through its raw bytes
+    auto* raw = reinterpret_cast<uint8_t*>(&store);
+    raw[sizeof(forensics::EvidenceSnapshot) * 3 + 20] ^= 0xFF;
+    TEST_ASSERT_FALSE(store.verify_chain());
+
+    forensics::ChainVerifyJob job(store);
+    core::JobStatus status = core::JobStatus::Pending;
+    for (int i = 0; i < 20 && status == core::JobStatus::Pending; ++i) {
+        status = job.step();
+    }
+    TEST_ASSERT_EQUAL(core::JobStatus::Failed, status);
+    TEST_ASSERT_TRUE(job.is_complete());
+    TEST_ASSERT_FALSE(job.is_intact());
+}
+
+static void test_chain_verify_job_restarts_on_mutation(void)
+{
+    forensics::EvidenceStore store;
+    fill_evidence(store, 6);
+
+    forensics::ChainVerifyJob job(store);
+    job.step();
+    job.step();
+    TEST_ASSERT_EQUAL(2, job.progress());
+
+    fill_evidence(store, 1);
+    core::JobStatus status = core::JobStatus::Pending;
+    for (int i = 0; i < 20 && status == core::JobStatus::Pending; ++i) {
+        status = job.step();
+    }
+    TEST_ASSERT_EQUAL(core::JobStatus::Done, status);
+    TEST_ASSERT_EQUAL(1, job.restarts());
+    TEST_ASSERT_EQUAL(7, job.progress());
+}
+
+// ============================================================================
+// KeygenAheadJob
+// ============================================================================
+
+static void test_keygen_ahead_then_rotate(void)
+{
+    JobFixture f;
+    security::KeyStorage key_storage(f.services);
+    security::CryptoEngine engine(f.crypto);
+    security::KeyRotationService rotation(key_storage, engine);
+    TEST_ASSERT_TRUE(rotation.initialize_if_needed().is_ok());
+
+    security::KeygenAheadJob job(engine);
+    TEST_ASSERT_TRUE(job.take().is_error());
+
+    core::JobScheduler<> scheduler;
+    scheduler.submit(job);
+    size_t cycles = 0;
+    while (scheduler.active() > 0 && cycles < 10) {
+        scheduler.run(f.time, 1);
+        ++cycles;
+    }
+    TEST_ASSERT_EQUAL(3, cycles); // generate, sign, verify: one per cycle
+    TEST_ASSERT_TRUE(job.is_ready());
+
+    auto staged = job.take();
+    TEST_ASSERT_TRUE(staged.is_ok());
+    TEST_ASSERT_FALSE(job.is_ready());
+
+    uint8_t staged_pub[security::ECC_PUBLIC_KEY_SIZE];
+    memcpy(staged_pub, staged.value().get_public_key(), sizeof(staged_pub));
+    TEST_ASSERT_TRUE(rotation.rotate_with(staged.value()).is_ok());
+    TEST_ASSERT_TRUE(rotation.has_backup());
+
+    security::ECCKeyPair primary;
+    TEST_ASSERT_TRUE(key_storage.load(primary, security::KeySlot::Primary).is_ok());
+    TEST_ASSERT_EQUAL_MEMORY(staged_pub, primary.get_public_key(), sizeof(staged_pub));
+}
+
+static void test_rotate_with_rejects_empty_key(void)
+{
+    JobFixture f;
+    security::KeyStorage key_storage(f.services);
+    security::CryptoEngine engine(f.crypto);
+    security::KeyRotationService rotation(key_storage, engine);
+
+    security::ECCKeyPair empty;
+    TEST_ASSERT_TRUE(rotation.rotate_with(empty).is_error());
+    TEST_ASSERT_FALSE(rotation.has_primary());
+}
+
+// ============================================================================
+// Main-loop latency under load
+// ============================================================================
+
+static constexpr size_t LATENCY_CYCLES = 64;
+
+static void test_job_main_loop_latency(void)
+{
+    JobFixture f;
+    auto config = f.make_config();
+    security::CryptoEngine engine(f.crypto);
+
+    forensics::EvidenceStore store;
+    fill_evidence(store, forensics::EVIDENCE_STORE_CAPACITY);
+
+    // Monolithic: full chain verify + keygen inline in one cycle
+    uint32_t worst_inline_us = 0;
+    {
+        GridShieldSystem system;
+        TEST_ASSERT_TRUE(system.initialize(config, f.services).is_ok());
+        TEST_ASSERT_TRUE(system.start().is_ok());
+        for (size_t i = 0; i < LATENCY_CYCLES; ++i) {
+            const uint64_t start = f.time.get_timestamp_us();
+            system.process_cycle();
+            if (i % 8 == 0) {
+                TEST_ASSERT_TRUE(store.verify_chain());
+                security::ECCKeyPair next;
+                engine.generate_keypair(next);
+            }
+            const auto elapsed = static_cast<uint32_t>(f.time.get_timestamp_us() - start);
+            worst_inline_us = (elapsed > worst_inline_us) ? elapsed : worst_inline_us;
+        }
+        system.shutdown();
+    }
+
+    // Incremental: the same work, resumed within the per-cycle budget
+    uint32_t worst_job_us = 0;
+    {
+        GridShieldSystem system;
+        TEST_ASSERT_TRUE(system.initialize(config, f.services).is_ok());
+        TEST_ASSERT_TRUE(system.start().is_ok());
+        forensics::ChainVerifyJob verify_job(store);
+        security::KeygenAheadJob keygen_job(engine);
+        for (size_t i = 0; i < LATENCY_CYCLES; ++i) {
+            if (i % 8 == 0) {
+                if (!system.jobs().is_queued(verify_job)) {
+                    verify_job.reset();
+                    system.submit_job(verify_job);
+                }
+                if (!system.jobs().is_queued(keygen_job)) {
+                    keygen_job.reset();
+                    system.submit_job(keygen_job);
+                }
+            }
+            const uint64_t start = f.time.get_timestamp_us();
+            system.process_cycle();
+            const auto elapsed = static_cast<uint32_t>(f.time.get_timestamp_us() - start);
+            worst_job_us = (elapsed > worst_job_us) ? elapsed : worst_job_us;
+        }
+        TEST_ASSERT_TRUE(verify_job.is_intact());
+        TEST_ASSERT_GREATER_THAN(0, system.telemetry().counters().max_cycle_us);
+        TEST_ASSERT_GREATER_THAN(0, system.jobs().stats().jobs_completed);
+        system.shutdown();
+    }
+
+    printf("  [latency] worst main-loop cycle: inline=%u us, incremental=%u us (%zu cycles)\n",
+           static_cast<unsigned>(worst_inline_us),
+           static_cast<unsigned>(worst_job_us),
+           LATENCY_CYCLES);
+}
+
+// ============================================================================
+// Suite Registration
+// ============================================================================
+
+void test_incremental_job_suite(void)
+{
+    RUN_TEST(test_job_scheduler_runs_to_completion);
+    RUN_TEST(test_job_scheduler_rejects_duplicate_and_full);
+    RUN_TEST(test_job_scheduler_defers_step_over_budget);
+    RUN_TEST(test_chain_verify_job_matches_monolithic);
+    RUN_TEST(test_chain_verify_job_detects_tamper);
+    RUN_TEST(test_chain_verify_job_restarts_on_mutation);
+    RUN_TEST(test_keygen_ahead_then_rotate);
+    RUN_TEST(test_rotate_with_rejects_empty_key);
+    RUN_TEST(test_job_main_loop_latency);
+}
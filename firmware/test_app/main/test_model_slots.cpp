@@ -0,0 +1,428 @@
+/**
+ * @file test_model_slots.cpp
+ * @brief Unit tests for double-buffered model hot-swap (verify, warm-up, rollback)
+ */
+
+#include "unity.h"
+
+#include "analytics/model_slots.hpp"
+#include "platform/mock_platform.hpp"
+#include "security/crypto.hpp"
+
+#include <cstdio>
+#include <cstring>
+
+using namespace gridshield;
+using namespace gridshield::analytics;
+using namespace gridshield::platform::mock;
+
+// ============================================================================
+// Helpers
+// ============================================================================
+
+static constexpr size_t TEST_MODEL_MAX = 1024;
+static constexpr uint32_t TEST_MODEL_SIZE = 700;
+static constexpr size_t TEST_CHUNK = 128;
+
+using TestSlots = ModelSlotManager<TEST_MODEL_MAX>;
+
+static MockCrypto g_mock_crypto;
+
+static security::CryptoEngine& engine()
+{
+    static security::CryptoEngine crypto(g_mock_crypto);
+    return crypto;
+}
+
+/// Publisher key pair, generated once (signing is slow on the host too).
+static security::ECCKeyPair& publisher()
+{
+    static security::ECCKeyPair key;
+    if (!key.has_private_key()) {
+        TEST_ASSERT_TRUE(engine().generate_keypair(key).is_ok());
+    }
+    return key;
+}
+
+static ModelSlotConfig small_config()
+{
+    ModelSlotConfig config;
+    config.slot_address = {{0x0000, 0x0400}};
+    config.slot_capacity = TEST_MODEL_MAX;
+    config.record_address = 0x0800;
+    config.probation_samples = 32;
+    return config;
+}
+
+struct TestModel
+{
+    uint8_t blob[TEST_MODEL_SIZE]{};
+    ModelManifest manifest{};
+};
+
+static void make_model(TestModel& model, uint32_t version, int32_t threshold_x1000 = 0,
+                       security::ECCKeyPair* signer = nullptr)
+{
+    for (uint32_t i = 0; i < TEST_MODEL_SIZE; ++i) {
+        model.blob[i] = static_cast<uint8_t>(i * 31U + version);
+    }
+    model.manifest = ModelManifest{};
+    model.manifest.version = version;
+    model.manifest.size_bytes = TEST_MODEL_SIZE;
+    model.manifest.threshold_x1000 = threshold_x1000;
+    TEST_ASSERT_TRUE(
+        engine().hash_sha256(model.blob, TEST_MODEL_SIZE, model.manifest.sha256.data()).is_ok());
+    uint8_t body[MODEL_SIGNED_BODY_SIZE];
+    model.manifest.signed_body(body);
+    TEST_ASSERT_TRUE(engine()
+                         .sign(signer != nullptr ? *signer : publisher(), body, sizeof(body),
+                               model.manifest.signature.data())
+                         .is_ok());
+}
+
+static void stream_model(TestSlots& slots, const TestModel& model)
+{
+    TEST_ASSERT_TRUE(slots.begin_update(model.manifest).is_ok());
+    for (uint32_t off = 0; off < TEST_MODEL_SIZE; off += TEST_CHUNK) {
+        const uint32_t left = TEST_MODEL_SIZE - off;
+        const size_t len = left < TEST_CHUNK ? left : TEST_CHUNK;
+        TEST_ASSERT_TRUE(slots.write_chunk(&model.blob[off], len).is_ok());
+    }
+    TEST_ASSERT_TRUE(slots.finish_update().is_ok());
+}
+
+/// Run the warm-up job to completion; returns the final status.
+static core::JobStatus run_warmup(TestSlots& slots, uint32_t* steps = nullptr)
+{
+    auto& job = slots.warmup_job();
+    core::JobStatus status = core::JobStatus::Pending;
+    uint32_t count = 0;
+    while (status == core::JobStatus::Pending && count < 1000) {
+        status = job.step();
+        ++count;
+    }
+    if (steps != nullptr) {
+        *steps = count;
+    }
+    return status;
+}
+
+static void set_score(TfliteRunner& runner, int32_t score_x1000)
+{
+    runner.set_mock_output(&score_x1000, 1);
+}
+
+static SensorSnapshot snapshot(uint64_t t)
+{
+    SensorSnapshot s;
+    s.voltage_mv = 230000;
+    s.current_ma = 4000;
+    s.energy_wh = 900;
+    s.timestamp = t;
+    return s;
+}
+
+/// Harness with model v1 already active in slot 0.
+struct Rig
+{
+    MockStorage storage;
+    TfliteRunner runner_a;
+    TfliteRunner runner_b;
+    MlAnomalyDetector detector;
+    TestSlots slots;
+    uint64_t t{0};
+
+    void boot()
+    {
+        set_score(runner_a, 100);
+        set_score(runner_b, 100);
+        TEST_ASSERT_TRUE(
+            slots.init(runner_a, runner_b, storage, engine(), publisher(), small_config())
+                .is_ok());
+        TEST_ASSERT_TRUE(detector.init(&runner_a).is_ok());
+        slots.bind(detector);
+
+        static TestModel v1;
+        make_model(v1, 1);
+        stream_model(slots, v1);
+        TEST_ASSERT_EQUAL(static_cast<uint8_t>(core::JobStatus::Done),
+                          static_cast<uint8_t>(run_warmup(slots)));
+        TEST_ASSERT_TRUE(slots.activate().is_ok());
+    }
+
+    /// Score one reading through the detector and report it to the manager.
+    bool score()
+    {
+        auto result = detector.score(snapshot(t++));
+        slots.observe(result);
+        return result.is_ok() && result.value().valid;
+    }
+};
+
+// ============================================================================
+// Tests
+// ============================================================================
+
+static void test_slots_init_validation()
+{
+    MockStorage storage;
+    TfliteRunner a;
+    TfliteRunner b;
+    TestSlots slots;
+    security::ECCKeyPair no_key;
+
+    TEST_ASSERT_TRUE(slots.init(a, b, storage, engine(), no_key, small_config()).is_error());
+    ModelSlotConfig too_big = small_config();
+    too_big.slot_capacity = TEST_MODEL_MAX + 1;
+    TEST_ASSERT_TRUE(slots.init(a, b, storage, engine(), publisher(), too_big).is_error());
+
+    TestModel model;
+    make_model(model, 1);
+    TEST_ASSERT_EQUAL(static_cast<int>(core::ErrorCode::SystemNotInitialized),
+                      static_cast<int>(slots.begin_update(model.manifest).error().code));
+}
+
+static void test_slots_first_model_trusted()
+{
+    static Rig rig;
+    rig.boot();
+
+    TEST_ASSERT_EQUAL(0, rig.slots.active_slot());
+    TEST_ASSERT_EQUAL(1, rig.slots.active_version());
+    TEST_ASSERT_FALSE(rig.slots.in_probation());
+    TEST_ASSERT_EQUAL(static_cast<uint8_t>(ModelSlotState::Active),
+                      static_cast<uint8_t>(rig.slots.slot_state(0)));
+    TEST_ASSERT_EQUAL(1, rig.slots.stats().confirmations);
+    TEST_ASSERT_TRUE(rig.runner_a.is_loaded());
+    TEST_ASSERT_TRUE(rig.score());
+}
+
+static void test_slots_hot_swap_zero_gap()
+{
+    static Rig rig;
+    rig.boot();
+    for (int i = 0; i < 40; ++i) {
+        TEST_ASSERT_TRUE(rig.score());
+    }
+
+    // Stream, verify and warm up v2 while v1 keeps scoring every cycle
+    static TestModel v2;
+    make_model(v2, 2, 650);
+    uint32_t missed = 0;
+    TEST_ASSERT_TRUE(rig.slots.begin_update(v2.manifest).is_ok());
+    for (uint32_t off = 0; off < TEST_MODEL_SIZE; off += TEST_CHUNK) {
+        const uint32_t left = TEST_MODEL_SIZE - off;
+        TEST_ASSERT_TRUE(
+            rig.slots.write_chunk(&v2.blob[off], left < TEST_CHUNK ? left : TEST_CHUNK).is_ok());
+        missed += rig.score() ? 0U : 1U;
+    }
+    TEST_ASSERT_TRUE(rig.slots.finish_update().is_ok());
+
+    uint32_t warmup_steps = 0;
+    core::JobStatus status = core::JobStatus::Pending;
+    while (status == core::JobStatus::Pending) {
+        status = rig.slots.warmup_job().step();
+        ++warmup_steps;
+        missed += rig.score() ? 0U : 1U;
+    }
+    TEST_ASSERT_EQUAL(static_cast<uint8_t>(core::JobStatus::Done), static_cast<uint8_t>(status));
+    TEST_ASSERT_EQUAL(static_cast<uint8_t>(ModelSlotState::Ready),
+                      static_cast<uint8_t>(rig.slots.slot_state(1)));
+
+    const uint32_t a_before = rig.runner_a.invoke_count();
+    const uint32_t b_before = rig.runner_b.invoke_count();
+    TEST_ASSERT_TRUE(rig.slots.activate().is_ok());
+    missed += rig.score() ? 0U : 1U;
+
+    // The very next reading went to v2; v1 stays loaded as the fallback
+    TEST_ASSERT_EQUAL(a_before, rig.runner_a.invoke_count());
+    TEST_ASSERT_EQUAL(b_before + 1, rig.runner_b.invoke_count());
+    TEST_ASSERT_TRUE(rig.slots.in_probation());
+    TEST_ASSERT_TRUE(rig.runner_a.is_loaded());
+    TEST_ASSERT_EQUAL(650, rig.detector.threshold() + ML_ADAPTIVE_STEP_X1000);
+
+    for (int i = 0; i < 40; ++i) {
+        missed += rig.score() ? 0U : 1U;
+    }
+    printf("  swap: %u warm-up steps, detection gap %u readings\n",
+           static_cast<unsigned>(warmup_steps), static_cast<unsigned>(missed));
+    TEST_ASSERT_EQUAL(0, missed);
+    TEST_ASSERT_EQUAL(0, rig.slots.stats().inference_failures);
+
+    // Probation passed: v2 confirmed, v1's slot released
+    TEST_ASSERT_FALSE(rig.slots.in_probation());
+    TEST_ASSERT_EQUAL(1, rig.slots.active_slot());
+    TEST_ASSERT_EQUAL(2, rig.slots.active_version());
+    TEST_ASSERT_FALSE(rig.runner_a.is_loaded());
+    TEST_ASSERT_EQUAL(static_cast<uint8_t>(ModelSlotState::Empty),
+                      static_cast<uint8_t>(rig.slots.slot_state(0)));
+}
+
+static void test_slots_rejects_tampered_blob()
+{
+    static Rig rig;
+    rig.boot();
+
+    static TestModel v2;
+    make_model(v2, 2);
+    v2.blob[10] ^= 0x01; // bit flip after signing (MockCrypto hashes the head only)
+    stream_model(rig.slots, v2);
+    TEST_ASSERT_EQUAL(static_cast<uint8_t>(core::JobStatus::Failed),
+                      static_cast<uint8_t>(run_warmup(rig.slots)));
+    TEST_ASSERT_EQUAL(1, rig.slots.stats().verify_failures);
+    TEST_ASSERT_EQUAL(static_cast<uint8_t>(ModelSlotState::Failed),
+                      static_cast<uint8_t>(rig.slots.slot_state(1)));
+    TEST_ASSERT_TRUE(rig.slots.activate().is_error());
+    TEST_ASSERT_FALSE(rig.runner_b.is_loaded());
+    TEST_ASSERT_TRUE(rig.score());
+}
+
+static void test_slots_rejects_foreign_signature()
+{
+    static Rig rig;
+    rig.boot();
+
+    static security::ECCKeyPair rogue;
+    TEST_ASSERT_TRUE(engine().generate_keypair(rogue).is_ok());
+    static TestModel v2;
+    make_model(v2, 2, 0, &rogue);
+    stream_model(rig.slots, v2);
+    TEST_ASSERT_EQUAL(static_cast<uint8_t>(core::JobStatus::Failed),
+                      static_cast<uint8_t>(run_warmup(rig.slots)));
+    TEST_ASSERT_EQUAL(1, rig.slots.stats().verify_failures);
+    TEST_ASSERT_EQUAL(1, rig.slots.active_version());
+}
+
+static void test_slots_calibration_mismatch()
+{
+    static Rig rig;
+    rig.boot();
+
+    ModelCalibration cal[2];
+    cal[0].features[2] = 900;
+    cal[0].expected_score_x1000 = 100;
+    cal[1].features[2] = 50;
+    cal[1].expected_score_x1000 = 900; // a theft pattern the new model must flag
+    TEST_ASSERT_TRUE(rig.slots.set_calibration(cal, 2).is_ok());
+
+    static TestModel v2;
+    make_model(v2, 2);
+    stream_model(rig.slots, v2);
+    set_score(rig.runner_b, 100); // new model scores everything as normal
+    TEST_ASSERT_EQUAL(static_cast<uint8_t>(core::JobStatus::Failed),
+                      static_cast<uint8_t>(run_warmup(rig.slots)));
+    TEST_ASSERT_EQUAL(1, rig.slots.stats().calibration_failures);
+    TEST_ASSERT_TRUE(rig.slots.activate().is_error());
+}
+
+static void test_slots_rollback_on_anomaly_regression()
+{
+    static Rig rig;
+    rig.boot();
+    for (int i = 0; i < 64; ++i) {
+        TEST_ASSERT_TRUE(rig.score());
+    }
+    const int32_t threshold_before = rig.detector.threshold();
+
+    static TestModel v2;
+    make_model(v2, 2, 400);
+    stream_model(rig.slots, v2);
+    TEST_ASSERT_EQUAL(static_cast<uint8_t>(core::JobStatus::Done),
+                      static_cast<uint8_t>(run_warmup(rig.slots)));
+    set_score(rig.runner_b, 950); // flags every reading after the swap
+    TEST_ASSERT_TRUE(rig.slots.activate().is_ok());
+
+    for (uint32_t i = 0; i < small_config().probation_samples; ++i) {
+        TEST_ASSERT_TRUE(rig.score());
+    }
+    TEST_ASSERT_EQUAL(1, rig.slots.stats().rollbacks);
+    TEST_ASSERT_FALSE(rig.slots.in_probation());
+    TEST_ASSERT_EQUAL(0, rig.slots.active_slot());
+    TEST_ASSERT_EQUAL(threshold_before, rig.detector.threshold());
+    TEST_ASSERT_EQUAL(static_cast<uint8_t>(ModelSlotState::Failed),
+                      static_cast<uint8_t>(rig.slots.slot_state(1)));
+
+    // Back on v1: the next reading goes to runner A
+    const uint32_t a_before = rig.runner_a.invoke_count();
+    TEST_ASSERT_TRUE(rig.score());
+    TEST_ASSERT_EQUAL(a_before + 1, rig.runner_a.invoke_count());
+}
+
+static void test_slots_rollback_on_inference_failure()
+{
+    static Rig rig;
+    rig.boot();
+
+    static TestModel v2;
+    make_model(v2, 2);
+    stream_model(rig.slots, v2);
+    TEST_ASSERT_EQUAL(static_cast<uint8_t>(core::JobStatus::Done),
+                      static_cast<uint8_t>(run_warmup(rig.slots)));
+    TEST_ASSERT_TRUE(rig.slots.activate().is_ok());
+
+    // An update is refused while the fallback is still held
+    TEST_ASSERT_EQUAL(static_cast<int>(core::ErrorCode::InvalidState),
+                      static_cast<int>(rig.slots.begin_update(v2.manifest).error().code));
+
+    rig.runner_b.set_simulate_failure(true);
+    TEST_ASSERT_FALSE(rig.score()); // one failed inference is enough
+    TEST_ASSERT_EQUAL(1, rig.slots.stats().rollbacks);
+    TEST_ASSERT_EQUAL(0, rig.slots.active_slot());
+    TEST_ASSERT_TRUE(rig.score());
+}
+
+static void test_slots_restore_after_reboot()
+{
+    static Rig rig;
+    rig.boot();
+    static TestModel v2;
+    make_model(v2, 2);
+    stream_model(rig.slots, v2);
+    TEST_ASSERT_EQUAL(static_cast<uint8_t>(core::JobStatus::Done),
+                      static_cast<uint8_t>(run_warmup(rig.slots)));
+    TEST_ASSERT_TRUE(rig.slots.activate().is_ok());
+    for (uint32_t i = 0; i < small_config().probation_samples; ++i) {
+        TEST_ASSERT_TRUE(rig.score());
+    }
+    TEST_ASSERT_EQUAL(1, rig.slots.active_slot());
+
+    // "Reboot": fresh runners and manager over the same storage
+    static TfliteRunner a;
+    static TfliteRunner b;
+    static MlAnomalyDetector detector;
+    static TestSlots slots;
+    TEST_ASSERT_TRUE(
+        slots.init(a, b, rig.storage, engine(), publisher(), small_config()).is_ok());
+    TEST_ASSERT_TRUE(detector.init(&b).is_ok());
+    slots.bind(detector);
+    TEST_ASSERT_TRUE(slots.restore().is_ok());
+    TEST_ASSERT_EQUAL(1, slots.staged_slot());
+    TEST_ASSERT_EQUAL(static_cast<uint8_t>(core::JobStatus::Done),
+                      static_cast<uint8_t>(run_warmup(slots)));
+    TEST_ASSERT_TRUE(slots.activate().is_ok());
+    TEST_ASSERT_EQUAL(2, slots.active_version());
+    TEST_ASSERT_TRUE(b.is_loaded());
+
+    // Nothing recorded yet on a blank device
+    static MockStorage blank;
+    static TestSlots fresh;
+    TEST_ASSERT_TRUE(fresh.init(a, b, blank, engine(), publisher(), small_config()).is_ok());
+    TEST_ASSERT_TRUE(fresh.restore().is_error());
+}
+
+// ============================================================================
+// TEST SUITE ENTRY POINT
+// ============================================================================
+
+void test_model_slots_suite(void)
+{
+    RUN_TEST(test_slots_init_validation);
+    RUN_TEST(test_slots_first_model_trusted);
+    RUN_TEST(test_slots_hot_swap_zero_gap);
+    RUN_TEST(test_slots_rejects_tampered_blob);
+    RUN_TEST(test_slots_rejects_foreign_signature);
+    RUN_TEST(test_slots_calibration_mismatch);
+    RUN_TEST(test_slots_rollback_on_anomaly_regression);
+    RUN_TEST(test_slots_rollback_on_inference_failure);
+    RUN_TEST(test_slots_restore_after_reboot);
+}
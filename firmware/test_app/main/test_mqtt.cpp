@@ -2,7 +2,8 @@
  * @file test_mqtt.cpp
  * @brief Unit tests for MQTT client interface and WiFi HAL
  *
- * Tests MockWiFi connectivity and MqttConfig validation.
+ * Tests MockWiFi connectivity, MqttConfig validation and the mock
+ * peripherals (ADC, I2C, UART, comm).
  */
 
 #include "unity.h"
@@ -217,6 +218,36 @@ static void test_uart_inject_and_read()
     TEST_ASSERT_EQUAL_UINT8(0xCC, read_buf[2]);
 }
 
+// ============================================================================
+// Comm Mock Tests
+// ============================================================================
+
+static void test_comm_inject_and_receive_in_order()
+{
+    MockComm comm;
+    TEST_ASSERT_TRUE(comm.init().is_ok());
+    comm.set_connected(true);
+
+    // Bytes come back in wire order, so framed packets parse; a short read
+    // leaves the rest queued
+    static constexpr uint8_t INJECT_DATA[] = {0xAA, 0xBB, 0xCC, 0xDD};
+    comm.inject_rx_data(INJECT_DATA, sizeof(INJECT_DATA));
+
+    std::array<uint8_t, 8> read_buf{};
+    auto first = comm.receive(read_buf.data(), 3, 0);
+    TEST_ASSERT_TRUE(first.is_ok());
+    TEST_ASSERT_EQUAL(3, first.value());
+    TEST_ASSERT_EQUAL_UINT8(0xAA, read_buf[0]);
+    TEST_ASSERT_EQUAL_UINT8(0xBB, read_buf[1]);
+    TEST_ASSERT_EQUAL_UINT8(0xCC, read_buf[2]);
+
+    auto rest = comm.receive(read_buf.data(), read_buf.size(), 0);
+    TEST_ASSERT_TRUE(rest.is_ok());
+    TEST_ASSERT_EQUAL(1, rest.value());
+    TEST_ASSERT_EQUAL_UINT8(0xDD, read_buf[0]);
+    TEST_ASSERT_TRUE(comm.receive(read_buf.data(), read_buf.size(), 0).is_error());
+}
+
 // ============================================================================
 // TEST SUITE ENTRY POINT
 // ============================================================================
@@ -246,4 +277,7 @@ extern "C" void test_mqtt_suite(void)
     // UART peripheral
     RUN_TEST(test_uart_init_and_write);
     RUN_TEST(test_uart_inject_and_read);
+
+    // Comm peripheral
+    RUN_TEST(test_comm_inject_and_receive_in_order);
 }
@@ -0,0 +1,389 @@
+/**
+ * @file test_native_crypto.cpp
+ * @brief Known-answer tests for the host crypto backend and the ESP32 path
+ *
+ * The same NIST / RFC vectors run against NativeCrypto + NativeHwCrypto
+ * (both the portable and the AES-NI / SHA-NI dispatch) on native builds,
+ * and against Esp32Crypto on QEMU, so host results match the device.
+ */
+
+#include "unity.h"
+
+#include "utils/gs_macros.hpp"
+
+#if GS_PLATFORM_NATIVE
+#include "platform/native_crypto.hpp"
+#include <chrono>
+#elif defined(GS_QEMU_BUILD)
+#include "platform/esp32_platform.hpp"
+#endif
+
+#include <array>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+
+using namespace gridshield;
+
+// ============================================================================
+// Vectors (FIPS 180-2 App. B, RFC 4231, GCM spec test cases 13/14/16)
+// ============================================================================
+
+static constexpr char SHA_MSG_ABC[] = "abc";
+static constexpr uint8_t SHA_DIGEST_ABC[32] = {
+    0xBA, 0x78, 0x16, 0xBF, 0x8F, 0x01, 0xCF, 0xEA, 0x41, 0x41, 0x40, 0xDE, 0x5D, 0xAE, 0x22, 0x23,
+    0xB0, 0x03, 0x61, 0xA3, 0x96, 0x17, 0x7A, 0x9C, 0xB4, 0x10, 0xFF, 0x61, 0xF2, 0x00, 0x15, 0xAD};
+
+static constexpr uint8_t SHA_DIGEST_EMPTY[32] = {
+    0xE3, 0xB0, 0xC4, 0x42, 0x98, 0xFC, 0x1C, 0x14, 0x9A, 0xFB, 0xF4, 0xC8, 0x99, 0x6F, 0xB9, 0x24,
+    0x27, 0xAE, 0x41, 0xE4, 0x64, 0x9B, 0x93, 0x4C, 0xA4, 0x95, 0x99, 0x1B, 0x78, 0x52, 0xB8, 0x55};
+
+static constexpr char SHA_MSG_TWO_BLOCK[] =
+    "abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq";
+static constexpr uint8_t SHA_DIGEST_TWO_BLOCK[32] = {
+    0x24, 0x8D, 0x6A, 0x61, 0xD2, 0x06, 0x38, 0xB8, 0xE5, 0xC0, 0x26, 0x93, 0x0C, 0x3E, 0x60, 0x39,
+    0xA3, 0x3C, 0xE4, 0x59, 0x64, 0xFF, 0x21, 0x67, 0xF6, 0xEC, 0xED, 0xD4, 0x19, 0xDB, 0x06, 0xC1};
+
+static constexpr char CRC_MSG[] = "123456789";
+static constexpr uint32_t CRC_CHECK = 0xCBF43926U;
+
+static const uint8_t* as_bytes(const char* str)
+{
+    return reinterpret_cast<const uint8_t*>(str);
+}
+
+#if GS_PLATFORM_NATIVE
+
+static constexpr char HMAC_KEY[] = "Jefe";
+static constexpr char HMAC_MSG[] = "what do ya want for nothing?";
+static constexpr uint8_t HMAC_EXPECTED[32] = {
+    0x5B, 0xDC, 0xC1, 0x46, 0xBF, 0x60, 0x75, 0x4E, 0x6A, 0x04, 0x24, 0x26, 0x08, 0x95, 0x75, 0xC7,
+    0x5A, 0x00, 0x3F, 0x08, 0x9D, 0x27, 0x39, 0x83, 0x9D, 0xEC, 0x58, 0xB9, 0x64, 0xEC, 0x38, 0x43};
+
+static constexpr uint8_t GCM_ZERO_KEY[32] = {};
+static constexpr uint8_t GCM_ZERO_IV[12] = {};
+static constexpr uint8_t GCM_ZERO_BLOCK[16] = {};
+static constexpr uint8_t GCM_TC13_TAG[16] = {0x53, 0x0F, 0x8A, 0xFB, 0xC7, 0x45, 0x36, 0xB9,
+                                             0xA9, 0x63, 0xB4, 0xF1, 0xC4, 0xCB, 0x73, 0x8B};
+static constexpr uint8_t GCM_TC14_CT[16] = {0xCE, 0xA7, 0x40, 0x3D, 0x4D, 0x60, 0x6B, 0x6E,
+                                            0x07, 0x4E, 0xC5, 0xD3, 0xBA, 0xF3, 0x9D, 0x18};
+static constexpr uint8_t GCM_TC14_TAG[16] = {0xD0, 0xD1, 0xC8, 0xA7, 0x99, 0x99, 0x6B, 0xF0,
+                                             0x26, 0x5B, 0x98, 0xB5, 0xD4, 0x8A, 0xB9, 0x19};
+
+static constexpr uint8_t GCM_TC16_KEY[32] = {
+    0xFE, 0xFF, 0xE9, 0x92, 0x86, 0x65, 0x73, 0x1C, 0x6D, 0x6A, 0x8F, 0x94, 0x67, 0x30, 0x83, 0x08,
+    0xFE, 0xFF, 0xE9, 0x92, 0x86, 0x65, 0x73, 0x1C, 0x6D, 0x6A, 0x8F, 0x94, 0x67, 0x30, 0x83, 0x08};
+static constexpr uint8_t GCM_TC16_IV[12] = {0xCA, 0xFE, 0xBA, 0xBE, 0xFA, 0xCE,
+                                            0xDB, 0xAD, 0xDE, 0xCA, 0xF8, 0x88};
+static constexpr uint8_t GCM_TC16_AAD[20] = {0xFE, 0xED, 0xFA, 0xCE, 0xDE, 0xAD, 0xBE,
+                                             0xEF, 0xFE, 0xED, 0xFA, 0xCE, 0xDE, 0xAD,
+                                             0xBE, 0xEF, 0xAB, 0xAD, 0xDA, 0xD2};
+static constexpr uint8_t GCM_TC16_PT[60] = {
+    0xD9, 0x31, 0x32, 0x25, 0xF8, 0x84, 0x06, 0xE5, 0xA5, 0x59, 0x09, 0xC5, 0xAF, 0xF5, 0x26,
+    0x9A, 0x86, 0xA7, 0xA9, 0x53, 0x15, 0x34, 0xF7, 0xDA, 0x2E, 0x4C, 0x30, 0x3D, 0x8A, 0x31,
+    0x8A, 0x72, 0x1C, 0x3C, 0x0C, 0x95, 0x95, 0x68, 0x09, 0x53, 0x2F, 0xCF, 0x0E, 0x24, 0x49,
+    0xA6, 0xB5, 0x25, 0xB1, 0x6A, 0xED, 0xF5, 0xAA, 0x0D, 0xE6, 0x57, 0xBA, 0x63, 0x7B, 0x39};
+static constexpr uint8_t GCM_TC16_CT[60] = {
+    0x52, 0x2D, 0xC1, 0xF0, 0x99, 0x56, 0x7D, 0x07, 0xF4, 0x7F, 0x37, 0xA3, 0x2A, 0x84, 0x42,
+    0x7D, 0x64, 0x3A, 0x8C, 0xDC, 0xBF, 0xE5, 0xC0, 0xC9, 0x75, 0x98, 0xA2, 0xBD, 0x25, 0x55,
+    0xD1, 0xAA, 0x8C, 0xB0, 0x8E, 0x48, 0x59, 0x0D, 0xBB, 0x3D, 0xA7, 0xB0, 0x8B, 0x10, 0x56,
+    0x82, 0x88, 0x38, 0xC5, 0xF6, 0x1E, 0x63, 0x93, 0xBA, 0x7A, 0x0A, 0xBC, 0xC9, 0xF6, 0x62};
+static constexpr uint8_t GCM_TC16_TAG[16] = {0x76, 0xFC, 0x6E, 0xCE, 0x0F, 0x4E, 0x17, 0x68,
+                                             0xCD, 0xDF, 0x88, 0x53, 0xBB, 0x2D, 0x55, 0x1B};
+
+using platform::native::NativeCrypto;
+using platform::native::NativeHwCrypto;
+
+// Run every KAT on the portable path first, then on the accelerated path
+static constexpr bool DISPATCH_MODES[] = {false, true};
+
+// ============================================================================
+// IPlatformCrypto
+// ============================================================================
+
+static void test_nc_sha256_kat()
+{
+    NativeCrypto crypto;
+    std::array<uint8_t, 32> digest{};
+
+    TEST_ASSERT_TRUE(crypto.sha256(as_bytes(SHA_MSG_ABC), 3, digest.data()).is_ok());
+    TEST_ASSERT_EQUAL_MEMORY(SHA_DIGEST_ABC, digest.data(), digest.size());
+
+    TEST_ASSERT_TRUE(crypto.sha256(as_bytes(""), 0, digest.data()).is_ok());
+    TEST_ASSERT_EQUAL_MEMORY(SHA_DIGEST_EMPTY, digest.data(), digest.size());
+
+    TEST_ASSERT_TRUE(crypto
+                         .sha256(as_bytes(SHA_MSG_TWO_BLOCK),
+                                 std::strlen(SHA_MSG_TWO_BLOCK),
+                                 digest.data())
+                         .is_ok());
+    TEST_ASSERT_EQUAL_MEMORY(SHA_DIGEST_TWO_BLOCK, digest.data(), digest.size());
+}
+
+static void test_nc_sha256_streaming_matches_oneshot()
+{
+    // Odd chunk sizes exercise every buffering branch of update()
+    std::array<uint8_t, 1000> msg{};
+    for (size_t idx = 0; idx < msg.size(); ++idx) {
+        msg[idx] = static_cast<uint8_t>(idx * 7U);
+    }
+
+    for (bool allow_hw : DISPATCH_MODES) {
+        std::array<uint8_t, 32> oneshot{};
+        std::array<uint8_t, 32> streamed{};
+        platform::native::Sha256 ctx(allow_hw);
+        ctx.update(msg.data(), msg.size());
+        ctx.finish(oneshot.data());
+
+        static constexpr size_t CHUNKS[] = {1, 63, 64, 65, 7, 200};
+        size_t off = 0;
+        size_t chunk_idx = 0;
+        while (off < msg.size()) {
+            size_t take = CHUNKS[chunk_idx++ % (sizeof(CHUNKS) / sizeof(CHUNKS[0]))];
+            take = (take < msg.size() - off) ? take : (msg.size() - off);
+            ctx.update(msg.data() + off, take);
+            off += take;
+        }
+        ctx.finish(streamed.data());
+        TEST_ASSERT_EQUAL_MEMORY(oneshot.data(), streamed.data(), oneshot.size());
+    }
+}
+
+static void test_nc_crc32_check_value()
+{
+    NativeCrypto crypto;
+    auto result = crypto.crc32(as_bytes(CRC_MSG), std::strlen(CRC_MSG));
+    TEST_ASSERT_TRUE(result.is_ok());
+    TEST_ASSERT_EQUAL_UINT32(CRC_CHECK, result.value());
+}
+
+static void test_nc_random_bytes()
+{
+    NativeCrypto crypto;
+    std::array<uint8_t, 32> first{};
+    std::array<uint8_t, 32> second{};
+    TEST_ASSERT_TRUE(crypto.random_bytes(first.data(), first.size()).is_ok());
+    TEST_ASSERT_TRUE(crypto.random_bytes(second.data(), second.size()).is_ok());
+    TEST_ASSERT_TRUE(std::memcmp(first.data(), second.data(), first.size()) != 0);
+    TEST_ASSERT_TRUE(crypto.random_bytes(nullptr, 4).is_error());
+}
+
+// ============================================================================
+// IHwCrypto
+// ============================================================================
+
+static void test_nc_hw_requires_init()
+{
+    NativeHwCrypto crypto;
+    auto result = crypto.sha256(as_bytes(SHA_MSG_ABC), 3);
+    TEST_ASSERT_TRUE(result.is_error());
+    TEST_ASSERT_EQUAL(core::ErrorCode::SystemNotInitialized, result.error().code);
+}
+
+static void test_nc_hw_sha256_and_hmac_kat()
+{
+    for (bool allow_hw : DISPATCH_MODES) {
+        NativeHwCrypto crypto;
+        crypto.set_allow_hw(allow_hw);
+        TEST_ASSERT_TRUE(crypto.init().is_ok());
+
+        auto digest = crypto.sha256(as_bytes(SHA_MSG_TWO_BLOCK), std::strlen(SHA_MSG_TWO_BLOCK));
+        TEST_ASSERT_TRUE(digest.is_ok());
+        TEST_ASSERT_EQUAL_MEMORY(SHA_DIGEST_TWO_BLOCK, digest.value().data(), 32);
+
+        auto mac = crypto.hmac_sha256(
+            as_bytes(HMAC_KEY), std::strlen(HMAC_KEY), as_bytes(HMAC_MSG), std::strlen(HMAC_MSG));
+        TEST_ASSERT_TRUE(mac.is_ok());
+        TEST_ASSERT_EQUAL_MEMORY(HMAC_EXPECTED, mac.value().data(), 32);
+    }
+}
+
+static void test_nc_gcm_kat_zero_key()
+{
+    for (bool allow_hw : DISPATCH_MODES) {
+        NativeHwCrypto crypto;
+        crypto.set_allow_hw(allow_hw);
+        crypto.init();
+
+        // Test case 13: empty plaintext, tag only
+        auto tc13 = crypto.aes_gcm_encrypt(GCM_ZERO_KEY, GCM_ZERO_IV, nullptr, 0, nullptr, 0);
+        TEST_ASSERT_TRUE(tc13.is_ok());
+        TEST_ASSERT_EQUAL_MEMORY(GCM_TC13_TAG, tc13.value().tag.data(), 16);
+
+        // Test case 14: one zero block
+        auto tc14 = crypto.aes_gcm_encrypt(
+            GCM_ZERO_KEY, GCM_ZERO_IV, GCM_ZERO_BLOCK, sizeof(GCM_ZERO_BLOCK), nullptr, 0);
+        TEST_ASSERT_TRUE(tc14.is_ok());
+        TEST_ASSERT_EQUAL_MEMORY(GCM_TC14_CT, tc14.value().data.data(), 16);
+        TEST_ASSERT_EQUAL_MEMORY(GCM_TC14_TAG, tc14.value().tag.data(), 16);
+    }
+}
+
+static void test_nc_gcm_kat_with_aad()
+{
+    for (bool allow_hw : DISPATCH_MODES) {
+        NativeHwCrypto crypto;
+        crypto.set_allow_hw(allow_hw);
+        crypto.init();
+
+        // Test case 16: partial final block + 20-byte AAD
+        auto enc = crypto.aes_gcm_encrypt(GCM_TC16_KEY, GCM_TC16_IV, GCM_TC16_PT,
+                                          sizeof(GCM_TC16_PT), GCM_TC16_AAD, sizeof(GCM_TC16_AAD));
+        TEST_ASSERT_TRUE(enc.is_ok());
+        TEST_ASSERT_EQUAL(sizeof(GCM_TC16_CT), enc.value().length);
+        TEST_ASSERT_EQUAL_MEMORY(GCM_TC16_CT, enc.value().data.data(), sizeof(GCM_TC16_CT));
+        TEST_ASSERT_EQUAL_MEMORY(GCM_TC16_TAG, enc.value().tag.data(), 16);
+
+        auto dec = crypto.aes_gcm_decrypt(GCM_TC16_KEY, GCM_TC16_IV, GCM_TC16_CT,
+                                          sizeof(GCM_TC16_CT), GCM_TC16_TAG, GCM_TC16_AAD,
+                                          sizeof(GCM_TC16_AAD));
+        TEST_ASSERT_TRUE(dec.is_ok());
+        TEST_ASSERT_EQUAL_MEMORY(GCM_TC16_PT, dec.value().data.data(), sizeof(GCM_TC16_PT));
+    }
+}
+
+static void test_nc_gcm_rejects_bad_tag()
+{
+    NativeHwCrypto crypto;
+    crypto.init();
+
+    std::array<uint8_t, 16> bad_tag{};
+    std::memcpy(bad_tag.data(), GCM_TC16_TAG, bad_tag.size());
+    bad_tag[0] ^= 0x01;
+
+    auto dec = crypto.aes_gcm_decrypt(GCM_TC16_KEY, GCM_TC16_IV, GCM_TC16_CT, sizeof(GCM_TC16_CT),
+                                      bad_tag.data(), GCM_TC16_AAD, sizeof(GCM_TC16_AAD));
+    TEST_ASSERT_TRUE(dec.is_error());
+    TEST_ASSERT_EQUAL(core::ErrorCode::AuthenticationFailed, dec.error().code);
+}
+
+static void test_nc_gcm_paths_agree_on_max_payload()
+{
+    // Bulk 4-block lanes + tail on the accelerated path vs. the portable reference
+    static constexpr size_t PAYLOAD = security::HW_CRYPTO_MAX_DATA_SIZE - 5;
+    static std::array<uint8_t, PAYLOAD> plain{};
+    for (size_t idx = 0; idx < plain.size(); ++idx) {
+        plain[idx] = static_cast<uint8_t>((idx * 31U) ^ (idx >> 8));
+    }
+
+    NativeHwCrypto portable;
+    portable.set_allow_hw(false);
+    portable.init();
+    NativeHwCrypto accel;
+    accel.init();
+
+    auto ref = portable.aes_gcm_encrypt(
+        GCM_TC16_KEY, GCM_TC16_IV, plain.data(), plain.size(), GCM_TC16_AAD, sizeof(GCM_TC16_AAD));
+    auto out = accel.aes_gcm_encrypt(
+        GCM_TC16_KEY, GCM_TC16_IV, plain.data(), plain.size(), GCM_TC16_AAD, sizeof(GCM_TC16_AAD));
+    TEST_ASSERT_TRUE(ref.is_ok());
+    TEST_ASSERT_TRUE(out.is_ok());
+    TEST_ASSERT_EQUAL_MEMORY(ref.value().data.data(), out.value().data.data(), PAYLOAD);
+    TEST_ASSERT_EQUAL_MEMORY(ref.value().tag.data(), out.value().tag.data(), 16);
+}
+
+// ============================================================================
+// Throughput (informational — prints GB/s per dispatch path)
+// ============================================================================
+
+static volatile uint8_t g_bench_sink = 0;
+
+static double measure_gbps(NativeHwCrypto& crypto, bool gcm)
+{
+    static constexpr size_t BENCH_ITERATIONS = 2048;
+    static std::array<uint8_t, security::HW_CRYPTO_MAX_DATA_SIZE> payload{};
+    uint8_t sink = 0;
+
+    const auto start = std::chrono::steady_clock::now();
+    for (size_t iter = 0; iter < BENCH_ITERATIONS; ++iter) {
+        payload[0] = static_cast<uint8_t>(iter);
+        if (gcm) {
+            auto res = crypto.aes_gcm_encrypt(
+                GCM_TC16_KEY, GCM_TC16_IV, payload.data(), payload.size(), nullptr, 0);
+            sink ^= res.value().tag[0];
+        } else {
+            auto res = crypto.sha256(payload.data(), payload.size());
+            sink ^= res.value()[0];
+        }
+    }
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+    g_bench_sink = sink;
+    const double secs = std::chrono::duration<double>(elapsed).count();
+    return (static_cast<double>(BENCH_ITERATIONS) * payload.size()) / (secs * 1e9);
+}
+
+static void test_nc_benchmark_throughput()
+{
+    for (bool allow_hw : DISPATCH_MODES) {
+        NativeHwCrypto crypto;
+        crypto.set_allow_hw(allow_hw);
+        crypto.init();
+        const double gcm_gbps = measure_gbps(crypto, true);
+        const double sha_gbps = measure_gbps(crypto, false);
+        printf("\n    [%s] AES-256-GCM %.3f GB/s (%s), SHA-256 %.3f GB/s (%s) ",
+               allow_hw ? "dispatch" : "portable", gcm_gbps,
+               crypto.has_hw_acceleration() ? "AES-NI+CLMUL" : "C++", sha_gbps,
+               crypto.has_sha_acceleration() ? "SHA-NI" : "C++");
+        TEST_ASSERT_TRUE(gcm_gbps > 0.0);
+        TEST_ASSERT_TRUE(sha_gbps > 0.0);
+    }
+}
+
+#elif defined(GS_QEMU_BUILD)
+
+// ============================================================================
+// ESP32 path — same vectors through Esp32Crypto (mbedTLS + ROM CRC)
+// ============================================================================
+
+static void test_esp32_sha256_kat()
+{
+    platform::esp32::Esp32Crypto crypto;
+    std::array<uint8_t, 32> digest{};
+
+    TEST_ASSERT_TRUE(crypto.sha256(as_bytes(SHA_MSG_ABC), 3, digest.data()).is_ok());
+    TEST_ASSERT_EQUAL_MEMORY(SHA_DIGEST_ABC, digest.data(), digest.size());
+
+    TEST_ASSERT_TRUE(crypto.sha256(as_bytes(""), 0, digest.data()).is_ok());
+    TEST_ASSERT_EQUAL_MEMORY(SHA_DIGEST_EMPTY, digest.data(), digest.size());
+
+    TEST_ASSERT_TRUE(crypto
+                         .sha256(as_bytes(SHA_MSG_TWO_BLOCK),
+                                 std::strlen(SHA_MSG_TWO_BLOCK),
+                                 digest.data())
+                         .is_ok());
+    TEST_ASSERT_EQUAL_MEMORY(SHA_DIGEST_TWO_BLOCK, digest.data(), digest.size());
+}
+
+static void test_esp32_crc32_check_value()
+{
+    platform::esp32::Esp32Crypto crypto;
+    auto result = crypto.crc32(as_bytes(CRC_MSG), std::strlen(CRC_MSG));
+    TEST_ASSERT_TRUE(result.is_ok());
+    TEST_ASSERT_EQUAL_UINT32(CRC_CHECK, result.value());
+}
+
+#endif
+
+// ============================================================================
+// TEST SUITE ENTRY POINT
+// ============================================================================
+
+extern "C" void test_native_crypto_suite(void)
+{
+#if GS_PLATFORM_NATIVE
+    RUN_TEST(test_nc_sha256_kat);
+    RUN_TEST(test_nc_sha256_streaming_matches_oneshot);
+    RUN_TEST(test_nc_crc32_check_value);
+    RUN_TEST(test_nc_random_bytes);
+    RUN_TEST(test_nc_hw_requires_init);
+    RUN_TEST(test_nc_hw_sha256_and_hmac_kat);
+    RUN_TEST(test_nc_gcm_kat_zero_key);
+    RUN_TEST(test_nc_gcm_kat_with_aad);
+    RUN_TEST(test_nc_gcm_rejects_bad_tag);
+    RUN_TEST(test_nc_gcm_paths_agree_on_max_payload);
+    RUN_TEST(test_nc_benchmark_throughput);
+#elif defined(GS_QEMU_BUILD)
+    RUN_TEST(test_esp32_sha256_kat);
+    RUN_TEST(test_esp32_crc32_check_value);
+#endif
+}
@@ -0,0 +1,498 @@
+/**
+ * @file test_net_emulator.cpp
+ * @brief Unit tests for the network emulator and PacketTransport under impairment
+ */
+
+#include "network/packet.hpp"
+#include "platform/mock_platform.hpp"
+#include "platform/net_emulator.hpp"
+#include "unity.h"
+
+#include <cstdio>
+#include <cstring>
+
+using namespace gridshield;
+using namespace gridshield::network;
+using namespace gridshield::platform::sim;
+
+// ============================================================================
+// Helpers
+// ============================================================================
+
+static platform::mock::MockCrypto net_platform_crypto;
+static security::CryptoEngine* net_crypto = nullptr;
+static security::ECCKeyPair net_keypair;
+
+static SimClock sim_clock;
+static NetEmulator net_instance(sim_clock, LinkProfile{}, 0);
+
+/// Shared emulator (too large for a task stack), re-seeded and clock rewound.
+static NetEmulator& fresh_net(const LinkProfile& profile, uint64_t seed)
+{
+    sim_clock = SimClock{};
+    net_instance.configure(profile, profile, seed);
+    return net_instance;
+}
+
+static LinkProfile clean_link() noexcept
+{
+    LinkProfile p;
+    p.latency_us = 10000;
+    return p;
+}
+
+/// Receive everything that arrives within @p timeout_ms into @p out.
+static size_t drain(NetEndpoint& ep, uint8_t* out, size_t capacity, uint32_t timeout_ms)
+{
+    size_t total = 0;
+    while (total < capacity) {
+        auto r = ep.receive(out + total, capacity - total, timeout_ms);
+        if (r.is_error()) {
+            break;
+        }
+        total += r.value();
+    }
+    return total;
+}
+
+static void net_setup(void)
+{
+    if (net_crypto == nullptr) {
+        net_crypto = new security::CryptoEngine(net_platform_crypto);
+        TEST_ASSERT_TRUE(net_crypto->generate_keypair(net_keypair).is_ok());
+    }
+}
+
+static core::Result<void> send_sequenced(PacketTransport& transport,
+                                         uint32_t seq,
+                                         uint64_t sent_us,
+                                         uint16_t payload_len)
+{
+    uint8_t payload[MAX_PAYLOAD_SIZE]{};
+    std::memcpy(payload, &seq, sizeof(seq));
+    std::memcpy(payload + sizeof(seq), &sent_us, sizeof(sent_us));
+    SecurePacket packet;
+    GS_TRY(packet.build(PacketType::MeterData,
+                        0x1122334455667788ULL,
+                        core::Priority::Normal,
+                        payload,
+                        payload_len,
+                        *net_crypto,
+                        net_keypair));
+    return transport.send_packet(packet, *net_crypto, net_keypair);
+}
+
+// ============================================================================
+// Link model
+// ============================================================================
+
+static void test_net_latency_and_bandwidth(void)
+{
+    LinkProfile p = clean_link();
+    p.bandwidth_bps = 80000; // 1000 bytes → 100 ms on the wire
+    NetEmulator& net = fresh_net(p, 1);
+    net.a().init();
+    net.b().init();
+
+    uint8_t data[1000];
+    std::memset(data, 0x5A, sizeof(data));
+    TEST_ASSERT_TRUE(net.a().send(data, sizeof(data)).is_ok());
+
+    uint8_t rx[1200];
+    auto early = net.b().receive(rx, sizeof(rx), 0);
+    TEST_ASSERT_TRUE(early.is_error());
+    TEST_ASSERT_EQUAL(core::ErrorCode::NetworkTimeout, early.error().code);
+
+    auto r = net.b().receive(rx, sizeof(rx), 500);
+    TEST_ASSERT_TRUE(r.is_ok());
+    TEST_ASSERT_EQUAL_UINT32(1000, r.value());
+    TEST_ASSERT_EQUAL_UINT32(110, sim_clock.get_timestamp_ms()); // serialisation + latency
+    TEST_ASSERT_EQUAL_MEMORY(data, rx, sizeof(data));
+}
+
+static void test_net_queue_tail_drop(void)
+{
+    LinkProfile p = clean_link();
+    p.bandwidth_bps = 8000; // 1 byte/ms
+    p.queue_bytes = 300;
+    NetEmulator& net = fresh_net(p, 2);
+    net.a().init();
+
+    uint8_t data[100]{};
+    for (int i = 0; i < 5; ++i) {
+        net.a().send(data, sizeof(data));
+    }
+    TEST_ASSERT_EQUAL_UINT32(5, net.a_to_b_stats().segments_offered);
+    TEST_ASSERT_EQUAL_UINT32(2, net.a_to_b_stats().dropped_queue);
+}
+
+struct RunDigest
+{
+    size_t bytes{0};
+    uint32_t end_ms{0};
+    uint32_t dropped{0};
+    uint32_t checksum{0};
+};
+
+static RunDigest run_cellular_burst(uint64_t seed)
+{
+    NetEmulator& net = fresh_net(presets::congested_cellular(), seed);
+    net.a().init();
+    net.b().init();
+
+    uint8_t data[300];
+    for (size_t i = 0; i < sizeof(data); ++i) {
+        data[i] = static_cast<uint8_t>(i * 7U);
+    }
+    for (int i = 0; i < 20; ++i) {
+        net.a().send(data, sizeof(data));
+    }
+
+    static uint8_t rx[8000];
+    RunDigest digest;
+    digest.bytes = drain(net.b(), rx, sizeof(rx), 5000);
+    for (size_t i = 0; i < digest.bytes; ++i) {
+        digest.checksum = digest.checksum * 31U + rx[i];
+    }
+    digest.end_ms = sim_clock.get_timestamp_ms();
+    digest.dropped = net.a_to_b_stats().dropped_loss + net.a_to_b_stats().dropped_queue;
+    return digest;
+}
+
+static void test_net_same_seed_same_run(void)
+{
+    const RunDigest first = run_cellular_burst(42);
+    const RunDigest again = run_cellular_burst(42);
+    const RunDigest other = run_cellular_burst(43);
+
+    TEST_ASSERT_EQUAL_UINT32(first.bytes, again.bytes);
+    TEST_ASSERT_EQUAL_UINT32(first.checksum, again.checksum);
+    TEST_ASSERT_EQUAL_UINT32(first.end_ms, again.end_ms);
+    TEST_ASSERT_EQUAL_UINT32(first.dropped, again.dropped);
+    TEST_ASSERT_TRUE(first.checksum != other.checksum || first.end_ms != other.end_ms);
+}
+
+static void test_net_gilbert_elliott_bursts(void)
+{
+    LinkProfile p = clean_link();
+    p.loss = {0.05F, 0.2F, 0.0F, 1.0F}; // bad state loses everything
+    NetEmulator& net = fresh_net(p, 7);
+    net.a().init();
+    net.b().init();
+
+    constexpr uint32_t COUNT = 4000;
+    uint32_t lost = 0;
+    uint32_t bursts = 0;
+    bool in_burst = false;
+    for (uint32_t i = 0; i < COUNT; ++i) {
+        const uint32_t before = net.a_to_b_stats().dropped_loss;
+        net.a().send(reinterpret_cast<const uint8_t*>(&i), sizeof(i));
+        const bool dropped = net.a_to_b_stats().dropped_loss != before;
+        lost += dropped ? 1U : 0U;
+        bursts += (dropped && !in_burst) ? 1U : 0U;
+        in_burst = dropped;
+        sim_clock.advance_us(20000); // deliver before the segment pool fills
+        uint8_t rx[8];
+        while (net.b().receive(rx, sizeof(rx), 0).is_ok()) {}
+    }
+
+    // Stationary bad fraction 0.05 / (0.05 + 0.2) = 20 %, mean burst 1 / 0.2 = 5
+    TEST_ASSERT_INT32_WITHIN(200, 800, static_cast<int32_t>(lost));
+    TEST_ASSERT_GREATER_THAN(3, lost / bursts);
+}
+
+static void test_net_reorder_duplicate_corrupt(void)
+{
+    LinkProfile p = clean_link();
+    p.reorder_prob = 0.3F;
+    p.reorder_delay_us = 5000;
+    p.duplicate_prob = 0.2F;
+    p.corrupt_prob = 0.2F;
+    NetEmulator& net = fresh_net(p, 11);
+    net.a().init();
+    net.b().init();
+
+    constexpr uint8_t COUNT = 40;
+    for (uint8_t i = 0; i < COUNT; ++i) {
+        uint8_t msg[4] = {i, i, i, i};
+        net.a().send(msg, sizeof(msg));
+        sim_clock.advance_us(1000);
+    }
+
+    uint32_t received = 0;
+    uint32_t out_of_order = 0;
+    uint32_t damaged = 0;
+    uint8_t last = 0;
+    uint8_t msg[4];
+    while (net.b().receive(msg, sizeof(msg), 100).is_ok()) {
+        const bool intact = msg[0] == msg[1] && msg[1] == msg[2] && msg[2] == msg[3];
+        damaged += intact ? 0U : 1U;
+        if (intact && received > 0 && msg[0] < last) {
+            ++out_of_order;
+        }
+        last = intact ? msg[0] : last;
+        ++received;
+    }
+
+    const auto& s = net.a_to_b_stats();
+    TEST_ASSERT_GREATER_THAN(0, s.reordered);
+    TEST_ASSERT_GREATER_THAN(0, s.duplicated);
+    TEST_ASSERT_GREATER_THAN(0, s.corrupted);
+    TEST_ASSERT_EQUAL_UINT32(COUNT + s.duplicated, received);
+    TEST_ASSERT_EQUAL_UINT32(s.corrupted, damaged);
+    TEST_ASSERT_GREATER_THAN(0, out_of_order);
+}
+
+static void test_net_stream_rechunks_in_order(void)
+{
+    LinkProfile p = clean_link();
+    p.mtu = 100;
+    p.stream = true;
+    NetEmulator& net = fresh_net(p, 3);
+    net.a().init();
+    net.b().init();
+
+    uint8_t data[700];
+    for (size_t i = 0; i < sizeof(data); ++i) {
+        data[i] = static_cast<uint8_t>(i);
+    }
+    net.a().send(data, 300);
+    net.a().send(data + 300, 400);
+    TEST_ASSERT_EQUAL_UINT32(7, net.a_to_b_stats().segments_offered);
+
+    uint8_t rx[700];
+    size_t total = 0;
+    uint32_t reads = 0;
+    bool unaligned = false;
+    while (total < sizeof(rx)) {
+        auto r = net.b().receive(rx + total, 256, 100);
+        TEST_ASSERT_TRUE(r.is_ok());
+        total += r.value();
+        unaligned = unaligned || (total % 100U) != 0;
+        ++reads;
+    }
+    TEST_ASSERT_EQUAL_MEMORY(data, rx, sizeof(data));
+    TEST_ASSERT_TRUE(unaligned);
+    TEST_ASSERT_NOT_EQUAL(7, reads);
+}
+
+static void test_net_disconnect(void)
+{
+    NetEmulator& net = fresh_net(clean_link(), 5);
+    net.a().init();
+    net.a().set_connected(false);
+    uint8_t byte = 1;
+    auto r = net.a().send(&byte, 1);
+    TEST_ASSERT_TRUE(r.is_error());
+    TEST_ASSERT_EQUAL(core::ErrorCode::NetworkDisconnected, r.error().code);
+}
+
+// ============================================================================
+// PacketTransport framing
+// ============================================================================
+
+static void test_transport_reassembles_fragmented_stream(void)
+{
+    net_setup();
+    LinkProfile p = clean_link();
+    p.mtu = 40;
+    p.stream = true;
+    NetEmulator& net = fresh_net(p, 9);
+    net.a().init();
+    net.b().init();
+    PacketTransport tx(net.a());
+    PacketTransport rx(net.b());
+
+    for (uint32_t seq = 0; seq < 3; ++seq) {
+        TEST_ASSERT_TRUE(send_sequenced(tx, seq, 0, 48).is_ok());
+    }
+    for (uint32_t seq = 0; seq < 3; ++seq) {
+        auto r = rx.receive_packet(*net_crypto, net_keypair, 100);
+        TEST_ASSERT_TRUE(r.is_ok());
+        uint32_t got = 0;
+        std::memcpy(&got, r.value().payload(), sizeof(got));
+        TEST_ASSERT_EQUAL_UINT32(seq, got);
+    }
+    TEST_ASSERT_EQUAL_UINT32(0, rx.buffered_bytes());
+}
+
+static void test_transport_resyncs_after_lost_fragment(void)
+{
+    net_setup();
+    NetEmulator& net = fresh_net(clean_link(), 13);
+    net.a().init();
+    net.b().init();
+    PacketTransport tx(net.a());
+    PacketTransport rx(net.b());
+
+    // Inject the head of a frame whose tail never arrives
+    uint8_t frame[PacketTransport::MAX_FRAME_SIZE];
+    {
+        uint8_t payload[16]{};
+        SecurePacket packet;
+        TEST_ASSERT_TRUE(packet
+                             .build(PacketType::Heartbeat,
+                                    1,
+                                    core::Priority::Low,
+                                    payload,
+                                    sizeof(payload),
+                                    *net_crypto,
+                                    net_keypair)
+                             .is_ok());
+        auto n = packet.serialize(frame, sizeof(frame));
+        TEST_ASSERT_TRUE(n.is_ok());
+        net.a().send(frame, n.value() / 2);
+    }
+    TEST_ASSERT_TRUE(send_sequenced(tx, 77, 0, 32).is_ok());
+
+    // The torn frame swallows the next one at first, fails, then resyncs
+    uint32_t got = 0;
+    for (int attempt = 0; attempt < 4 && got != 77; ++attempt) {
+        auto r = rx.receive_packet(*net_crypto, net_keypair, 100);
+        if (r.is_ok()) {
+            std::memcpy(&got, r.value().payload(), sizeof(got));
+        }
+    }
+    TEST_ASSERT_EQUAL_UINT32(77, got);
+}
+
+// ============================================================================
+// Scenario benchmark: goodput and end-to-end latency
+// ============================================================================
+
+struct ScenarioReport
+{
+    uint32_t sent{0};
+    uint32_t delivered{0};
+    uint32_t p50_ms{0};
+    uint32_t p95_ms{0};
+    uint32_t p99_ms{0};
+    double goodput_bps{0.0};
+};
+
+static uint32_t percentile(const uint32_t* sorted, uint32_t count, uint32_t pct)
+{
+    if (count == 0) {
+        return 0;
+    }
+    const uint32_t idx = (count * pct + 99U) / 100U;
+    return sorted[idx == 0 ? 0 : idx - 1];
+}
+
+static ScenarioReport
+run_scenario(const LinkProfile& profile, uint32_t packets, uint32_t interval_ms, uint64_t seed)
+{
+    static constexpr uint32_t MAX_PACKETS = 128;
+    static constexpr uint16_t PAYLOAD = 64;
+
+    NetEmulator& net = fresh_net(profile, seed);
+    net.a().init();
+    net.b().init();
+    PacketTransport tx(net.a());
+    PacketTransport rx(net.b());
+
+    ScenarioReport report;
+    static uint32_t latencies_ms[MAX_PACKETS];
+    bool seen[MAX_PACKETS]{};
+    packets = packets < MAX_PACKETS ? packets : MAX_PACKETS;
+
+    uint64_t last_delivery_us = 0;
+    auto collect = [&](uint64_t until_us) {
+        while (sim_clock.get_timestamp_us() < until_us) {
+            const uint64_t left_ms = (until_us - sim_clock.get_timestamp_us() + 999U) / 1000U;
+            auto r = rx.receive_packet(*net_crypto, net_keypair, static_cast<uint32_t>(left_ms));
+            if (r.is_error()) {
+                continue; // timeout, or a damaged frame the transport dropped
+            }
+            uint32_t seq = 0;
+            uint64_t sent_us = 0;
+            std::memcpy(&seq, r.value().payload(), sizeof(seq));
+            std::memcpy(&sent_us, r.value().payload() + sizeof(seq), sizeof(sent_us));
+            if (seq >= packets || seen[seq]) {
+                continue; // duplicate
+            }
+            seen[seq] = true;
+            last_delivery_us = sim_clock.get_timestamp_us();
+            latencies_ms[report.delivered++] =
+                static_cast<uint32_t>((last_delivery_us - sent_us) / 1000U);
+        }
+    };
+
+    for (uint32_t seq = 0; seq < packets; ++seq) {
+        const uint64_t now_us = sim_clock.get_timestamp_us();
+        if (send_sequenced(tx, seq, now_us, PAYLOAD).is_ok()) {
+            ++report.sent;
+        }
+        collect(now_us + static_cast<uint64_t>(interval_ms) * 1000U);
+    }
+    collect(sim_clock.get_timestamp_us() + 10000000ULL); // drain stragglers
+
+    // Insertion sort: at most MAX_PACKETS entries
+    for (uint32_t i = 1; i < report.delivered; ++i) {
+        const uint32_t v = latencies_ms[i];
+        uint32_t j = i;
+        while (j > 0 && latencies_ms[j - 1] > v) {
+            latencies_ms[j] = latencies_ms[j - 1];
+            --j;
+        }
+        latencies_ms[j] = v;
+    }
+    report.p50_ms = percentile(latencies_ms, report.delivered, 50);
+    report.p95_ms = percentile(latencies_ms, report.delivered, 95);
+    report.p99_ms = percentile(latencies_ms, report.delivered, 99);
+    if (last_delivery_us > 0) {
+        report.goodput_bps = static_cast<double>(report.delivered) * PAYLOAD * 8.0 * 1e6 /
+                             static_cast<double>(last_delivery_us);
+    }
+    return report;
+}
+
+static void print_report(const char* name, const ScenarioReport& r)
+{
+    printf("  [net] %-18s delivered=%3u/%-3u goodput=%9.1f bit/s "
+           "p50=%5u ms p95=%5u ms p99=%5u ms\n",
+           name,
+           static_cast<unsigned>(r.delivered),
+           static_cast<unsigned>(r.sent),
+           r.goodput_bps,
+           static_cast<unsigned>(r.p50_ms),
+           static_cast<unsigned>(r.p95_ms),
+           static_cast<unsigned>(r.p99_ms));
+}
+
+static void test_transport_scenario_presets(void)
+{
+    net_setup();
+
+    const ScenarioReport wifi = run_scenario(presets::good_wifi(), 100, 20, 1);
+    const ScenarioReport cell = run_scenario(presets::congested_cellular(), 100, 100, 1);
+    const ScenarioReport lora = run_scenario(presets::lora_like(), 40, 2000, 1);
+    print_report("good_wifi", wifi);
+    print_report("congested_cellular", cell);
+    print_report("lora_like", lora);
+
+    TEST_ASSERT_GREATER_OR_EQUAL(95, wifi.delivered);
+    TEST_ASSERT_LESS_THAN(10, wifi.p99_ms);
+    TEST_ASSERT_GREATER_THAN(cell.p50_ms, cell.p99_ms);
+    TEST_ASSERT_GREATER_THAN(wifi.p50_ms, cell.p50_ms);
+    TEST_ASSERT_GREATER_THAN(500, lora.p50_ms); // airtime of a ~150 B frame at 1.76 kbit/s
+    TEST_ASSERT_GREATER_THAN(0, lora.delivered);
+}
+
+// ============================================================================
+// Suite Registration
+// ============================================================================
+
+void test_net_emulator_suite(void)
+{
+    RUN_TEST(test_net_latency_and_bandwidth);
+    RUN_TEST(test_net_queue_tail_drop);
+    RUN_TEST(test_net_same_seed_same_run);
+    RUN_TEST(test_net_gilbert_elliott_bursts);
+    RUN_TEST(test_net_reorder_duplicate_corrupt);
+    RUN_TEST(test_net_stream_rechunks_in_order);
+    RUN_TEST(test_net_disconnect);
+    RUN_TEST(test_transport_reassembles_fragmented_stream);
+    RUN_TEST(test_transport_resyncs_after_lost_fragment);
+    RUN_TEST(test_transport_scenario_presets);
+}
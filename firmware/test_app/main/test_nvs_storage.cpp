@@ -0,0 +1,531 @@
+/**
+ * @file test_nvs_storage.cpp
+ * @brief Unit tests for BatchedNvsStorage (persistent handle, batches, commit deadline)
+ */
+
+#include "core/system.hpp"
+#include "platform/mock_platform.hpp"
+#include "platform/nvs_storage.hpp"
+#include "platform/sim_clock.hpp"
+#include "unity.h"
+
+#if defined(GS_QEMU_BUILD) && GS_PLATFORM_ESP32
+#include "platform/esp32_platform.hpp"
+#endif
+
+#include <cstdio>
+#include <cstring>
+#include <new>
+
+using namespace gridshield;
+using namespace gridshield::platform;
+
+// ============================================================================
+// Fake NVS backend
+// ============================================================================
+
+/// Latency model charged to the shared clock (ESP32 NVS on SPI NOR,
+/// order-of-magnitude): namespace open walks the page hash, each 32-byte
+/// entry is a flash program. nvs_commit is nearly free because
+/// nvs_set_blob already writes synchronously.
+static constexpr uint32_t NVS_OPEN_US = 60;
+static constexpr uint32_t NVS_CLOSE_US = 10;
+static constexpr uint32_t NVS_SET_BASE_US = 100;
+static constexpr uint32_t NVS_ENTRY_US = 45;
+static constexpr uint32_t NVS_COMMIT_US = 5;
+
+static sim::SimClock nvs_clock;
+
+class FakeNvsBackend
+{
+public:
+    static constexpr size_t MAX_KEYS = 48;
+    static constexpr size_t MAX_VALUE = 2048;
+    static constexpr size_t ORDER_LOG = 16;
+
+    core::Result<void> open() noexcept
+    {
+        ++opens;
+        nvs_clock.advance_us(NVS_OPEN_US);
+        return core::Result<void>{};
+    }
+
+    void close() noexcept
+    {
+        nvs_clock.advance_us(NVS_CLOSE_US);
+    }
+
+    core::Result<size_t> get_blob(const char* key, uint8_t* buffer, size_t length) noexcept
+    {
+        const Entry* entry = find(key);
+        if (entry == nullptr) {
+            return core::Result<size_t>(static_cast<size_t>(0));
+        }
+        if (entry->length > length) {
+            return core::Result<size_t>(GS_MAKE_ERROR(core::ErrorCode::HardwareFailure));
+        }
+        std::memcpy(buffer, entry->value, entry->length);
+        return core::Result<size_t>(entry->length);
+    }
+
+    core::Result<void> set_blob(const char* key, const uint8_t* data, size_t length) noexcept
+    {
+        Entry* entry = find(key);
+        if (entry == nullptr) {
+            if (count_ == MAX_KEYS || length > MAX_VALUE) {
+                return GS_MAKE_ERROR(core::ErrorCode::ResourceExhausted);
+            }
+            entry = &entries_[count_++];
+            std::strncpy(entry->key, key, sizeof(entry->key) - 1);
+        }
+        std::memcpy(entry->value, data, length);
+        entry->length = length;
+        if (sets < ORDER_LOG) {
+            std::strncpy(order[sets], key, sizeof(order[0]) - 1);
+        }
+        ++sets;
+        nvs_clock.advance_us(NVS_SET_BASE_US + NVS_ENTRY_US * nvs_blob_entries(length));
+        return core::Result<void>{};
+    }
+
+    core::Result<void> erase_key(const char* key) noexcept
+    {
+        Entry* entry = find(key);
+        if (entry != nullptr) {
+            *entry = entries_[--count_];
+        }
+        return core::Result<void>{};
+    }
+
+    core::Result<void> commit() noexcept
+    {
+        ++commits;
+        nvs_clock.advance_us(NVS_COMMIT_US);
+        return core::Result<void>{};
+    }
+
+    uint64_t now_ms() noexcept
+    {
+        return nvs_clock.get_timestamp_ms();
+    }
+
+    GS_NODISCARD bool contains(const char* key) const noexcept
+    {
+        for (size_t i = 0; i < count_; ++i) {
+            if (std::strcmp(entries_[i].key, key) == 0) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    uint32_t opens{0};
+    uint32_t sets{0};
+    uint32_t commits{0};
+    char order[ORDER_LOG][16]{};
+
+private:
+    struct Entry
+    {
+        char key[16]{};
+        size_t length{0};
+        uint8_t value[MAX_VALUE]{};
+    };
+
+    Entry* find(const char* key) noexcept
+    {
+        for (size_t i = 0; i < count_; ++i) {
+            if (std::strcmp(entries_[i].key, key) == 0) {
+                return &entries_[i];
+            }
+        }
+        return nullptr;
+    }
+
+    Entry entries_[MAX_KEYS]{};
+    size_t count_{0};
+};
+
+using FakeNvsStorage = BatchedNvsStorage<FakeNvsBackend>;
+
+// Large (~25 KB): keep off the test task stack
+static FakeNvsStorage nvs_instance;
+
+/// Re-create the shared instance in place (fresh backend, stats, stage).
+static FakeNvsStorage& fresh_nvs()
+{
+    nvs_instance.~FakeNvsStorage();
+    new (&nvs_instance) FakeNvsStorage();
+    TEST_ASSERT_TRUE(nvs_instance.init().is_ok());
+    return nvs_instance;
+}
+
+static constexpr uint8_t REC_A[4] = {1, 2, 3, 4};
+static constexpr uint8_t REC_B[4] = {5, 6, 7, 8};
+static constexpr uint8_t REC_C[4] = {9, 10, 11, 12};
+
+// ============================================================================
+// Write-through and read-back
+// ============================================================================
+
+static void test_nvs_unbatched_write_commits_each(void)
+{
+    auto& nvs = fresh_nvs();
+    for (uint32_t i = 0; i < 10; ++i) {
+        TEST_ASSERT_TRUE(nvs.write(i * 16, REC_A, sizeof(REC_A)).is_ok());
+    }
+    TEST_ASSERT_EQUAL(1, nvs.backend().opens); // handle kept open
+    TEST_ASSERT_EQUAL(10, nvs.backend().sets);
+    TEST_ASSERT_EQUAL(10, nvs.backend().commits);
+
+    uint8_t out[4]{};
+    auto got = nvs.read(16, out, sizeof(out));
+    TEST_ASSERT_TRUE(got.is_ok());
+    TEST_ASSERT_EQUAL(4, got.value());
+    TEST_ASSERT_EQUAL_MEMORY(REC_A, out, sizeof(out));
+
+    // Never-written key reads as erased flash
+    uint8_t blank[3]{};
+    TEST_ASSERT_TRUE(nvs.read(999, blank, sizeof(blank)).is_ok());
+    TEST_ASSERT_EQUAL_UINT8(0xFF, blank[0]);
+    TEST_ASSERT_EQUAL_UINT8(0xFF, blank[2]);
+}
+
+static void test_nvs_requires_init(void)
+{
+    FakeNvsStorage& nvs = nvs_instance;
+    nvs.~FakeNvsStorage();
+    new (&nvs) FakeNvsStorage();
+    TEST_ASSERT_TRUE(nvs.write(0, REC_A, sizeof(REC_A)).is_error());
+    TEST_ASSERT_TRUE(nvs.begin_batch().is_error());
+    TEST_ASSERT_TRUE(nvs.commit().is_error());
+}
+
+// ============================================================================
+// Batches
+// ============================================================================
+
+static void test_nvs_batch_coalesces_rewrites(void)
+{
+    auto& nvs = fresh_nvs();
+    TEST_ASSERT_TRUE(nvs.begin_batch().is_ok());
+    TEST_ASSERT_TRUE(nvs.write(0, REC_A, sizeof(REC_A)).is_ok());
+    TEST_ASSERT_TRUE(nvs.write(0, REC_B, sizeof(REC_B)).is_ok());
+    TEST_ASSERT_TRUE(nvs.write(32, REC_A, sizeof(REC_A)).is_ok());
+    TEST_ASSERT_TRUE(nvs.write(0, REC_C, sizeof(REC_C)).is_ok());
+    TEST_ASSERT_EQUAL(0, nvs.backend().sets);
+
+    // Read-your-writes before the commit
+    uint8_t out[4]{};
+    TEST_ASSERT_TRUE(nvs.read(0, out, sizeof(out)).is_ok());
+    TEST_ASSERT_EQUAL_MEMORY(REC_C, out, sizeof(out));
+
+    TEST_ASSERT_TRUE(nvs.commit().is_ok());
+    TEST_ASSERT_FALSE(nvs.in_batch());
+    TEST_ASSERT_EQUAL(2, nvs.backend().sets);
+    TEST_ASSERT_EQUAL(1, nvs.backend().commits);
+    TEST_ASSERT_EQUAL(2, nvs.stats().coalesced);
+    TEST_ASSERT_TRUE(nvs.read(0, out, sizeof(out)).is_ok());
+    TEST_ASSERT_EQUAL_MEMORY(REC_C, out, sizeof(out));
+}
+
+static void test_nvs_batch_keeps_last_write_order(void)
+{
+    auto& nvs = fresh_nvs();
+    // header, payload, header again: the header must still land last
+    TEST_ASSERT_TRUE(nvs.begin_batch().is_ok());
+    TEST_ASSERT_TRUE(nvs.write(0x100, REC_A, sizeof(REC_A)).is_ok());
+    TEST_ASSERT_TRUE(nvs.write(0x110, REC_B, sizeof(REC_B)).is_ok());
+    TEST_ASSERT_TRUE(nvs.write(0x100, REC_C, sizeof(REC_C)).is_ok());
+    TEST_ASSERT_TRUE(nvs.commit().is_ok());
+
+    TEST_ASSERT_EQUAL(2, nvs.backend().sets);
+    TEST_ASSERT_EQUAL_STRING("blk_0110", nvs.backend().order[0]);
+    TEST_ASSERT_EQUAL_STRING("blk_0100", nvs.backend().order[1]);
+
+    uint8_t out[4]{};
+    TEST_ASSERT_TRUE(nvs.read(0x110, out, sizeof(out)).is_ok());
+    TEST_ASSERT_EQUAL_MEMORY(REC_B, out, sizeof(out)); // compaction kept neighbours intact
+}
+
+static void test_nvs_nested_batches(void)
+{
+    auto& nvs = fresh_nvs();
+    TEST_ASSERT_TRUE(nvs.begin_batch().is_ok());
+    TEST_ASSERT_TRUE(nvs.begin_batch().is_ok());
+    TEST_ASSERT_TRUE(nvs.write(0, REC_A, sizeof(REC_A)).is_ok());
+    TEST_ASSERT_TRUE(nvs.commit().is_ok());
+    TEST_ASSERT_EQUAL(0, nvs.backend().sets); // inner commit persists nothing
+    TEST_ASSERT_TRUE(nvs.commit().is_ok());
+    TEST_ASSERT_EQUAL(1, nvs.backend().sets);
+    TEST_ASSERT_EQUAL(1, nvs.backend().commits);
+    TEST_ASSERT_TRUE(nvs.commit().is_error()); // unbalanced
+}
+
+static void test_nvs_flush_inside_batch(void)
+{
+    auto& nvs = fresh_nvs();
+    TEST_ASSERT_TRUE(nvs.begin_batch().is_ok());
+    TEST_ASSERT_TRUE(nvs.write(0, REC_A, sizeof(REC_A)).is_ok());
+    TEST_ASSERT_TRUE(nvs.flush().is_ok());
+    TEST_ASSERT_EQUAL(1, nvs.backend().sets);
+    TEST_ASSERT_EQUAL(1, nvs.backend().commits);
+    TEST_ASSERT_TRUE(nvs.in_batch()); // flush is a durability point, not an end
+
+    TEST_ASSERT_TRUE(nvs.commit().is_ok());
+    TEST_ASSERT_EQUAL(1, nvs.backend().commits); // nothing left to commit
+}
+
+static void test_nvs_commit_deadline(void)
+{
+    auto& nvs = fresh_nvs();
+    nvs.set_commit_deadline_ms(100);
+    TEST_ASSERT_TRUE(nvs.begin_batch().is_ok());
+    TEST_ASSERT_TRUE(nvs.write(0, REC_A, sizeof(REC_A)).is_ok());
+    nvs_clock.delay_ms(50);
+    TEST_ASSERT_TRUE(nvs.write(16, REC_B, sizeof(REC_B)).is_ok());
+    TEST_ASSERT_EQUAL(0, nvs.backend().sets);
+
+    // Oldest staged write is now 110 ms old: the next write drains
+    nvs_clock.delay_ms(60);
+    TEST_ASSERT_TRUE(nvs.write(32, REC_C, sizeof(REC_C)).is_ok());
+    TEST_ASSERT_EQUAL(3, nvs.backend().sets);
+    TEST_ASSERT_EQUAL(1, nvs.stats().deadline_drains);
+    TEST_ASSERT_TRUE(nvs.in_batch());
+
+    // Idle batch: poll() from the main loop enforces the same bound
+    TEST_ASSERT_TRUE(nvs.write(48, REC_A, sizeof(REC_A)).is_ok());
+    TEST_ASSERT_TRUE(nvs.poll().is_ok());
+    TEST_ASSERT_EQUAL(1, nvs.stats().deadline_drains);
+    nvs_clock.delay_ms(100);
+    TEST_ASSERT_TRUE(nvs.poll().is_ok());
+    TEST_ASSERT_EQUAL(4, nvs.backend().sets);
+    TEST_ASSERT_EQUAL(2, nvs.stats().deadline_drains);
+    TEST_ASSERT_TRUE(nvs.commit().is_ok());
+}
+
+static void test_nvs_stage_capacity_drains(void)
+{
+    auto& nvs = fresh_nvs();
+    TEST_ASSERT_TRUE(nvs.begin_batch().is_ok());
+    for (uint32_t i = 0; i < 9; ++i) { // one more than the 8 stage slots
+        TEST_ASSERT_TRUE(nvs.write(i * 16, REC_A, sizeof(REC_A)).is_ok());
+    }
+    TEST_ASSERT_EQUAL(1, nvs.stats().capacity_drains);
+    TEST_ASSERT_EQUAL(8, nvs.backend().sets);
+    TEST_ASSERT_EQUAL(1, nvs.staged_writes());
+    TEST_ASSERT_TRUE(nvs.commit().is_ok());
+    TEST_ASSERT_EQUAL(9, nvs.backend().sets);
+    TEST_ASSERT_EQUAL(1, nvs.backend().commits);
+
+    // Larger than the whole stage: written through, ordered after staged data
+    static uint8_t big[3000];
+    std::memset(big, 0x5A, sizeof(big));
+    TEST_ASSERT_TRUE(nvs.begin_batch().is_ok());
+    TEST_ASSERT_TRUE(nvs.write(0x400, REC_B, sizeof(REC_B)).is_ok());
+    TEST_ASSERT_TRUE(nvs.write(0x800, big, 400).is_ok());
+    TEST_ASSERT_TRUE(nvs.write(0x900, big, sizeof(big)).is_error()); // fake backend limit
+    TEST_ASSERT_TRUE(nvs.commit().is_ok());
+}
+
+static void test_nvs_erase_in_batch(void)
+{
+    auto& nvs = fresh_nvs();
+    TEST_ASSERT_TRUE(nvs.write(0, REC_A, sizeof(REC_A)).is_ok());
+    TEST_ASSERT_TRUE(nvs.begin_batch().is_ok());
+    TEST_ASSERT_TRUE(nvs.write(16, REC_B, sizeof(REC_B)).is_ok());
+    TEST_ASSERT_TRUE(nvs.erase(0, sizeof(REC_A)).is_ok());
+    TEST_ASSERT_TRUE(nvs.backend().contains("blk_0010")); // drained before the erase
+    TEST_ASSERT_FALSE(nvs.backend().contains("blk_0000"));
+    TEST_ASSERT_TRUE(nvs.commit().is_ok());
+
+    uint8_t out[4]{};
+    TEST_ASSERT_TRUE(nvs.read(0, out, sizeof(out)).is_ok());
+    TEST_ASSERT_EQUAL_UINT8(0xFF, out[0]);
+}
+
+// ============================================================================
+// System integration: warm-boot checkpoint is one commit
+// ============================================================================
+
+static void test_nvs_checkpoint_is_one_commit(void)
+{
+    auto& nvs = fresh_nvs();
+    mock::MockTime time;
+    mock::MockGPIO gpio;
+    mock::MockInterrupt interrupt;
+    mock::MockCrypto crypto;
+    mock::MockComm comm;
+    PlatformServices services;
+    services.time = &time;
+    services.gpio = &gpio;
+    services.interrupt = &interrupt;
+    services.crypto = &crypto;
+    services.storage = &nvs;
+    services.comm = &comm;
+
+    SystemConfig config;
+    config.meter_id = 0xBEEF;
+    config.tamper_config.sensor_pin = 4;
+    for (size_t i = 0; i < analytics::PROFILE_HISTORY_SIZE; ++i) {
+        config.baseline_profile.hourly_avg_wh[i] = 1200;
+    }
+    config.baseline_profile.daily_avg_wh = 1200;
+    config.baseline_profile.variance_threshold = 30;
+    comm.set_connected(true);
+    GridShieldSystem system;
+    TEST_ASSERT_TRUE(system.initialize(config, services).is_ok());
+
+    const uint32_t sets_before = nvs.backend().sets;
+    const uint32_t commits_before = nvs.backend().commits;
+    TEST_ASSERT_TRUE(system.checkpoint_state().is_ok());
+    TEST_ASSERT_EQUAL(2, nvs.backend().sets - sets_before); // payload + header
+    TEST_ASSERT_EQUAL(1, nvs.backend().commits - commits_before);
+    TEST_ASSERT_FALSE(nvs.in_batch());
+    (void)system.shutdown();
+}
+
+// ============================================================================
+// Benchmark: 1000 small writes (event-slot ring + head pointer)
+// ============================================================================
+
+static constexpr uint32_t BENCH_WRITES = 1000;
+static constexpr uint32_t BENCH_SLOTS = 8;
+static constexpr size_t BENCH_RECORD = 16;
+static constexpr uint32_t BENCH_APPENDS_PER_BATCH = 10;
+
+struct NvsBenchResult
+{
+    uint64_t total_us{0};
+    uint32_t sets{0};
+    uint32_t commits{0};
+    uint32_t entries{0};
+};
+
+/// Previous Esp32Storage::write: open, set, commit, close on every call.
+static void legacy_write(FakeNvsBackend& backend, uint32_t address, const uint8_t* data,
+                         size_t length, NvsBenchResult& r)
+{
+    char key[16];
+    std::snprintf(key, sizeof(key), "blk_%04X", static_cast<unsigned>(address));
+    (void)backend.open();
+    (void)backend.set_blob(key, data, length);
+    (void)backend.commit();
+    backend.close();
+    r.entries += nvs_blob_entries(length);
+}
+
+/// One append = record into the next slot + head index update (2 writes).
+static NvsBenchResult bench_nvs(bool legacy, bool batched)
+{
+    auto& nvs = fresh_nvs();
+    FakeNvsBackend& backend = nvs.backend();
+    const uint32_t sets0 = backend.sets;
+    const uint32_t commits0 = backend.commits;
+    NvsBenchResult r;
+
+    uint8_t record[BENCH_RECORD];
+    const uint64_t start = nvs_clock.get_timestamp_us();
+    for (uint32_t i = 0; i < BENCH_WRITES / 2; ++i) {
+        std::memset(record, static_cast<int>(i & 0xFF), sizeof(record));
+        const uint32_t slot_addr = 0x1000 + (i % BENCH_SLOTS) * 0x20;
+        const uint32_t head = i + 1;
+        if (legacy) {
+            legacy_write(backend, slot_addr, record, sizeof(record), r);
+            legacy_write(backend, 0x0FF0, reinterpret_cast<const uint8_t*>(&head), 4, r);
+            continue;
+        }
+        if (batched && i % BENCH_APPENDS_PER_BATCH == 0) {
+            (void)nvs.begin_batch();
+        }
+        (void)nvs.write(slot_addr, record, sizeof(record));
+        (void)nvs.write(0x0FF0, reinterpret_cast<const uint8_t*>(&head), 4);
+        if (batched && (i + 1) % BENCH_APPENDS_PER_BATCH == 0) {
+            (void)nvs.commit();
+        }
+    }
+    r.total_us = nvs_clock.get_timestamp_us() - start;
+    r.sets = backend.sets - sets0;
+    r.commits = backend.commits - commits0;
+    if (!legacy) {
+        r.entries = nvs.stats().entries_written;
+    }
+    return r;
+}
+
+static void report_nvs(const char* label, const NvsBenchResult& r)
+{
+    printf("  [nvs] %-26s %6.1f us/write  sets=%4u commits=%4u entries=%5u (~%u page erases)\n",
+           label,
+           static_cast<double>(r.total_us) / BENCH_WRITES,
+           static_cast<unsigned>(r.sets),
+           static_cast<unsigned>(r.commits),
+           static_cast<unsigned>(r.entries),
+           static_cast<unsigned>(r.entries / NVS_ENTRIES_PER_PAGE));
+}
+
+static void test_nvs_write_benchmark(void)
+{
+    const NvsBenchResult legacy = bench_nvs(true, false);
+    const NvsBenchResult handle = bench_nvs(false, false);
+    const NvsBenchResult batched = bench_nvs(false, true);
+    report_nvs("open/set/commit per write", legacy);
+    report_nvs("persistent handle", handle);
+    report_nvs("batched (10 appends)", batched);
+
+    // Handle reuse removes the open/close cost but not the flash traffic
+    TEST_ASSERT_LESS_THAN(legacy.total_us, handle.total_us);
+    TEST_ASSERT_EQUAL(legacy.entries, handle.entries);
+    // Batching: head pointer rewrites coalesce (one per batch instead of ten)
+    TEST_ASSERT_LESS_THAN(legacy.entries * 2 / 3, batched.entries);
+    TEST_ASSERT_LESS_THAN(legacy.commits / 10 + 1, batched.commits);
+
+#if defined(GS_QEMU_BUILD) && GS_PLATFORM_ESP32
+    // Same workload on the real NVS partition (time only; wear is estimated)
+    esp32::Esp32Storage real;
+    if (real.init().is_ok()) {
+        uint8_t record[BENCH_RECORD]{};
+        for (int pass = 0; pass < 2; ++pass) {
+            const bool batched_pass = pass == 1;
+            real.reset_stats();
+            const int64_t t0 = esp_timer_get_time();
+            for (uint32_t i = 0; i < BENCH_WRITES / 2; ++i) {
+                const uint32_t head = i + 1;
+                if (batched_pass && i % BENCH_APPENDS_PER_BATCH == 0) {
+                    (void)real.begin_batch();
+                }
+                (void)real.write(0x1000 + (i % BENCH_SLOTS) * 0x20, record, sizeof(record));
+                (void)real.write(0x0FF0, reinterpret_cast<const uint8_t*>(&head), 4);
+                if (batched_pass && (i + 1) % BENCH_APPENDS_PER_BATCH == 0) {
+                    (void)real.commit();
+                }
+            }
+            NvsBenchResult r;
+            r.total_us = static_cast<uint64_t>(esp_timer_get_time() - t0);
+            r.sets = real.stats().blob_sets;
+            r.commits = real.stats().commits;
+            r.entries = real.stats().entries_written;
+            report_nvs(batched_pass ? "esp32 batched" : "esp32 persistent handle", r);
+        }
+    }
+#endif
+}
+
+// ============================================================================
+// Suite Registration
+// ============================================================================
+
+void test_nvs_storage_suite(void)
+{
+    RUN_TEST(test_nvs_unbatched_write_commits_each);
+    RUN_TEST(test_nvs_requires_init);
+    RUN_TEST(test_nvs_batch_coalesces_rewrites);
+    RUN_TEST(test_nvs_batch_keeps_last_write_order);
+    RUN_TEST(test_nvs_nested_batches);
+    RUN_TEST(test_nvs_flush_inside_batch);
+    RUN_TEST(test_nvs_commit_deadline);
+    RUN_TEST(test_nvs_stage_capacity_drains);
+    RUN_TEST(test_nvs_erase_in_batch);
+    RUN_TEST(test_nvs_checkpoint_is_one_commit);
+    RUN_TEST(test_nvs_write_benchmark);
+}
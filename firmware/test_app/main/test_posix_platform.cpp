@@ -0,0 +1,405 @@
+/**
+ * @file test_posix_platform.cpp
+ * @brief Unit tests for the native POSIX backend (clock, sockets, replay HALs, full stack)
+ */
+
+#include "unity.h"
+#include "utils/gs_macros.hpp"
+
+#if GS_PLATFORM_NATIVE
+
+#include "core/system.hpp"
+#include "platform/posix_platform.hpp"
+#include "platform/sim_clock.hpp"
+
+#include <cstdio>
+#include <cstring>
+#include <unistd.h>
+
+using namespace gridshield;
+using namespace gridshield::platform;
+using namespace gridshield::platform::posix;
+
+// ============================================================================
+// Helpers
+// ============================================================================
+
+/// Write @p text to a fresh temp file; @p path receives its name.
+static bool write_temp(char (&path)[32], const char* text)
+{
+    std::strcpy(path, "/tmp/gs_posix_XXXXXX");
+    const int fd = mkstemp(path);
+    if (fd < 0) {
+        return false;
+    }
+    const size_t len = std::strlen(text);
+    const bool ok = ::write(fd, text, len) == static_cast<ssize_t>(len);
+    ::close(fd);
+    return ok;
+}
+
+// ============================================================================
+// Clock
+// ============================================================================
+
+static void test_posix_time_monotonic_and_sleeps(void)
+{
+    PosixTime time;
+    const uint64_t t0 = time.get_timestamp_us();
+    time.delay_ms(20);
+    const uint64_t t1 = time.get_timestamp_us();
+    TEST_ASSERT_GREATER_OR_EQUAL(20000, static_cast<uint32_t>(t1 - t0));
+    TEST_ASSERT_LESS_THAN(500000, static_cast<uint32_t>(t1 - t0));
+
+    // Absolute deadline: wake at (not before) the target
+    const uint64_t deadline = t1 + 15000;
+    time.sleep_until_us(deadline);
+    TEST_ASSERT_TRUE(time.get_timestamp_us() >= deadline);
+    TEST_ASSERT_TRUE(PosixTime::unix_time_ms() > 1700000000000ULL);
+}
+
+// ============================================================================
+// UDP
+// ============================================================================
+
+static void test_posix_udp_loopback_and_reply(void)
+{
+    UdpConfig server_cfg;
+    server_cfg.bind_host = "127.0.0.1";
+    PosixUdpComm server(server_cfg);
+    TEST_ASSERT_TRUE(server.init().is_ok());
+    TEST_ASSERT_NOT_EQUAL(0, server.local_port());
+
+    // No peer yet: a server cannot send until someone talks to it
+    static constexpr uint8_t PING[4] = {'p', 'i', 'n', 'g'};
+    TEST_ASSERT_TRUE(server.send(PING, sizeof(PING)).is_error());
+
+    UdpConfig client_cfg;
+    client_cfg.bind_host = "127.0.0.1";
+    client_cfg.peer_port = server.local_port();
+    PosixUdpComm client(client_cfg);
+    TEST_ASSERT_TRUE(client.init().is_ok());
+
+    auto sent = client.send(PING, sizeof(PING));
+    TEST_ASSERT_TRUE(sent.is_ok());
+    TEST_ASSERT_EQUAL(sizeof(PING), sent.value());
+
+    uint8_t buf[16]{};
+    auto got = server.receive(buf, sizeof(buf), 500);
+    TEST_ASSERT_TRUE(got.is_ok());
+    TEST_ASSERT_EQUAL(sizeof(PING), got.value());
+    TEST_ASSERT_EQUAL_MEMORY(PING, buf, sizeof(PING));
+
+    // Reply goes to the learned sender
+    static constexpr uint8_t PONG[4] = {'p', 'o', 'n', 'g'};
+    TEST_ASSERT_TRUE(server.send(PONG, sizeof(PONG)).is_ok());
+    got = client.receive(buf, sizeof(buf), 500);
+    TEST_ASSERT_TRUE(got.is_ok());
+    TEST_ASSERT_EQUAL_MEMORY(PONG, buf, sizeof(PONG));
+}
+
+static void test_posix_udp_receive_times_out(void)
+{
+    UdpConfig cfg;
+    cfg.bind_host = "127.0.0.1";
+    PosixUdpComm comm(cfg);
+    TEST_ASSERT_TRUE(comm.init().is_ok());
+
+    PosixTime time;
+    uint8_t buf[8];
+    const uint64_t t0 = time.get_timestamp_us();
+    auto got = comm.receive(buf, sizeof(buf), 30);
+    const uint64_t waited = time.get_timestamp_us() - t0;
+    TEST_ASSERT_TRUE(got.is_error());
+    TEST_ASSERT_EQUAL(static_cast<int>(core::ErrorCode::NetworkTimeout),
+                      static_cast<int>(got.error().code));
+    TEST_ASSERT_GREATER_OR_EQUAL(25000, static_cast<uint32_t>(waited));
+
+    comm.shutdown();
+    TEST_ASSERT_FALSE(comm.is_connected());
+    TEST_ASSERT_TRUE(comm.send(buf, sizeof(buf)).is_error());
+}
+
+// ============================================================================
+// TCP
+// ============================================================================
+
+static void test_posix_tcp_stream_and_hangup(void)
+{
+    TcpConfig server_cfg;
+    server_cfg.role = TcpConfig::Role::Server;
+    PosixTcpComm server(server_cfg);
+    TEST_ASSERT_TRUE(server.init().is_ok());
+    TEST_ASSERT_FALSE(server.is_connected());
+
+    TcpConfig client_cfg;
+    client_cfg.port = server.local_port();
+    PosixTcpComm client(client_cfg);
+    TEST_ASSERT_TRUE(client.init().is_ok());
+    TEST_ASSERT_TRUE(client.is_connected());
+
+    // Larger than one segment on loopback is still delivered in order
+    static uint8_t payload[8192];
+    for (size_t i = 0; i < sizeof(payload); ++i) {
+        payload[i] = static_cast<uint8_t>(i * 7U);
+    }
+    auto sent = client.send(payload, sizeof(payload));
+    TEST_ASSERT_TRUE(sent.is_ok());
+    TEST_ASSERT_EQUAL(sizeof(payload), sent.value());
+
+    static uint8_t received[sizeof(payload)];
+    size_t filled = 0;
+    while (filled < sizeof(received)) {
+        auto got = server.receive(received + filled, sizeof(received) - filled, 500);
+        TEST_ASSERT_TRUE(got.is_ok());
+        filled += got.value();
+    }
+    TEST_ASSERT_TRUE(server.is_connected());
+    TEST_ASSERT_EQUAL_MEMORY(payload, received, sizeof(payload));
+
+    // Peer hang-up: server drops the peer and goes back to accepting
+    client.shutdown();
+    uint8_t byte = 0;
+    auto got = server.receive(&byte, 1, 500);
+    TEST_ASSERT_TRUE(got.is_error());
+    TEST_ASSERT_EQUAL(static_cast<int>(core::ErrorCode::NetworkDisconnected),
+                      static_cast<int>(got.error().code));
+    TEST_ASSERT_FALSE(server.is_connected());
+
+    TEST_ASSERT_TRUE(client.init().is_ok());
+    TEST_ASSERT_TRUE(client.send(payload, 4).is_ok());
+    got = server.receive(received, 4, 500);
+    TEST_ASSERT_TRUE(got.is_ok());
+}
+
+static void test_posix_tcp_connect_refused(void)
+{
+    // Grab an ephemeral port, then close it so nothing listens there
+    TcpConfig probe_cfg;
+    probe_cfg.role = TcpConfig::Role::Server;
+    PosixTcpComm probe(probe_cfg);
+    TEST_ASSERT_TRUE(probe.init().is_ok());
+    const uint16_t port = probe.local_port();
+    probe.shutdown();
+
+    TcpConfig cfg;
+    cfg.port = port;
+    cfg.connect_timeout_ms = 200;
+    PosixTcpComm client(cfg);
+    TEST_ASSERT_TRUE(client.init().is_error());
+    TEST_ASSERT_FALSE(client.is_connected());
+}
+
+// ============================================================================
+// Replay HALs (virtual clock, so timing is exact)
+// ============================================================================
+
+static void test_replay_adc_sample_and_hold(void)
+{
+    char path[32];
+    TEST_ASSERT_TRUE(write_temp(path,
+                                "# t_ms ch0 ch1\n"
+                                "0    100, 2000\n"
+                                "50   0x200 9999   # clamps to 12 bits\n"
+                                "bogus line\n"
+                                "120  7\n"));
+
+    sim::SimClock clock;
+    ReplayADC adc(clock);
+    TEST_ASSERT_TRUE(adc.open(path).is_ok());
+    TEST_ASSERT_TRUE(adc.read_raw(0).is_error()); // channel not initialised
+    TEST_ASSERT_TRUE(adc.init(0, ADCAttenuation::Db12).is_ok());
+    TEST_ASSERT_TRUE(adc.init(1, ADCAttenuation::Db12).is_ok());
+
+    TEST_ASSERT_EQUAL(100, adc.read_raw(0).value());
+    TEST_ASSERT_EQUAL(2000, adc.read_raw(1).value());
+
+    clock.delay_ms(49);
+    TEST_ASSERT_EQUAL(100, adc.read_raw(0).value()); // held until t=50
+    clock.delay_ms(1);
+    TEST_ASSERT_EQUAL(0x200, adc.read_raw(0).value());
+    TEST_ASSERT_EQUAL(4095, adc.read_raw(1).value());
+    TEST_ASSERT_EQUAL(3300, adc.read_mv(1).value());
+
+    clock.delay_ms(100);
+    TEST_ASSERT_EQUAL(7, adc.read_raw(0).value());
+    TEST_ASSERT_EQUAL(4095, adc.read_raw(1).value()); // ch1 absent: held
+    TEST_ASSERT_EQUAL(3, adc.frames());
+    unlink(path);
+}
+
+static void test_replay_adc_loops(void)
+{
+    char path[32];
+    TEST_ASSERT_TRUE(write_temp(path, "0 10\n10 20\n"));
+
+    sim::SimClock clock;
+    ReplayADC adc(clock);
+    TEST_ASSERT_TRUE(adc.open(path, true).is_ok());
+    TEST_ASSERT_TRUE(adc.init(0, ADCAttenuation::Db0).is_ok());
+
+    TEST_ASSERT_EQUAL(10, adc.read_raw(0).value());
+    clock.delay_ms(10);
+    TEST_ASSERT_EQUAL(20, adc.read_raw(0).value());
+    clock.delay_ms(1); // second pass starts at t=11
+    TEST_ASSERT_EQUAL(10, adc.read_raw(0).value());
+    clock.delay_ms(10);
+    TEST_ASSERT_EQUAL(20, adc.read_raw(0).value());
+    unlink(path);
+}
+
+static void test_replay_i2c_register_banks(void)
+{
+    char path[32];
+    TEST_ASSERT_TRUE(write_temp(path,
+                                "0   0x40 0x00 0x12 0x34\n"
+                                "100 0x40 0x01 0x56\n"));
+
+    sim::SimClock clock;
+    ReplayI2C i2c(clock);
+    TEST_ASSERT_TRUE(i2c.open(path).is_ok());
+    TEST_ASSERT_TRUE(i2c.init(21, 22, IPlatformI2C::DEFAULT_FREQ_HZ).is_ok());
+
+    uint8_t regs[2]{};
+    TEST_ASSERT_TRUE(i2c.read_reg(0x40, 0x00, regs, 2).is_ok());
+    TEST_ASSERT_EQUAL_UINT8(0x12, regs[0]);
+    TEST_ASSERT_EQUAL_UINT8(0x34, regs[1]);
+
+    // Unknown address NACKs for reads and writes
+    TEST_ASSERT_TRUE(i2c.read_reg(0x41, 0x00, regs, 1).is_error());
+    TEST_ASSERT_TRUE(i2c.write_reg(0x41, 0x00, regs, 1).is_error());
+
+    // Driver configuration writes read back
+    const uint8_t config = 0x9C;
+    TEST_ASSERT_TRUE(i2c.write_reg(0x40, 0x05, &config, 1).is_ok());
+    TEST_ASSERT_TRUE(i2c.read_reg(0x40, 0x05, regs, 1).is_ok());
+    TEST_ASSERT_EQUAL_UINT8(0x9C, regs[0]);
+
+    clock.delay_ms(100);
+    TEST_ASSERT_TRUE(i2c.read_reg(0x40, 0x00, regs, 2).is_ok());
+    TEST_ASSERT_EQUAL_UINT8(0x12, regs[0]);
+    TEST_ASSERT_EQUAL_UINT8(0x56, regs[1]);
+    unlink(path);
+}
+
+static void test_replay_uart_timed_rx_and_tx_capture(void)
+{
+    char rx_path[32];
+    TEST_ASSERT_TRUE(write_temp(rx_path,
+                                "10 1 0x01 0x03 0x00\n"
+                                "40 1 0x04\n"
+                                "40 2 0xAA\n"));
+    char tx_path[32];
+    TEST_ASSERT_TRUE(write_temp(tx_path, ""));
+
+    sim::SimClock clock;
+    ReplayUART uart(clock);
+    TEST_ASSERT_TRUE(uart.open(rx_path, false, tx_path).is_ok());
+    TEST_ASSERT_TRUE(uart.init(1, 9600, 17, 16).is_ok());
+
+    uint8_t buf[8]{};
+    // Nothing due yet, no timeout: returns immediately with 0 bytes
+    TEST_ASSERT_EQUAL(0, uart.read(1, buf, sizeof(buf), 0).value());
+    TEST_ASSERT_EQUAL(0, static_cast<uint32_t>(clock.get_timestamp_ms()));
+
+    // A timeout sleeps only until the next arrival
+    auto got = uart.read(1, buf, sizeof(buf), 1000);
+    TEST_ASSERT_EQUAL(3, got.value());
+    TEST_ASSERT_EQUAL(10, static_cast<uint32_t>(clock.get_timestamp_ms()));
+    TEST_ASSERT_EQUAL_UINT8(0x03, buf[1]);
+
+    // Arrival beyond the timeout: wait the full timeout, return nothing
+    TEST_ASSERT_EQUAL(0, uart.read(1, buf, sizeof(buf), 5).value());
+    TEST_ASSERT_EQUAL(15, static_cast<uint32_t>(clock.get_timestamp_ms()));
+
+    got = uart.read(1, buf, sizeof(buf), 1000);
+    TEST_ASSERT_EQUAL(1, got.value());
+    TEST_ASSERT_EQUAL_UINT8(0x04, buf[0]);
+
+    // TX capture uses the replay format, so it replays on another port
+    const uint8_t request[3] = {0x01, 0x03, 0x10};
+    TEST_ASSERT_EQUAL(3, uart.write(1, request, sizeof(request)).value());
+    TEST_ASSERT_EQUAL(3, static_cast<uint32_t>(uart.tx_bytes()));
+
+    sim::SimClock clock2;
+    ReplayUART echo(clock2);
+    TEST_ASSERT_TRUE(echo.open(tx_path).is_ok());
+    TEST_ASSERT_TRUE(echo.init(1, 9600, 17, 16).is_ok());
+    got = echo.read(1, buf, sizeof(buf), 1000);
+    TEST_ASSERT_EQUAL(3, got.value());
+    TEST_ASSERT_EQUAL_MEMORY(request, buf, sizeof(request));
+    unlink(rx_path);
+    unlink(tx_path);
+}
+
+// ============================================================================
+// Full stack: GridShieldSystem on the POSIX platform, across a "reboot"
+// ============================================================================
+
+static SystemConfig make_posix_config()
+{
+    SystemConfig config;
+    config.meter_id = 0x00C0FFEE;
+    config.reading_interval_ms = 10;
+    config.heartbeat_interval_ms = 50;
+    config.tamper_config.sensor_pin = 4;
+    for (size_t i = 0; i < analytics::PROFILE_HISTORY_SIZE; ++i) {
+        config.baseline_profile.hourly_avg_wh[i] = 1200;
+    }
+    config.baseline_profile.daily_avg_wh = 1200;
+    return config;
+}
+
+static void run_posix_boot(const char* flash_path, bool& warm_keys)
+{
+    PosixPlatformConfig cfg;
+    cfg.flash_path = flash_path;
+    PosixPlatform posix;
+    TEST_ASSERT_TRUE(posix.init(cfg).is_ok());
+
+    GridShieldSystem system;
+    TEST_ASSERT_TRUE(system.initialize(make_posix_config(), posix.services()).is_ok());
+    TEST_ASSERT_TRUE(system.start().is_ok());
+    for (int i = 0; i < 5; ++i) {
+        TEST_ASSERT_TRUE(system.process_cycle().is_ok());
+        posix.time().delay_ms(10);
+    }
+    warm_keys = system.boot_timing().warm_keys;
+    TEST_ASSERT_TRUE(system.shutdown().is_ok());
+}
+
+static void test_posix_platform_full_stack_reboot(void)
+{
+    char path[32];
+    TEST_ASSERT_TRUE(write_temp(path, ""));
+
+    bool warm = true;
+    run_posix_boot(path, warm);
+    TEST_ASSERT_FALSE(warm); // first boot generates keys
+
+    run_posix_boot(path, warm);
+    TEST_ASSERT_TRUE(warm); // second process finds them in the flash image
+    unlink(path);
+}
+
+#endif // GS_PLATFORM_NATIVE
+
+// ============================================================================
+// Suite Registration
+// ============================================================================
+
+void test_posix_platform_suite(void)
+{
+#if GS_PLATFORM_NATIVE
+    RUN_TEST(test_posix_time_monotonic_and_sleeps);
+    RUN_TEST(test_posix_udp_loopback_and_reply);
+    RUN_TEST(test_posix_udp_receive_times_out);
+    RUN_TEST(test_posix_tcp_stream_and_hangup);
+    RUN_TEST(test_posix_tcp_connect_refused);
+    RUN_TEST(test_replay_adc_sample_and_hold);
+    RUN_TEST(test_replay_adc_loops);
+    RUN_TEST(test_replay_i2c_register_banks);
+    RUN_TEST(test_replay_uart_timed_rx_and_tx_capture);
+    RUN_TEST(test_posix_platform_full_stack_reboot);
+#endif
+}
@@ -0,0 +1,515 @@
+/**
+ * @file test_quantile.cpp
+ * @brief Unit tests for streaming quantile sketches and per-hour detector thresholds
+ */
+
+#include "unity.h"
+
+#include "analytics/detector.hpp"
+#include "analytics/quantile.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+
+using namespace gridshield;
+using namespace gridshield::analytics;
+
+// ============================================================================
+// Helpers
+// ============================================================================
+
+static constexpr size_t STREAM_LEN = 4000;
+
+/// Deterministic LCG so the heavy-tailed stream is identical on every target.
+static uint32_t next_rand(uint32_t& state)
+{
+    state = state * 1664525U + 1013904223U;
+    return state >> 8;
+}
+
+/// Pareto-like integer stream: mostly 100..300, rare excursions into the
+/// thousands (the shape of appliance bursts in per-interval deviations).
+static void make_heavy_tail(int32_t* out, size_t n, uint32_t seed)
+{
+    uint32_t state = seed;
+    for (size_t i = 0; i < n; ++i) {
+        const uint32_t u = (next_rand(state) % 1000U) + 1U; // 1..1000
+        out[i] = static_cast<int32_t>(100U + 200000U / (u * u / 10U + 100U) * 10U);
+    }
+}
+
+static int32_t exact_quantile(const int32_t* data, size_t n, uint32_t p_x1000)
+{
+    static int32_t sorted[STREAM_LEN];
+    std::memcpy(sorted, data, n * sizeof(int32_t));
+    std::sort(sorted, sorted + n);
+    size_t idx = (n * p_x1000) / QUANTILE_SCALE;
+    return sorted[idx < n ? idx : n - 1];
+}
+
+/// |estimate - exact| <= tolerance_permille of exact
+static bool within(int32_t estimate, int32_t exact, int32_t tolerance_permille)
+{
+    const int32_t diff = estimate > exact ? estimate - exact : exact - estimate;
+    return static_cast<int64_t>(diff) * 1000 <= static_cast<int64_t>(exact) * tolerance_permille;
+}
+
+static int32_t g_stream[STREAM_LEN];
+
+// ============================================================================
+// P² Tests
+// ============================================================================
+
+static void test_p2_exact_during_warmup()
+{
+    P2Quantile q;
+    q.init(500);
+    TEST_ASSERT_EQUAL(0, q.value());
+
+    q.add(30);
+    q.add(10);
+    q.add(20);
+    TEST_ASSERT_EQUAL(3, q.count());
+    TEST_ASSERT_EQUAL(20, q.value());
+    TEST_ASSERT_EQUAL(500, q.quantile_x1000());
+}
+
+static void test_p2_median_of_uniform()
+{
+    P2Quantile q;
+    q.init(500);
+    uint32_t state = 7;
+    for (int i = 0; i < 5000; ++i) {
+        q.add(static_cast<int32_t>(next_rand(state) % 1001U));
+    }
+    TEST_ASSERT_INT32_WITHIN(30, 500, q.value());
+}
+
+static void test_p2_tracks_heavy_tail_p99()
+{
+    make_heavy_tail(g_stream, STREAM_LEN, 11);
+
+    P2Quantile p99;
+    p99.init(990);
+    P2Quantile p90;
+    p90.init(900);
+    for (size_t i = 0; i < STREAM_LEN; ++i) {
+        p99.add(g_stream[i]);
+        p90.add(g_stream[i]);
+    }
+
+    const int32_t exact99 = exact_quantile(g_stream, STREAM_LEN, 990);
+    const int32_t exact90 = exact_quantile(g_stream, STREAM_LEN, 900);
+    printf("  P2 p90 %d (exact %d), p99 %d (exact %d)\n", static_cast<int>(p90.value()),
+           static_cast<int>(exact90), static_cast<int>(p99.value()), static_cast<int>(exact99));
+    TEST_ASSERT_TRUE(within(p90.value(), exact90, 150));
+    TEST_ASSERT_TRUE(within(p99.value(), exact99, 250));
+}
+
+static void test_p2_saturates_extreme_values()
+{
+    P2Quantile q;
+    q.init(990);
+    for (int i = 0; i < 20; ++i) {
+        q.add(INT32_MAX);
+    }
+    // Q8 range is 2^23; larger inputs clamp instead of wrapping negative
+    TEST_ASSERT_GREATER_THAN(0, q.value());
+}
+
+// ============================================================================
+// t-digest Tests
+// ============================================================================
+
+static void test_p2_snapshot_roundtrip()
+{
+    make_heavy_tail(g_stream, STREAM_LEN, 11U);
+    P2Quantile q(990);
+    for (size_t i = 0; i < STREAM_LEN / 2; ++i) {
+        q.add(g_stream[i] / 10); // deviations stay inside the Q4 snapshot range
+    }
+
+    P2Snapshot snapshot;
+    q.save(snapshot);
+    P2Quantile restored;
+    TEST_ASSERT_TRUE(restored.load(snapshot, 990));
+    TEST_ASSERT_EQUAL_UINT32(q.count(), restored.count());
+    TEST_ASSERT_EQUAL_INT32(q.value(), restored.value());
+
+    // Both keep learning the same way
+    for (size_t i = STREAM_LEN / 2; i < STREAM_LEN; ++i) {
+        q.add(g_stream[i] / 10);
+        restored.add(g_stream[i] / 10);
+    }
+    TEST_ASSERT_TRUE(within(restored.value(), q.value(), 20));
+
+    // Warm-up state restores exactly
+    P2Quantile few(990);
+    few.add(7);
+    few.add(3);
+    few.save(snapshot);
+    TEST_ASSERT_TRUE(restored.load(snapshot, 990));
+    TEST_ASSERT_EQUAL_UINT32(2, restored.count());
+    TEST_ASSERT_EQUAL_INT32(few.value(), restored.value());
+}
+
+static void test_p2_snapshot_rejects_inconsistent_markers()
+{
+    P2Quantile q(990);
+    for (int32_t i = 0; i < 200; ++i) {
+        q.add(i % 50);
+    }
+    P2Snapshot snapshot;
+    q.save(snapshot);
+
+    P2Snapshot unsorted = snapshot;
+    unsorted.height_q4[1] = static_cast<uint16_t>(unsorted.height_q4[3] + 16U);
+    P2Quantile restored;
+    TEST_ASSERT_FALSE(restored.load(unsorted, 990));
+    TEST_ASSERT_EQUAL_UINT32(0, restored.count());
+
+    P2Snapshot crossed = snapshot;
+    crossed.position_offset[0] = INT8_MAX; // past marker 2
+    TEST_ASSERT_FALSE(restored.load(crossed, 990));
+    TEST_ASSERT_EQUAL_UINT32(0, restored.count());
+}
+
+static void test_p2_snapshot_saturates_count()
+{
+    P2Quantile q(990);
+    for (uint32_t i = 0; i < 70000U; ++i) {
+        q.add(static_cast<int32_t>(i % 100U));
+    }
+    P2Snapshot snapshot;
+    q.save(snapshot);
+    TEST_ASSERT_EQUAL_UINT16(UINT16_MAX, snapshot.count);
+
+    P2Quantile restored;
+    TEST_ASSERT_TRUE(restored.load(snapshot, 990));
+    TEST_ASSERT_EQUAL_UINT32(UINT16_MAX, restored.count());
+    TEST_ASSERT_TRUE(within(restored.value(), q.value(), 20));
+}
+
+static void test_tdigest_quantiles()
+{
+    make_heavy_tail(g_stream, STREAM_LEN, 23);
+
+    TDigest<> digest;
+    for (size_t i = 0; i < STREAM_LEN; ++i) {
+        digest.add(g_stream[i]);
+    }
+    TEST_ASSERT_EQUAL(STREAM_LEN, digest.count());
+    TEST_ASSERT_TRUE(digest.centroid_count() <= 32);
+
+    const int32_t p50 = digest.quantile(500);
+    const int32_t p99 = digest.quantile(990);
+    const int32_t p999 = digest.quantile(999);
+    printf("  t-digest p50 %d p99 %d p999 %d with %u centroids\n", static_cast<int>(p50),
+           static_cast<int>(p99), static_cast<int>(p999),
+           static_cast<unsigned>(digest.centroid_count()));
+    TEST_ASSERT_TRUE(within(p50, exact_quantile(g_stream, STREAM_LEN, 500), 150));
+    TEST_ASSERT_TRUE(within(p99, exact_quantile(g_stream, STREAM_LEN, 990), 150));
+    TEST_ASSERT_TRUE(within(p999, exact_quantile(g_stream, STREAM_LEN, 999), 250));
+    TEST_ASSERT_EQUAL(digest.max(), digest.quantile(1000));
+    TEST_ASSERT_TRUE(digest.min() <= p50);
+}
+
+static void test_tdigest_empty_and_buffered()
+{
+    TDigest<> digest;
+    TEST_ASSERT_EQUAL(0, digest.quantile(500));
+
+    // Fewer samples than the buffer: answered from a flushed copy
+    digest.add(5);
+    digest.add(1);
+    digest.add(9);
+    TEST_ASSERT_EQUAL(0, digest.centroid_count());
+    TEST_ASSERT_EQUAL(3, digest.count());
+    TEST_ASSERT_EQUAL(5, digest.quantile(500));
+    TEST_ASSERT_EQUAL(1, digest.min());
+    TEST_ASSERT_EQUAL(9, digest.max());
+}
+
+static void test_tdigest_merge_matches_single()
+{
+    make_heavy_tail(g_stream, STREAM_LEN, 37);
+
+    TDigest<> whole;
+    TDigest<> left;
+    TDigest<> right;
+    for (size_t i = 0; i < STREAM_LEN; ++i) {
+        whole.add(g_stream[i]);
+        ((i & 1U) != 0 ? left : right).add(g_stream[i]);
+    }
+    left.merge(right);
+
+    TEST_ASSERT_EQUAL(whole.count(), left.count());
+    TEST_ASSERT_EQUAL(whole.max(), left.max());
+    TEST_ASSERT_TRUE(left.centroid_count() <= 32);
+    const int32_t exact99 = exact_quantile(g_stream, STREAM_LEN, 990);
+    TEST_ASSERT_TRUE(within(left.quantile(500), whole.quantile(500), 100));
+    TEST_ASSERT_TRUE(within(left.quantile(990), exact99, 150));
+
+    // Merging into an empty digest copies it
+    TDigest<> empty;
+    empty.merge(left);
+    TEST_ASSERT_EQUAL(left.count(), empty.count());
+    TEST_ASSERT_EQUAL(left.quantile(990), empty.quantile(990));
+}
+
+// ============================================================================
+// Detector Integration
+// ============================================================================
+
+static constexpr uint32_t BASE_WH = 1200;
+static constexpr uint64_t HOUR_MS = 3600000ULL;
+
+static core::MeterReading reading_at(uint32_t energy_wh, size_t hour)
+{
+    core::MeterReading r;
+    r.energy_wh = energy_wh;
+    r.voltage_mv = 220000;
+    r.current_ma = 500;
+    r.power_factor = 950;
+    r.timestamp = hour * HOUR_MS + 1000;
+    return r;
+}
+
+static void init_detector(AnomalyDetector& detector)
+{
+    ConsumptionProfile profile;
+    for (size_t i = 0; i < PROFILE_HISTORY_SIZE; ++i) {
+        profile.hourly_avg_wh[i] = BASE_WH;
+    }
+    profile.daily_avg_wh = BASE_WH;
+    profile.weekly_avg_wh = BASE_WH;
+    profile.variance_threshold = 30;
+    profile.profile_confidence = 80;
+    TEST_ASSERT_TRUE(detector.initialize(profile).is_ok());
+}
+
+/// Feed @p count readings into @p hour, cycling through @p pattern_wh.
+static void feed_hour(AnomalyDetector& detector, size_t hour, const uint32_t* pattern_wh,
+                      size_t pattern_len, uint32_t count)
+{
+    for (uint32_t i = 0; i < count; ++i) {
+        (void)detector.analyze(reading_at(pattern_wh[i % pattern_len], hour));
+    }
+}
+
+static void test_detector_threshold_falls_back_until_learned()
+{
+    AnomalyDetector detector;
+    init_detector(detector);
+
+    const uint32_t quiet[] = {1200, 1150, 1250, 1180};
+    feed_hour(detector, 3, quiet, 4, QUANTILE_MIN_SAMPLES - 1);
+    TEST_ASSERT_EQUAL(30, detector.deviation_threshold(3, true));
+    TEST_ASSERT_EQUAL(30, detector.deviation_threshold(4, true));
+}
+
+static void test_detector_quiet_hour_tightens()
+{
+    AnomalyDetector detector;
+    init_detector(detector);
+
+    // Hour 3 never drops more than ~5%: p99 sits under the Low band
+    const uint32_t quiet[] = {1200, 1150, 1180, 1140};
+    feed_hour(detector, 3, quiet, 4, 200);
+    TEST_ASSERT_EQUAL(SEVERITY_LOW_THRESHOLD, detector.deviation_threshold(3, true));
+
+    // A 25% drop is an anomaly in the quiet hour but not in an unlearned one
+    auto tight = detector.analyze(reading_at(900, 3));
+    auto loose = detector.analyze(reading_at(900, 4));
+    TEST_ASSERT_TRUE(tight.is_ok());
+    TEST_ASSERT_TRUE(loose.is_ok());
+    TEST_ASSERT_EQUAL(static_cast<uint8_t>(AnomalyType::UnexpectedDrop),
+                      static_cast<uint8_t>(tight.value().type));
+    TEST_ASSERT_EQUAL(static_cast<uint8_t>(AnomalyType::None),
+                      static_cast<uint8_t>(loose.value().type));
+}
+
+static void test_detector_noisy_hour_widens_within_high_band()
+{
+    AnomalyDetector detector;
+    init_detector(detector);
+
+    // Hour 18 routinely spikes ~45% above the profile
+    const uint32_t evening[] = {1200, 1500, 1740, 1300, 1650};
+    feed_hour(detector, 18, evening, 5, 200);
+    const uint32_t spike_threshold = detector.deviation_threshold(18, false);
+    TEST_ASSERT_GREATER_THAN(35, spike_threshold);
+    TEST_ASSERT_TRUE(spike_threshold <= SEVERITY_HIGH_THRESHOLD);
+    // Drops and spikes are tracked separately
+    TEST_ASSERT_EQUAL(30, detector.deviation_threshold(18, true));
+
+    auto usual = detector.analyze(reading_at(1620, 18)); // +35%
+    TEST_ASSERT_TRUE(usual.is_ok());
+    TEST_ASSERT_EQUAL(static_cast<uint8_t>(AnomalyType::None),
+                      static_cast<uint8_t>(usual.value().type));
+
+    // Bursts far beyond the High band cannot push the threshold past it
+    const uint32_t bursts[] = {3600, 1200, 4800};
+    feed_hour(detector, 19, bursts, 3, 200);
+    TEST_ASSERT_EQUAL(SEVERITY_HIGH_THRESHOLD, detector.deviation_threshold(19, false));
+}
+
+static void test_detector_reset_forgets_quantiles()
+{
+    AnomalyDetector detector;
+    init_detector(detector);
+
+    const uint32_t quiet[] = {1200, 1190};
+    feed_hour(detector, 7, quiet, 2, 100);
+    TEST_ASSERT_EQUAL(SEVERITY_LOW_THRESHOLD, detector.deviation_threshold(7, true));
+
+    TEST_ASSERT_TRUE(detector.reset_profile().is_ok());
+    TEST_ASSERT_EQUAL(detector.get_profile().variance_threshold,
+                      detector.deviation_threshold(7, true));
+}
+
+static void test_detector_checkpoint_keeps_quantiles()
+{
+    AnomalyDetector detector;
+    init_detector(detector);
+
+    const uint32_t quiet[] = {1200, 1150, 1180, 1140};
+    feed_hour(detector, 3, quiet, 4, 200);
+    const uint32_t evening[] = {1200, 1500, 1740, 1300, 1650};
+    feed_hour(detector, 18, evening, 5, 200);
+
+    static DetectorCheckpoint checkpoint;
+    detector.export_state(checkpoint);
+    TEST_ASSERT_EQUAL_UINT8(DetectorCheckpoint::VERSION, checkpoint.version);
+
+    // A rebooted detector uses the learned thresholds straight away
+    AnomalyDetector rebooted;
+    init_detector(rebooted);
+    TEST_ASSERT_TRUE(rebooted.restore_state(checkpoint).is_ok());
+    TEST_ASSERT_EQUAL(SEVERITY_LOW_THRESHOLD, rebooted.deviation_threshold(3, true));
+    TEST_ASSERT_EQUAL(detector.deviation_threshold(18, false),
+                      rebooted.deviation_threshold(18, false));
+    TEST_ASSERT_EQUAL(30, rebooted.deviation_threshold(4, true));
+
+    // A checkpoint from another layout version is refused
+    checkpoint.version = DetectorCheckpoint::VERSION - 1;
+    AnomalyDetector stale;
+    init_detector(stale);
+    TEST_ASSERT_TRUE(stale.restore_state(checkpoint).is_error());
+    TEST_ASSERT_EQUAL(30, stale.deviation_threshold(3, true));
+}
+
+// ============================================================================
+// Update Cost Benchmark
+// ============================================================================
+
+/// Exact baseline: the last WINDOW samples kept sorted (ring + sorted copy).
+template <size_t WINDOW> class SortedWindow
+{
+public:
+    void add(int32_t value) noexcept
+    {
+        if (count_ == WINDOW) {
+            // Evict the oldest sample from the sorted array
+            const int32_t old = ring_[head_];
+            size_t pos = static_cast<size_t>(std::lower_bound(sorted_, sorted_ + count_, old) -
+                                             sorted_);
+            std::memmove(&sorted_[pos], &sorted_[pos + 1], (count_ - pos - 1) * sizeof(int32_t));
+            --count_;
+        }
+        ring_[head_] = value;
+        head_ = (head_ + 1) % WINDOW;
+        const size_t pos =
+            static_cast<size_t>(std::upper_bound(sorted_, sorted_ + count_, value) - sorted_);
+        std::memmove(&sorted_[pos + 1], &sorted_[pos], (count_ - pos) * sizeof(int32_t));
+        sorted_[pos] = value;
+        ++count_;
+    }
+
+    int32_t quantile(uint32_t p_x1000) const noexcept
+    {
+        const size_t idx = (count_ * p_x1000) / QUANTILE_SCALE;
+        return count_ == 0 ? 0 : sorted_[idx < count_ ? idx : count_ - 1];
+    }
+
+private:
+    int32_t ring_[WINDOW]{};
+    int32_t sorted_[WINDOW]{};
+    size_t head_{0};
+    size_t count_{0};
+};
+
+template <typename Sketch, typename Query>
+static uint32_t bench_ns_per_update(Sketch& sketch, Query query, int32_t& sink)
+{
+    static constexpr int ROUNDS = 5;
+    const auto start = std::chrono::steady_clock::now();
+    for (int round = 0; round < ROUNDS; ++round) {
+        for (size_t i = 0; i < STREAM_LEN; ++i) {
+            sketch.add(g_stream[i]);
+        }
+        sink += query(sketch);
+    }
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+    const auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count();
+    return static_cast<uint32_t>(ns / (ROUNDS * static_cast<int64_t>(STREAM_LEN)));
+}
+
+static void test_quantile_update_benchmark()
+{
+    // Device-scale windows: 256 samples is ~2.7 days of 15-min readings
+    make_heavy_tail(g_stream, STREAM_LEN, 53);
+    int32_t sink = 0;
+
+    static P2Quantile p2;
+    p2.init(990);
+    static TDigest<> digest;
+    static SortedWindow<256> window;
+
+    const uint32_t p2_ns = bench_ns_per_update(p2, [](P2Quantile& s) { return s.value(); }, sink);
+    const uint32_t td_ns =
+        bench_ns_per_update(digest, [](TDigest<>& s) { return s.quantile(990); }, sink);
+    const uint32_t win_ns = bench_ns_per_update(
+        window, [](SortedWindow<256>& s) { return s.quantile(990); }, sink);
+
+    printf("  %-22s %6u ns/update %6u bytes\n", "P2 (p99)", static_cast<unsigned>(p2_ns),
+           static_cast<unsigned>(sizeof(P2Quantile)));
+    printf("  %-22s %6u ns/update %6u bytes\n", "t-digest (32 centroids)",
+           static_cast<unsigned>(td_ns), static_cast<unsigned>(sizeof(TDigest<>)));
+    printf("  %-22s %6u ns/update %6u bytes\n", "sorted window (256)",
+           static_cast<unsigned>(win_ns), static_cast<unsigned>(sizeof(SortedWindow<256>)));
+    printf("  detector per-hour sketches: %u bytes\n",
+           static_cast<unsigned>(2 * PROFILE_HISTORY_SIZE * sizeof(P2Quantile)));
+
+    TEST_ASSERT_NOT_EQUAL(0, sink);
+    TEST_ASSERT_EQUAL(48, sizeof(P2Quantile));
+    TEST_ASSERT_LESS_THAN(sizeof(SortedWindow<256>), sizeof(TDigest<>));
+    // P² is O(1) per sample; the window pays two memmoves per sample
+    TEST_ASSERT_LESS_THAN(win_ns + 1, p2_ns);
+}
+
+// ============================================================================
+// TEST SUITE ENTRY POINT
+// ============================================================================
+
+void test_quantile_suite(void)
+{
+    RUN_TEST(test_p2_exact_during_warmup);
+    RUN_TEST(test_p2_median_of_uniform);
+    RUN_TEST(test_p2_tracks_heavy_tail_p99);
+    RUN_TEST(test_p2_saturates_extreme_values);
+    RUN_TEST(test_p2_snapshot_roundtrip);
+    RUN_TEST(test_p2_snapshot_rejects_inconsistent_markers);
+    RUN_TEST(test_p2_snapshot_saturates_count);
+    RUN_TEST(test_tdigest_quantiles);
+    RUN_TEST(test_tdigest_empty_and_buffered);
+    RUN_TEST(test_tdigest_merge_matches_single);
+    RUN_TEST(test_detector_threshold_falls_back_until_learned);
+    RUN_TEST(test_detector_quiet_hour_tightens);
+    RUN_TEST(test_detector_noisy_hour_widens_within_high_band);
+    RUN_TEST(test_detector_reset_forgets_quantiles);
+    RUN_TEST(test_detector_checkpoint_keeps_quantiles);
+    RUN_TEST(test_quantile_update_benchmark);
+}
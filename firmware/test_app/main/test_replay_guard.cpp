@@ -0,0 +1,392 @@
+/**
+ * @file test_replay_guard.cpp
+ * @brief Unit tests for sequence anti-replay (network/replay_guard.hpp)
+ *
+ * Covers the sliding window, the open-addressed sender table (LRU eviction,
+ * backward-shift deletion), high-water persistence, the persistent TX
+ * counter and the PacketTransport hook.
+ */
+
+#include "unity.h"
+
+#include "network/packet.hpp"
+#include "network/replay_guard.hpp"
+#include "platform/mock_platform.hpp"
+#include "security/crypto.hpp"
+
+using namespace gridshield;
+using namespace gridshield::network;
+using namespace gridshield::platform::mock;
+
+namespace {
+
+uint8_t u8(ReplayVerdict v)
+{
+    return static_cast<uint8_t>(v);
+}
+
+constexpr uint8_t ACCEPTED = 0;
+constexpr uint8_t DUPLICATE = 1;
+constexpr uint8_t TOO_OLD = 2;
+
+struct StorageFixture
+{
+    MockCrypto crypto;
+    MockStorage storage;
+    platform::PlatformServices services;
+
+    StorageFixture() noexcept
+    {
+        services.crypto = &crypto;
+        services.storage = &storage;
+    }
+};
+
+/// Tracks batch nesting and can fail writes, like a full or failing flash.
+class BatchTrackingStorage final : public MockStorage
+{
+public:
+    core::Result<size_t>
+    write(uint32_t address, const uint8_t* data, size_t length) noexcept override
+    {
+        if (fail_writes) {
+            return core::Result<size_t>{GS_MAKE_ERROR(core::ErrorCode::HardwareFailure)};
+        }
+        return MockStorage::write(address, data, length);
+    }
+    core::Result<void> begin_batch() noexcept override
+    {
+        ++depth;
+        return core::Result<void>{};
+    }
+    core::Result<void> commit() noexcept override
+    {
+        --depth;
+        return core::Result<void>{};
+    }
+
+    bool fail_writes{false};
+    int depth{0};
+};
+
+} // namespace
+
+// ============================================================================
+// Sliding window
+// ============================================================================
+
+static void test_replay_window_basic(void)
+{
+    ReplayWindow<64> w;
+    TEST_ASSERT_EQUAL_UINT8(ACCEPTED, u8(w.check_and_update(100)));
+    TEST_ASSERT_EQUAL_UINT8(DUPLICATE, u8(w.check_and_update(100)));
+    TEST_ASSERT_EQUAL_UINT8(ACCEPTED, u8(w.check_and_update(102)));
+    // Reordered but inside the window
+    TEST_ASSERT_EQUAL_UINT8(ACCEPTED, u8(w.check_and_update(101)));
+    TEST_ASSERT_EQUAL_UINT8(DUPLICATE, u8(w.check_and_update(101)));
+    TEST_ASSERT_EQUAL_UINT8(ACCEPTED, u8(w.check_and_update(50))); // 52 behind, fits
+    TEST_ASSERT_EQUAL_UINT8(TOO_OLD, u8(w.check_and_update(38)));  // 64 behind
+    TEST_ASSERT_EQUAL_UINT32(102, w.high_water());
+
+    // A jump past the window forgets everything behind it
+    TEST_ASSERT_EQUAL_UINT8(ACCEPTED, u8(w.check_and_update(1000)));
+    TEST_ASSERT_EQUAL_UINT8(ACCEPTED, u8(w.check_and_update(999)));
+    TEST_ASSERT_EQUAL_UINT8(TOO_OLD, u8(w.check_and_update(102)));
+}
+
+static void test_replay_window_128_word_shift(void)
+{
+    ReplayWindow<128> w;
+    for (core::sequence_t s = 10; s < 20; ++s) {
+        TEST_ASSERT_EQUAL_UINT8(ACCEPTED, u8(w.check_and_update(s)));
+    }
+    // Shift by 70: bits for 10..19 move across the word boundary
+    TEST_ASSERT_EQUAL_UINT8(ACCEPTED, u8(w.check_and_update(89)));
+    for (core::sequence_t s = 10; s < 20; ++s) {
+        TEST_ASSERT_EQUAL_UINT8(DUPLICATE, u8(w.check(s)));
+    }
+    for (core::sequence_t s = 20; s < 89; ++s) {
+        TEST_ASSERT_EQUAL_UINT8(ACCEPTED, u8(w.check(s)));
+    }
+    TEST_ASSERT_EQUAL_UINT8(ACCEPTED, u8(w.check_and_update(150)));
+    TEST_ASSERT_EQUAL_UINT8(DUPLICATE, u8(w.check(89)));
+    TEST_ASSERT_EQUAL_UINT8(TOO_OLD, u8(w.check(19)));
+
+    w.restore(500);
+    TEST_ASSERT_EQUAL_UINT8(DUPLICATE, u8(w.check(450)));
+    TEST_ASSERT_EQUAL_UINT8(TOO_OLD, u8(w.check(300)));
+    TEST_ASSERT_EQUAL_UINT8(ACCEPTED, u8(w.check(501)));
+}
+
+// ============================================================================
+// Sender table
+// ============================================================================
+
+static void test_replay_guard_independent_senders(void)
+{
+    static ReplayGuard<16> guard;
+    guard.reset();
+    TEST_ASSERT_EQUAL_UINT8(ACCEPTED, u8(guard.check_and_update(1, 5)));
+    TEST_ASSERT_EQUAL_UINT8(ACCEPTED, u8(guard.check_and_update(2, 5)));
+    TEST_ASSERT_EQUAL_UINT8(DUPLICATE, u8(guard.check_and_update(1, 5)));
+    TEST_ASSERT_EQUAL_UINT8(ACCEPTED, u8(guard.check(3, 5))); // unknown: no insert
+    TEST_ASSERT_EQUAL_UINT32(2, guard.size());
+    TEST_ASSERT_EQUAL_UINT32(2, guard.stats().accepted);
+    TEST_ASSERT_EQUAL_UINT32(1, guard.stats().duplicates);
+    TEST_ASSERT_EQUAL_UINT32(2, guard.dirty());
+    TEST_ASSERT_TRUE(guard.high_water(3).is_error());
+}
+
+static void test_replay_guard_lru_eviction(void)
+{
+    static ReplayGuard<4, 64> guard;
+    guard.reset();
+    for (core::meter_id_t id = 1; id <= 4; ++id) {
+        (void)guard.check_and_update(id, 10);
+    }
+    (void)guard.check_and_update(1, 11); // 1 is now most recent; 2 is LRU
+    (void)guard.check_and_update(5, 1);
+
+    TEST_ASSERT_EQUAL_UINT32(4, guard.size());
+    TEST_ASSERT_EQUAL_UINT32(1, guard.stats().evictions);
+    TEST_ASSERT_TRUE(guard.high_water(2).is_error());
+    TEST_ASSERT_EQUAL_UINT32(11, guard.high_water(1).value());
+    TEST_ASSERT_EQUAL_UINT8(DUPLICATE, u8(guard.check(3, 10)));
+}
+
+static void test_replay_guard_churn_matches_reference(void)
+{
+    // Many evictions through a small table: every survivor must stay
+    // reachable after backward-shift deletions
+    static constexpr size_t CAP = 64;
+    static ReplayGuard<CAP, 64> guard;
+    guard.reset();
+
+    core::meter_id_t recent[CAP]{}; // ring of the last CAP distinct ids
+    size_t recent_head = 0;
+    uint32_t lcg = 7;
+    for (uint32_t i = 0; i < 5000; ++i) {
+        lcg = lcg * 1664525U + 1013904223U;
+        // Fresh ids only, so the last CAP ids inserted are exactly the table
+        const core::meter_id_t id = (static_cast<uint64_t>(lcg) << 20) | i;
+        TEST_ASSERT_EQUAL_UINT8(ACCEPTED, u8(guard.check_and_update(id, i)));
+        recent[recent_head] = id;
+        recent_head = (recent_head + 1) % CAP;
+    }
+    TEST_ASSERT_EQUAL_UINT32(CAP, guard.size());
+    TEST_ASSERT_EQUAL_UINT32(5000 - CAP, guard.stats().evictions);
+    size_t found = 0;
+    for (const core::meter_id_t id : recent) {
+        found += guard.high_water(id).is_ok() ? 1U : 0U;
+    }
+    TEST_ASSERT_EQUAL_UINT32(CAP, found);
+}
+
+// ============================================================================
+// Persistence
+// ============================================================================
+
+static void test_replay_persist_round_trip(void)
+{
+    StorageFixture f;
+    const ReplayPersistConfig config{0, 1024};
+    static ReplayGuard<8, 64> guard;
+    static ReplayGuard<8, 64> rebooted;
+    guard.reset();
+    for (core::meter_id_t id = 1; id <= 6; ++id) {
+        (void)guard.check_and_update(id, static_cast<core::sequence_t>(100 * id));
+    }
+    (void)guard.check_and_update(3, 305);
+
+    auto saved = guard.save(f.services, config);
+    TEST_ASSERT_TRUE(saved.is_ok());
+    TEST_ASSERT_EQUAL_UINT32(6, saved.value());
+    TEST_ASSERT_EQUAL_UINT32(0, guard.dirty());
+
+    auto restored = rebooted.restore(f.services, config);
+    TEST_ASSERT_TRUE(restored.is_ok());
+    TEST_ASSERT_EQUAL_UINT32(6, restored.value());
+    TEST_ASSERT_EQUAL_UINT32(305, rebooted.high_water(3).value());
+    // Old frames are replays after reboot; newer ones pass
+    TEST_ASSERT_EQUAL_UINT8(DUPLICATE, u8(rebooted.check_and_update(3, 305)));
+    TEST_ASSERT_EQUAL_UINT8(DUPLICATE, u8(rebooted.check_and_update(3, 290)));
+    TEST_ASSERT_EQUAL_UINT8(ACCEPTED, u8(rebooted.check_and_update(3, 306)));
+
+    // LRU order survives: 1 is the oldest, evicted first
+    (void)rebooted.check_and_update(7, 1);
+    (void)rebooted.check_and_update(8, 1);
+    (void)rebooted.check_and_update(9, 1);
+    TEST_ASSERT_TRUE(rebooted.high_water(1).is_error());
+    TEST_ASSERT_TRUE(rebooted.high_water(2).is_ok());
+}
+
+static void test_replay_persist_torn_bank_falls_back(void)
+{
+    StorageFixture f;
+    const ReplayPersistConfig config{0, 512};
+    static ReplayGuard<8, 64> guard;
+    static ReplayGuard<8, 64> rebooted;
+    guard.reset();
+    (void)guard.check_and_update(42, 10);
+    TEST_ASSERT_TRUE(guard.save(f.services, config).is_ok()); // bank A (seq 1)
+    (void)guard.check_and_update(42, 20);
+    TEST_ASSERT_TRUE(guard.save(f.services, config).is_ok()); // bank B (seq 2)
+
+    // Corrupt the record block of bank B, as if power failed mid-save
+    const uint8_t junk = 0xEE;
+    const uint32_t torn = 512 + ReplayGuard<8, 64>::HEADER_SIZE + 2;
+    TEST_ASSERT_TRUE(f.storage.write(torn, &junk, 1).is_ok());
+
+    TEST_ASSERT_TRUE(rebooted.restore(f.services, config).is_ok());
+    TEST_ASSERT_EQUAL_UINT32(10, rebooted.high_water(42).value());
+
+    StorageFixture blank;
+    TEST_ASSERT_TRUE(rebooted.restore(blank.services, config).is_error());
+    TEST_ASSERT_EQUAL_UINT32(0, rebooted.size());
+}
+
+static void test_replay_persist_small_bank_keeps_recent(void)
+{
+    StorageFixture f;
+    using Guard = ReplayGuard<64, 64>;
+    // Header + one block: 32 records
+    const ReplayPersistConfig config{0, Guard::HEADER_SIZE + Guard::BLOCK_SIZE};
+    TEST_ASSERT_EQUAL_UINT32(REPLAY_PERSIST_BLOCK, Guard::bank_capacity(config.bank_size));
+    static Guard guard;
+    static Guard rebooted;
+    guard.reset();
+    for (core::meter_id_t id = 1; id <= 40; ++id) {
+        (void)guard.check_and_update(id, 1);
+    }
+    auto saved = guard.save(f.services, config);
+    TEST_ASSERT_TRUE(saved.is_ok());
+    TEST_ASSERT_EQUAL_UINT32(REPLAY_PERSIST_BLOCK, saved.value());
+
+    TEST_ASSERT_TRUE(rebooted.restore(f.services, config).is_ok());
+    TEST_ASSERT_TRUE(rebooted.high_water(40).is_ok());
+    TEST_ASSERT_TRUE(rebooted.high_water(9).is_ok());
+    TEST_ASSERT_TRUE(rebooted.high_water(8).is_error());
+}
+
+static void test_replay_persist_failed_save_closes_batch(void)
+{
+    MockCrypto crypto;
+    BatchTrackingStorage storage;
+    platform::PlatformServices services;
+    services.crypto = &crypto;
+    services.storage = &storage;
+    const ReplayPersistConfig config{0, 512};
+    static ReplayGuard<8, 64> guard;
+    guard.reset();
+    (void)guard.check_and_update(42, 10);
+
+    storage.fail_writes = true;
+    TEST_ASSERT_TRUE(guard.save(services, config).is_error());
+    TEST_ASSERT_EQUAL_INT(0, storage.depth); // no batch left open for later writers
+    TEST_ASSERT_EQUAL_UINT32(1, guard.dirty());
+
+    storage.fail_writes = false;
+    TEST_ASSERT_TRUE(guard.save(services, config).is_ok());
+    TEST_ASSERT_EQUAL_INT(0, storage.depth);
+}
+
+// ============================================================================
+// TX sequence counter
+// ============================================================================
+
+static void test_tx_sequence_survives_reboot(void)
+{
+    StorageFixture f;
+    TxSequenceCounter counter;
+    TEST_ASSERT_TRUE(counter.init(f.services).is_ok());
+    core::sequence_t last = 0;
+    for (int i = 0; i < 300; ++i) {
+        auto seq = counter.next();
+        TEST_ASSERT_TRUE(seq.is_ok());
+        TEST_ASSERT_GREATER_THAN(last, seq.value());
+        last = seq.value();
+    }
+
+    // Reboot: resumes above everything handed out before
+    TxSequenceCounter rebooted;
+    TEST_ASSERT_TRUE(rebooted.init(f.services).is_ok());
+    auto seq = rebooted.next();
+    TEST_ASSERT_TRUE(seq.is_ok());
+    TEST_ASSERT_GREATER_THAN(last, seq.value());
+    TEST_ASSERT_LESS_THAN(last + 2 * TxSequenceCounter::RESERVE_STRIDE, seq.value());
+
+    // Without storage it still counts
+    platform::PlatformServices none{};
+    TxSequenceCounter volatile_counter;
+    TEST_ASSERT_TRUE(volatile_counter.init(none).is_ok());
+    TEST_ASSERT_EQUAL_UINT32(1, volatile_counter.next().value());
+    TEST_ASSERT_EQUAL_UINT32(2, volatile_counter.next().value());
+}
+
+// ============================================================================
+// PacketTransport hook
+// ============================================================================
+
+static void test_replay_transport_rejects_replayed_frame(void)
+{
+    MockCrypto platform_crypto;
+    security::CryptoEngine crypto(platform_crypto);
+    security::ECCKeyPair keypair;
+    TEST_ASSERT_TRUE(crypto.generate_keypair(keypair).is_ok());
+
+    MockComm comm;
+    TEST_ASSERT_TRUE(comm.init().is_ok());
+    comm.set_connected(true);
+    PacketTransport transport(comm);
+    static ReplayGuard<16> guard;
+    guard.reset();
+    transport.set_replay_guard(&guard);
+
+    uint8_t frames[2][PacketTransport::MAX_FRAME_SIZE];
+    size_t lengths[2]{};
+    for (core::sequence_t i = 0; i < 2; ++i) {
+        uint8_t payload[8]{};
+        SecurePacket packet;
+        packet.set_sequence(7 + i);
+        TEST_ASSERT_TRUE(packet
+                             .build(PacketType::Command,
+                                    0xABCD,
+                                    core::Priority::Normal,
+                                    payload,
+                                    sizeof(payload),
+                                    crypto,
+                                    keypair)
+                             .is_ok());
+        TEST_ASSERT_EQUAL_UINT32(7 + i, packet.header().sequence);
+        auto n = packet.serialize(frames[i], sizeof(frames[i]));
+        TEST_ASSERT_TRUE(n.is_ok());
+        lengths[i] = n.value();
+    }
+
+    // 8, 7 (reordered), 8 again (replay)
+    comm.inject_rx_data(frames[1], lengths[1]);
+    comm.inject_rx_data(frames[0], lengths[0]);
+    comm.inject_rx_data(frames[1], lengths[1]);
+    TEST_ASSERT_TRUE(transport.receive_packet(crypto, keypair, 10).is_ok());
+    TEST_ASSERT_TRUE(transport.receive_packet(crypto, keypair, 10).is_ok());
+    auto replay = transport.receive_packet(crypto, keypair, 10);
+    TEST_ASSERT_TRUE(replay.is_error());
+    TEST_ASSERT_EQUAL_INT(static_cast<int>(core::ErrorCode::ReplayDetected),
+                          static_cast<int>(replay.error().code));
+    TEST_ASSERT_EQUAL_UINT32(0, transport.buffered_bytes()); // replay consumed
+}
+
+void test_replay_guard_suite(void)
+{
+    RUN_TEST(test_replay_window_basic);
+    RUN_TEST(test_replay_window_128_word_shift);
+    RUN_TEST(test_replay_guard_independent_senders);
+    RUN_TEST(test_replay_guard_lru_eviction);
+    RUN_TEST(test_replay_guard_churn_matches_reference);
+    RUN_TEST(test_replay_persist_round_trip);
+    RUN_TEST(test_replay_persist_torn_bank_falls_back);
+    RUN_TEST(test_replay_persist_small_bank_keeps_recent);
+    RUN_TEST(test_replay_persist_failed_save_closes_batch);
+    RUN_TEST(test_tx_sequence_survives_reboot);
+    RUN_TEST(test_replay_transport_rejects_replayed_frame);
+}
@@ -0,0 +1,282 @@
+/**
+ * @file test_report_policy.cpp
+ * @brief Unit tests for report-by-exception telemetry (network/report_policy.hpp)
+ *
+ * Covers deadbands, the energy integral-error bound and its reconstruction
+ * guarantee, heartbeat, urgent sends, failed-send handling and the
+ * GridShieldSystem hook.
+ */
+
+#include "unity.h"
+
+#include "core/system.hpp"
+#include "network/report_policy.hpp"
+#include "platform/mock_platform.hpp"
+
+using namespace gridshield;
+using namespace gridshield::network;
+
+namespace {
+
+constexpr core::timestamp_t STEP_MS = 5000;
+
+core::MeterReading make_reading(core::timestamp_t ts, uint32_t energy_wh)
+{
+    core::MeterReading r;
+    r.timestamp = ts;
+    r.energy_wh = energy_wh;
+    r.voltage_mv = 230000;
+    r.current_ma = 4000;
+    r.power_factor = 950;
+    return r;
+}
+
+ReportPolicyConfig enabled_config()
+{
+    ReportPolicyConfig config;
+    config.enabled = true;
+    return config;
+}
+
+/// evaluate + (outgoing, commit) as GridShieldSystem does on a good send.
+ReportReason step(ReportPolicy& policy,
+                  const core::MeterReading& r,
+                  bool urgent = false,
+                  core::MeterReading* sent = nullptr)
+{
+    const ReportReason reason = policy.evaluate(r, urgent);
+    if (reason != ReportReason::Suppressed) {
+        const core::MeterReading out = policy.outgoing(r);
+        policy.commit(r, out);
+        if (sent != nullptr) {
+            *sent = out;
+        }
+    }
+    return reason;
+}
+
+uint8_t u8(ReportReason reason)
+{
+    return static_cast<uint8_t>(reason);
+}
+
+} // namespace
+
+// ============================================================================
+// Decisions
+// ============================================================================
+
+static void test_report_disabled_sends_all(void)
+{
+    ReportPolicy policy;
+    for (core::timestamp_t i = 0; i < 5; ++i) {
+        TEST_ASSERT_EQUAL_UINT8(u8(ReportReason::Disabled),
+                                u8(step(policy, make_reading(i * STEP_MS, 1000))));
+    }
+    TEST_ASSERT_EQUAL_UINT32(5, policy.stats().sent);
+}
+
+static void test_report_steady_state_suppressed(void)
+{
+    ReportPolicy policy(enabled_config());
+    TEST_ASSERT_EQUAL_UINT8(u8(ReportReason::First), u8(step(policy, make_reading(0, 1000))));
+    for (core::timestamp_t i = 1; i < 20; ++i) {
+        TEST_ASSERT_EQUAL_UINT8(u8(ReportReason::Suppressed),
+                                u8(step(policy, make_reading(i * STEP_MS, 1000))));
+    }
+    TEST_ASSERT_EQUAL_UINT32(1, policy.stats().sent);
+    TEST_ASSERT_EQUAL_UINT32(19, policy.stats().suppressed());
+}
+
+static void test_report_deadbands(void)
+{
+    ReportPolicy policy(enabled_config());
+    (void)step(policy, make_reading(0, 1000));
+
+    // Voltage: 2 % of 230 V = 4.6 V
+    auto r = make_reading(STEP_MS, 1000);
+    r.voltage_mv = 234000;
+    TEST_ASSERT_EQUAL_UINT8(u8(ReportReason::Suppressed), u8(step(policy, r)));
+    r.voltage_mv = 235000;
+    TEST_ASSERT_EQUAL_UINT8(u8(ReportReason::Deadband), u8(step(policy, r)));
+
+    // Current: 200 mA absolute band trips before the 10 % one (400 mA)
+    r = make_reading(2 * STEP_MS, 1000);
+    r.voltage_mv = 235000;
+    r.current_ma = 4150;
+    TEST_ASSERT_EQUAL_UINT8(u8(ReportReason::Suppressed), u8(step(policy, r)));
+    r.current_ma = 4250;
+    TEST_ASSERT_EQUAL_UINT8(u8(ReportReason::Deadband), u8(step(policy, r)));
+
+    // Energy: 25 %
+    r.energy_wh = 1300;
+    TEST_ASSERT_EQUAL_UINT8(u8(ReportReason::Deadband), u8(step(policy, r)));
+
+    Deadband off;
+    TEST_ASSERT_FALSE(off.exceeded(UINT32_MAX, 0));
+}
+
+static void test_report_heartbeat_and_urgent(void)
+{
+    ReportPolicyConfig config = enabled_config();
+    config.max_silence_ms = 4 * STEP_MS;
+    ReportPolicy policy(config);
+
+    (void)step(policy, make_reading(0, 1000));
+    TEST_ASSERT_EQUAL_UINT8(u8(ReportReason::Urgent),
+                            u8(step(policy, make_reading(STEP_MS, 1000), true)));
+    for (core::timestamp_t i = 2; i < 5; ++i) {
+        TEST_ASSERT_EQUAL_UINT8(u8(ReportReason::Suppressed),
+                                u8(step(policy, make_reading(i * STEP_MS, 1000))));
+    }
+    TEST_ASSERT_EQUAL_UINT8(u8(ReportReason::Heartbeat),
+                            u8(step(policy, make_reading(5 * STEP_MS, 1000))));
+}
+
+// ============================================================================
+// Integral error bound
+// ============================================================================
+
+static void test_report_integral_error_triggers(void)
+{
+    ReportPolicy policy(enabled_config()); // bound 50 Wh
+    (void)step(policy, make_reading(0, 1000));
+
+    // +20 Wh per interval stays inside the 25 % band but drifts the integral
+    TEST_ASSERT_EQUAL_UINT8(u8(ReportReason::Suppressed),
+                            u8(step(policy, make_reading(STEP_MS, 1020))));
+    TEST_ASSERT_EQUAL_UINT8(u8(ReportReason::Suppressed),
+                            u8(step(policy, make_reading(2 * STEP_MS, 1020))));
+    TEST_ASSERT_EQUAL_INT32(40, static_cast<int32_t>(policy.residual_wh()));
+
+    core::MeterReading sent;
+    TEST_ASSERT_EQUAL_UINT8(u8(ReportReason::IntegralError),
+                            u8(step(policy, make_reading(3 * STEP_MS, 1020), false, &sent)));
+    // Outstanding 40 Wh folded into the report
+    TEST_ASSERT_EQUAL_UINT32(1060, sent.energy_wh);
+    TEST_ASSERT_EQUAL_INT32(0, static_cast<int32_t>(policy.residual_wh()));
+}
+
+static void test_report_reconstruction_bounded(void)
+{
+    ReportPolicyConfig config = enabled_config();
+    config.energy_wh = Deadband{0, 0}; // integral bound only
+    config.max_silence_ms = 0;
+    ReportPolicy policy(config);
+
+    // Server: hold the last reported value for silent intervals
+    uint32_t held = 0;
+    int64_t actual_total = 0;
+    int64_t server_total = 0;
+    int64_t worst = 0;
+    uint32_t lcg = 12345;
+    for (core::timestamp_t i = 0; i < 2000; ++i) {
+        lcg = lcg * 1103515245U + 12345U;
+        const uint32_t wh = 800 + ((lcg >> 16) % 400) + static_cast<uint32_t>(i % 96) * 4;
+        core::MeterReading sent;
+        const ReportReason reason = step(policy, make_reading(i * STEP_MS, wh), false, &sent);
+        if (reason != ReportReason::Suppressed) {
+            held = sent.energy_wh;
+        }
+        actual_total += wh;
+        server_total += held;
+        const int64_t err = actual_total - server_total;
+        const int64_t mag = err < 0 ? -err : err;
+        worst = mag > worst ? mag : worst;
+    }
+    TEST_ASSERT_TRUE(worst <= static_cast<int64_t>(config.energy_error_bound_wh));
+    TEST_ASSERT_GREATER_THAN(100, policy.stats().suppressed());
+}
+
+static void test_report_residual_clamps_at_zero(void)
+{
+    ReportPolicyConfig config = enabled_config();
+    config.energy_wh = Deadband{0, 0};
+    config.energy_error_bound_wh = 100;
+    ReportPolicy policy(config);
+
+    (void)step(policy, make_reading(0, 90));
+    (void)step(policy, make_reading(STEP_MS, 0)); // -90, suppressed
+    core::MeterReading sent;
+    TEST_ASSERT_EQUAL_UINT8(u8(ReportReason::IntegralError),
+                            u8(step(policy, make_reading(2 * STEP_MS, 0), false, &sent)));
+    // The earlier -90 Wh cannot be folded into a 0 Wh report: it stays outstanding
+    TEST_ASSERT_EQUAL_UINT32(0, sent.energy_wh);
+    TEST_ASSERT_EQUAL_INT32(-90, static_cast<int32_t>(policy.residual_wh()));
+    TEST_ASSERT_EQUAL_UINT32(0, policy.outgoing(make_reading(3 * STEP_MS, 50)).energy_wh);
+    TEST_ASSERT_EQUAL_UINT32(110, policy.outgoing(make_reading(3 * STEP_MS, 200)).energy_wh);
+}
+
+static void test_report_failed_send_not_committed(void)
+{
+    ReportPolicy policy(enabled_config());
+    (void)step(policy, make_reading(0, 1000));
+
+    auto r = make_reading(STEP_MS, 2000);
+    TEST_ASSERT_EQUAL_UINT8(u8(ReportReason::Deadband), u8(policy.evaluate(r)));
+    // No commit: the next reading is still measured against the old reference
+    TEST_ASSERT_EQUAL_UINT8(u8(ReportReason::Deadband),
+                            u8(policy.evaluate(make_reading(2 * STEP_MS, 2000))));
+    TEST_ASSERT_EQUAL_UINT32(1, policy.stats().sent);
+}
+
+// ============================================================================
+// System hook
+// ============================================================================
+
+static void test_report_system_suppresses(void)
+{
+    using namespace gridshield::platform::mock;
+    MockTime time;
+    MockGPIO gpio;
+    MockInterrupt interrupt;
+    MockCrypto crypto;
+    MockComm comm;
+    MockStorage storage;
+    platform::PlatformServices services;
+    services.time = &time;
+    services.gpio = &gpio;
+    services.interrupt = &interrupt;
+    services.crypto = &crypto;
+    services.storage = &storage;
+    services.comm = &comm;
+    comm.set_connected(true);
+
+    static GridShieldSystem system;
+    SystemConfig config;
+    config.meter_id = 0xDEADBEEF;
+    config.tamper_config.sensor_pin = 4;
+    for (size_t i = 0; i < analytics::PROFILE_HISTORY_SIZE; ++i) {
+        config.baseline_profile.hourly_avg_wh[i] = 1000;
+    }
+    config.baseline_profile.daily_avg_wh = 1000;
+    config.baseline_profile.variance_threshold = 30;
+    config.report_policy.enabled = true;
+    TEST_ASSERT_TRUE(system.initialize(config, services).is_ok());
+
+    for (core::timestamp_t i = 0; i < 6; ++i) {
+        TEST_ASSERT_TRUE(system.send_meter_reading(make_reading(i * STEP_MS, 1000)).is_ok());
+    }
+    TEST_ASSERT_EQUAL_UINT32(1, system.report_policy().stats().sent);
+    TEST_ASSERT_EQUAL_UINT32(5, system.report_policy().stats().suppressed());
+
+    // Transport down: the deadband reading is not committed
+    comm.set_connected(false);
+    TEST_ASSERT_TRUE(system.send_meter_reading(make_reading(6 * STEP_MS, 1400)).is_error());
+    TEST_ASSERT_EQUAL_UINT32(1, system.report_policy().stats().sent);
+
+    (void)system.shutdown();
+}
+
+void test_report_policy_suite(void)
+{
+    RUN_TEST(test_report_disabled_sends_all);
+    RUN_TEST(test_report_steady_state_suppressed);
+    RUN_TEST(test_report_deadbands);
+    RUN_TEST(test_report_heartbeat_and_urgent);
+    RUN_TEST(test_report_integral_error_triggers);
+    RUN_TEST(test_report_reconstruction_bounded);
+    RUN_TEST(test_report_residual_clamps_at_zero);
+    RUN_TEST(test_report_failed_send_not_committed);
+    RUN_TEST(test_report_system_suppresses);
+}
@@ -0,0 +1,335 @@
+/**
+ * @file test_shadow_sync.cpp
+ * @brief Unit tests for delta-only shadow / twin reporting
+ *
+ * Covers the full first report and merge-patch diffs, deadbands measured
+ * from the acknowledged value, coalescing windows with urgent bypass,
+ * stale desired deltas, version conflicts and resync through the AWS
+ * connector, unversioned Azure twin patches, acknowledgement timeouts and
+ * the legacy full-document mode.
+ */
+
+#include "unity.h"
+
+#include "cloud/aws_iot.hpp"
+#include "cloud/azure_iot.hpp"
+#include "cloud/shadow_sync.hpp"
+
+#include <cstdint>
+#include <cstring>
+
+using namespace gridshield;
+using namespace gridshield::cloud;
+
+namespace {
+
+constexpr uint32_t WINDOW_MS = 60000;
+
+ReportedState reading(uint32_t voltage_mv, uint32_t current_ma, uint32_t energy_wh)
+{
+    ReportedState state;
+    state.voltage_mv = voltage_mv;
+    state.current_ma = current_ma;
+    state.energy_wh = energy_wh;
+    state.temperature_c10 = 250;
+    return state;
+}
+
+CloudConfig connector_config()
+{
+    CloudConfig config{};
+    std::strncpy(config.endpoint.data(), "test.iot.example.com", CLOUD_MAX_ENDPOINT_LENGTH - 1);
+    std::strncpy(config.device_id.data(), "gridshield_001", CLOUD_MAX_DEVICE_ID_LENGTH - 1);
+    return config;
+}
+
+TelemetryPayload telemetry(uint32_t voltage_mv, uint32_t energy_wh, uint64_t timestamp)
+{
+    TelemetryPayload payload{};
+    payload.voltage_mv = voltage_mv;
+    payload.current_ma = 5000;
+    payload.energy_wh = energy_wh;
+    payload.temperature_c10 = 250;
+    payload.timestamp = timestamp;
+    return payload;
+}
+
+} // namespace
+
+// ============================================================================
+// DIFF AND DEADBANDS
+// ============================================================================
+
+static void test_shadow_first_report_then_patch(void)
+{
+    ShadowSync sync;
+    char doc[256];
+
+    // Nothing acknowledged yet: the whole document, at once, unversioned
+    sync.update(reading(230000, 5000, 1000), 0);
+    TEST_ASSERT_TRUE(sync.due(0));
+    auto full = sync.build_patch(doc, sizeof(doc), ShadowFormat::AwsShadow, 0);
+    TEST_ASSERT_TRUE(full.is_ok());
+    TEST_ASSERT_EQUAL_STRING("{\"state\":{\"reported\":{\"voltage_mv\":230000,"
+                             "\"current_ma\":5000,\"energy_wh\":1000,"
+                             "\"temperature_c10\":250,\"tamper_detected\":false}}}",
+                             doc);
+    TEST_ASSERT_EQUAL(std::strlen(doc), full.value());
+    TEST_ASSERT_FALSE(sync.due(0)); // in flight
+    sync.on_accepted(1);
+
+    // Inside every band: nothing to send
+    sync.update(reading(231000, 5040, 1004), 5000);
+    TEST_ASSERT_EQUAL_UINT8(0, sync.dirty_fields());
+    TEST_ASSERT_FALSE(sync.due(5000 + WINDOW_MS));
+
+    // Energy leaves its 10 Wh band: only that field, once the window closes
+    sync.update(reading(231000, 5040, 1011), 10000);
+    TEST_ASSERT_EQUAL_UINT8(shadow_field_bit(ShadowField::EnergyWh), sync.dirty_fields());
+    TEST_ASSERT_FALSE(sync.due(10000 + WINDOW_MS - 1));
+    TEST_ASSERT_TRUE(sync.due(10000 + WINDOW_MS));
+    auto patch = sync.build_patch(doc, sizeof(doc), ShadowFormat::AwsShadow, 10000 + WINDOW_MS);
+    TEST_ASSERT_TRUE(patch.is_ok());
+    TEST_ASSERT_EQUAL_STRING("{\"state\":{\"reported\":{\"energy_wh\":1011}},\"version\":1}", doc);
+    sync.on_accepted(2);
+    TEST_ASSERT_EQUAL_UINT32(1011, sync.acknowledged().energy_wh);
+    TEST_ASSERT_EQUAL_UINT32(230000, sync.acknowledged().voltage_mv); // never sent 231000
+    TEST_ASSERT_EQUAL_UINT32(2, sync.version());
+    TEST_ASSERT_EQUAL_UINT32(2, sync.stats().messages);
+    TEST_ASSERT_EQUAL_UINT32(6, sync.stats().fields_sent);
+}
+
+static void test_shadow_deadband_drift(void)
+{
+    ShadowSyncConfig config;
+    config.coalesce_ms = 0;
+    ShadowSync sync(config);
+    char doc[256];
+
+    sync.update(reading(230000, 5000, 1000), 0);
+    (void)sync.build_patch(doc, sizeof(doc), ShadowFormat::AzureTwin, 0);
+    sync.on_accepted(0);
+
+    // 1 % voltage band measured from the acknowledged value, so a slow drift
+    // is reported once it adds up rather than never
+    uint32_t voltage = 230000;
+    uint32_t steps = 0;
+    while (sync.dirty_fields() == 0 && steps < 100) {
+        voltage += 500;
+        ++steps;
+        sync.update(reading(voltage, 5000, 1000), steps * 1000U);
+    }
+    TEST_ASSERT_EQUAL_UINT32(5, steps); // 2.5 V > 2.3 V
+    TEST_ASSERT_EQUAL_UINT8(shadow_field_bit(ShadowField::VoltageMv), sync.dirty_fields());
+
+    // Exact mode: any change counts
+    ShadowSyncConfig exact;
+    exact.voltage_mv = network::Deadband{};
+    exact.current_ma = network::Deadband{};
+    exact.energy_wh = network::Deadband{};
+    exact.temperature_c10 = 0;
+    ShadowSync strict(exact);
+    strict.update(reading(230000, 5000, 1000), 0);
+    (void)strict.build_patch(doc, sizeof(doc), ShadowFormat::AzureTwin, 0);
+    strict.on_accepted(0);
+    ReportedState next = reading(230001, 5000, 1000);
+    next.temperature_c10 = 251;
+    strict.update(next, 1000);
+    TEST_ASSERT_EQUAL_UINT8(shadow_field_bit(ShadowField::VoltageMv) |
+                                shadow_field_bit(ShadowField::TemperatureC10),
+                            strict.dirty_fields());
+}
+
+// ============================================================================
+// COALESCING
+// ============================================================================
+
+static void test_shadow_coalescing_window(void)
+{
+    ShadowSync sync;
+    char doc[256];
+    sync.update(reading(230000, 5000, 1000), 0);
+    (void)sync.build_patch(doc, sizeof(doc), ShadowFormat::AzureTwin, 0);
+    sync.on_accepted(0);
+
+    // Twelve readings in one window: one patch with the latest values
+    for (uint32_t i = 1; i <= 12; ++i) {
+        sync.update(reading(230000, 5000 + i * 200, 1000 + i * 20), 1000U + i * 5000U);
+        TEST_ASSERT_FALSE(sync.due(1000U + i * 5000U));
+    }
+    TEST_ASSERT_EQUAL_UINT32(11, sync.stats().coalesced);
+    TEST_ASSERT_TRUE(sync.due(6000 + WINDOW_MS));
+    (void)sync.build_patch(doc, sizeof(doc), ShadowFormat::AzureTwin, 6000 + WINDOW_MS);
+    TEST_ASSERT_EQUAL_STRING("{\"current_ma\":7400,\"energy_wh\":1240}", doc);
+    sync.on_accepted(0);
+
+    // A change that returns inside the band before the window closes is dropped
+    sync.update(reading(230000, 7400, 1300), 70000);
+    sync.update(reading(230000, 7400, 1240), 75000);
+    TEST_ASSERT_FALSE(sync.due(70000 + WINDOW_MS));
+
+    // Tamper is urgent: out at once, with whatever else is pending
+    ReportedState tampered = reading(230000, 7400, 1260);
+    tampered.tamper_detected = true;
+    sync.update(tampered, 80000);
+    TEST_ASSERT_TRUE(sync.due(80000));
+    (void)sync.build_patch(doc, sizeof(doc), ShadowFormat::AzureTwin, 80000);
+    TEST_ASSERT_EQUAL_STRING("{\"energy_wh\":1260,\"tamper_detected\":true}", doc);
+}
+
+// ============================================================================
+// VERSIONS
+// ============================================================================
+
+static void test_shadow_stale_delta(void)
+{
+    ShadowSync sync;
+    DesiredState desired;
+    desired.reading_interval_ms = 10000;
+
+    TEST_ASSERT_EQUAL(DeltaOutcome::Applied, sync.apply_delta(desired, 5));
+    TEST_ASSERT_EQUAL_UINT32(10000, sync.desired().reading_interval_ms);
+
+    // Replayed or reordered deltas do not roll the setting back
+    DesiredState older;
+    older.reading_interval_ms = 60000;
+    TEST_ASSERT_EQUAL(DeltaOutcome::Stale, sync.apply_delta(older, 4));
+    TEST_ASSERT_EQUAL(DeltaOutcome::Stale, sync.apply_delta(older, 5));
+    TEST_ASSERT_EQUAL_UINT32(10000, sync.desired().reading_interval_ms);
+    TEST_ASSERT_EQUAL_UINT32(2, sync.stats().stale_deltas);
+
+    desired.ota_requested = true;
+    TEST_ASSERT_EQUAL(DeltaOutcome::Applied, sync.apply_delta(desired, 7));
+    TEST_ASSERT_TRUE(sync.desired().ota_requested);
+    TEST_ASSERT_EQUAL_UINT32(7, sync.version());
+}
+
+static void test_shadow_aws_version_conflict(void)
+{
+    AwsIotConnector aws;
+    TEST_ASSERT_TRUE(aws.init(connector_config()).is_ok());
+    TEST_ASSERT_TRUE(aws.connect().is_ok());
+    ShadowSyncConfig config;
+    config.coalesce_ms = 0;
+    aws.configure_shadow_sync(config);
+
+    TEST_ASSERT_TRUE(aws.publish_telemetry(telemetry(230000, 1000, 0)).is_ok());
+    TEST_ASSERT_EQUAL_UINT32(1, aws.shadow().version);
+    TEST_ASSERT_EQUAL_UINT32(1, aws.shadow_sync().version());
+
+    // Desired changed in the cloud, delta not received yet
+    DeviceShadowState::Desired desired;
+    desired.reading_interval_ms = 30000;
+    aws.set_desired_state(desired);
+    TEST_ASSERT_EQUAL_UINT32(2, aws.shadow().version);
+
+    // The patch sent against version 1 is refused; the connector fetches
+    // the document, adopts its desired state and resends against version 2
+    TEST_ASSERT_TRUE(aws.publish_telemetry(telemetry(230000, 1050, 5000)).is_ok());
+    TEST_ASSERT_EQUAL_UINT32(1, aws.shadow_sync().stats().conflicts);
+    TEST_ASSERT_EQUAL_UINT32(1, aws.shadow_sync().stats().resyncs);
+    TEST_ASSERT_EQUAL_UINT32(30000, aws.shadow_sync().desired().reading_interval_ms);
+    TEST_ASSERT_EQUAL_UINT32(1050, aws.shadow().reported.energy_wh);
+    TEST_ASSERT_EQUAL_UINT32(3, aws.shadow().version);
+    TEST_ASSERT_EQUAL_STRING("{\"state\":{\"reported\":{\"energy_wh\":1050}},\"version\":2}",
+                             aws.last_shadow_update());
+
+    // The delta arriving late is stale by now
+    TEST_ASSERT_EQUAL(DeltaOutcome::Stale, aws.apply_desired_delta(desired, 2));
+
+    // Unchanged reading: no message at all
+    const uint32_t messages = aws.shadow_sync().stats().messages;
+    TEST_ASSERT_TRUE(aws.publish_telemetry(telemetry(230000, 1050, 10000)).is_ok());
+    TEST_ASSERT_EQUAL_UINT32(messages, aws.shadow_sync().stats().messages);
+    TEST_ASSERT_EQUAL_UINT32(3, aws.publish_count());
+}
+
+static void test_shadow_azure_twin_patch(void)
+{
+    AzureIotConnector azure;
+    TEST_ASSERT_TRUE(azure.init(connector_config()).is_ok());
+    TEST_ASSERT_TRUE(azure.connect().is_ok());
+
+    TEST_ASSERT_TRUE(azure.publish_telemetry(telemetry(230000, 1000, 0)).is_ok());
+    TEST_ASSERT_EQUAL_STRING("{\"voltage_mv\":230000,\"current_ma\":5000,\"energy_wh\":1000,"
+                             "\"temperature_c10\":250,\"tamper_detected\":false}",
+                             azure.last_twin_patch());
+
+    // Held in the window, sent by a flush once it closes
+    TEST_ASSERT_TRUE(azure.publish_telemetry(telemetry(230000, 1100, 5000)).is_ok());
+    TEST_ASSERT_EQUAL_UINT32(1000, azure.twin().reported.energy_wh);
+    TEST_ASSERT_TRUE(azure.flush_twin(5000 + WINDOW_MS).is_ok());
+    TEST_ASSERT_EQUAL_UINT32(1100, azure.twin().reported.energy_wh);
+    TEST_ASSERT_EQUAL_STRING("{\"energy_wh\":1100}", azure.last_twin_patch());
+
+    // Unversioned even if asked, since twin reported patches cannot be
+    ShadowSyncConfig versioned;
+    versioned.versioned = true;
+    azure.configure_twin_sync(versioned);
+    TEST_ASSERT_FALSE(azure.twin_sync().config().versioned);
+}
+
+// ============================================================================
+// FAILURES AND LEGACY
+// ============================================================================
+
+static void test_shadow_timeout_and_overflow(void)
+{
+    ShadowSync sync;
+    char doc[256];
+    sync.update(reading(230000, 5000, 1000), 0);
+
+    // Does not fit: nothing goes in flight
+    char tiny[32];
+    auto too_big = sync.build_patch(tiny, sizeof(tiny), ShadowFormat::AwsShadow, 0);
+    TEST_ASSERT_TRUE(too_big.is_error());
+    TEST_ASSERT_EQUAL(core::ErrorCode::CloudPayloadTooLarge, too_big.error().code);
+    TEST_ASSERT_FALSE(sync.in_flight());
+    TEST_ASSERT_EQUAL_UINT32(0, sync.stats().messages);
+
+    // Never acknowledged: after the timeout the same fields go again
+    (void)sync.build_patch(doc, sizeof(doc), ShadowFormat::AwsShadow, 0);
+    sync.poll(SHADOW_DEFAULT_ACK_TIMEOUT_MS - 1);
+    TEST_ASSERT_TRUE(sync.in_flight());
+    sync.poll(SHADOW_DEFAULT_ACK_TIMEOUT_MS);
+    TEST_ASSERT_FALSE(sync.in_flight());
+    TEST_ASSERT_EQUAL_UINT32(1, sync.stats().timeouts);
+    TEST_ASSERT_TRUE(sync.due(SHADOW_DEFAULT_ACK_TIMEOUT_MS)); // still the first report
+    (void)sync.build_patch(
+        doc, sizeof(doc), ShadowFormat::AwsShadow, SHADOW_DEFAULT_ACK_TIMEOUT_MS);
+    TEST_ASSERT_EQUAL_UINT8(SHADOW_ALL_FIELDS, sync.in_flight_fields());
+}
+
+static void test_shadow_legacy_full_document(void)
+{
+    ShadowSyncConfig config;
+    config.enabled = false;
+    ShadowSync sync(config);
+    char doc[256];
+
+    for (uint32_t i = 0; i < 3; ++i) {
+        sync.update(reading(230000, 5000, 1000), i * 5000U);
+        TEST_ASSERT_TRUE(sync.due(i * 5000U));
+        (void)sync.build_patch(doc, sizeof(doc), ShadowFormat::AzureTwin, i * 5000U);
+        sync.on_accepted(0);
+    }
+    TEST_ASSERT_EQUAL_UINT32(3, sync.stats().messages);
+    TEST_ASSERT_EQUAL_UINT32(3 * SHADOW_FIELD_COUNT, sync.stats().fields_sent);
+    TEST_ASSERT_FALSE(sync.due(20000)); // no new reading
+}
+
+// ============================================================================
+// TEST SUITE RUNNER
+// ============================================================================
+
+void test_shadow_sync_suite(void)
+{
+    RUN_TEST(test_shadow_first_report_then_patch);
+    RUN_TEST(test_shadow_deadband_drift);
+    RUN_TEST(test_shadow_coalescing_window);
+    RUN_TEST(test_shadow_stale_delta);
+    RUN_TEST(test_shadow_aws_version_conflict);
+    RUN_TEST(test_shadow_azure_twin_patch);
+    RUN_TEST(test_shadow_timeout_and_overflow);
+    RUN_TEST(test_shadow_legacy_full_document);
+}
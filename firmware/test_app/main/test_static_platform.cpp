@@ -0,0 +1,240 @@
+/**
+ * @file test_static_platform.cpp
+ * @brief Unit tests for compile-time platform binding and RMS sampling loops
+ */
+
+#include "hardware/sensor_manager.hpp"
+#include "hardware/sensors/acs712.hpp"
+#include "hardware/sensors/zmpt101b.hpp"
+#include "platform/mock_platform.hpp"
+#include "platform/static_platform.hpp"
+#include "unity.h"
+
+#include <cstdio>
+
+using namespace gridshield;
+using namespace gridshield::hardware::sensors;
+using namespace gridshield::platform;
+using namespace gridshield::platform::mock;
+
+// ============================================================================
+// Helpers
+// ============================================================================
+
+/// Final ADC producing a square wave of ±amplitude around a bias (exact RMS).
+class SquareWaveADC final : public IPlatformADC
+{
+public:
+    SquareWaveADC(uint32_t bias_mv, uint32_t amplitude_mv) noexcept
+        : bias_mv_(bias_mv), amplitude_mv_(amplitude_mv)
+    {}
+
+    core::Result<void> init(uint8_t /*channel*/, Attenuation /*atten*/) noexcept override
+    {
+        return core::Result<void>{};
+    }
+    core::Result<uint32_t> read_raw(uint8_t channel) noexcept override
+    {
+        return read_mv(channel);
+    }
+    core::Result<uint32_t> read_mv(uint8_t /*channel*/) noexcept override
+    {
+        phase_ = !phase_;
+        ++reads_;
+        return core::Result<uint32_t>(phase_ ? bias_mv_ + amplitude_mv_ : bias_mv_ - amplitude_mv_);
+    }
+
+    uint32_t reads_{0};
+
+private:
+    uint32_t bias_mv_;
+    uint32_t amplitude_mv_;
+    bool phase_{false};
+};
+
+using MockStaticPlatform = StaticPlatform<MockTime, SquareWaveADC, MockCrypto>;
+
+// Concept-like checks
+static_assert(is_adc_provider_v<IPlatformADC>, "interface satisfies its own contract");
+static_assert(is_adc_provider_v<SquareWaveADC>, "concrete ADC satisfies the contract");
+static_assert(!is_adc_provider_v<MockTime>, "a clock is not an ADC");
+static_assert(is_time_provider_v<MockTime>, "MockTime satisfies the time contract");
+static_assert(is_crypto_provider_v<MockCrypto>, "MockCrypto satisfies the crypto contract");
+static_assert(!VirtualPlatform::is_static, "interfaces dispatch virtually");
+static_assert(std::is_same<DefaultPlatform, VirtualPlatform>::value,
+              "test builds keep the virtual mock path");
+
+// ============================================================================
+// RMS sampling
+// ============================================================================
+
+static void test_isqrt_exact_and_floor(void)
+{
+    TEST_ASSERT_EQUAL_UINT32(0, utils::isqrt_u64(0));
+    TEST_ASSERT_EQUAL_UINT32(1, utils::isqrt_u64(3));
+    TEST_ASSERT_EQUAL_UINT32(12, utils::isqrt_u64(168));
+    TEST_ASSERT_EQUAL_UINT32(13, utils::isqrt_u64(169));
+    TEST_ASSERT_EQUAL_UINT32(0xFFFFFFFFU, utils::isqrt_u64(0xFFFFFFFE00000001ULL));
+}
+
+static void test_sample_rms_square_wave(void)
+{
+    SquareWaveADC adc(2500, 300);
+    auto rms = sample_rms_mv(adc, 0, 2500, 100);
+    TEST_ASSERT_TRUE(rms.is_ok());
+    TEST_ASSERT_EQUAL_UINT32(300, rms.value());
+    TEST_ASSERT_EQUAL_UINT32(100, adc.reads_);
+
+    TEST_ASSERT_TRUE(sample_rms_mv(adc, 0, 2500, 0).is_error());
+}
+
+static void test_sample_rms_propagates_adc_error(void)
+{
+    MockADC adc; // channel never initialised: every read fails
+    auto rms = sample_rms_mv(adc, 3, 0, 10);
+    TEST_ASSERT_TRUE(rms.is_error());
+    TEST_ASSERT_EQUAL(core::ErrorCode::ADCReadError, rms.error().code);
+}
+
+static void test_acs712_rms_static_matches_virtual(void)
+{
+    ACS712Config config{};
+    config.variant = ACS712Variant::ACS712_20A; // 100 mV/A
+
+    SquareWaveADC adc_virtual(ACS712_ZERO_CURRENT_MV, 500);
+    ACS712Driver virtual_driver;
+    virtual_driver.init(adc_virtual, config);
+
+    SquareWaveADC adc_static(ACS712_ZERO_CURRENT_MV, 500);
+    ACS712DriverT<SquareWaveADC> static_driver;
+    static_driver.init(adc_static, config);
+
+    auto a = virtual_driver.read_current_rms_ma();
+    auto b = static_driver.read_current_rms_ma();
+    TEST_ASSERT_TRUE(a.is_ok() && b.is_ok());
+    TEST_ASSERT_EQUAL_UINT32(5000, a.value()); // 500 mV / 100 mV/A
+    TEST_ASSERT_EQUAL_UINT32(a.value(), b.value());
+}
+
+static void test_zmpt101b_rms_applies_ratio(void)
+{
+    ZMPT101BConfig config{};
+    config.voltage_ratio = 2000; // x2
+
+    SquareWaveADC adc(ZMPT101B_ZERO_POINT_MV, 400);
+    ZMPT101BDriverT<SquareWaveADC> driver;
+    TEST_ASSERT_TRUE(driver.init(adc, config).is_ok());
+
+    auto rms = driver.read_voltage_rms_mv();
+    TEST_ASSERT_TRUE(rms.is_ok());
+    TEST_ASSERT_EQUAL_UINT32(800, rms.value());
+    TEST_ASSERT_EQUAL_UINT32(ZMPT101B_SAMPLES_PER_READ, adc.reads_);
+}
+
+static void test_sensor_manager_static_binding(void)
+{
+    MockTime time;
+    SquareWaveADC adc(ACS712_ZERO_CURRENT_MV, 0);
+    MockCrypto crypto;
+    StaticPlatformServices<MockStaticPlatform> services(time, adc, crypto);
+
+    hardware::SensorManagerConfig config{};
+    config.enable_acs712 = true;
+
+    hardware::SensorManagerT<MockStaticPlatform> manager;
+    TEST_ASSERT_TRUE(manager.initialize(services, config).is_ok());
+    auto data = manager.read_all();
+    TEST_ASSERT_TRUE(data.is_ok());
+    TEST_ASSERT_EQUAL_UINT32(0, data.value().current_ma);
+    TEST_ASSERT_EQUAL_UINT32(1, adc.reads_);
+}
+
+static void test_sensor_manager_rejects_unbound_adc(void)
+{
+    MockTime time;
+    SquareWaveADC adc(ACS712_ZERO_CURRENT_MV, 0);
+    MockCrypto crypto;
+    StaticPlatformServices<MockStaticPlatform> services(time, adc, crypto);
+
+    hardware::SensorManagerConfig config{};
+    config.enable_acs712 = true;
+
+    // Reassigned after construction: not the registered object
+    MockADC other;
+    services.adc = &other;
+    hardware::SensorManagerT<MockStaticPlatform> manager;
+    auto result = manager.initialize(services, config);
+    TEST_ASSERT_TRUE(result.is_error());
+    TEST_ASSERT_EQUAL(core::ErrorCode::InvalidParameter, result.error().code);
+    TEST_ASSERT_FALSE(manager.is_initialized());
+
+    // Plain services never registered a SquareWaveADC
+    SquareWaveADC stray(ACS712_ZERO_CURRENT_MV, 0);
+    PlatformServices plain;
+    plain.adc = &stray;
+    TEST_ASSERT_TRUE(manager.initialize(plain, config).is_error());
+    TEST_ASSERT_EQUAL_UINT32(0, stray.reads_);
+
+    // The virtual policy accepts any implementation
+    hardware::SensorManager virtual_manager;
+    TEST_ASSERT_TRUE(virtual_manager.initialize(plain, config).is_ok());
+}
+
+// ============================================================================
+// Per-sample cost: virtual vs statically bound
+// ============================================================================
+
+static constexpr uint32_t BENCH_READS = 200;
+static volatile uint32_t g_bench_sink = 0;
+
+template <typename Driver> static uint64_t bench_driver(Driver& driver, MockTime& time)
+{
+    const uint64_t start = time.get_timestamp_us();
+    for (uint32_t i = 0; i < BENCH_READS; ++i) {
+        auto rms = driver.read_voltage_rms_mv();
+        g_bench_sink = g_bench_sink + rms.value();
+    }
+    return time.get_timestamp_us() - start;
+}
+
+static void test_static_binding_per_sample_cost(void)
+{
+    MockTime time;
+    ZMPT101BConfig config{};
+
+    SquareWaveADC adc_virtual(ZMPT101B_ZERO_POINT_MV, 311);
+    IPlatformADC& iface = adc_virtual;
+    ZMPT101BDriver virtual_driver;
+    virtual_driver.init(iface, config);
+
+    SquareWaveADC adc_static(ZMPT101B_ZERO_POINT_MV, 311);
+    ZMPT101BDriverT<SquareWaveADC> static_driver;
+    static_driver.init(adc_static, config);
+
+    const uint64_t virtual_us = bench_driver(virtual_driver, time);
+    const uint64_t static_us = bench_driver(static_driver, time);
+    TEST_ASSERT_EQUAL_UINT32(adc_virtual.reads_, adc_static.reads_);
+
+    const double samples = static_cast<double>(BENCH_READS) * ZMPT101B_SAMPLES_PER_READ;
+    printf("  [hal] ns/sample: virtual=%.2f static=%.2f (%u x %u samples)\n",
+           static_cast<double>(virtual_us) * 1000.0 / samples,
+           static_cast<double>(static_us) * 1000.0 / samples,
+           static_cast<unsigned>(BENCH_READS),
+           static_cast<unsigned>(ZMPT101B_SAMPLES_PER_READ));
+}
+
+// ============================================================================
+// Suite Registration
+// ============================================================================
+
+void test_static_platform_suite(void)
+{
+    RUN_TEST(test_isqrt_exact_and_floor);
+    RUN_TEST(test_sample_rms_square_wave);
+    RUN_TEST(test_sample_rms_propagates_adc_error);
+    RUN_TEST(test_acs712_rms_static_matches_virtual);
+    RUN_TEST(test_zmpt101b_rms_applies_ratio);
+    RUN_TEST(test_sensor_manager_static_binding);
+    RUN_TEST(test_sensor_manager_rejects_unbound_adc);
+    RUN_TEST(test_static_binding_per_sample_cost);
+}
@@ -0,0 +1,492 @@
+/**
+ * @file test_three_phase.cpp
+ * @brief Unit tests for three-phase metering (sampler, phase rules, send path)
+ *
+ * A simulated grid drives an ADC whose clock advances per read, so the
+ * sampler sees the same inter-channel skew as a multiplexed SAR ADC.
+ * Covers RMS/power/frequency accuracy, skew correction of phase angles,
+ * phase sequence, neutral residual, energy integration, the compact record
+ * and each phase rule.
+ */
+
+#include "unity.h"
+
+#include "analytics/phase_rules.hpp"
+#include "core/system.hpp"
+#include "hardware/sensors/three_phase.hpp"
+#include "platform/mock_platform.hpp"
+#include "platform/sim_clock.hpp"
+
+#include <cmath>
+#include <cstdint>
+
+using namespace gridshield;
+using namespace gridshield::hardware::sensors;
+
+namespace {
+
+static constexpr double PI = 3.14159265358979323846;
+static constexpr uint8_t NEUTRAL_CH = 6;
+
+/// Sinusoidal three-phase supply seen through ZMPT101B/ACS712 front ends.
+struct SimGrid
+{
+    double frequency_hz{50.0};
+    double voltage_sensor_rms_mv{920.0}; // x250 ratio -> 230 V
+    double current_a[3]{10.0, 10.0, 10.0};
+    double lag_deg[3]{0.0, 0.0, 0.0};     // current behind voltage
+    double ct_scale[3]{1.0, 1.0, 1.0};    // 0 = load bypasses the phase CT
+    double ct_sign[3]{1.0, 1.0, 1.0};     // -1 = reversed CT
+    bool acb{false};
+};
+
+class SimThreePhaseAdc final : public platform::IPlatformADC
+{
+public:
+    SimThreePhaseAdc(platform::sim::SimClock& clock, const SimGrid& grid) noexcept
+        : clock_(clock), grid_(grid)
+    {}
+
+    core::Result<void> init(uint8_t channel, Attenuation /*atten*/) noexcept override
+    {
+        if (channel > NEUTRAL_CH) {
+            return GS_MAKE_ERROR(core::ErrorCode::InvalidParameter);
+        }
+        return core::Result<void>{};
+    }
+
+    core::Result<uint32_t> read_raw(uint8_t channel) noexcept override
+    {
+        return read_mv(channel);
+    }
+
+    core::Result<uint32_t> read_mv(uint8_t channel) noexcept override
+    {
+        if (channel == fail_channel_) {
+            return core::Result<uint32_t>{GS_MAKE_ERROR(core::ErrorCode::ADCReadError)};
+        }
+        const double t = static_cast<double>(clock_.get_timestamp_us()) * 1e-6;
+        clock_.advance_us(read_us_);
+
+        double value = 0.0;
+        if (channel == NEUTRAL_CH) {
+            for (size_t p = 0; p < 3; ++p) {
+                value += load_current(p, t); // all load current returns on the neutral
+            }
+            value *= 100.0; // 100 mV/A
+        } else {
+            const size_t p = channel / 2;
+            value = (channel % 2 == 0) ? voltage(p, t)
+                                       : 100.0 * grid_.ct_scale[p] * grid_.ct_sign[p] *
+                                             load_current(p, t);
+        }
+        return core::Result<uint32_t>{static_cast<uint32_t>(std::lround(2500.0 + value))};
+    }
+
+    void set_read_us(uint64_t us) noexcept
+    {
+        read_us_ = us;
+    }
+    void fail_on(uint8_t channel) noexcept
+    {
+        fail_channel_ = channel;
+    }
+
+private:
+    double phase_offset(size_t p) const noexcept
+    {
+        const double step = (grid_.acb ? 120.0 : -120.0) * static_cast<double>(p);
+        return step * PI / 180.0;
+    }
+
+    double voltage(size_t p, double t) const noexcept
+    {
+        return grid_.voltage_sensor_rms_mv * std::sqrt(2.0) *
+               std::sin(2.0 * PI * grid_.frequency_hz * t + phase_offset(p));
+    }
+
+    double load_current(size_t p, double t) const noexcept
+    {
+        return grid_.current_a[p] * std::sqrt(2.0) *
+               std::sin(2.0 * PI * grid_.frequency_hz * t + phase_offset(p) -
+                        grid_.lag_deg[p] * PI / 180.0);
+    }
+
+    platform::sim::SimClock& clock_;
+    const SimGrid& grid_;
+    uint64_t read_us_{20};
+    uint8_t fail_channel_{0xFF};
+};
+
+ThreePhaseConfig make_config(bool neutral = false)
+{
+    ThreePhaseConfig config;
+    config.voltage_ratio = 250000; // 920 mV sensor RMS -> 230 V
+    config.rounds = 512;           // 512 x 7 x 20 us = 72 ms, > 3 cycles
+    if (neutral) {
+        config.neutral_channel = NEUTRAL_CH;
+    }
+    return config;
+}
+
+using Sampler = ThreePhaseSamplerT<platform::IPlatformADC, platform::IPlatformTime>;
+
+ThreePhaseMeasurement measure(const SimGrid& grid,
+                              const ThreePhaseConfig& config,
+                              uint64_t read_us = 20)
+{
+    platform::sim::SimClock clock;
+    clock.advance_us(1234); // arbitrary start phase
+    SimThreePhaseAdc adc(clock, grid);
+    adc.set_read_us(read_us);
+    Sampler sampler;
+    TEST_ASSERT_TRUE(sampler.init(adc, clock, config).is_ok());
+    auto result = sampler.sample();
+    TEST_ASSERT_TRUE(result.is_ok());
+    return result.value();
+}
+
+bool within_permille(int64_t actual, int64_t expected, int64_t permille)
+{
+    const int64_t diff = actual > expected ? actual - expected : expected - actual;
+    const int64_t mag = expected >= 0 ? expected : -expected;
+    return diff * 1000 <= mag * permille;
+}
+
+core::ThreePhaseReading balanced_reading(uint16_t current_ca = 1000)
+{
+    core::ThreePhaseReading reading;
+    for (auto& phase : reading.phases) {
+        phase.voltage_dv = 2300;
+        phase.current_ca = current_ca;
+        phase.power_w = 23 * current_ca / 10;
+    }
+    reading.total_power_w = 3 * reading.phases[0].power_w;
+    reading.sequence = core::PhaseSequence::Abc;
+    reading.flags = static_cast<uint8_t>(0x7U << core::PHASE_FLAG_LIVE_SHIFT);
+    return reading;
+}
+
+} // namespace
+
+// ============================================================================
+// SAMPLER
+// ============================================================================
+
+void test_three_phase_balanced_measurement(void)
+{
+    SimGrid grid;
+    grid.lag_deg[0] = grid.lag_deg[1] = grid.lag_deg[2] = 30.0; // PF 0.866
+    const ThreePhaseMeasurement m = measure(grid, make_config());
+
+    const int64_t expected_mw = std::llround(230.0 * 10.0 * std::cos(PI / 6) * 1000.0);
+    for (size_t p = 0; p < 3; ++p) {
+        TEST_ASSERT_TRUE(within_permille(m.phases[p].voltage_mv, 230000, 5));
+        TEST_ASSERT_TRUE(within_permille(m.phases[p].current_ma, 10000, 5));
+        TEST_ASSERT_TRUE(within_permille(m.phases[p].power_mw, expected_mw, 10));
+        TEST_ASSERT_TRUE(m.phases[p].angle_deg10 == 0 || p != 0);
+    }
+    TEST_ASSERT_TRUE(within_permille(m.total_power_mw, 3 * expected_mw, 10));
+    TEST_ASSERT_INT32_WITHIN(5, 5000, m.frequency_chz);
+    TEST_ASSERT_TRUE(m.sequence == core::PhaseSequence::Abc);
+    TEST_ASSERT_EQUAL_UINT8(core::PHASE_FLAG_FREQ_VALID | (0x7U << core::PHASE_FLAG_LIVE_SHIFT),
+                            m.flags);
+    // Balanced: the vector sum (neutral) cancels, no unbalance
+    TEST_ASSERT_LESS_THAN(150U, m.neutral_ma);
+    TEST_ASSERT_LESS_THAN(5U, m.voltage_unbalance_permille);
+    TEST_ASSERT_LESS_THAN(5U, m.current_unbalance_permille);
+    // Whole cycles only: 2 cycles of 166.7 rounds (6 x 20 us) out of the 511
+    TEST_ASSERT_INT32_WITHIN(1, 333, m.samples);
+}
+
+void test_three_phase_skew_alignment(void)
+{
+    // 60 Hz on a slow mux: Vc is read 4 slots (200 us, 4.3 deg) after Va
+    SimGrid grid;
+    grid.frequency_hz = 60.0;
+    ThreePhaseConfig config = make_config();
+    config.rounds = 256;
+    const ThreePhaseMeasurement m = measure(grid, config, 50);
+    TEST_ASSERT_INT32_WITHIN(10, 1200, m.phases[1].angle_deg10);
+    TEST_ASSERT_INT32_WITHIN(10, 2400, m.phases[2].angle_deg10);
+    TEST_ASSERT_INT32_WITHIN(6, 6000, m.frequency_chz);
+    // Unity PF: V and I of a phase are a slot apart but the power stays exact
+    TEST_ASSERT_TRUE(within_permille(m.phases[2].power_mw, 2300000, 5));
+
+    grid.acb = true;
+    const ThreePhaseMeasurement swapped = measure(grid, config, 50);
+    TEST_ASSERT_TRUE(swapped.sequence == core::PhaseSequence::Acb);
+    TEST_ASSERT_INT32_WITHIN(10, 2400, swapped.phases[1].angle_deg10);
+}
+
+void test_three_phase_neutral_and_reverse(void)
+{
+    // Phase B load bypasses its CT but still returns through the neutral CT
+    SimGrid grid;
+    grid.ct_scale[1] = 0.0;
+    const ThreePhaseMeasurement m = measure(grid, make_config(true));
+    TEST_ASSERT_TRUE((m.flags & core::PHASE_FLAG_NEUTRAL_CT) != 0);
+    TEST_ASSERT_TRUE(within_permille(m.residual_ma, 10000, 10));
+    TEST_ASSERT_LESS_THAN(150U, m.neutral_ma); // balanced loads cancel in the neutral
+    TEST_ASSERT_LESS_THAN(100U, m.phases[1].current_ma);
+    TEST_ASSERT_GREATER_THAN(900U, m.current_unbalance_permille);
+
+    // A reversed CT shows as that phase exporting
+    SimGrid reversed;
+    reversed.ct_sign[2] = -1.0;
+    const ThreePhaseMeasurement r = measure(reversed, make_config(true));
+    TEST_ASSERT_TRUE(within_permille(r.phases[2].power_mw, -2300000, 10));
+    TEST_ASSERT_TRUE(within_permille(r.total_power_mw, 2300000, 20));
+    TEST_ASSERT_TRUE(within_permille(r.residual_ma, 20000, 10)); // In - (Ia + Ib - Ic)
+}
+
+void test_three_phase_energy_and_record(void)
+{
+    SimGrid grid; // 6.9 kW
+    platform::sim::SimClock clock;
+    SimThreePhaseAdc adc(clock, grid);
+    Sampler sampler;
+    TEST_ASSERT_TRUE(sampler.init(adc, clock, make_config()).is_ok());
+
+    // One window per second of wall time: 6.9 kW for 10 minutes = 1150 Wh
+    ThreePhaseMeasurement m;
+    for (int s = 0; s < 600; ++s) {
+        auto result = sampler.sample();
+        TEST_ASSERT_TRUE(result.is_ok());
+        m = result.value();
+        clock.advance_us(1000000 - 512 * 6 * 20);
+    }
+    TEST_ASSERT_INT32_WITHIN(10, 1150, static_cast<int32_t>(sampler.energy_wh()));
+
+    const core::ThreePhaseReading reading = Sampler::to_reading(m, 42, sampler.energy_wh());
+    TEST_ASSERT_TRUE(reading.timestamp == 42);
+    TEST_ASSERT_INT32_WITHIN(30, 6900, reading.total_power_w);
+    TEST_ASSERT_INT32_WITHIN(10, 2300, reading.phases[1].voltage_dv);
+    TEST_ASSERT_INT32_WITHIN(5, 1000, reading.phases[2].current_ca);
+    TEST_ASSERT_INT32_WITHIN(5, 5000, reading.frequency_chz);
+    TEST_ASSERT_TRUE(reading.sequence == core::PhaseSequence::Abc);
+    TEST_ASSERT_TRUE(reading.phase_live(0) && reading.phase_live(2));
+    TEST_ASSERT_EQUAL(56, sizeof(reading));
+}
+
+void test_three_phase_errors(void)
+{
+    SimGrid grid;
+    platform::sim::SimClock clock;
+    SimThreePhaseAdc adc(clock, grid);
+    Sampler sampler;
+    TEST_ASSERT_TRUE(sampler.sample().is_error());
+
+    ThreePhaseConfig bad = make_config();
+    bad.current_sensitivity_mv_per_a[1] = 0;
+    TEST_ASSERT_TRUE(sampler.init(adc, clock, bad).is_error());
+    bad = make_config();
+    bad.rounds = 2;
+    TEST_ASSERT_TRUE(sampler.init(adc, clock, bad).is_error());
+    bad = make_config();
+    bad.neutral_channel = 9; // init() of the channel fails
+    TEST_ASSERT_TRUE(sampler.init(adc, clock, bad).is_error());
+
+    TEST_ASSERT_TRUE(sampler.init(adc, clock, make_config()).is_ok());
+    adc.fail_on(3);
+    auto result = sampler.sample();
+    TEST_ASSERT_TRUE(result.is_error());
+    TEST_ASSERT_EQUAL(core::ErrorCode::ADCReadError, result.error().code);
+}
+
+// ============================================================================
+// PHASE RULES
+// ============================================================================
+
+void test_phase_rules_bypass(void)
+{
+    analytics::PhaseRules rules;
+    TEST_ASSERT_TRUE(rules.evaluate(balanced_reading()).is_error());
+    TEST_ASSERT_TRUE(rules.initialize(analytics::PhaseRulesConfig{}).is_ok());
+
+    for (int i = 0; i < 20; ++i) {
+        auto result = rules.evaluate(balanced_reading());
+        TEST_ASSERT_TRUE(result.is_ok());
+        TEST_ASSERT_TRUE(result.value().type == analytics::PhaseAnomalyType::None);
+    }
+    TEST_ASSERT_EQUAL_UINT32(1000, rules.baseline_current_ca(1));
+    TEST_ASSERT_TRUE(rules.learned_sequence() == core::PhaseSequence::Abc);
+
+    // Phase B collapses while A and C hold: reported after two readings
+    core::ThreePhaseReading bypass = balanced_reading();
+    bypass.phases[1].current_ca = 50;
+    bypass.phases[1].power_w = 115;
+    bypass.current_unbalance_permille = 300;
+    auto first = rules.evaluate(bypass);
+    TEST_ASSERT_TRUE(first.value().type == analytics::PhaseAnomalyType::None);
+    auto second = rules.evaluate(bypass);
+    TEST_ASSERT_TRUE(second.value().type == analytics::PhaseAnomalyType::CurrentBypass);
+    TEST_ASSERT_TRUE(second.value().severity == analytics::AnomalySeverity::High);
+    TEST_ASSERT_EQUAL_UINT8(1, second.value().phase);
+    TEST_ASSERT_EQUAL_UINT32(1000, second.value().expected_value);
+    // Not learned while it lasts
+    TEST_ASSERT_EQUAL_UINT32(1000, rules.baseline_current_ca(1));
+
+    // The whole premises switching off is not a bypass
+    TEST_ASSERT_TRUE(rules.initialize(analytics::PhaseRulesConfig{}).is_ok());
+    for (int i = 0; i < 5; ++i) {
+        (void)rules.evaluate(balanced_reading());
+    }
+    for (int i = 0; i < 3; ++i) {
+        auto result = rules.evaluate(balanced_reading(20));
+        TEST_ASSERT_TRUE(result.value().type == analytics::PhaseAnomalyType::None);
+    }
+}
+
+void test_phase_rules_priorities(void)
+{
+    analytics::PhaseRules rules;
+    TEST_ASSERT_TRUE(rules.initialize(analytics::PhaseRulesConfig{}).is_ok());
+    (void)rules.evaluate(balanced_reading());
+
+    // Residual in the neutral outranks the sequence change and imbalance
+    core::ThreePhaseReading reading = balanced_reading();
+    reading.flags |= core::PHASE_FLAG_NEUTRAL_CT;
+    reading.residual_ca = 400;
+    reading.sequence = core::PhaseSequence::Acb;
+    reading.current_unbalance_permille = 500;
+    (void)rules.evaluate(reading);
+    auto result = rules.evaluate(reading);
+    TEST_ASSERT_TRUE(result.value().type == analytics::PhaseAnomalyType::NeutralResidual);
+    TEST_ASSERT_TRUE(result.value().severity == analytics::AnomalySeverity::Critical);
+    TEST_ASSERT_EQUAL_UINT8(analytics::PHASE_ALL, result.value().phase);
+
+    reading = balanced_reading();
+    reading.sequence = core::PhaseSequence::Acb;
+    result = rules.evaluate(reading);
+    TEST_ASSERT_TRUE(result.value().type == analytics::PhaseAnomalyType::SequenceChange);
+    TEST_ASSERT_TRUE(result.value().severity == analytics::AnomalySeverity::Medium);
+
+    // Reversed CT on C: exporting phase against an importing total
+    reading = balanced_reading();
+    reading.phases[2].power_w = -2300;
+    reading.total_power_w = 2300;
+    (void)rules.evaluate(reading);
+    result = rules.evaluate(reading);
+    TEST_ASSERT_TRUE(result.value().type == analytics::PhaseAnomalyType::ReverseFlow);
+    TEST_ASSERT_EQUAL_UINT8(2, result.value().phase);
+
+    // Lost phase A
+    reading = balanced_reading();
+    reading.phases[0].voltage_dv = 30;
+    reading.phases[0].current_ca = 0;
+    reading.phases[0].power_w = 0;
+    reading.flags = static_cast<uint8_t>(0x6U << core::PHASE_FLAG_LIVE_SHIFT);
+    (void)rules.evaluate(reading);
+    result = rules.evaluate(reading);
+    TEST_ASSERT_TRUE(result.value().type == analytics::PhaseAnomalyType::PhaseLoss);
+    TEST_ASSERT_EQUAL_UINT8(0, result.value().phase);
+
+    analytics::PhaseRulesConfig bad;
+    bad.persistence = 0;
+    TEST_ASSERT_TRUE(rules.initialize(bad).is_error());
+}
+
+// ============================================================================
+// SYSTEM SEND PATH
+// ============================================================================
+
+void test_three_phase_system_send(void)
+{
+    platform::mock::MockTime time;
+    platform::mock::MockGPIO gpio;
+    platform::mock::MockInterrupt interrupt;
+    platform::mock::MockCrypto crypto;
+    platform::mock::MockComm comm;
+    platform::mock::MockStorage storage;
+    platform::PlatformServices services;
+    services.time = &time;
+    services.gpio = &gpio;
+    services.interrupt = &interrupt;
+    services.crypto = &crypto;
+    services.storage = &storage;
+    services.comm = &comm;
+    comm.set_connected(true);
+
+    GridShieldSystem system;
+    SystemConfig config;
+    config.meter_id = 0x3;
+    TEST_ASSERT_TRUE(system.send_three_phase_reading(balanced_reading()).is_error());
+    TEST_ASSERT_TRUE(system.initialize(config, services).is_ok());
+
+    const size_t before = comm.get_tx_buffer().size();
+    core::ThreePhaseReading reading = balanced_reading();
+    reading.energy_wh = 100;
+    TEST_ASSERT_TRUE(system.send_three_phase_reading(reading).is_ok());
+    TEST_ASSERT_GREATER_OR_EQUAL(before + sizeof(core::ThreePhaseReading),
+                                 comm.get_tx_buffer().size());
+    TEST_ASSERT_TRUE(system.phase_rules().learned_sequence() == core::PhaseSequence::Abc);
+    TEST_ASSERT_EQUAL_UINT32(1000, system.phase_rules().baseline_current_ca(0));
+}
+
+void test_three_phase_aggregate_unsaturated(void)
+{
+    // 600 A per phase: the summed 1800 A would pin a 16-bit mA field
+    const core::MeterReading total = GridShieldSystem::aggregate_reading(balanced_reading(60000));
+    TEST_ASSERT_EQUAL_UINT32(100, GridShieldSystem::AGGREGATE_CURRENT_UNIT_MA);
+    TEST_ASSERT_EQUAL_UINT16(18000, total.current_ma);
+    TEST_ASSERT_EQUAL_UINT32(230000, total.voltage_mv);
+
+    const core::MeterReading light = GridShieldSystem::aggregate_reading(balanced_reading(4));
+    TEST_ASSERT_EQUAL_UINT16(1, light.current_ma); // 120 mA rounds to one unit
+}
+
+void test_three_phase_system_main_loop(void)
+{
+    SimGrid grid;
+    platform::sim::SimClock clock;
+    SimThreePhaseAdc adc(clock, grid);
+    platform::mock::MockGPIO gpio;
+    platform::mock::MockInterrupt interrupt;
+    platform::mock::MockCrypto crypto;
+    platform::mock::MockComm comm;
+    platform::mock::MockStorage storage;
+    platform::PlatformServices services;
+    services.time = &clock;
+    services.adc = &adc;
+    services.gpio = &gpio;
+    services.interrupt = &interrupt;
+    services.crypto = &crypto;
+    services.storage = &storage;
+    services.comm = &comm;
+    comm.set_connected(true);
+
+    static GridShieldSystem system;
+    SystemConfig config;
+    config.meter_id = 0x3;
+    config.sensor_config.enable_three_phase = true;
+    config.sensor_config.three_phase_config = make_config();
+    TEST_ASSERT_TRUE(system.initialize(config, services).is_ok());
+    TEST_ASSERT_TRUE(system.start().is_ok());
+    TEST_ASSERT_TRUE(system.phase_rules().learned_sequence() == core::PhaseSequence::Unknown);
+
+    // process_cycle() samples the phases itself and sends the three-phase record
+    const size_t before = comm.get_tx_buffer().size();
+    clock.advance_us(uint64_t{config.reading_interval_ms} * 1000U);
+    TEST_ASSERT_TRUE(system.process_cycle().is_ok());
+    TEST_ASSERT_GREATER_OR_EQUAL(before + sizeof(core::ThreePhaseReading),
+                                 comm.get_tx_buffer().size());
+    TEST_ASSERT_TRUE(system.phase_rules().learned_sequence() == core::PhaseSequence::Abc);
+    TEST_ASSERT_TRUE(within_permille(system.phase_rules().baseline_current_ca(0), 1000, 20));
+
+    (void)system.shutdown();
+}
+
+void test_three_phase_suite(void)
+{
+    RUN_TEST(test_three_phase_balanced_measurement);
+    RUN_TEST(test_three_phase_skew_alignment);
+    RUN_TEST(test_three_phase_neutral_and_reverse);
+    RUN_TEST(test_three_phase_energy_and_record);
+    RUN_TEST(test_three_phase_errors);
+    RUN_TEST(test_phase_rules_bypass);
+    RUN_TEST(test_phase_rules_priorities);
+    RUN_TEST(test_three_phase_system_send);
+    RUN_TEST(test_three_phase_aggregate_unsaturated);
+    RUN_TEST(test_three_phase_system_main_loop);
+}
@@ -0,0 +1,494 @@
+/**
+ * @file test_transport_manager.cpp
+ * @brief Unit tests for multi-link routing, failover and recovery probing
+ *
+ * Covers the EWMA link estimator, per-class link selection (fastest for
+ * alerts, cheapest within budget for telemetry, MTU for evidence), failover
+ * inside one send, down-marking and backoff probing, Network health
+ * reporting, adapter size limits, the comm channel views (reply link,
+ * ack feedback) and the ESP-NOW adapter.
+ */
+
+#include "unity.h"
+
+#include "core/degradation.hpp"
+#include "network/comm_links.hpp"
+#include "network/transport_manager.hpp"
+#include "platform/mock_platform.hpp"
+#include "platform/sim_clock.hpp"
+
+#include <cstdint>
+#include <cstring>
+
+using namespace gridshield;
+using namespace gridshield::network;
+
+namespace {
+
+/// Uplink whose send takes @c delay_ms of simulated time and can be broken.
+class ScriptedLink final : public platform::IPlatformComm
+{
+public:
+    explicit ScriptedLink(platform::sim::SimClock& clock, uint32_t delay_ms = 0) noexcept
+        : clock_(clock), delay_ms_(delay_ms)
+    {}
+
+    core::Result<void> init() noexcept override
+    {
+        return core::Result<void>{};
+    }
+    core::Result<void> shutdown() noexcept override
+    {
+        return core::Result<void>{};
+    }
+    core::Result<size_t> send(const uint8_t* /*data*/, size_t length) noexcept override
+    {
+        ++attempts;
+        clock_.delay_ms(delay_ms_);
+        if (max_length != 0 && length > max_length) {
+            return core::Result<size_t>(GS_MAKE_ERROR(core::ErrorCode::InvalidParameter));
+        }
+        if (failing) {
+            return core::Result<size_t>(GS_MAKE_ERROR(core::ErrorCode::TransmissionFailed));
+        }
+        last_length = length;
+        return core::Result<size_t>(length);
+    }
+    core::Result<size_t>
+    receive(uint8_t* /*buffer*/, size_t /*max_length*/, uint32_t /*timeout_ms*/) noexcept override
+    {
+        ++receives;
+        return core::Result<size_t>(GS_MAKE_ERROR(core::ErrorCode::NetworkTimeout));
+    }
+    bool is_connected() noexcept override
+    {
+        return connected;
+    }
+
+    bool failing{false};
+    bool connected{true};
+    size_t max_length{0}; // adapter limit unknown to LinkConfig; 0 = none
+    uint32_t attempts{0};
+    uint32_t receives{0};
+    size_t last_length{0};
+
+private:
+    platform::sim::SimClock& clock_;
+    uint32_t delay_ms_;
+};
+
+LinkConfig link_config(uint16_t mtu, uint8_t cost, uint32_t rtt_ms, uint32_t bytes_per_s)
+{
+    LinkConfig config;
+    config.mtu = mtu;
+    config.cost = cost;
+    config.nominal_rtt_ms = rtt_ms;
+    config.nominal_bytes_per_s = bytes_per_s;
+    return config;
+}
+
+uint8_t send_ok(TransportManager& manager, TrafficClass cls, size_t length)
+{
+    static uint8_t payload[4096];
+    auto result = manager.send(cls, payload, length);
+    TEST_ASSERT_TRUE(result.is_ok());
+    return result.is_ok() ? result.value() : 0xFF;
+}
+
+} // namespace
+
+// ============================================================================
+// ESTIMATOR
+// ============================================================================
+
+static void test_transport_estimator(void)
+{
+    LinkEstimator est;
+    est.reset(link_config(0, 1, 200, 10000), analytics::ema_alpha_for_half_life(4));
+    TEST_ASSERT_EQUAL_UINT32(200, est.rtt_ms());
+    TEST_ASSERT_EQUAL_UINT32(10000, est.bytes_per_s());
+    TEST_ASSERT_EQUAL_UINT32(0, est.loss_permille());
+
+    // First sample replaces the prior, later ones move part of the way
+    est.record_rtt(40000);
+    TEST_ASSERT_EQUAL_UINT32(40, est.rtt_ms());
+    est.record_rtt(140000);
+    TEST_ASSERT_GREATER_THAN(40, est.rtt_ms());
+    TEST_ASSERT_LESS_THAN(90, est.rtt_ms());
+
+    est.record_throughput(1000, 0); // no duration, no sample
+    TEST_ASSERT_EQUAL_UINT32(10000, est.bytes_per_s());
+    est.record_throughput(1000, 500000);
+    TEST_ASSERT_EQUAL_UINT32(2000, est.bytes_per_s());
+
+    const uint64_t clean_us = est.expected_delivery_us(1000);
+    for (int i = 0; i < 4; ++i) {
+        est.record_loss();
+    }
+    TEST_ASSERT_INT32_WITHIN(5, 500, static_cast<int32_t>(est.loss_permille()));
+    TEST_ASSERT_INT32_WITHIN(20,
+                             static_cast<int32_t>(clean_us * 2 / 1000),
+                             static_cast<int32_t>(est.expected_delivery_us(1000) / 1000));
+    est.record_delivery();
+    TEST_ASSERT_LESS_THAN(500, est.loss_permille());
+    est.clear_loss();
+    TEST_ASSERT_EQUAL_UINT32(0, est.loss_permille());
+}
+
+// ============================================================================
+// ROUTING
+// ============================================================================
+
+static void test_transport_routes_by_class(void)
+{
+    platform::sim::SimClock clock;
+    ScriptedLink wifi(clock);
+    ScriptedLink cellular(clock);
+    ScriptedLink lora(clock);
+    TransportManager manager(clock);
+    const uint8_t w = manager.add_link(wifi, link_config(0, 3, 40, 200000)).value();
+    const uint8_t c = manager.add_link(cellular, link_config(1400, 10, 300, 50000)).value();
+    const uint8_t l = manager.add_link(lora, link_config(255, 1, 1900, 300)).value();
+    TEST_ASSERT_EQUAL_UINT8(3, manager.link_count());
+
+    // Alerts take the fastest link, telemetry the cheapest inside 30 s
+    TEST_ASSERT_EQUAL_UINT8(w, send_ok(manager, TrafficClass::TamperAlert, 64));
+    TEST_ASSERT_EQUAL_UINT8(l, send_ok(manager, TrafficClass::Telemetry, 100));
+    // Too big for LoRa's MTU: next cheapest
+    TEST_ASSERT_EQUAL_UINT8(w, send_ok(manager, TrafficClass::Telemetry, 600));
+    // Evidence: only the unlimited-MTU link fits
+    TEST_ASSERT_EQUAL_UINT8(w, send_ok(manager, TrafficClass::Evidence, 4000));
+
+    // Alert over 2 s on LoRa: with WiFi and cellular gone it is still sent
+    wifi.connected = false;
+    cellular.connected = false;
+    TEST_ASSERT_EQUAL_UINT8(l, send_ok(manager, TrafficClass::TamperAlert, 64));
+    TEST_ASSERT_EQUAL(LinkState::Down, manager.link_state(w));
+    TEST_ASSERT_EQUAL(LinkState::Down, manager.link_state(c));
+    TEST_ASSERT_EQUAL_UINT32(0, manager.stats().undeliverable);
+}
+
+static void test_transport_class_mask_and_errors(void)
+{
+    platform::sim::SimClock clock;
+    ScriptedLink wifi(clock);
+    ScriptedLink lora(clock);
+    TransportManager manager(clock);
+    LinkConfig wifi_config = link_config(0, 1, 40, 200000);
+    wifi_config.classes = traffic_class_bit(TrafficClass::Telemetry);
+    (void)manager.add_link(wifi, wifi_config);
+    (void)manager.add_link(lora, link_config(255, 1, 1500, 300));
+
+    // Evidence is barred from WiFi and too large for LoRa
+    uint8_t data[1024]{};
+    auto none = manager.send(TrafficClass::Evidence, data, sizeof(data));
+    TEST_ASSERT_TRUE(none.is_error());
+    TEST_ASSERT_EQUAL(core::ErrorCode::NetworkDisconnected, none.error().code);
+    TEST_ASSERT_TRUE(manager.is_available(TrafficClass::TamperAlert));
+
+    // Every eligible link failing
+    wifi.failing = true;
+    lora.failing = true;
+    auto failed = manager.send(TrafficClass::Telemetry, data, 32);
+    TEST_ASSERT_TRUE(failed.is_error());
+    TEST_ASSERT_EQUAL(core::ErrorCode::TransmissionFailed, failed.error().code);
+    TEST_ASSERT_EQUAL_UINT32(1, wifi.attempts);
+    TEST_ASSERT_EQUAL_UINT32(1, lora.attempts);
+    TEST_ASSERT_EQUAL_UINT32(2, manager.stats().undeliverable);
+
+    TEST_ASSERT_TRUE(manager.send(TrafficClass::Telemetry, nullptr, 4).is_error());
+    TEST_ASSERT_TRUE(manager.send(TrafficClass::Telemetry, data, 0).is_error());
+
+    ScriptedLink extra(clock);
+    (void)manager.add_link(extra, LinkConfig{});
+    (void)manager.add_link(extra, LinkConfig{});
+    auto full = manager.add_link(extra, LinkConfig{});
+    TEST_ASSERT_TRUE(full.is_error());
+    TEST_ASSERT_EQUAL(core::ErrorCode::ResourceExhausted, full.error().code);
+}
+
+// ============================================================================
+// FAILOVER AND RECOVERY
+// ============================================================================
+
+static void test_transport_failover_in_one_send(void)
+{
+    platform::sim::SimClock clock;
+    ScriptedLink wifi(clock, 20);
+    ScriptedLink cellular(clock, 150);
+    TransportConfig config;
+    config.down_after_failures = 2;
+    TransportManager manager(clock, config);
+    LinkConfig wifi_config = link_config(0, 1, 40, 200000);
+    wifi_config.send_is_round_trip = true;
+    LinkConfig cell_config = link_config(0, 5, 300, 50000);
+    cell_config.send_is_round_trip = true;
+    const uint8_t w = manager.add_link(wifi, wifi_config).value();
+    const uint8_t c = manager.add_link(cellular, cell_config).value();
+
+    TEST_ASSERT_EQUAL_UINT8(w, send_ok(manager, TrafficClass::TamperAlert, 64));
+    TEST_ASSERT_EQUAL_UINT32(20, manager.estimator(w).rtt_ms());
+
+    // Primary breaks: the same call lands on cellular
+    wifi.failing = true;
+    TEST_ASSERT_EQUAL_UINT8(c, send_ok(manager, TrafficClass::TamperAlert, 64));
+    TEST_ASSERT_EQUAL_UINT32(1, manager.stats().failovers);
+    TEST_ASSERT_EQUAL(LinkState::Up, manager.link_state(w));
+    TEST_ASSERT_EQUAL_UINT32(150, manager.estimator(c).rtt_ms());
+
+    // Second consecutive failure takes WiFi down; then it is skipped
+    TEST_ASSERT_EQUAL_UINT8(c, send_ok(manager, TrafficClass::TamperAlert, 64));
+    TEST_ASSERT_EQUAL(LinkState::Down, manager.link_state(w));
+    const uint32_t attempts = wifi.attempts;
+    TEST_ASSERT_EQUAL_UINT8(c, send_ok(manager, TrafficClass::TamperAlert, 64));
+    TEST_ASSERT_EQUAL_UINT32(attempts, wifi.attempts);
+    TEST_ASSERT_EQUAL_UINT32(2, manager.link_stats(w).failed);
+    TEST_ASSERT_EQUAL_UINT32(4, manager.stats().delivered);
+
+    // Acknowledgement timeouts count as failures too
+    manager.record_timeout(c);
+    manager.record_timeout(c);
+    TEST_ASSERT_EQUAL(LinkState::Down, manager.link_state(c));
+    TEST_ASSERT_FALSE(manager.is_available(TrafficClass::TamperAlert));
+}
+
+static void test_transport_probe_recovery(void)
+{
+    platform::sim::SimClock clock;
+    ScriptedLink wifi(clock);
+    ScriptedLink lora(clock);
+    TransportConfig config;
+    config.down_after_failures = 1;
+    config.probe_base_ms = 1000;
+    config.probe_max_ms = 4000;
+    TransportManager manager(clock, config);
+    core::DegradationManager degradation;
+    const uint8_t w = manager.add_link(wifi, link_config(0, 1, 40, 200000)).value();
+    const uint8_t l = manager.add_link(lora, link_config(255, 2, 1500, 300)).value();
+    manager.set_degradation(&degradation);
+    const uint8_t probe[4] = {0xA5, 0x00, 0x00, 0x5A};
+    manager.set_probe_frame(probe, sizeof(probe));
+
+    wifi.failing = true;
+    TEST_ASSERT_EQUAL_UINT8(l, send_ok(manager, TrafficClass::TamperAlert, 32));
+    TEST_ASSERT_EQUAL(LinkState::Down, manager.link_state(w));
+    TEST_ASSERT_EQUAL(core::ServiceHealth::Degraded,
+                      degradation.get_health(core::ServiceId::Network));
+
+    // No probe before the backoff expires
+    clock.delay_ms(999);
+    manager.poll();
+    TEST_ASSERT_EQUAL_UINT32(0, manager.link_stats(w).probes);
+
+    // Failed probe doubles the backoff: next at +2 s
+    clock.delay_ms(1);
+    manager.poll();
+    TEST_ASSERT_EQUAL_UINT32(1, manager.link_stats(w).probes);
+    TEST_ASSERT_EQUAL(LinkState::Down, manager.link_state(w));
+    clock.delay_ms(1999);
+    manager.poll();
+    TEST_ASSERT_EQUAL_UINT32(1, manager.link_stats(w).probes);
+    clock.delay_ms(1);
+    manager.poll();
+    TEST_ASSERT_EQUAL_UINT32(2, manager.link_stats(w).probes);
+
+    // Capped at probe_max_ms
+    clock.delay_ms(4000);
+    manager.poll();
+    TEST_ASSERT_EQUAL_UINT32(3, manager.link_stats(w).probes);
+    clock.delay_ms(4000);
+    manager.poll();
+    TEST_ASSERT_EQUAL_UINT32(4, manager.link_stats(w).probes);
+
+    // Link returns: the probe frame goes out and routing moves back
+    wifi.failing = false;
+    clock.delay_ms(4000);
+    manager.poll();
+    TEST_ASSERT_EQUAL(LinkState::Up, manager.link_state(w));
+    TEST_ASSERT_EQUAL_UINT32(sizeof(probe), wifi.last_length);
+    TEST_ASSERT_EQUAL_UINT32(1, manager.link_stats(w).recoveries);
+    TEST_ASSERT_EQUAL_UINT32(0, manager.estimator(w).loss_permille());
+    TEST_ASSERT_EQUAL_UINT8(w, send_ok(manager, TrafficClass::TamperAlert, 32));
+    TEST_ASSERT_EQUAL(core::ServiceHealth::Healthy,
+                      degradation.get_health(core::ServiceId::Network));
+
+    // Both down: Network failed, reported once per outage
+    wifi.failing = true;
+    lora.failing = true;
+    uint8_t data[16]{};
+    TEST_ASSERT_TRUE(manager.send(TrafficClass::TamperAlert, data, sizeof(data)).is_error());
+    TEST_ASSERT_TRUE(manager.send(TrafficClass::TamperAlert, data, sizeof(data)).is_error());
+    TEST_ASSERT_EQUAL(core::ServiceHealth::Failed,
+                      degradation.get_health(core::ServiceId::Network));
+    TEST_ASSERT_EQUAL_UINT16(1, degradation.get_failure_count(core::ServiceId::Network));
+}
+
+// ============================================================================
+// CHANNELS AND ADAPTERS
+// ============================================================================
+
+static void test_transport_channels(void)
+{
+    platform::sim::SimClock clock;
+    ScriptedLink wifi(clock);
+    ScriptedLink lora(clock);
+    TransportManager manager(clock);
+    const uint8_t w = manager.add_link(wifi, link_config(0, 3, 40, 200000)).value();
+    const uint8_t l = manager.add_link(lora, link_config(255, 1, 1500, 300)).value();
+
+    platform::IPlatformComm& frames = manager.channel();
+    TEST_ASSERT_TRUE(frames.init().is_ok());
+    TEST_ASSERT_TRUE(frames.is_connected());
+
+    uint8_t frame[sizeof(PacketHeader) + 8]{};
+    PacketHeader header;
+    header.type = PacketType::MeterData;
+    std::memcpy(frame, &header, sizeof(header));
+    TEST_ASSERT_EQUAL(TrafficClass::Telemetry, classify_frame(frame, sizeof(frame)));
+    auto sent = frames.send(frame, sizeof(frame));
+    TEST_ASSERT_TRUE(sent.is_ok());
+    TEST_ASSERT_EQUAL_UINT32(1, manager.link_stats(l).sent);
+
+    header.type = PacketType::TamperAlert;
+    std::memcpy(frame, &header, sizeof(header));
+    TEST_ASSERT_EQUAL(TrafficClass::TamperAlert, classify_frame(frame, sizeof(frame)));
+    TEST_ASSERT_TRUE(frames.send(frame, sizeof(frame)).is_ok());
+    TEST_ASSERT_EQUAL_UINT32(1, manager.link_stats(w).sent);
+
+    header.type = PacketType::Heartbeat;
+    header.priority = core::Priority::Emergency;
+    std::memcpy(frame, &header, sizeof(header));
+    TEST_ASSERT_EQUAL(TrafficClass::TamperAlert, classify_frame(frame, sizeof(frame)));
+    TEST_ASSERT_EQUAL(TrafficClass::Telemetry, classify_frame(frame, 4)); // truncated
+
+    // Fixed-class view
+    TEST_ASSERT_TRUE(manager.channel(TrafficClass::Evidence).send(frame, sizeof(frame)).is_ok());
+    TEST_ASSERT_EQUAL_UINT32(2, manager.link_stats(w).sent);
+    uint8_t rx[8];
+    TEST_ASSERT_TRUE(manager.channel(TrafficClass::Evidence).receive(rx, sizeof(rx), 0).is_error());
+
+    // Feedback from the ack layer
+    manager.record_ack(w, 15);
+    TEST_ASSERT_EQUAL_UINT32(15, manager.estimator(w).rtt_ms());
+}
+
+static void test_transport_adapter_limit_is_not_loss(void)
+{
+    platform::sim::SimClock clock;
+    ScriptedLink wifi(clock);
+    ScriptedLink lora(clock);
+    lora.max_length = 64; // LinkConfig says nothing about it
+    TransportManager manager(clock);
+    const uint8_t w = manager.add_link(wifi, link_config(0, 3, 1500, 300)).value();
+    const uint8_t l = manager.add_link(lora, link_config(0, 1, 40, 200000)).value();
+
+    // Refused by the adapter: falls over without charging the link
+    for (int i = 0; i < 3; ++i) {
+        TEST_ASSERT_EQUAL_UINT8(w, send_ok(manager, TrafficClass::TamperAlert, 200));
+    }
+    TEST_ASSERT_EQUAL(LinkState::Up, manager.link_state(l));
+    TEST_ASSERT_EQUAL_UINT32(0, manager.link_stats(l).failed);
+    TEST_ASSERT_EQUAL_UINT32(0, manager.estimator(l).loss_permille());
+    TEST_ASSERT_EQUAL_UINT32(1, lora.attempts); // limit learned after the first refusal
+    TEST_ASSERT_EQUAL_UINT8(l, send_ok(manager, TrafficClass::TamperAlert, 64));
+}
+
+static void test_transport_frame_receive_follows_send(void)
+{
+    platform::sim::SimClock clock;
+    ScriptedLink wifi(clock);
+    ScriptedLink lora(clock);
+    TransportManager manager(clock);
+    const uint8_t w = manager.add_link(wifi, link_config(0, 3, 40, 200000)).value();
+    const uint8_t l = manager.add_link(lora, link_config(255, 1, 1500, 300)).value();
+    TransportChannel& frames = manager.channel();
+
+    uint8_t frame[sizeof(PacketHeader) + 8]{};
+    PacketHeader header;
+    header.type = PacketType::TamperAlert;
+    std::memcpy(frame, &header, sizeof(header));
+    TEST_ASSERT_TRUE(frames.send(frame, sizeof(frame)).is_ok());
+    TEST_ASSERT_EQUAL_UINT8(w, frames.last_link());
+    uint8_t rx[8];
+    (void)frames.receive(rx, sizeof(rx), 0);
+    TEST_ASSERT_EQUAL_UINT32(1, wifi.receives);
+
+    // The reply to an alert arrives where the alert went, not on the telemetry link
+    header.type = PacketType::MeterData;
+    std::memcpy(frame, &header, sizeof(header));
+    TEST_ASSERT_TRUE(frames.send(frame, sizeof(frame)).is_ok());
+    TEST_ASSERT_EQUAL_UINT8(l, frames.last_link());
+    (void)frames.receive(rx, sizeof(rx), 0);
+    TEST_ASSERT_EQUAL_UINT32(1, lora.receives);
+
+    // Ack-layer feedback lands on the link the frame went out on
+    IDeliveryFeedback& feedback = frames;
+    feedback.on_delivered(feedback.last_link(), 900);
+    TEST_ASSERT_EQUAL_UINT32(900, manager.estimator(l).rtt_ms());
+    feedback.on_lost(l);
+    feedback.on_lost(l);
+    TEST_ASSERT_EQUAL(LinkState::Down, manager.link_state(l));
+    TEST_ASSERT_EQUAL(LinkState::Up, manager.link_state(w));
+}
+
+static void test_transport_mesh_adapter(void)
+{
+    platform::sim::SimClock clock;
+    EspNowMesh mesh;
+    MeshConfig mesh_config;
+    TEST_ASSERT_TRUE(mesh.init(mesh_config).is_ok());
+    const std::array<uint8_t, MESH_MAC_LENGTH> gateway{{0x24, 0x6F, 0x28, 0x01, 0x02, 0x03}};
+    MeshCommLink mesh_link(mesh, gateway);
+    platform::mock::MockComm backhaul;
+    TEST_ASSERT_TRUE(backhaul.init().is_ok());
+
+    TransportManager manager(clock);
+    const uint8_t m = manager.add_link(mesh_link, link_config(MESH_MAX_PAYLOAD, 1, 30, 100000))
+                          .value();
+    const uint8_t b = manager.add_link(backhaul, link_config(0, 8, 200, 50000)).value();
+
+    // No peer yet: the mesh reports disconnected and is skipped
+    TEST_ASSERT_FALSE(mesh_link.is_connected());
+    TEST_ASSERT_EQUAL_UINT8(b, send_ok(manager, TrafficClass::Telemetry, 40));
+    TEST_ASSERT_EQUAL(LinkState::Down, manager.link_state(m));
+
+    TEST_ASSERT_TRUE(mesh.add_peer(gateway, false).is_ok());
+    clock.delay_ms(TRANSPORT_DEFAULT_PROBE_MS);
+    manager.poll();
+    TEST_ASSERT_EQUAL(LinkState::Up, manager.link_state(m));
+    TEST_ASSERT_EQUAL_UINT8(m, send_ok(manager, TrafficClass::Telemetry, 40));
+    TEST_ASSERT_EQUAL_UINT32(1, mesh.get_stats().tx_count);
+
+    // Radio error: failover to the backhaul in the same call
+    mesh.set_simulate_send_failure(true);
+    TEST_ASSERT_EQUAL_UINT8(b, send_ok(manager, TrafficClass::Telemetry, 40));
+    TEST_ASSERT_EQUAL_UINT32(2, manager.stats().failovers);
+
+    MeshPacket packet;
+    packet.header.payload_len = 3;
+    packet.payload[0] = 7;
+    mesh.inject_packet(packet);
+    uint8_t rx[8]{};
+    auto got = mesh_link.receive(rx, sizeof(rx), 0);
+    TEST_ASSERT_TRUE(got.is_ok());
+    TEST_ASSERT_EQUAL_UINT32(3, got.value());
+    TEST_ASSERT_EQUAL_UINT8(7, rx[0]);
+    TEST_ASSERT_TRUE(mesh_link.receive(rx, sizeof(rx), 0).is_error());
+}
+
+// ============================================================================
+// TEST SUITE RUNNER
+// ============================================================================
+
+void test_transport_manager_suite(void)
+{
+    RUN_TEST(test_transport_estimator);
+    RUN_TEST(test_transport_routes_by_class);
+    RUN_TEST(test_transport_class_mask_and_errors);
+    RUN_TEST(test_transport_failover_in_one_send);
+    RUN_TEST(test_transport_probe_recovery);
+    RUN_TEST(test_transport_channels);
+    RUN_TEST(test_transport_adapter_limit_is_not_loss);
+    RUN_TEST(test_transport_frame_receive_follows_send);
+    RUN_TEST(test_transport_mesh_adapter);
+}
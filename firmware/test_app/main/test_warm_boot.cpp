@@ -0,0 +1,291 @@
+/**
+ * @file test_warm_boot.cpp
+ * @brief Unit tests for warm-boot persistence (WarmBootStore, key reuse, boot timing)
+ */
+
+#include "analytics/time_series.hpp"
+#include "core/system.hpp"
+#include "core/warm_boot.hpp"
+#include "platform/mock_platform.hpp"
+#include "security/key_storage.hpp"
+#include "unity.h"
+
+using namespace gridshield;
+using namespace gridshield::platform;
+using namespace gridshield::platform::mock;
+
+// ============================================================================
+// Helpers
+// ============================================================================
+
+struct WarmBootFixture
+{
+    MockTime time;
+    MockGPIO gpio;
+    MockInterrupt interrupt;
+    MockCrypto crypto;
+    MockComm comm;
+    MockStorage storage;
+    PlatformServices services;
+
+    WarmBootFixture() noexcept
+    {
+        services.time = &time;
+        services.gpio = &gpio;
+        services.interrupt = &interrupt;
+        services.crypto = &crypto;
+        services.storage = &storage;
+        services.comm = &comm;
+        comm.set_connected(true);
+    }
+
+    SystemConfig make_config()
+    {
+        SystemConfig config;
+        config.meter_id = 0xDEADBEEF;
+        config.tamper_config.sensor_pin = 4;
+        config.tamper_config.debounce_ms = 50;
+        for (size_t i = 0; i < analytics::PROFILE_HISTORY_SIZE; ++i) {
+            config.baseline_profile.hourly_avg_wh[i] = 1200;
+        }
+        config.baseline_profile.daily_avg_wh = 1200;
+        return config;
+    }
+};
+
+static constexpr size_t TEST_READINGS = 20;
+
+static void feed_readings(GridShieldSystem& system)
+{
+    for (size_t i = 0; i < TEST_READINGS; ++i) {
+        core::MeterReading reading;
+        reading.timestamp = static_cast<core::timestamp_t>(i) * 1000U;
+        reading.energy_wh = 900 + static_cast<uint32_t>(i);
+        (void)system.send_meter_reading(reading);
+    }
+}
+
+// ============================================================================
+// WarmBootStore
+// ============================================================================
+
+static void test_wb_load_empty_fails(void)
+{
+    WarmBootFixture f;
+    core::WarmBootStore store(f.services);
+
+    analytics::DetectorCheckpoint checkpoint;
+    auto result = store.load(core::WarmBootRecord::Detector, checkpoint);
+    TEST_ASSERT_TRUE(result.is_error());
+}
+
+static void test_wb_save_load_roundtrip(void)
+{
+    WarmBootFixture f;
+    core::WarmBootStore store(f.services);
+
+    analytics::DetectorCheckpoint saved;
+    saved.profile.profile_confidence = 42;
+    saved.profile.daily_avg_wh = 1234;
+    saved.recent_count = 3;
+    saved.recent_energy_wh[2] = 777;
+    TEST_ASSERT_TRUE(store.save(core::WarmBootRecord::Detector, saved).is_ok());
+
+    analytics::DetectorCheckpoint loaded;
+    TEST_ASSERT_TRUE(store.load(core::WarmBootRecord::Detector, loaded).is_ok());
+    TEST_ASSERT_EQUAL(42, loaded.profile.profile_confidence);
+    TEST_ASSERT_EQUAL(1234, loaded.profile.daily_avg_wh);
+    TEST_ASSERT_EQUAL(3, loaded.recent_count);
+    TEST_ASSERT_EQUAL(777, loaded.recent_energy_wh[2]);
+}
+
+static void test_wb_newest_bank_wins(void)
+{
+    WarmBootFixture f;
+    core::WarmBootStore store(f.services);
+
+    analytics::DetectorCheckpoint state;
+    for (uint8_t gen = 1; gen <= 3; ++gen) {
+        state.profile.profile_confidence = gen;
+        TEST_ASSERT_TRUE(store.save(core::WarmBootRecord::Detector, state).is_ok());
+    }
+
+    analytics::DetectorCheckpoint loaded;
+    TEST_ASSERT_TRUE(store.load(core::WarmBootRecord::Detector, loaded).is_ok());
+    TEST_ASSERT_EQUAL(3, loaded.profile.profile_confidence);
+}
+
+static void test_wb_torn_write_falls_back(void)
+{
+    WarmBootFixture f;
+    core::WarmBootStore store(f.services);
+
+    analytics::DetectorCheckpoint state;
+    state.profile.profile_confidence = 10;
+    store.save(core::WarmBootRecord::Detector, state); // bank A, seq 1
+    state.profile.profile_confidence = 11;
+    store.save(core::WarmBootRecord::Detector, state); // bank B, seq 2
+
+    // Corrupt bank B payload (simulates power cut mid-write)
+    static constexpr uint8_t GARBAGE[4] = {0xDE, 0xAD, 0xBE, 0xEF};
+    const uint32_t bank_b = core::WarmBootStore::WB_BASE_ADDRESS +
+                            core::WarmBootStore::DETECTOR_BANK_SIZE +
+                            core::WarmBootStore::HEADER_SIZE;
+    f.storage.write(bank_b, GARBAGE, sizeof(GARBAGE));
+
+    analytics::DetectorCheckpoint loaded;
+    TEST_ASSERT_TRUE(store.load(core::WarmBootRecord::Detector, loaded).is_ok());
+    TEST_ASSERT_EQUAL(10, loaded.profile.profile_confidence);
+}
+
+static void test_wb_time_series_roundtrip(void)
+{
+    WarmBootFixture f;
+    core::WarmBootStore store(f.services);
+
+    analytics::TimeSeriesBuffer<32> series;
+    series.init();
+    for (int32_t i = 0; i < 40; ++i) {
+        series.push(i * 10, static_cast<uint64_t>(i));
+    }
+    TEST_ASSERT_TRUE(store.save(core::WarmBootRecord::TimeSeries, series).is_ok());
+
+    analytics::TimeSeriesBuffer<32> restored;
+    TEST_ASSERT_TRUE(store.load(core::WarmBootRecord::TimeSeries, restored).is_ok());
+    TEST_ASSERT_TRUE(restored.is_initialized());
+    TEST_ASSERT_EQUAL(32, restored.count());
+    TEST_ASSERT_EQUAL(390, restored.latest().value().value);
+    TEST_ASSERT_EQUAL(series.exponential_smooth().value(), restored.exponential_smooth().value());
+}
+
+// ============================================================================
+// GridShieldSystem warm boot
+// ============================================================================
+
+static void test_wb_system_reuses_device_key(void)
+{
+    WarmBootFixture f;
+    auto config = f.make_config();
+    security::KeyStorage key_storage(f.services);
+
+    security::ECCKeyPair first_boot_key;
+    {
+        GridShieldSystem system;
+        TEST_ASSERT_TRUE(system.initialize(config, f.services).is_ok());
+        TEST_ASSERT_FALSE(system.boot_timing().warm_keys);
+        TEST_ASSERT_TRUE(key_storage.load(first_boot_key, security::KeySlot::Primary).is_ok());
+        system.shutdown();
+    }
+
+    GridShieldSystem system;
+    TEST_ASSERT_TRUE(system.initialize(config, f.services).is_ok());
+    TEST_ASSERT_TRUE(system.boot_timing().warm_keys);
+
+    security::ECCKeyPair second_boot_key;
+    TEST_ASSERT_TRUE(key_storage.load(second_boot_key, security::KeySlot::Primary).is_ok());
+    TEST_ASSERT_EQUAL_MEMORY(first_boot_key.get_public_key(),
+                             second_boot_key.get_public_key(),
+                             security::ECCKeyPair::PUBLIC_KEY_SIZE);
+    system.shutdown();
+}
+
+static void test_wb_system_restores_profile_after_power_loss(void)
+{
+    WarmBootFixture f;
+    auto config = f.make_config();
+
+    uint8_t learned_confidence = 0;
+    {
+        GridShieldSystem system;
+        system.initialize(config, f.services);
+        feed_readings(system);
+        learned_confidence = system.anomaly_detector().get_profile().profile_confidence;
+        TEST_ASSERT_GREATER_THAN(0, learned_confidence);
+
+        TEST_ASSERT_TRUE(system.handle_power_loss().is_ok());
+        TEST_ASSERT_EQUAL(core::SystemState::PowerLoss, system.get_state());
+    }
+
+    GridShieldSystem system;
+    TEST_ASSERT_TRUE(system.initialize(config, f.services).is_ok());
+    TEST_ASSERT_TRUE(system.boot_timing().warm_analytics);
+    TEST_ASSERT_EQUAL(learned_confidence,
+                      system.anomaly_detector().get_profile().profile_confidence);
+    system.shutdown();
+}
+
+static void test_wb_supply_fail_checkpoints_and_resumes(void)
+{
+    static constexpr uint8_t SUPPLY_SENSE_PIN = 5;
+    WarmBootFixture f;
+    auto config = f.make_config();
+    config.tamper_config.backup_power_pin = SUPPLY_SENSE_PIN;
+    config.checkpoint_interval_ms = 0; // no periodic checkpoint
+    f.gpio.simulate_trigger(SUPPLY_SENSE_PIN, true);
+
+    GridShieldSystem system;
+    TEST_ASSERT_TRUE(system.initialize(config, f.services).is_ok());
+    TEST_ASSERT_TRUE(system.start().is_ok());
+    feed_readings(system);
+    TEST_ASSERT_TRUE(system.process_cycle().is_ok());
+
+    core::WarmBootStore store(f.services);
+    analytics::DetectorCheckpoint checkpoint;
+    TEST_ASSERT_TRUE(store.load(core::WarmBootRecord::Detector, checkpoint).is_error());
+
+    // Mains drops: the next cycle checkpoints instead of doing normal work
+    f.gpio.simulate_trigger(SUPPLY_SENSE_PIN, false);
+    auto result = system.process_cycle();
+    TEST_ASSERT_TRUE(result.is_error());
+    TEST_ASSERT_EQUAL(core::ErrorCode::PowerLossDetected, result.error().code);
+    TEST_ASSERT_EQUAL(core::SystemState::PowerLoss, system.get_state());
+    TEST_ASSERT_TRUE(store.load(core::WarmBootRecord::Detector, checkpoint).is_ok());
+    TEST_ASSERT_EQUAL(system.anomaly_detector().get_profile().profile_confidence,
+                      checkpoint.profile.profile_confidence);
+
+    TEST_ASSERT_TRUE(system.process_cycle().is_error());
+    TEST_ASSERT_EQUAL(core::SystemState::PowerLoss, system.get_state());
+
+    // Supply back before the hold-up ran out: carry on where it left off
+    f.gpio.simulate_trigger(SUPPLY_SENSE_PIN, true);
+    TEST_ASSERT_TRUE(system.process_cycle().is_ok());
+    TEST_ASSERT_EQUAL(core::SystemState::Operating, system.get_state());
+    system.shutdown();
+}
+
+static void test_wb_boot_timing_phases(void)
+{
+    WarmBootFixture f;
+    auto config = f.make_config();
+
+    GridShieldSystem system;
+    system.initialize(config, f.services);
+    const auto& timing = system.boot_timing();
+    TEST_ASSERT_TRUE(timing.reached(core::BootPhase::Reset));
+    TEST_ASSERT_TRUE(timing.reached(core::BootPhase::KeysReady));
+    TEST_ASSERT_TRUE(timing.reached(core::BootPhase::Ready));
+    TEST_ASSERT_FALSE(timing.reached(core::BootPhase::FirstSignedReading));
+
+    feed_readings(system);
+    TEST_ASSERT_TRUE(timing.reached(core::BootPhase::FirstSignedReading));
+    TEST_ASSERT_GREATER_OR_EQUAL(timing.since_reset(core::BootPhase::Ready),
+                                 timing.since_reset(core::BootPhase::FirstSignedReading));
+    system.shutdown();
+}
+
+// ============================================================================
+// Suite Registration
+// ============================================================================
+
+void test_warm_boot_suite(void)
+{
+    RUN_TEST(test_wb_load_empty_fails);
+    RUN_TEST(test_wb_save_load_roundtrip);
+    RUN_TEST(test_wb_newest_bank_wins);
+    RUN_TEST(test_wb_torn_write_falls_back);
+    RUN_TEST(test_wb_time_series_roundtrip);
+    RUN_TEST(test_wb_system_reuses_device_key);
+    RUN_TEST(test_wb_system_restores_profile_after_power_loss);
+    RUN_TEST(test_wb_supply_fail_checkpoints_and_resumes);
+    RUN_TEST(test_wb_boot_timing_phases);
+}
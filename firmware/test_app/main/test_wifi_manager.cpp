@@ -0,0 +1,454 @@
+/**
+ * @file test_wifi_manager.cpp
+ * @brief Unit tests for the WiFi connection manager
+ *
+ * Covers the association cache (fast reconnect without scan or DHCP,
+ * lease expiry, restore), the full-connect and static-address fallbacks,
+ * reconnect backoff, modem-sleep wake periods and wake-window batching
+ * with immediate alerts.
+ */
+
+#include "unity.h"
+
+#include "network/packet.hpp"
+#include "network/wifi_manager.hpp"
+#include "platform/mock_platform.hpp"
+#include "platform/sim_clock.hpp"
+
+#include <cstdint>
+#include <cstring>
+
+using namespace gridshield;
+using namespace gridshield::network;
+using platform::WiFiConnectHint;
+using platform::WiFiIpConfig;
+using platform::WiFiLinkInfo;
+using platform::WiFiPowerSave;
+
+namespace {
+
+constexpr uint32_t SCAN_MS = 1500;
+constexpr uint32_t ASSOC_MS = 100;
+constexpr uint32_t DHCP_MS = 800;
+constexpr uint32_t ARP_MS = 10;
+constexpr uint32_t DHCP_TIMEOUT_MS = 3000;
+
+/// Access point behind a scripted station: connect costs simulated time.
+class ScriptedWiFi final : public platform::IPlatformWiFi
+{
+public:
+    explicit ScriptedWiFi(platform::sim::SimClock& clock) noexcept : clock_(clock) {}
+
+    core::Result<void> init() noexcept override
+    {
+        return core::Result<void>{};
+    }
+    core::Result<void> connect(const char* ssid, const char* password) noexcept override
+    {
+        return connect_with_hint(ssid, password, WiFiConnectHint{});
+    }
+    core::Result<void> disconnect() noexcept override
+    {
+        connected = false;
+        return core::Result<void>{};
+    }
+    bool is_connected() noexcept override
+    {
+        return connected;
+    }
+    core::Result<void> get_ip(char* buf, size_t len) noexcept override
+    {
+        if (buf == nullptr || len == 0) {
+            return GS_MAKE_ERROR(core::ErrorCode::InvalidParameter);
+        }
+        buf[0] = '\0';
+        return core::Result<void>{};
+    }
+
+    core::Result<void> connect_with_hint(const char* /*ssid*/,
+                                         const char* /*password*/,
+                                         const WiFiConnectHint& hint) noexcept override
+    {
+        ++attempts;
+        last_hint = hint;
+        if (hint.channel == 0) {
+            ++scans;
+            clock_.delay_ms(SCAN_MS);
+        } else if (hint.channel != channel) {
+            clock_.delay_ms(ASSOC_MS);
+            return GS_MAKE_ERROR(core::ErrorCode::WiFiConnectionFailed);
+        }
+        if (!ap_up) {
+            return GS_MAKE_ERROR(core::ErrorCode::WiFiConnectionFailed);
+        }
+        clock_.delay_ms(ASSOC_MS);
+        if (hint.static_ip.is_set()) {
+            clock_.delay_ms(ARP_MS);
+            ip = hint.static_ip;
+            lease_s = 0;
+        } else {
+            ++dhcp_requests;
+            if (!dhcp_ok) {
+                clock_.delay_ms(DHCP_TIMEOUT_MS);
+                return GS_MAKE_ERROR(core::ErrorCode::NetworkTimeout);
+            }
+            clock_.delay_ms(DHCP_MS);
+            ip.address = 0xC0A80132; // 192.168.1.50
+            ip.gateway = 0xC0A80101;
+            ip.netmask = 0xFFFFFF00;
+            lease_s = 3600;
+        }
+        connected = true;
+        return core::Result<void>{};
+    }
+
+    core::Result<WiFiLinkInfo> get_link_info() noexcept override
+    {
+        WiFiLinkInfo info;
+        info.bssid = {{0x02, 0x11, 0x22, 0x33, 0x44, static_cast<uint8_t>(channel)}};
+        info.channel = channel;
+        info.dtim_period = 1;
+        info.beacon_interval_tu = 100;
+        info.ip = ip;
+        info.lease_s = lease_s;
+        return core::Result<WiFiLinkInfo>(info);
+    }
+
+    core::Result<void> set_power_save(WiFiPowerSave mode, uint8_t interval) noexcept override
+    {
+        power_save = mode;
+        listen_interval = interval;
+        return core::Result<void>{};
+    }
+
+    uint8_t channel{6};
+    bool ap_up{true};
+    bool dhcp_ok{true};
+    bool connected{false};
+    uint32_t attempts{0};
+    uint32_t scans{0};
+    uint32_t dhcp_requests{0};
+    WiFiConnectHint last_hint{};
+    WiFiIpConfig ip{};
+    uint32_t lease_s{0};
+    WiFiPowerSave power_save{WiFiPowerSave::None};
+    uint8_t listen_interval{0};
+
+private:
+    platform::sim::SimClock& clock_;
+};
+
+class CountingUplink final : public platform::IPlatformComm
+{
+public:
+    core::Result<void> init() noexcept override
+    {
+        return core::Result<void>{};
+    }
+    core::Result<void> shutdown() noexcept override
+    {
+        return core::Result<void>{};
+    }
+    core::Result<size_t> send(const uint8_t* data, size_t length) noexcept override
+    {
+        ++sends;
+        last_first_byte = data[0];
+        return core::Result<size_t>(length);
+    }
+    core::Result<size_t>
+    receive(uint8_t* /*buffer*/, size_t /*max_length*/, uint32_t /*timeout_ms*/) noexcept override
+    {
+        return core::Result<size_t>(GS_MAKE_ERROR(core::ErrorCode::NetworkTimeout));
+    }
+    bool is_connected() noexcept override
+    {
+        return true;
+    }
+
+    uint32_t sends{0};
+    uint8_t last_first_byte{0};
+};
+
+WiFiManagerConfig base_config()
+{
+    WiFiManagerConfig config;
+    config.ssid = "gridshield";
+    config.password = "secret";
+    return config;
+}
+
+struct Rig
+{
+    platform::sim::SimClock clock;
+    ScriptedWiFi wifi{clock};
+    CountingUplink uplink;
+    WiFiManager manager{wifi, uplink, clock};
+
+    explicit Rig(const WiFiManagerConfig& config = base_config())
+    {
+        TEST_ASSERT_TRUE(manager.configure(config).is_ok());
+    }
+
+    void drop_and_poll()
+    {
+        wifi.connected = false;
+        manager.poll();
+    }
+};
+
+} // namespace
+
+// ============================================================================
+// CONNECT AND CACHE
+// ============================================================================
+
+static void test_wifi_first_connect_caches(void)
+{
+    Rig rig;
+    TEST_ASSERT_TRUE(rig.manager.init().is_ok());
+    TEST_ASSERT_EQUAL(WiFiState::Connected, rig.manager.state());
+    TEST_ASSERT_EQUAL(WiFiConnectPath::Full, rig.manager.last_path());
+    TEST_ASSERT_EQUAL_UINT32(1, rig.wifi.scans);
+    TEST_ASSERT_EQUAL_UINT32(SCAN_MS + ASSOC_MS + DHCP_MS, rig.manager.stats().last_connect_ms);
+
+    const WiFiCache& cache = rig.manager.cache();
+    TEST_ASSERT_TRUE(cache.is_valid());
+    TEST_ASSERT_EQUAL_UINT8(6, cache.channel);
+    TEST_ASSERT_EQUAL_UINT32(0xC0A80132, cache.ip.address);
+    TEST_ASSERT_EQUAL_UINT32(3600, cache.lease_s);
+
+    // Modem sleep every 3 beacons; the 60 s window rounds up to 196 periods
+    TEST_ASSERT_EQUAL(WiFiPowerSave::MaxModem, rig.wifi.power_save);
+    TEST_ASSERT_EQUAL_UINT8(WIFI_DEFAULT_LISTEN_INTERVAL, rig.wifi.listen_interval);
+    TEST_ASSERT_EQUAL_UINT32(307200, rig.manager.wake_period_us());
+    TEST_ASSERT_TRUE(rig.manager.batch_window_us() == 196ULL * 307200ULL);
+}
+
+static void test_wifi_fast_reconnect(void)
+{
+    Rig rig;
+    (void)rig.manager.init();
+    const uint64_t lease_start = rig.manager.cache().lease_start_ms;
+
+    rig.clock.delay_ms(60000);
+    rig.drop_and_poll();
+    TEST_ASSERT_EQUAL(WiFiState::Connected, rig.manager.state());
+    TEST_ASSERT_EQUAL(WiFiConnectPath::Fast, rig.manager.last_path());
+    TEST_ASSERT_EQUAL_UINT32(1, rig.manager.stats().drops);
+    TEST_ASSERT_EQUAL_UINT32(1, rig.manager.stats().fast_connects);
+    // No scan, no DHCP: association plus the address check only
+    TEST_ASSERT_EQUAL_UINT32(1, rig.wifi.scans);
+    TEST_ASSERT_EQUAL_UINT32(1, rig.wifi.dhcp_requests);
+    TEST_ASSERT_EQUAL_UINT8(6, rig.wifi.last_hint.channel);
+    TEST_ASSERT_EQUAL_UINT32(0xC0A80132, rig.wifi.last_hint.static_ip.address);
+    TEST_ASSERT_EQUAL_UINT32(ASSOC_MS + ARP_MS, rig.manager.stats().last_connect_ms);
+    // The reused lease keeps its original start
+    TEST_ASSERT_EQUAL_UINT32(3600, rig.manager.cache().lease_s);
+    TEST_ASSERT_TRUE(rig.manager.cache().lease_start_ms == lease_start);
+
+    // Past half the lease (T1) the address is renewed through DHCP
+    rig.clock.delay_ms(1800U * 1000U);
+    rig.drop_and_poll();
+    TEST_ASSERT_EQUAL(WiFiConnectPath::Fast, rig.manager.last_path());
+    TEST_ASSERT_FALSE(rig.wifi.last_hint.static_ip.is_set());
+    TEST_ASSERT_EQUAL_UINT32(2, rig.wifi.dhcp_requests);
+    TEST_ASSERT_EQUAL_UINT32(1, rig.wifi.scans);
+    TEST_ASSERT_TRUE(rig.manager.cache().lease_start_ms > lease_start);
+}
+
+static void test_wifi_fallback_paths(void)
+{
+    WiFiManagerConfig config = base_config();
+    config.static_fallback.address = 0xC0A801F0; // 192.168.1.240
+    config.static_fallback.gateway = 0xC0A80101;
+    config.static_fallback.netmask = 0xFFFFFF00;
+    Rig rig(config);
+    (void)rig.manager.init();
+
+    // AP moved channel: the cached hint fails, a scan finds it in the same poll
+    rig.wifi.channel = 11;
+    rig.drop_and_poll();
+    TEST_ASSERT_EQUAL(WiFiConnectPath::Full, rig.manager.last_path());
+    TEST_ASSERT_EQUAL_UINT32(1, rig.manager.stats().failed_attempts);
+    TEST_ASSERT_EQUAL_UINT8(11, rig.manager.cache().channel);
+
+    // Moved again and DHCP down: fast and full fail, the static address works
+    rig.wifi.channel = 1;
+    rig.wifi.dhcp_ok = false;
+    rig.drop_and_poll();
+    TEST_ASSERT_EQUAL(WiFiState::Connected, rig.manager.state());
+    TEST_ASSERT_EQUAL(WiFiConnectPath::Fallback, rig.manager.last_path());
+    TEST_ASSERT_EQUAL_UINT32(1, rig.manager.stats().fallback_connects);
+    TEST_ASSERT_EQUAL_UINT32(0xC0A801F0, rig.wifi.ip.address);
+    // The fallback address is not cached as a lease
+    TEST_ASSERT_EQUAL_UINT8(1, rig.manager.cache().channel);
+    TEST_ASSERT_FALSE(rig.manager.cache().ip.is_set());
+
+    // DHCP back: the next fast reconnect asks for a lease again
+    rig.wifi.dhcp_ok = true;
+    rig.drop_and_poll();
+    TEST_ASSERT_EQUAL(WiFiConnectPath::Fast, rig.manager.last_path());
+    TEST_ASSERT_EQUAL_UINT32(0xC0A80132, rig.manager.cache().ip.address);
+
+    // AP gone: no DHCP timeout, so no static attempt (one scan per cycle)
+    const uint32_t scans = rig.wifi.scans;
+    rig.wifi.ap_up = false;
+    rig.drop_and_poll();
+    TEST_ASSERT_EQUAL(WiFiState::Disconnected, rig.manager.state());
+    TEST_ASSERT_EQUAL_UINT32(scans + 1, rig.wifi.scans);
+    TEST_ASSERT_EQUAL_UINT32(1, rig.manager.stats().fallback_connects);
+}
+
+static void test_wifi_reconnect_backoff(void)
+{
+    Rig rig;
+    (void)rig.manager.init();
+
+    rig.wifi.ap_up = false;
+    rig.drop_and_poll();
+    TEST_ASSERT_EQUAL(WiFiState::Disconnected, rig.manager.state());
+    const uint32_t after_first = rig.wifi.attempts;
+
+    // 1 s, then 2 s, before the next cycle
+    rig.clock.delay_ms(WIFI_RECONNECT_BASE_MS - 1);
+    rig.manager.poll();
+    TEST_ASSERT_EQUAL_UINT32(after_first, rig.wifi.attempts);
+    rig.clock.delay_ms(1);
+    rig.manager.poll();
+    TEST_ASSERT_GREATER_THAN(after_first, rig.wifi.attempts);
+    const uint32_t after_second = rig.wifi.attempts;
+    rig.clock.delay_ms(2 * WIFI_RECONNECT_BASE_MS - 1);
+    rig.manager.poll();
+    TEST_ASSERT_EQUAL_UINT32(after_second, rig.wifi.attempts);
+
+    rig.wifi.ap_up = true;
+    rig.clock.delay_ms(1);
+    rig.manager.poll();
+    TEST_ASSERT_EQUAL(WiFiState::Connected, rig.manager.state());
+    TEST_ASSERT_EQUAL(WiFiConnectPath::Fast, rig.manager.last_path());
+}
+
+static void test_wifi_cache_restore_and_config(void)
+{
+    platform::sim::SimClock clock;
+    ScriptedWiFi wifi(clock);
+    CountingUplink uplink;
+    WiFiManager manager(wifi, uplink, clock);
+    TEST_ASSERT_EQUAL(core::ErrorCode::ConfigurationError, manager.init().error().code);
+    WiFiManagerConfig bad = base_config();
+    bad.ssid = "";
+    TEST_ASSERT_TRUE(manager.configure(bad).is_error());
+
+    // Cache kept across deep sleep: the very first connect skips the scan
+    WiFiCache cache;
+    cache.magic = WIFI_CACHE_MAGIC;
+    cache.channel = 6;
+    cache.ip.address = 0xC0A80132;
+    manager.restore_cache(cache);
+    TEST_ASSERT_TRUE(manager.configure(base_config()).is_ok());
+    TEST_ASSERT_TRUE(manager.init().is_ok());
+    TEST_ASSERT_EQUAL(WiFiConnectPath::Fast, manager.last_path());
+    TEST_ASSERT_EQUAL_UINT32(0, wifi.scans);
+    TEST_ASSERT_EQUAL_UINT32(0, wifi.dhcp_requests);
+
+    // Cache disabled: every reconnect scans
+    WiFiManagerConfig no_cache = base_config();
+    no_cache.use_cache = false;
+    no_cache.power_save = WiFiPowerSave::None;
+    Rig rig(no_cache);
+    (void)rig.manager.init();
+    rig.drop_and_poll();
+    TEST_ASSERT_EQUAL(WiFiConnectPath::Full, rig.manager.last_path());
+    TEST_ASSERT_EQUAL_UINT32(2, rig.wifi.scans);
+    TEST_ASSERT_EQUAL(WiFiPowerSave::None, rig.wifi.power_save);
+    TEST_ASSERT_EQUAL_UINT32(0, rig.manager.wake_period_us());
+
+    // The mock HAL honours hints too
+    platform::mock::MockWiFi mock;
+    (void)mock.init();
+    WiFiConnectHint hint;
+    hint.channel = 11;
+    TEST_ASSERT_TRUE(mock.connect_with_hint("ssid", "pw", hint).is_ok());
+    TEST_ASSERT_EQUAL_UINT8(11, mock.get_link_info().value().channel);
+    TEST_ASSERT_TRUE(mock.set_power_save(WiFiPowerSave::MinModem, 1).is_ok());
+    TEST_ASSERT_EQUAL(WiFiPowerSave::MinModem, mock.power_save());
+}
+
+// ============================================================================
+// BATCHING
+// ============================================================================
+
+static void test_wifi_batching_windows(void)
+{
+    Rig rig;
+    (void)rig.manager.init();
+    const uint64_t window_ms = rig.manager.batch_window_us() / 1000U;
+
+    uint8_t reading[120];
+    std::memset(reading, 0x11, sizeof(reading));
+    for (int i = 0; i < 5; ++i) {
+        TEST_ASSERT_TRUE(rig.manager.send(reading, sizeof(reading)).is_ok());
+        rig.clock.delay_ms(5000);
+        rig.manager.poll();
+    }
+    TEST_ASSERT_EQUAL_UINT32(0, rig.uplink.sends);
+    TEST_ASSERT_EQUAL_UINT32(5, rig.manager.queued());
+
+    rig.clock.delay_ms(static_cast<uint32_t>(window_ms) - 25000 + 1);
+    rig.manager.poll();
+    TEST_ASSERT_EQUAL_UINT32(5, rig.uplink.sends);
+    TEST_ASSERT_EQUAL_UINT32(1, rig.manager.stats().windows);
+    TEST_ASSERT_EQUAL_UINT32(0, rig.manager.queued());
+
+    // An alert frame goes out at once, queued readings first
+    TEST_ASSERT_TRUE(rig.manager.send(reading, sizeof(reading)).is_ok());
+    uint8_t alert[sizeof(PacketHeader) + 16]{};
+    PacketHeader header;
+    header.type = PacketType::TamperAlert;
+    std::memcpy(alert, &header, sizeof(header));
+    TEST_ASSERT_TRUE(rig.manager.send(alert, sizeof(alert)).is_ok());
+    TEST_ASSERT_EQUAL_UINT32(7, rig.uplink.sends);
+    TEST_ASSERT_EQUAL_UINT8(MAGIC_HEADER, rig.uplink.last_first_byte);
+    TEST_ASSERT_EQUAL_UINT32(1, rig.manager.stats().immediate);
+
+    // Offline: the queue fills, then refuses; an alert flushes on reconnect
+    rig.wifi.ap_up = false;
+    rig.drop_and_poll();
+    for (size_t i = 0; i < WIFI_BATCH_MAX_MESSAGES - 1; ++i) {
+        TEST_ASSERT_TRUE(rig.manager.send(reading, sizeof(reading)).is_ok());
+    }
+    TEST_ASSERT_TRUE(rig.manager.send(alert, sizeof(alert)).is_ok());
+    auto full = rig.manager.send(reading, sizeof(reading));
+    TEST_ASSERT_TRUE(full.is_error());
+    TEST_ASSERT_EQUAL(core::ErrorCode::BufferOverflow, full.error().code);
+    TEST_ASSERT_EQUAL_UINT32(1, rig.manager.stats().overflows);
+
+    rig.wifi.ap_up = true;
+    rig.clock.delay_ms(WIFI_RECONNECT_BASE_MS);
+    rig.manager.poll();
+    TEST_ASSERT_EQUAL(WiFiState::Connected, rig.manager.state());
+    TEST_ASSERT_EQUAL_UINT32(7 + WIFI_BATCH_MAX_MESSAGES, rig.uplink.sends);
+    TEST_ASSERT_EQUAL_UINT32(0, rig.manager.queued());
+
+    // Batching off: straight through
+    WiFiManagerConfig direct = base_config();
+    direct.batch_interval_ms = 0;
+    Rig unbatched(direct);
+    (void)unbatched.manager.init();
+    TEST_ASSERT_TRUE(unbatched.manager.send(reading, sizeof(reading)).is_ok());
+    TEST_ASSERT_EQUAL_UINT32(1, unbatched.uplink.sends);
+}
+
+// ============================================================================
+// TEST SUITE RUNNER
+// ============================================================================
+
+void test_wifi_manager_suite(void)
+{
+    RUN_TEST(test_wifi_first_connect_caches);
+    RUN_TEST(test_wifi_fast_reconnect);
+    RUN_TEST(test_wifi_fallback_paths);
+    RUN_TEST(test_wifi_reconnect_backoff);
+    RUN_TEST(test_wifi_cache_restore_and_config);
+    RUN_TEST(test_wifi_batching_windows);
+}